@@ -17,6 +17,7 @@
 
 #include "stdUniquePtr.h"
 
+#include <chrono>
 #include <string>
 #include <tuple>
 
@@ -154,6 +155,16 @@ public:
         return (m_messageAttributes);
     };
 
+    /** \brief Time the message was sent (in-process senders only).
+     * 
+     * @return send time; default (epoch) if unknown
+     */
+    const std::chrono::steady_clock::time_point&
+    getSendTime() const { return (m_sendTime); };
+
+    void
+    setSendTime(const std::chrono::steady_clock::time_point& sendTime) { m_sendTime = sendTime; };
+
 protected:
 
     bool
@@ -202,6 +213,7 @@ protected:
 
     static std::string s_emptyString;
     std::unique_ptr<MessageAttributes> m_messageAttributes;
+    std::chrono::steady_clock::time_point m_sendTime;
 
 };
 
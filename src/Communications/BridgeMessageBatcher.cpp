@@ -0,0 +1,301 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#include "BridgeMessageBatcher.h"
+
+#include "LmcpObjectSerializer.h"
+
+#include "afrl/cmasi/EntityState.h"
+
+#include "UxAS_Log.h"
+#include "Constants/UxAS_String.h"
+
+#include "stdUniquePtr.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+
+namespace uxas
+{
+namespace communications
+{
+
+namespace
+{
+
+void
+putUint32(std::string& buffer, uint32_t value)
+{
+    buffer.push_back(static_cast<char>((value >> 24) & 0xFF));
+    buffer.push_back(static_cast<char>((value >> 16) & 0xFF));
+    buffer.push_back(static_cast<char>((value >> 8) & 0xFF));
+    buffer.push_back(static_cast<char>(value & 0xFF));
+}
+
+uint32_t
+getUint32(const char* data)
+{
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    return ((static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16)
+            | (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]));
+}
+
+/** \brief bound on the uncompressed size of a received batch */
+const uint32_t c_maximumBatchSize{64 * 1024 * 1024};
+
+} //namespace
+
+const uint8_t BridgeMessageBatcher::s_batchFormatVersion;
+const uint8_t BridgeMessageBatcher::s_compressedFlag;
+const size_t BridgeMessageBatcher::s_headerSize;
+
+void
+BridgeMessageBatcher::readConfiguration(const pugi::xml_node& bridgeXmlNode, Configuration& configuration)
+{
+    if (!bridgeXmlNode.attribute(uxas::common::StringConstant::BatchWindow_ms().c_str()).empty())
+    {
+        configuration.m_batchWindow_ms = bridgeXmlNode.attribute(uxas::common::StringConstant::BatchWindow_ms().c_str()).as_uint();
+        UXAS_LOG_INFORM(s_typeName(), "::readConfiguration setting batch window to ", configuration.m_batchWindow_ms, " ms from XML configuration");
+    }
+    if (!bridgeXmlNode.attribute(uxas::common::StringConstant::BatchCompressionLevel().c_str()).empty())
+    {
+        int32_t compressionLevel = bridgeXmlNode.attribute(uxas::common::StringConstant::BatchCompressionLevel().c_str()).as_int();
+        configuration.m_compressionLevel = std::max(0, std::min(9, compressionLevel));
+        UXAS_LOG_INFORM(s_typeName(), "::readConfiguration setting batch compression level to ", configuration.m_compressionLevel, " from XML configuration");
+    }
+    for (pugi::xml_node currentXmlNode = bridgeXmlNode.first_child(); currentXmlNode; currentXmlNode = currentXmlNode.next_sibling())
+    {
+        if (uxas::common::StringConstant::LatestValueMessage() == currentXmlNode.name())
+        {
+            std::string messageType = currentXmlNode.attribute(uxas::common::StringConstant::MessageType().c_str()).value();
+            if (!messageType.empty())
+            {
+                UXAS_LOG_INFORM(s_typeName(), "::readConfiguration adding latest-value message type ", messageType);
+                configuration.m_latestValueDescriptors.emplace(messageType);
+            }
+        }
+    }
+};
+
+size_t
+BridgeMessageBatcher::addMessage(uxas::communications::data::AddressedAttributedMessage& message)
+{
+    std::string latestValueKey = getLatestValueKey(message);
+    const std::string& messageString = message.getString();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_statistics.m_messageCount++;
+    m_statistics.m_messageByteCount += messageString.size();
+    if (!latestValueKey.empty())
+    {
+        auto messageIndexIt = m_messageIndexesByLatestValueKey.find(latestValueKey);
+        if (messageIndexIt != m_messageIndexesByLatestValueKey.end())
+        {
+            // the newest message replaces the older one at its position in the batch
+            std::string& coalescedMessageString = m_messageStrings[messageIndexIt->second];
+            m_batchSize = m_batchSize - coalescedMessageString.size() + messageString.size();
+            coalescedMessageString = messageString;
+            m_statistics.m_coalescedMessageCount++;
+            return (m_batchSize);
+        }
+        m_messageIndexesByLatestValueKey.emplace(std::move(latestValueKey), m_messageStrings.size());
+    }
+    m_messageStrings.push_back(messageString);
+    m_batchSize += sizeof(uint32_t) + messageString.size();
+    return (m_batchSize);
+};
+
+bool
+BridgeMessageBatcher::isEmpty()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (m_messageStrings.empty());
+};
+
+std::unique_ptr<uxas::communications::data::AddressedAttributedMessage>
+BridgeMessageBatcher::createBatchMessage(const std::string& sourceEntityId, const std::string& sourceServiceId)
+{
+    std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> batchMessage;
+    std::string payload;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_messageStrings.empty())
+        {
+            return (batchMessage);
+        }
+
+        m_batchBuffer.clear();
+        m_batchBuffer.reserve(m_batchSize);
+        for (auto& messageString : m_messageStrings)
+        {
+            putUint32(m_batchBuffer, static_cast<uint32_t>(messageString.size()));
+            m_batchBuffer.append(messageString);
+        }
+        m_messageStrings.clear();
+        m_messageIndexesByLatestValueKey.clear();
+        m_batchSize = 0;
+
+        bool isCompressed{false};
+        payload.push_back(static_cast<char>(s_batchFormatVersion));
+        payload.push_back(static_cast<char>(0));
+        putUint32(payload, static_cast<uint32_t>(m_batchBuffer.size()));
+        if (m_compressionLevel > 0)
+        {
+            uLongf compressedSize = compressBound(static_cast<uLong>(m_batchBuffer.size()));
+            payload.resize(s_headerSize + compressedSize);
+            int result = compress2(reinterpret_cast<Bytef*>(&payload[s_headerSize]), &compressedSize,
+                                   reinterpret_cast<const Bytef*>(m_batchBuffer.data()), static_cast<uLong>(m_batchBuffer.size()), m_compressionLevel);
+            if (result == Z_OK && compressedSize < m_batchBuffer.size())
+            {
+                payload.resize(s_headerSize + compressedSize);
+                isCompressed = true;
+            }
+            else
+            {
+                if (result != Z_OK)
+                {
+                    UXAS_LOG_WARN(s_typeName(), "::createBatchMessage failed to compress batch - zlib error ", result, "; sending uncompressed batch");
+                }
+                payload.resize(s_headerSize);
+            }
+        }
+        if (isCompressed)
+        {
+            payload[1] = static_cast<char>(s_compressedFlag);
+        }
+        else
+        {
+            payload.append(m_batchBuffer);
+        }
+    }
+
+    batchMessage = uxas::stduxas::make_unique<uxas::communications::data::AddressedAttributedMessage>();
+    if (!batchMessage->setAddressAttributesAndPayload(s_batchAddress(), uxas::common::ContentType::batch(), s_batchAddress(),
+                                                      "", sourceEntityId, sourceServiceId, std::move(payload)))
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::createBatchMessage failed to create batch message");
+        batchMessage.reset();
+        return (batchMessage);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_statistics.m_batchCount++;
+    m_statistics.m_sentByteCount += batchMessage->getString().size();
+    return (batchMessage);
+};
+
+BridgeMessageBatcher::Statistics
+BridgeMessageBatcher::getStatistics()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (m_statistics);
+};
+
+void
+BridgeMessageBatcher::logStatistics(const std::string& linkName)
+{
+    Statistics statistics = getStatistics();
+    int64_t savedByteCount = static_cast<int64_t>(statistics.m_messageByteCount) - static_cast<int64_t>(statistics.m_sentByteCount);
+    double savedPercentage = statistics.m_messageByteCount > 0 ? 100.0 * savedByteCount / statistics.m_messageByteCount : 0.0;
+    UXAS_LOG_INFORM(s_typeName(), "::logStatistics link [", linkName, "] messages ", statistics.m_messageCount,
+                    ", coalesced ", statistics.m_coalescedMessageCount, ", batches ", statistics.m_batchCount,
+                    ", message bytes ", statistics.m_messageByteCount, ", sent bytes ", statistics.m_sentByteCount,
+                    ", saved bytes ", savedByteCount, " (", savedPercentage, "%)");
+};
+
+bool
+BridgeMessageBatcher::unpackBatchMessage(uxas::communications::data::AddressedAttributedMessage& batchMessage,
+                                         std::vector<std::unique_ptr<uxas::communications::data::AddressedAttributedMessage>>& messages)
+{
+    const std::string& payload = batchMessage.getPayload();
+    if (payload.size() < s_headerSize || static_cast<uint8_t>(payload[0]) != s_batchFormatVersion)
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::unpackBatchMessage received batch with unsupported header");
+        return (false);
+    }
+
+    uint32_t batchSize = getUint32(payload.data() + 2);
+    std::string uncompressedBatch;
+    const char* batchData = payload.data() + s_headerSize;
+    if ((static_cast<uint8_t>(payload[1]) & s_compressedFlag) != 0)
+    {
+        if (batchSize > c_maximumBatchSize)
+        {
+            UXAS_LOG_ERROR(s_typeName(), "::unpackBatchMessage received batch with invalid size ", batchSize);
+            return (false);
+        }
+        uncompressedBatch.resize(batchSize);
+        uLongf size = batchSize;
+        int result = uncompress(reinterpret_cast<Bytef*>(&uncompressedBatch[0]), &size,
+                                reinterpret_cast<const Bytef*>(batchData), static_cast<uLong>(payload.size() - s_headerSize));
+        if (result != Z_OK || size != batchSize)
+        {
+            UXAS_LOG_ERROR(s_typeName(), "::unpackBatchMessage failed to decompress batch - zlib error ", result);
+            return (false);
+        }
+        batchData = uncompressedBatch.data();
+    }
+    else if (batchSize != payload.size() - s_headerSize)
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::unpackBatchMessage received batch with invalid size ", batchSize);
+        return (false);
+    }
+
+    size_t offset{0};
+    while (offset < batchSize)
+    {
+        uint32_t messageSize = (batchSize - offset >= sizeof(uint32_t)) ? getUint32(batchData + offset) : 0;
+        offset += sizeof(uint32_t);
+        if (messageSize == 0 || messageSize > batchSize - offset)
+        {
+            UXAS_LOG_ERROR(s_typeName(), "::unpackBatchMessage received truncated batch");
+            return (false);
+        }
+        auto message = uxas::stduxas::make_unique<uxas::communications::data::AddressedAttributedMessage>();
+        if (message->setAddressAttributesAndPayloadFromDelimitedString(std::string(batchData + offset, messageSize)))
+        {
+            messages.push_back(std::move(message));
+        }
+        else
+        {
+            UXAS_LOG_WARN(s_typeName(), "::unpackBatchMessage ignoring invalid message in batch");
+        }
+        offset += messageSize;
+    }
+    return (true);
+};
+
+std::string
+BridgeMessageBatcher::getLatestValueKey(uxas::communications::data::AddressedAttributedMessage& message)
+{
+    std::string latestValueKey;
+    const std::string& descriptor = message.getMessageAttributesReference()->getDescriptor();
+    if (m_latestValueDescriptors.find(descriptor) == m_latestValueDescriptors.end())
+    {
+        return (latestValueKey);
+    }
+
+    // entity states are keyed by the entity they describe; other messages by their source entity
+    latestValueKey = descriptor + "|";
+    std::unique_ptr<avtas::lmcp::Object> lmcpObject = LmcpObjectSerializer::deserialize(message.getPayload());
+    afrl::cmasi::EntityState* entityState = dynamic_cast<afrl::cmasi::EntityState*>(lmcpObject.get());
+    if (entityState != nullptr)
+    {
+        latestValueKey.append(std::to_string(entityState->getID()));
+    }
+    else
+    {
+        latestValueKey.append(message.getMessageAttributesReference()->getSourceEntityId());
+    }
+    return (latestValueKey);
+};
+
+}; //namespace communications
+}; //namespace uxas
@@ -0,0 +1,200 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_MESSAGE_BRIDGE_MESSAGE_BATCHER_H
+#define UXAS_MESSAGE_BRIDGE_MESSAGE_BATCHER_H
+
+#include "AddressedAttributedMessage.h"
+
+#include "pugixml.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace uxas
+{
+namespace communications
+{
+
+/** \class BridgeMessageBatcher
+ *
+ * \par Description:
+ * Collects the messages a bridge forwards over one external link during a
+ * batching window and packs them into a single (optionally zlib compressed)
+ * batch message. For "latest-value" message types (e.g.,
+ * <B><i>AirVehicleState</i></B>), only the newest message per entity is
+ * kept within a window; it replaces the older message at its position in
+ * the batch.
+ *
+ * The batch is an <B><i>AddressedAttributedMessage</i></B> with address
+ * <B><i>s_batchAddress</i></B> and content type "batch", so it travels over
+ * any link that carries addressed attributed messages. Its payload is
+ * <ul style="padding-left:1em;margin-left:0">
+ * <li>1 byte: batch format version (1)
+ * <li>1 byte: flags (0x01 = compressed)
+ * <li>4 bytes: uncompressed size (big endian)
+ * <li>messages (zlib stream if compressed), each as 4 bytes length (big
+ * endian) followed by the delimited message string
+ * </ul>
+ *
+ * \par Configuration:
+ * Bridges read the attributes <B><i>BatchWindow_ms</i></B> (0, the default,
+ * forwards every message individually) and <B><i>BatchCompressionLevel</i></B>
+ * (zlib level 0 to 9, default 6) and the child elements
+ * <B><i>LatestValueMessage MessageType="..."</i></B> of their XML
+ * configuration.
+ *
+ * \par Statistics:
+ * Counts of added and coalesced messages and the uncompressed and sent byte
+ * counts give the bytes saved on the link.
+ *
+ * \par Threading:
+ * All methods are thread-safe (messages are added on the bridge thread and
+ * batches are created on the timer thread).
+ *
+ * \n
+ */
+class BridgeMessageBatcher
+{
+public:
+
+    static const std::string&
+    s_typeName() { static std::string s_string("BridgeMessageBatcher"); return (s_string); };
+
+    /** \brief Address (and descriptor) of batch messages. */
+    static const std::string&
+    s_batchAddress() { static std::string s_string("uxas.bridge.MessageBatch"); return (s_string); };
+
+    static const uint8_t s_batchFormatVersion{1};
+    static const uint8_t s_compressedFlag{0x01};
+    static const size_t s_headerSize{6};
+
+    struct Statistics
+    {
+        /** \brief messages added to batches */
+        uint64_t m_messageCount{0};
+        /** \brief messages replaced by a newer message of the same entity */
+        uint64_t m_coalescedMessageCount{0};
+        uint64_t m_batchCount{0};
+        /** \brief size of all added messages, i.e., bytes sent without batching */
+        uint64_t m_messageByteCount{0};
+        /** \brief size of all batch messages */
+        uint64_t m_sentByteCount{0};
+    };
+
+    struct Configuration
+    {
+        /** \brief batching window (0 = batching disabled) */
+        uint32_t m_batchWindow_ms{0};
+        /** \brief zlib compression level (0 = not compressed, 1 to 9) */
+        int32_t m_compressionLevel{6};
+        /** \brief message types (full LMCP type names) of which only the
+         * newest message per entity is sent */
+        std::unordered_set<std::string> m_latestValueDescriptors;
+    };
+
+    /** \brief Reads the batching configuration of a bridge.
+     *
+     * @param bridgeXmlNode XML configuration of the bridge
+     * @param configuration set from the attributes and child elements present
+     */
+    static void
+    readConfiguration(const pugi::xml_node& bridgeXmlNode, Configuration& configuration);
+
+    BridgeMessageBatcher(const Configuration& configuration)
+    : m_compressionLevel(configuration.m_compressionLevel), m_latestValueDescriptors(configuration.m_latestValueDescriptors) { };
+
+private:
+
+    /** \brief Copy construction not permitted */
+    BridgeMessageBatcher(BridgeMessageBatcher const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(BridgeMessageBatcher const&) = delete;
+
+public:
+
+    /** \brief Adds a message to the current batch.
+     *
+     * @param message message to forward
+     * @return uncompressed size of the current batch
+     */
+    size_t
+    addMessage(uxas::communications::data::AddressedAttributedMessage& message);
+
+    bool
+    isEmpty();
+
+    /** \brief Packs the current batch into a batch message and starts a new
+     * batch.
+     *
+     * @param sourceEntityId source entity ID attribute of the batch message
+     * @param sourceServiceId source service ID attribute of the batch message
+     * @return batch message; empty pointer if the batch is empty
+     */
+    std::unique_ptr<uxas::communications::data::AddressedAttributedMessage>
+    createBatchMessage(const std::string& sourceEntityId, const std::string& sourceServiceId);
+
+    Statistics
+    getStatistics();
+
+    /** \brief Logs the statistics of the link.
+     *
+     * @param linkName name of the link (e.g., remote entity)
+     */
+    void
+    logStatistics(const std::string& linkName);
+
+    static bool
+    isBatchMessage(const uxas::communications::data::AddressedAttributedMessage& message)
+    {
+        return (message.getAddress() == s_batchAddress());
+    };
+
+    /** \brief Unpacks the messages of a batch message.
+     *
+     * @param batchMessage received batch message
+     * @param messages unpacked messages (appended in their send order)
+     * @return true if the batch is intact
+     */
+    static bool
+    unpackBatchMessage(uxas::communications::data::AddressedAttributedMessage& batchMessage,
+                       std::vector<std::unique_ptr<uxas::communications::data::AddressedAttributedMessage>>& messages);
+
+private:
+
+    /** \brief Key of the newest message of an entity (empty if the message
+     * is not of a latest-value type). */
+    std::string
+    getLatestValueKey(uxas::communications::data::AddressedAttributedMessage& message);
+
+    std::mutex m_mutex;
+    int32_t m_compressionLevel{0};
+    std::unordered_set<std::string> m_latestValueDescriptors;
+
+    /** \brief delimited message strings of the current batch (coalesced
+     * messages are replaced in place) */
+    std::vector<std::string> m_messageStrings;
+    std::unordered_map<std::string, size_t> m_messageIndexesByLatestValueKey;
+    size_t m_batchSize{0};
+    std::string m_batchBuffer;
+
+    Statistics m_statistics;
+};
+
+}; //namespace communications
+}; //namespace uxas
+
+#endif /* UXAS_MESSAGE_BRIDGE_MESSAGE_BATCHER_H */
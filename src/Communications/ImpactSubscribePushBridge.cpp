@@ -19,6 +19,7 @@
 #include <locale>
 #include "ZeroMqFabric.h"
 #include "ImpactSubscribePushBridge.h"
+#include "LmcpObjectSerializer.h"
 
 #define STRING_XML_SUBSCRIBE_TO_EXTERNAL_MESSAGE "SubscribeToExternalMessage"
 
@@ -217,14 +218,7 @@ ImpactSubscribePushBridge::processReceivedSerializedLmcpMessage(
         UXAS_LOG_INFORM(s_typeName(), "::processReceivedSerializedLmcpMessage processing message with source service ID ", receivedLmcpMessage->getMessageAttributesReference()->getSourceServiceId());
 
         // unpack message to get complete attributes
-        std::string message = receivedLmcpMessage->getPayload();
-        avtas::lmcp::ByteBuffer byteBuffer;
-        byteBuffer.allocate(message.size());
-        byteBuffer.put(reinterpret_cast<const uint8_t*> (message.c_str()), message.size());
-        byteBuffer.rewind();
-
-        std::shared_ptr<avtas::lmcp::Object> ptr_Object;
-        ptr_Object.reset(avtas::lmcp::Factory::getObject(byteBuffer));
+        std::shared_ptr<avtas::lmcp::Object> ptr_Object = LmcpObjectSerializer::deserialize(receivedLmcpMessage->getPayload());
         if(!ptr_Object)
         {
             UXAS_LOG_WARN(s_typeName(), "::processReceivedSerializedLmcpMessage received an invalid LMCP object, ignoring");
@@ -275,13 +269,7 @@ ImpactSubscribePushBridge::executeExternalSerializedLmcpObjectReceiveProcessing(
             std::string message = n_ZMQ::s_recv(*subscriber);
 
             // ignore impact address, construct UxAS address from valid LMCP message
-            avtas::lmcp::ByteBuffer byteBuffer;
-            byteBuffer.allocate(message.size());
-            byteBuffer.put(reinterpret_cast<const uint8_t*> (message.c_str()), message.size());
-            byteBuffer.rewind();
-
-            std::shared_ptr<avtas::lmcp::Object> ptr_Object;
-            ptr_Object.reset(avtas::lmcp::Factory::getObject(byteBuffer));
+            std::shared_ptr<avtas::lmcp::Object> ptr_Object = LmcpObjectSerializer::deserialize(message);
             
             if(ptr_Object)
             {
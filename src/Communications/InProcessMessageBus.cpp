@@ -0,0 +1,274 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#include "InProcessMessageBus.h"
+
+#include "LmcpObjectSerializer.h"
+
+#include "UxAS_Log.h"
+
+#include "Constants/UxAS_String.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace uxas
+{
+namespace communications
+{
+namespace transport
+{
+
+void
+InProcessMessage::setReceiverCount(uint32_t receiverCount)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_receiverCount = receiverCount;
+};
+
+std::shared_ptr<avtas::lmcp::Object>
+InProcessMessage::takeObject()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_object && m_payload && m_contentType == uxas::common::ContentType::lmcp())
+    {
+        m_object = uxas::communications::LmcpObjectSerializer::deserialize(*m_payload);
+    }
+    if (m_receiverCount > 1)
+    {
+        m_receiverCount--;
+        return (m_object ? std::shared_ptr<avtas::lmcp::Object>(m_object->clone()) : nullptr);
+    }
+    // the other receivers are done with the object, so the last one can take it
+    m_receiverCount = 0;
+    std::shared_ptr<avtas::lmcp::Object> object;
+    object.swap(m_object);
+    return (object);
+};
+
+std::shared_ptr<const std::string>
+InProcessMessage::takePayload()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_payload && m_object)
+    {
+        m_payload = uxas::communications::LmcpObjectSerializer::serialize(m_object.get());
+    }
+    if (m_receiverCount > 0)
+    {
+        m_receiverCount--;
+    }
+    return (m_payload);
+};
+
+void
+InProcessMessage::release()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_receiverCount > 0)
+    {
+        m_receiverCount--;
+    }
+};
+
+bool
+InProcessMessage::getLmcpTypeIds(int64_t& seriesId, uint32_t& typeId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_object)
+    {
+        seriesId = m_object->getSeriesNameAsLong();
+        typeId = m_object->getLmcpType();
+        return (true);
+    }
+    return (m_payload && uxas::communications::LmcpObjectSerializer::getLmcpTypeIds(*m_payload, seriesId, typeId));
+};
+
+bool
+InProcessMessageQueue::push(const std::shared_ptr<InProcessMessage>& message)
+{
+    uint64_t droppedMessageCount{0};
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_messages.size() < m_highWaterMark)
+        {
+            m_messages.push_back(message);
+            m_size.store(m_messages.size(), std::memory_order_relaxed);
+        }
+        else
+        {
+            droppedMessageCount = ++m_droppedMessageCount;
+        }
+    }
+    if (droppedMessageCount > 0)
+    {
+        if (droppedMessageCount == 1 || droppedMessageCount % 10000 == 0)
+        {
+            UXAS_LOG_WARN("InProcessMessageQueue::push queue of entity ", m_entityIdString, " service ", m_serviceIdString,
+                          " is at its high-water mark [", m_highWaterMark, "], dropped [", droppedMessageCount, "] messages");
+        }
+        return (false);
+    }
+    m_condition.notify_one();
+    return (true);
+};
+
+std::shared_ptr<InProcessMessage>
+InProcessMessageQueue::pop(int32_t waitTime_ms)
+{
+    std::shared_ptr<InProcessMessage> message;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (waitTime_ms < 0)
+    {
+        m_condition.wait(lock, [this] { return (!m_messages.empty()); });
+    }
+    else if (m_messages.empty())
+    {
+        m_condition.wait_for(lock, std::chrono::milliseconds(waitTime_ms), [this] { return (!m_messages.empty()); });
+    }
+    if (!m_messages.empty())
+    {
+        message = std::move(m_messages.front());
+        m_messages.pop_front();
+        m_size.store(m_messages.size(), std::memory_order_relaxed);
+    }
+    return (message);
+};
+
+std::unique_ptr<InProcessMessageBus> InProcessMessageBus::s_instance = nullptr;
+
+InProcessMessageBus&
+InProcessMessageBus::getInstance()
+{
+    // first time/one time creation (services may initialize concurrently)
+    static std::once_flag s_createFlag;
+    std::call_once(s_createFlag, [] { s_instance.reset(new InProcessMessageBus); });
+    return *s_instance;
+};
+
+InProcessMessageBus::InProcessMessageBus()
+: m_subscriptionIndex(std::make_shared<const SubscriptionIndex>())
+{
+};
+
+void
+InProcessMessageBus::subscribe(const std::string& address, const std::shared_ptr<InProcessMessageQueue>& queue)
+{
+    std::lock_guard<std::mutex> lock(m_subscriptionMutex);
+    auto index = std::make_shared<SubscriptionIndex>(*std::atomic_load(&m_subscriptionIndex));
+    auto& queues = index->m_queuesByAddress[address];
+    if (std::find(queues.begin(), queues.end(), queue) == queues.end())
+    {
+        queues.push_back(queue);
+    }
+    updateAddressLengths(*index);
+    std::atomic_store(&m_subscriptionIndex, std::shared_ptr<const SubscriptionIndex>(std::move(index)));
+};
+
+void
+InProcessMessageBus::unsubscribe(const std::string& address, const std::shared_ptr<InProcessMessageQueue>& queue)
+{
+    std::lock_guard<std::mutex> lock(m_subscriptionMutex);
+    auto index = std::make_shared<SubscriptionIndex>(*std::atomic_load(&m_subscriptionIndex));
+    auto queuesIt = index->m_queuesByAddress.find(address);
+    if (queuesIt != index->m_queuesByAddress.end())
+    {
+        queuesIt->second.erase(std::remove(queuesIt->second.begin(), queuesIt->second.end(), queue), queuesIt->second.end());
+        if (queuesIt->second.empty())
+        {
+            index->m_queuesByAddress.erase(queuesIt);
+        }
+    }
+    updateAddressLengths(*index);
+    std::atomic_store(&m_subscriptionIndex, std::shared_ptr<const SubscriptionIndex>(std::move(index)));
+};
+
+void
+InProcessMessageBus::unsubscribeAll(const std::shared_ptr<InProcessMessageQueue>& queue)
+{
+    std::lock_guard<std::mutex> lock(m_subscriptionMutex);
+    auto index = std::make_shared<SubscriptionIndex>(*std::atomic_load(&m_subscriptionIndex));
+    for (auto queuesIt = index->m_queuesByAddress.begin(); queuesIt != index->m_queuesByAddress.end();)
+    {
+        queuesIt->second.erase(std::remove(queuesIt->second.begin(), queuesIt->second.end(), queue), queuesIt->second.end());
+        if (queuesIt->second.empty())
+        {
+            queuesIt = index->m_queuesByAddress.erase(queuesIt);
+        }
+        else
+        {
+            queuesIt++;
+        }
+    }
+    updateAddressLengths(*index);
+    std::atomic_store(&m_subscriptionIndex, std::shared_ptr<const SubscriptionIndex>(std::move(index)));
+};
+
+uint32_t
+InProcessMessageBus::publish(const std::shared_ptr<InProcessMessage>& message)
+{
+    std::shared_ptr<const SubscriptionIndex> index = std::atomic_load(&m_subscriptionIndex);
+    const std::string& address = message->getAddress();
+
+    // only prefixes with the length of some subscription can match
+    std::vector<InProcessMessageQueue*> receiverQueues;
+    for (size_t length : index->m_addressLengths)
+    {
+        if (length > address.size())
+        {
+            break;
+        }
+        auto queuesIt = index->m_queuesByAddress.find(length == address.size() ? address : address.substr(0, length));
+        if (queuesIt == index->m_queuesByAddress.end())
+        {
+            continue;
+        }
+        for (const auto& queue : queuesIt->second)
+        {
+            if (queue->m_entityIdString == message->getSourceEntityId() && queue->m_serviceIdString == message->getSourceServiceId())
+            {
+                continue;
+            }
+            if (std::find(receiverQueues.begin(), receiverQueues.end(), queue.get()) == receiverQueues.end())
+            {
+                receiverQueues.push_back(queue.get());
+            }
+        }
+    }
+
+    // the count is set before the first receiver can take the message
+    message->setReceiverCount(static_cast<uint32_t>(receiverQueues.size()));
+    uint32_t queuedCount{0};
+    for (auto queue : receiverQueues)
+    {
+        if (queue->push(message))
+        {
+            queuedCount++;
+        }
+        else
+        {
+            message->release();
+        }
+    }
+    return (queuedCount);
+};
+
+void
+InProcessMessageBus::updateAddressLengths(SubscriptionIndex& index)
+{
+    index.m_addressLengths.clear();
+    for (const auto& queues : index.m_queuesByAddress)
+    {
+        index.m_addressLengths.insert(queues.first.size());
+    }
+};
+
+}; //namespace transport
+}; //namespace communications
+}; //namespace uxas
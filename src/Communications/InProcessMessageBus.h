@@ -0,0 +1,306 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_MESSAGE_TRANSPORT_IN_PROCESS_MESSAGE_BUS_H
+#define UXAS_MESSAGE_TRANSPORT_IN_PROCESS_MESSAGE_BUS_H
+
+#include "avtas/lmcp/Object.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace uxas
+{
+namespace communications
+{
+namespace transport
+{
+
+/** \class InProcessMessage
+ * 
+ * \par Description:
+ * Message exchanged on the in-process message bus. One instance is shared by 
+ * all subscribers. An <b>LMCP</b> message carries its object, its serialized 
+ * payload or both; the missing representation is created on first request 
+ * (once) and then shared, so a message sent and received as an object is 
+ * never serialized. Receivers may modify received objects, so each receiver 
+ * takes its own object: all but the last receiver get a copy, the last one 
+ * gets the sent object. Each receiver calls exactly one of 
+ * <B><i>takeObject</i></B>, <B><i>takePayload</i></B> or 
+ * <B><i>release</i></B>.
+ * 
+ * \n
+ */
+class InProcessMessage final
+{
+public:
+
+    static const std::string&
+    s_typeName() { static std::string s_string("InProcessMessage"); return (s_string); };
+
+    InProcessMessage(const std::string& address, const std::string& contentType, const std::string& descriptor,
+                     const std::string& sourceGroup, const std::string& sourceEntityId, const std::string& sourceServiceId,
+                     const std::shared_ptr<avtas::lmcp::Object>& object, const std::shared_ptr<const std::string>& payload)
+    : m_address(address), m_contentType(contentType), m_descriptor(descriptor), m_sourceGroup(sourceGroup),
+    m_sourceEntityId(sourceEntityId), m_sourceServiceId(sourceServiceId), m_sendTime(std::chrono::steady_clock::now()),
+    m_object(object), m_payload(payload) { };
+
+private:
+
+    /** \brief Copy construction not permitted */
+    InProcessMessage(InProcessMessage const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(InProcessMessage const&) = delete;
+
+public:
+
+    const std::string&
+    getAddress() const { return (m_address); };
+
+    const std::string&
+    getContentType() const { return (m_contentType); };
+
+    const std::string&
+    getDescriptor() const { return (m_descriptor); };
+
+    const std::string&
+    getSourceGroup() const { return (m_sourceGroup); };
+
+    const std::string&
+    getSourceEntityId() const { return (m_sourceEntityId); };
+
+    const std::string&
+    getSourceServiceId() const { return (m_sourceServiceId); };
+
+    /** \brief Time the message was created (sent), used to measure receive 
+     * queue wait times. */
+    const std::chrono::steady_clock::time_point&
+    getSendTime() const { return (m_sendTime); };
+
+    /** \brief Sets the number of receivers the message is delivered to 
+     * (before it is delivered). */
+    void
+    setReceiverCount(uint32_t receiverCount);
+
+    /** \brief <b>LMCP</b> object owned by the calling receiver (deserialized 
+     * on first request if the message was sent serialized); a copy unless 
+     * the calling receiver is the last one.
+     * 
+     * @return <b>LMCP</b> object; empty pointer if not an <b>LMCP</b> message 
+     * or deserialization fails.
+     */
+    std::shared_ptr<avtas::lmcp::Object>
+    takeObject();
+
+    /** \brief Serialized payload (serialized on first request if the message 
+     * was sent as an object).
+     * 
+     * @return serialized payload; empty pointer if serialization fails.
+     */
+    std::shared_ptr<const std::string>
+    takePayload();
+
+    /** \brief Releases the message without taking it (e.g., filtered out or 
+     * dropped). */
+    void
+    release();
+
+    /** \brief Series ID and type ID of the <b>LMCP</b> message, read from the 
+     * object or from the serialized payload header (never deserializes).
+     * 
+     * @param seriesId series ID (series name as long)
+     * @param typeId type ID within the series
+     * @return true if the IDs are known
+     */
+    bool
+    getLmcpTypeIds(int64_t& seriesId, uint32_t& typeId);
+
+private:
+
+    std::string m_address;
+    std::string m_contentType;
+    std::string m_descriptor;
+    std::string m_sourceGroup;
+    std::string m_sourceEntityId;
+    std::string m_sourceServiceId;
+    std::chrono::steady_clock::time_point m_sendTime;
+
+    std::mutex m_mutex;
+    std::shared_ptr<avtas::lmcp::Object> m_object;
+    std::shared_ptr<const std::string> m_payload;
+    /** \brief receivers that have not taken or released the message */
+    uint32_t m_receiverCount{0};
+
+};
+
+/** \class InProcessMessageQueue
+ * 
+ * \par Description:
+ * Receive queue of one in-process subscriber. Held by shared pointer so that 
+ * a publisher holding a subscription snapshot can deliver to a queue whose 
+ * receiver is being destroyed.
+ * 
+ * \n
+ */
+class InProcessMessageQueue final
+{
+public:
+
+    /** \brief Constructs the queue.
+     * 
+     * @param entityIdString entity ID of the owning receiver
+     * @param serviceIdString service ID of the owning receiver
+     * @param highWaterMark maximum number of queued messages; further 
+     * messages are dropped (as by a Zero MQ SUB socket at its high-water mark)
+     */
+    InProcessMessageQueue(const std::string& entityIdString, const std::string& serviceIdString, size_t highWaterMark)
+    : m_entityIdString(entityIdString), m_serviceIdString(serviceIdString), m_highWaterMark(highWaterMark) { };
+
+private:
+
+    /** \brief Copy construction not permitted */
+    InProcessMessageQueue(InProcessMessageQueue const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(InProcessMessageQueue const&) = delete;
+
+public:
+
+    /** \brief Queues the message unless the queue is at its high-water mark.
+     * 
+     * @param message message to queue
+     * @return true if queued; false if dropped
+     */
+    bool
+    push(const std::shared_ptr<InProcessMessage>& message);
+
+    /** \brief Next queued message, waiting up to wait duration if the queue 
+     * is empty (negative wait blocks until a message arrives).
+     * 
+     * @param waitTime_ms wait duration in milliseconds
+     * @return next message; empty pointer if none arrived.
+     */
+    std::shared_ptr<InProcessMessage>
+    pop(int32_t waitTime_ms);
+
+    /** \brief Number of queued messages (read without locking). */
+    size_t
+    size() const { return (m_size.load(std::memory_order_relaxed)); };
+
+    /** \brief Number of messages dropped at the high-water mark. */
+    uint64_t
+    getDroppedMessageCount() const { return (m_droppedMessageCount.load(std::memory_order_relaxed)); };
+
+    /** \brief Entity and service ID of the owning receiver (messages sent 
+     * from the same IDs are not delivered). */
+    const std::string m_entityIdString;
+    const std::string m_serviceIdString;
+
+private:
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque< std::shared_ptr<InProcessMessage> > m_messages;
+    std::atomic<size_t> m_size{0};
+    const size_t m_highWaterMark;
+    std::atomic<uint64_t> m_droppedMessageCount{0};
+
+};
+
+/** \class InProcessMessageBus
+ * 
+ * \par Description:
+ * Process-wide publish/subscribe bus that delivers shared messages directly 
+ * to subscriber queues (no sockets, no serialization). Subscriptions follow 
+ * Zero MQ SUB semantics: a subscription address matches any message address 
+ * that it prefixes, a subscriber receives each message once, and messages to 
+ * a full queue are dropped. Publishers 
+ * read an immutable subscription index snapshot; subscription changes 
+ * replace the snapshot (copy-on-write).
+ * 
+ * \n
+ */
+class InProcessMessageBus final
+{
+public:
+
+    static const std::string&
+    s_typeName() { static std::string s_string("InProcessMessageBus"); return (s_string); };
+
+    static InProcessMessageBus&
+    getInstance();
+
+    ~InProcessMessageBus() { };
+
+private:
+
+    /** \brief Public, direct construction not permitted (singleton pattern) */
+    InProcessMessageBus();
+
+    /** \brief Copy construction not permitted */
+    InProcessMessageBus(InProcessMessageBus const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(InProcessMessageBus const&) = delete;
+
+public:
+
+    void
+    subscribe(const std::string& address, const std::shared_ptr<InProcessMessageQueue>& queue);
+
+    void
+    unsubscribe(const std::string& address, const std::shared_ptr<InProcessMessageQueue>& queue);
+
+    void
+    unsubscribeAll(const std::shared_ptr<InProcessMessageQueue>& queue);
+
+    /** \brief Deliver a message to every subscriber whose subscription 
+     * address prefixes the message address (except the sender).
+     * 
+     * @param message message to deliver
+     * @return number of subscribers the message was queued for
+     */
+    uint32_t
+    publish(const std::shared_ptr<InProcessMessage>& message);
+
+private:
+
+    struct SubscriptionIndex
+    {
+        std::unordered_map< std::string, std::vector< std::shared_ptr<InProcessMessageQueue> > > m_queuesByAddress;
+        std::set<size_t> m_addressLengths;
+    };
+
+    void
+    updateAddressLengths(SubscriptionIndex& index);
+
+    static std::unique_ptr<InProcessMessageBus> s_instance;
+
+    /** \brief serializes subscription changes (publishers do not lock) */
+    std::mutex m_subscriptionMutex;
+
+    std::shared_ptr<const SubscriptionIndex> m_subscriptionIndex;
+
+};
+
+}; //namespace transport
+}; //namespace communications
+}; //namespace uxas
+
+#endif /* UXAS_MESSAGE_TRANSPORT_IN_PROCESS_MESSAGE_BUS_H */
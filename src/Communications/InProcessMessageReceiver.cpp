@@ -0,0 +1,74 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#include "InProcessMessageReceiver.h"
+
+#include "UxAS_ConfigurationManager.h"
+#include "UxAS_Log.h"
+
+namespace uxas
+{
+namespace communications
+{
+namespace transport
+{
+
+InProcessMessageReceiver::~InProcessMessageReceiver()
+{
+    if (m_queue)
+    {
+        InProcessMessageBus::getInstance().unsubscribeAll(m_queue);
+    }
+};
+
+void
+InProcessMessageReceiver::initialize(uint32_t entityId, uint32_t serviceId, size_t highWaterMark)
+{
+    m_entityId = entityId;
+    m_serviceId = serviceId;
+    m_queue = std::make_shared<InProcessMessageQueue>(std::to_string(entityId), std::to_string(serviceId), highWaterMark);
+};
+
+std::shared_ptr<InProcessMessage>
+InProcessMessageReceiver::getNextMessage()
+{
+    std::shared_ptr<InProcessMessage> nextMsg;
+    if (m_queue)
+    {
+        nextMsg = m_queue->pop(uxas::common::ConfigurationManager::getZeroMqReceiveSocketPollWaitTime_ms());
+    }
+    return (nextMsg);
+};
+
+bool
+InProcessMessageReceiver::addSubscriptionAddressToSocket(const std::string& address)
+{
+    if (!m_queue)
+    {
+        UXAS_LOG_ERROR("InProcessMessageReceiver::addSubscriptionAddressToSocket receiver has not been initialized");
+        return (false);
+    }
+    InProcessMessageBus::getInstance().subscribe(address, m_queue);
+    return (true);
+};
+
+bool
+InProcessMessageReceiver::removeSubscriptionAddressFromSocket(const std::string& address)
+{
+    if (!m_queue)
+    {
+        return (false);
+    }
+    InProcessMessageBus::getInstance().unsubscribe(address, m_queue);
+    return (true);
+};
+
+}; //namespace transport
+}; //namespace communications
+}; //namespace uxas
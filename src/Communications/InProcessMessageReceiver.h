@@ -0,0 +1,98 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_MESSAGE_TRANSPORT_IN_PROCESS_MESSAGE_RECEIVER_H
+#define UXAS_MESSAGE_TRANSPORT_IN_PROCESS_MESSAGE_RECEIVER_H
+
+#include "TransportReceiverBase.h"
+
+#include "InProcessMessageBus.h"
+
+#include <memory>
+#include <string>
+
+namespace uxas
+{
+namespace communications
+{
+namespace transport
+{
+
+/** \class InProcessMessageReceiver
+ * 
+ * \par Description:
+ * Receives messages from the in-process message bus. Subscription addresses 
+ * have the same (prefix) semantics as a Zero MQ SUB socket.
+ * 
+ * \n
+ */
+class InProcessMessageReceiver : public TransportReceiverBase
+{
+
+public:
+
+    InProcessMessageReceiver()
+    : TransportReceiverBase() { };
+
+    ~InProcessMessageReceiver();
+
+private:
+
+    /** \brief Copy construction not permitted */
+    InProcessMessageReceiver(InProcessMessageReceiver const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(InProcessMessageReceiver const&) = delete;
+
+public:
+
+    /** \brief Creates the receive queue.
+     * 
+     * @param entityId entity ID of the receiver
+     * @param serviceId service ID of the receiver
+     * @param highWaterMark maximum number of queued messages (further 
+     * messages are dropped)
+     */
+    void
+    initialize(uint32_t entityId, uint32_t serviceId, size_t highWaterMark);
+
+    /** \brief Get next message, waiting up to the configured Zero MQ receive 
+     * poll wait duration.
+     * 
+     * @return next message; empty pointer if none is available.
+     */
+    std::shared_ptr<InProcessMessage>
+    getNextMessage();
+
+    /** \brief Number of messages waiting in the receive queue.
+     * 
+     * @return queue depth; 0 if not initialized
+     */
+    size_t
+    getQueueDepth() const { return (m_queue ? m_queue->size() : 0); };
+
+protected:
+
+    bool
+    addSubscriptionAddressToSocket(const std::string& address) override;
+
+    bool
+    removeSubscriptionAddressFromSocket(const std::string& address) override;
+
+private:
+
+    std::shared_ptr<InProcessMessageQueue> m_queue;
+
+};
+
+}; //namespace transport
+}; //namespace communications
+}; //namespace uxas
+
+#endif /* UXAS_MESSAGE_TRANSPORT_IN_PROCESS_MESSAGE_RECEIVER_H */
@@ -0,0 +1,74 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#include "InProcessMessageSender.h"
+
+#include "UxAS_Log.h"
+
+#include "Constants/UxAS_String.h"
+
+namespace uxas
+{
+namespace communications
+{
+namespace transport
+{
+
+void
+InProcessMessageSender::initialize(const std::string& sourceGroup, uint32_t entityId, uint32_t serviceId)
+{
+    m_sourceGroup = sourceGroup;
+    m_entityId = entityId;
+    m_serviceId = serviceId;
+    m_entityIdString = std::to_string(entityId);
+    m_serviceIdString = std::to_string(serviceId);
+};
+
+void
+InProcessMessageSender::sendObjectMessage(const std::string& address, const std::shared_ptr<avtas::lmcp::Object>& lmcpObject)
+{
+    if (!lmcpObject || !uxas::communications::data::AddressedMessage::isValidAddress(address))
+    {
+        UXAS_LOG_WARN("InProcessMessageSender::sendObjectMessage invalid address or object - did not send message");
+        return;
+    }
+    InProcessMessageBus::getInstance().publish(std::make_shared<InProcessMessage>(address, uxas::common::ContentType::lmcp(),
+            lmcpObject->getFullLmcpTypeName(), m_sourceGroup, m_entityIdString, m_serviceIdString, lmcpObject, nullptr));
+};
+
+void
+InProcessMessageSender::sendSerializedMessage(const std::string& address, const std::string& contentType, const std::string& descriptor,
+                                              const std::shared_ptr<const std::string>& payload)
+{
+    if (!payload || payload->empty() || !uxas::communications::data::AddressedMessage::isValidAddress(address))
+    {
+        UXAS_LOG_WARN("InProcessMessageSender::sendSerializedMessage invalid address or empty payload - did not send message");
+        return;
+    }
+    InProcessMessageBus::getInstance().publish(std::make_shared<InProcessMessage>(address, contentType, descriptor,
+            m_sourceGroup, m_entityIdString, m_serviceIdString, nullptr, payload));
+};
+
+void
+InProcessMessageSender::sendAddressedAttributedMessage(std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> message)
+{
+    if (!message || !message->isValid())
+    {
+        UXAS_LOG_WARN("InProcessMessageSender::sendAddressedAttributedMessage ignoring invalid AddressedAttributedMessage object - did not send message");
+        return;
+    }
+    const std::unique_ptr<uxas::communications::data::MessageAttributes>& attributes = message->getMessageAttributesReference();
+    InProcessMessageBus::getInstance().publish(std::make_shared<InProcessMessage>(message->getAddress(), attributes->getContentType(),
+            attributes->getDescriptor(), attributes->getSourceGroup(), attributes->getSourceEntityId(), attributes->getSourceServiceId(),
+            nullptr, std::make_shared<const std::string>(message->getPayload())));
+};
+
+}; //namespace transport
+}; //namespace communications
+}; //namespace uxas
@@ -0,0 +1,103 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_MESSAGE_TRANSPORT_IN_PROCESS_MESSAGE_SENDER_H
+#define UXAS_MESSAGE_TRANSPORT_IN_PROCESS_MESSAGE_SENDER_H
+
+#include "TransportSenderBase.h"
+
+#include "AddressedAttributedMessage.h"
+#include "InProcessMessageBus.h"
+
+#include "avtas/lmcp/Object.h"
+
+#include <memory>
+#include <string>
+
+namespace uxas
+{
+namespace communications
+{
+namespace transport
+{
+
+/** \class InProcessMessageSender
+ * 
+ * \par Description:
+ * Publishes messages on the in-process message bus. <b>LMCP</b> objects are 
+ * delivered as objects (the last receiver gets the sent object, the others 
+ * copies); serialized messages (e.g., received by bridges) are delivered as 
+ * shared payloads.
+ * 
+ * \n
+ */
+class InProcessMessageSender : public TransportSenderBase
+{
+
+public:
+
+    InProcessMessageSender()
+    : TransportSenderBase() { };
+
+    ~InProcessMessageSender() { };
+
+private:
+
+    /** \brief Copy construction not permitted */
+    InProcessMessageSender(InProcessMessageSender const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(InProcessMessageSender const&) = delete;
+
+public:
+
+    void
+    initialize(const std::string& sourceGroup, uint32_t entityId, uint32_t serviceId);
+
+    /** \brief Publish an <b>LMCP</b> object without serializing it. The 
+     * object is handed to a receiver and must not be used after sending.
+     * 
+     * @param address message publish address
+     * @param lmcpObject object to publish
+     */
+    void
+    sendObjectMessage(const std::string& address, const std::shared_ptr<avtas::lmcp::Object>& lmcpObject);
+
+    /** \brief Publish a serialized payload.
+     * 
+     * @param address message publish address
+     * @param contentType payload content type
+     * @param descriptor payload descriptor
+     * @param payload shared, immutable payload
+     */
+    void
+    sendSerializedMessage(const std::string& address, const std::string& contentType, const std::string& descriptor,
+                          const std::shared_ptr<const std::string>& payload);
+
+    /** \brief Publish a serialized message, retaining its source attributes 
+     * (used to forward messages).
+     * 
+     * @param message message to publish
+     */
+    void
+    sendAddressedAttributedMessage(std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> message);
+
+private:
+
+    std::string m_sourceGroup;
+    std::string m_entityIdString;
+    std::string m_serviceIdString;
+
+};
+
+}; //namespace transport
+}; //namespace communications
+}; //namespace uxas
+
+#endif /* UXAS_MESSAGE_TRANSPORT_IN_PROCESS_MESSAGE_SENDER_H */
@@ -16,6 +16,7 @@
 
 #include "stdUniquePtr.h"
 
+#include <chrono>
 #include <string>
 #include <tuple>
 
@@ -46,6 +47,12 @@ public:
         m_object = std::move(lmcpObject);
     };
 
+    LmcpMessage(std::unique_ptr<MessageAttributes> messageAttributes, std::shared_ptr<avtas::lmcp::Object> lmcpObject)
+    {
+        m_attributes = std::move(messageAttributes);
+        m_object = std::move(lmcpObject);
+    };
+
     /** \brief Message attributes associated with the payload.
      * 
      * @return message attributes
@@ -58,6 +65,16 @@ public:
      */
     std::shared_ptr<avtas::lmcp::Object> m_object;
 
+    /** \brief Subscription address on which the message was received (set by
+     * the receiver pipe; empty for locally constructed messages).
+     */
+    std::string m_address;
+
+    /** \brief Time the message was sent, if known (in-process message bus or 
+     * message envelope); otherwise default constructed (clock epoch).
+     */
+    std::chrono::steady_clock::time_point m_sendTime;
+
 };
 
 }; //namespace data
@@ -10,12 +10,14 @@
 #include "LmcpObjectMessageReceiverPipe.h"
 
 #include "LmcpMessage.h"
+#include "LmcpObjectSerializer.h"
 #include "MessageAttributes.h"
 #include "ZeroMqSocketConfiguration.h"
 
 #include "avtas/lmcp/ByteBuffer.h"
 #include "avtas/lmcp/Factory.h"
 
+#include "UxAS_ConfigurationManager.h"
 #include "UxAS_Log.h"
 #include "Constants/UxAS_String.h"
 
@@ -50,8 +52,23 @@ LmcpObjectMessageReceiverPipe::initializeExternalSubscription(uint32_t entityId,
 void
 LmcpObjectMessageReceiverPipe::initializeSubscription(uint32_t entityId, uint32_t serviceId)
 {
+    if (uxas::common::ConfigurationManager::getIsInProcessMessageBus())
+    {
+        m_entityId = entityId;
+        m_serviceId = serviceId;
+        // bounded as the Zero MQ receive socket
+        uint32_t highWaterMark{100000};
+        m_inProcessReceiver = uxas::stduxas::make_unique<uxas::communications::transport::InProcessMessageReceiver>();
+        m_inProcessReceiver->initialize(m_entityId, m_serviceId, highWaterMark);
+        return;
+    }
     initializeZmqSocket(entityId, serviceId, ZMQ_SUB,
                         uxas::common::LmcpNetworkSocketAddress::strGetInProc_FromMessageHub(), false);
+    // a sharded hub publishes from one socket per worker
+    for (uint32_t shardIndex = 1; shardIndex < uxas::common::ConfigurationManager::getNetworkServerWorkerCount(); shardIndex++)
+    {
+        m_transportReceiver->connectSocketAddress(uxas::common::LmcpNetworkSocketAddress::strGetInProc_FromMessageHub(shardIndex));
+    }
 };
 
 void
@@ -90,24 +107,68 @@ LmcpObjectMessageReceiverPipe::initializeZmqSocket(uint32_t entityId, uint32_t s
 bool
 LmcpObjectMessageReceiverPipe::addLmcpObjectSubscriptionAddress(const std::string& address)
 {
+    if (m_inProcessReceiver)
+    {
+        return (m_inProcessReceiver->addSubscriptionAddress(address));
+    }
     return (m_transportReceiver->addSubscriptionAddress(address));
 };
 
 bool
 LmcpObjectMessageReceiverPipe::removeLmcpObjectSubscriptionAddress(const std::string& address)
 {
+    if (m_inProcessReceiver)
+    {
+        return (m_inProcessReceiver->removeSubscriptionAddress(address));
+    }
     return (m_transportReceiver->removeSubscriptionAddress(address));
 };
 
 bool
 LmcpObjectMessageReceiverPipe::removeAllLmcpObjectSubscriptionAddresses()
 {
+    if (m_inProcessReceiver)
+    {
+        return (m_inProcessReceiver->removeAllSubscriptionAddresses());
+    }
     return (m_transportReceiver->removeAllSubscriptionAddresses());
 };
 
 std::unique_ptr<uxas::communications::data::LmcpMessage>
 LmcpObjectMessageReceiverPipe::getNextMessageObject()
 {
+    if (m_inProcessReceiver)
+    {
+        // in-process messages are delivered as objects (no deserialization), a copy per receiver
+        std::shared_ptr<uxas::communications::transport::InProcessMessage> nextInProcessMessage = m_inProcessReceiver->getNextMessage();
+        int64_t seriesId{0};
+        uint32_t typeId{0};
+        if (nextInProcessMessage && m_lmcpTypeFilter
+                && nextInProcessMessage->getLmcpTypeIds(seriesId, typeId)
+                && !isAcceptedLmcpType(seriesId, typeId, nextInProcessMessage->getDescriptor()))
+        {
+            // not accepted (never deserialized by this receiver)
+            nextInProcessMessage->release();
+            nextInProcessMessage.reset();
+        }
+        if (nextInProcessMessage)
+        {
+            std::shared_ptr<avtas::lmcp::Object> lmcpObject = nextInProcessMessage->takeObject();
+            std::unique_ptr<uxas::communications::data::MessageAttributes> messageAttributes
+                    = uxas::stduxas::make_unique<uxas::communications::data::MessageAttributes>();
+            if (lmcpObject && messageAttributes->setAttributes(nextInProcessMessage->getContentType(), nextInProcessMessage->getDescriptor(),
+                    nextInProcessMessage->getSourceGroup(), nextInProcessMessage->getSourceEntityId(), nextInProcessMessage->getSourceServiceId()))
+            {
+                std::unique_ptr<uxas::communications::data::LmcpMessage> lmcpMessage
+                        = uxas::stduxas::make_unique<uxas::communications::data::LmcpMessage>(std::move(messageAttributes), std::move(lmcpObject));
+                lmcpMessage->m_address = nextInProcessMessage->getAddress();
+                lmcpMessage->m_sendTime = nextInProcessMessage->getSendTime();
+                return (lmcpMessage);
+            }
+        }
+        return (std::unique_ptr<uxas::communications::data::LmcpMessage>());
+    }
+
     // get next zero mq message
     // limit attempts on each receiver to one
     std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> nextZeroMqMessage
@@ -115,6 +176,16 @@ LmcpObjectMessageReceiverPipe::getNextMessageObject()
 
     // process zero mq message
     // (false implies no message retrieved since receiver "queues" were empty)
+    int64_t seriesId{0};
+    uint32_t typeId{0};
+    if (nextZeroMqMessage && m_lmcpTypeFilter
+            && LmcpObjectSerializer::getLmcpTypeIds(nextZeroMqMessage->getPayload(), seriesId, typeId)
+            && !isAcceptedLmcpType(seriesId, typeId, nextZeroMqMessage->getMessageAttributesReference()->getDescriptor()))
+    {
+        // not accepted - skip deserialization
+        nextZeroMqMessage.reset();
+    }
+
     if (nextZeroMqMessage)
     {
         // deserialize
@@ -124,6 +195,8 @@ LmcpObjectMessageReceiverPipe::getNextMessageObject()
             std::unique_ptr<uxas::communications::data::LmcpMessage> lmcpMessage 
                     = uxas::stduxas::make_unique<uxas::communications::data::LmcpMessage>
               (nextZeroMqMessage->getMessageAttributesOwnership(), std::move(lmcpObject));
+            lmcpMessage->m_address = nextZeroMqMessage->getAddress();
+            lmcpMessage->m_sendTime = nextZeroMqMessage->getSendTime();
             return (lmcpMessage);
         }
     }
@@ -137,6 +210,27 @@ LmcpObjectMessageReceiverPipe::getNextMessageObject()
 std::unique_ptr<uxas::communications::data::AddressedAttributedMessage>
 LmcpObjectMessageReceiverPipe::getNextSerializedMessage()
 {
+    if (m_inProcessReceiver)
+    {
+        std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> serializedMessage;
+        std::shared_ptr<uxas::communications::transport::InProcessMessage> nextInProcessMessage = m_inProcessReceiver->getNextMessage();
+        std::shared_ptr<const std::string> payload = nextInProcessMessage ? nextInProcessMessage->takePayload() : nullptr;
+        if (payload)
+        {
+            serializedMessage = uxas::stduxas::make_unique<uxas::communications::data::AddressedAttributedMessage>();
+            if (!serializedMessage->setAddressAttributesAndPayload(nextInProcessMessage->getAddress(), nextInProcessMessage->getContentType(),
+                    nextInProcessMessage->getDescriptor(), nextInProcessMessage->getSourceGroup(), nextInProcessMessage->getSourceEntityId(),
+                    nextInProcessMessage->getSourceServiceId(), *payload))
+            {
+                serializedMessage.reset();
+            }
+            else
+            {
+                serializedMessage->setSendTime(nextInProcessMessage->getSendTime());
+            }
+        }
+        return (serializedMessage);
+    }
     return (m_transportReceiver->getNextMessage());
 };
 
@@ -144,26 +238,7 @@ LmcpObjectMessageReceiverPipe::getNextSerializedMessage()
 std::unique_ptr<avtas::lmcp::Object>
 LmcpObjectMessageReceiverPipe::deserializeMessage(const std::string& payload)
 {
-    std::unique_ptr<avtas::lmcp::Object> lmcpObject;
-
-    // allocate memory
-    avtas::lmcp::ByteBuffer lmcpByteBuffer;
-    lmcpByteBuffer.allocate(payload.size());
-    lmcpByteBuffer.rewind();
-
-    for (size_t charIndex = 0; charIndex < payload.size(); charIndex++)
-    {
-        lmcpByteBuffer.putByte(payload[charIndex]); // TODO REVIEW
-    }
-    lmcpByteBuffer.rewind();
-    
-    lmcpObject.reset(avtas::lmcp::Factory::getObject(lmcpByteBuffer));
-    if (!lmcpObject)
-    {
-        UXAS_LOG_ERROR("LmcpObjectMessageReceiverPipe::deserializeMessage failed to convert message payload string into an LMCP object");
-    }
-
-    return (lmcpObject);
+    return (LmcpObjectSerializer::deserialize(payload));
 };
 
 }; //namespace communications
@@ -13,10 +13,12 @@
 #include "AddressedAttributedMessage.h"
 #include "LmcpMessage.h"
 
+#include "InProcessMessageReceiver.h"
 #include "ZeroMqAddressedAttributedMessageReceiver.h"
 
 #include "avtas/lmcp/Object.h"
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -37,6 +39,10 @@ class LmcpObjectMessageReceiverPipe
 {
 public:
 
+    /** \brief Returns true if messages of the <b>LMCP</b> type (series ID, 
+     * type ID, full type name) are to be deserialized and returned. */
+    typedef std::function<bool(int64_t seriesId, uint32_t typeId, const std::string& descriptor)> LmcpTypeFilter;
+
     LmcpObjectMessageReceiverPipe() { };
 
     ~LmcpObjectMessageReceiverPipe() { };
@@ -75,6 +81,24 @@ public:
     bool
     removeAllLmcpObjectSubscriptionAddresses();
     
+    /** \brief Set the filter applied by <B><i>getNextMessageObject</i></B>; 
+     * messages of rejected types are discarded before deserialization. Must 
+     * be set before receiving starts (not synchronized).
+     * 
+     * @param lmcpTypeFilter filter; empty accepts all types
+     */
+    void
+    setLmcpTypeFilter(LmcpTypeFilter lmcpTypeFilter) { m_lmcpTypeFilter = std::move(lmcpTypeFilter); };
+
+    /** \brief Whether messages of the <b>LMCP</b> type pass the filter (all 
+     * types pass if no filter is set).
+     */
+    bool
+    isAcceptedLmcpType(int64_t seriesId, uint32_t typeId, const std::string& descriptor) const
+    {
+        return (!m_lmcpTypeFilter || m_lmcpTypeFilter(seriesId, typeId, descriptor));
+    };
+
     /** \brief Get next LMCP message.
      * 
      * @return <b>LMCP</b> message object.
@@ -88,6 +112,23 @@ public:
     std::unique_ptr<avtas::lmcp::Object>
     deserializeMessage(const std::string& payload);
 
+    /** \brief Number of messages waiting to be received.
+     * 
+     * @param queueDepth number of waiting messages
+     * @return true if known (in-process message bus); Zero MQ sockets do not 
+     * expose their queue depth
+     */
+    bool
+    getQueueDepth(size_t& queueDepth) const
+    {
+        if (m_inProcessReceiver)
+        {
+            queueDepth = m_inProcessReceiver->getQueueDepth();
+            return (true);
+        }
+        return (false);
+    };
+
 private:
 
     void
@@ -103,6 +144,12 @@ protected:
 
     std::unique_ptr<uxas::communications::transport::ZeroMqAddressedAttributedMessageReceiver> m_transportReceiver;
 
+    /** \brief In-process bus receiver (replaces <B><i>m_transportReceiver</i></B> 
+     * for the internal network when the in-process message bus is enabled). */
+    std::unique_ptr<uxas::communications::transport::InProcessMessageReceiver> m_inProcessReceiver;
+
+    LmcpTypeFilter m_lmcpTypeFilter;
+
 };
 
 }; //namespace communications
@@ -9,13 +9,12 @@
 
 #include "LmcpObjectMessageSenderPipe.h"
 
-#include "avtas/lmcp/ByteBuffer.h"
-#include "avtas/lmcp/Factory.h"
-
+#include "LmcpObjectSerializer.h"
 #include "ZeroMqSocketConfiguration.h"
 
 #include "SerialHelper.h"
 
+#include "UxAS_ConfigurationManager.h"
 #include "Constants/UxAS_String.h"
 
 #include "stdUniquePtr.h"
@@ -49,6 +48,14 @@ LmcpObjectMessageSenderPipe::initializeExternalPub(const std::string& sourceGrou
 void
 LmcpObjectMessageSenderPipe::initializePush(const std::string& sourceGroup, uint32_t entityId, uint32_t serviceId)
 {
+    if (uxas::common::ConfigurationManager::getIsInProcessMessageBus())
+    {
+        m_entityId = entityId;
+        m_serviceId = serviceId;
+        m_inProcessSender = uxas::stduxas::make_unique<uxas::communications::transport::InProcessMessageSender>();
+        m_inProcessSender->initialize(sourceGroup, m_entityId, m_serviceId);
+        return;
+    }
     initializeZmqSocket(sourceGroup, entityId, serviceId, ZMQ_PUSH,
                         uxas::common::LmcpNetworkSocketAddress::strGetInProc_ToMessageHub(), false);
 };
@@ -95,15 +102,23 @@ LmcpObjectMessageSenderPipe::sendBroadcastMessage(std::unique_ptr<avtas::lmcp::O
 void
 LmcpObjectMessageSenderPipe::sendLimitedCastMessage(const std::string& castAddress, std::unique_ptr<avtas::lmcp::Object> lmcpObject)
 {
-    avtas::lmcp::ByteBuffer* lmcpByteBuffer = avtas::lmcp::Factory::packMessage(lmcpObject.get(), true);
-    std::string serializedPayload = std::string(reinterpret_cast<char*>(lmcpByteBuffer->array()), lmcpByteBuffer->capacity());
-    delete lmcpByteBuffer;
-    m_transportSender->sendMessage(castAddress, uxas::common::ContentType::lmcp(), lmcpObject->getFullLmcpTypeName(), std::move(serializedPayload));
+    if (m_inProcessSender)
+    {
+        // ownership is transferred, so the object itself can be shared with receivers
+        m_inProcessSender->sendObjectMessage(castAddress, std::shared_ptr<avtas::lmcp::Object>(std::move(lmcpObject)));
+        return;
+    }
+    m_transportSender->sendSharedPayloadMessage(castAddress, uxas::common::ContentType::lmcp(), lmcpObject->getFullLmcpTypeName(), LmcpObjectSerializer::serialize(lmcpObject.get()));
 };
 
 void
 LmcpObjectMessageSenderPipe::sendSerializedMessage(std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> serializedLmcpObject)
 {
+    if (m_inProcessSender)
+    {
+        m_inProcessSender->sendAddressedAttributedMessage(std::move(serializedLmcpObject));
+        return;
+    }
     m_transportSender->sendAddressedAttributedMessage(std::move(serializedLmcpObject));
 };
 
@@ -118,10 +133,25 @@ LmcpObjectMessageSenderPipe::sendSharedBroadcastMessage(const std::shared_ptr<av
 void
 LmcpObjectMessageSenderPipe::sendSharedLimitedCastMessage(const std::string& castAddress, const std::shared_ptr<avtas::lmcp::Object>& lmcpObject)
 {
-    avtas::lmcp::ByteBuffer* lmcpByteBuffer = avtas::lmcp::Factory::packMessage(lmcpObject.get(), true);
-    std::string serializedPayload = std::string(reinterpret_cast<char*>(lmcpByteBuffer->array()), lmcpByteBuffer->capacity());
-    delete lmcpByteBuffer;
-    m_transportSender->sendMessage(castAddress, uxas::common::ContentType::lmcp(), lmcpObject->getFullLmcpTypeName(), std::move(serializedPayload));
+    if (m_inProcessSender)
+    {
+        // the sender keeps (and may modify) its object, so receivers get a
+        // snapshot - as they would from serialization
+        m_inProcessSender->sendObjectMessage(castAddress, std::shared_ptr<avtas::lmcp::Object>(lmcpObject->clone()));
+        return;
+    }
+    m_transportSender->sendSharedPayloadMessage(castAddress, uxas::common::ContentType::lmcp(), lmcpObject->getFullLmcpTypeName(), LmcpObjectSerializer::serialize(lmcpObject.get()));
+};
+
+void
+LmcpObjectMessageSenderPipe::sendSharedSerializedMessage(const std::string& castAddress, const uxas::communications::data::SerializedLmcpObject& serializedLmcpObject)
+{
+    if (m_inProcessSender)
+    {
+        m_inProcessSender->sendSerializedMessage(castAddress, uxas::common::ContentType::lmcp(), serializedLmcpObject.getDescriptor(), serializedLmcpObject.getPayload());
+        return;
+    }
+    m_transportSender->sendSharedPayloadMessage(castAddress, uxas::common::ContentType::lmcp(), serializedLmcpObject.getDescriptor(), serializedLmcpObject.getPayload());
 };
 
 }; //namespace communications
@@ -10,6 +10,8 @@
 #ifndef UXAS_MESSAGE_LMCP_OBJECT_MESSAGE_SENDER_PIPE_H
 #define UXAS_MESSAGE_LMCP_OBJECT_MESSAGE_SENDER_PIPE_H
 
+#include "InProcessMessageSender.h"
+#include "SerializedLmcpObject.h"
 #include "ZeroMqAddressedAttributedMessageSender.h"
 
 #include "avtas/lmcp/Object.h"
@@ -79,6 +81,16 @@ public:
     void
     sendSharedLimitedCastMessage(const std::string& castAddress, const std::shared_ptr<avtas::lmcp::Object>& lmcpObject);
 
+    /** \brief Send an already serialized <b>LMCP</b> object. The serialized 
+     * payload is shared (not copied), so the same <B><i>SerializedLmcpObject</i></B> 
+     * can be sent to any number of addresses for the cost of one serialization.
+     * 
+     * @param castAddress message publish address
+     * @param serializedLmcpObject serialize-once <b>LMCP</b> object
+     */
+    void
+    sendSharedSerializedMessage(const std::string& castAddress, const uxas::communications::data::SerializedLmcpObject& serializedLmcpObject);
+
 private:
 
     void
@@ -94,6 +106,10 @@ private:
 
     std::unique_ptr<uxas::communications::transport::ZeroMqAddressedAttributedMessageSender> m_transportSender;
 
+    /** \brief In-process bus sender (replaces <B><i>m_transportSender</i></B> 
+     * for the internal network when the in-process message bus is enabled). */
+    std::unique_ptr<uxas::communications::transport::InProcessMessageSender> m_inProcessSender;
+
 };
 
 }; //namespace communications
@@ -10,6 +10,7 @@
 #include "LmcpObjectMessageTcpReceiverSenderPipe.h"
 
 #include "LmcpMessage.h"
+#include "LmcpObjectSerializer.h"
 #include "MessageAttributes.h"
 #include "ZeroMqSocketConfiguration.h"
 
@@ -108,26 +109,7 @@ LmcpObjectMessageTcpReceiverSenderPipe::getNextSerializedMessage()
 std::unique_ptr<avtas::lmcp::Object>
 LmcpObjectMessageTcpReceiverSenderPipe::deserializeMessage(const std::string& payload)
 {
-    std::unique_ptr<avtas::lmcp::Object> lmcpObject;
-
-    // allocate memory
-    avtas::lmcp::ByteBuffer lmcpByteBuffer;
-    lmcpByteBuffer.allocate(payload.size());
-    lmcpByteBuffer.rewind();
-
-    for (size_t charIndex = 0; charIndex < payload.size(); charIndex++)
-    {
-        lmcpByteBuffer.putByte(payload[charIndex]); // TODO REVIEW
-    }
-    lmcpByteBuffer.rewind();
-    
-    lmcpObject.reset(avtas::lmcp::Factory::getObject(lmcpByteBuffer));
-    if (!lmcpObject)
-    {
-        UXAS_LOG_ERROR("LmcpObjectMessageTcpReceiverSenderPipe::deserializeMessage failed to convert message payload string into an LMCP object");
-    }
-
-    return (lmcpObject);
+    return (LmcpObjectSerializer::deserialize(payload));
 };
 
 void
@@ -169,5 +151,11 @@ LmcpObjectMessageTcpReceiverSenderPipe::sendSharedLimitedCastMessage(const std::
     m_transportTcpReceiverSender->sendMessage(castAddress, uxas::common::ContentType::lmcp(), lmcpObject->getFullLmcpTypeName(), serializedPayload);
 };
 
+uint8_t
+LmcpObjectMessageTcpReceiverSenderPipe::getPeerFramingVersion()
+{
+    return (m_transportTcpReceiverSender ? m_transportTcpReceiverSender->getPeerFramingVersion() : 0);
+};
+
 }; //namespace communications
 }; //namespace uxas
@@ -89,6 +89,14 @@ public:
     void
     sendSharedLimitedCastMessage(const std::string& castAddress, const std::shared_ptr<avtas::lmcp::Object>& lmcpObject);
 
+    /** \brief Lowest framing version negotiated with the peers (see
+     * ZeroMqAddressedAttributedMessageTcpReceiverSender::getPeerFramingVersion).
+     *
+     * @return 0 if not known
+     */
+    uint8_t
+    getPeerFramingVersion();
+
 private:
 
     void
@@ -8,6 +8,7 @@
 // ===============================================================================
 
 #include "LmcpObjectNetworkClientBase.h"
+#include "LmcpObjectSerializer.h"
 
 #include "avtas/lmcp/ByteBuffer.h"
 #include "avtas/lmcp/Factory.h"
@@ -56,6 +57,12 @@ LmcpObjectNetworkClientBase::configureNetworkClient(const std::string& subclassT
     m_networkClientTypeName = subclassTypeName;
     m_receiveProcessingType = receiveProcessingType;
 
+    if (m_networkClientHost && m_receiveProcessingType != ReceiveProcessingType::LMCP)
+    {
+        UXAS_LOG_ERROR(m_networkClientTypeName, "::configureNetworkClient failed - only LMCP receive processing network clients can be hosted");
+        return (false);
+    }
+
     //
     // DESIGN 20150911 RJT message addressing - entity ID + service ID (uni-cast)
     // - sent messages always include entity ID and service ID
@@ -129,6 +136,12 @@ LmcpObjectNetworkClientBase::initializeAndStart()
         return (false);
     }
 
+    if (uxas::common::ConfigurationManager::getIsMessageProcessingStatistics())
+    {
+        m_messageProcessingStatistics = std::make_shared<MessageProcessingStatistics>(m_networkClientTypeName, m_networkId);
+        MessageProcessingStatistics::registerStatistics(m_messageProcessingStatistics);
+    }
+
     if (start())
     {
         UXAS_LOG_INFORM(m_networkClientTypeName, "::initializeAndStart start call succeeded");
@@ -139,6 +152,14 @@ LmcpObjectNetworkClientBase::initializeAndStart()
         return (false);
     }
 
+    if (m_networkClientHost)
+    {
+        // hosted network clients receive on the host's thread
+        UXAS_LOG_INFORM(m_networkClientTypeName, "::initializeAndStart hosted network client started without processing thread");
+        UXAS_LOG_DEBUGGING(m_networkClientTypeName, "::initializeAndStart method END");
+        return (true);
+    }
+
     UXAS_LOG_INFORM(m_networkClientTypeName, "::initializeAndStart processing thread starting ...");
     switch (m_receiveProcessingType)
     {
@@ -165,7 +186,15 @@ LmcpObjectNetworkClientBase::addSubscriptionAddress(const std::string& address)
 {
     UXAS_LOG_DEBUGGING(m_networkClientTypeName, "::addSubscriptionAddress method START");
     bool isAdded{false};
-    if (m_isThreadStarted)
+    if (m_networkClientHost)
+    {
+        if (m_preStartLmcpSubscriptionAddresses.emplace(address).second)
+        {
+            m_networkClientHost->addHostedSubscriptionAddress(this, address);
+            UXAS_LOG_INFORM(m_networkClientTypeName, "::addSubscriptionAddress forwarded subscribe address [", address, "] to host");
+        }
+    }
+    else if (m_isThreadStarted)
     {
         if (m_lmcpObjectMessageReceiverPipe.addLmcpObjectSubscriptionAddress(address))
         {
@@ -198,7 +227,15 @@ bool
 LmcpObjectNetworkClientBase::removeSubscriptionAddress(const std::string& address)
 {
     bool isRemoved{false};
-    if (m_isThreadStarted)
+    if (m_networkClientHost)
+    {
+        isRemoved = ((m_preStartLmcpSubscriptionAddresses.erase(address) > 0) ? true : false);
+        if (isRemoved)
+        {
+            m_networkClientHost->removeHostedSubscriptionAddress(this, address);
+        }
+    }
+    else if (m_isThreadStarted)
     {
         isRemoved = m_lmcpObjectMessageReceiverPipe.removeLmcpObjectSubscriptionAddress(address);
     }
@@ -224,7 +261,16 @@ bool
 LmcpObjectNetworkClientBase::removeAllSubscriptionAddresses()
 {
     bool isRemoved{false};
-    if (m_isThreadStarted)
+    if (m_networkClientHost)
+    {
+        for (const auto& address : m_preStartLmcpSubscriptionAddresses)
+        {
+            m_networkClientHost->removeHostedSubscriptionAddress(this, address);
+        }
+        m_preStartLmcpSubscriptionAddresses.clear();
+        isRemoved = true;
+    }
+    else if (m_isThreadStarted)
     {
         isRemoved = m_lmcpObjectMessageReceiverPipe.removeAllLmcpObjectSubscriptionAddresses();
     }
@@ -251,6 +297,14 @@ LmcpObjectNetworkClientBase::initializeNetworkClient()
 {
     UXAS_LOG_DEBUGGING(m_networkClientTypeName, "::initializeNetworkClient method START");
 
+    if (m_networkClientHost)
+    {
+        // hosted network clients only send; subscriptions were forwarded to the host
+        m_lmcpObjectMessageSenderPipe.initializePush(m_messageSourceGroup, m_entityId, m_networkId);
+        UXAS_LOG_DEBUGGING(m_networkClientTypeName, "::initializeNetworkClient method END");
+        return (true);
+    }
+
     m_lmcpObjectMessageReceiverPipe.initializeSubscription(m_entityId, m_networkId);
 
     for (const auto& address : m_preStartLmcpSubscriptionAddresses)
@@ -284,6 +338,8 @@ LmcpObjectNetworkClientBase::executeNetworkClient()
         {
             try
             {
+                processPendingWork();
+
                 // get the next LMCP message (if any) from the LMCP network server
                 UXAS_LOG_DEBUG_VERBOSE_MESSAGING(m_networkClientTypeName, "::executeNetworkClient calling m_lmcpObjectMessageReceiverPipe.getNextMessageObject()");
                 std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage
@@ -292,6 +348,9 @@ LmcpObjectNetworkClientBase::executeNetworkClient()
 
                 if (receivedLmcpMessage)
                 {
+                    auto processingStartTime = std::chrono::steady_clock::now();
+                    auto sendTime = receivedLmcpMessage->m_sendTime;
+                    std::string descriptor = m_messageProcessingStatistics ? receivedLmcpMessage->m_attributes->getDescriptor() : std::string();
                     UXAS_LOG_DEBUG_VERBOSE_MESSAGING(m_networkClientTypeName, "::executeNetworkClient processing received LMCP message");
                     UXAS_LOG_DEBUG_VERBOSE_MESSAGING("ContentType:      [", receivedLmcpMessage->m_attributes->getContentType(), "]");
                     UXAS_LOG_DEBUG_VERBOSE_MESSAGING("Descriptor:       [", receivedLmcpMessage->m_attributes->getDescriptor(), "]");
@@ -303,11 +362,20 @@ LmcpObjectNetworkClientBase::executeNetworkClient()
                             && uxas::messages::uxnative::isKillService(receivedLmcpMessage->m_object)
                             //&& m_entityIdString.compare(std::static_pointer_cast<uxas::messages::uxnative::KillService>(receivedLmcpMessage->m_object)->getEntityID()) == 0//TODO check entityID
                             && m_networkIdString.compare(std::to_string(std::static_pointer_cast<uxas::messages::uxnative::KillService>(receivedLmcpMessage->m_object)->getServiceID())) == 0)
-                            || processReceivedLmcpMessage(std::move(receivedLmcpMessage)))
+                            || dispatchReceivedLmcpMessage(std::move(receivedLmcpMessage)))
                     {
                         UXAS_LOG_INFORM(m_networkClientTypeName, "::executeNetworkClient starting termination since received [", uxas::messages::uxnative::KillService::TypeName, "] message ");
                         m_isTerminateNetworkClient = true;
                     }
+                    if (m_messageProcessingStatistics)
+                    {
+                        m_messageProcessingStatistics->recordMessage(descriptor, sendTime, processingStartTime, std::chrono::steady_clock::now());
+                        size_t queueDepth{0};
+                        if (m_lmcpObjectMessageReceiverPipe.getQueueDepth(queueDepth))
+                        {
+                            m_messageProcessingStatistics->recordQueueDepth(queueDepth);
+                        }
+                    }
                 }
             }
             catch (std::exception& ex)
@@ -361,43 +429,70 @@ LmcpObjectNetworkClientBase::executeSerializedNetworkClient()
         m_isThreadStarted = true;
         while (!m_isTerminateNetworkClient)
         {
-            // get the next serialized LMCP object message (if any) from the LMCP network server
-            std::unique_ptr<uxas::communications::data::AddressedAttributedMessage>
-                    nextReceivedSerializedLmcpObject
-                    = m_lmcpObjectMessageReceiverPipe.getNextSerializedMessage();
-
-            if (nextReceivedSerializedLmcpObject)
+            try
             {
-                UXAS_LOG_DEBUG_VERBOSE_MESSAGING(m_networkClientTypeName, "::executeSerializedNetworkClient processing received LMCP message");
-                UXAS_LOG_DEBUG_VERBOSE_MESSAGING("Address:          [", nextReceivedSerializedLmcpObject->getAddress(), "]");
-                UXAS_LOG_DEBUG_VERBOSE_MESSAGING("ContentType:      [", nextReceivedSerializedLmcpObject->getMessageAttributesReference()->getContentType(), "]");
-                UXAS_LOG_DEBUG_VERBOSE_MESSAGING("Descriptor:       [", nextReceivedSerializedLmcpObject->getMessageAttributesReference()->getDescriptor(), "]");
-                UXAS_LOG_DEBUG_VERBOSE_MESSAGING("SourceGroup:      [", nextReceivedSerializedLmcpObject->getMessageAttributesReference()->getSourceGroup(), "]");
-                UXAS_LOG_DEBUG_VERBOSE_MESSAGING("SourceEntityId:   [", nextReceivedSerializedLmcpObject->getMessageAttributesReference()->getSourceEntityId(), "]");
-                UXAS_LOG_DEBUG_VERBOSE_MESSAGING("SourceServiceId:  [", nextReceivedSerializedLmcpObject->getMessageAttributesReference()->getSourceServiceId(), "]");
-                UXAS_LOG_DEBUG_VERBOSE_MESSAGING("AttributesString: [", nextReceivedSerializedLmcpObject->getMessageAttributesReference()->getString(), "]");
-                UXAS_LOG_DEBUG_VERBOSE_MESSAGING("getPayload:       [", nextReceivedSerializedLmcpObject->getPayload(), "]");
-                UXAS_LOG_DEBUG_VERBOSE_MESSAGING("getString:        [", nextReceivedSerializedLmcpObject->getString(), "]");
-
-                if (m_isBaseClassKillServiceProcessingPermitted
-                        && nextReceivedSerializedLmcpObject->getMessageAttributesReference()->getDescriptor()
-                        .rfind(uxas::messages::uxnative::KillService::Subscription) != std::string::npos)
+                processPendingWork();
+
+                // get the next serialized LMCP object message (if any) from the LMCP network server
+                std::unique_ptr<uxas::communications::data::AddressedAttributedMessage>
+                        nextReceivedSerializedLmcpObject
+                        = m_lmcpObjectMessageReceiverPipe.getNextSerializedMessage();
+
+                if (nextReceivedSerializedLmcpObject)
                 {
-                    // reconstitute LMCP object
-                    std::shared_ptr<avtas::lmcp::Object> lmcpObject = deserializeMessage(nextReceivedSerializedLmcpObject->getPayload());
-                    // check KillService serviceID == my serviceID
-                    if (uxas::messages::uxnative::isKillService(lmcpObject)
-                            //&& m_entityIdString.compare(std::static_pointer_cast<uxas::messages::uxnative::KillService>(lmcpObject)->getEntityID()) == 0//TODO check entityID
-                            && m_networkIdString.compare(std::to_string(std::static_pointer_cast<uxas::messages::uxnative::KillService>(lmcpObject)->getServiceID())) == 0)
+                    auto processingStartTime = std::chrono::steady_clock::now();
+                    auto sendTime = nextReceivedSerializedLmcpObject->getSendTime();
+                    std::string descriptor = m_messageProcessingStatistics
+                            ? nextReceivedSerializedLmcpObject->getMessageAttributesReference()->getDescriptor() : std::string();
+                    UXAS_LOG_DEBUG_VERBOSE_MESSAGING(m_networkClientTypeName, "::executeSerializedNetworkClient processing received LMCP message");
+                    UXAS_LOG_DEBUG_VERBOSE_MESSAGING("Address:          [", nextReceivedSerializedLmcpObject->getAddress(), "]");
+                    UXAS_LOG_DEBUG_VERBOSE_MESSAGING("ContentType:      [", nextReceivedSerializedLmcpObject->getMessageAttributesReference()->getContentType(), "]");
+                    UXAS_LOG_DEBUG_VERBOSE_MESSAGING("Descriptor:       [", nextReceivedSerializedLmcpObject->getMessageAttributesReference()->getDescriptor(), "]");
+                    UXAS_LOG_DEBUG_VERBOSE_MESSAGING("SourceGroup:      [", nextReceivedSerializedLmcpObject->getMessageAttributesReference()->getSourceGroup(), "]");
+                    UXAS_LOG_DEBUG_VERBOSE_MESSAGING("SourceEntityId:   [", nextReceivedSerializedLmcpObject->getMessageAttributesReference()->getSourceEntityId(), "]");
+                    UXAS_LOG_DEBUG_VERBOSE_MESSAGING("SourceServiceId:  [", nextReceivedSerializedLmcpObject->getMessageAttributesReference()->getSourceServiceId(), "]");
+                    UXAS_LOG_DEBUG_VERBOSE_MESSAGING("AttributesString: [", nextReceivedSerializedLmcpObject->getMessageAttributesReference()->getString(), "]");
+                    UXAS_LOG_DEBUG_VERBOSE_MESSAGING("getPayload:       [", nextReceivedSerializedLmcpObject->getPayload(), "]");
+                    UXAS_LOG_DEBUG_VERBOSE_MESSAGING("getString:        [", nextReceivedSerializedLmcpObject->getString(), "]");
+
+                    if (m_isBaseClassKillServiceProcessingPermitted
+                            && nextReceivedSerializedLmcpObject->getMessageAttributesReference()->getDescriptor()
+                            .rfind(uxas::messages::uxnative::KillService::Subscription) != std::string::npos)
+                    {
+                        // reconstitute LMCP object
+                        std::shared_ptr<avtas::lmcp::Object> lmcpObject = deserializeMessage(nextReceivedSerializedLmcpObject->getPayload());
+                        // check KillService serviceID == my serviceID
+                        if (uxas::messages::uxnative::isKillService(lmcpObject)
+                                //&& m_entityIdString.compare(std::static_pointer_cast<uxas::messages::uxnative::KillService>(lmcpObject)->getEntityID()) == 0//TODO check entityID
+                                && m_networkIdString.compare(std::to_string(std::static_pointer_cast<uxas::messages::uxnative::KillService>(lmcpObject)->getServiceID())) == 0)
+                        {
+                            UXAS_LOG_INFORM(m_networkClientTypeName, "::executeSerializedNetworkClient starting termination since received [", uxas::messages::uxnative::KillService::TypeName, "] message ");
+                            m_isTerminateNetworkClient = true;
+                        }
+                        else if (m_isOtherKillServiceProcessingPermitted
+                                && processReceivedSerializedLmcpMessage(std::move(nextReceivedSerializedLmcpObject)))
+                        {
+                            m_isTerminateNetworkClient = true;
+                        }
+                    }
+                    else if (processReceivedSerializedLmcpMessage(std::move(nextReceivedSerializedLmcpObject)))
                     {
-                        UXAS_LOG_INFORM(m_networkClientTypeName, "::executeSerializedNetworkClient starting termination since received [", uxas::messages::uxnative::KillService::TypeName, "] message ");
                         m_isTerminateNetworkClient = true;
                     }
+                    if (m_messageProcessingStatistics)
+                    {
+                        m_messageProcessingStatistics->recordMessage(descriptor, sendTime, processingStartTime, std::chrono::steady_clock::now());
+                        size_t queueDepth{0};
+                        if (m_lmcpObjectMessageReceiverPipe.getQueueDepth(queueDepth))
+                        {
+                            m_messageProcessingStatistics->recordQueueDepth(queueDepth);
+                        }
+                    }
                 }
-                else if (processReceivedSerializedLmcpMessage(std::move(nextReceivedSerializedLmcpObject)))
-                {
-                    m_isTerminateNetworkClient = true;
-                }
+            }
+            catch (std::exception& ex)
+            {
+                UXAS_LOG_ERROR(m_networkClientTypeName, "::executeSerializedNetworkClient continuing infinite while loop after EXCEPTION: ", ex.what());
             }
         }
 
@@ -437,29 +532,75 @@ LmcpObjectNetworkClientBase::executeSerializedNetworkClient()
     }
 };
 
-std::shared_ptr<avtas::lmcp::Object>
-LmcpObjectNetworkClientBase::deserializeMessage(const std::string& payload)
+bool
+LmcpObjectNetworkClientBase::processHostedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage)
 {
-    std::shared_ptr<avtas::lmcp::Object> lmcpObject;
-
-    // allocate memory
-    avtas::lmcp::ByteBuffer lmcpByteBuffer;
-    lmcpByteBuffer.allocate(payload.size());
-    lmcpByteBuffer.rewind();
+    if (m_isTerminateNetworkClient)
+    {
+        return (true);
+    }
 
-    for (size_t charIndex = 0; charIndex < payload.size(); charIndex++)
+    try
+    {
+        // the host's receive queue is shared, so only processing and queue wait times are recorded
+        auto processingStartTime = std::chrono::steady_clock::now();
+        auto sendTime = receivedLmcpMessage->m_sendTime;
+        std::string descriptor = m_messageProcessingStatistics ? receivedLmcpMessage->m_attributes->getDescriptor() : std::string();
+        if ((m_isBaseClassKillServiceProcessingPermitted
+                && uxas::messages::uxnative::isKillService(receivedLmcpMessage->m_object)
+                && m_networkIdString.compare(std::to_string(std::static_pointer_cast<uxas::messages::uxnative::KillService>(receivedLmcpMessage->m_object)->getServiceID())) == 0)
+                || dispatchReceivedLmcpMessage(std::move(receivedLmcpMessage)))
+        {
+            UXAS_LOG_INFORM(m_networkClientTypeName, "::processHostedLmcpMessage starting termination");
+            m_isTerminateNetworkClient = true;
+        }
+        if (m_messageProcessingStatistics)
+        {
+            m_messageProcessingStatistics->recordMessage(descriptor, sendTime, processingStartTime, std::chrono::steady_clock::now());
+        }
+    }
+    catch (std::exception& ex)
     {
-        lmcpByteBuffer.putByte(payload[charIndex]); // TODO REVIEW
+        UXAS_LOG_ERROR(m_networkClientTypeName, "::processHostedLmcpMessage continuing after EXCEPTION: ", ex.what());
     }
-    lmcpByteBuffer.rewind();
-    
-    lmcpObject.reset(avtas::lmcp::Factory::getObject(lmcpByteBuffer));
-    if (!lmcpObject)
+    return (m_isTerminateNetworkClient);
+};
+
+void
+LmcpObjectNetworkClientBase::terminateHostedNetworkClient()
+{
+    m_isTerminateNetworkClient = true;
+    m_isBaseClassTerminationFinished = true;
+
+    uint32_t subclassTerminateDuration_ms{0};
+    while (true)
     {
-        UXAS_LOG_ERROR("LmcpObjectMessageReceiverPipe::deserializeMessage failed to convert message payload string into an LMCP object");
+        m_isSubclassTerminationFinished = terminate();
+        if (m_isSubclassTerminationFinished)
+        {
+            UXAS_LOG_INFORM(m_networkClientTypeName, "::terminateHostedNetworkClient terminated subclass processing after [", subclassTerminateDuration_ms, "] milliseconds on thread [", std::this_thread::get_id(), "]");
+            break;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(m_subclassTerminationAttemptPeriod_ms));
+        subclassTerminateDuration_ms += m_subclassTerminationAttemptPeriod_ms;
+        if (subclassTerminateDuration_ms > m_subclassTerminationAbortDuration_ms)
+        {
+            UXAS_LOG_ERROR(m_networkClientTypeName, "::terminateHostedNetworkClient aborting termination of subclass processing after [", subclassTerminateDuration_ms, "] milliseconds on thread [", std::this_thread::get_id(), "]");
+            m_isSubclassTerminationFinished = true;
+            break;
+        }
+        else if (subclassTerminateDuration_ms > m_subclassTerminationWarnDuration_ms)
+        {
+            UXAS_LOG_WARN(m_networkClientTypeName, "::terminateHostedNetworkClient has not terminated subclass processing after [", subclassTerminateDuration_ms, "] milliseconds on thread [", std::this_thread::get_id(), "]");
+        }
     }
+};
 
-    return (lmcpObject);
+std::shared_ptr<avtas::lmcp::Object>
+LmcpObjectNetworkClientBase::deserializeMessage(const std::string& payload)
+{
+    return (LmcpObjectSerializer::deserialize(payload));
 };
 
 void
@@ -497,5 +638,19 @@ LmcpObjectNetworkClientBase::sendSharedLmcpObjectLimitedCastMessage(const std::s
     m_lmcpObjectMessageSenderPipe.sendSharedLimitedCastMessage(castAddress, lmcpObject);
 };
 
+void
+LmcpObjectNetworkClientBase::sendSharedSerializedLmcpObjectBroadcastMessage(const uxas::communications::data::SerializedLmcpObject& serializedLmcpObject)
+{
+    s_uniqueEntitySendMessageId++;
+    m_lmcpObjectMessageSenderPipe.sendSharedSerializedMessage(serializedLmcpObject.getDescriptor(), serializedLmcpObject);
+};
+
+void
+LmcpObjectNetworkClientBase::sendSharedSerializedLmcpObjectLimitedCastMessage(const std::string& castAddress, const uxas::communications::data::SerializedLmcpObject& serializedLmcpObject)
+{
+    s_uniqueEntitySendMessageId++;
+    m_lmcpObjectMessageSenderPipe.sendSharedSerializedMessage(castAddress, serializedLmcpObject);
+};
+
 }; //namespace communications
 }; //namespace uxas
@@ -12,6 +12,8 @@
 
 #include "LmcpObjectMessageReceiverPipe.h"
 #include "LmcpObjectMessageSenderPipe.h"
+#include "LmcpObjectNetworkClientHost.h"
+#include "MessageProcessingStatistics.h"
 
 #include "avtas/lmcp/Factory.h"
 
@@ -84,6 +86,13 @@ namespace communications
  * specific to the inheriting class (e.g., thread joining).
  * </ul>
  * 
+ * \par Hosted Mode:
+ * If a <B><i>LmcpObjectNetworkClientHost</i></B> is set before configuration, the 
+ * network client does not create a receiver pipe or a thread. Subscription 
+ * addresses are forwarded to the host, which calls 
+ * <B><i>processHostedLmcpMessage</i></B> for each received message and 
+ * <B><i>terminateHostedNetworkClient</i></B> on termination. Sending is unchanged.
+ * 
  * 
  * @n
  */
@@ -296,6 +305,37 @@ public:
     bool
     getIsTerminationFinished() { return(m_isBaseClassTerminationFinished && m_isSubclassTerminationFinished); }
 
+    /** \brief The <B><i>setNetworkClientHost</i></B> method selects hosted mode 
+     * (see class description). Must be invoked before calling the 
+     * <B><i>configureNetworkClient</i></B> method. Only 
+     * <B><i>ReceiveProcessingType::LMCP</i></B> network clients can be hosted.
+     * 
+     * @param networkClientHost host that receives and dispatches messages for this 
+     * network client; must outlive it.
+     */
+    void
+    setNetworkClientHost(LmcpObjectNetworkClientHost* networkClientHost) { m_networkClientHost = networkClientHost; };
+
+    bool
+    getIsHosted() const { return (m_networkClientHost != nullptr); };
+
+    /** \brief The <B><i>processHostedLmcpMessage</i></B> method is invoked by 
+     * the host of a hosted network client for each received message. Calls 
+     * for one network client must not overlap. 
+     * 
+     * @param receivedLmcpMessage received <b>LMCP</b> message.
+     * @return true if the network client is to terminate.
+     */
+    bool
+    processHostedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage);
+
+    /** \brief The <B><i>terminateHostedNetworkClient</i></B> method is invoked by 
+     * the host of a hosted network client to execute termination (including 
+     * repeated <B><i>terminate</i></B> attempts) on the calling thread. 
+     */
+    void
+    terminateHostedNetworkClient();
+
 protected:
 
     /** \brief The virtual <B><i>configure</i></B> method is invoked by the 
@@ -347,6 +387,36 @@ protected:
     virtual
     bool
     processReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage) { return (false); };
+
+    /** \brief The virtual <B><i>dispatchReceivedLmcpMessage</i></B> is invoked 
+     * for each received <b>LMCP</b> message (other than a base class processed 
+     * <B><i>KillService</i></B>). The default implementation invokes 
+     * <B><i>processReceivedLmcpMessage</i></B>; framework classes override it 
+     * to route messages to registered handlers. 
+     * 
+     * @param receivedLmcpMessage received <b>LMCP</b> message.
+     * @return true if object is to terminate; false if object is to continue processing.
+     */
+    virtual
+    bool
+    dispatchReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage)
+    {
+        return (processReceivedLmcpMessage(std::move(receivedLmcpMessage)));
+    };
+
+    /** \brief Restricts the <b>LMCP</b> messages received by this network 
+     * client to the types accepted by the filter; other messages are discarded 
+     * before deserialization. Must be invoked before the network client 
+     * starts receiving (e.g., during configuration). Not applied to hosted 
+     * network clients (their host receives and deserializes).
+     * 
+     * @param lmcpTypeFilter filter; empty accepts all types
+     */
+    void
+    setLmcpTypeFilter(LmcpObjectMessageReceiverPipe::LmcpTypeFilter lmcpTypeFilter)
+    {
+        m_lmcpObjectMessageReceiverPipe.setLmcpTypeFilter(std::move(lmcpTypeFilter));
+    };
     
     /** \brief The virtual <B><i>processReceivedSerializedLmcpMessage</i></B> is 
      * repeatedly invoked by the <B><i>LmcpObjectNetworkClientBase</i></B> class in an 
@@ -359,6 +429,16 @@ protected:
     virtual
     bool
     processReceivedSerializedLmcpMessage(std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> receivedSerializedLmcpMessage) { return (false); };
+
+    /** \brief The virtual <B><i>processPendingWork</i></B> method is invoked by 
+     * the network client thread before each attempt to receive a message (i.e., 
+     * at least once per receive poll wait period). Intended for work that must 
+     * run on the network client thread, e.g., applying subscription changes 
+     * requested by other threads. 
+     */
+    virtual
+    void
+    processPendingWork() { };
     
 public:
     /** \brief The <B><i>addSubscriptionAddress</i></B> can be invoked 
@@ -434,6 +514,26 @@ protected:
     void
     sendSharedLmcpObjectLimitedCastMessage(const std::string& castAddress, const std::shared_ptr<avtas::lmcp::Object>& lmcpObject);
 
+    /** \brief The <B><i>sendSharedSerializedLmcpObjectBroadcastMessage</i></B> method can be 
+     * invoked to broadcast an already serialized <b>LMCP</b> object on the <b>LMCP</b> network. 
+     * Intended for objects that are sent repeatedly or to several addresses: 
+     * the object is packed once and every send shares the same buffer. 
+     * 
+     * @param serializedLmcpObject serialize-once <b>LMCP</b> object to be broadcasted. The message 
+     * publish address is the full <b>LMCP</b> object name.
+     */
+    void
+    sendSharedSerializedLmcpObjectBroadcastMessage(const uxas::communications::data::SerializedLmcpObject& serializedLmcpObject);
+
+    /** \brief The <B><i>sendSharedSerializedLmcpObjectLimitedCastMessage</i></B> method can be 
+     * invoked to send an already serialized <b>LMCP</b> object as a uni-cast or multi-cast message. 
+     * 
+     * @param castAddress message publish address
+     * @param serializedLmcpObject serialize-once <b>LMCP</b> object to be uni-casted/multi-casted.
+     */
+    void
+    sendSharedSerializedLmcpObjectLimitedCastMessage(const std::string& castAddress, const uxas::communications::data::SerializedLmcpObject& serializedLmcpObject);
+
 private:
     
     /** \brief The <B><i>initializeNetworkClient</i></B> method is invoked by 
@@ -503,6 +603,11 @@ protected:
     std::string m_entityType;
 
     std::atomic<bool> m_isBaseClassKillServiceProcessingPermitted{true};
+    /** \brief If true, serialized <b>KillService</b> messages addressed to other 
+     * services are passed to <B><i>processReceivedSerializedLmcpMessage</i></B> 
+     * (e.g., for logging) instead of being consumed by the base class. Bridges 
+     * must not set this, since they would export local <b>KillService</b> messages.  */
+    std::atomic<bool> m_isOtherKillServiceProcessingPermitted{false};
     std::atomic<bool> m_isTerminateNetworkClient{false};
     std::atomic<bool> m_isBaseClassTerminationFinished{false};
     std::atomic<bool> m_isSubclassTerminationFinished{false};
@@ -525,10 +630,16 @@ private:
     /** \brief Pointer to the component's thread.  */
     std::unique_ptr<std::thread> m_networkClientThread;
 
+    /** \brief Host of a hosted network client (not owned); null if the network client runs its own thread.  */
+    LmcpObjectNetworkClientHost* m_networkClientHost{nullptr};
+
     uxas::communications::LmcpObjectMessageReceiverPipe m_lmcpObjectMessageReceiverPipe;
     std::set<std::string> m_preStartLmcpSubscriptionAddresses;
 
     uxas::communications::LmcpObjectMessageSenderPipe m_lmcpObjectMessageSenderPipe;
+
+    /** \brief Received message statistics; null if disabled by configuration.  */
+    std::shared_ptr<MessageProcessingStatistics> m_messageProcessingStatistics;
     
 };
 
@@ -0,0 +1,55 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_MESSAGE_LMCP_OBJECT_NETWORK_CLIENT_HOST_H
+#define UXAS_MESSAGE_LMCP_OBJECT_NETWORK_CLIENT_HOST_H
+
+#include <string>
+
+namespace uxas
+{
+namespace communications
+{
+
+class LmcpObjectNetworkClientBase;
+
+/** \class LmcpObjectNetworkClientHost
+ * 
+ * \par Description:
+ * Interface of an object that receives and dispatches messages on behalf of 
+ * hosted <B><i>LmcpObjectNetworkClientBase</i></B> instances. A hosted network 
+ * client has no receiver pipe and no thread of its own: its subscription 
+ * address changes are forwarded to the host, and the host delivers received 
+ * messages by calling <B><i>processHostedLmcpMessage</i></B>. 
+ * 
+ * Both methods can be called from any thread.
+ * 
+ * \n
+ */
+class LmcpObjectNetworkClientHost
+{
+public:
+
+    virtual
+    ~LmcpObjectNetworkClientHost() { };
+
+    virtual
+    void
+    addHostedSubscriptionAddress(LmcpObjectNetworkClientBase* networkClient, const std::string& address) = 0;
+
+    virtual
+    void
+    removeHostedSubscriptionAddress(LmcpObjectNetworkClientBase* networkClient, const std::string& address) = 0;
+
+};
+
+}; //namespace communications
+}; //namespace uxas
+
+#endif /* UXAS_MESSAGE_LMCP_OBJECT_NETWORK_CLIENT_HOST_H */
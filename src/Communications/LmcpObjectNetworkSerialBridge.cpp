@@ -11,6 +11,7 @@
 
 #include "SerialHelper.h"
 
+#include "UxAS_ConfigurationManager.h"
 #include "UxAS_Log.h"
 #include "Constants/UxAS_String.h"
 
@@ -111,6 +112,20 @@ LmcpObjectNetworkSerialBridge::initialize()
     {
         isSuccess = true;
         UXAS_LOG_INFORM(s_typeName(), "::initialize opened serial connection with serial port address ", m_serialPortAddress, ", baud rate ", m_serialBaudRate, " and timeout ", m_serialTimeout_ms);
+
+        // sentinel framing until the peer announces (or sends) binary frames
+        m_receiveSerialDataBuffer.setLocalFramingVersion(static_cast<uint8_t>(uxas::common::ConfigurationManager::getSerialFramingVersion()));
+        if (m_receiveSerialDataBuffer.getLocalFramingVersion() >= uxas::common::FramedSerialBuffer::s_binaryFramingVersion)
+        {
+            try
+            {
+                m_serialConnection->write(uxas::common::FramedSerialBuffer::createAnnounceFrame());
+            }
+            catch (std::exception& ex)
+            {
+                UXAS_LOG_WARN(s_typeName(), "::initialize failed to send framing version announcement EXCEPTION: ", ex.what());
+            }
+        }
     }
     else
     {
@@ -161,7 +176,8 @@ LmcpObjectNetworkSerialBridge::processReceivedSerializedLmcpMessage(std::unique_
             UXAS_LOG_INFORM(s_typeName(), "::processReceivedSerializedLmcpMessage processing message with source entity ID ", receivedLmcpMessage->getMessageAttributesReference()->getSourceEntityId());
             try
             {
-                m_serialConnection->write(uxas::common::SentinelSerialBuffer::createSentinelizedString(receivedLmcpMessage->getString()));
+                m_serialConnection->write(uxas::common::FramedSerialBuffer::createFramedString(receivedLmcpMessage->getString(),
+                                                                                               m_receiveSerialDataBuffer.getSendFramingVersion()));
             }
             catch (std::exception& ex)
             {
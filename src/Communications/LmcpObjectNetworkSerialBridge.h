@@ -12,7 +12,7 @@
 
 #include "LmcpObjectNetworkClientBase.h"
 
-#include "UxAS_SentinelSerialBuffer.h"
+#include "UxAS_FramedSerialBuffer.h"
 
 #include "serial/serial.h"
 
@@ -130,7 +130,8 @@ private:
      */
     uint32_t m_serialMaxBytesReadCount{1000};
 
-    uxas::common::SentinelSerialBuffer m_receiveSerialDataBuffer;
+    /** \brief receive buffer; also tracks the framing version of the peer */
+    uxas::common::FramedSerialBuffer m_receiveSerialDataBuffer;
     
     std::set<std::string> m_externalSubscriptionAddresses;
     std::set<std::string> m_nonImportForwardAddresses;
@@ -11,6 +11,9 @@
 
 #include "UxAS_ConfigurationManager.h"
 #include "UxAS_Log.h"
+#include "Constants/UxAS_String.h"
+
+#include <chrono>
 
 namespace uxas
 {
@@ -39,14 +42,29 @@ LmcpObjectNetworkServer::configure()
 bool
 LmcpObjectNetworkServer::initializeAndStart()
 {
+    if (uxas::common::ConfigurationManager::getIsInProcessMessageBus())
+    {
+        // services publish directly to subscriber queues - no hub required
+        UXAS_LOG_INFORM("LmcpObjectNetworkServer::initializeAndStart not starting LMCP network server since in-process message bus is enabled");
+        return (true);
+    }
+
     bool isStarted{false};
     isStarted = initialize();
 
-    if (isStarted)
+    if (isStarted && !m_shards)
     {
         m_thread = uxas::stduxas::make_unique<std::thread>(&LmcpObjectNetworkServer::executeNetworkServer, this);
         UXAS_LOG_INFORM("LmcpObjectNetworkServer::initializeAndStart started LMCP network server processing thread [", m_thread->get_id(), "]");
     }
+    else if (isStarted)
+    {
+        m_shards->start();
+        m_statisticsTime = std::chrono::steady_clock::now();
+        m_thread = uxas::stduxas::make_unique<std::thread>(&LmcpObjectNetworkServer::executeShardDispatcher, this);
+        UXAS_LOG_INFORM("LmcpObjectNetworkServer::initializeAndStart started LMCP network server dispatch thread [", m_thread->get_id(), "] and ",
+                        m_shards->getShardCount(), " worker threads");
+    }
     return (isStarted);
 }
 
@@ -60,8 +78,28 @@ bool
 LmcpObjectNetworkServer::initialize()
 {
     m_lmcpObjectMessageReceiverPipe.initializePull(m_entityId, m_networkId);
-    m_lmcpObjectMessageSenderPipe.initializePublish("", m_entityId, m_networkId);
-    UXAS_LOG_INFORM("LmcpObjectNetworkServer initialized LMCP network pull receiver and publish sender pipes");
+    uint32_t workerCount = uxas::common::ConfigurationManager::getNetworkServerWorkerCount();
+    if (workerCount <= 1)
+    {
+        m_lmcpObjectMessageSenderPipe.initializePublish("", m_entityId, m_networkId);
+        UXAS_LOG_INFORM("LmcpObjectNetworkServer initialized LMCP network pull receiver and publish sender pipes");
+    }
+    else
+    {
+        for (uint32_t shardIndex = 0; shardIndex < workerCount; shardIndex++)
+        {
+            auto senderPipe = uxas::stduxas::make_unique<uxas::communications::LmcpObjectMessageSenderPipe>();
+            senderPipe->initializeExternalPub("", m_entityId, m_networkId,
+                                              uxas::common::LmcpNetworkSocketAddress::strGetInProc_FromMessageHub(shardIndex), true);
+            m_shardSenderPipes.push_back(std::move(senderPipe));
+        }
+        m_shards = uxas::stduxas::make_unique<NetworkServerShards>(workerCount,
+            [this](uint32_t shardIndex, std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> message)
+            {
+                m_shardSenderPipes[shardIndex]->sendSerializedMessage(std::move(message));
+            });
+        UXAS_LOG_INFORM("LmcpObjectNetworkServer initialized LMCP network pull receiver and ", workerCount, " shard publish sender pipes");
+    }
 
     return (true);
 };
@@ -94,5 +132,53 @@ LmcpObjectNetworkServer::executeNetworkServer()
     UXAS_LOG_INFORM("LmcpObjectNetworkServer::executeSerializedNetworkClient exiting infinite loop thread [", std::this_thread::get_id(), "]");
 };
 
+void
+LmcpObjectNetworkServer::executeShardDispatcher()
+{
+    const std::chrono::seconds statisticsPeriod(10);
+    auto nextStatisticsTime = std::chrono::steady_clock::now() + statisticsPeriod;
+    while (!m_isTerminate)
+    {
+        // pull only - parsing of attributes is the sole per-message work
+        // of this thread; publishing happens on the worker threads
+        std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> receivedLmcpMessage
+                = m_lmcpObjectMessageReceiverPipe.getNextSerializedMessage();
+        if (receivedLmcpMessage)
+        {
+            m_shards->push(std::move(receivedLmcpMessage));
+        }
+
+        if (std::chrono::steady_clock::now() >= nextStatisticsTime)
+        {
+            logStatistics();
+            nextStatisticsTime += statisticsPeriod;
+        }
+    }
+    // the workers publish the messages still queued before exiting
+    m_shards->stop();
+    logStatistics();
+    UXAS_LOG_INFORM("LmcpObjectNetworkServer::executeShardDispatcher exiting infinite loop thread [", std::this_thread::get_id(), "]");
+};
+
+void
+LmcpObjectNetworkServer::logStatistics()
+{
+    auto now = std::chrono::steady_clock::now();
+    uint64_t receivedMessageCount = m_shards->getReceivedMessageCount();
+    double elapsed_s = std::chrono::duration<double>(now - m_statisticsTime).count();
+    double receivedMessageRate_per_s = elapsed_s > 0.0 ? (receivedMessageCount - m_statisticsReceivedMessageCount) / elapsed_s : 0.0;
+    m_statisticsTime = now;
+    m_statisticsReceivedMessageCount = receivedMessageCount;
+
+    UXAS_LOG_INFORM(s_typeName(), "::logStatistics received ", receivedMessageCount, " messages (", receivedMessageRate_per_s, " messages/s)");
+    for (uint32_t shardIndex = 0; shardIndex < m_shards->getShardCount(); shardIndex++)
+    {
+        UXAS_LOG_INFORM(s_typeName(), "::logStatistics shard ", shardIndex,
+                        " published ", m_shards->getPublishedMessageCount(shardIndex),
+                        " queue depth ", m_shards->getQueueDepth(shardIndex),
+                        " maximum queue depth ", m_shards->getMaximumQueueDepth(shardIndex));
+    }
+};
+
 }; //namespace communications
 }; //namespace uxas
@@ -13,10 +13,14 @@
 #include "AddressedAttributedMessage.h"
 #include "LmcpObjectMessageReceiverPipe.h"
 #include "LmcpObjectMessageSenderPipe.h"
+#include "NetworkServerShards.h"
 
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <thread>
+#include <vector>
 
 namespace uxas
 {
@@ -50,6 +54,15 @@ namespace communications
  * ZeroMQ PUB socket and sends messages to the hub using a ZeroMQ PUSH socket.
  * Each message a component publishes also includes sending service
  * ID and entity ID.
+ * 
+ * <li> Sharded hub -
+ * When the <B><i>NetworkServerWorkerCount</i></B> entity attribute is greater 
+ * than one, a dispatch thread pulls messages and assigns each one to a worker 
+ * shard by sender (see <B><i>NetworkServerShards</i></B>). Each worker 
+ * publishes on its own PUB socket and subscribers connect to all of them. A 
+ * given sender always maps to the same worker, so messages of one sender are 
+ * published in send order. On termination, the workers publish the messages 
+ * still queued before exiting.
  * </ul>
  * 
  * 
@@ -95,7 +108,7 @@ public:
     terminate();
 
 private:
-    
+
     /** \brief The <B><i>initialize</i></B> function must be invoked 
      * before calling the <B><i>initializeAndStartNetworkClientBaseAndDerived</i></B> 
      * function.  It performs LmcpObjectNetworkServer specific configuration. */
@@ -104,6 +117,12 @@ private:
 
     void
     executeNetworkServer();
+
+    void
+    executeShardDispatcher();
+
+    void
+    logStatistics();
     
     /** \brief  this is the unique ID for the entity represented by this instance of the UxAS software, configured in component manager XML*/
     uint32_t m_entityId;
@@ -124,6 +143,16 @@ private:
 
     std::atomic<bool> m_isTerminate{false};
 
+    /** \brief Publish pipes of the worker shards (empty for the unsharded hub). */
+    std::vector< std::unique_ptr<uxas::communications::LmcpObjectMessageSenderPipe> > m_shardSenderPipes;
+
+    /** \brief Worker shards (null for the unsharded hub). */
+    std::unique_ptr<NetworkServerShards> m_shards;
+
+    /** \brief Received message count and time at the last statistics report. */
+    uint64_t m_statisticsReceivedMessageCount{0};
+    std::chrono::steady_clock::time_point m_statisticsTime;
+
 };
 
 }; //namespace communications
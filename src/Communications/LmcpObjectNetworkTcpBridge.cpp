@@ -12,9 +12,11 @@
 #include "avtas/lmcp/Factory.h"
 
 #include "UxAS_ConfigurationManager.h"
+#include "UxAS_FramedSerialBuffer.h"
 #include "UxAS_Log.h"
 #include "Constants/UxAS_String.h"
 #include "UxAS_Time.h"
+#include "UxAS_TimerManager.h"
 
 #include "stdUniquePtr.h"
 
@@ -29,6 +31,14 @@ namespace uxas
 namespace communications
 {
 
+namespace
+{
+
+/** \brief period of the batching statistics log */
+const uint64_t c_batchStatisticsLogPeriod_ms{60000};
+
+} //namespace
+
 LmcpObjectNetworkTcpBridge::LmcpObjectNetworkTcpBridge()
 {
 };
@@ -82,6 +92,11 @@ LmcpObjectNetworkTcpBridge::configure(const pugi::xml_node& bridgeXmlNode)
             UXAS_LOG_INFORM(s_typeName(), "::configure did not find 'ConsiderSelfGenerated' boolean in XML configuration; 'ConsiderSelfGenerated' boolean is ", m_isConsideredSelfGenerated);
         }
     }
+
+    if (isSuccess)
+    {
+        uxas::communications::BridgeMessageBatcher::readConfiguration(bridgeXmlNode, m_batchConfiguration);
+    }
     
     if (isSuccess)
     {
@@ -130,6 +145,14 @@ LmcpObjectNetworkTcpBridge::initialize()
 {
     UXAS_LOG_INFORM(s_typeName(), "::initialize - START");
     m_externalLmcpObjectMessageTcpReceiverSenderPipe.initializeStream(m_entityId, m_networkId, m_tcpReceiveSendAddress, m_isServer);
+    if (m_batchConfiguration.m_batchWindow_ms > 0)
+    {
+        m_messageBatcher = uxas::stduxas::make_unique<uxas::communications::BridgeMessageBatcher>(m_batchConfiguration);
+        m_batchTimerId = uxas::common::TimerManager::getInstance().createTimer(
+            std::bind(&LmcpObjectNetworkTcpBridge::sendMessageBatch, this), "LmcpObjectNetworkTcpBridge::sendMessageBatch");
+        uxas::common::TimerManager::getInstance().startPeriodicTimer(m_batchTimerId, m_batchConfiguration.m_batchWindow_ms, m_batchConfiguration.m_batchWindow_ms);
+        UXAS_LOG_INFORM(s_typeName(), "::initialize batching exported messages every ", m_batchConfiguration.m_batchWindow_ms, " ms");
+    }
     UXAS_LOG_INFORM(s_typeName(), "::initialize succeeded");
     return (true);
 };
@@ -145,6 +168,16 @@ LmcpObjectNetworkTcpBridge::start()
 bool
 LmcpObjectNetworkTcpBridge::terminate()
 {
+    if (m_batchTimerId && !uxas::common::TimerManager::getInstance().destroyTimer(m_batchTimerId, 1000))
+    {
+        UXAS_LOG_WARN(s_typeName(), "::terminate failed to destroy batch timer");
+    }
+    m_batchTimerId = 0;
+    if (m_messageBatcher)
+    {
+        sendMessageBatch();
+        m_messageBatcher->logStatistics(m_tcpReceiveSendAddress);
+    }
     m_isTerminate = true;
     if (m_tcpProcessingThread && m_tcpProcessingThread->joinable())
     {
@@ -183,7 +216,19 @@ LmcpObjectNetworkTcpBridge::processReceivedSerializedLmcpMessage(std::unique_ptr
         UXAS_LOG_INFORM(s_typeName(), "::processReceivedSerializedLmcpMessage processing message with source entity ID ", receivedLmcpMessage->getMessageAttributesReference()->getSourceEntityId());
         try
         {
-            m_externalLmcpObjectMessageTcpReceiverSenderPipe.sendSerializedMessage(std::move(receivedLmcpMessage));
+            if (m_messageBatcher && isPeerBatching())
+            {
+                m_messageBatcher->addMessage(*receivedLmcpMessage);
+            }
+            else
+            {
+                // messages batched before a legacy peer connected are sent first
+                if (m_messageBatcher && !m_messageBatcher->isEmpty())
+                {
+                    sendBatchedMessages();
+                }
+                m_externalLmcpObjectMessageTcpReceiverSenderPipe.sendSerializedMessage(std::move(receivedLmcpMessage));
+            }
         }
         catch (std::exception& ex)
         {
@@ -220,31 +265,21 @@ LmcpObjectNetworkTcpBridge::executeTcpReceiveProcessing()
             UXAS_LOG_DEBUG_VERBOSE_BRIDGE("getPayload:       [", receivedTcpMessage->getPayload(), "]");
             UXAS_LOG_DEBUG_VERBOSE_BRIDGE("getString:        [", receivedTcpMessage->getString(), "]");
 
-            if (receivedTcpMessage)
+            if (receivedTcpMessage && uxas::communications::BridgeMessageBatcher::isBatchMessage(*receivedTcpMessage))
             {
-                if (m_nonImportForwardAddresses.find(receivedTcpMessage->getAddress()) == m_nonImportForwardAddresses.end())
+                std::vector<std::unique_ptr<uxas::communications::data::AddressedAttributedMessage>> batchedTcpMessages;
+                if (!uxas::communications::BridgeMessageBatcher::unpackBatchMessage(*receivedTcpMessage, batchedTcpMessages))
                 {
-                    if(m_isConsideredSelfGenerated)
-                    {
-                        receivedTcpMessage->updateSourceAttributes("TcpBridge", std::to_string(m_entityId), std::to_string(m_networkId));
-                    }
-
-                    const auto it = m_messageAddressToAlias.find(receivedTcpMessage->getAddress());
-                    if (it != m_messageAddressToAlias.cend())
-                    {
-                        receivedTcpMessage->updateAddress(it->second);
-                    }
-
-                    sendSerializedLmcpObjectMessage(std::move(receivedTcpMessage));
+                    UXAS_LOG_WARN(s_typeName(), "::executeTcpReceiveProcessing failed to unpack all messages of received batch");
                 }
-                else
+                for (auto& batchedTcpMessage : batchedTcpMessages)
                 {
-                    UXAS_LOG_INFORM(s_typeName(), "::executeTcpReceiveProcessing ignoring non-import message with address ", receivedTcpMessage->getAddress(), ", source entity ID ", receivedTcpMessage->getMessageAttributesReference()->getSourceEntityId(), " and source service ID ", receivedTcpMessage->getMessageAttributesReference()->getSourceServiceId());
+                    forwardReceivedTcpMessage(std::move(batchedTcpMessage));
                 }
             }
             else
             {
-                UXAS_LOG_INFORM(s_typeName(), "::executeTcpReceiveProcessing ignoring external message with entity ID ", m_entityIdString, " since it matches its own entity ID");
+                forwardReceivedTcpMessage(std::move(receivedTcpMessage));
             }
         }
         UXAS_LOG_INFORM(s_typeName(), "::executeTcpReceiveProcessing exiting infinite loop thread [", std::this_thread::get_id(), "]");
@@ -255,5 +290,88 @@ LmcpObjectNetworkTcpBridge::executeTcpReceiveProcessing()
     }
 };
 
+void
+LmcpObjectNetworkTcpBridge::forwardReceivedTcpMessage(std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> receivedTcpMessage)
+{
+    if (receivedTcpMessage)
+    {
+        if (m_nonImportForwardAddresses.find(receivedTcpMessage->getAddress()) == m_nonImportForwardAddresses.end())
+        {
+            if(m_isConsideredSelfGenerated)
+            {
+                receivedTcpMessage->updateSourceAttributes("TcpBridge", std::to_string(m_entityId), std::to_string(m_networkId));
+            }
+
+            const auto it = m_messageAddressToAlias.find(receivedTcpMessage->getAddress());
+            if (it != m_messageAddressToAlias.cend())
+            {
+                receivedTcpMessage->updateAddress(it->second);
+            }
+
+            sendSerializedLmcpObjectMessage(std::move(receivedTcpMessage));
+        }
+        else
+        {
+            UXAS_LOG_INFORM(s_typeName(), "::forwardReceivedTcpMessage ignoring non-import message with address ", receivedTcpMessage->getAddress(), ", source entity ID ", receivedTcpMessage->getMessageAttributesReference()->getSourceEntityId(), " and source service ID ", receivedTcpMessage->getMessageAttributesReference()->getSourceServiceId());
+        }
+    }
+    else
+    {
+        UXAS_LOG_INFORM(s_typeName(), "::forwardReceivedTcpMessage ignoring external message with entity ID ", m_entityIdString, " since it matches its own entity ID");
+    }
+};
+
+bool
+LmcpObjectNetworkTcpBridge::isPeerBatching()
+{
+    // binary framing and batches were introduced together: peers that
+    // negotiated binary framing unpack batches, legacy peers do not
+    return (m_externalLmcpObjectMessageTcpReceiverSenderPipe.getPeerFramingVersion() >= uxas::common::FramedSerialBuffer::s_binaryFramingVersion);
+};
+
+void
+LmcpObjectNetworkTcpBridge::sendBatchedMessages()
+{
+    try
+    {
+        std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> batchMessage
+                = m_messageBatcher->createBatchMessage(m_entityIdString, std::to_string(m_networkId));
+        if (!batchMessage)
+        {
+            return;
+        }
+        if (isPeerBatching())
+        {
+            m_externalLmcpObjectMessageTcpReceiverSenderPipe.sendSerializedMessage(std::move(batchMessage));
+        }
+        else
+        {
+            // a legacy peer connected since the messages were batched
+            std::vector<std::unique_ptr<uxas::communications::data::AddressedAttributedMessage>> batchedMessages;
+            uxas::communications::BridgeMessageBatcher::unpackBatchMessage(*batchMessage, batchedMessages);
+            for (auto& batchedMessage : batchedMessages)
+            {
+                m_externalLmcpObjectMessageTcpReceiverSenderPipe.sendSerializedMessage(std::move(batchedMessage));
+            }
+        }
+    }
+    catch (std::exception& ex)
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::sendBatchedMessages failed to send message batch; EXCEPTION: ", ex.what());
+    }
+};
+
+void
+LmcpObjectNetworkTcpBridge::sendMessageBatch()
+{
+    sendBatchedMessages();
+
+    if (++m_batchStatisticsLogCount * m_batchConfiguration.m_batchWindow_ms >= c_batchStatisticsLogPeriod_ms)
+    {
+        m_batchStatisticsLogCount = 0;
+        m_messageBatcher->logStatistics(m_tcpReceiveSendAddress);
+    }
+};
+
 }; //namespace communications
 }; //namespace uxas
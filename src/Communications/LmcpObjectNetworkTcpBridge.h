@@ -10,6 +10,7 @@
 #ifndef UXAS_MESSAGE_LMCP_OBJECT_NETWORK_TCP_BRIDGE_H
 #define UXAS_MESSAGE_LMCP_OBJECT_NETWORK_TCP_BRIDGE_H
 
+#include "BridgeMessageBatcher.h"
 #include "LmcpObjectNetworkClientBase.h"
 #include "LmcpObjectMessageTcpReceiverSenderPipe.h"
 
@@ -117,6 +118,26 @@ private:
     void
     executeTcpReceiveProcessing();
 
+    /** \brief Forwards a message received from the external entity to the
+     * internal network. */
+    void
+    forwardReceivedTcpMessage(std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> receivedTcpMessage);
+
+    /** \brief True if every peer unpacks batches, i.e., negotiated binary
+     * framing (see FramedSerialBuffer). */
+    bool
+    isPeerBatching();
+
+    /** \brief Sends the current message batch; its messages are sent
+     * individually if a peer does not unpack batches. */
+    void
+    sendBatchedMessages();
+
+    /** \brief Sends the current message batch and periodically logs the
+     * batching statistics (timer callback). */
+    void
+    sendMessageBatch();
+
     std::atomic<bool> m_isTerminate{false};
 
     /** \brief External TCP processing thread.  */
@@ -144,6 +165,15 @@ private:
     bool m_isConsideredSelfGenerated{true};
     
     std::map<std::string, std::string> m_messageAddressToAlias;
+
+    /** \brief If the batch window is non-zero, exported messages are batched
+     * (see BridgeMessageBatcher) and sent by a periodic timer while every
+     * peer unpacks batches; otherwise they are sent individually (received
+     * batches are always unpacked). */
+    uxas::communications::BridgeMessageBatcher::Configuration m_batchConfiguration;
+    std::unique_ptr<uxas::communications::BridgeMessageBatcher> m_messageBatcher;
+    uint64_t m_batchTimerId{0};
+    uint64_t m_batchStatisticsLogCount{0};
 };
 
 }; //namespace communications
@@ -12,8 +12,10 @@
 #include "uxas/messages/uxnative/EntityJoin.h"
 #include "uxas/messages/uxnative/EntityExit.h"
 
+#include "UxAS_ConfigurationManager.h"
 #include "UxAS_Log.h"
 #include "Constants/UxAS_String.h"
+#include "UxAS_TimerManager.h"
 
 #include "stdUniquePtr.h"
 
@@ -40,6 +42,7 @@
 #include <termio.h>
 #endif
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <map>
@@ -50,7 +53,19 @@ namespace uxas
 namespace communications
 {
 
+namespace
+{
+
+/** \brief bound on the number of distinct addresses whose routes are cached */
+const size_t c_maximumRoutedAddressCount{4096};
+
+/** \brief period of the batching statistics log */
+const uint64_t c_batchStatisticsLogPeriod_ms{60000};
+
+} //namespace
+
 LmcpObjectNetworkZeroMqZyreBridge::LmcpObjectNetworkZeroMqZyreBridge()
+: m_peerRoutingCache(c_maximumRoutedAddressCount)
 {
 };
 
@@ -66,6 +81,10 @@ LmcpObjectNetworkZeroMqZyreBridge::configure(const pugi::xml_node& bridgeXmlNode
     m_headerKeyValuePairs = uxas::stduxas::make_unique<std::unordered_map<std::string, std::string>>();
     m_headerKeyValuePairs->emplace(uxas::common::StringConstant::EntityID(), m_entityIdString);
     m_headerKeyValuePairs->emplace(uxas::common::StringConstant::EntityType(), m_entityType);
+    // peers without this header entry are sent sentinel frames
+    m_headerKeyValuePairs->emplace(uxas::common::StringConstant::SerialFramingVersion(), std::to_string(uxas::common::ConfigurationManager::getSerialFramingVersion()));
+    // received batches are always unpacked; peers without this header entry are never sent batches
+    m_headerKeyValuePairs->emplace(uxas::common::StringConstant::MessageBatchVersion(), std::to_string(uxas::communications::BridgeMessageBatcher::s_batchFormatVersion));
     
     if (!bridgeXmlNode.attribute(uxas::common::StringConstant::GossipBind().c_str()).empty())
     {
@@ -108,6 +127,8 @@ LmcpObjectNetworkZeroMqZyreBridge::configure(const pugi::xml_node& bridgeXmlNode
         }
     }
 
+    uxas::communications::BridgeMessageBatcher::readConfiguration(bridgeXmlNode, m_batchConfiguration);
+
     std::set<std::string> extSubAddDupChk; // prevent dup external address subscription
     std::string delimitedExtSubAddresses{""};
     for (pugi::xml_node currentXmlNode = bridgeXmlNode.first_child(); currentXmlNode; currentXmlNode = currentXmlNode.next_sibling())
@@ -180,12 +201,33 @@ LmcpObjectNetworkZeroMqZyreBridge::configure(const pugi::xml_node& bridgeXmlNode
 bool
 LmcpObjectNetworkZeroMqZyreBridge::start()
 {
+    if (m_batchConfiguration.m_batchWindow_ms > 0)
+    {
+        m_batchTimerId = uxas::common::TimerManager::getInstance().createTimer(
+            std::bind(&LmcpObjectNetworkZeroMqZyreBridge::sendMessageBatches, this), "LmcpObjectNetworkZeroMqZyreBridge::sendMessageBatches");
+        uxas::common::TimerManager::getInstance().startPeriodicTimer(m_batchTimerId, m_batchConfiguration.m_batchWindow_ms, m_batchConfiguration.m_batchWindow_ms);
+        UXAS_LOG_INFORM(s_typeName(), "::start batching messages to remote entities every ", m_batchConfiguration.m_batchWindow_ms, " ms");
+    }
     return (m_zeroMqZyreBridge.start(m_zyreNetworkDevice, m_zyreEndpoint, m_gossipEndpoint, m_isGossipBind, m_entityIdString, m_headerKeyValuePairs));
 };
 
 bool
 LmcpObjectNetworkZeroMqZyreBridge::terminate()
 {
+    if (m_batchTimerId && !uxas::common::TimerManager::getInstance().destroyTimer(m_batchTimerId, 1000))
+    {
+        UXAS_LOG_WARN(s_typeName(), "::terminate failed to destroy batch timer");
+    }
+    m_batchTimerId = 0;
+    if (m_batchConfiguration.m_batchWindow_ms > 0)
+    {
+        sendMessageBatches();
+        std::lock_guard<std::mutex> lock(m_batchMutex);
+        for (auto& peerMessageBatch : m_messageBatchesByZyreUuid)
+        {
+            peerMessageBatch.second.m_messageBatcher->logStatistics(peerMessageBatch.second.m_linkName);
+        }
+    }
     return (m_zeroMqZyreBridge.terminate());
 };
 
@@ -224,23 +266,41 @@ LmcpObjectNetworkZeroMqZyreBridge::processReceivedSerializedLmcpMessage(std::uni
         if (m_nonExportForwardAddresses.find(receivedLmcpMessage->getAddress()) == m_nonExportForwardAddresses.end())
         {
             UXAS_LOG_INFORM_ASSIGNMENT(s_typeName(), "::processReceivedSerializedLmcpMessage processing message with source entity ID ", receivedLmcpMessage->getMessageAttributesReference()->getSourceEntityId());
-            std::unique_lock<std::mutex> lock(m_mutex);
-            std::set<std::string> uuidsSentMsg; // avoid sending message out to an entity more than once
-            for (const auto& addressAndUuids : m_remoteZyreUuidsBySubscriptionAddress)
+            // the routing index is immutable, so no lock is needed while sending
+            std::shared_ptr<const RoutingIndex> routingIndex = std::atomic_load(&m_routingIndex);
+            const PeerRoutingIndex::PeerBitset& routedPeers = m_peerRoutingCache.getRoutedPeers(routingIndex->m_peerRoutingIndex, receivedLmcpMessage->getAddress());
+            std::string framedMessages[2]; // framed once per framing version, then re-used for every remote entity
+            for (size_t wordIndex = 0; wordIndex < routedPeers.size(); wordIndex++)
             {
-                if (receivedLmcpMessage->getAddress().size() >= addressAndUuids.first.size()
-                        && receivedLmcpMessage->getAddress().compare(0, addressAndUuids.first.size(), addressAndUuids.first) == 0)
+                uint64_t word = routedPeers[wordIndex];
+                for (size_t bitIndex = 0; word != 0; bitIndex++, word >>= 1)
                 {
-                    for (const auto& uuid : addressAndUuids.second)
+                    if ((word & 1u) == 0)
                     {
-                        auto uuidIt = uuidsSentMsg.find(uuid);
-                        if (uuidIt == uuidsSentMsg.end())
+                        continue;
+                    }
+                    const RoutingIndex::Peer& peer = routingIndex->m_peers[wordIndex * 64 + bitIndex];
+                    if (peer.m_isBatching)
+                    {
+                        std::lock_guard<std::mutex> lock(m_batchMutex);
+                        PeerMessageBatch& peerMessageBatch = m_messageBatchesByZyreUuid[peer.m_zyreUuid];
+                        if (!peerMessageBatch.m_messageBatcher)
                         {
-                            uuidsSentMsg.emplace(uuid);
-                            m_zeroMqZyreBridge.sendZyreWhisperMessage(uuid, uxas::common::SentinelSerialBuffer::createSentinelizedString(receivedLmcpMessage->getString()));
-                            UXAS_LOG_INFORM_ASSIGNMENT(s_typeName(), "::processReceivedSerializedLmcpMessage sent ", receivedLmcpMessage->getMessageAttributesReference()->getDescriptor(), " message to Zyre UUID ", uuid, " associated with ", m_remoteEntityTypeIdsByZyreUuids[uuid].first, " with ID ", m_remoteEntityTypeIdsByZyreUuids[uuid].second);
+                            peerMessageBatch.m_messageBatcher = uxas::stduxas::make_unique<uxas::communications::BridgeMessageBatcher>(m_batchConfiguration);
+                            peerMessageBatch.m_linkName = peer.m_entityType + " " + peer.m_entityId;
                         }
+                        peerMessageBatch.m_framingVersion = peer.m_framingVersion;
+                        peerMessageBatch.m_messageBatcher->addMessage(*receivedLmcpMessage);
+                        continue;
+                    }
+                    bool isBinaryFraming = peer.m_framingVersion >= uxas::common::FramedSerialBuffer::s_binaryFramingVersion;
+                    std::string& framedMessage = framedMessages[isBinaryFraming ? 1 : 0];
+                    if (framedMessage.empty())
+                    {
+                        uxas::common::FramedSerialBuffer::appendFramedString(receivedLmcpMessage->getString(), peer.m_framingVersion, framedMessage);
                     }
+                    sendZyreWhisperMessage(peer.m_zyreUuid, framedMessage);
+                    UXAS_LOG_INFORM_ASSIGNMENT(s_typeName(), "::processReceivedSerializedLmcpMessage sent ", receivedLmcpMessage->getMessageAttributesReference()->getDescriptor(), " message to Zyre UUID ", peer.m_zyreUuid, " associated with ", peer.m_entityType, " with ID ", peer.m_entityId);
                 }
             }
         }
@@ -303,6 +363,20 @@ LmcpObjectNetworkZeroMqZyreBridge::zyreEnterMessageHandler(const std::string& zy
         UXAS_LOG_WARN(s_typeName(), "::zyreEnterMessageHandler unexpectedly removed existing Zyre UUID/entity ID map pair");
     }
     m_remoteEntityTypeIdsByZyreUuids.emplace(zyreRemoteUuid, std::make_pair(entityTypeKvPairIt->second, entityIdKvPairIt->second));
+    uint8_t framingVersion{uxas::common::FramedSerialBuffer::s_sentinelFramingVersion};
+    auto framingVersionKvPairIt = headerKeyValuePairs.find(uxas::common::StringConstant::SerialFramingVersion());
+    if (framingVersionKvPairIt != headerKeyValuePairs.end() && std::atoi(framingVersionKvPairIt->second.c_str()) >= uxas::common::FramedSerialBuffer::s_binaryFramingVersion
+            && uxas::common::ConfigurationManager::getSerialFramingVersion() >= uxas::common::FramedSerialBuffer::s_binaryFramingVersion)
+    {
+        framingVersion = uxas::common::FramedSerialBuffer::s_binaryFramingVersion;
+    }
+    m_remoteFramingVersionsByZyreUuids[zyreRemoteUuid] = framingVersion;
+    auto batchVersionKvPairIt = headerKeyValuePairs.find(uxas::common::StringConstant::MessageBatchVersion());
+    if (m_batchConfiguration.m_batchWindow_ms > 0 && batchVersionKvPairIt != headerKeyValuePairs.end()
+            && std::atoi(batchVersionKvPairIt->second.c_str()) >= uxas::communications::BridgeMessageBatcher::s_batchFormatVersion)
+    {
+        m_batchingZyreUuids.insert(zyreRemoteUuid);
+    }
     UXAS_LOG_INFORM_ASSIGNMENT(s_typeName(), "::zyreEnterMessageHandler added Zyre UUID ", zyreRemoteUuid, " to entity map for ", entityTypeKvPairIt->second, " with ID ", entityIdKvPairIt->second);
 
     std::vector<std::string> addresses = uxas::common::StringUtil::split(subAddsKvPairIt->second, *(m_extSubAddressDelimiter.c_str()));
@@ -340,6 +414,8 @@ LmcpObjectNetworkZeroMqZyreBridge::zyreEnterMessageHandler(const std::string& zy
         }
     }
 
+    rebuildRoutingIndex();
+
     // broadcast entity join message
     UXAS_LOG_INFORM_ASSIGNMENT(s_typeName(), "::zyreEnterMessageHandler broadcasting EntityJoin for type [", entityTypeKvPairIt->second, "] ID [", entityIdKvPairIt->second, "]");
     std::unique_ptr<uxas::messages::uxnative::EntityJoin> entityJoin = uxas::stduxas::make_unique<uxas::messages::uxnative::EntityJoin>();
@@ -401,10 +477,52 @@ LmcpObjectNetworkZeroMqZyreBridge::zyreExitMessageHandler(const std::string& zyr
     {
         UXAS_LOG_WARN(s_typeName(), "::zyreExitMessageHandler unexpectedly did not find (so did not remove) Zyre UUID/entity ID map pair; not sending internal EntityExit message");
     }
+    m_remoteFramingVersionsByZyreUuids.erase(zyreRemoteUuid);
+    m_batchingZyreUuids.erase(zyreRemoteUuid);
+    rebuildRoutingIndex();
+    {
+        // messages batched for the exiting entity are discarded
+        std::lock_guard<std::mutex> batchLock(m_batchMutex);
+        auto peerMessageBatchIt = m_messageBatchesByZyreUuid.find(zyreRemoteUuid);
+        if (peerMessageBatchIt != m_messageBatchesByZyreUuid.end())
+        {
+            peerMessageBatchIt->second.m_messageBatcher->logStatistics(peerMessageBatchIt->second.m_linkName);
+            m_messageBatchesByZyreUuid.erase(peerMessageBatchIt);
+        }
+    }
 
     UXAS_LOG_INFORM(s_typeName(), "::zyreExitMessageHandler - END");
 };
 
+void
+LmcpObjectNetworkZeroMqZyreBridge::rebuildRoutingIndex()
+{
+    auto routingIndex = std::make_shared<RoutingIndex>();
+    routingIndex->m_peerRoutingIndex = std::make_shared<const PeerRoutingIndex>(m_remoteZyreUuidsBySubscriptionAddress);
+    for (size_t peerIndex = 0; peerIndex < routingIndex->m_peerRoutingIndex->getPeerCount(); peerIndex++)
+    {
+        RoutingIndex::Peer peer;
+        peer.m_zyreUuid = routingIndex->m_peerRoutingIndex->getPeerId(peerIndex);
+        auto entityTypeIdIt = m_remoteEntityTypeIdsByZyreUuids.find(peer.m_zyreUuid);
+        if (entityTypeIdIt != m_remoteEntityTypeIdsByZyreUuids.end())
+        {
+            peer.m_entityType = entityTypeIdIt->second.first;
+            peer.m_entityId = entityTypeIdIt->second.second;
+        }
+        auto framingVersionIt = m_remoteFramingVersionsByZyreUuids.find(peer.m_zyreUuid);
+        if (framingVersionIt != m_remoteFramingVersionsByZyreUuids.end())
+        {
+            peer.m_framingVersion = framingVersionIt->second;
+        }
+        peer.m_isBatching = m_batchingZyreUuids.find(peer.m_zyreUuid) != m_batchingZyreUuids.end();
+        routingIndex->m_peers.push_back(std::move(peer));
+    }
+
+    UXAS_LOG_INFORM(s_typeName(), "::rebuildRoutingIndex routing ", routingIndex->m_peerRoutingIndex->getSubscriptionAddressCount(),
+                    " subscription addresses to ", routingIndex->m_peers.size(), " remote entities");
+    std::atomic_store(&m_routingIndex, std::shared_ptr<const RoutingIndex>(std::move(routingIndex)));
+};
+
 void
 LmcpObjectNetworkZeroMqZyreBridge::zyreWhisperMessageHandler(const std::string& zyreRemoteUuid, const std::string& messagePayload)
 {
@@ -421,28 +539,21 @@ LmcpObjectNetworkZeroMqZyreBridge::zyreWhisperMessageHandler(const std::string&
                     = uxas::stduxas::make_unique<uxas::communications::data::AddressedAttributedMessage>();
             if (recvdAddAttMsg->setAddressAttributesAndPayloadFromDelimitedString(std::move(recvdZyreDataSegment)))
             {
-                UXAS_LOG_INFORM(s_typeName(), "::zyreWhisperMessageHandler processing ", recvdAddAttMsg->getMessageAttributesReference()->getDescriptor(),
-                           " message from ", m_remoteEntityTypeIdsByZyreUuids[zyreRemoteUuid].first, " with ID ", m_remoteEntityTypeIdsByZyreUuids[zyreRemoteUuid].second);
-
-                // process messages from an external service (only)
-                if (m_entityIdString != recvdAddAttMsg->getMessageAttributesReference()->getSourceEntityId())
+                if (uxas::communications::BridgeMessageBatcher::isBatchMessage(*recvdAddAttMsg))
                 {
-                    if (m_nonImportForwardAddresses.find(recvdAddAttMsg->getAddress()) == m_nonImportForwardAddresses.end())
+                    std::vector<std::unique_ptr<uxas::communications::data::AddressedAttributedMessage>> batchedAddAttMsgs;
+                    if (!uxas::communications::BridgeMessageBatcher::unpackBatchMessage(*recvdAddAttMsg, batchedAddAttMsgs))
                     {
-                        if(m_isConsideredSelfGenerated)
-                        {
-                            recvdAddAttMsg->updateSourceAttributes("ZyreBridge", std::to_string(m_entityId), std::to_string(m_networkId));
-                        }
-                        sendSerializedLmcpObjectMessage(std::move(recvdAddAttMsg));
+                        UXAS_LOG_WARN(s_typeName(), "::zyreWhisperMessageHandler failed to unpack all messages of received batch");
                     }
-                    else
+                    for (auto& batchedAddAttMsg : batchedAddAttMsgs)
                     {
-                        UXAS_LOG_INFORM(s_typeName(), "::zyreWhisperMessageHandler ignoring non-import message with address ", recvdAddAttMsg->getAddress(), ", source entity ID ", recvdAddAttMsg->getMessageAttributesReference()->getSourceEntityId(), " and source service ID ", recvdAddAttMsg->getMessageAttributesReference()->getSourceServiceId());
+                        forwardReceivedZyreMessage(zyreRemoteUuid, std::move(batchedAddAttMsg));
                     }
                 }
                 else
                 {
-                    UXAS_LOG_INFORM(s_typeName(), "::zyreWhisperMessageHandler ignoring external message with entity ID ", m_entityIdString, " since it matches its own entity ID");
+                    forwardReceivedZyreMessage(zyreRemoteUuid, std::move(recvdAddAttMsg));
                 }
             }
             else
@@ -469,5 +580,66 @@ LmcpObjectNetworkZeroMqZyreBridge::zyreWhisperMessageHandler(const std::string&
     }
 };
 
+void
+LmcpObjectNetworkZeroMqZyreBridge::forwardReceivedZyreMessage(const std::string& zyreRemoteUuid, std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> recvdAddAttMsg)
+{
+    UXAS_LOG_INFORM(s_typeName(), "::forwardReceivedZyreMessage processing ", recvdAddAttMsg->getMessageAttributesReference()->getDescriptor(),
+               " message from ", m_remoteEntityTypeIdsByZyreUuids[zyreRemoteUuid].first, " with ID ", m_remoteEntityTypeIdsByZyreUuids[zyreRemoteUuid].second);
+
+    // process messages from an external service (only)
+    if (m_entityIdString != recvdAddAttMsg->getMessageAttributesReference()->getSourceEntityId())
+    {
+        if (m_nonImportForwardAddresses.find(recvdAddAttMsg->getAddress()) == m_nonImportForwardAddresses.end())
+        {
+            if(m_isConsideredSelfGenerated)
+            {
+                recvdAddAttMsg->updateSourceAttributes("ZyreBridge", std::to_string(m_entityId), std::to_string(m_networkId));
+            }
+            sendSerializedLmcpObjectMessage(std::move(recvdAddAttMsg));
+        }
+        else
+        {
+            UXAS_LOG_INFORM(s_typeName(), "::forwardReceivedZyreMessage ignoring non-import message with address ", recvdAddAttMsg->getAddress(), ", source entity ID ", recvdAddAttMsg->getMessageAttributesReference()->getSourceEntityId(), " and source service ID ", recvdAddAttMsg->getMessageAttributesReference()->getSourceServiceId());
+        }
+    }
+    else
+    {
+        UXAS_LOG_INFORM(s_typeName(), "::forwardReceivedZyreMessage ignoring external message with entity ID ", m_entityIdString, " since it matches its own entity ID");
+    }
+};
+
+void
+LmcpObjectNetworkZeroMqZyreBridge::sendZyreWhisperMessage(const std::string& zyreRemoteUuid, const std::string& messagePayload)
+{
+    std::lock_guard<std::mutex> lock(m_sendMutex);
+    m_zeroMqZyreBridge.sendZyreWhisperMessage(zyreRemoteUuid, messagePayload);
+};
+
+void
+LmcpObjectNetworkZeroMqZyreBridge::sendMessageBatches()
+{
+    bool isLogStatistics = ++m_batchStatisticsLogCount * m_batchConfiguration.m_batchWindow_ms >= c_batchStatisticsLogPeriod_ms;
+    if (isLogStatistics)
+    {
+        m_batchStatisticsLogCount = 0;
+    }
+
+    std::lock_guard<std::mutex> lock(m_batchMutex);
+    for (auto& peerMessageBatch : m_messageBatchesByZyreUuid)
+    {
+        std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> batchMessage
+                = peerMessageBatch.second.m_messageBatcher->createBatchMessage(m_entityIdString, std::to_string(m_networkId));
+        if (batchMessage)
+        {
+            sendZyreWhisperMessage(peerMessageBatch.first,
+                                   uxas::common::FramedSerialBuffer::createFramedString(batchMessage->getString(), peerMessageBatch.second.m_framingVersion));
+        }
+        if (isLogStatistics)
+        {
+            peerMessageBatch.second.m_messageBatcher->logStatistics(peerMessageBatch.second.m_linkName);
+        }
+    }
+};
+
 }; //namespace communications
 }; //namespace uxas
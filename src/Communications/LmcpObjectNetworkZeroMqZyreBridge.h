@@ -10,14 +10,18 @@
 #ifndef UXAS_MESSAGE_LMCP_OBJECT_NETWORK_ZERO_MQ_ZYRE_BRIDGE_H
 #define    UXAS_MESSAGE_LMCP_OBJECT_NETWORK_ZERO_MQ_ZYRE_BRIDGE_H
 
+#include "BridgeMessageBatcher.h"
 #include "LmcpObjectNetworkClientBase.h"
+#include "PeerRoutingIndex.h"
 #include "ZeroMqZyreBridge.h"
 
-#include "UxAS_SentinelSerialBuffer.h"
+#include "UxAS_FramedSerialBuffer.h"
 
 #include <thread>
+#include <cstdint>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <unordered_map>
 #include <vector>
 
@@ -229,6 +233,55 @@ private:
     void
     zyreWhisperMessageHandler(const std::string& zyreRemoteUuid, const std::string& messagePayload);
 
+    /** \brief Forwards a message received from a remote entity to the
+     * internal network. */
+    void
+    forwardReceivedZyreMessage(const std::string& zyreRemoteUuid, std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> recvdAddAttMsg);
+
+    void
+    sendZyreWhisperMessage(const std::string& zyreRemoteUuid, const std::string& messagePayload);
+
+    /** \brief Sends the current message batch of every batching remote
+     * entity (timer callback). */
+    void
+    sendMessageBatches();
+
+    /** \class RoutingIndex
+     *
+     * \par Description:
+     * Immutable snapshot of the remote subscriptions, compiled from
+     * <B><i>m_remoteZyreUuidsBySubscriptionAddress</i></B> whenever a remote
+     * entity enters or exits. <B><i>m_peers</i></B> holds the remote entities
+     * in the peer order of <B><i>m_peerRoutingIndex</i></B>.
+     */
+    class RoutingIndex
+    {
+    public:
+        class Peer
+        {
+        public:
+            std::string m_zyreUuid;
+            std::string m_entityType;
+            std::string m_entityId;
+            /** \brief framing version used for messages to this peer */
+            uint8_t m_framingVersion{uxas::common::FramedSerialBuffer::s_sentinelFramingVersion};
+            /** \brief messages are sent in batches (see <B><i>m_messageBatchesByZyreUuid</i></B>) */
+            bool m_isBatching{false};
+        };
+
+        std::shared_ptr<const PeerRoutingIndex> m_peerRoutingIndex{std::make_shared<const PeerRoutingIndex>()};
+        std::vector<Peer> m_peers;
+    };
+
+    /** \brief Compiles a new <B><i>RoutingIndex</i></B> from the current
+     * remote subscriptions and makes it current. Must be called with
+     * <B><i>m_mutex</i></B> held. */
+    void
+    rebuildRoutingIndex();
+
+    /** \brief Guards the remote entity maps below, which the Zyre enter and
+     * exit handlers (Zyre event thread) change. The sending threads never
+     * take it and read <B><i>m_routingIndex</i></B> instead. */
     std::mutex m_mutex;
     ZeroMqZyreBridge m_zeroMqZyreBridge;
     
@@ -242,15 +295,53 @@ private:
     std::unique_ptr<std::unordered_map<std::string, std::string>> m_headerKeyValuePairs;
 	std::string m_extSubAddressDelimiter = std::string(";");
     
-    uxas::common::SentinelSerialBuffer m_receiveZyreDataBuffer;
+    uxas::common::FramedSerialBuffer m_receiveZyreDataBuffer;
     
     std::unordered_map<std::string, std::pair<std::string, std::string>> m_remoteEntityTypeIdsByZyreUuids;
+    /** \brief framing version announced in the Zyre header of each remote entity */
+    std::unordered_map<std::string, uint8_t> m_remoteFramingVersionsByZyreUuids;
+    /** \brief remote entities that are sent batches (batching is configured
+     * and the remote bridge unpacks batches) */
+    std::set<std::string> m_batchingZyreUuids;
     std::unordered_map<std::string, std::set<std::string>> m_remoteZyreUuidsBySubscriptionAddress;
 
+    /** \brief current routing index; replaced (never modified) under
+     * <B><i>m_mutex</i></B> and loaded atomically by the sending thread */
+    std::shared_ptr<const RoutingIndex> m_routingIndex{std::make_shared<const RoutingIndex>()};
+    /** \brief routed peers of recent addresses; only used by the network
+     * client thread */
+    PeerRoutingCache m_peerRoutingCache;
+
     std::set<std::string> m_initialPersistentLocalSubscriptionAddresses;
     std::set<std::string> m_nonImportForwardAddresses;
     std::set<std::string> m_nonExportForwardAddresses;
     bool m_isConsideredSelfGenerated{false};
+
+    /** \brief Messages to a remote entity that is sent batches */
+    class PeerMessageBatch
+    {
+    public:
+        std::unique_ptr<uxas::communications::BridgeMessageBatcher> m_messageBatcher;
+        uint8_t m_framingVersion{uxas::common::FramedSerialBuffer::s_sentinelFramingVersion};
+        std::string m_linkName;
+    };
+
+    /** \brief If the batch window is non-zero, messages to remote entities
+     * that unpack batches are batched per remote entity and sent by a
+     * periodic timer. */
+    uxas::communications::BridgeMessageBatcher::Configuration m_batchConfiguration;
+    std::mutex m_batchMutex;
+    std::unordered_map<std::string, PeerMessageBatch> m_messageBatchesByZyreUuid;
+    uint64_t m_batchTimerId{0};
+    uint64_t m_batchStatisticsLogCount{0};
+    /** \brief Serializes the whispers of the network client thread and the
+     * batch timer thread, which share the actor pipe of the Zyre node. The
+     * Zyre event thread does not take it: it only reads the inbox socket of
+     * the node (under the mutex of <B><i>ZeroMqZyreBridge</i></B>), and its
+     * enter and exit handlers change routing under <B><i>m_mutex</i></B>
+     * and publish it through <B><i>m_routingIndex</i></B>. Lock order:
+     * <B><i>m_batchMutex</i></B> before <B><i>m_sendMutex</i></B>. */
+    std::mutex m_sendMutex;
 };
 
 }; //namespace communications
@@ -0,0 +1,91 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#include "LmcpObjectSerializer.h"
+
+#include "avtas/lmcp/ByteBuffer.h"
+#include "avtas/lmcp/Factory.h"
+
+#include "UxAS_Log.h"
+
+namespace uxas
+{
+namespace communications
+{
+
+std::unique_ptr<avtas::lmcp::Object>
+LmcpObjectSerializer::deserialize(const uint8_t* data, size_t size)
+{
+    std::unique_ptr<avtas::lmcp::Object> lmcpObject;
+
+    if (data == nullptr || size == 0)
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::deserialize received empty payload");
+        return (lmcpObject);
+    }
+
+    // the LMCP factory validates the checksum against the buffer capacity,
+    // so the buffer must be sized exactly to the payload
+    avtas::lmcp::ByteBuffer lmcpByteBuffer;
+    lmcpByteBuffer.allocate(static_cast<uint32_t>(size));
+    lmcpByteBuffer.put(data, static_cast<uint32_t>(size));
+    lmcpByteBuffer.rewind();
+
+    lmcpObject.reset(avtas::lmcp::Factory::getObject(lmcpByteBuffer));
+    if (!lmcpObject)
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::deserialize failed to convert message payload into an LMCP object");
+    }
+
+    return (lmcpObject);
+};
+
+bool
+LmcpObjectSerializer::getLmcpTypeIds(const uint8_t* data, size_t size, int64_t& seriesId, uint32_t& typeId)
+{
+    // LMCP message: control string (4), size (4), object exists flag (1), 
+    // series ID (8), type ID (4), series version (2), fields, checksum (4); 
+    // all big-endian
+    static const size_t s_existsFlagOffset{8};
+    static const size_t s_seriesIdOffset{9};
+    static const size_t s_typeIdOffset{17};
+    static const size_t s_headerSize{23};
+    if (data == nullptr || size < s_headerSize || data[s_existsFlagOffset] == 0)
+    {
+        return (false);
+    }
+
+    uint64_t series{0};
+    for (size_t byteIndex = 0; byteIndex < 8; byteIndex++)
+    {
+        series = (series << 8) | data[s_seriesIdOffset + byteIndex];
+    }
+    seriesId = static_cast<int64_t>(series);
+    typeId = (static_cast<uint32_t>(data[s_typeIdOffset]) << 24) | (static_cast<uint32_t>(data[s_typeIdOffset + 1]) << 16)
+            | (static_cast<uint32_t>(data[s_typeIdOffset + 2]) << 8) | static_cast<uint32_t>(data[s_typeIdOffset + 3]);
+    return (true);
+};
+
+std::shared_ptr<const std::string>
+LmcpObjectSerializer::serialize(avtas::lmcp::Object* lmcpObject)
+{
+    std::shared_ptr<const std::string> serializedPayload;
+    if (lmcpObject == nullptr)
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::serialize received null LMCP object");
+        return (serializedPayload);
+    }
+
+    std::unique_ptr<avtas::lmcp::ByteBuffer> lmcpByteBuffer(avtas::lmcp::Factory::packMessage(lmcpObject, true));
+    serializedPayload = std::make_shared<const std::string>(reinterpret_cast<char*>(lmcpByteBuffer->array()), lmcpByteBuffer->capacity());
+    return (serializedPayload);
+};
+
+}; //namespace communications
+}; //namespace uxas
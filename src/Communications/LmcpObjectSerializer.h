@@ -0,0 +1,126 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_MESSAGE_LMCP_OBJECT_SERIALIZER_H
+#define UXAS_MESSAGE_LMCP_OBJECT_SERIALIZER_H
+
+#include "avtas/lmcp/Object.h"
+
+#include "UxAS_ZeroMQ.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace uxas
+{
+namespace communications
+{
+
+/** \class LmcpObjectSerializer
+ *
+ * \par Description:
+ * Static helpers that convert between <b>LMCP</b> objects and their serialized
+ * byte representation. Deserialization reads directly from the memory of the
+ * received string or Zero MQ frame and fills the <b>LMCP</b> byte buffer with
+ * a single bulk copy (rather than one <B><i>putByte</i></B> call per byte).
+ * Serialization produces an immutable, shared buffer so that one packed
+ * object can be sent many times without re-packing or copying.
+ *
+ * \n
+ */
+class LmcpObjectSerializer
+{
+public:
+
+    static const std::string&
+    s_typeName() { static std::string s_string("LmcpObjectSerializer"); return (s_string); };
+
+    /** \brief Deserialize an <b>LMCP</b> object from a contiguous byte range.
+     *
+     * @param data pointer to the first byte of the serialized <b>LMCP</b> message.
+     * @param size number of bytes in the serialized <b>LMCP</b> message.
+     * @return unique pointer to <b>LMCP</b> object if succeeds; empty unique pointer if fails.
+     */
+    static
+    std::unique_ptr<avtas::lmcp::Object>
+    deserialize(const uint8_t* data, size_t size);
+
+    /** \brief Deserialize an <b>LMCP</b> object from a payload string.
+     *
+     * @param payload serialized <b>LMCP</b> message.
+     * @return unique pointer to <b>LMCP</b> object if succeeds; empty unique pointer if fails.
+     */
+    static
+    std::unique_ptr<avtas::lmcp::Object>
+    deserialize(const std::string& payload)
+    {
+        return (deserialize(reinterpret_cast<const uint8_t*>(payload.data()), payload.size()));
+    };
+
+    /** \brief Deserialize an <b>LMCP</b> object directly from a received Zero MQ frame.
+     *
+     * @param frame Zero MQ message frame containing a serialized <b>LMCP</b> message.
+     * @return unique pointer to <b>LMCP</b> object if succeeds; empty unique pointer if fails.
+     */
+    static
+    std::unique_ptr<avtas::lmcp::Object>
+    deserialize(const zmq::message_t& frame)
+    {
+        return (deserialize(static_cast<const uint8_t*>(frame.data()), frame.size()));
+    };
+
+    /** \brief Read the series ID and type ID of a serialized <b>LMCP</b> 
+     * message from its header, without deserializing (or validating) it.
+     *
+     * @param data pointer to the first byte of the serialized <b>LMCP</b> message.
+     * @param size number of bytes in the serialized <b>LMCP</b> message.
+     * @param seriesId series ID (series name as long) of the serialized object.
+     * @param typeId type ID of the serialized object within its series.
+     * @return true if the header is complete and contains an object.
+     */
+    static
+    bool
+    getLmcpTypeIds(const uint8_t* data, size_t size, int64_t& seriesId, uint32_t& typeId);
+
+    static
+    bool
+    getLmcpTypeIds(const std::string& payload, int64_t& seriesId, uint32_t& typeId)
+    {
+        return (getLmcpTypeIds(reinterpret_cast<const uint8_t*>(payload.data()), payload.size(), seriesId, typeId));
+    };
+
+    /** \brief Serialize an <b>LMCP</b> object (with checksum) into an immutable,
+     * reference-counted buffer that can be shared by any number of sends.
+     *
+     * @param lmcpObject <b>LMCP</b> object to serialize.
+     * @return shared serialized <b>LMCP</b> message; empty pointer if lmcpObject is null.
+     */
+    static
+    std::shared_ptr<const std::string>
+    serialize(avtas::lmcp::Object* lmcpObject);
+
+private:
+
+    // \brief Prevent construction (static methods only)
+    LmcpObjectSerializer() { };
+
+    /** \brief Copy construction not permitted */
+    LmcpObjectSerializer(LmcpObjectSerializer const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(LmcpObjectSerializer const&) = delete;
+
+};
+
+}; //namespace communications
+}; //namespace uxas
+
+#endif /* UXAS_MESSAGE_LMCP_OBJECT_SERIALIZER_H */
@@ -221,17 +221,31 @@ protected:
     bool
     parseMessageAttributesStringAndSetFields(const std::string delimitedString)
     {
-        std::vector<std::string> tokens = uxas::common::StringUtil::split(delimitedString, *(AddressedMessage::s_fieldDelimiter().c_str()));
-        if (tokens.size() == uxas::communications::data::MessageAttributes::s_attributeCount)
+        // locate the field delimiters in place (avoids building a token vector)
+        const char fieldDelimiter = *(AddressedMessage::s_fieldDelimiter().c_str());
+        std::string::size_type fieldStartIndex[5] = {0, 0, 0, 0, 0};
+        std::string::size_type fieldEndIndex[5] = {0, 0, 0, 0, 0};
+        std::string::size_type startIndex = 0;
+        for (uint32_t fieldIndex = 0; fieldIndex < s_attributeCount; fieldIndex++)
         {
-            return (setAttributes(std::move(tokens.at(0)), std::move(tokens.at(1)), std::move(tokens.at(2)), std::move(tokens.at(3)), std::move(tokens.at(4))));
-        }
-        else
-        {
-            UXAS_LOG_ERROR(s_typeName(), "::parseMessageAttributesStringAndSetFields string must consist of ",  s_attributeCount, " delimited fields");
-            m_isValid = false;
-            return (m_isValid);
+            std::string::size_type delimIndex = delimitedString.find(fieldDelimiter, startIndex);
+            bool isLastField = (fieldIndex + 1 == s_attributeCount);
+            if ((delimIndex == std::string::npos) != isLastField)
+            {
+                UXAS_LOG_ERROR(s_typeName(), "::parseMessageAttributesStringAndSetFields string must consist of ",  s_attributeCount, " delimited fields");
+                m_isValid = false;
+                return (m_isValid);
+            }
+            fieldStartIndex[fieldIndex] = startIndex;
+            fieldEndIndex[fieldIndex] = isLastField ? delimitedString.length() : delimIndex;
+            startIndex = delimIndex + 1;
         }
+
+        return (setAttributes(delimitedString.substr(fieldStartIndex[0], fieldEndIndex[0] - fieldStartIndex[0]),
+                              delimitedString.substr(fieldStartIndex[1], fieldEndIndex[1] - fieldStartIndex[1]),
+                              delimitedString.substr(fieldStartIndex[2], fieldEndIndex[2] - fieldStartIndex[2]),
+                              delimitedString.substr(fieldStartIndex[3], fieldEndIndex[3] - fieldStartIndex[3]),
+                              delimitedString.substr(fieldStartIndex[4], fieldEndIndex[4] - fieldStartIndex[4])));
     };
 
     bool m_isValid{false};
@@ -0,0 +1,281 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#include "MessageEnvelope.h"
+
+#include "Constants/UxAS_String.h"
+
+#include "UxAS_Log.h"
+
+#include <limits>
+
+namespace uxas
+{
+namespace communications
+{
+namespace data
+{
+
+namespace
+{
+
+const uint8_t c_marker{0x00};
+const uint8_t c_magic{0xE5};
+
+const uint8_t c_contentTypeCodeOther{0};
+const uint8_t c_contentTypeCodeLmcp{1};
+const uint8_t c_contentTypeCodeJson{2};
+const uint8_t c_contentTypeCodeXml{3};
+const uint8_t c_contentTypeCodeText{4};
+
+void
+putUint16(std::string& buffer, uint16_t value)
+{
+    buffer.push_back(static_cast<char>((value >> 8) & 0xFF));
+    buffer.push_back(static_cast<char>(value & 0xFF));
+}
+
+void
+putUint32(std::string& buffer, uint32_t value)
+{
+    buffer.push_back(static_cast<char>((value >> 24) & 0xFF));
+    buffer.push_back(static_cast<char>((value >> 16) & 0xFF));
+    buffer.push_back(static_cast<char>((value >> 8) & 0xFF));
+    buffer.push_back(static_cast<char>(value & 0xFF));
+}
+
+void
+putUint64(std::string& buffer, uint64_t value)
+{
+    putUint32(buffer, static_cast<uint32_t>(value >> 32));
+    putUint32(buffer, static_cast<uint32_t>(value & 0xFFFFFFFF));
+}
+
+uint16_t
+getUint16(const uint8_t* data)
+{
+    return (static_cast<uint16_t>((static_cast<uint16_t>(data[0]) << 8) | data[1]));
+}
+
+uint32_t
+getUint32(const uint8_t* data)
+{
+    return ((static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16)
+            | (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]));
+}
+
+uint64_t
+getUint64(const uint8_t* data)
+{
+    return ((static_cast<uint64_t>(getUint32(data)) << 32) | getUint32(data + 4));
+}
+
+} //namespace
+
+const uint8_t MessageEnvelope::s_version;
+const size_t MessageEnvelope::s_headerSize;
+const uint8_t MessageEnvelope::s_payloadInNextFrameFlag;
+
+bool
+MessageEnvelope::isEnvelope(const void* data, size_t size)
+{
+    if (data == nullptr || size < s_headerSize)
+    {
+        return (false);
+    }
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    return (bytes[0] == c_marker && bytes[1] == c_magic && bytes[2] == s_version);
+};
+
+bool
+MessageEnvelope::toSourceId(const std::string& idString, uint32_t& id)
+{
+    if (idString.empty())
+    {
+        return (false);
+    }
+    // decimal digits only (strtoul would accept a sign or leading white
+    // space, and wraps "-1" to the largest unsigned long)
+    uint64_t value{0};
+    for (char character : idString)
+    {
+        if (character < '0' || character > '9')
+        {
+            return (false);
+        }
+        value = value * 10 + static_cast<uint64_t>(character - '0');
+        if (value > std::numeric_limits<uint32_t>::max())
+        {
+            return (false);
+        }
+    }
+    id = static_cast<uint32_t>(value);
+    return (true);
+};
+
+bool
+MessageEnvelope::encode(const std::string& contentType, const std::string& descriptor, const std::string& sourceGroup,
+                        uint32_t sourceEntityId, uint32_t sourceServiceId, const std::chrono::steady_clock::time_point& sendTime,
+                        const std::string& payload, bool isPayloadInNextFrame, std::string& envelope)
+{
+    if (contentType.empty() || descriptor.empty() || payload.empty())
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::encode content type, descriptor and payload must be non-empty");
+        return (false);
+    }
+
+    uint8_t contentTypeCode = getContentTypeCode(contentType);
+    if (descriptor.size() > std::numeric_limits<uint16_t>::max()
+            || sourceGroup.size() > std::numeric_limits<uint16_t>::max()
+            || (contentTypeCode == c_contentTypeCodeOther && contentType.size() > std::numeric_limits<uint8_t>::max())
+            || payload.size() > std::numeric_limits<uint32_t>::max())
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::encode attribute or payload length exceeds envelope field width");
+        return (false);
+    }
+
+    envelope.reserve(envelope.size() + s_headerSize + descriptor.size() + sourceGroup.size()
+                     + (isPayloadInNextFrame ? 0 : payload.size()) + (contentTypeCode == c_contentTypeCodeOther ? contentType.size() : 0));
+    envelope.push_back(static_cast<char>(c_marker));
+    envelope.push_back(static_cast<char>(c_magic));
+    envelope.push_back(static_cast<char>(s_version));
+    envelope.push_back(static_cast<char>(isPayloadInNextFrame ? s_payloadInNextFrameFlag : 0));
+    envelope.push_back(static_cast<char>(contentTypeCode));
+    putUint32(envelope, sourceEntityId);
+    putUint32(envelope, sourceServiceId);
+    putUint16(envelope, static_cast<uint16_t>(descriptor.size()));
+    envelope.push_back(static_cast<char>(contentTypeCode == c_contentTypeCodeOther ? contentType.size() : 0));
+    putUint16(envelope, static_cast<uint16_t>(sourceGroup.size()));
+    putUint32(envelope, static_cast<uint32_t>(payload.size()));
+    putUint64(envelope, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(sendTime.time_since_epoch()).count()));
+    if (contentTypeCode == c_contentTypeCodeOther)
+    {
+        envelope.append(contentType);
+    }
+    envelope.append(descriptor);
+    envelope.append(sourceGroup);
+    if (!isPayloadInNextFrame)
+    {
+        envelope.append(payload);
+    }
+    return (true);
+};
+
+bool
+MessageEnvelope::getSourceIds(const void* data, size_t size, uint32_t& sourceEntityId, uint32_t& sourceServiceId)
+{
+    if (!isEnvelope(data, size))
+    {
+        return (false);
+    }
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    sourceEntityId = getUint32(bytes + 5);
+    sourceServiceId = getUint32(bytes + 9);
+    return (true);
+};
+
+std::unique_ptr<AddressedAttributedMessage>
+MessageEnvelope::decode(const std::string& address, const void* data, size_t size, const void* payloadData, size_t payloadSize)
+{
+    std::unique_ptr<AddressedAttributedMessage> message;
+    if (!isEnvelope(data, size))
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::decode data is not a version ", static_cast<uint32_t>(s_version), " message envelope");
+        return (message);
+    }
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    bool isPayloadInNextFrame = (bytes[3] & s_payloadInNextFrameFlag) != 0;
+    uint8_t contentTypeCode = bytes[4];
+    uint32_t sourceEntityId = getUint32(bytes + 5);
+    uint32_t sourceServiceId = getUint32(bytes + 9);
+    size_t descriptorLength = getUint16(bytes + 13);
+    size_t contentTypeLength = bytes[15];
+    size_t sourceGroupLength = getUint16(bytes + 16);
+    size_t payloadLength = getUint32(bytes + 18);
+    std::chrono::steady_clock::time_point sendTime(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::nanoseconds(static_cast<int64_t>(getUint64(bytes + 22)))));
+
+    size_t expectedSize = s_headerSize + contentTypeLength + descriptorLength + sourceGroupLength + (isPayloadInNextFrame ? 0 : payloadLength);
+    if (size != expectedSize || (isPayloadInNextFrame && (payloadData == nullptr || payloadSize != payloadLength)))
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::decode envelope field lengths do not match received size ", size);
+        return (message);
+    }
+
+    const char* field = reinterpret_cast<const char*>(bytes + s_headerSize);
+    std::string contentType;
+    if (contentTypeCode == c_contentTypeCodeOther)
+    {
+        contentType.assign(field, contentTypeLength);
+        field += contentTypeLength;
+    }
+    else
+    {
+        contentType = getContentTypeString(contentTypeCode);
+    }
+    std::string descriptor(field, descriptorLength);
+    field += descriptorLength;
+    std::string sourceGroup(field, sourceGroupLength);
+    field += sourceGroupLength;
+    std::string payload = isPayloadInNextFrame ? std::string(static_cast<const char*>(payloadData), payloadSize) : std::string(field, payloadLength);
+
+    message = uxas::stduxas::make_unique<AddressedAttributedMessage>();
+    if (!message->setAddressAttributesAndPayload(address, std::move(contentType), std::move(descriptor), std::move(sourceGroup),
+                                                 std::to_string(sourceEntityId), std::to_string(sourceServiceId), std::move(payload)))
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::decode failed to create AddressedAttributedMessage from envelope");
+        message.reset();
+    }
+    else
+    {
+        message->setSendTime(sendTime);
+    }
+    return (message);
+};
+
+uint8_t
+MessageEnvelope::getContentTypeCode(const std::string& contentType)
+{
+    if (contentType == uxas::common::ContentType::lmcp())
+    {
+        return (c_contentTypeCodeLmcp);
+    }
+    else if (contentType == uxas::common::ContentType::json())
+    {
+        return (c_contentTypeCodeJson);
+    }
+    else if (contentType == uxas::common::ContentType::xml())
+    {
+        return (c_contentTypeCodeXml);
+    }
+    else if (contentType == uxas::common::ContentType::text())
+    {
+        return (c_contentTypeCodeText);
+    }
+    return (c_contentTypeCodeOther);
+};
+
+const std::string&
+MessageEnvelope::getContentTypeString(uint8_t contentTypeCode)
+{
+    static std::string s_emptyString;
+    switch (contentTypeCode)
+    {
+        case c_contentTypeCodeLmcp: return (uxas::common::ContentType::lmcp());
+        case c_contentTypeCodeJson: return (uxas::common::ContentType::json());
+        case c_contentTypeCodeXml: return (uxas::common::ContentType::xml());
+        case c_contentTypeCodeText: return (uxas::common::ContentType::text());
+        default: return (s_emptyString);
+    }
+};
+
+}; //namespace data
+}; //namespace communications
+}; //namespace uxas
@@ -0,0 +1,167 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_MESSAGE_DATA_MESSAGE_ENVELOPE_H
+#define UXAS_MESSAGE_DATA_MESSAGE_ENVELOPE_H
+
+#include "AddressedAttributedMessage.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace uxas
+{
+namespace communications
+{
+namespace data
+{
+
+/** \class MessageEnvelope
+ *
+ * \par Description:
+ * Compact, fixed-layout binary encoding of message attributes and payload.
+ * Replaces the five delimited (or five separate Zero MQ frame) attribute
+ * strings with one header of integer fields followed by length-prefixed
+ * strings and payload. All integers are in network byte order.
+ *
+ * \par Layout:
+ * <pre>
+ *  offset  size  field
+ *       0     1  marker (0x00 - never the first byte of a legacy content type)
+ *       1     1  magic (0xE5)
+ *       2     1  version
+ *       3     1  flags (bit 0: payload follows in the next Zero MQ frame)
+ *       4     1  content type code (0 implies content type string follows)
+ *       5     4  source entity ID
+ *       9     4  source service ID
+ *      13     2  descriptor length
+ *      15     1  content type string length (code 0 only)
+ *      16     2  source group length
+ *      18     4  payload length
+ *      22     8  send time (steady clock nanoseconds; 0 if unknown)
+ *      30        content type string, descriptor, source group, payload
+ * </pre>
+ *
+ * The send time is only comparable within the sending process, which holds
+ * since envelopes are only sent on in-process sockets.
+ *
+ * \par Zero MQ framing:
+ * Multi-part: [address][envelope] or [address][envelope header][payload].
+ * Single-part: [address$envelope]. The address always leads so that
+ * subscription prefix filtering is unchanged. Receivers detect the envelope
+ * from its leading marker and otherwise fall back to the legacy formats, so
+ * peers that do not send envelopes remain interoperable.
+ *
+ * \n
+ */
+class MessageEnvelope
+{
+public:
+
+    static const std::string&
+    s_typeName() { static std::string s_string("MessageEnvelope"); return (s_string); };
+
+    static const uint8_t s_version{2};
+    static const size_t s_headerSize{30};
+    static const uint8_t s_payloadInNextFrameFlag{0x01};
+
+    /** \brief Checks whether a byte range begins with a message envelope.
+     *
+     * @param data pointer to first byte
+     * @param size number of available bytes
+     * @return true if the bytes start with an envelope header of a supported version
+     */
+    static
+    bool
+    isEnvelope(const void* data, size_t size);
+
+    /** \brief Converts a decimal source ID string (entity or service) into
+     * its integer value.
+     *
+     * @param idString decimal ID string
+     * @param id converted ID
+     * @return true if the whole string converted to a 32-bit unsigned value
+     */
+    static
+    bool
+    toSourceId(const std::string& idString, uint32_t& id);
+
+    /** \brief Writes the envelope header (and optionally the payload) into
+     * <B><i>envelope</i></B>, appending to its existing content.
+     *
+     * @param contentType payload content type
+     * @param descriptor payload descriptor
+     * @param sourceGroup sending service group (can be empty)
+     * @param sourceEntityId sending entity ID
+     * @param sourceServiceId sending service ID
+     * @param sendTime time the message was sent; default (epoch) if unknown
+     * @param payload message payload
+     * @param isPayloadInNextFrame if true, only the header is written and the
+     * payload is expected in the next Zero MQ frame
+     * @param envelope buffer to which the envelope is appended
+     * @return true if the attributes are valid and fit the field widths
+     */
+    static
+    bool
+    encode(const std::string& contentType, const std::string& descriptor, const std::string& sourceGroup,
+           uint32_t sourceEntityId, uint32_t sourceServiceId, const std::chrono::steady_clock::time_point& sendTime,
+           const std::string& payload, bool isPayloadInNextFrame, std::string& envelope);
+
+    /** \brief Reads the source entity and service IDs without decoding the
+     * rest of the envelope (used to ignore self-sent messages cheaply).
+     *
+     * @return true if data is an envelope
+     */
+    static
+    bool
+    getSourceIds(const void* data, size_t size, uint32_t& sourceEntityId, uint32_t& sourceServiceId);
+
+    /** \brief Decodes an envelope into an addressed, attributed message.
+     *
+     * @param address message address (received ahead of the envelope)
+     * @param data pointer to envelope
+     * @param size envelope size
+     * @param payloadData pointer to payload if the envelope flags indicate
+     * the payload in the next frame; otherwise ignored
+     * @param payloadSize size of separate payload frame
+     * @return message (with the send time, if known) if succeeds; empty unique pointer if fails.
+     */
+    static
+    std::unique_ptr<AddressedAttributedMessage>
+    decode(const std::string& address, const void* data, size_t size, const void* payloadData = nullptr, size_t payloadSize = 0);
+
+private:
+
+    // \brief Prevent construction (static methods only)
+    MessageEnvelope() { };
+
+    /** \brief Copy construction not permitted */
+    MessageEnvelope(MessageEnvelope const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(MessageEnvelope const&) = delete;
+
+    static
+    uint8_t
+    getContentTypeCode(const std::string& contentType);
+
+    static
+    const std::string&
+    getContentTypeString(uint8_t contentTypeCode);
+
+};
+
+}; //namespace data
+}; //namespace communications
+}; //namespace uxas
+
+#endif /* UXAS_MESSAGE_DATA_MESSAGE_ENVELOPE_H */
@@ -0,0 +1,200 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#include "MessageProcessingStatistics.h"
+
+#include <algorithm>
+
+namespace uxas
+{
+namespace communications
+{
+
+namespace
+{
+
+std::mutex&
+getRegistryMutex()
+{
+    static std::mutex s_mutex;
+    return (s_mutex);
+}
+
+std::vector<std::weak_ptr<MessageProcessingStatistics>>&
+getRegistry()
+{
+    static std::vector<std::weak_ptr<MessageProcessingStatistics>> s_registry;
+    return (s_registry);
+}
+
+// histograms without values (not measurable on the client's transport) are unavailable
+void
+writeJsonHistogram(const uxas::common::LatencyHistogram& histogram, std::ostream& stream)
+{
+    if (histogram.getCount() == 0)
+    {
+        stream << "null";
+        return;
+    }
+    stream << "{\"count\":" << histogram.getCount()
+            << ",\"min\":" << histogram.getMinimum()
+            << ",\"mean\":" << static_cast<uint64_t>(histogram.getMean())
+            << ",\"p50\":" << histogram.getValueAtPercentile(50.0)
+            << ",\"p90\":" << histogram.getValueAtPercentile(90.0)
+            << ",\"p99\":" << histogram.getValueAtPercentile(99.0)
+            << ",\"p999\":" << histogram.getValueAtPercentile(99.9)
+            << ",\"max\":" << histogram.getMaximum() << "}";
+}
+
+void
+writeTextHistogram(const uxas::common::LatencyHistogram& histogram, std::ostream& stream)
+{
+    if (histogram.getCount() == 0)
+    {
+        stream << "unavailable";
+        return;
+    }
+    stream << "p50 " << histogram.getValueAtPercentile(50.0)
+            << " p99 " << histogram.getValueAtPercentile(99.0)
+            << " max " << histogram.getMaximum();
+}
+
+} //namespace
+
+void
+MessageProcessingStatistics::recordMessage(const std::string& descriptor, const std::chrono::steady_clock::time_point& sendTime,
+                                           const std::chrono::steady_clock::time_point& processingStartTime,
+                                           const std::chrono::steady_clock::time_point& processingEndTime)
+{
+    auto processingTime_us = std::chrono::duration_cast<std::chrono::microseconds>(processingEndTime - processingStartTime).count();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& statistics = m_messageTypeStatistics[descriptor];
+    statistics.m_messageCount++;
+    statistics.m_processingTime_us.record(static_cast<uint64_t>(std::max<int64_t>(processingTime_us, 0)));
+    if (sendTime != std::chrono::steady_clock::time_point())
+    {
+        auto queueWaitTime_us = std::chrono::duration_cast<std::chrono::microseconds>(processingStartTime - sendTime).count();
+        statistics.m_queueWaitTime_us.record(static_cast<uint64_t>(std::max<int64_t>(queueWaitTime_us, 0)));
+    }
+};
+
+void
+MessageProcessingStatistics::recordQueueDepth(size_t queueDepth)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queueDepth.record(queueDepth);
+};
+
+MessageProcessingStatistics::Snapshot
+MessageProcessingStatistics::getSnapshot() const
+{
+    Snapshot snapshot;
+    snapshot.m_networkClientTypeName = m_networkClientTypeName;
+    snapshot.m_networkId = m_networkId;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    snapshot.m_messageTypeStatistics.insert(m_messageTypeStatistics.begin(), m_messageTypeStatistics.end());
+    snapshot.m_queueDepth = m_queueDepth;
+    return (snapshot);
+};
+
+void
+MessageProcessingStatistics::registerStatistics(const std::shared_ptr<MessageProcessingStatistics>& statistics)
+{
+    if (!statistics)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(getRegistryMutex());
+    auto& registry = getRegistry();
+    registry.erase(std::remove_if(registry.begin(), registry.end(),
+                                  [](const std::weak_ptr<MessageProcessingStatistics>& entry) { return (entry.expired()); }),
+                   registry.end());
+    registry.push_back(statistics);
+};
+
+std::vector<MessageProcessingStatistics::Snapshot>
+MessageProcessingStatistics::getRegisteredSnapshots()
+{
+    std::vector<std::shared_ptr<MessageProcessingStatistics>> liveStatistics;
+    {
+        std::lock_guard<std::mutex> lock(getRegistryMutex());
+        for (auto& entry : getRegistry())
+        {
+            auto statistics = entry.lock();
+            if (statistics)
+            {
+                liveStatistics.push_back(std::move(statistics));
+            }
+        }
+    }
+
+    std::vector<Snapshot> snapshots;
+    snapshots.reserve(liveStatistics.size());
+    for (auto& statistics : liveStatistics)
+    {
+        snapshots.push_back(statistics->getSnapshot());
+    }
+    std::sort(snapshots.begin(), snapshots.end(),
+              [](const Snapshot& left, const Snapshot& right) { return (left.m_networkId < right.m_networkId); });
+    return (snapshots);
+};
+
+void
+MessageProcessingStatistics::writeText(const std::vector<Snapshot>& snapshots, std::ostream& stream)
+{
+    for (auto& snapshot : snapshots)
+    {
+        stream << snapshot.m_networkClientTypeName << "." << snapshot.m_networkId << " queue depth ";
+        writeTextHistogram(snapshot.m_queueDepth, stream);
+        stream << "\n";
+        for (auto& typeStatistics : snapshot.m_messageTypeStatistics)
+        {
+            auto& statistics = typeStatistics.second;
+            stream << snapshot.m_networkClientTypeName << "." << snapshot.m_networkId << " " << typeStatistics.first
+                    << " count " << statistics.m_messageCount << " processing_us ";
+            writeTextHistogram(statistics.m_processingTime_us, stream);
+            stream << " queue_wait_us ";
+            writeTextHistogram(statistics.m_queueWaitTime_us, stream);
+            stream << "\n";
+        }
+    }
+};
+
+void
+MessageProcessingStatistics::writeJson(const std::vector<Snapshot>& snapshots, std::ostream& stream)
+{
+    // service type names and LMCP type names contain no characters requiring JSON escaping
+    stream << "{\"services\":[";
+    bool isFirstSnapshot{true};
+    for (auto& snapshot : snapshots)
+    {
+        stream << (isFirstSnapshot ? "" : ",") << "{\"type\":\"" << snapshot.m_networkClientTypeName
+                << "\",\"networkId\":" << snapshot.m_networkId << ",\"queueDepth\":";
+        writeJsonHistogram(snapshot.m_queueDepth, stream);
+        stream << ",\"messages\":{";
+        bool isFirstType{true};
+        for (auto& typeStatistics : snapshot.m_messageTypeStatistics)
+        {
+            auto& statistics = typeStatistics.second;
+            stream << (isFirstType ? "" : ",") << "\"" << typeStatistics.first << "\":{\"count\":" << statistics.m_messageCount
+                    << ",\"processing_us\":";
+            writeJsonHistogram(statistics.m_processingTime_us, stream);
+            stream << ",\"queueWait_us\":";
+            writeJsonHistogram(statistics.m_queueWaitTime_us, stream);
+            stream << "}";
+            isFirstType = false;
+        }
+        stream << "}}";
+        isFirstSnapshot = false;
+    }
+    stream << "]}";
+};
+
+}; //namespace communications
+}; //namespace uxas
@@ -0,0 +1,134 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_MESSAGE_MESSAGE_PROCESSING_STATISTICS_H
+#define UXAS_MESSAGE_MESSAGE_PROCESSING_STATISTICS_H
+
+#include "UxAS_LatencyHistogram.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace uxas
+{
+namespace communications
+{
+
+/** \class MessageProcessingStatistics
+ * 
+ * \par Description:
+ * Receive-side statistics of one network client (service or bridge): per 
+ * message type (descriptor) count, processing time and queue wait time 
+ * histograms (microseconds), plus a histogram of the receive queue depth. 
+ * Queue wait time is the time from sending to the start of processing; it is 
+ * only known for messages received via the in-process message bus or in 
+ * message envelopes. Queue depth is only known for the in-process message 
+ * bus. Histograms without values are reported as unavailable (JSON null).
+ * 
+ * \par Registry:
+ * Network clients register their statistics; <B><i>writeText</i></B> and 
+ * <B><i>writeJson</i></B> report all registered (live) network clients.
+ * 
+ * \n
+ */
+class MessageProcessingStatistics
+{
+public:
+
+    static const std::string&
+    s_typeName() { static std::string s_string("MessageProcessingStatistics"); return (s_string); };
+
+    struct MessageTypeStatistics
+    {
+        uint64_t m_messageCount{0};
+        uxas::common::LatencyHistogram m_processingTime_us;
+        uxas::common::LatencyHistogram m_queueWaitTime_us;
+    };
+
+    struct Snapshot
+    {
+        std::string m_networkClientTypeName;
+        int64_t m_networkId{0};
+        std::map<std::string, MessageTypeStatistics> m_messageTypeStatistics;
+        uxas::common::LatencyHistogram m_queueDepth;
+    };
+
+    MessageProcessingStatistics(const std::string& networkClientTypeName, int64_t networkId)
+    : m_networkClientTypeName(networkClientTypeName), m_networkId(networkId) { };
+
+private:
+
+    /** \brief Copy construction not permitted */
+    MessageProcessingStatistics(MessageProcessingStatistics const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(MessageProcessingStatistics const&) = delete;
+
+public:
+
+    /** \brief Records the processing of one received message.
+     * 
+     * @param descriptor message type
+     * @param sendTime time the message was sent; default (epoch) if unknown
+     * @param processingStartTime time processing started
+     * @param processingEndTime time processing completed
+     */
+    void
+    recordMessage(const std::string& descriptor, const std::chrono::steady_clock::time_point& sendTime,
+                  const std::chrono::steady_clock::time_point& processingStartTime,
+                  const std::chrono::steady_clock::time_point& processingEndTime);
+
+    /** \brief Records the number of messages waiting in the receive queue. */
+    void
+    recordQueueDepth(size_t queueDepth);
+
+    Snapshot
+    getSnapshot() const;
+
+    /** \brief Adds statistics to the registry (held weakly; removed once destroyed). */
+    static
+    void
+    registerStatistics(const std::shared_ptr<MessageProcessingStatistics>& statistics);
+
+    /** \brief Snapshots of all registered statistics, ordered by network ID. */
+    static
+    std::vector<Snapshot>
+    getRegisteredSnapshots();
+
+    /** \brief Writes one line per network client and message type. */
+    static
+    void
+    writeText(const std::vector<Snapshot>& snapshots, std::ostream& stream);
+
+    static
+    void
+    writeJson(const std::vector<Snapshot>& snapshots, std::ostream& stream);
+
+private:
+
+    const std::string m_networkClientTypeName;
+    const int64_t m_networkId;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, MessageTypeStatistics> m_messageTypeStatistics;
+    uxas::common::LatencyHistogram m_queueDepth;
+};
+
+}; //namespace communications
+}; //namespace uxas
+
+#endif /* UXAS_MESSAGE_MESSAGE_PROCESSING_STATISTICS_H */
@@ -0,0 +1,155 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#include "NetworkServerShards.h"
+
+#include "UxAS_Log.h"
+
+#include "stdUniquePtr.h"
+
+#include <string>
+
+namespace uxas
+{
+namespace communications
+{
+
+NetworkServerShards::NetworkServerShards(uint32_t shardCount, Publisher publisher)
+: m_publisher(std::move(publisher))
+{
+    for (uint32_t shardIndex = 0; shardIndex < shardCount; shardIndex++)
+    {
+        m_shards.push_back(uxas::stduxas::make_unique<Shard>());
+    }
+};
+
+NetworkServerShards::~NetworkServerShards()
+{
+    stop();
+};
+
+void
+NetworkServerShards::start()
+{
+    std::lock_guard<std::mutex> lock(m_threadMutex);
+    if (m_isStopping)
+    {
+        return;
+    }
+    for (uint32_t shardIndex = 0; shardIndex < m_shards.size(); shardIndex++)
+    {
+        if (!m_shards[shardIndex]->m_thread)
+        {
+            m_shards[shardIndex]->m_thread = uxas::stduxas::make_unique<std::thread>(&NetworkServerShards::executeWorker, this, shardIndex);
+        }
+    }
+};
+
+void
+NetworkServerShards::push(std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> message)
+{
+    m_receivedMessageCount++;
+    Shard* shard = m_shards[getShardIndex(*message)].get();
+    {
+        std::lock_guard<std::mutex> lock(shard->m_mutex);
+        shard->m_queue.push_back(std::move(message));
+        shard->m_queueDepth = shard->m_queue.size();
+        if (shard->m_queueDepth > shard->m_maximumQueueDepth)
+        {
+            shard->m_maximumQueueDepth = shard->m_queueDepth.load();
+        }
+    }
+    shard->m_condition.notify_one();
+};
+
+void
+NetworkServerShards::stop()
+{
+    std::lock_guard<std::mutex> threadLock(m_threadMutex);
+    m_isStopping = true;
+    for (auto& shard : m_shards)
+    {
+        {
+            // under the shard lock, so that a worker cannot miss the notification
+            std::lock_guard<std::mutex> lock(shard->m_mutex);
+        }
+        shard->m_condition.notify_all();
+    }
+    for (uint32_t shardIndex = 0; shardIndex < m_shards.size(); shardIndex++)
+    {
+        auto& shard = m_shards[shardIndex];
+        if (shard->m_thread && shard->m_thread->joinable())
+        {
+            shard->m_thread->join();
+        }
+        // only if never started
+        if (shard->m_queueDepth > 0)
+        {
+            UXAS_LOG_WARN("NetworkServerShards::stop dropped ", shard->m_queueDepth.load(), " messages queued to shard ", shardIndex);
+        }
+    }
+};
+
+uint32_t
+NetworkServerShards::getShardIndex(uxas::communications::data::AddressedAttributedMessage& message) const
+{
+    size_t key = std::hash<std::string>()(message.getMessageAttributesReference()->getSourceEntityId())
+            ^ (std::hash<std::string>()(message.getMessageAttributesReference()->getSourceServiceId()) * 31);
+    return (static_cast<uint32_t>(key % m_shards.size()));
+};
+
+uint64_t
+NetworkServerShards::getPublishedMessageCount(uint32_t shardIndex) const
+{
+    return (shardIndex < m_shards.size() ? m_shards[shardIndex]->m_publishedMessageCount.load() : 0);
+};
+
+uint64_t
+NetworkServerShards::getQueueDepth(uint32_t shardIndex) const
+{
+    return (shardIndex < m_shards.size() ? m_shards[shardIndex]->m_queueDepth.load() : 0);
+};
+
+uint64_t
+NetworkServerShards::getMaximumQueueDepth(uint32_t shardIndex) const
+{
+    return (shardIndex < m_shards.size() ? m_shards[shardIndex]->m_maximumQueueDepth.load() : 0);
+};
+
+void
+NetworkServerShards::executeWorker(uint32_t shardIndex)
+{
+    Shard* shard = m_shards[shardIndex].get();
+    std::deque< std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> > messages;
+    while (true)
+    {
+        {
+            // take the whole queue at once to keep lock hold time independent of publish time
+            std::unique_lock<std::mutex> lock(shard->m_mutex);
+            shard->m_condition.wait(lock, [this, shard] { return (m_isStopping || !shard->m_queue.empty()); });
+            messages.swap(shard->m_queue);
+            shard->m_queueDepth = 0;
+        }
+        if (messages.empty())
+        {
+            break; // stopping and nothing left to publish
+        }
+
+        for (auto& message : messages)
+        {
+            m_publisher(shardIndex, std::move(message));
+            shard->m_publishedMessageCount++;
+        }
+        messages.clear();
+    }
+    UXAS_LOG_INFORM("NetworkServerShards::executeWorker exiting infinite loop thread [", std::this_thread::get_id(), "]");
+};
+
+}; //namespace communications
+}; //namespace uxas
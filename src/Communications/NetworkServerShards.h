@@ -0,0 +1,137 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_MESSAGE_NETWORK_SERVER_SHARDS_H
+#define UXAS_MESSAGE_NETWORK_SERVER_SHARDS_H
+
+#include "AddressedAttributedMessage.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace uxas
+{
+namespace communications
+{
+
+/** \class NetworkServerShards
+ *
+ * \par Description:
+ * Worker shards of the sharded <B><i>LmcpObjectNetworkServer</i></B>. Each
+ * message is queued to a shard by sender (source entity and service ID) and
+ * published by the worker thread of that shard. A given sender always maps
+ * to the same shard, so the messages of one sender are published in the
+ * order they were queued.
+ *
+ * \par Threading:
+ * <B><i>push</i></B> must be called from one thread (the dispatching
+ * thread) and not after <B><i>stop</i></B>. The publish function is
+ * called on the worker thread of the shard.
+ *
+ * \n
+ */
+class NetworkServerShards
+{
+public:
+
+    /** \brief Publishes a message on the socket of a shard. */
+    typedef std::function<void(uint32_t shardIndex, std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> message)> Publisher;
+
+    NetworkServerShards(uint32_t shardCount, Publisher publisher);
+
+    /** \brief Stops the worker threads (see <B><i>stop</i></B>). */
+    ~NetworkServerShards();
+
+private:
+
+    /** \brief Copy construction not permitted */
+    NetworkServerShards(NetworkServerShards const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(NetworkServerShards const&) = delete;
+
+public:
+
+    /** \brief Starts one worker thread per shard. Messages pushed before
+     * are published once started. */
+    void
+    start();
+
+    /** \brief Queues <B><i>message</i></B> to the shard of its sender. */
+    void
+    push(std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> message);
+
+    /** \brief Stops the worker threads after they published every queued
+     * message and waits for them. */
+    void
+    stop();
+
+    uint32_t
+    getShardCount() const { return (static_cast<uint32_t>(m_shards.size())); };
+
+    /** \brief Index of the shard of the sender of <B><i>message</i></B>. */
+    uint32_t
+    getShardIndex(uxas::communications::data::AddressedAttributedMessage& message) const;
+
+    /** \brief Total number of pushed messages. */
+    uint64_t
+    getReceivedMessageCount() const { return (m_receivedMessageCount); };
+
+    /** \brief Number of messages published by a shard. */
+    uint64_t
+    getPublishedMessageCount(uint32_t shardIndex) const;
+
+    /** \brief Current number of messages waiting in a shard queue. */
+    uint64_t
+    getQueueDepth(uint32_t shardIndex) const;
+
+    /** \brief Largest observed number of messages waiting in a shard queue. */
+    uint64_t
+    getMaximumQueueDepth(uint32_t shardIndex) const;
+
+private:
+
+    /** \brief Queue, thread and counters of one shard. */
+    struct Shard
+    {
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::deque< std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> > m_queue;
+        std::unique_ptr<std::thread> m_thread;
+        std::atomic<uint64_t> m_queueDepth{0};
+        std::atomic<uint64_t> m_maximumQueueDepth{0};
+        std::atomic<uint64_t> m_publishedMessageCount{0};
+    };
+
+    void
+    executeWorker(uint32_t shardIndex);
+
+    Publisher m_publisher;
+
+    std::vector< std::unique_ptr<Shard> > m_shards;
+
+    /** \brief Serializes <B><i>start</i></B> and <B><i>stop</i></B>. */
+    std::mutex m_threadMutex;
+
+    std::atomic<bool> m_isStopping{false};
+
+    std::atomic<uint64_t> m_receivedMessageCount{0};
+};
+
+}; //namespace communications
+}; //namespace uxas
+
+#endif /* UXAS_MESSAGE_NETWORK_SERVER_SHARDS_H */
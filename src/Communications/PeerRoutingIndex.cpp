@@ -0,0 +1,86 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#include "PeerRoutingIndex.h"
+
+#include <algorithm>
+
+namespace uxas
+{
+namespace communications
+{
+
+PeerRoutingIndex::PeerRoutingIndex(const std::unordered_map<std::string, std::set<std::string> >& peerIdsBySubscriptionAddress)
+{
+    std::set<std::string> peerIds;
+    for (const auto& addressPeerIds : peerIdsBySubscriptionAddress)
+    {
+        peerIds.insert(addressPeerIds.second.begin(), addressPeerIds.second.end());
+    }
+    m_peerIds.assign(peerIds.begin(), peerIds.end());
+
+    size_t wordCount = (m_peerIds.size() + 63) / 64;
+    for (const auto& addressPeerIds : peerIdsBySubscriptionAddress)
+    {
+        if (addressPeerIds.second.empty())
+        {
+            continue;
+        }
+        PeerBitset& peers = m_peersBySubscriptionAddress[addressPeerIds.first];
+        peers.assign(wordCount, 0);
+        for (const auto& peerId : addressPeerIds.second)
+        {
+            size_t peerIndex = std::lower_bound(m_peerIds.begin(), m_peerIds.end(), peerId) - m_peerIds.begin();
+            peers[peerIndex / 64] |= (uint64_t(1) << (peerIndex % 64));
+        }
+        m_addressLengths.insert(addressPeerIds.first.size());
+    }
+};
+
+PeerRoutingIndex::PeerBitset
+PeerRoutingIndex::getRoutedPeers(const std::string& address) const
+{
+    PeerBitset routedPeers((m_peerIds.size() + 63) / 64, 0);
+    for (size_t length : m_addressLengths)
+    {
+        if (length > address.size())
+        {
+            break;
+        }
+        auto peersIt = m_peersBySubscriptionAddress.find(length == address.size() ? address : address.substr(0, length));
+        if (peersIt != m_peersBySubscriptionAddress.end())
+        {
+            for (size_t wordIndex = 0; wordIndex < routedPeers.size(); wordIndex++)
+            {
+                routedPeers[wordIndex] |= peersIt->second[wordIndex];
+            }
+        }
+    }
+    return (routedPeers);
+};
+
+const PeerRoutingIndex::PeerBitset&
+PeerRoutingCache::getRoutedPeers(const std::shared_ptr<const PeerRoutingIndex>& routingIndex, const std::string& address)
+{
+    if (m_routingIndex != routingIndex || m_routedPeersByAddress.size() >= m_maximumAddressCount)
+    {
+        m_routedPeersByAddress.clear();
+        m_routingIndex = routingIndex;
+    }
+
+    auto routedIt = m_routedPeersByAddress.find(address);
+    if (routedIt == m_routedPeersByAddress.end())
+    {
+        routedIt = m_routedPeersByAddress.emplace(address, routingIndex->getRoutedPeers(address)).first;
+    }
+    return (routedIt->second);
+};
+
+}; //namespace communications
+}; //namespace uxas
@@ -0,0 +1,121 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_MESSAGE_PEER_ROUTING_INDEX_H
+#define UXAS_MESSAGE_PEER_ROUTING_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace uxas
+{
+namespace communications
+{
+
+/** \class PeerRoutingIndex
+ *
+ * \par Description:
+ * Immutable index from the subscription addresses of remote peers to the
+ * peers subscribed to them. A message address is routed to every peer
+ * subscribed to a prefix of it (as Zero MQ subscriptions match). Peers are
+ * numbered in order of their IDs and routed peers are returned as a bitset
+ * (64 peers per word). Only prefixes with the length of some subscription
+ * are looked up, so the routing cost does not depend on the number of peers
+ * or subscriptions.
+ *
+ * \n
+ */
+class PeerRoutingIndex
+{
+public:
+
+    /** \brief Bitset of peers, indexed by the peer positions of one
+     * <B><i>PeerRoutingIndex</i></B> (64 peers per word). */
+    typedef std::vector<uint64_t> PeerBitset;
+
+    PeerRoutingIndex() { };
+
+    /** \brief Compiles the index.
+     *
+     * @param peerIdsBySubscriptionAddress IDs of the peers subscribed to
+     * each address
+     */
+    explicit
+    PeerRoutingIndex(const std::unordered_map<std::string, std::set<std::string> >& peerIdsBySubscriptionAddress);
+
+    size_t
+    getPeerCount() const { return (m_peerIds.size()); };
+
+    /** \brief ID of the peer at <B><i>peerIndex</i></B>. */
+    const std::string&
+    getPeerId(size_t peerIndex) const { return (m_peerIds[peerIndex]); };
+
+    size_t
+    getSubscriptionAddressCount() const { return (m_peersBySubscriptionAddress.size()); };
+
+    /** \brief Returns the peers subscribed to <B><i>address</i></B> or to a
+     * prefix of it (<B><i>getPeerCount</i></B> bits). */
+    PeerBitset
+    getRoutedPeers(const std::string& address) const;
+
+private:
+
+    std::vector<std::string> m_peerIds;
+    std::unordered_map<std::string, PeerBitset> m_peersBySubscriptionAddress;
+    /** \brief distinct subscription address lengths (ascending) */
+    std::set<size_t> m_addressLengths;
+};
+
+/** \class PeerRoutingCache
+ *
+ * \par Description:
+ * Routed peers of recently sent addresses. The cache is flushed when the
+ * routing index changes or when it holds <B><i>maximumAddressCount</i></B>
+ * addresses.
+ *
+ * \par Threading:
+ * Not thread-safe; used by the sending thread only.
+ *
+ * \n
+ */
+class PeerRoutingCache
+{
+public:
+
+    explicit
+    PeerRoutingCache(size_t maximumAddressCount)
+    : m_maximumAddressCount(maximumAddressCount) { };
+
+    /** \brief Returns the peers of <B><i>routingIndex</i></B> subscribed to
+     * <B><i>address</i></B> or to a prefix of it. The reference is valid
+     * until the next call. */
+    const PeerRoutingIndex::PeerBitset&
+    getRoutedPeers(const std::shared_ptr<const PeerRoutingIndex>& routingIndex, const std::string& address);
+
+    size_t
+    getAddressCount() const { return (m_routedPeersByAddress.size()); };
+
+private:
+
+    size_t m_maximumAddressCount;
+    /** \brief index that <B><i>m_routedPeersByAddress</i></B> was computed
+     * from (held, so that a new index cannot reuse its address) */
+    std::shared_ptr<const PeerRoutingIndex> m_routingIndex;
+    std::unordered_map<std::string, PeerRoutingIndex::PeerBitset> m_routedPeersByAddress;
+};
+
+}; //namespace communications
+}; //namespace uxas
+
+#endif /* UXAS_MESSAGE_PEER_ROUTING_INDEX_H */
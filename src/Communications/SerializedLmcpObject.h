@@ -0,0 +1,107 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_MESSAGE_DATA_SERIALIZED_LMCP_OBJECT_H
+#define UXAS_MESSAGE_DATA_SERIALIZED_LMCP_OBJECT_H
+
+#include "LmcpObjectSerializer.h"
+
+#include "avtas/lmcp/Object.h"
+
+#include <memory>
+#include <string>
+
+namespace uxas
+{
+namespace communications
+{
+namespace data
+{
+
+/** \class SerializedLmcpObject
+ *
+ * \par Description:
+ * Immutable, serialize-once representation of an <b>LMCP</b> object. The
+ * packed payload is reference counted, so copies of this object, re-broadcasts
+ * to several addresses and Zero MQ frames built from it all share one buffer.
+ * The payload is a snapshot: later changes to the source object are not
+ * reflected.
+ *
+ * Only senders use it. Bridges and the message logger receive
+ * <B><i>AddressedAttributedMessage</i></B> objects and forward or log their
+ * payload string without deserializing it, but each message holds its own
+ * copy of the payload.
+ *
+ * \n
+ */
+class SerializedLmcpObject
+{
+public:
+
+    SerializedLmcpObject() { };
+
+    explicit
+    SerializedLmcpObject(const std::shared_ptr<avtas::lmcp::Object>& lmcpObject)
+    {
+        if (lmcpObject)
+        {
+            m_descriptor = lmcpObject->getFullLmcpTypeName();
+            m_payload = LmcpObjectSerializer::serialize(lmcpObject.get());
+        }
+    };
+
+    /** \brief Wraps an already serialized <b>LMCP</b> message (e.g., one
+     * read from a recording) without deserializing it.
+     *
+     * @param descriptor full <b>LMCP</b> type name of the serialized object
+     * @param payload serialized <b>LMCP</b> message
+     */
+    SerializedLmcpObject(const std::string& descriptor, std::shared_ptr<const std::string> payload)
+    : m_descriptor(descriptor), m_payload(std::move(payload)) { };
+
+    bool
+    isValid() const
+    {
+        return (m_payload && !m_payload->empty() && !m_descriptor.empty());
+    };
+
+    /** \brief Full <b>LMCP</b> type name of the serialized object (e.g.,
+     * "afrl.cmasi.AirVehicleState"). Used as message descriptor and as
+     * broadcast address.
+     *
+     * @return full <b>LMCP</b> type name
+     */
+    const std::string&
+    getDescriptor() const
+    {
+        return (m_descriptor);
+    };
+
+    /** \brief Shared, immutable serialized <b>LMCP</b> message.
+     *
+     * @return serialized payload
+     */
+    const std::shared_ptr<const std::string>&
+    getPayload() const
+    {
+        return (m_payload);
+    };
+
+private:
+
+    std::string m_descriptor;
+    std::shared_ptr<const std::string> m_payload;
+
+};
+
+}; //namespace data
+}; //namespace communications
+}; //namespace uxas
+
+#endif /* UXAS_MESSAGE_DATA_SERIALIZED_LMCP_OBJECT_H */
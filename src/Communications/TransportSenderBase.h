@@ -0,0 +1,54 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_MESSAGE_TRANSPORT_TRANSPORT_SENDER_BASE_H
+#define UXAS_MESSAGE_TRANSPORT_TRANSPORT_SENDER_BASE_H
+
+#include "TransportBase.h"
+
+namespace uxas
+{
+namespace communications
+{
+namespace transport
+{
+
+/** \class TransportSenderBase
+ * 
+ * \par Description:
+ * Sends transported messages (counterpart of TransportReceiverBase).
+ * 
+ * \n
+ */
+class TransportSenderBase : public TransportBase
+{
+
+public:
+
+    TransportSenderBase()
+    : TransportBase() { };
+
+    virtual
+    ~TransportSenderBase() { };
+
+private:
+
+    /** \brief Copy construction not permitted */
+    TransportSenderBase(TransportSenderBase const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(TransportSenderBase const&) = delete;
+
+};
+
+}; //namespace transport
+}; //namespace communications
+}; //namespace uxas
+
+#endif /* UXAS_MESSAGE_TRANSPORT_TRANSPORT_SENDER_BASE_H */
@@ -9,6 +9,8 @@
 
 #include "ZeroMqAddressedAttributedMessageReceiver.h"
 
+#include "MessageEnvelope.h"
+
 #include "UxAS_ConfigurationManager.h"
 #include "UxAS_Time.h"
 
@@ -18,6 +20,8 @@
 
 #include "czmq.h"
 
+#include <cstring>
+
 namespace uxas
 {
 namespace communications
@@ -105,54 +109,89 @@ ZeroMqAddressedAttributedMessageReceiver::getNextMessage()
             }
             else
             {
-                // not a stream, so should only be a single message
-                if (uxas::common::ConfigurationManager::getIsZeroMqMultipartMessage())
+                // not a stream, so should only be a single message; the frame
+                // structure identifies the format, so envelope and legacy
+                // senders can share the network
+                zmq::message_t firstFrame;
+                m_zmqSocket->recv(&firstFrame);
+                if (!isReceiveMore())
                 {
-                    std::string address = n_ZMQ::s_recv(*m_zmqSocket);
-                    std::string contentType = n_ZMQ::s_recv(*m_zmqSocket);
-                    std::string descriptor = n_ZMQ::s_recv(*m_zmqSocket);
-                    std::string sourceGroup = n_ZMQ::s_recv(*m_zmqSocket);
-                    std::string sourceEntityId = n_ZMQ::s_recv(*m_zmqSocket);
-                    std::string sourceServiceId = n_ZMQ::s_recv(*m_zmqSocket);
-                    std::string payload = n_ZMQ::s_recv(*m_zmqSocket);
-                    if (m_entityIdString != sourceEntityId || m_serviceIdString != sourceServiceId)
+                    // single-part: address$envelope or legacy address$attributes$payload
+                    const char* frameData = static_cast<const char*>(firstFrame.data());
+                    const char* delimiter = static_cast<const char*>(memchr(frameData, *(uxas::communications::data::AddressedMessage::s_addressAttributesDelimiter().c_str()), firstFrame.size()));
+                    size_t envelopeOffset = delimiter ? static_cast<size_t>(delimiter - frameData) + 1 : firstFrame.size();
+                    if (uxas::communications::data::MessageEnvelope::isEnvelope(frameData + envelopeOffset, firstFrame.size() - envelopeOffset))
+                    {
+                        processEnvelope(std::string(frameData, envelopeOffset - 1), frameData + envelopeOffset, firstFrame.size() - envelopeOffset, nullptr, 0);
+                    }
+                    else
                     {
-                        std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> recvdMultipartAddAttMsg
+                        std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> recvdSinglepartAddAttMsg
                                 = uxas::stduxas::make_unique<uxas::communications::data::AddressedAttributedMessage>();
-                        if (recvdMultipartAddAttMsg->setAddressAttributesAndPayload(std::move(address), std::move(contentType), std::move(descriptor), std::move(sourceGroup),
-                                                                                    std::move(sourceEntityId), std::move(sourceServiceId), std::move(payload)))
+                        if (recvdSinglepartAddAttMsg->setAddressAttributesAndPayloadFromDelimitedString(std::string(frameData, firstFrame.size())))
                         {
-                            m_recvdMsgs.push_back( std::move(recvdMultipartAddAttMsg) );
+                            if (m_entityIdString != recvdSinglepartAddAttMsg->getMessageAttributesReference()->getSourceEntityId()
+                                    || m_serviceIdString != recvdSinglepartAddAttMsg->getMessageAttributesReference()->getSourceServiceId())
+                            {
+                                m_recvdMsgs.push_back( std::move(recvdSinglepartAddAttMsg) );
+                            }
+                            else
+                            {
+                                UXAS_LOG_DEBUG_VERBOSE("ZeroMqAddressedAttributedMessageReceiver::getNextMessage ignoring ", recvdSinglepartAddAttMsg->getMessageAttributesReference()->getDescriptor(), " message with entity ID ", m_entityIdString, " and service ID ", m_serviceIdString, " since it matches its own entity ID");
+                            }
                         }
                         else
                         {
-                            UXAS_LOG_WARN("ZeroMqAddressedAttributedMessageReceiver::getNextMessage failed to create AddressedAttributedMessage object from Zero MQ multi-part message");
+                            UXAS_LOG_WARN("ZeroMqAddressedAttributedMessageReceiver::getNextMessage failed to create AddressedAttributedMessage object from Zero MQ single-part message");
                         }
                     }
-                    else
-                    {
-                        UXAS_LOG_DEBUG_VERBOSE("ZeroMqAddressedAttributedMessageReceiver::getNextMessage ignoring ", descriptor, " message with entity ID ", m_entityIdString, " and service ID ", m_serviceIdString, " since it matches its own entity ID");
-                    }
                 }
                 else
                 {
-                    std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> recvdSinglepartAddAttMsg
-                            = uxas::stduxas::make_unique<uxas::communications::data::AddressedAttributedMessage>();
-                    if (recvdSinglepartAddAttMsg->setAddressAttributesAndPayloadFromDelimitedString(n_ZMQ::s_recv(*m_zmqSocket)))
+                    std::string address(static_cast<const char*>(firstFrame.data()), firstFrame.size());
+                    zmq::message_t secondFrame;
+                    m_zmqSocket->recv(&secondFrame);
+                    if (uxas::communications::data::MessageEnvelope::isEnvelope(secondFrame.data(), secondFrame.size()))
                     {
-                        if (m_entityIdString != recvdSinglepartAddAttMsg->getMessageAttributesReference()->getSourceEntityId()
-                                || m_serviceIdString != recvdSinglepartAddAttMsg->getMessageAttributesReference()->getSourceServiceId())
+                        // multi-part: [address][envelope] or [address][envelope header][payload]
+                        if (isReceiveMore())
                         {
-                            m_recvdMsgs.push_back( std::move(recvdSinglepartAddAttMsg) );
+                            zmq::message_t payloadFrame;
+                            m_zmqSocket->recv(&payloadFrame);
+                            processEnvelope(address, secondFrame.data(), secondFrame.size(), payloadFrame.data(), payloadFrame.size());
                         }
                         else
                         {
-                            UXAS_LOG_DEBUG_VERBOSE("ZeroMqAddressedAttributedMessageReceiver::getNextMessage ignoring ", recvdSinglepartAddAttMsg->getMessageAttributesReference()->getDescriptor(), " message with entity ID ", m_entityIdString, " and service ID ", m_serviceIdString, " since it matches its own entity ID");
+                            processEnvelope(address, secondFrame.data(), secondFrame.size(), nullptr, 0);
                         }
                     }
                     else
                     {
-                        UXAS_LOG_WARN("ZeroMqAddressedAttributedMessageReceiver::getNextMessage failed to create AddressedAttributedMessage object from Zero MQ single-part message");
+                        // legacy multi-part: one frame per attribute
+                        std::string contentType(static_cast<const char*>(secondFrame.data()), secondFrame.size());
+                        std::string descriptor = n_ZMQ::s_recv(*m_zmqSocket);
+                        std::string sourceGroup = n_ZMQ::s_recv(*m_zmqSocket);
+                        std::string sourceEntityId = n_ZMQ::s_recv(*m_zmqSocket);
+                        std::string sourceServiceId = n_ZMQ::s_recv(*m_zmqSocket);
+                        std::string payload = n_ZMQ::s_recv(*m_zmqSocket);
+                        if (m_entityIdString != sourceEntityId || m_serviceIdString != sourceServiceId)
+                        {
+                            std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> recvdMultipartAddAttMsg
+                                    = uxas::stduxas::make_unique<uxas::communications::data::AddressedAttributedMessage>();
+                            if (recvdMultipartAddAttMsg->setAddressAttributesAndPayload(std::move(address), std::move(contentType), std::move(descriptor), std::move(sourceGroup),
+                                                                                        std::move(sourceEntityId), std::move(sourceServiceId), std::move(payload)))
+                            {
+                                m_recvdMsgs.push_back( std::move(recvdMultipartAddAttMsg) );
+                            }
+                            else
+                            {
+                                UXAS_LOG_WARN("ZeroMqAddressedAttributedMessageReceiver::getNextMessage failed to create AddressedAttributedMessage object from Zero MQ multi-part message");
+                            }
+                        }
+                        else
+                        {
+                            UXAS_LOG_DEBUG_VERBOSE("ZeroMqAddressedAttributedMessageReceiver::getNextMessage ignoring ", descriptor, " message with entity ID ", m_entityIdString, " and service ID ", m_serviceIdString, " since it matches its own entity ID");
+                        }
                     }
                 }
             }
@@ -167,6 +206,44 @@ ZeroMqAddressedAttributedMessageReceiver::getNextMessage()
     return (nextMsg);
 };
 
+bool
+ZeroMqAddressedAttributedMessageReceiver::isReceiveMore()
+{
+    int isMore{0};
+    size_t isMoreSize = sizeof(isMore);
+    m_zmqSocket->getsockopt(ZMQ_RCVMORE, &isMore, &isMoreSize);
+    return (isMore != 0);
+};
+
+void
+ZeroMqAddressedAttributedMessageReceiver::processEnvelope(const std::string& address, const void* data, size_t size, const void* payloadData, size_t payloadSize)
+{
+    uint32_t sourceEntityId{0};
+    uint32_t sourceServiceId{0};
+    if (!uxas::communications::data::MessageEnvelope::getSourceIds(data, size, sourceEntityId, sourceServiceId))
+    {
+        UXAS_LOG_WARN("ZeroMqAddressedAttributedMessageReceiver::processEnvelope ignoring invalid message envelope");
+        return;
+    }
+
+    if (sourceEntityId == m_entityId && sourceServiceId == m_serviceId)
+    {
+        UXAS_LOG_DEBUG_VERBOSE("ZeroMqAddressedAttributedMessageReceiver::processEnvelope ignoring message with entity ID ", m_entityIdString, " and service ID ", m_serviceIdString, " since it matches its own entity ID");
+        return;
+    }
+
+    std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> recvdEnvelopeAddAttMsg
+            = uxas::communications::data::MessageEnvelope::decode(address, data, size, payloadData, payloadSize);
+    if (recvdEnvelopeAddAttMsg)
+    {
+        m_recvdMsgs.push_back( std::move(recvdEnvelopeAddAttMsg) );
+    }
+    else
+    {
+        UXAS_LOG_WARN("ZeroMqAddressedAttributedMessageReceiver::processEnvelope failed to create AddressedAttributedMessage object from Zero MQ message envelope");
+    }
+};
+
 }; //namespace transport
 }; //namespace communications
 }; //namespace uxas
@@ -15,7 +15,7 @@
 
 #include "AddressedAttributedMessage.h"
 
-#include "UxAS_SentinelSerialBuffer.h"
+#include "UxAS_FramedSerialBuffer.h"
 
 namespace uxas
 {
@@ -86,9 +86,18 @@ public:
     
 private:
 
+    /** \brief Whether more frames of the current Zero MQ message remain. */
+    bool
+    isReceiveMore();
+
+    /** \brief Decode a binary message envelope (unless sent by this 
+     * entity/service) and queue the resulting message. */
+    void
+    processEnvelope(const std::string& address, const void* data, size_t size, const void* payloadData, size_t payloadSize);
+
     bool m_isTcpStream{false};
 
-    uxas::common::SentinelSerialBuffer m_receiveTcpDataBuffer;
+    uxas::common::FramedSerialBuffer m_receiveTcpDataBuffer;
     std::deque< std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> > m_recvdMsgs;
 
 };
@@ -9,9 +9,11 @@
 
 #include "ZeroMqAddressedAttributedMessageSender.h"
 
+#include "MessageEnvelope.h"
+
 #include "UxAS_ConfigurationManager.h"
 #include "UxAS_Log.h"
-#include "UxAS_SentinelSerialBuffer.h"
+#include "UxAS_FramedSerialBuffer.h"
 
 #include "UxAS_ZeroMQ.h"
 
@@ -22,19 +24,35 @@ namespace communications
 namespace transport
 {
 
+namespace
+{
+
+/** \brief address prefix of in-process sockets */
+const std::string c_inProcessAddressPrefix("inproc://");
+
+} //namespace
+
 void
-ZeroMqAddressedAttributedMessageSender::sendMessage(const std::string& address, const std::string& contentType, const std::string& descriptor, const std::string payload)
+ZeroMqAddressedAttributedMessageSender::sendMessage(const std::string& address, const std::string& contentType, const std::string& descriptor, const std::string& payload)
 {
+    if (m_zmqSocket && isBinaryEnvelope())
+    {
+        sendEnvelopeMessage(address, contentType, descriptor, m_sourceGroup, m_entityId, m_serviceId,
+                            std::chrono::steady_clock::now(), payload, nullptr);
+        return;
+    }
+
     if (m_zmqSocket)
     {
         uxas::communications::data::AddressedAttributedMessage message;
         message.setAddressAttributesAndPayload(address, contentType, descriptor, m_sourceGroup,
-                                               m_entityIdString, m_serviceIdString, std::move(payload));
+                                               m_entityIdString, m_serviceIdString, payload);
         if (m_isTcpStream)
         {
             if (message.isValid())
             {
-                std::string sentinelStr = uxas::common::SentinelSerialBuffer::createSentinelizedString(message.getString());
+                // no return channel to learn the peer framing version, so sentinel framing is kept
+                std::string sentinelStr = uxas::common::FramedSerialBuffer::createFramedString(message.getString(), uxas::common::FramedSerialBuffer::s_sentinelFramingVersion);
                 UXAS_LOG_DEBUG_VERBOSE("ZeroMqAddressedAttributedMessageSender::sendMessage BEFORE sending TCP stream single-part message");
                 zmq_send(*m_zmqSocket, sentinelStr.c_str(), sentinelStr.size(), ZMQ_SNDMORE);
                 UXAS_LOG_DEBUG_VERBOSE("ZeroMqAddressedAttributedMessageSender::sendMessage AFTER sending TCP stream single-part message");
@@ -95,6 +113,51 @@ ZeroMqAddressedAttributedMessageSender::sendMessage(const std::string& address,
     } //if(m_zmqSocket)
 };
 
+void
+ZeroMqAddressedAttributedMessageSender::sendSharedPayloadMessage(const std::string& address, const std::string& contentType, const std::string& descriptor, const std::shared_ptr<const std::string>& payload)
+{
+    if (!payload || payload->empty())
+    {
+        UXAS_LOG_WARN("ZeroMqAddressedAttributedMessageSender::sendSharedPayloadMessage ignoring empty payload - did not send message");
+        return;
+    }
+
+    if (m_zmqSocket && isBinaryEnvelope())
+    {
+        sendEnvelopeMessage(address, contentType, descriptor, m_sourceGroup, m_entityId, m_serviceId,
+                            std::chrono::steady_clock::now(), *payload, payload);
+        return;
+    }
+
+    if (m_isTcpStream || !uxas::common::ConfigurationManager::getIsZeroMqMultipartMessage())
+    {
+        // single-part and TCP stream messages embed the payload in a delimited string
+        sendMessage(address, contentType, descriptor, *payload);
+        return;
+    }
+
+    if (m_zmqSocket)
+    {
+        if (uxas::communications::data::AddressedMessage::isValidAddress(address) && !contentType.empty() && !descriptor.empty())
+        {
+            UXAS_LOG_DEBUG_VERBOSE("ZeroMqAddressedAttributedMessageSender::sendSharedPayloadMessage BEFORE sending multi-part message");
+            n_ZMQ::s_sendmore(*m_zmqSocket, address);
+            n_ZMQ::s_sendmore(*m_zmqSocket, contentType);
+            n_ZMQ::s_sendmore(*m_zmqSocket, descriptor);
+            n_ZMQ::s_sendmore(*m_zmqSocket, m_sourceGroup);
+            n_ZMQ::s_sendmore(*m_zmqSocket, m_entityIdString);
+            n_ZMQ::s_sendmore(*m_zmqSocket, m_serviceIdString);
+            // message payload (shared, not copied)
+            n_ZMQ::s_send(*m_zmqSocket, payload);
+            UXAS_LOG_DEBUG_VERBOSE("ZeroMqAddressedAttributedMessageSender::sendSharedPayloadMessage AFTER sending multi-part message");
+        }
+        else
+        {
+            UXAS_LOG_WARN("ZeroMqAddressedAttributedMessageSender::sendSharedPayloadMessage invalid address or attributes - did not send Zero MQ multi-part message");
+        }
+    } //if(m_zmqSocket)
+};
+
 void
 ZeroMqAddressedAttributedMessageSender::sendAddressedAttributedMessage(std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> message)
 {
@@ -103,6 +166,28 @@ ZeroMqAddressedAttributedMessageSender::sendAddressedAttributedMessage(std::uniq
         static size_t idSize{0};
         static uint8_t id[256];
 
+        if (isBinaryEnvelope() && message->isValid())
+        {
+            // forwarded messages keep their original source IDs; non-numeric
+            // IDs cannot be enveloped and are sent in the legacy format below
+            uint32_t sourceEntityId{0};
+            uint32_t sourceServiceId{0};
+            const std::unique_ptr<uxas::communications::data::MessageAttributes>& attributes = message->getMessageAttributesReference();
+            if (uxas::communications::data::MessageEnvelope::toSourceId(attributes->getSourceEntityId(), sourceEntityId)
+                    && uxas::communications::data::MessageEnvelope::toSourceId(attributes->getSourceServiceId(), sourceServiceId))
+            {
+                // forwarded messages also keep their original send time, if known
+                std::chrono::steady_clock::time_point sendTime = message->getSendTime();
+                if (sendTime == std::chrono::steady_clock::time_point())
+                {
+                    sendTime = std::chrono::steady_clock::now();
+                }
+                sendEnvelopeMessage(message->getAddress(), attributes->getContentType(), attributes->getDescriptor(), attributes->getSourceGroup(),
+                                    sourceEntityId, sourceServiceId, sendTime, message->getPayload(), nullptr);
+                return;
+            }
+        }
+
         if (m_isTcpStream)
         {
             if (message->isValid())
@@ -115,7 +200,7 @@ ZeroMqAddressedAttributedMessageSender::sendAddressedAttributedMessage(std::uniq
                 }
                 zmq_send(*m_zmqSocket, id, idSize, ZMQ_SNDMORE);
 
-                std::string sentinelStr = uxas::common::SentinelSerialBuffer::createSentinelizedString(message->getString());
+                std::string sentinelStr = uxas::common::FramedSerialBuffer::createFramedString(message->getString(), uxas::common::FramedSerialBuffer::s_sentinelFramingVersion);
                 UXAS_LOG_DEBUG_VERBOSE("ZeroMqAddressedAttributedMessageSender::sendAddressedAttributedMessage BEFORE sending TCP stream single-part message");
                 zmq_send(*m_zmqSocket, sentinelStr.c_str(), sentinelStr.size(), ZMQ_SNDMORE);
                 UXAS_LOG_DEBUG_VERBOSE("ZeroMqAddressedAttributedMessageSender::sendAddressedAttributedMessage AFTER sending TCP stream single-part message");
@@ -177,6 +262,64 @@ ZeroMqAddressedAttributedMessageSender::sendAddressedAttributedMessage(std::uniq
     } //if(m_zmqSocket)
 };
 
+bool
+ZeroMqAddressedAttributedMessageSender::isBinaryEnvelope()
+{
+    // only in-process peers are known to decode envelopes (external bridge
+    // peers can be legacy entities), so other sockets keep the legacy format
+    return (!m_isTcpStream && uxas::common::ConfigurationManager::getIsZeroMqBinaryEnvelope()
+            && m_zeroMqSocketConfiguration.m_socketAddress.compare(0, c_inProcessAddressPrefix.size(), c_inProcessAddressPrefix) == 0);
+};
+
+void
+ZeroMqAddressedAttributedMessageSender::sendEnvelopeMessage(const std::string& address, const std::string& contentType, const std::string& descriptor,
+                                                            const std::string& sourceGroup, uint32_t sourceEntityId, uint32_t sourceServiceId,
+                                                            const std::chrono::steady_clock::time_point& sendTime, const std::string& payload,
+                                                            const std::shared_ptr<const std::string>& sharedPayload)
+{
+    if (!uxas::communications::data::AddressedMessage::isValidAddress(address))
+    {
+        UXAS_LOG_WARN("ZeroMqAddressedAttributedMessageSender::sendEnvelopeMessage invalid address - did not send message envelope");
+        return;
+    }
+
+    bool isMultipart = uxas::common::ConfigurationManager::getIsZeroMqMultipartMessage();
+    bool isPayloadInNextFrame = isMultipart && sharedPayload;
+    std::string frame;
+    if (!isMultipart)
+    {
+        // single-part: address$envelope (address leads for subscription filtering)
+        frame.reserve(address.size() + 1 + uxas::communications::data::MessageEnvelope::s_headerSize + descriptor.size() + sourceGroup.size() + payload.size());
+        frame.append(address);
+        frame.append(uxas::communications::data::AddressedMessage::s_addressAttributesDelimiter());
+    }
+    if (!uxas::communications::data::MessageEnvelope::encode(contentType, descriptor, sourceGroup, sourceEntityId, sourceServiceId,
+                                                               sendTime, payload, isPayloadInNextFrame, frame))
+    {
+        UXAS_LOG_WARN("ZeroMqAddressedAttributedMessageSender::sendEnvelopeMessage failed to encode message envelope - did not send message");
+        return;
+    }
+
+    UXAS_LOG_DEBUG_VERBOSE("ZeroMqAddressedAttributedMessageSender::sendEnvelopeMessage BEFORE sending message envelope");
+    if (!isMultipart)
+    {
+        n_ZMQ::s_send(*m_zmqSocket, frame);
+    }
+    else if (isPayloadInNextFrame)
+    {
+        n_ZMQ::s_sendmore(*m_zmqSocket, address);
+        n_ZMQ::s_sendmore(*m_zmqSocket, frame);
+        // message payload (shared, not copied)
+        n_ZMQ::s_send(*m_zmqSocket, sharedPayload);
+    }
+    else
+    {
+        n_ZMQ::s_sendmore(*m_zmqSocket, address);
+        n_ZMQ::s_send(*m_zmqSocket, frame);
+    }
+    UXAS_LOG_DEBUG_VERBOSE("ZeroMqAddressedAttributedMessageSender::sendEnvelopeMessage AFTER sending message envelope");
+};
+
 }; //namespace transport
 }; //namespace communications
 }; //namespace uxas
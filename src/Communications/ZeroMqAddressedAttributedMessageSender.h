@@ -25,6 +25,10 @@ namespace transport
  * 
  * @par Description:
  * Composes and sends single-part or multi-part messages across Zero MQ network.
+ * Messages on in-process sockets are sent with a binary attribute envelope
+ * (see <B><i>MessageEnvelope</i></B>) when enabled by configuration. Sockets
+ * to other processes (e.g., bridges to external entities) always use the
+ * legacy format, since their peers may not decode envelopes.
  */
 class ZeroMqAddressedAttributedMessageSender : public ZeroMqSenderBase
 {
@@ -47,13 +51,35 @@ private:
 public:
 
     void
-    sendMessage(const std::string& address, const std::string& contentType, const std::string& descriptor, const std::string payload);
+    sendMessage(const std::string& address, const std::string& contentType, const std::string& descriptor, const std::string& payload);
     
+    /** \brief Send a message whose payload is shared with other sends. For 
+     * multi-part messaging the payload frame references the shared buffer 
+     * directly (no copy); other modes fall back to <B><i>sendMessage</i></B>.
+     * 
+     * @param address message publish address
+     * @param contentType payload content type
+     * @param descriptor payload descriptor
+     * @param payload shared, immutable payload
+     */
+    void
+    sendSharedPayloadMessage(const std::string& address, const std::string& contentType, const std::string& descriptor, const std::shared_ptr<const std::string>& payload);
+
     void
     sendAddressedAttributedMessage(std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> message);
 
 private:
 
+    /** \brief Envelopes are enabled and the socket is in-process. */
+    bool
+    isBinaryEnvelope();
+
+    void
+    sendEnvelopeMessage(const std::string& address, const std::string& contentType, const std::string& descriptor,
+                        const std::string& sourceGroup, uint32_t sourceEntityId, uint32_t sourceServiceId,
+                        const std::chrono::steady_clock::time_point& sendTime, const std::string& payload,
+                        const std::shared_ptr<const std::string>& sharedPayload);
+
     bool m_isTcpStream{false};
     
 };
@@ -15,6 +15,8 @@
 #include "stdUniquePtr.h"
 #include "UxAS_ZeroMQ.h"
 
+#include <algorithm>
+
 namespace uxas
 {
 namespace communications
@@ -27,6 +29,7 @@ ZeroMqAddressedAttributedMessageTcpReceiverSender::~ZeroMqAddressedAttributedMes
     for(auto c : m_clients)
         zframe_destroy(&c);
     m_clients.clear();
+    m_clientFramingVersions.clear();
 }
 
 std::unique_ptr<uxas::communications::data::AddressedAttributedMessage>
@@ -143,8 +146,16 @@ ZeroMqAddressedAttributedMessageTcpReceiverSender::getNextMessage()
                 else
                 {
                     UXAS_LOG_INFORM("ZeroMqAddressedAttributedMessageTcpReceiverSender::getNextMessage detecting new client connect");
+                    // announce binary framing; peers that do not support it disregard the announcement
+                    if (uxas::common::ConfigurationManager::getSerialFramingVersion() >= uxas::common::FramedSerialBuffer::s_binaryFramingVersion)
+                    {
+                        std::string announceFrame = uxas::common::FramedSerialBuffer::createAnnounceFrame();
+                        zmq_send(*m_zmqSocket, zframe_data(identityFrame), zframe_size(identityFrame), ZMQ_SNDMORE);
+                        zmq_send(*m_zmqSocket, announceFrame.c_str(), announceFrame.size(), 0);
+                    }
                     // save identity frame as new client
                     m_clients.push_back(identityFrame);
+                    m_clientFramingVersions.push_back(0);
                 }
 
                 zframe_destroy(&frameData); // delete empty frame data
@@ -154,11 +165,13 @@ ZeroMqAddressedAttributedMessageTcpReceiverSender::getNextMessage()
             // at this point we have an actual data frame ready for processing
             // if for some reason, the identity of this actual data is not in the client list, add it
             bool existingclient = false;
-            for(auto c : m_clients)
+            size_t clientindex = 0;
+            for(size_t k=0; k<m_clients.size(); k++)
             {
-                if(zframe_eq(c,identityFrame))
+                if(zframe_eq(m_clients.at(k),identityFrame))
                 {
                     existingclient = true;
+                    clientindex = k;
                     break;
                 }
             }
@@ -166,7 +179,9 @@ ZeroMqAddressedAttributedMessageTcpReceiverSender::getNextMessage()
             if(!existingclient)
             {
                 UXAS_LOG_INFORM("ZeroMqAddressedAttributedMessageTcpReceiverSender::getNextMessage got a non-zero data packet from unknown client");
+                clientindex = m_clients.size();
                 m_clients.push_back(identityFrame);
+                m_clientFramingVersions.push_back(0);
             }
             else
                 zframe_destroy(&identityFrame);
@@ -191,6 +206,11 @@ ZeroMqAddressedAttributedMessageTcpReceiverSender::getNextMessage()
                 }
                 recvdTcpDataSegment = m_receiveTcpDataBuffer.getNextPayloadString("");
             }
+            // the receive buffer is shared, so record the framing version per client
+            if (m_receiveTcpDataBuffer.getLastFramingVersion() > m_clientFramingVersions.at(clientindex))
+            {
+                m_clientFramingVersions.at(clientindex) = m_receiveTcpDataBuffer.getLastFramingVersion();
+            }
             UXAS_LOG_DEBUG_VERBOSE("ZeroMqAddressedAttributedMessageTcpReceiverSender::getNextMessage BEFORE zframe_destroy");
             zframe_destroy(&frameData);
         }
@@ -227,34 +247,75 @@ ZeroMqAddressedAttributedMessageTcpReceiverSender::sendAddressedAttributedMessag
     std::lock_guard<std::mutex> lock(m_data_guard);
     if (m_zmqSocket)
     {
-        std::string sentinelStr = uxas::common::SentinelSerialBuffer::createSentinelizedString(message->getString());
+        // each frame format is built at most once per message
+        std::string payload = message->getString();
+        std::string sentinelFrame;
+        std::string binaryFrame;
 
         if(m_zeroMqSocketConfiguration.m_isServerBind)
         {
             // send to every connected client
-            for(auto c : m_clients)
+            for(size_t k=0; k<m_clients.size(); k++)
             {
+                const std::string& framedStr = getFramedString(payload, m_clientFramingVersions.at(k), sentinelFrame, binaryFrame);
                 // first part of message must be client identity
-                zmq_send(*m_zmqSocket, zframe_data(c), zframe_size(c), ZMQ_SNDMORE);
+                zmq_send(*m_zmqSocket, zframe_data(m_clients.at(k)), zframe_size(m_clients.at(k)), ZMQ_SNDMORE);
                 UXAS_LOG_DEBUG_VERBOSE("ZeroMqAddressedAttributedMessageTcpReceiverSender::sendAddressedAttributedMessage BEFORE sending TCP stream single-part message");
-                zmq_send(*m_zmqSocket, sentinelStr.c_str(), sentinelStr.size(), 0);
+                zmq_send(*m_zmqSocket, framedStr.c_str(), framedStr.size(), 0);
                 UXAS_LOG_DEBUG_VERBOSE("ZeroMqAddressedAttributedMessageTcpReceiverSender::sendAddressedAttributedMessage AFTER sending TCP stream single-part message");
             }
         }
         else
         {
+            const std::string& framedStr = getFramedString(payload, m_receiveTcpDataBuffer.getPeerFramingVersion(), sentinelFrame, binaryFrame);
+
             // force identity to server id according to http://api.zeromq.org/4-1:zmq-socket
             memset(serverid, 0, 256);
             m_zmqSocket->getsockopt(ZMQ_IDENTITY, serverid, &serveridsize);
 
             zmq_send(*m_zmqSocket, serverid, serveridsize, ZMQ_SNDMORE);
             UXAS_LOG_DEBUG_VERBOSE("ZeroMqAddressedAttributedMessageTcpReceiverSender::sendAddressedAttributedMessage BEFORE sending TCP stream single-part message");
-            zmq_send(*m_zmqSocket, sentinelStr.c_str(), sentinelStr.size(), 0);
+            zmq_send(*m_zmqSocket, framedStr.c_str(), framedStr.size(), 0);
             UXAS_LOG_DEBUG_VERBOSE("ZeroMqAddressedAttributedMessageTcpReceiverSender::sendAddressedAttributedMessage AFTER sending TCP stream single-part message");
         }
     }
 };
 
+uint8_t
+ZeroMqAddressedAttributedMessageTcpReceiverSender::getPeerFramingVersion()
+{
+    std::lock_guard<std::mutex> lock(m_data_guard);
+    if (!m_zeroMqSocketConfiguration.m_isServerBind)
+    {
+        return (m_receiveTcpDataBuffer.getPeerFramingVersion());
+    }
+    if (m_clientFramingVersions.empty())
+    {
+        return (0);
+    }
+    return (*std::min_element(m_clientFramingVersions.begin(), m_clientFramingVersions.end()));
+};
+
+const std::string&
+ZeroMqAddressedAttributedMessageTcpReceiverSender::getFramedString(const std::string& payload, uint8_t peerFramingVersion,
+                                                                   std::string& sentinelFrame, std::string& binaryFrame) const
+{
+    if (peerFramingVersion >= uxas::common::FramedSerialBuffer::s_binaryFramingVersion
+            && uxas::common::ConfigurationManager::getSerialFramingVersion() >= uxas::common::FramedSerialBuffer::s_binaryFramingVersion)
+    {
+        if (binaryFrame.empty())
+        {
+            uxas::common::FramedSerialBuffer::appendFramedString(payload, uxas::common::FramedSerialBuffer::s_binaryFramingVersion, binaryFrame);
+        }
+        return (binaryFrame);
+    }
+    if (sentinelFrame.empty())
+    {
+        uxas::common::FramedSerialBuffer::appendFramedString(payload, uxas::common::FramedSerialBuffer::s_sentinelFramingVersion, sentinelFrame);
+    }
+    return (sentinelFrame);
+};
+
 }; //namespace transport
 }; //namespace communications
 }; //namespace uxas
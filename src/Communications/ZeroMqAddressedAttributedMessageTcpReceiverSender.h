@@ -16,7 +16,7 @@
 #include "czmq.h"
 #include "ZeroMqReceiverBase.h"
 #include "AddressedAttributedMessage.h"
-#include "UxAS_SentinelSerialBuffer.h"
+#include "UxAS_FramedSerialBuffer.h"
 
 namespace uxas
 {
@@ -72,14 +72,31 @@ public:
     void
     sendAddressedAttributedMessage(std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> message);
 
+    /** \brief Lowest framing version negotiated with the peers that messages
+     * are sent to: the server if connected as a client, otherwise every client
+     * connected so far.
+     *
+     * @return 0 if no peer is connected or a peer has not sent a frame yet
+     */
+    uint8_t
+    getPeerFramingVersion();
+
 private:
 
-    uxas::common::SentinelSerialBuffer m_receiveTcpDataBuffer;
+    /** \brief Frames <B><i>payload</i></B> for a peer with the given
+     * (announced) framing version, re-using frames already built. */
+    const std::string&
+    getFramedString(const std::string& payload, uint8_t peerFramingVersion, std::string& sentinelFrame, std::string& binaryFrame) const;
+
+    uxas::common::FramedSerialBuffer m_receiveTcpDataBuffer;
     std::deque< std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> > m_recvdMsgs;
     std::string m_sourceGroup;
     
     // for return sending for zeromq tcp sockets
     std::vector< zframe_t* > m_clients;
+
+    // highest framing version received from each client (same order as m_clients)
+    std::vector< uint8_t > m_clientFramingVersions;
     
     // guard for accessing m_clients to carefully manage memory of zframes
     std::mutex m_data_guard;
@@ -58,6 +58,26 @@ ZeroMqReceiverBase::initialize(uint32_t entityId, uint32_t serviceId, SocketConf
     }
 };
 
+bool
+ZeroMqReceiverBase::connectSocketAddress(const std::string& socketAddress)
+{
+    if (!m_zmqSocket)
+    {
+        UXAS_LOG_ERROR("ZeroMqReceiverBase::connectSocketAddress socket has not been created");
+        return (false);
+    }
+    try
+    {
+        m_zmqSocket->connect(socketAddress.c_str());
+    }
+    catch (std::exception& ex)
+    {
+        UXAS_LOG_ERROR("ZeroMqReceiverBase::connectSocketAddress connect to ", socketAddress, " EXCEPTION: ", ex.what());
+        return (false);
+    }
+    return (true);
+};
+
 bool
 ZeroMqReceiverBase::addSubscriptionAddressToSocket(const std::string& address)
 {
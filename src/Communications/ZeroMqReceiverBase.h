@@ -67,6 +67,15 @@ public:
     void
     initialize(uint32_t entityId, uint32_t serviceId, SocketConfiguration& zeroMqSocketConfiguration);
     
+    /** \brief Connect the (already initialized) socket to an additional 
+     * endpoint, e.g., the publish sockets of a sharded message hub.
+     * 
+     * @param socketAddress Zero MQ endpoint
+     * @return true if connected
+     */
+    bool
+    connectSocketAddress(const std::string& socketAddress);
+
     bool
     addSubscriptionAddressToSocket(const std::string& address) override;
 
@@ -10,7 +10,7 @@
 #ifndef UXAS_MESSAGE_TRANSPORT_ZERO_MQ_SENDER_BASE_H
 #define UXAS_MESSAGE_TRANSPORT_ZERO_MQ_SENDER_BASE_H
 
-#include "TransportBase.h"
+#include "TransportSenderBase.h"
 
 #include "ZeroMqSocketConfiguration.h"
 
@@ -30,13 +30,13 @@ namespace transport
  * @par Description:
  * Composes and sends messages across Zero MQ network.
  */
-class ZeroMqSenderBase : public TransportBase
+class ZeroMqSenderBase : public TransportSenderBase
 {
     
 public:
     
     ZeroMqSenderBase()
-    : TransportBase() { };
+    : TransportSenderBase() { };
 
     virtual
     ~ZeroMqSenderBase();
@@ -10,6 +10,7 @@
 #ifndef UXAS_COMMON_STRING_CONSTANT_H
 #define UXAS_COMMON_STRING_CONSTANT_H
 
+#include <cstdint>
 #include <string>
 
 namespace uxas
@@ -24,6 +25,9 @@ public:
 //
     static const std::string& Alias() { static std::string s_string("Alias"); return(s_string); };
     static const std::string& AlwaysSendPosition() { static std::string s_string("AlwaysSendPosition"); return(s_string); };
+    static const std::string& AsynchronousLogRingCapacity() { static std::string s_string("AsynchronousLogRingCapacity"); return(s_string); };
+    static const std::string& BatchCompressionLevel() { static std::string s_string("BatchCompressionLevel"); return(s_string); };
+    static const std::string& BatchWindow_ms() { static std::string s_string("BatchWindow_ms"); return(s_string); };
     static const std::string& BaudRate() { static std::string s_string("BaudRate"); return(s_string); };
     static const std::string& Bridge() { static std::string s_string("Bridge"); return(s_string); };
     static const std::string& Component() { static std::string s_string("Component"); return(s_string); };
@@ -34,13 +38,26 @@ public:
     static const std::string& EntityType() { static std::string s_string("EntityType"); return(s_string); };
     static const std::string& FilterType() { static std::string s_string("FilterType"); return(s_string); };
     static const std::string& GapTime_ms() { static std::string s_string("GapTime_ms"); return(s_string); };
+    static const std::string& isAsynchronousLogging() { static std::string s_string("isAsynchronousLogging"); return(s_string); };
     static const std::string& isDataTimestamp() { static std::string s_string("isDataTimestamp"); return(s_string); };
+    static const std::string& isInProcessMessageBus() { static std::string s_string("isInProcessMessageBus"); return(s_string); };
     static const std::string& isLoggingThreadId() { static std::string s_string("isLoggingThreadId"); return(s_string); };
+    static const std::string& isMessageProcessingStatistics() { static std::string s_string("isMessageProcessingStatistics"); return(s_string); };
+    static const std::string& isZeroMqBinaryEnvelope() { static std::string s_string("isZeroMqBinaryEnvelope"); return(s_string); };
+    static const std::string& LatestValueMessage() { static std::string s_string("LatestValueMessage"); return(s_string); };
+    static const std::string& LogDatabaseBatchCount() { static std::string s_string("LogDatabaseBatchCount"); return(s_string); };
+    static const std::string& LogDatabaseBatchPeriod_ms() { static std::string s_string("LogDatabaseBatchPeriod_ms"); return(s_string); };
+    static const std::string& LogDatabaseFormat() { static std::string s_string("LogDatabaseFormat"); return(s_string); };
     static const std::string& LogFileMessageCountLimit() { static std::string s_string("LogFileMessageCountLimit"); return(s_string); };
+    static const std::string& LogRecording() { static std::string s_string("LogRecording"); return(s_string); };
+    static const std::string& LogRecordingChunkSize_kB() { static std::string s_string("LogRecordingChunkSize_kB"); return(s_string); };
+    static const std::string& LogRecordingCompressed() { static std::string s_string("LogRecordingCompressed"); return(s_string); };
     static const std::string& MainFileLoggerSeverityLevel() { static std::string s_string("MainFileLoggerSeverityLevel"); return(s_string); };
+    static const std::string& MessageBatchVersion() { static std::string s_string("MessageBatchVersion"); return(s_string); };
     static const std::string& MessageGroup() { static std::string s_string("MessageGroup"); return(s_string); };
     static const std::string& MessageType() { static std::string s_string("MessageType"); return(s_string); };
     static const std::string& NetworkDevice() { static std::string s_string("NetworkDevice"); return(s_string); };
+    static const std::string& NetworkServerWorkerCount() { static std::string s_string("NetworkServerWorkerCount"); return(s_string); };
     static const std::string& ZyreEndpoint() { static std::string s_string("ZyreEndpoint"); return(s_string); };
     static const std::string& GossipEndpoint() { static std::string s_string("GossipEndpoint"); return(s_string); };
     static const std::string& GossipBind() { static std::string s_string("GossipBind"); return(s_string); };
@@ -53,6 +70,7 @@ public:
     static const std::string& SendSourceEntityId() { static std::string s_string("SendSourceEntityId"); return(s_string); };
     static const std::string& SendSourceGroup() { static std::string s_string("SendSourceGroup"); return(s_string); };
     static const std::string& SendSourceServiceId() { static std::string s_string("SendSourceServiceId"); return(s_string); };
+    static const std::string& SerialFramingVersion() { static std::string s_string("SerialFramingVersion"); return(s_string); };
     static const std::string& SerialPortAddress() { static std::string s_string("SerialPortAddress"); return(s_string); };
     static const std::string& SerialPollWaitTime_us() { static std::string s_string("SerialPollWaitTime_us"); return(s_string); };
     static const std::string& SerialTimeout_ms() { static std::string s_string("SerialTimeout_ms"); return(s_string); };
@@ -62,6 +80,7 @@ public:
     static const std::string& SubscribeToExternalMessage() { static std::string s_string("SubscribeToExternalMessage"); return(s_string); };
     static const std::string& SubscribeToMessage() { static std::string s_string("SubscribeToMessage"); return(s_string); };
     static const std::string& TcpAddress() { static std::string s_string("TcpAddress"); return(s_string); };
+    static const std::string& TimerCallbackThreadCount() { static std::string s_string("TimerCallbackThreadCount"); return(s_string); };
     static const std::string& TransformReceivedMessage() { static std::string s_string("TransformReceivedMessage"); return(s_string); };
     static const std::string& Type() { static std::string s_string("Type"); return(s_string); };
     static const std::string& UAV() { static std::string s_string("UAV"); return(s_string); };
@@ -73,6 +92,7 @@ class ContentType
 {
 public:
 
+    static const std::string& batch() { static std::string s_string("batch"); return(s_string); };
     static const std::string& json() { static std::string s_string("json"); return(s_string); };
     static const std::string& lmcp() { static std::string s_string("lmcp"); return(s_string); };
     static const std::string& text() { static std::string s_string("text"); return(s_string); };
@@ -98,6 +118,8 @@ public:
     static const std::string& strGetInProc_ThreadControl(){static std::string strString("inproc://thread_control");return(strString);};
     static const std::string& strGetInProc_FromMessageHub(){static std::string strString("inproc://from_message_hub");return(strString);};
     static const std::string& strGetInProc_ToMessageHub(){static std::string strString("inproc://to_message_hub");return(strString);};
+    /** \brief Publish address of a sharded message hub worker (shard 0 uses the unsharded hub address). */
+    static std::string strGetInProc_FromMessageHub(uint32_t shardIndex){return(shardIndex == 0 ? strGetInProc_FromMessageHub() : strGetInProc_FromMessageHub() + "_" + std::to_string(shardIndex));};
     static const std::string& strGetInProc_ConfigurationHub(){static std::string strString("inproc://configuration_hub");return(strString);};
     static const std::string& strGetInProc_ManagerThreadControl(){static std::string strString("inproc://manager_thread_control");return(strString);};
 
@@ -375,48 +375,12 @@ CPolygon::enError CPolygon::errFindVisibleEdges(V_POSITION_t& vposVertexContaine
         {
             for(auto itVertexThat=itPolygonThat->viGetVerticies().begin();itVertexThat!=itPolygonThat->viGetVerticies().end();itVertexThat++)
             {
-                //first check to make sure that the segment doesn't violate the keep-in rules of this polygon
-                //1. check to see if the center of the edge is in the polygon
-                bool bGoodEdge(true);
-
-                if(plytypGetPolygonType().bGetKeepIn())
-                {
-                    double dCenterNorth_m = (vposVertexContainer[*itVertexThat].m_north_m - vposVertexContainer[*itVertexThis].m_north_m)*0.5 + vposVertexContainer[*itVertexThis].m_north_m;
-                    double dCenterEast_m = (vposVertexContainer[*itVertexThat].m_east_m - vposVertexContainer[*itVertexThis].m_east_m)*0.5 + vposVertexContainer[*itVertexThis].m_east_m;
-
-                    bool bInsidePolygon(false);
-
-                    stringstream sstrErrorMessage;
-                    bInsidePolygon = InPolygon(dCenterNorth_m,dCenterEast_m,0.0,vposVertexContainer,sstrErrorMessage);
-
-                    if(bInsidePolygon != true)
-                    {
-                        bGoodEdge = false;
-                    }
-                }        //plytypGetPolygonType().bGetKeepIn()
-
-                // 2. check new edge against all exisitng edges
-                if(bGoodEdge)
+                if(bIsVisible(vposVertexContainer,*itVertexThis,*itVertexThat))
                 {
-                    bool bIntersectionFound(false);
                     CEdge edgeNew(*itVertexThis,*itVertexThat);
-                    for(MMAP_INT_ITPOLYGON_IT_t itIntPolygon=mmapiitGetSortedDistancesToOtherPolygons().begin();
-                        itIntPolygon!=mmapiitGetSortedDistancesToOtherPolygons().end();
-                        itIntPolygon++)
-                    {
-                        V_POLYGON_IT_t itPolygonCheck = itIntPolygon->second;
-                        if(itPolygonCheck->bCheckForIntersection(vposVertexContainer,edgeNew))
-                        {
-                            bIntersectionFound = true;
-                            break;
-                        }
-                    }        //for(V_POLYGON_CONST_IT_t itPolygon=itPolygonAllBegin;itPolygon!=itPolygonAllEnd;itPolygon++)
-                    if(!bIntersectionFound)
-                    {
-                        edgeNew.iGetLength() = static_cast<int>(vposVertexContainer[*itVertexThis].relativeDistance2D_m(vposVertexContainer[*itVertexThat]));
-                        veEdgesVisible.push_back(edgeNew);
-                    }
-                }        //if(bGoodEdge)
+                    edgeNew.iGetLength() = static_cast<int>(vposVertexContainer[*itVertexThis].relativeDistance2D_m(vposVertexContainer[*itVertexThat]));
+                    veEdgesVisible.push_back(edgeNew);
+                }
             }        //for(auto itVertexThat=itPolygonThat->viGetVerticies().begin();itVertexThat!=itPolygonThat->viGetVerticies().end();itVertexThat++)
         }
 
@@ -424,6 +388,48 @@ CPolygon::enError CPolygon::errFindVisibleEdges(V_POSITION_t& vposVertexContaine
         return(errReturn);
     };
 
+bool CPolygon::bIsVisible(V_POSITION_t& vposVertexContainer,const int32_t& iVertexThis,const int32_t& iVertexThat)
+    {
+        //first check to make sure that the segment doesn't violate the keep-in rules of this polygon
+        //1. check to see if the center of the edge is in the polygon
+        bool bGoodEdge(true);
+
+        if(plytypGetPolygonType().bGetKeepIn())
+        {
+            double dCenterNorth_m = (vposVertexContainer[iVertexThat].m_north_m - vposVertexContainer[iVertexThis].m_north_m)*0.5 + vposVertexContainer[iVertexThis].m_north_m;
+            double dCenterEast_m = (vposVertexContainer[iVertexThat].m_east_m - vposVertexContainer[iVertexThis].m_east_m)*0.5 + vposVertexContainer[iVertexThis].m_east_m;
+
+            bool bInsidePolygon(false);
+
+            stringstream sstrErrorMessage;
+            bInsidePolygon = InPolygon(dCenterNorth_m,dCenterEast_m,0.0,vposVertexContainer,sstrErrorMessage);
+
+            if(bInsidePolygon != true)
+            {
+                bGoodEdge = false;
+            }
+        }        //plytypGetPolygonType().bGetKeepIn()
+
+        // 2. check new edge against all exisitng edges
+        if(bGoodEdge)
+        {
+            CEdge edgeNew(iVertexThis,iVertexThat);
+            for(MMAP_INT_ITPOLYGON_IT_t itIntPolygon=mmapiitGetSortedDistancesToOtherPolygons().begin();
+                itIntPolygon!=mmapiitGetSortedDistancesToOtherPolygons().end();
+                itIntPolygon++)
+            {
+                V_POLYGON_IT_t itPolygonCheck = itIntPolygon->second;
+                if(itPolygonCheck->bCheckForIntersection(vposVertexContainer,edgeNew))
+                {
+                    bGoodEdge = false;
+                    break;
+                }
+            }        //for(V_POLYGON_CONST_IT_t itPolygon=itPolygonAllBegin;itPolygon!=itPolygonAllEnd;itPolygon++)
+        }        //if(bGoodEdge)
+
+        return(bGoodEdge);
+    };
+
 CPolygon::enError CPolygon::errAddExtraVisibleEdges(V_POSITION_t& vposVertexContainer,const V_POLYGON_CONST_IT_t& itPolygonThat,V_EDGE_t& veEdgesVisible)
     {
         enError errReturn(errNoError);
@@ -622,6 +622,8 @@ public:    //methods/functions
     enError errCheckForConcavity(V_POSITION_t& vposVerticies);
     enError errFindSelfVisibleEdges(V_POSITION_t& vposVertexContainer);
     enError errFindVisibleEdges(V_POSITION_t& vposVertexContainer,const V_POLYGON_CONST_IT_t& itPolygonThat,V_EDGE_t& veEdgesVisible);
+    // visibility of the segment from a vertex of this polygon to a vertex of another polygon (see errFindVisibleEdges)
+    bool bIsVisible(V_POSITION_t& vposVertexContainer,const int32_t& iVertexThis,const int32_t& iVertexThat);
     enError errAddExtraVisibleEdges(V_POSITION_t& vposVertexContainer,const V_POLYGON_CONST_IT_t& itPolygonThat,V_EDGE_t& veEdgesVisible);
 
 
@@ -22,6 +22,7 @@
 //    1. Add polygons    => enError errAddPolygon(const int& iUniqueID,V_POSITION_IT_t itBegin,V_POSITION_IT_t itEnd)
 //    2. Finalize polygons => enError errFinalizePolygons(void)
 //    3. Build visibility graph => enError errBuildVisibilityGraph(void)
+//        (or, after a change of the polygons, errBuildVisibilityGraph(const CVisibilityGraph& cvgPrevious))
 //    4. Add extra vertices, e.g. vehicles/objectives => vposidVerticiesCurrent.push_back(CPosition())
 //    5. Buld current visibility graph, i.e. find visible edges for each of the new vertices =>  enError errBuildVisibilityGraphCurrent(void)
 //
@@ -39,6 +40,9 @@
 
 #include <pugixml.hpp>
 
+#include <algorithm>    //sort, unique
+#include <limits>
+#include <unordered_set>
 
 namespace n_FrameworkLib
 {
@@ -207,6 +211,189 @@ namespace n_FrameworkLib
         // if keep-out edges go out of the keep-in zone then don't add it a valid
 
 
+        errReturn = errInitializeEdgesVisibleBase();
+
+        //based on order of polygons:
+        //    create line segments using vertices from current polygon to every other polygon
+        //    for each line segment check all polygon edges for intersections
+        if (!vplygnGetPolygons().empty())
+        {
+            for (V_POLYGON_IT_t itPolygons1 = vplygnGetPolygons().begin(); itPolygons1 != (vplygnGetPolygons().end() - 1); itPolygons1++)
+            {
+                for (V_POLYGON_IT_t itPolygons2 = (itPolygons1 + 1); itPolygons2 != vplygnGetPolygons().end(); itPolygons2++)
+                {
+                    itPolygons1->errFindVisibleEdges(vposGetVerticiesBase(), itPolygons2, veGetEdgesVisibleBase());
+                }
+            }
+        }
+
+        if (errReturn == errNoError)
+        {
+            errReturn = errAddExtraEdgesVisibleBase();
+        }
+        PRINT_DEBUG("*DEBUG*")
+        return (errReturn);
+    }
+    
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////        
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////    
+
+    CVisibilityGraph::enError CVisibilityGraph::errBuildVisibilityGraph(const CVisibilityGraph& cvgPrevious)
+    {
+        // same result as errBuildVisibilityGraph(void), but the visibility of segments between vertices of polygons that
+        // are unchanged from cvgPrevious (same type and vertex positions) is taken from the previous graph:
+        //    - a previously visible segment stays visible unless a polygon that was added crosses it
+        //    - a previously hidden segment is rechecked only if a polygon that was removed crossed it
+        // segments to vertices of added polygons are checked as in the full build
+        PRINT_DEBUG("*DEBUG*")
+        enError errReturn(errNoError);
+
+        errReturn = errInitializeEdgesVisibleBase();
+
+        // 1) match the polygons to the previous ones and map their vertices to the previous vertices
+        const V_POSITION_t& vposPrevious(cvgPrevious.vposGetVerticiesBase());
+        const V_POLYGON_t& vplygnPrevious(cvgPrevious.vplygnGetPolygons());
+        std::vector<int32_t> viPolygonPrevious(vplygnGetPolygons().size(), -1);
+        std::vector<bool> vbPreviousMatched(vplygnPrevious.size(), false);
+        std::vector<int32_t> viVertexPrevious(vposGetVerticiesBase().size(), -1);
+        for (size_t szPolygon = 0; szPolygon < vplygnGetPolygons().size(); szPolygon++)
+        {
+            const CPolygon& plygnThis(vplygnGetPolygons()[szPolygon]);
+            for (size_t szPrevious = 0; szPrevious < vplygnPrevious.size(); szPrevious++)
+            {
+                const CPolygon& plygnPrevious(vplygnPrevious[szPrevious]);
+                bool bMatch = !vbPreviousMatched[szPrevious]
+                        && (plygnPrevious.plytypGetPolygonType().bGetKeepIn() == plygnThis.plytypGetPolygonType().bGetKeepIn())
+                        && (plygnPrevious.viGetVerticies().size() == plygnThis.viGetVerticies().size());
+                for (size_t szVertex = 0; bMatch && (szVertex < plygnThis.viGetVerticies().size()); szVertex++)
+                {
+                    const CPosition& posThis(vposGetVerticiesBase()[plygnThis.viGetVerticies()[szVertex]]);
+                    const CPosition& posPrevious(vposPrevious[plygnPrevious.viGetVerticies()[szVertex]]);
+                    bMatch = (posThis.m_north_m == posPrevious.m_north_m) && (posThis.m_east_m == posPrevious.m_east_m)
+                            && (posThis.m_altitude_m == posPrevious.m_altitude_m);
+                }
+                if (bMatch)
+                {
+                    viPolygonPrevious[szPolygon] = static_cast<int32_t> (szPrevious);
+                    vbPreviousMatched[szPrevious] = true;
+                    for (size_t szVertex = 0; szVertex < plygnThis.viGetVerticies().size(); szVertex++)
+                    {
+                        viVertexPrevious[plygnThis.viGetVerticies()[szVertex]] = plygnPrevious.viGetVerticies()[szVertex];
+                    }
+                    break;
+                }
+            }
+        }
+
+        // 2) the previously visible segments, the added and the removed polygons (bounding boxes to skip distant ones)
+        std::unordered_set<uint64_t> uiVisiblePrevious;
+        for (auto itEdge = cvgPrevious.veGetEdgesVisibleBase().begin(); itEdge != cvgPrevious.veGetEdgesVisibleBase().end(); itEdge++)
+        {
+            uiVisiblePrevious.insert(uiGetVertexPairKey(static_cast<int32_t> (itEdge->first), static_cast<int32_t> (itEdge->second)));
+        }
+        std::vector<V_POLYGON_IT_t> vitPolygonsAdded;
+        std::vector<CPosition> vposAddedMinimum;
+        std::vector<CPosition> vposAddedMaximum;
+        for (size_t szPolygon = 0; szPolygon < vplygnGetPolygons().size(); szPolygon++)
+        {
+            if (viPolygonPrevious[szPolygon] < 0)
+            {
+                vitPolygonsAdded.push_back(vplygnGetPolygons().begin() + szPolygon);
+                vposAddedMinimum.push_back(CPosition());
+                vposAddedMaximum.push_back(CPosition());
+                FindBoundingBox(vposGetVerticiesBase(), vplygnGetPolygons()[szPolygon], vposAddedMinimum.back(), vposAddedMaximum.back());
+            }
+        }
+        V_POSITION_t vposRemovedVertices;
+        V_POLYGON_t vplygnRemoved;
+        std::vector<CPosition> vposRemovedMinimum;
+        std::vector<CPosition> vposRemovedMaximum;
+        for (size_t szPrevious = 0; szPrevious < vplygnPrevious.size(); szPrevious++)
+        {
+            if (!vbPreviousMatched[szPrevious])
+            {
+                if (vposRemovedVertices.empty())
+                {
+                    vposRemovedVertices = vposPrevious;
+                }
+                vplygnRemoved.push_back(vplygnPrevious[szPrevious]);
+                vposRemovedMinimum.push_back(CPosition());
+                vposRemovedMaximum.push_back(CPosition());
+                FindBoundingBox(vposPrevious, vplygnPrevious[szPrevious], vposRemovedMinimum.back(), vposRemovedMaximum.back());
+            }
+        }
+
+        // 3) same order of polygons and vertices as errBuildVisibilityGraph(void)
+        if (!vplygnGetPolygons().empty())
+        {
+            for (V_POLYGON_IT_t itPolygons1 = vplygnGetPolygons().begin(); itPolygons1 != (vplygnGetPolygons().end() - 1); itPolygons1++)
+            {
+                int32_t iPrevious1 = viPolygonPrevious[itPolygons1 - vplygnGetPolygons().begin()];
+                for (V_POLYGON_IT_t itPolygons2 = (itPolygons1 + 1); itPolygons2 != vplygnGetPolygons().end(); itPolygons2++)
+                {
+                    int32_t iPrevious2 = viPolygonPrevious[itPolygons2 - vplygnGetPolygons().begin()];
+                    // the keep-in check is made on the first polygon of the pair, it must be the first one of the previous pair as well
+                    bool bReusePrevious = (iPrevious1 >= 0) && (iPrevious2 >= 0)
+                            && ((iPrevious1 < iPrevious2) || (!itPolygons1->plytypGetPolygonType().bGetKeepIn() && !itPolygons2->plytypGetPolygonType().bGetKeepIn()));
+                    if (!bReusePrevious)
+                    {
+                        itPolygons1->errFindVisibleEdges(vposGetVerticiesBase(), itPolygons2, veGetEdgesVisibleBase());
+                        continue;
+                    }
+                    for (auto itVertexThis = itPolygons1->viGetVerticies().begin(); itVertexThis != itPolygons1->viGetVerticies().end(); itVertexThis++)
+                    {
+                        for (auto itVertexThat = itPolygons2->viGetVerticies().begin(); itVertexThat != itPolygons2->viGetVerticies().end(); itVertexThat++)
+                        {
+                            bool bVisible(false);
+                            CEdge edgeNew(*itVertexThis, *itVertexThat);
+                            if (uiVisiblePrevious.find(uiGetVertexPairKey(viVertexPrevious[*itVertexThis], viVertexPrevious[*itVertexThat])) != uiVisiblePrevious.end())
+                            {
+                                bVisible = true;
+                                for (size_t szAdded = 0; bVisible && (szAdded < vitPolygonsAdded.size()); szAdded++)
+                                {
+                                    bVisible = !(bSegmentInBoundingBox(vposGetVerticiesBase()[*itVertexThis], vposGetVerticiesBase()[*itVertexThat], vposAddedMinimum[szAdded], vposAddedMaximum[szAdded])
+                                            && vitPolygonsAdded[szAdded]->bCheckForIntersection(vposGetVerticiesBase(), edgeNew));
+                                }
+                            }
+                            else
+                            {
+                                CEdge edgePrevious(viVertexPrevious[*itVertexThis], viVertexPrevious[*itVertexThat]);
+                                for (size_t szRemoved = 0; !bVisible && (szRemoved < vplygnRemoved.size()); szRemoved++)
+                                {
+                                    if (bSegmentInBoundingBox(vposPrevious[edgePrevious.first], vposPrevious[edgePrevious.second], vposRemovedMinimum[szRemoved], vposRemovedMaximum[szRemoved])
+                                            && vplygnRemoved[szRemoved].bCheckForIntersection(vposRemovedVertices, edgePrevious))
+                                    {
+                                        bVisible = itPolygons1->bIsVisible(vposGetVerticiesBase(), *itVertexThis, *itVertexThat);
+                                        break;
+                                    }
+                                }
+                            }
+                            if (bVisible)
+                            {
+                                edgeNew.iGetLength() = static_cast<int> (vposGetVerticiesBase()[*itVertexThis].relativeDistance2D_m(vposGetVerticiesBase()[*itVertexThat]));
+                                veGetEdgesVisibleBase().push_back(edgeNew);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        if (errReturn == errNoError)
+        {
+            errReturn = errAddExtraEdgesVisibleBase();
+        }
+        PRINT_DEBUG("*DEBUG*")
+        return (errReturn);
+    }
+    
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////        
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////    
+
+    CVisibilityGraph::enError CVisibilityGraph::errInitializeEdgesVisibleBase()
+    {
+        enError errReturn(errNoError);
+
         //clear out any old edges
         veGetEdgesVisibleBase().clear();
         //add all of the visible edges that we already know about
@@ -276,19 +463,15 @@ namespace n_FrameworkLib
             itPolygon->errCalculateDistanceToOtherPolygons(itPolygonBegin, itPolygonEnd);
         }
 
-        //based on order of polygons:
-        //    create line segments using vertices from current polygon to every other polygon
-        //    for each line segment check all polygon edges for intersections
-        if (!vplygnGetPolygons().empty())
-        {
-            for (V_POLYGON_IT_t itPolygons1 = vplygnGetPolygons().begin(); itPolygons1 != (vplygnGetPolygons().end() - 1); itPolygons1++)
-            {
-                for (V_POLYGON_IT_t itPolygons2 = (itPolygons1 + 1); itPolygons2 != vplygnGetPolygons().end(); itPolygons2++)
-                {
-                    itPolygons1->errFindVisibleEdges(vposGetVerticiesBase(), itPolygons2, veGetEdgesVisibleBase());
-                }
-            }
-        }
+        return (errReturn);
+    }
+    
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////        
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////    
+
+    CVisibilityGraph::enError CVisibilityGraph::errAddExtraEdgesVisibleBase()
+    {
+        enError errReturn(errNoError);
 
         //based on order of polygons:
         //    check each of the extra edges, generated earlier to make sure they don't intersect other polygons
@@ -316,7 +499,6 @@ namespace n_FrameworkLib
         {
             vplygnGetPolygons().begin()->errAddExtraVisibleEdges(vposGetVerticiesBase(), vplygnGetPolygons().begin(), veGetEdgesVisibleBase());
         }
-        PRINT_DEBUG("*DEBUG*")
         return (errReturn);
     }
     
@@ -1086,6 +1268,159 @@ namespace n_FrameworkLib
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////        
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////    
 
+    bool CVisibilityGraph::isFindPaths(std::vector<std::shared_ptr<n_FrameworkLib::CPathInformation> >& vpathInformation,
+            const PARALLEL_FOR_t& parallelFor)
+    {
+        bool isSuccessful(true);
+
+        auto forEach = [&parallelFor](size_t szCount, const std::function<void(size_t)>& body)
+        {
+            if (parallelFor)
+            {
+                parallelFor(szCount, body);
+            }
+            else
+            {
+                for (size_t szIndex = 0; szIndex < szCount; szIndex++)
+                {
+                    body(szIndex);
+                }
+            }
+        };
+
+        // distinct start and end positions (rows and columns of the cost matrix)
+        std::vector<CPosition> vposStarts;
+        std::vector<CPosition> vposEnds;
+        std::vector<size_t> vszStartIndex(vpathInformation.size());
+        std::vector<size_t> vszEndIndex(vpathInformation.size());
+        {
+            std::map<std::pair<double, double>, size_t> mpdszStarts;
+            std::map<std::pair<double, double>, size_t> mpdszEnds;
+            for (size_t szPath = 0; szPath < vpathInformation.size(); szPath++)
+            {
+                const CPosition& posStart = vpathInformation[szPath]->posGetStart();
+                auto itStart = mpdszStarts.insert(std::make_pair(std::make_pair(posStart.m_north_m, posStart.m_east_m), vposStarts.size()));
+                if (itStart.second)
+                {
+                    vposStarts.push_back(posStart);
+                }
+                vszStartIndex[szPath] = itStart.first->second;
+
+                const CPosition& posEnd = vpathInformation[szPath]->posGetEnd();
+                auto itEnd = mpdszEnds.insert(std::make_pair(std::make_pair(posEnd.m_north_m, posEnd.m_east_m), vposEnds.size()));
+                if (itEnd.second)
+                {
+                    vposEnds.push_back(posEnd);
+                }
+                vszEndIndex[szPath] = itEnd.first->second;
+            }
+        }
+
+        // base vertices referenced by the polygon edges
+        std::vector<int32_t> vi32BaseVertices;
+        for (V_POLYGON_IT_t itPolygons1 = vplygnGetPolygons().begin(); itPolygons1 != (vplygnGetPolygons().end()); itPolygons1++)
+        {
+            for (CEdge::V_EDGE_IT_t itEdge1 = itPolygons1->veGetPolygonEdges().begin(); itEdge1 != itPolygons1->veGetPolygonEdges().end(); itEdge1++)
+            {
+                vi32BaseVertices.push_back(static_cast<int32_t> (itEdge1->first));
+            }
+        }
+        std::sort(vi32BaseVertices.begin(), vi32BaseVertices.end());
+        vi32BaseVertices.erase(std::unique(vi32BaseVertices.begin(), vi32BaseVertices.end()), vi32BaseVertices.end());
+
+        // for each start: the shortest distance to every base vertex (start -> visible base vertex -> base graph)
+        // and the visible base vertex that path leaves the start through
+        const double dInfinity((std::numeric_limits<double>::max)());
+        size_t szVertexCount(vposGetVerticiesBase().size());
+        std::vector<std::vector<double> > vvdStartToBase(vposStarts.size());
+        std::vector<std::vector<int32_t> > vvi32StartExit(vposStarts.size());
+        forEach(vposStarts.size(), [&](size_t szStart)
+        {
+            const CPosition& posStart = vposStarts[szStart];
+            std::vector<double>& vdStartToBase = vvdStartToBase[szStart];
+            std::vector<int32_t>& vi32StartExit = vvi32StartExit[szStart];
+            vdStartToBase.assign(szVertexCount, dInfinity);
+            vi32StartExit.assign(szVertexCount, -1);
+            for (auto i32Vertex : vi32BaseVertices)
+            {
+                if (!bFindIntersection(vposGetVerticiesBase(), vplygnGetPolygons(), posStart, vposGetVerticiesBase()[static_cast<unsigned int> (i32Vertex)], -1, i32Vertex))
+                {
+                    double dStartToVertex = static_cast<double> (static_cast<int> (posStart.relativeDistance2D_m(vposGetVerticiesBase()[static_cast<unsigned int> (i32Vertex)])));
+                    const std::vector<int32_t>& vi32Distances = vviGetVertexDistancesBase()[static_cast<size_t> (i32Vertex)];
+                    for (auto i32BaseVertex : vi32BaseVertices)
+                    {
+                        double dDistanceCandidate = dStartToVertex + static_cast<double> (vi32Distances[static_cast<size_t> (i32BaseVertex)]);
+                        if (dDistanceCandidate < vdStartToBase[static_cast<size_t> (i32BaseVertex)])
+                        {
+                            vdStartToBase[static_cast<size_t> (i32BaseVertex)] = dDistanceCandidate;
+                            vi32StartExit[static_cast<size_t> (i32BaseVertex)] = i32Vertex;
+                        }
+                    }
+                }
+            }
+        });
+
+        // for each end: the visible base vertices
+        std::vector<V_VISIBLE_VERTEX_t> vvvisEndVisible(vposEnds.size());
+        forEach(vposEnds.size(), [&](size_t szEnd)
+        {
+            const CPosition& posEnd = vposEnds[szEnd];
+            for (auto i32Vertex : vi32BaseVertices)
+            {
+                if (!bFindIntersection(vposGetVerticiesBase(), vplygnGetPolygons(), vposGetVerticiesBase()[static_cast<unsigned int> (i32Vertex)], posEnd, i32Vertex, -1))
+                {
+                    vvvisEndVisible[szEnd].push_back(std::make_pair(i32Vertex,
+                            static_cast<int32_t> (posEnd.relativeDistance2D_m(vposGetVerticiesBase()[static_cast<unsigned int> (i32Vertex)]))));
+                }
+            }
+        });
+
+        // connect each path's end to its start's distances
+        forEach(vpathInformation.size(), [&](size_t szPath)
+        {
+            const CPosition posStart = vposStarts[vszStartIndex[szPath]];
+            const CPosition posEnd = vposEnds[vszEndIndex[szPath]];
+            CPathInformation& pathInformation = *vpathInformation[szPath];
+            if (!bFindIntersection(vposGetVerticiesBase(), vplygnGetPolygons(), posStart, posEnd))
+            {
+                // NO INTERSECTIONS FOUND -> DIRECT PATH
+                pathInformation.iGetIndexBaseBegin() = -1;
+                pathInformation.iGetIndexBaseEnd() = -1;
+                pathInformation.iGetLength() = static_cast<int> (posStart.relativeDistance2D_m(posEnd));
+                pathInformation.posGetStart() = posStart;
+                pathInformation.posGetEnd() = posEnd;
+            }
+            else
+            {
+                const std::vector<double>& vdStartToBase = vvdStartToBase[vszStartIndex[szPath]];
+                double dMinimumDistance(dInfinity);
+                CPathInformation pthiPathInformationMin; // save the min path parameters here
+                for (auto& visibleVertex : vvvisEndVisible[vszEndIndex[szPath]])
+                {
+                    if (vdStartToBase[static_cast<size_t> (visibleVertex.first)] < dInfinity)
+                    {
+                        double dDistanceCandidate = vdStartToBase[static_cast<size_t> (visibleVertex.first)] + static_cast<double> (visibleVertex.second);
+                        if (dDistanceCandidate < dMinimumDistance)
+                        {
+                            dMinimumDistance = dDistanceCandidate;
+                            pthiPathInformationMin.iGetIndexBaseBegin() = vvi32StartExit[vszStartIndex[szPath]][static_cast<size_t> (visibleVertex.first)];
+                            pthiPathInformationMin.iGetIndexBaseEnd() = visibleVertex.first;
+                            pthiPathInformationMin.iGetLength() = static_cast<int> (dDistanceCandidate);
+                            pthiPathInformationMin.posGetStart() = posStart;
+                            pthiPathInformationMin.posGetEnd() = posEnd;
+                        }
+                    }
+                }
+                pathInformation = pthiPathInformationMin;
+            }
+        });
+
+        return (isSuccessful);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////        
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////    
+
 #ifdef STEVETEST
     CVisibilityGraph::enError CVisibilityGraph::errAddVehicleObjectives(const int& iVehicleID, const CPosition& posVehiclePosition,
             M_PTR_I_OBJECTIVE_PARAMETERS_BASE_t& m_ptr_i_opGetObjectivesParameters,
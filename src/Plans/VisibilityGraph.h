@@ -52,6 +52,9 @@ using std::ostream;
 using std::complex;
 
 #include <memory>       //std::shared_ptr
+#include <functional>   //std::function
+#include <vector>
+#include <algorithm>    //min, max
 
 namespace n_FrameworkLib
 {
@@ -100,6 +103,10 @@ namespace n_FrameworkLib
         typedef std::shared_ptr<uxas::messages::route::GraphRegion> PTR_GRAPH_REGION_t;
         typedef std::map<uint32_t, PTR_GRAPH_REGION_t> M_UI32_PTR_GRAPH_REGION_t;
         typedef std::map<uint32_t, PTR_GRAPH_REGION_t>::iterator M_UI32_PTR_GRAPH_REGION_IT_t;
+        // executes body(index) for every index in [0, count), e.g., on a thread pool
+        typedef std::function<void(size_t, const std::function<void(size_t)>&)> PARALLEL_FOR_t;
+        // base vertex index and distance (m) of the base vertices visible from a position
+        typedef std::vector<std::pair<int32_t, int32_t> > V_VISIBLE_VERTEX_t;
 
 
 
@@ -146,11 +153,19 @@ namespace n_FrameworkLib
     public: //methods/functions
         enError errExpandAndMergePolygons(void);
         enError errBuildVisibilityGraph(void);
+        // rebuild after the polygons changed (errFinalizePolygons), reusing the visibility between the polygons
+        // that are unchanged from cvgPrevious; gives the same edges as errBuildVisibilityGraph(void)
+        enError errBuildVisibilityGraph(const CVisibilityGraph& cvgPrevious);
         enError errBuildVisibilityGraph(PTR_GRAPH_REGION_t& ptr_GraphRegion);
         enError errBuildVisibilityGraphWithOsm(const string& osmFile);
         
 
         bool isFindPath(std::shared_ptr<CPathInformation>& pathInformation);
+        // one-to-many version of isFindPath for cost matrices: the visibility of each distinct
+        // start/end position is computed once, and each distinct start takes a single pass over
+        // the base graph distances (rather than one search per start/end pair)
+        bool isFindPaths(std::vector<std::shared_ptr<CPathInformation> >& vpathInformation,
+                const PARALLEL_FOR_t& parallelFor = PARALLEL_FOR_t());
 #ifdef STEVETEST
         enError errAddVehicleObjectives(const int& iVehicleID, const CPosition& posVehiclePosition, M_PTR_I_OBJECTIVE_PARAMETERS_BASE_t& ptr_miopObjectives,
                 PTR_M_INT_PTR_M_INT_PATHINFORMATION_t& mipmipthDistanceBasedOnLineSegments, const bool& bPlanToClosestEdge = false);
@@ -199,6 +214,37 @@ namespace n_FrameworkLib
 
         bool bFindIntersection(const V_POSITION_t&vposVerticiesBase, V_POLYGON_t& vPolygons, const CPosition& posPositionA, const CPosition& posPositionB,
                 const int32_t& i32IndexA = -1, const int32_t& i32IndexB = -1);
+    protected: //methods/functions
+        // steps of errBuildVisibilityGraph shared by the full and the incremental builds
+        enError errInitializeEdgesVisibleBase();
+        enError errAddExtraEdgesVisibleBase();
+
+        static uint64_t uiGetVertexPairKey(const int32_t& iVertex1, const int32_t& iVertex2) {
+            return ((static_cast<uint64_t> (static_cast<uint32_t> (std::min(iVertex1, iVertex2))) << 32) | static_cast<uint32_t> (std::max(iVertex1, iVertex2)));
+        };
+
+        // padded, since the bounding boxes are only used to skip the exact intersection checks
+        static void FindBoundingBox(const V_POSITION_t& vposVerticies, const CPolygon& plygnPolygon, CPosition& posMinimum, CPosition& posMaximum) {
+            const double dPadding_m(1.0e-3);
+            posMinimum = vposVerticies[plygnPolygon.viGetVerticies().front()];
+            posMaximum = posMinimum;
+            for (auto itVertex = plygnPolygon.viGetVerticies().begin(); itVertex != plygnPolygon.viGetVerticies().end(); itVertex++) {
+                posMinimum.m_north_m = std::min(posMinimum.m_north_m, vposVerticies[*itVertex].m_north_m);
+                posMinimum.m_east_m = std::min(posMinimum.m_east_m, vposVerticies[*itVertex].m_east_m);
+                posMaximum.m_north_m = std::max(posMaximum.m_north_m, vposVerticies[*itVertex].m_north_m);
+                posMaximum.m_east_m = std::max(posMaximum.m_east_m, vposVerticies[*itVertex].m_east_m);
+            }
+            posMinimum.m_north_m -= dPadding_m;
+            posMinimum.m_east_m -= dPadding_m;
+            posMaximum.m_north_m += dPadding_m;
+            posMaximum.m_east_m += dPadding_m;
+        };
+
+        static bool bSegmentInBoundingBox(const CPosition& posA, const CPosition& posB, const CPosition& posMinimum, const CPosition& posMaximum) {
+            return ((std::max(posA.m_north_m, posB.m_north_m) >= posMinimum.m_north_m) && (std::min(posA.m_north_m, posB.m_north_m) <= posMaximum.m_north_m)
+                    && (std::max(posA.m_east_m, posB.m_east_m) >= posMinimum.m_east_m) && (std::min(posA.m_east_m, posB.m_east_m) <= posMaximum.m_east_m));
+        };
+
     public: //inline methods/functions
 
         enError errGetDistance(const int& iFromID, const int& iToID, double& dDistance,
@@ -64,6 +64,7 @@
 
 // data
 #include "MessageLoggerDataService.h"
+#include "MessageReplayService.h"
 #include "AutomationDiagramDataService.h"
 #ifdef AFRL_INTERNAL_ENABLED
 #include "VicsLoggerDataService.h"
@@ -114,6 +115,7 @@
 #include "SteeringService.h"
 
 // DO NOT REMOVE - USED TO AUTOMATICALLY ADD NEW SERVICE HEADERS
+#include "MessageStatisticsService.h"
 #include "StatusReportService.h"
 #include "LoiterLeash.h"
 
@@ -143,6 +145,7 @@
 
 // data
 {auto svc = uxas::stduxas::make_unique<uxas::service::data::MessageLoggerDataService>();}
+{auto svc = uxas::stduxas::make_unique<uxas::service::data::MessageReplayService>();}
 {auto svc = uxas::stduxas::make_unique<uxas::service::data::AutomationDiagramDataService>();}
 
 // task
@@ -190,6 +193,7 @@
 {auto svc = uxas::stduxas::make_unique<uxas::service::SteeringService>();}
 
 // DO NOT REMOVE - USED TO AUTOMATICALLY ADD NEW SERVICE DUMMY INSTANCES
+{auto svc = uxas::stduxas::make_unique<uxas::service::MessageStatisticsService>();}
 {auto svc = uxas::stduxas::make_unique<uxas::service::StatusReportService>();}
 {auto svc = uxas::stduxas::make_unique<uxas::service::LoiterLeash>();}
 
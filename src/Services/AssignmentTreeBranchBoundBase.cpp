@@ -18,6 +18,7 @@
 #include "AssignmentTreeBranchBoundBase.h"
 
 #include "TimeUtilities.h"
+#include "stdUniquePtr.h"
 #include "Constants/Constant_Strings.h"
 
 #include "afrl/cmasi/ServiceStatus.h"
@@ -35,6 +36,10 @@
 #include <cstdint>      //int64_t
 #include <memory>       // make_unique
 #include <set>       // set
+#include <algorithm>    // lexicographical_compare, stable_sort
+#include <iterator>     // distance
+#include <chrono>
+#include <thread>
 
 
 #define STRING_COMPONENT_NAME "AssignmentTreeBB"
@@ -46,6 +51,10 @@
 
 #define STRING_XML_NUMBER_NODES_MAXIMUM "NumberNodesMaximum"
 #define STRING_XML_COST_FUNCTION "CostFunction"
+#define STRING_XML_ASSIGNMENT_THREAD_COUNT "AssignmentThreadCount"
+#define STRING_XML_ASSIGNMENT_DEADLINE_MS "AssignmentDeadline_ms"
+#define STRING_XML_PUBLISH_PROVISIONAL_ASSIGNMENTS "PublishProvisionalAssignments"
+#define STRING_XML_WARM_START_ASSIGNMENT "WarmStartAssignment"
 
 #define COUT_INFO_MSG(MESSAGE) std::cout << MESSAGE << std::endl;std::cout.flush();
 #define COUT_FILE_LINE_MSG(MESSAGE) std::cout << "<>AssignmentTreeBB:" << __FILE__ << ":" << __LINE__ << ":" << MESSAGE << std::endl;std::cout.flush();
@@ -58,15 +67,117 @@ namespace service
 {
 
 
-bool c_Node_Base::m_isFinalAssignmentCalculated = false;
 #ifdef AFRL_INTERNAL_ENABLED
 uxas::project::pisr::AssignmentType::AssignmentType c_Node_Base::m_assignmentType{uxas::project::pisr::AssignmentType::MinMaxTime};
 #endif
 
+namespace
+{
+
+/** \brief Collects groups of actions from the algebra's parse tree, at least
+ * one action of each group is executed in every complete assignment.
+ * Sequential and parallel operators require the groups of all of their
+ * children. An alternative operator requires one of its children, i.e. at
+ * least one of all of its children's required actions. */
+void findRequiredActionGroups(uxas::common::utilities::parseTreeNode* node, std::vector<std::vector<int64_t> >& groups)
+{
+    if (node == nullptr)
+    {
+        return;
+    }
+    if (node->getNodeType() == uxas::common::utilities::ND_ACTION)
+    {
+        groups.push_back(std::vector<int64_t>(1, static_cast<uxas::common::utilities::actionNode*>(node)->getActionID()));
+        return;
+    }
+    if (node->getNodeType() != uxas::common::utilities::ND_OPERATOR)
+    {
+        return;
+    }
+    auto operatorNode = static_cast<uxas::common::utilities::operatorNode*>(node);
+    if (operatorNode->getOperatorType() == uxas::common::utilities::OP_ALTERNATIVE)
+    {
+        std::vector<int64_t> alternativeGroup;
+        for (int iNode = 0; iNode < operatorNode->getNumNodes(); iNode++)
+        {
+            std::vector<std::vector<int64_t> > childGroups;
+            findRequiredActionGroups(operatorNode->getNodePointer(iNode), childGroups);
+            if (childGroups.empty())
+            {
+                // this alternative requires nothing
+                return;
+            }
+            for (auto itGroup = childGroups.begin(); itGroup != childGroups.end(); itGroup++)
+            {
+                alternativeGroup.insert(alternativeGroup.end(), itGroup->begin(), itGroup->end());
+            }
+        }
+        if (!alternativeGroup.empty())
+        {
+            groups.push_back(alternativeGroup);
+        }
+    }
+    else if ((operatorNode->getOperatorType() == uxas::common::utilities::OP_SEQUENTIAL) ||
+            (operatorNode->getOperatorType() == uxas::common::utilities::OP_PARALLEL))
+    {
+        for (int iNode = 0; iNode < operatorNode->getNumNodes(); iNode++)
+        {
+            findRequiredActionGroups(operatorNode->getNodePointer(iNode), groups);
+        }
+    }
+}
+
+/** \brief Allocates the nodes created on the calling thread from an arena, until
+ * the scope ends. */
+class NodeArenaScope
+{
+public:
+    explicit NodeArenaScope(c_NodeArena* arena)
+    : m_previousArena(c_NodeArena::threadArena())
+    {
+        c_NodeArena::threadArena() = arena;
+    };
+
+    ~NodeArenaScope()
+    {
+        c_NodeArena::threadArena() = m_previousArena;
+    };
+
+private:
+    NodeArenaScope(const NodeArenaScope&) = delete;
+    NodeArenaScope& operator=(const NodeArenaScope&) = delete;
+
+    c_NodeArena* m_previousArena;
+};
+
+/** \brief Each node allocation starts with a header that records its arena. */
+const size_t c_nodeHeaderSize{16};
+
+/** \brief Scratch buffers of the calling thread's arena. Searches always expand nodes
+ * within an arena scope, other threads get their own buffers. */
+c_SearchScratch& getThreadScratch()
+{
+    c_NodeArena* arena = c_NodeArena::threadArena();
+    if (arena != nullptr)
+    {
+        return (arena->m_scratch);
+    }
+    static thread_local c_SearchScratch s_scratch;
+    return (s_scratch);
+}
+
+} //namespace
+
 AssignmentTreeBranchBoundBase::AssignmentTreeBranchBoundBase(const std::string& serviceType, const std::string& workDirectoryName)
 : ServiceBase(serviceType, workDirectoryName) { };
 
-AssignmentTreeBranchBoundBase::~AssignmentTreeBranchBoundBase() { };
+AssignmentTreeBranchBoundBase::~AssignmentTreeBranchBoundBase()
+{
+    if (m_assignmentThreadPool)
+    {
+        m_assignmentThreadPool->shutdown();
+    }
+};
 
 bool AssignmentTreeBranchBoundBase::start()
 {
@@ -75,6 +186,10 @@ bool AssignmentTreeBranchBoundBase::start()
 
 bool AssignmentTreeBranchBoundBase::terminate()
 {
+    if (m_assignmentThreadPool)
+    {
+        m_assignmentThreadPool->shutdown();
+    }
     return (isTerminateAssignment());
 }
 
@@ -113,6 +228,35 @@ AssignmentTreeBranchBoundBase::configure(const pugi::xml_node& ndComponent)
         }
     }
 
+    if (!ndComponent.attribute(STRING_XML_ASSIGNMENT_DEADLINE_MS).empty())
+    {
+        m_assignmentDeadline_ms = ndComponent.attribute(STRING_XML_ASSIGNMENT_DEADLINE_MS).as_int64();
+    }
+
+    if (!ndComponent.attribute(STRING_XML_PUBLISH_PROVISIONAL_ASSIGNMENTS).empty())
+    {
+        m_isPublishingProvisionalAssignments = ndComponent.attribute(STRING_XML_PUBLISH_PROVISIONAL_ASSIGNMENTS).as_bool();
+    }
+
+    if (!ndComponent.attribute(STRING_XML_WARM_START_ASSIGNMENT).empty())
+    {
+        m_isWarmStartAssignment = ndComponent.attribute(STRING_XML_WARM_START_ASSIGNMENT).as_bool();
+    }
+
+    if (!ndComponent.attribute(STRING_XML_ASSIGNMENT_THREAD_COUNT).empty())
+    {
+        m_assignmentThreadCount = ndComponent.attribute(STRING_XML_ASSIGNMENT_THREAD_COUNT).as_uint();
+        if (m_assignmentThreadCount == 0)
+        {
+            m_assignmentThreadCount = uxas::common::ThreadPool::getHardwareThreadCount();
+        }
+        UXAS_LOG_INFORM(s_typeName(), "::configure set assignment thread count to ", m_assignmentThreadCount, " from XML");
+    }
+    if (m_assignmentThreadCount > 1)
+    {
+        m_assignmentThreadPool = uxas::stduxas::make_unique<uxas::common::ThreadPool>(m_assignmentThreadCount);
+    }
+
     addSubscriptionAddress(uxas::messages::task::UniqueAutomationRequest::Subscription);
     addSubscriptionAddress(uxas::messages::task::TaskPlanOptions::Subscription);
     addSubscriptionAddress(uxas::messages::task::AssignmentCostMatrix::Subscription);
@@ -198,7 +342,7 @@ AssignmentTreeBranchBoundBase::processReceivedLmcpMessage(std::unique_ptr<uxas::
     if (assigmentPrerequisites)
     {
         runCalculateAssignment(assigmentPrerequisites);
-        c_Node_Base::m_staticAssignmentParameters.reset(new c_StaticAssignmentParameters);
+        m_staticAssignmentParameters.reset();
     }
 
     processReceivedLmcpMessageAssignment(std::move(receivedLmcpMessage));
@@ -463,7 +607,7 @@ bool AssignmentTreeBranchBoundBase::isInitializeAlgebra(const std::shared_ptr<As
 
         if (!algebraString.empty())
         {
-            if (!c_Node_Base::m_staticAssignmentParameters->algebra.initAtomicObjectives(taskIds))
+            if (!m_staticAssignmentParameters->algebra.initAtomicObjectives(taskIds))
             {
                 //sstreamErrors << "Error:: error encountered while initializing algebra objectives.]\n";
                 //errReturn = static_cast<enReturnErrorAssignment> (errReturn | eassignFailed);
@@ -471,7 +615,7 @@ bool AssignmentTreeBranchBoundBase::isInitializeAlgebra(const std::shared_ptr<As
                 sendErrorMsg(errStr);
                 isSuccess = false;
             }
-            else if (!c_Node_Base::m_staticAssignmentParameters->algebra.initAlgebraString(algebraString))
+            else if (!m_staticAssignmentParameters->algebra.initAlgebraString(algebraString))
             {
                 //sstreamErrors << "Error:: error encountered while parsing the algebra string:\n [" << algebraString << "]\n";
                 //errReturn = static_cast<enReturnErrorAssignment> (errReturn | eassignFailed);
@@ -495,80 +639,12 @@ void AssignmentTreeBranchBoundBase::runCalculateAssignment(const std::shared_ptr
 void AssignmentTreeBranchBoundBase::calculateAssignment(std::unique_ptr<c_Node_Base> nodeAssignment,
                                                         const std::shared_ptr<AssigmentPrerequisites>& assigmentPrerequisites)
 {
-    bool isError(false);
-
     /////////////////////////////////////////////////////////
     //construct the inputs for the assignment algorithm
     /////////////////////////////////////////////////////////
-
-    // re-initialize static storage/parameters
-    nodeAssignment->m_staticAssignmentParameters.reset(new c_StaticAssignmentParameters);
-    nodeAssignment->m_staticAssignmentParameters->m_CostFunction = m_CostFunction;
-    nodeAssignment->m_staticAssignmentParameters->m_numberNodesMaximum = m_numberNodesMaximum;
-#ifdef AFRL_INTERNAL_ENABLED
-    nodeAssignment->m_assignmentType = assigmentPrerequisites->m_assignmentType;
-#endif
-    nodeAssignment->m_isFinalAssignmentCalculated = false;
-
-    // ALGEBRA:: Initialization
-    isError = !isInitializeAlgebra(assigmentPrerequisites);
-
-    if (!isError)
+    if (isInitializeAssignment(*nodeAssignment, assigmentPrerequisites))
     {
-        for (auto itOptions = assigmentPrerequisites->m_taskIdVsTaskPlanOptions.begin(); itOptions != assigmentPrerequisites->m_taskIdVsTaskPlanOptions.end(); itOptions++)
-        {
-            for (auto itOption = itOptions->second->getOptions().begin(); itOption != itOptions->second->getOptions().end(); itOption++)
-            {
-                int64_t taskOptionId = c_TaskAssignmentState::getTaskAndOptionId((*itOption)->getTaskID(), (*itOption)->getOptionID());
-                if (nodeAssignment->m_staticAssignmentParameters->m_taskOptionIdVsInformation.find(taskOptionId) == nodeAssignment->m_staticAssignmentParameters->m_taskOptionIdVsInformation.end())
-                {
-                    nodeAssignment->m_staticAssignmentParameters->m_taskOptionIdVsInformation[taskOptionId] = std::unique_ptr<c_TaskInformationStatic>(new c_TaskInformationStatic());
-                }
-                for (auto itObjVehicle = (*itOption)->getEligibleEntities().begin(); itObjVehicle != (*itOption)->getEligibleEntities().end(); itObjVehicle++)
-                {
-                    nodeAssignment->m_staticAssignmentParameters->m_taskOptionIdVsInformation[taskOptionId]->m_VehicleIdVsTaskTravelTime[*itObjVehicle] = (*itOption)->getCost();
-                }
-            }
-        }
-
-        for (auto itTaskOptionCost = assigmentPrerequisites->m_assignmentCostMatrix->getCostMatrix().begin();
-                itTaskOptionCost != assigmentPrerequisites->m_assignmentCostMatrix->getCostMatrix().end();
-                itTaskOptionCost++)
-        {
-            auto vehicleId = (*itTaskOptionCost)->getVehicleID();
-            auto fromId = c_TaskAssignmentState::getTaskAndOptionId((*itTaskOptionCost)->getIntialTaskID(), (*itTaskOptionCost)->getIntialTaskOption());
-            fromId = (fromId == 0) ? (vehicleId) : (fromId);
-            auto toId = c_TaskAssignmentState::getTaskAndOptionId((*itTaskOptionCost)->getDestinationTaskID(), (*itTaskOptionCost)->getDestinationTaskOption());
-            auto travelCost = (*itTaskOptionCost)->getTimeToGo();
-
-            // instantiate new vehicle assignment classes if necessary
-            if (nodeAssignment->m_vehicleIdVsAssignmentState.find(vehicleId) == nodeAssignment->m_vehicleIdVsAssignmentState.end())
-            {
-                nodeAssignment->m_vehicleIdVsAssignmentState[vehicleId] = std::unique_ptr<c_VehicleAssignmentState>(new c_VehicleAssignmentState(vehicleId));
-            }
-            if (nodeAssignment->m_staticAssignmentParameters->m_vehicleIdVsInformation.find(vehicleId) == nodeAssignment->m_staticAssignmentParameters->m_vehicleIdVsInformation.end())
-            {
-                nodeAssignment->m_staticAssignmentParameters->m_vehicleIdVsInformation[vehicleId] = std::unique_ptr<c_VehicleInformationStatic>(new c_VehicleInformationStatic(vehicleId));
-            }
-            if (nodeAssignment->m_staticAssignmentParameters->m_vehicleIdVsInformation[vehicleId]->m_FromIdVsToIdVsTravelTime.find(fromId) == nodeAssignment->m_staticAssignmentParameters->m_vehicleIdVsInformation[vehicleId]->m_FromIdVsToIdVsTravelTime.end())
-            {
-                nodeAssignment->m_staticAssignmentParameters->m_vehicleIdVsInformation[vehicleId]->m_FromIdVsToIdVsTravelTime[fromId] = std::unique_ptr<std::unordered_map<int64_t, int64_t >> (new std::unordered_map<int64_t, int64_t>);
-            }
-            nodeAssignment->m_staticAssignmentParameters->m_vehicleIdVsInformation[vehicleId]->m_FromIdVsToIdVsTravelTime[fromId]->operator[](toId) = travelCost;
-        }
-
-        //TODO:: need to calculate "m_maximumVehicleCost" for the c_VehicleCostsStatic's map
-
-
-        /////////////////////////////////////////////////////////
-        /////////  RUN THE ASSIGNMENT ALGORITHM
-        /////////////////////////////////////////////////////////
-        /////////////////////////////////////////////////////////////////////////////////////////////////////////
-        // use errRunAllocation to run the allocation algorithm. 
-        //  Note: (1)load Objectives and vehicles (2) run allocation algorithm (3)  the function GetWaypoints_m or GetWaypoints_LatLong_rad to return the results
-        /////////////////////////////////////////////////////////////////////////////////////////////////////////
-        nodeAssignment->m_staticAssignmentParameters->m_assignmentStartTime_ms = uxas::common::utilities::c_TimeUtilities::getTimeNow_ms();
-        nodeAssignment->ExpandNode();
+        searchAssignment(*nodeAssignment, assigmentPrerequisites);
         nodeAssignment->printStatus("INFO::FINAL:  ");
 
         if (nodeAssignment->m_staticAssignmentParameters->m_numberCompleteAssignments <= 0)
@@ -589,6 +665,10 @@ void AssignmentTreeBranchBoundBase::calculateAssignment(std::unique_ptr<c_Node_B
             serviceStatus->setStatusType(afrl::cmasi::ServiceStatusType::Information);
             auto keyValuePair = new afrl::cmasi::KeyValuePair;
             keyValuePair->setKey(std::string("AssignmentComplete"));
+            if (nodeAssignment->m_staticAssignmentParameters->m_isDeadlineReached)
+            {
+                keyValuePair->setValue(std::string("DeadlineReached"));
+            }
             serviceStatus->getInfo().push_back(keyValuePair);
             keyValuePair = nullptr;
             sendSharedLmcpObjectBroadcastMessage(serviceStatus);
@@ -600,22 +680,8 @@ void AssignmentTreeBranchBoundBase::calculateAssignment(std::unique_ptr<c_Node_B
         /////////////////////////////////////////////////////////
         if (!nodeAssignment->m_staticAssignmentParameters->m_candidateVehicleIdVsAssignmentState.empty())
         {
-            auto taskAssignmentSummary = std::make_shared<uxas::messages::task::TaskAssignmentSummary>();
-
-            taskAssignmentSummary->setOperatingRegion(assigmentPrerequisites->m_uniqueAutomationRequest->getOriginalRequest()->getOperatingRegion());
-            taskAssignmentSummary->setCorrespondingAutomationRequestID(assigmentPrerequisites->m_uniqueAutomationRequest->getRequestID());
-
-            for (auto itVehicleAssignments = nodeAssignment->m_staticAssignmentParameters->m_candidateVehicleIdVsAssignmentState.begin();
-                    itVehicleAssignments != nodeAssignment->m_staticAssignmentParameters->m_candidateVehicleIdVsAssignmentState.end();
-                    itVehicleAssignments++)
-            {
-                for (auto itTaskAssignment = itVehicleAssignments->second->m_taskAssignments.begin();
-                        itTaskAssignment != itVehicleAssignments->second->m_taskAssignments.end();
-                        itTaskAssignment++)
-                {
-                    taskAssignmentSummary->getTaskList().push_back((*itTaskAssignment)->clone());
-                }
-            }
+            auto taskAssignmentSummary = getCandidateAssignmentSummary(assigmentPrerequisites);
+            setWarmStartAssignment(taskAssignmentSummary);
             auto newMessage = std::static_pointer_cast<avtas::lmcp::Object>(taskAssignmentSummary);
             sendSharedLmcpObjectBroadcastMessage(newMessage);
             UXAS_LOG_INFORM("ASSIGNMENT COMPLETE!");
@@ -627,28 +693,286 @@ void AssignmentTreeBranchBoundBase::calculateAssignment(std::unique_ptr<c_Node_B
             sendErrorMsg(errMsg);
         }    
 
-    } //if(!isError)
-    nodeAssignment.reset();
+    } //if(isInitializeAssignment(*nodeAssignment, assigmentPrerequisites))
+    releaseAssignmentNodes(std::move(nodeAssignment));
 } //void AssignmentTreeBranchBoundBase::CalculateAssignment()
 
+bool AssignmentTreeBranchBoundBase::isInitializeAssignment(c_Node_Base& nodeAssignment, const std::shared_ptr<AssigmentPrerequisites>& assigmentPrerequisites)
+{
+    // parameters of this search, the trunk's children inherit them
+    m_staticAssignmentParameters.reset(new c_StaticAssignmentParameters);
+    nodeAssignment.m_staticAssignmentParameters = m_staticAssignmentParameters.get();
+    nodeAssignment.m_staticAssignmentParameters->m_numberNodesVisited++; // the trunk
+    nodeAssignment.m_staticAssignmentParameters->m_CostFunction = m_CostFunction;
+    nodeAssignment.m_staticAssignmentParameters->m_numberNodesMaximum = m_numberNodesMaximum;
+#ifdef AFRL_INTERNAL_ENABLED
+    nodeAssignment.m_assignmentType = assigmentPrerequisites->m_assignmentType;
+#endif
+
+    // ALGEBRA:: Initialization
+    if (!isInitializeAlgebra(assigmentPrerequisites))
+    {
+        return (false);
+    }
+
+    for (auto itOptions = assigmentPrerequisites->m_taskIdVsTaskPlanOptions.begin(); itOptions != assigmentPrerequisites->m_taskIdVsTaskPlanOptions.end(); itOptions++)
+    {
+        for (auto itOption = itOptions->second->getOptions().begin(); itOption != itOptions->second->getOptions().end(); itOption++)
+        {
+            int64_t taskOptionId = c_TaskAssignmentState::getTaskAndOptionId((*itOption)->getTaskID(), (*itOption)->getOptionID());
+            if (nodeAssignment.m_staticAssignmentParameters->m_taskOptionIdVsInformation.find(taskOptionId) == nodeAssignment.m_staticAssignmentParameters->m_taskOptionIdVsInformation.end())
+            {
+                nodeAssignment.m_staticAssignmentParameters->m_taskOptionIdVsInformation[taskOptionId] = std::unique_ptr<c_TaskInformationStatic>(new c_TaskInformationStatic());
+            }
+            for (auto itObjVehicle = (*itOption)->getEligibleEntities().begin(); itObjVehicle != (*itOption)->getEligibleEntities().end(); itObjVehicle++)
+            {
+                nodeAssignment.m_staticAssignmentParameters->m_taskOptionIdVsInformation[taskOptionId]->m_VehicleIdVsTaskTravelTime[*itObjVehicle] = (*itOption)->getCost();
+            }
+        }
+    }
+
+    // dense task option indices, in task option ID order
+    std::vector<int64_t> taskOptionIds;
+    for (auto itTaskOptionInformation = nodeAssignment.m_staticAssignmentParameters->m_taskOptionIdVsInformation.begin();
+            itTaskOptionInformation != nodeAssignment.m_staticAssignmentParameters->m_taskOptionIdVsInformation.end();
+            itTaskOptionInformation++)
+    {
+        taskOptionIds.push_back(itTaskOptionInformation->first);
+    }
+    std::sort(taskOptionIds.begin(), taskOptionIds.end());
+    for (size_t taskOptionIndex = 0; taskOptionIndex < taskOptionIds.size(); taskOptionIndex++)
+    {
+        nodeAssignment.m_staticAssignmentParameters->m_taskOptionIdVsInformation[taskOptionIds[taskOptionIndex]]->m_taskOptionIndex = taskOptionIndex;
+    }
+
+    // compile the cost matrix into a travel time table for each vehicle
+    for (auto itTaskOptionCost = assigmentPrerequisites->m_assignmentCostMatrix->getCostMatrix().begin();
+            itTaskOptionCost != assigmentPrerequisites->m_assignmentCostMatrix->getCostMatrix().end();
+            itTaskOptionCost++)
+    {
+        auto vehicleId = (*itTaskOptionCost)->getVehicleID();
+        auto fromId = c_TaskAssignmentState::getTaskAndOptionId((*itTaskOptionCost)->getIntialTaskID(), (*itTaskOptionCost)->getIntialTaskOption());
+        auto toId = c_TaskAssignmentState::getTaskAndOptionId((*itTaskOptionCost)->getDestinationTaskID(), (*itTaskOptionCost)->getDestinationTaskOption());
+        auto travelCost = (*itTaskOptionCost)->getTimeToGo();
+
+        // instantiate new vehicle assignment classes if necessary
+        if (nodeAssignment.m_vehicleIdVsAssignmentState.find(vehicleId) == nodeAssignment.m_vehicleIdVsAssignmentState.end())
+        {
+            nodeAssignment.m_vehicleIdVsAssignmentState[vehicleId] = std::unique_ptr<c_VehicleAssignmentState>(new c_VehicleAssignmentState(vehicleId));
+        }
+        auto itVehicleInformation = nodeAssignment.m_staticAssignmentParameters->m_vehicleIdVsInformation.find(vehicleId);
+        if (itVehicleInformation == nodeAssignment.m_staticAssignmentParameters->m_vehicleIdVsInformation.end())
+        {
+            itVehicleInformation = nodeAssignment.m_staticAssignmentParameters->m_vehicleIdVsInformation.insert(
+                    std::make_pair(vehicleId, std::unique_ptr<c_VehicleInformationStatic>(new c_VehicleInformationStatic(vehicleId)))).first;
+            itVehicleInformation->second->initializeTravelTimes(taskOptionIds.size());
+            itVehicleInformation->second->m_vehicleIndex = nodeAssignment.m_staticAssignmentParameters->m_vehicleIds.size();
+            nodeAssignment.m_staticAssignmentParameters->m_vehicleIds.push_back(vehicleId);
+        }
+
+        // costs to/from task options that are not in the task plan options can never be used
+        auto itToInformation = nodeAssignment.m_staticAssignmentParameters->m_taskOptionIdVsInformation.find(toId);
+        if (itToInformation == nodeAssignment.m_staticAssignmentParameters->m_taskOptionIdVsInformation.end())
+        {
+            continue;
+        }
+        size_t fromLocationIndex(0); // fromId == 0 -> vehicle's starting location
+        if (fromId != 0)
+        {
+            auto itFromInformation = nodeAssignment.m_staticAssignmentParameters->m_taskOptionIdVsInformation.find(fromId);
+            if (itFromInformation == nodeAssignment.m_staticAssignmentParameters->m_taskOptionIdVsInformation.end())
+            {
+                continue;
+            }
+            fromLocationIndex = itFromInformation->second->m_taskOptionIndex + 1;
+        }
+        itVehicleInformation->second->setTravelTime_ms(fromLocationIndex, itToInformation->second->m_taskOptionIndex, travelCost);
+    }
+
+    for (auto itVehicleInformation = nodeAssignment.m_staticAssignmentParameters->m_vehicleIdVsInformation.begin();
+            itVehicleInformation != nodeAssignment.m_staticAssignmentParameters->m_vehicleIdVsInformation.end();
+            itVehicleInformation++)
+    {
+        for (size_t taskOptionIndex = 0; taskOptionIndex < taskOptionIds.size(); taskOptionIndex++)
+        {
+            itVehicleInformation->second->m_taskTime_ms[taskOptionIndex] =
+                    nodeAssignment.m_staticAssignmentParameters->m_taskOptionIdVsInformation[taskOptionIds[taskOptionIndex]]->getTravelTime_ms(itVehicleInformation->first);
+        }
+        itVehicleInformation->second->calculateLowerBounds();
+    }
+
+    // task options required by the algebra, for lower bounds
+    if (nodeAssignment.m_staticAssignmentParameters->algebra.parseTreeRoot != nullptr)
+    {
+        std::vector<std::vector<int64_t> > requiredTaskOptionIdGroups;
+        findRequiredActionGroups(nodeAssignment.m_staticAssignmentParameters->algebra.parseTreeRoot, requiredTaskOptionIdGroups);
+        for (auto itGroup = requiredTaskOptionIdGroups.begin(); itGroup != requiredTaskOptionIdGroups.end(); itGroup++)
+        {
+            std::vector<size_t> taskOptionIndexGroup;
+            for (auto itTaskOptionId = itGroup->begin(); itTaskOptionId != itGroup->end(); itTaskOptionId++)
+            {
+                auto itTaskOptionInformation = nodeAssignment.m_staticAssignmentParameters->m_taskOptionIdVsInformation.find(*itTaskOptionId);
+                if (itTaskOptionInformation == nodeAssignment.m_staticAssignmentParameters->m_taskOptionIdVsInformation.end())
+                {
+                    // can not bound a group with unknown task options
+                    taskOptionIndexGroup.clear();
+                    break;
+                }
+                taskOptionIndexGroup.push_back(itTaskOptionInformation->second->m_taskOptionIndex);
+            }
+            if (!taskOptionIndexGroup.empty())
+            {
+                nodeAssignment.m_staticAssignmentParameters->m_requiredTaskOptionIndexGroups.push_back(taskOptionIndexGroup);
+            }
+        }
+    }
+
+    // the previous assignment, without the task options and vehicles that are no longer part of the assignment
+    if (m_isWarmStartAssignment && !m_previousVehicleIdVsTaskOptionIds.empty())
+    {
+        auto& warmStartTaskOptionIndices = nodeAssignment.m_staticAssignmentParameters->m_warmStartTaskOptionIndices;
+        warmStartTaskOptionIndices.resize(nodeAssignment.m_staticAssignmentParameters->m_vehicleIds.size());
+        for (auto itPrevious = m_previousVehicleIdVsTaskOptionIds.begin(); itPrevious != m_previousVehicleIdVsTaskOptionIds.end(); itPrevious++)
+        {
+            auto itVehicleInformation = nodeAssignment.m_staticAssignmentParameters->m_vehicleIdVsInformation.find(itPrevious->first);
+            if (itVehicleInformation == nodeAssignment.m_staticAssignmentParameters->m_vehicleIdVsInformation.end())
+            {
+                continue;
+            }
+            for (auto itTaskOptionId = itPrevious->second.begin(); itTaskOptionId != itPrevious->second.end(); itTaskOptionId++)
+            {
+                auto itTaskOptionInformation = nodeAssignment.m_staticAssignmentParameters->m_taskOptionIdVsInformation.find(*itTaskOptionId);
+                if (itTaskOptionInformation != nodeAssignment.m_staticAssignmentParameters->m_taskOptionIdVsInformation.end())
+                {
+                    warmStartTaskOptionIndices[itVehicleInformation->second->m_vehicleIndex].push_back(itTaskOptionInformation->second->m_taskOptionIndex);
+                }
+            }
+        }
+    }
+
+    //TODO:: need to calculate "m_maximumVehicleCost" for the c_VehicleCostsStatic's map
+
+    return (true);
+}
+
+void AssignmentTreeBranchBoundBase::searchAssignment(c_Node_Base& nodeAssignment, const std::shared_ptr<AssigmentPrerequisites>& assigmentPrerequisites)
+{
+    /////////////////////////////////////////////////////////
+    /////////  RUN THE ASSIGNMENT ALGORITHM
+    /////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // use errRunAllocation to run the allocation algorithm. 
+    //  Note: (1)load Objectives and vehicles (2) run allocation algorithm (3)  the function GetWaypoints_m or GetWaypoints_LatLong_rad to return the results
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    nodeAssignment.m_staticAssignmentParameters->m_assignmentStartTime_ms = uxas::common::utilities::c_TimeUtilities::getTimeNow_ms();
+    if (m_assignmentDeadline_ms >= 0)
+    {
+        nodeAssignment.m_staticAssignmentParameters->m_isDeadline = true;
+        nodeAssignment.m_staticAssignmentParameters->m_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_assignmentDeadline_ms);
+    }
+    if (m_isPublishingProvisionalAssignments)
+    {
+        // sent from this thread only, like all other messages of this service
+        nodeAssignment.m_staticAssignmentParameters->m_publishingThreadId = std::this_thread::get_id();
+        nodeAssignment.m_staticAssignmentParameters->m_newCandidateCallback = [this, &assigmentPrerequisites]()
+        {
+            auto taskAssignmentSummary = getCandidateAssignmentSummary(assigmentPrerequisites);
+            sendSharedLmcpObjectLimitedCastMessage(s_provisionalAssignmentAddress(), std::static_pointer_cast<avtas::lmcp::Object>(taskAssignmentSummary));
+        };
+    }
+    {
+        NodeArenaScope nodeArenaScope(nodeAssignment.m_staticAssignmentParameters->addNodeArena());
+        if (m_assignmentThreadPool && (m_numberNodesMaximum < 0))
+        {
+            // with a node limit the result would depend on thread timing, so only
+            // exhaustive searches run in parallel
+            nodeAssignment.ExpandNodeParallel(*m_assignmentThreadPool);
+        }
+        else
+        {
+            nodeAssignment.ExpandNode();
+        }
+    }
+}
+
+void AssignmentTreeBranchBoundBase::setWarmStartAssignment(const std::shared_ptr<uxas::messages::task::TaskAssignmentSummary>& taskAssignmentSummary)
+{
+    if (!m_isWarmStartAssignment)
+    {
+        return;
+    }
+    m_previousVehicleIdVsTaskOptionIds.clear();
+    for (auto itTaskAssignment = taskAssignmentSummary->getTaskList().begin(); itTaskAssignment != taskAssignmentSummary->getTaskList().end(); itTaskAssignment++)
+    {
+        m_previousVehicleIdVsTaskOptionIds[(*itTaskAssignment)->getAssignedVehicle()].push_back(
+                c_TaskAssignmentState::getTaskAndOptionId((*itTaskAssignment)->getTaskID(), (*itTaskAssignment)->getOptionID()));
+    }
+}
+
+void AssignmentTreeBranchBoundBase::releaseAssignmentNodes(std::unique_ptr<c_Node_Base> nodeAssignment)
+{
+    c_StaticAssignmentParameters* staticAssignmentParameters = nodeAssignment->m_staticAssignmentParameters;
+    nodeAssignment.reset();
+    if (staticAssignmentParameters != nullptr)
+    {
+        // release the memory of all search nodes at once
+        staticAssignmentParameters->m_nodeArenas.clear();
+        staticAssignmentParameters->m_newCandidateCallback = nullptr;
+    }
+}
+
+std::shared_ptr<uxas::messages::task::TaskAssignmentSummary> AssignmentTreeBranchBoundBase::getCandidateAssignmentSummary(const std::shared_ptr<AssigmentPrerequisites>& assigmentPrerequisites)
+{
+    auto taskAssignmentSummary = std::make_shared<uxas::messages::task::TaskAssignmentSummary>();
+
+    taskAssignmentSummary->setOperatingRegion(assigmentPrerequisites->m_uniqueAutomationRequest->getOriginalRequest()->getOperatingRegion());
+    taskAssignmentSummary->setCorrespondingAutomationRequestID(assigmentPrerequisites->m_uniqueAutomationRequest->getRequestID());
+
+    // other search threads may replace the candidate
+    std::lock_guard<std::mutex> lock(m_staticAssignmentParameters->m_candidateMutex);
+    for (auto itVehicleAssignments = m_staticAssignmentParameters->m_candidateVehicleIdVsAssignmentState.begin();
+            itVehicleAssignments != m_staticAssignmentParameters->m_candidateVehicleIdVsAssignmentState.end();
+            itVehicleAssignments++)
+    {
+        for (auto itTaskAssignment = itVehicleAssignments->second->m_taskAssignments.begin();
+                itTaskAssignment != itVehicleAssignments->second->m_taskAssignments.end();
+                itTaskAssignment++)
+        {
+            taskAssignmentSummary->getTaskList().push_back((*itTaskAssignment)->clone());
+        }
+    }
+    return (taskAssignmentSummary);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 c_VehicleInformationStatic::c_VehicleInformationStatic(const int64_t & vehicleId)
 : m_vehicleId(vehicleId) { };
 
-int64_t c_VehicleInformationStatic::getTravelTime_ms(const int64_t& fromId, const int64_t & toId)
+void c_VehicleInformationStatic::initializeTravelTimes(const size_t& numberTaskOptions)
+{
+    m_numberTaskOptions = numberTaskOptions;
+    m_travelTime_ms.assign((numberTaskOptions + 1) * numberTaskOptions, -1);
+    m_taskTime_ms.assign(numberTaskOptions, -1);
+    m_minimumTimeToComplete_ms.assign(numberTaskOptions, INT64_MAX);
+};
+
+void c_VehicleInformationStatic::calculateLowerBounds()
 {
-    int64_t returnTravelTime_ms(-1); // LengthOfTime_ms not found
-    auto itToCost = m_FromIdVsToIdVsTravelTime.find(fromId);
-    if (itToCost != m_FromIdVsToIdVsTravelTime.end())
+    for (size_t toIndex = 0; toIndex < m_numberTaskOptions; toIndex++)
     {
-        auto itTravelTime = itToCost->second->find(toId);
-        if (itTravelTime != itToCost->second->end())
+        int64_t minimumTravelTime_ms(INT64_MAX);
+        for (size_t fromIndex = 0; fromIndex <= m_numberTaskOptions; fromIndex++)
         {
-            returnTravelTime_ms = itTravelTime->second;
+            int64_t travelTime_ms = getTravelTime_ms(fromIndex, toIndex);
+            if ((travelTime_ms >= 0) && (travelTime_ms < minimumTravelTime_ms))
+            {
+                minimumTravelTime_ms = travelTime_ms;
+            }
         }
+        // NodeAssignment adds the task time as is, even if it was not found (-1)
+        m_minimumTimeToComplete_ms[toIndex] = (minimumTravelTime_ms == INT64_MAX) ? (INT64_MAX) : (minimumTravelTime_ms + m_taskTime_ms[toIndex]);
     }
-    return (returnTravelTime_ms);
 };
 
 c_TaskInformationStatic::c_TaskInformationStatic() { }
@@ -664,6 +988,122 @@ int64_t c_TaskInformationStatic::getTravelTime_ms(const int64_t & VehicleId)
     return (returnCost_ms);
 };
 
+const size_t c_NodeArena::s_alignment;
+const size_t c_NodeArena::s_blockSize;
+
+void* c_NodeArena::allocate(const size_t& size)
+{
+    size_t allocationSize = ((size + s_alignment - 1) / s_alignment) * s_alignment;
+    for (auto itFreeList = m_sizeVsFreeList.begin(); itFreeList != m_sizeVsFreeList.end(); itFreeList++)
+    {
+        if ((itFreeList->first == allocationSize) && (itFreeList->second != nullptr))
+        {
+            void* memory = itFreeList->second;
+            itFreeList->second = *static_cast<void**>(memory);
+            return (memory);
+        }
+    }
+    if (static_cast<size_t>(m_blockEnd - m_blockNext) < allocationSize)
+    {
+        size_t blockSize = std::max(s_blockSize, allocationSize);
+        m_blocks.push_back(std::unique_ptr<char[]>(new char[blockSize]));
+        m_blockNext = m_blocks.back().get();
+        m_blockEnd = m_blockNext + blockSize;
+    }
+    void* memory = m_blockNext;
+    m_blockNext += allocationSize;
+    return (memory);
+}
+
+void c_NodeArena::deallocate(void* memory, const size_t& size)
+{
+    size_t allocationSize = ((size + s_alignment - 1) / s_alignment) * s_alignment;
+    auto itFreeList = m_sizeVsFreeList.begin();
+    for (; itFreeList != m_sizeVsFreeList.end(); itFreeList++)
+    {
+        if (itFreeList->first == allocationSize)
+        {
+            break;
+        }
+    }
+    if (itFreeList == m_sizeVsFreeList.end())
+    {
+        itFreeList = m_sizeVsFreeList.insert(itFreeList, std::make_pair(allocationSize, static_cast<void*>(nullptr)));
+    }
+    *static_cast<void**>(memory) = itFreeList->second;
+    itFreeList->second = memory;
+}
+
+c_NodeArena*& c_NodeArena::threadArena()
+{
+    static thread_local c_NodeArena* s_threadArena(nullptr);
+    return (s_threadArena);
+}
+
+bool c_StaticAssignmentParameters::isBetterThanCandidate(const int64_t& cost, const c_Node_Base* node)
+{
+    int64_t candidateCost = m_minimumAssignmentCostCandidate;
+    if (cost != candidateCost)
+    {
+        return (cost < candidateCost);
+    }
+    std::lock_guard<std::mutex> lock(m_candidateMutex);
+    return (isBetterThanCandidateLocked(cost, node));
+}
+
+bool c_StaticAssignmentParameters::isBetterThanCandidateLocked(const int64_t& cost, const c_Node_Base* node)
+{
+    if (cost != m_minimumAssignmentCostCandidate)
+    {
+        return (cost < m_minimumAssignmentCostCandidate);
+    }
+    // a search order that is a prefix of the candidate's compares lower, its subtree may hold an earlier tie
+    std::vector<uint32_t>& searchOrder = getThreadScratch().m_searchOrder;
+    node->getSearchOrder(searchOrder);
+    return (std::lexicographical_compare(searchOrder.begin(), searchOrder.end(),
+                                         m_candidateSearchOrder.begin(), m_candidateSearchOrder.end()));
+}
+
+c_NodeArena* c_StaticAssignmentParameters::addNodeArena()
+{
+    std::lock_guard<std::mutex> lock(m_nodeArenasMutex);
+    m_nodeArenas.push_back(std::unique_ptr<c_NodeArena>(new c_NodeArena()));
+    return (m_nodeArenas.back().get());
+}
+
+void c_StaticAssignmentParameters::checkDeadline()
+{
+    if (m_isDeadline && (m_numberCompleteAssignments > 0) && !m_isStopCondition &&
+            (std::chrono::steady_clock::now() >= m_deadline))
+    {
+        m_isDeadlineReached = true;
+        m_isStopCondition = true;
+    }
+}
+
+const uint32_t c_StaticAssignmentParameters::s_deadlineSamplingInterval;
+const int64_t c_StaticAssignmentParameters::s_publishingPeriod_ms;
+
+void c_StaticAssignmentParameters::sampleDeadline()
+{
+    static thread_local uint32_t s_numberCalls(0);
+    if (m_isDeadline && ((++s_numberCalls % s_deadlineSamplingInterval) == 0))
+    {
+        checkDeadline();
+    }
+}
+
+void c_StaticAssignmentParameters::publishNewCandidate()
+{
+    // m_numberCompleteAssignmentsPublished is only accessed by the publishing thread
+    if (m_newCandidateCallback && (std::this_thread::get_id() == m_publishingThreadId) &&
+            (m_numberCompleteAssignments != m_numberCompleteAssignmentsPublished))
+    {
+        m_numberCompleteAssignmentsPublished = m_numberCompleteAssignments;
+        m_newCandidateCallback();
+    }
+}
+
 c_VehicleAssignmentState::c_VehicleAssignmentState(const int64_t & vehicleId)
 : m_vehicleId(vehicleId) { };
 
@@ -677,6 +1117,7 @@ c_VehicleAssignmentState::c_VehicleAssignmentState(const c_VehicleAssignmentStat
     m_vehicleId = rhs.m_vehicleId;
     m_isAcceptingNewAssignments = rhs.m_isAcceptingNewAssignments;
     m_travelTimeTotal_ms = rhs.m_travelTimeTotal_ms;
+    m_locationIndex = rhs.m_locationIndex;
     for (auto itAssignment = rhs.m_taskAssignments.begin(); itAssignment != rhs.m_taskAssignments.end(); itAssignment++)
     {
         m_taskAssignments.push_back(std::unique_ptr<uxas::messages::task::TaskAssignment>((*itAssignment)->clone()));
@@ -698,17 +1139,17 @@ c_TaskAssignmentState::c_TaskAssignmentState(const c_TaskAssignmentState & rhs)
 }
 
 
-std::unique_ptr<c_StaticAssignmentParameters> c_Node_Base::m_staticAssignmentParameters(new c_StaticAssignmentParameters);
-
 c_Node_Base::c_Node_Base() //this is used for the root node
 {
-    m_staticAssignmentParameters->m_numberNodesVisited++;
     //CERR_FILE_LINE_MSG("m_staticAssignmentParameters->m_numberNodesAdded[" << m_staticAssignmentParameters->m_numberNodesAdded << "]")
 }
 
 c_Node_Base::~c_Node_Base()
 {
-    m_staticAssignmentParameters->m_numberNodesRemoved++;
+    if (m_staticAssignmentParameters != nullptr)
+    {
+        m_staticAssignmentParameters->m_numberNodesRemoved++;
+    }
 }
 
 std::unique_ptr<c_Node_Base> c_Node_Base::clone()
@@ -719,26 +1160,117 @@ std::unique_ptr<c_Node_Base> c_Node_Base::clone()
 //copy constructor
 
 c_Node_Base::c_Node_Base(const c_Node_Base & rhs) //copy constructor
-: m_travelTimeTotal_ms(rhs.m_travelTimeTotal_ms),
+: m_staticAssignmentParameters(rhs.m_staticAssignmentParameters),
 m_isPruneable(rhs.m_isPruneable),
 m_isLeafNode(rhs.m_isLeafNode)
 {
-    m_staticAssignmentParameters->m_numberNodesVisited++;
-    for (auto itVehicleAssignmentState = rhs.m_vehicleIdVsAssignmentState.begin();
-            itVehicleAssignmentState != rhs.m_vehicleIdVsAssignmentState.end();
+    // do not copy children or assignment states, NodeAssignment links the copy to its parent !!!!!!!!
+};
+
+void* c_Node_Base::operator new(std::size_t size)
+{
+    c_NodeArena* arena = c_NodeArena::threadArena();
+    char* memory = static_cast<char*>((arena != nullptr) ? arena->allocate(size + c_nodeHeaderSize) : ::operator new(size + c_nodeHeaderSize));
+    *reinterpret_cast<c_NodeArena**>(memory) = arena;
+    return (memory + c_nodeHeaderSize);
+}
+
+void c_Node_Base::operator delete(void* memory, std::size_t size)
+{
+    if (memory == nullptr)
+    {
+        return;
+    }
+    char* allocation = static_cast<char*>(memory) - c_nodeHeaderSize;
+    c_NodeArena* arena = *reinterpret_cast<c_NodeArena**>(allocation);
+    if (arena == nullptr)
+    {
+        ::operator delete(allocation);
+    }
+    else if (arena == c_NodeArena::threadArena())
+    {
+        arena->deallocate(allocation, size + c_nodeHeaderSize);
+    }
+    // otherwise the node belongs to another thread's arena, its memory is released with the arena
+}
+
+void c_Node_Base::getSearchOrder(std::vector<uint32_t>& searchOrder) const
+{
+    searchOrder.clear();
+    for (const c_Node_Base* node = this; node->m_parent != nullptr; node = node->m_parent)
+    {
+        searchOrder.push_back(node->m_childRank);
+    }
+    std::reverse(searchOrder.begin(), searchOrder.end());
+}
+
+void c_Node_Base::restoreVehicleAssignmentStates(c_SearchScratch& scratch)
+{
+    std::vector<int64_t>& assignedTaskOptionIds = scratch.m_assignedTaskOptionIds;
+    assignedTaskOptionIds.clear();
+    // the last assignment of each vehicle, by vehicle index
+    std::vector<const c_Node_Base*>& vehicleLastAssignments = scratch.m_vehicleLastAssignments;
+    vehicleLastAssignments.assign(m_staticAssignmentParameters->m_vehicleIds.size(), nullptr);
+    const c_Node_Base* trunk = this;
+    for (; trunk->m_parent != nullptr; trunk = trunk->m_parent)
+    {
+        assignedTaskOptionIds.push_back(trunk->m_taskOptionID);
+        if (vehicleLastAssignments[trunk->m_vehicleIndex] == nullptr)
+        {
+            vehicleLastAssignments[trunk->m_vehicleIndex] = trunk;
+        }
+    }
+    std::reverse(assignedTaskOptionIds.begin(), assignedTaskOptionIds.end());
+    if (trunk == this)
+    {
+        return;
+    }
+
+    // the states of the previous node are overwritten, the vehicles are the same for all nodes of a search
+    m_vehicleIdVsAssignmentState.swap(scratch.m_vehicleIdVsAssignmentState);
+    if (m_vehicleIdVsAssignmentState.size() != trunk->m_vehicleIdVsAssignmentState.size())
+    {
+        m_vehicleIdVsAssignmentState.clear();
+    }
+    for (auto itVehicleAssignmentState = trunk->m_vehicleIdVsAssignmentState.begin();
+            itVehicleAssignmentState != trunk->m_vehicleIdVsAssignmentState.end();
             itVehicleAssignmentState++)
     {
-        m_vehicleIdVsAssignmentState[itVehicleAssignmentState->first] = itVehicleAssignmentState->second->clone();
+        auto& vehicleAssignmentState = m_vehicleIdVsAssignmentState[itVehicleAssignmentState->first];
+        if (!vehicleAssignmentState)
+        {
+            vehicleAssignmentState.reset(new c_VehicleAssignmentState(itVehicleAssignmentState->first));
+        }
+        vehicleAssignmentState->m_isAcceptingNewAssignments = itVehicleAssignmentState->second->m_isAcceptingNewAssignments;
+        vehicleAssignmentState->m_travelTimeTotal_ms = itVehicleAssignmentState->second->m_travelTimeTotal_ms;
+        vehicleAssignmentState->m_locationIndex = itVehicleAssignmentState->second->m_locationIndex;
+        auto itVehicleInformation = m_staticAssignmentParameters->m_vehicleIdVsInformation.find(itVehicleAssignmentState->first);
+        if (itVehicleInformation != m_staticAssignmentParameters->m_vehicleIdVsInformation.end())
+        {
+            const c_Node_Base* lastAssignment = vehicleLastAssignments[itVehicleInformation->second->m_vehicleIndex];
+            if (lastAssignment != nullptr)
+            {
+                vehicleAssignmentState->m_travelTimeTotal_ms = lastAssignment->m_travelTimeTotal_ms;
+                vehicleAssignmentState->m_locationIndex = lastAssignment->m_taskOptionIndex + 1;
+            }
+        }
     }
-    for (auto itTaskAssignmentState = rhs.m_taskIdVsAssignmentState.begin();
-            itTaskAssignmentState != rhs.m_taskIdVsAssignmentState.end();
-            itTaskAssignmentState++)
+    if (m_vehicleIdVsAssignmentState.size() != trunk->m_vehicleIdVsAssignmentState.size())
     {
-        m_taskIdVsAssignmentState[itTaskAssignmentState->first] = itTaskAssignmentState->second->clone();
+        // states of another search's vehicles (only if the thread has no arena)
+        for (auto itVehicleAssignmentState = m_vehicleIdVsAssignmentState.begin(); itVehicleAssignmentState != m_vehicleIdVsAssignmentState.end();)
+        {
+            if (trunk->m_vehicleIdVsAssignmentState.find(itVehicleAssignmentState->first) == trunk->m_vehicleIdVsAssignmentState.end())
+            {
+                itVehicleAssignmentState = m_vehicleIdVsAssignmentState.erase(itVehicleAssignmentState);
+            }
+            else
+            {
+                itVehicleAssignmentState++;
+            }
+        }
     }
-    m_viObjectiveIDs_Assigned = rhs.m_viObjectiveIDs_Assigned;
-    // do not copy children !!!!!!!!
-};
+}
 
 void c_Node_Base::printStatus(const std::string& Message)
 {
@@ -747,16 +1279,16 @@ void c_Node_Base::printStatus(const std::string& Message)
     UXAS_LOG_INFORM(Message
                   , "timeSinceStart_s[" , timeSinceStart_s
                   , "] m_vehicleID[" , m_vehicleID
-                  , "] cost[" , m_staticAssignmentParameters->m_minimumAssignmentCostCandidate
-                  , "] numberNodesVisited[" , m_staticAssignmentParameters->m_numberNodesVisited
-                  , "] numberNodesRemoved[" , m_staticAssignmentParameters->m_numberNodesRemoved
+                  , "] cost[" , m_staticAssignmentParameters->m_minimumAssignmentCostCandidate.load()
+                  , "] numberNodesVisited[" , m_staticAssignmentParameters->m_numberNodesVisited.load()
+                  , "] numberNodesRemoved[" , m_staticAssignmentParameters->m_numberNodesRemoved.load()
                   , "] Number Current Nodes[" , (m_staticAssignmentParameters->m_numberNodesVisited - m_staticAssignmentParameters->m_numberNodesRemoved)
-                  , "] numberNodesAdded[" , m_staticAssignmentParameters->m_numberNodesAdded
-                  , "] numberNodesPruned[" , m_staticAssignmentParameters->m_numberNodesPruned
+                  , "] numberNodesAdded[" , m_staticAssignmentParameters->m_numberNodesAdded.load()
+                  , "] numberNodesPruned[" , m_staticAssignmentParameters->m_numberNodesPruned.load()
                   , "]" );
     UXAS_LOG_INFORM_ASSIGNMENT("timeSinceStart_s[", timeSinceStart_s,
-                                  "] cost[", m_staticAssignmentParameters->m_minimumAssignmentCostCandidate,
-                                  "] numberNodesVisited[", m_staticAssignmentParameters->m_numberNodesVisited, "]");
+                                  "] cost[", m_staticAssignmentParameters->m_minimumAssignmentCostCandidate.load(),
+                                  "] numberNodesVisited[", m_staticAssignmentParameters->m_numberNodesVisited.load(), "]");
 }
 
 void c_Node_Base::ExpandNode()
@@ -764,11 +1296,103 @@ void c_Node_Base::ExpandNode()
     //////////////////////////////////////////////////////////////////////////////////
     // check assignment viability and find lower bound on costs of child nodes
     //////////////////////////////////////////////////////////////////////////////////
+    bool bTaskAvailable = AddChildren(); //if there are no tasks to do then this is the final assignment node
+
+    if (!m_staticAssignmentParameters->m_isStopCondition)
+    {
+        //if there are valid assignments and there are child nodes, then expand them 
+        //if (bTaskAvailable && bVehicleAvailable)
+        if (!m_costVsChildren.empty())
+        {
+            ExpandChildren();
+            PruneChildren();
+        }
+        else //if(((bTaskAvailable)&&(bVehicleAvailable))
+        {
+            EvaluateLeaf(bTaskAvailable);
+        } //if(((bTaskAvailable)&&(bVehicleAvailable)))
+    }
+
+    EvaluateStopCondition();
+} //void CNode::ExpandNode(
+
+void c_Node_Base::ExpandNodeParallel(uxas::common::ThreadPool& threadPool)
+{
+    // a few subtrees per thread balance the load, since subtree sizes vary widely after pruning
+    size_t numberSubtreesMinimum = static_cast<size_t>(threadPool.getThreadCount() + 1) * 8;
+
+    // split the top of the tree, breadth first. Nodes on each level stay in search order.
+    std::vector<c_Node_Base*> subtrees(1, this);
+    while ((subtrees.size() < numberSubtreesMinimum) && !m_staticAssignmentParameters->m_isStopCondition)
+    {
+        std::vector<c_Node_Base*> nextSubtrees;
+        for (auto& node : subtrees)
+        {
+            bool bTaskAvailable = node->AddChildren();
+            if (node->m_costVsChildren.empty())
+            {
+                node->EvaluateLeaf(bTaskAvailable);
+                continue;
+            }
+            if ((node->m_isOnWarmStartPath || (node->m_parent == nullptr)) && !m_staticAssignmentParameters->m_warmStartTaskOptionIndices.empty())
+            {
+                node->findWarmStartChild();
+            }
+            for (auto itChild = node->m_costVsChildren.begin(); itChild != node->m_costVsChildren.end(); itChild++)
+            {
+                nextSubtrees.push_back(itChild->second.get());
+            }
+        }
+        subtrees.swap(nextSubtrees);
+        if (subtrees.empty())
+        {
+            break;
+        }
+    }
+
+    // the warm start subtree is searched first, its assignment bounds the others. Ties are
+    // still resolved by search order, so this does not change the result.
+    std::stable_partition(subtrees.begin(), subtrees.end(), [](c_Node_Base* node)
+    {
+        return (node->m_isOnWarmStartPath);
+    });
+
+    // search the subtrees, in search order, on the pool's threads and the calling thread. While the
+    // calling thread waits for the last subtrees, it publishes their candidates and checks the deadline.
+    threadPool.parallelFor(subtrees.size(), [this, &subtrees](size_t index)
+    {
+        // the nodes below a subtree are created and pruned by the thread searching it
+        NodeArenaScope nodeArenaScope(m_staticAssignmentParameters->addNodeArena());
+        c_Node_Base* node = subtrees[index];
+        if (m_staticAssignmentParameters->isBetterThanCandidate(node->calculateLowerBound(), node) && !m_staticAssignmentParameters->m_isStopCondition)
+        {
+            node->ExpandNode();
+        }
+        else
+        {
+            node->m_isPruneable = true;
+        }
+    }, std::chrono::milliseconds(c_StaticAssignmentParameters::s_publishingPeriod_ms), [this]()
+    {
+        m_staticAssignmentParameters->checkDeadline();
+        m_staticAssignmentParameters->publishNewCandidate();
+    });
+
+    PruneChildren();
+    EvaluateStopCondition();
+}
+
+bool c_Node_Base::AddChildren()
+{
     bool bTaskAvailable = false; //if there are no tasks to do then this is the final assignment node
 
+    // the vehicle states of this node are only needed while its children are added
+    c_SearchScratch& scratch = getThreadScratch();
+    restoreVehicleAssignmentStates(scratch);
+
     // investigate child nodes
     std::vector<int64_t> vectorOfNextObjectiveIDs;
-    m_staticAssignmentParameters->algebra.searchNext(m_viObjectiveIDs_Assigned, vectorOfNextObjectiveIDs);
+    m_staticAssignmentParameters->algebra.searchNext(scratch.m_assignedTaskOptionIds, vectorOfNextObjectiveIDs);
 
     for (auto itObjectiveID = vectorOfNextObjectiveIDs.begin(); itObjectiveID != vectorOfNextObjectiveIDs.end(); itObjectiveID++) // ALGEBRA:: New for loop
     {
@@ -788,135 +1412,306 @@ void c_Node_Base::ExpandNode()
         }
     } //for(V_INT_IT_t itObjectiveID = vectorOfNextObjectiveIDs.begin(); itObjectiveID != vectorOfNextObjectiveIDs.end(); itObjectiveID++)
 
-    if (!m_staticAssignmentParameters->m_isStopCondition)
+    if (m_parent != nullptr)
     {
-        //if there are valid assignments and there are child nodes, then expand them 
-        //if (bTaskAvailable && bVehicleAvailable)
-        if (!m_costVsChildren.empty())
-        {
-            //////////////////////////////////////////////////////////////////////////////////
-            //expand the children
-            //////////////////////////////////////////////////////////////////////////////////
+        // return the states to the scratch buffers, the next node reuses them
+        m_vehicleIdVsAssignmentState.swap(scratch.m_vehicleIdVsAssignmentState);
+    }
+
+    // equal costs stay in the order they were added
+    std::stable_sort(m_costVsChildren.begin(), m_costVsChildren.end(),
+                     [](const std::pair<int64_t, std::unique_ptr<c_Node_Base> >& lhs, const std::pair<int64_t, std::unique_ptr<c_Node_Base> >& rhs)
+                     {
+                         return (lhs.first < rhs.first);
+                     });
+    uint32_t childRank(0);
+    for (auto itChild = m_costVsChildren.begin(); itChild != m_costVsChildren.end(); itChild++, childRank++)
+    {
+        itChild->second->m_childRank = childRank;
+    }
+
+    return (bTaskAvailable);
+}
+
+void c_Node_Base::ExpandChildren()
+{
+    //////////////////////////////////////////////////////////////////////////////////
+    //expand the children
+    //////////////////////////////////////////////////////////////////////////////////
 #ifdef STEVETEST
-            std::cout << std::endl << "<>AssignmentTreeBB:m_costVsChildren [" << m_costVsChildren.size() << "] # Previous Assignments[" << m_viObjectiveIDs_Assigned.size() << "]";
+    std::vector<uint32_t> searchOrder;
+    getSearchOrder(searchOrder);
+    std::cout << std::endl << "<>AssignmentTreeBB:m_costVsChildren [" << m_costVsChildren.size() << "] # Previous Assignments[" << searchOrder.size() << "]";
 #endif  //#ifdef STEVETEST
 #ifdef STEVETEST
-            for (auto& itChild : m_costVsChildren)
+    for (auto& itChild : m_costVsChildren)
+    {
+        std::cout << " (" << itChild.second->m_vehicleID << ", " << itChild.second->m_taskOptionID << ", " << itChild.first << ")";
+    }
+    std::cout << "]" << std::endl;
+    std::cout.flush();
+#endif  //#ifdef STEVETEST
+
+    // the child that continues the warm start assignment is expanded first. Ties are still
+    // resolved by search order, so this only changes the order candidates are found in.
+    size_t warmStartChildIndex(m_costVsChildren.size());
+    if ((m_isOnWarmStartPath || (m_parent == nullptr)) && !m_staticAssignmentParameters->m_warmStartTaskOptionIndices.empty())
+    {
+        warmStartChildIndex = findWarmStartChild();
+    }
+
+    for (size_t expansionIndex = 0; expansionIndex < m_costVsChildren.size(); expansionIndex++)
+    {
+        size_t childIndex(expansionIndex);
+        if (warmStartChildIndex < m_costVsChildren.size())
+        {
+            if (expansionIndex == 0)
+            {
+                childIndex = warmStartChildIndex;
+            }
+            else if (expansionIndex <= warmStartChildIndex)
             {
-                std::cout << " (" << itChild.second->m_vehicleID << ", " << itChild.second->m_taskOptionID << ", " << itChild.first << ")";
+                childIndex = expansionIndex - 1;
             }
-            std::cout << "]" << std::endl;
-            std::cout.flush();
+        }
+        auto itChild = m_costVsChildren.begin() + childIndex;
+        // other children (or other threads) may have found lower costs or a stop condition
+        if (m_staticAssignmentParameters->isBetterThanCandidate(itChild->second->calculateLowerBound(), itChild->second.get()) && !m_staticAssignmentParameters->m_isStopCondition)
+        {
+#ifdef STEVETEST
+            std::cout << "  #Prev[" << searchOrder.size() << "](" << itChild->second->m_vehicleID << ", "
+                    << itChild->second->m_taskOptionID << ", " << itChild->first << ", " << itChild->second->m_nodeCost << ")";
 #endif  //#ifdef STEVETEST
+            itChild->second->ExpandNode();
+        }
+        else
+        {
+            itChild->second->m_isPruneable = true;
+        }
+    } //for(L_CHILD_IT_t itChild=lnodeitGe ......
+}
+
+size_t c_Node_Base::findWarmStartChild()
+{
+    std::vector<bool> isTaskOptionAssigned(m_staticAssignmentParameters->m_taskOptionIdVsInformation.size(), false);
+    for (const c_Node_Base* node = this; node->m_parent != nullptr; node = node->m_parent)
+    {
+        isTaskOptionAssigned[node->m_taskOptionIndex] = true;
+    }
+
+    // the warm start child assigns its vehicle the next of the vehicle's previous task options
+    size_t warmStartChildIndex(0);
+    for (size_t childIndex = 0; childIndex < m_costVsChildren.size(); childIndex++)
+    {
+        const c_Node_Base* child = m_costVsChildren[childIndex].second.get();
+        const auto& taskOptionIndices = m_staticAssignmentParameters->m_warmStartTaskOptionIndices[child->m_vehicleIndex];
+        auto itNextTaskOptionIndex = std::find_if(taskOptionIndices.begin(), taskOptionIndices.end(), [&isTaskOptionAssigned](const size_t& taskOptionIndex)
+        {
+            return (!isTaskOptionAssigned[taskOptionIndex]);
+        });
+        if ((itNextTaskOptionIndex != taskOptionIndices.end()) && (*itNextTaskOptionIndex == child->m_taskOptionIndex))
+        {
+            warmStartChildIndex = childIndex;
+            break;
+        }
+    }
+    m_costVsChildren[warmStartChildIndex].second->m_isOnWarmStartPath = true;
+    return (warmStartChildIndex);
+}
 
-            for (auto itChild = m_costVsChildren.begin(); itChild != m_costVsChildren.end(); itChild++)
+void c_Node_Base::EvaluateLeaf(const bool& bTaskAvailable)
+{
+    // have all of the tasks been accounted for?
+    if (!bTaskAvailable)
+    {
+        bool isNewCandidate(false);
+        {
+            // check to see if this leaf node is better than the candidate optimal
+            std::lock_guard<std::mutex> lock(m_staticAssignmentParameters->m_candidateMutex);
+            if (m_staticAssignmentParameters->isBetterThanCandidateLocked(m_nodeCost, this))
             {
-                // other children may have found lower costs or a stop condition
-                if ((itChild->second->m_nodeCost < m_staticAssignmentParameters->m_minimumAssignmentCostCandidate) && !m_staticAssignmentParameters->m_isStopCondition)
+                ////////////////  NEW LEAF NODE  ///////////////////////////
+                // this is the new minimum (feasible) leaf node
+                isNewCandidate = true;
+                m_isLeafNode = true;
+                m_staticAssignmentParameters->m_numberCompleteAssignments++;
+                m_staticAssignmentParameters->m_minimumAssignmentCostCandidate = m_nodeCost;
+                getSearchOrder(m_staticAssignmentParameters->m_candidateSearchOrder);
+                // build the vehicle assignments from the trunk's states and the assignments leading to this node
+                std::vector<const c_Node_Base*> assignments;
+                const c_Node_Base* trunk = this;
+                for (; trunk->m_parent != nullptr; trunk = trunk->m_parent)
                 {
-#ifdef STEVETEST
-                    std::cout << "  #Prev[" << m_viObjectiveIDs_Assigned.size() << "](" << itChild->second->m_vehicleID << ", "
-                            << itChild->second->m_taskOptionID << ", " << itChild->first << ", " << itChild->second->m_nodeCost << ")";
-#endif  //#ifdef STEVETEST
-                    itChild->second->ExpandNode();
+                    assignments.push_back(trunk);
                 }
-                else
+                m_staticAssignmentParameters->m_candidateVehicleIdVsAssignmentState.clear();
+                for (auto itVehicleAssignment = trunk->m_vehicleIdVsAssignmentState.begin(); itVehicleAssignment != trunk->m_vehicleIdVsAssignmentState.end(); itVehicleAssignment++)
                 {
-                    itChild->second->m_isPruneable = true;
+                    m_staticAssignmentParameters->m_candidateVehicleIdVsAssignmentState[itVehicleAssignment->first] = itVehicleAssignment->second->clone();
                 }
-            } //for(L_CHILD_IT_t itChild=lnodeitGe ......
-            PruneChildren();
-        }
-        else //if(((bTaskAvailable)&&(bVehicleAvailable))
-        {
-            // have all of the tasks been accounted for?
-            if (!bTaskAvailable)
-            {
-                // check to see if this leaf node is better than the candidate optimal
-                if (m_nodeCost < m_staticAssignmentParameters->m_minimumAssignmentCostCandidate)
+                for (auto itAssignment = assignments.rbegin(); itAssignment != assignments.rend(); itAssignment++)
                 {
-                    ////////////////  NEW LEAF NODE  ///////////////////////////
-                    // this is the new minimum (feasible) leaf node
-                    m_isLeafNode = true;
-                    m_staticAssignmentParameters->m_numberCompleteAssignments++;
-                    m_staticAssignmentParameters->m_minimumAssignmentCostCandidate = m_nodeCost;
-                    m_staticAssignmentParameters->m_candidateVehicleIdVsAssignmentState.clear();
-                    for (auto itVehicleAssignment = m_vehicleIdVsAssignmentState.begin(); itVehicleAssignment != m_vehicleIdVsAssignmentState.end(); itVehicleAssignment++)
+                    auto& vehicleAssignmentState = m_staticAssignmentParameters->m_candidateVehicleIdVsAssignmentState[(*itAssignment)->m_vehicleID];
+                    if (!vehicleAssignmentState)
                     {
-                        m_staticAssignmentParameters->m_candidateVehicleIdVsAssignmentState[itVehicleAssignment->first] = itVehicleAssignment->second->clone();
+                        vehicleAssignmentState = std::unique_ptr<c_VehicleAssignmentState>(new c_VehicleAssignmentState((*itAssignment)->m_vehicleID));
                     }
-                    printStatus("INFO::NEW LEAF: ");
+                    auto taskAssignment = std::unique_ptr<uxas::messages::task::TaskAssignment>(new uxas::messages::task::TaskAssignment());
+                    taskAssignment->setTaskID(c_TaskAssignmentState::getTaskID((*itAssignment)->m_taskOptionID));
+                    taskAssignment->setOptionID(c_TaskAssignmentState::getOptionID((*itAssignment)->m_taskOptionID));
+                    taskAssignment->setAssignedVehicle((*itAssignment)->m_vehicleID);
+                    taskAssignment->setTimeThreshold((*itAssignment)->m_timeThreshold_ms);
+                    taskAssignment->setTimeTaskCompleted((*itAssignment)->m_travelTimeTotal_ms);
+                    vehicleAssignmentState->m_taskAssignments.push_back(std::move(taskAssignment));
+                    vehicleAssignmentState->m_travelTimeTotal_ms = (*itAssignment)->m_travelTimeTotal_ms;
+                    vehicleAssignmentState->m_locationIndex = (*itAssignment)->m_taskOptionIndex + 1;
                 }
-                else //if (m_nodeCost < m_staticAssignmentParameters->m_minimumAssignmentCostCandidate)
-                {
-                    //COUT_INFO_MSG("(!bTaskAvailable)")
-                    // this is a node that is not optimal and needs to be pruned
-                    m_isLeafNode = true;
-                    m_isPruneable = true;
-                } //if (m_nodeCost < m_staticAssignmentParameters->m_minimumAssignmentCostCandidate)
             }
-            else //if(!bTaskAvailable)
-            {
-                //COUT_INFO_MSG("(bTaskAvailable && !bVehicleAvailable)")
-                // not all of the tasks were assigned!!!!!
-                //TODO:: let them know why this set of assignments didn't work???
-                // this is a node that is not optimal and needs to be pruned
-                m_isLeafNode = true;
-                m_isPruneable = true;
-            } //if(!bTaskAvailable)
-        } //if(((bTaskAvailable)&&(bVehicleAvailable)))
+        }
+        if (isNewCandidate)
+        {
+            printStatus("INFO::NEW LEAF: ");
+            m_staticAssignmentParameters->publishNewCandidate();
+            m_staticAssignmentParameters->checkDeadline();
+        }
+        else //if (m_nodeCost < m_staticAssignmentParameters->m_minimumAssignmentCostCandidate)
+        {
+            //COUT_INFO_MSG("(!bTaskAvailable)")
+            // this is a node that is not optimal and needs to be pruned
+            m_isLeafNode = true;
+            m_isPruneable = true;
+        } //if (m_nodeCost < m_staticAssignmentParameters->m_minimumAssignmentCostCandidate)
     }
+    else //if(!bTaskAvailable)
+    {
+        //COUT_INFO_MSG("(bTaskAvailable && !bVehicleAvailable)")
+        // not all of the tasks were assigned!!!!!
+        //TODO:: let them know why this set of assignments didn't work???
+        // this is a node that is not optimal and needs to be pruned
+        m_isLeafNode = true;
+        m_isPruneable = true;
+    } //if(!bTaskAvailable)
+}
 
+void c_Node_Base::EvaluateStopCondition()
+{
     if (m_staticAssignmentParameters->m_isStopCondition)
     {
         // got a stop condition, time to get out
-        if (!m_isFinalAssignmentCalculated)
+        if (!m_staticAssignmentParameters->m_isFinalAssignmentCalculated.exchange(true))
         {
             //COUT_INFO_MSG("calculateFinalAssignment()!")
             calculateFinalAssignment();
-            m_isFinalAssignmentCalculated = true;
         }
         // dump the children
         m_costVsChildren.clear();
 
     } //if(m_staticAssignmentParameters->m_isStopCondition)
-} //void CNode::ExpandNode(
+}
 
-void c_Node_Base::PruneChildren()
+int64_t c_Node_Base::calculateLowerBound()
 {
-    bool isPruneParent(true); //if any of the nodes below this are not pruned then don't allow this one to be pruned
+    int64_t lowerBound(m_nodeCost);
+    if (m_staticAssignmentParameters->m_requiredTaskOptionIndexGroups.empty() || !isMinMaxCost())
+    {
+        return (lowerBound);
+    }
 
-    if (!m_costVsChildren.empty())
+    // task options assigned from the trunk to this node and the last assignment of each vehicle
+    c_SearchScratch& scratch = getThreadScratch();
+    std::vector<bool>& isTaskOptionAssigned = scratch.m_isTaskOptionAssigned;
+    isTaskOptionAssigned.assign(m_staticAssignmentParameters->m_taskOptionIdVsInformation.size(), false);
+    std::vector<const c_Node_Base*>& vehicleLastAssignments = scratch.m_vehicleLastAssignments;
+    vehicleLastAssignments.assign(m_staticAssignmentParameters->m_vehicleIds.size(), nullptr);
+    const c_Node_Base* trunk = this;
+    for (; trunk->m_parent != nullptr; trunk = trunk->m_parent)
     {
-        for (auto itChild = m_costVsChildren.begin(); itChild != m_costVsChildren.end(); itChild++)
+        isTaskOptionAssigned[trunk->m_taskOptionIndex] = true;
+        if (vehicleLastAssignments[trunk->m_vehicleIndex] == nullptr)
         {
-            itChild->second->PruneChildren();
+            vehicleLastAssignments[trunk->m_vehicleIndex] = trunk;
         }
-        while (1)
+    }
+
+    // travel time total and information of the vehicles that accept assignments
+    std::vector<std::pair<int64_t, c_VehicleInformationStatic*> >& vehicles = scratch.m_vehicles;
+    vehicles.clear();
+    for (auto itVehicleAssignmentState = trunk->m_vehicleIdVsAssignmentState.begin(); itVehicleAssignmentState != trunk->m_vehicleIdVsAssignmentState.end(); itVehicleAssignmentState++)
+    {
+        auto itVehicleInformation = m_staticAssignmentParameters->m_vehicleIdVsInformation.find(itVehicleAssignmentState->first);
+        if (itVehicleAssignmentState->second->m_isAcceptingNewAssignments && (itVehicleInformation != m_staticAssignmentParameters->m_vehicleIdVsInformation.end()))
         {
-            auto itChild = m_costVsChildren.begin();
-            for (; itChild != m_costVsChildren.end(); itChild++)
-            {
-                if (itChild->second->m_isPruneable)
-                {
-                    m_costVsChildren.erase(itChild);
-                    itChild = m_costVsChildren.begin();
-                    m_staticAssignmentParameters->m_numberNodesPruned++;
-                    break;
-                }
-                else
-                {
-                    isPruneParent = false;
-                }
+            const c_Node_Base* lastAssignment = vehicleLastAssignments[itVehicleInformation->second->m_vehicleIndex];
+            int64_t travelTimeTotal_ms = (lastAssignment != nullptr) ? lastAssignment->m_travelTimeTotal_ms : itVehicleAssignmentState->second->m_travelTimeTotal_ms;
+            vehicles.push_back(std::make_pair(travelTimeTotal_ms, itVehicleInformation->second.get()));
+        }
+    }
 
-            }
-            if (itChild == m_costVsChildren.end())
+    // one task option of each required group that has not been assigned, yet, still has to be
+    // completed by some vehicle, which ends that vehicle's travel no earlier than its bound
+    for (auto itGroup = m_staticAssignmentParameters->m_requiredTaskOptionIndexGroups.begin();
+            itGroup != m_staticAssignmentParameters->m_requiredTaskOptionIndexGroups.end();
+            itGroup++)
+    {
+        bool isGroupAssigned(false);
+        for (auto itTaskOptionIndex = itGroup->begin(); itTaskOptionIndex != itGroup->end(); itTaskOptionIndex++)
+        {
+            if (isTaskOptionAssigned[*itTaskOptionIndex])
             {
+                isGroupAssigned = true;
                 break;
             }
-        } //while(1)
+        }
+        if (isGroupAssigned)
+        {
+            continue;
+        }
+        int64_t groupBound(INT64_MAX);
+        for (auto itTaskOptionIndex = itGroup->begin(); itTaskOptionIndex != itGroup->end(); itTaskOptionIndex++)
+        {
+            for (auto itVehicle = vehicles.begin(); itVehicle != vehicles.end(); itVehicle++)
+            {
+                int64_t minimumTimeToComplete_ms = itVehicle->second->m_minimumTimeToComplete_ms[*itTaskOptionIndex];
+                if (minimumTimeToComplete_ms != INT64_MAX)
+                {
+                    groupBound = std::min(groupBound, itVehicle->first + minimumTimeToComplete_ms);
+                }
+            }
+        }
+        lowerBound = std::max(lowerBound, groupBound);
+    }
+    return (lowerBound);
+}
+
+bool c_Node_Base::isMinMaxCost()
+{
+#ifdef AFRL_INTERNAL_ENABLED
+    return (m_assignmentType == uxas::project::pisr::AssignmentType::MinMaxTime);
+#else
+    return (true);
+#endif
+}
+
+void c_Node_Base::PruneChildren()
+{
+    bool isPruneParent(true); //if any of the nodes below this are not pruned then don't allow this one to be pruned
+
+    if (!m_costVsChildren.empty())
+    {
+        for (auto itChild = m_costVsChildren.begin(); itChild != m_costVsChildren.end(); itChild++)
+        {
+            itChild->second->PruneChildren();
+        }
+        auto itPruned = std::remove_if(m_costVsChildren.begin(), m_costVsChildren.end(),
+                                       [](const std::pair<int64_t, std::unique_ptr<c_Node_Base> >& child)
+                                       {
+                                           return (child.second->m_isPruneable);
+                                       });
+        m_staticAssignmentParameters->m_numberNodesPruned += std::distance(itPruned, m_costVsChildren.end());
+        m_costVsChildren.erase(itPruned, m_costVsChildren.end());
+        isPruneParent = m_costVsChildren.empty();
     }
-    else if ((m_nodeCost < m_staticAssignmentParameters->m_minimumAssignmentCostCandidate) && m_isLeafNode)
+    else if (m_isLeafNode && m_staticAssignmentParameters->isBetterThanCandidate(m_nodeCost, this))
     {
         isPruneParent = false;
     }
@@ -936,6 +1731,9 @@ void c_Node_Base::NodeAssignment(std::unique_ptr<c_VehicleAssignmentState>& vehi
     {
         m_staticAssignmentParameters->m_isStopCondition = true;
     }
+    m_staticAssignmentParameters->sampleDeadline();
+    // candidates found by other threads
+    m_staticAssignmentParameters->publishNewCandidate();
 
     bool isError(false);
 
@@ -944,14 +1742,19 @@ void c_Node_Base::NodeAssignment(std::unique_ptr<c_VehicleAssignmentState>& vehi
     int64_t prerequisiteTime_ms(0);
     if (prerequisiteTaskOptionId > 0)
     {
-        auto itTaskAssignmentState = m_taskIdVsAssignmentState.find(prerequisiteTaskOptionId);
-        if (itTaskAssignmentState != m_taskIdVsAssignmentState.end())
+        const c_Node_Base* prerequisiteAssignment = this;
+        while ((prerequisiteAssignment->m_parent != nullptr) && (prerequisiteAssignment->m_taskOptionID != prerequisiteTaskOptionId))
+        {
+            prerequisiteAssignment = prerequisiteAssignment->m_parent;
+        }
+        if (prerequisiteAssignment->m_parent != nullptr)
         {
-            prerequisiteTime_ms = itTaskAssignmentState->second->m_taskCompletionTime_ms;
+            prerequisiteTime_ms = prerequisiteAssignment->m_travelTimeTotal_ms;
         }
         else
         {
 	UXAS_LOG_ERROR("ASSIGNMENT_ERROR:: required prerequisite TaskOptionId[", prerequisiteTaskOptionId, "] not found");
+            std::lock_guard<std::mutex> lock(m_staticAssignmentParameters->m_reasonsMutex);
             m_staticAssignmentParameters->m_reasonsForNoAssignment << "ASSIGNMENT_ERROR:: required prerequisite TaskOptionId[" << prerequisiteTaskOptionId << "] not found!" << std::endl;
             isError = true;
         }
@@ -974,16 +1777,10 @@ void c_Node_Base::NodeAssignment(std::unique_ptr<c_VehicleAssignmentState>& vehi
             (itTaskOptionInformation != m_staticAssignmentParameters->m_taskOptionIdVsInformation.end()) &&
             (vehicleAssignmentState->m_isAcceptingNewAssignments))
     {
-        int64_t taskTime_ms = itTaskOptionInformation->second->getTravelTime_ms(vehicleId);
-        int64_t startingLocationId = vehicleId;
-        if (!vehicleAssignmentState->m_taskAssignments.empty())
-        {
-            auto lastTaskId = vehicleAssignmentState->m_taskAssignments.back()->getTaskID();
-            auto lastOptionId = vehicleAssignmentState->m_taskAssignments.back()->getOptionID();
-            startingLocationId = c_TaskAssignmentState::getTaskAndOptionId(lastTaskId, lastOptionId);
-        }
+        size_t taskOptionIndex = itTaskOptionInformation->second->m_taskOptionIndex;
+        int64_t taskTime_ms = itVehicleInformation->second->m_taskTime_ms[taskOptionIndex];
         // increment from last task to this one
-        int64_t travelTime_ms = itVehicleInformation->second->getTravelTime_ms(startingLocationId, taskOptionId);
+        int64_t travelTime_ms = itVehicleInformation->second->getTravelTime_ms(vehicleAssignmentState->m_locationIndex, taskOptionIndex);
         if (travelTime_ms >= 0)
         {
             // travel from starting location to beginning of this task
@@ -1003,62 +1800,62 @@ void c_Node_Base::NodeAssignment(std::unique_ptr<c_VehicleAssignmentState>& vehi
 
             if ((maxVehicleTravelTime_ms < 0) || (travelTimeTotalToEnd_ms < maxVehicleTravelTime_ms))
             {
-                // create new child for cost calculation
-                auto newChild = std::unique_ptr<c_Node_Base>(clone());
-                // calculate assignment cost
-                int64_t nodeCost(INT64_MAX);
-                int64_t evaluationOrderCost(INT64_MAX);
-                newChild->calculateAssignmentCostBase(vehicleAssignmentState, taskOptionId,
-                                                      taskTime_ms, travelTime_ms,
-                                                      nodeCost, evaluationOrderCost);
-                if (nodeCost < m_staticAssignmentParameters->m_minimumAssignmentCostCandidate)
+                // the MINMAX cost is at least this vehicle's travel time, skip the cost calculation if that can not win
+                if (!isMinMaxCost() || m_staticAssignmentParameters->isBetterThanCandidate(travelTimeTotalToEnd_ms, this))
                 {
-                    // add new child
-                    newChild->m_nodeCost = nodeCost;
-                    //COUT_INFO_MSG("nodeCost[" << nodeCost << "]")
-                    newChild->m_travelTimeTotal_ms = travelTimeTotalToEnd_ms;
-                    newChild->m_vehicleID = vehicleId;
-                    newChild->m_taskOptionID = taskOptionId;
-                    //tell the algebra function that we have accounted for this objective
-                    newChild->m_viObjectiveIDs_Assigned.push_back(taskOptionId);
-
-                    //////// update the task //////////
-                    if (newChild->m_taskIdVsAssignmentState.find(taskOptionId) == newChild->m_taskIdVsAssignmentState.end())
+                    m_staticAssignmentParameters->m_numberNodesVisited++;
+                    // calculate assignment cost, this node holds the vehicle states the new child starts from
+                    int64_t nodeCost(INT64_MAX);
+                    int64_t evaluationOrderCost(INT64_MAX);
+                    calculateAssignmentCostBase(vehicleAssignmentState, taskOptionId,
+                                                taskTime_ms, travelTime_ms,
+                                                nodeCost, evaluationOrderCost);
+                    // children extend this node's search order, so they can only win a cost tie if this node can
+                    if (m_staticAssignmentParameters->isBetterThanCandidate(nodeCost, this))
                     {
-                        newChild->m_taskIdVsAssignmentState[taskOptionId] = std::unique_ptr<c_TaskAssignmentState>(new c_TaskAssignmentState(taskOptionId));
+                        // add new child, it only stores its assignment
+                        auto newChild = std::unique_ptr<c_Node_Base>(clone());
+                        newChild->m_parent = this;
+                        newChild->m_nodeCost = nodeCost;
+                        //COUT_INFO_MSG("nodeCost[" << nodeCost << "]")
+                        newChild->m_travelTimeTotal_ms = travelTimeTotalToEnd_ms;
+                        newChild->m_vehicleID = vehicleId;
+                        newChild->m_vehicleIndex = itVehicleInformation->second->m_vehicleIndex;
+                        newChild->m_taskOptionID = taskOptionId;
+                        newChild->m_taskOptionIndex = taskOptionIndex;
+                        newChild->m_timeThreshold_ms = prerequisiteTime_ms;
+                        m_costVsChildren.push_back(std::make_pair(evaluationOrderCost, std::move(newChild)));
+                        m_staticAssignmentParameters->m_numberNodesAdded++;
+                    }
+                    else
+                    {
+                        m_staticAssignmentParameters->m_numberNodesRemoved++;
                     }
-                    newChild->m_taskIdVsAssignmentState[taskOptionId]->m_taskCompletionTime_ms = travelTimeTotalToEnd_ms;
-                    //////// update the vehicle //////////
-                    newChild->m_vehicleIdVsAssignmentState[vehicleAssignmentState->m_vehicleId]->m_travelTimeTotal_ms = travelTimeTotalToEnd_ms;
-                    // add the assignment
-                    auto taskAssignment = std::unique_ptr<uxas::messages::task::TaskAssignment>(new uxas::messages::task::TaskAssignment());
-                    taskAssignment->setTaskID(c_TaskAssignmentState::getTaskID(taskOptionId));
-                    taskAssignment->setOptionID(c_TaskAssignmentState::getOptionID(taskOptionId));
-                    taskAssignment->setAssignedVehicle(vehicleId);
-                    taskAssignment->setTimeThreshold(prerequisiteTime_ms);
-                    taskAssignment->setTimeTaskCompleted(travelTimeTotalToEnd_ms);
-                    newChild->m_vehicleIdVsAssignmentState[vehicleAssignmentState->m_vehicleId]->m_taskAssignments.push_back(std::move(taskAssignment));
-                    m_costVsChildren.insert(std::pair<int64_t, std::unique_ptr<c_Node_Base> >(evaluationOrderCost, std::move(newChild)));
-                    m_staticAssignmentParameters->m_numberNodesAdded++;
-                }
-                else
-                {
-                    newChild.reset();
                 }
             }
             else
             {
+                std::lock_guard<std::mutex> lock(m_staticAssignmentParameters->m_reasonsMutex);
                 m_staticAssignmentParameters->m_reasonsForNoAssignment << "ASSIGNMENT_WARNING:: Vehicle[" << vehicleId << "] exceeded travel time[" << maxVehicleTravelTime_ms << "]!" << std::endl;
             }
         }
         else //if (travelTime_ms > 0)
         {
+            int64_t startingLocationId = vehicleId;
+            if (!vehicleAssignmentState->m_taskAssignments.empty())
+            {
+                auto lastTaskId = vehicleAssignmentState->m_taskAssignments.back()->getTaskID();
+                auto lastOptionId = vehicleAssignmentState->m_taskAssignments.back()->getOptionID();
+                startingLocationId = c_TaskAssignmentState::getTaskAndOptionId(lastTaskId, lastOptionId);
+            }
             //UXAS_LOG_WARN("ASSIGNMENT_WARNING:: No TravelTime_ms[", startingLocationId, ",", taskOptionId, "] found.");
+            std::lock_guard<std::mutex> lock(m_staticAssignmentParameters->m_reasonsMutex);
             m_staticAssignmentParameters->m_reasonsForNoAssignment << "ASSIGNMENT_WARNING:: No TravelTime_ms[" << startingLocationId << "," << taskOptionId << "] found.!" << std::endl;
         } //if (travelTime_ms > 0)
     }
     else //if ( !isError && (itVehicleAssignmentState != m_vehicleIdVsAssignmentState.end()) &&  ... 
     {
+        std::lock_guard<std::mutex> lock(m_staticAssignmentParameters->m_reasonsMutex);
         if (itVehicleInformation == m_staticAssignmentParameters->m_vehicleIdVsInformation.end())
         {
             m_staticAssignmentParameters->m_reasonsForNoAssignment << "ASSIGNMENT_ERROR:: could not find information for VehilceId[" << vehicleId << "]!" << std::endl;
@@ -21,17 +21,26 @@
 #include "Algebra.h"
 
 #include "ServiceBase.h"
+#include "UxAS_ThreadPool.h"
 
 #include "uxas/messages/task/UniqueAutomationRequest.h"
 #include "uxas/messages/task/AssignmentCostMatrix.h"
 #include "uxas/messages/task/TaskPlanOptions.h"
 #include "uxas/messages/task/TaskAssignment.h"
+#include "uxas/messages/task/TaskAssignmentSummary.h"
 #ifdef AFRL_INTERNAL_ENABLED
 #include "uxas/project/pisr/AssignmentType.h"
 #endif
 
+#include <atomic>
+#include <chrono>
+#include <cstddef> // size_t
 #include <cstdint> // int64_t
+#include <functional>
 #include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #define MAX_COST_MS (INT64_MAX / 10000)
 
@@ -40,6 +49,8 @@ namespace uxas
 namespace service
 {
 
+class c_Node_Base;
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 class c_VehicleInformationStatic
@@ -48,14 +59,36 @@ public:
     c_VehicleInformationStatic(const int64_t& vehicleId);
     virtual ~c_VehicleInformationStatic() { };
 public:
-    int64_t getTravelTime_ms(const int64_t& fromId, const int64_t& toId);
-    /*! \brief  vehicle specific costs for shortest paths*/
-    std::unordered_map<int64_t, std::unique_ptr<std::unordered_map<int64_t, int64_t>>> m_FromIdVsToIdVsTravelTime;
+    /*! \brief  sizes the travel time table for the number of task options, all travel times are unknown (-1)*/
+    void initializeTravelTimes(const size_t& numberTaskOptions);
+    /*! \brief  travel time from a location (0 -> vehicle's starting location, i + 1 -> end of
+     * task option i) to the start of task option <B><i>toTaskOptionIndex</i></B>, -1 -> not found*/
+    int64_t getTravelTime_ms(const size_t& fromLocationIndex, const size_t& toTaskOptionIndex) const
+    {
+        return (m_travelTime_ms[fromLocationIndex * m_numberTaskOptions + toTaskOptionIndex]);
+    };
+    void setTravelTime_ms(const size_t& fromLocationIndex, const size_t& toTaskOptionIndex, const int64_t& travelTime_ms)
+    {
+        m_travelTime_ms[fromLocationIndex * m_numberTaskOptions + toTaskOptionIndex] = travelTime_ms;
+    };
+    /*! \brief  calculates m_minimumTimeToComplete_ms from the travel and task times*/
+    void calculateLowerBounds();
+    /*! \brief  time this vehicle needs to perform each task option (by task option index), -1 -> not found*/
+    std::vector<int64_t> m_taskTime_ms;
+    /*! \brief  lower bound on the time from the end of this vehicle's previous assignment to the end of each
+     * task option (minimum travel time from any location plus task time), INT64_MAX -> can not be reached*/
+    std::vector<int64_t> m_minimumTimeToComplete_ms;
     /*! \brief  this is the maximum mission travel time (ms), -1 -> no maximum travel time*/
     int64_t m_maxVehicleTravelTime_ms = {-1};
+    /*! \brief  dense index of this vehicle, see c_StaticAssignmentParameters::m_vehicleIds*/
+    size_t m_vehicleIndex = {0};
 protected:
     /*! \brief  vehicle ID*/
     int64_t m_vehicleId = {0};
+    /*! \brief  number of task options, the travel time table has m_numberTaskOptions + 1 rows and m_numberTaskOptions columns*/
+    size_t m_numberTaskOptions = {0};
+    /*! \brief  vehicle specific costs for shortest paths, row major*/
+    std::vector<int64_t> m_travelTime_ms;
 private:
     /*! @name Private: No Copying*/
     c_VehicleInformationStatic(const c_VehicleInformationStatic& rhs) = delete; //no copying
@@ -74,6 +107,8 @@ public:
     int64_t getTravelTime_ms(const int64_t& VehicleId);
     /*! \brief  the task cost for each vehicle*/
     std::unordered_map<int64_t, int64_t> m_VehicleIdVsTaskTravelTime;
+    /*! \brief  dense index of this task option in the vehicles' travel time tables*/
+    size_t m_taskOptionIndex = {0};
 private:
     /*! @name Private: No Copying*/
     c_TaskInformationStatic(const c_TaskInformationStatic& rhs) = delete; //no copying
@@ -110,6 +145,9 @@ public:
     /*! \brief  this is the sum of the travel times of the current assignments including
      * inter-task travel-times, task-times, and prerequisite-times*/
     int64_t m_travelTimeTotal_ms = {0};
+    /*! \brief  travel time table location of the vehicle after its current assignments
+     * (0 -> starting location, i + 1 -> task option index i)*/
+    size_t m_locationIndex = {0};
 
 private:
     /*! @name Private: No Copying*/
@@ -120,6 +158,65 @@ private:
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+/*! \class c_SearchScratch
+ *  \brief Buffers the nodes of one search thread reuse while they are expanded, instead
+ * of allocating them for each node. Their contents are only valid until the next use.
+ */
+class c_SearchScratch
+{
+public:
+    /*! \brief  vehicle assignment states, lent to the node that is adding its children*/
+    std::unordered_map<int64_t, std::unique_ptr< c_VehicleAssignmentState> > m_vehicleIdVsAssignmentState;
+    /*! \brief  task options assigned from the trunk to a node, in trunk order*/
+    std::vector<int64_t> m_assignedTaskOptionIds;
+    /*! \brief  true for the task options assigned from the trunk to a node, by task option index*/
+    std::vector<bool> m_isTaskOptionAssigned;
+    /*! \brief  node holding the last assignment of each vehicle, by vehicle index*/
+    std::vector<const c_Node_Base*> m_vehicleLastAssignments;
+    /*! \brief  travel time total and information of the vehicles that accept assignments*/
+    std::vector<std::pair<int64_t, c_VehicleInformationStatic*> > m_vehicles;
+    /*! \brief  see c_Node_Base::getSearchOrder*/
+    std::vector<uint32_t> m_searchOrder;
+};
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class c_NodeArena
+ *  \brief Block allocator for the nodes of one search thread. Freed nodes are kept on
+ * free lists and reused by the same arena, all blocks are released at once when the
+ * arena is destroyed. An arena must only be used by one thread at a time.
+ */
+class c_NodeArena
+{
+public:
+    c_NodeArena() { };
+    ~c_NodeArena() { };
+public:
+    void* allocate(const size_t& size);
+    void deallocate(void* memory, const size_t& size);
+    /*! \brief  arena that nodes created on the calling thread are allocated from (nullptr -> heap)*/
+    static c_NodeArena*& threadArena();
+    /*! \brief  scratch buffers of the thread using this arena, released with the arena*/
+    c_SearchScratch m_scratch;
+private:
+    /*! \brief  allocations are rounded up to multiples of this, which keeps them aligned*/
+    static const size_t s_alignment = {16};
+    static const size_t s_blockSize = {64 * 1024};
+    std::vector<std::unique_ptr<char[]> > m_blocks;
+    char* m_blockNext = {nullptr};
+    char* m_blockEnd = {nullptr};
+    /*! \brief  allocation size and first free chunk of that size, the chunks are linked through their first bytes*/
+    std::vector<std::pair<size_t, void*> > m_sizeVsFreeList;
+private:
+    /*! @name Private: No Copying*/
+    c_NodeArena(const c_NodeArena& rhs) = delete; //no copying
+    c_NodeArena operator=(const c_NodeArena&) = delete; //no copying
+};
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 class c_StaticAssignmentParameters
 {
 public:
@@ -138,26 +235,79 @@ public:
 public:
     std::unordered_map<int64_t, std::unique_ptr<c_VehicleInformationStatic>> m_vehicleIdVsInformation;
     std::unordered_map<int64_t, std::unique_ptr<c_TaskInformationStatic>> m_taskOptionIdVsInformation;
-    int64_t m_minimumAssignmentCostCandidate = {INT64_MAX};
+    /*! \brief  vehicle IDs by vehicle index*/
+    std::vector<int64_t> m_vehicleIds;
+    /*! \brief  groups of task option indices, at least one task option of each group must be
+     * part of every complete assignment (derived from the algebra). Used for lower bounds.*/
+    std::vector<std::vector<size_t> > m_requiredTaskOptionIndexGroups;
+    /*! \brief  task option indices of a previous assignment, in order, by vehicle index. The search
+     * follows these assignments first, so their cost bounds the rest of the search (warm start).*/
+    std::vector<std::vector<size_t> > m_warmStartTaskOptionIndices;
+    /*! \brief  cost of the current candidate assignment, shared by all search threads as the pruning bound*/
+    std::atomic<int64_t> m_minimumAssignmentCostCandidate{INT64_MAX};
     int64_t m_minimumAssignmentTravelTimeCandidate_ms = {INT64_MAX};
-    int64_t m_numberNodesVisited = {0};
-    int64_t m_numberNodesAdded = {0};
-    int64_t m_numberNodesPruned = {0};
-    int64_t m_numberNodesRemoved = {0};
-    int64_t m_numberCompleteAssignments = {0};
+    std::atomic<int64_t> m_numberNodesVisited{0};
+    std::atomic<int64_t> m_numberNodesAdded{0};
+    std::atomic<int64_t> m_numberNodesPruned{0};
+    std::atomic<int64_t> m_numberNodesRemoved{0};
+    std::atomic<int64_t> m_numberCompleteAssignments{0};
 
     uxas::common::utilities::CAlgebra algebra; // ALGEBRA:: Algebra class definition
 
-    bool m_isStopCondition = {false};
+    std::atomic<bool> m_isStopCondition{false};
+    /*! \brief  this flag controls calling the calculateFinalAssignment function only once */
+    std::atomic<bool> m_isFinalAssignmentCalculated{false};
 
     int64_t m_numberNodesMaximum = {0};  // default to best-first search
     CostFunction m_CostFunction = {CostFunction::MINMAX};
     int64_t m_assignmentStartTime_ms = {0};
+    /*! \brief  the search stops at this time, once it has found a complete assignment (only if m_isDeadline)*/
+    std::chrono::steady_clock::time_point m_deadline;
+    bool m_isDeadline = {false};
+    std::atomic<bool> m_isDeadlineReached{false};
+    /*! \brief  called with each new candidate assignment, on the publishing thread (empty -> not called)*/
+    std::function<void()> m_newCandidateCallback;
+    /*! \brief  thread that calls m_newCandidateCallback, i.e. the thread that started the search*/
+    std::thread::id m_publishingThreadId;
+    /*! \brief  m_numberCompleteAssignments when m_newCandidateCallback was last called*/
+    int64_t m_numberCompleteAssignmentsPublished = {0};
 
     std::stringstream m_reasonsForNoAssignment;
     
     /*! \brief  these are vehicle assignment parameters that do change during the assignment*/
     std::unordered_map<int64_t, std::unique_ptr< c_VehicleAssignmentState> > m_candidateVehicleIdVsAssignmentState;
+    /*! \brief  search order (child rank at each tree level) of the candidate assignment, breaks cost ties*/
+    std::vector<uint32_t> m_candidateSearchOrder;
+    /*! \brief  guards the candidate assignment (cost, search order and assignment states)*/
+    std::mutex m_candidateMutex;
+    /*! \brief  guards m_reasonsForNoAssignment*/
+    std::mutex m_reasonsMutex;
+    /*! \brief  arenas holding the search nodes, their memory is released with these parameters*/
+    std::vector<std::unique_ptr<c_NodeArena> > m_nodeArenas;
+    /*! \brief  guards m_nodeArenas*/
+    std::mutex m_nodeArenasMutex;
+
+public:
+    /*! \brief  returns true if a node with this cost and the search order of <B><i>node</i></B> can
+     * still lead to an assignment that replaces the candidate. Equal costs are resolved in favor of
+     * the lowest search order, i.e. the assignment a serial depth first search finds first.*/
+    bool isBetterThanCandidate(const int64_t& cost, const c_Node_Base* node);
+    /*! \brief  same as isBetterThanCandidate, m_candidateMutex must be held by the caller*/
+    bool isBetterThanCandidateLocked(const int64_t& cost, const c_Node_Base* node);
+    /*! \brief  creates an arena for the nodes of one search thread, it lives as long as these parameters*/
+    c_NodeArena* addNodeArena();
+    /*! \brief  sets the stop condition if the deadline has passed and there is a candidate assignment*/
+    void checkDeadline();
+    /*! \brief  calls checkDeadline on every s_deadlineSamplingInterval-th call of the calling thread,
+     * which keeps the clock out of the per-node work*/
+    void sampleDeadline();
+    /*! \brief  calls m_newCandidateCallback if the candidate changed since its last call. Only acts on
+     * the publishing thread, candidates found by other threads are published on its next call
+     * (at the latest after s_publishingPeriod_ms, see c_Node_Base::ExpandNodeParallel).*/
+    void publishNewCandidate();
+
+    static const uint32_t s_deadlineSamplingInterval = {64};
+    static const int64_t s_publishingPeriod_ms = {10};
 
 private:
     /*! @name Private: No Copying*/
@@ -208,6 +358,11 @@ private:
 ////////////////////////////////////////////////////
 ////////////////////////////////////////////////////
 
+/*! \class c_Node_Base
+ *  \brief Node of the assignment tree. A node only stores its assignment (vehicle, task
+ * option and completion time), everything else is shared with its ancestors through
+ * m_parent. Nodes are allocated from the arena of the thread that creates them.
+ */
 class c_Node_Base
 {
 public: //constructors/destructors
@@ -216,9 +371,16 @@ public: //constructors/destructors
     virtual ~c_Node_Base();
 
     c_Node_Base(const c_Node_Base& rhs);
+
+    static void* operator new(std::size_t size);
+    static void operator delete(void* memory, std::size_t size);
     
 public: //member functions - prototypes
     virtual void ExpandNode();
+    /*! \brief  expands the top of the tree breadth first until there are enough subtrees
+     * to keep the threads of the pool busy, then searches the subtrees in parallel. All
+     * threads prune against the shared candidate cost.*/
+    void ExpandNodeParallel(uxas::common::ThreadPool& threadPool);
 protected: //member functions - prototypes
     virtual std::unique_ptr<c_Node_Base> clone();
     virtual void NodeAssignment(std::unique_ptr<c_VehicleAssignmentState>& vehicleAssignmentState, const int64_t& taskOptionId, const int64_t& prerequisiteTaskOptionId);
@@ -230,37 +392,58 @@ protected: //member functions - prototypes
 public: // member functions - prototypes
     void PruneChildren();
     void printStatus(const std::string& Message);
+    /*! \brief  rank of this node among its siblings at each level, from the trunk to
+     * this node. Orders nodes the way a serial depth first search visits them.*/
+    void getSearchOrder(std::vector<uint32_t>& searchOrder) const;
 
 private:    // base member functions
+    /*! \brief  rebuilds the vehicle assignment states of this node from the trunk's states and
+     * the assignments of its ancestors in the states of <B><i>scratch</i></B>, which it lends to this
+     * node (see AddChildren), and returns the assigned task options in scratch.m_assignedTaskOptionIds*/
+    void restoreVehicleAssignmentStates(c_SearchScratch& scratch);
+    bool AddChildren();
+    void ExpandChildren();
+    /*! \brief  returns the index of the child that continues the warm start assignment and marks it as
+     * part of the warm start path (the first child if none does). Only for nodes on the warm start path.*/
+    size_t findWarmStartChild();
+    void EvaluateLeaf(const bool& bTaskAvailable);
+    void EvaluateStopCondition();
+    /*! \brief  lower bound on the cost of all complete assignments below this node*/
+    int64_t calculateLowerBound();
+    /*! \brief  true if the node cost is the maximum vehicle travel time (MINMAX), which the lower bounds assume*/
+    bool isMinMaxCost();
     void calculateAssignmentCostBase(std::unique_ptr<c_VehicleAssignmentState>& vehicleAssignmentState, const int64_t& taskOptionId,
                                             const int64_t& taskTime_ms, const int64_t& travelTime_ms,
                                             int64_t& nodeCost, int64_t& evaluationOrderCost);
     
 public:
-    /*! \brief  these are assignment parameters that do not change during the assignment*/
-    static std::unique_ptr<c_StaticAssignmentParameters> m_staticAssignmentParameters;
-    /*! \brief  this flag controls calling the calculateFinalAssignment function only once */
-    static bool m_isFinalAssignmentCalculated;
-    /*! \brief  these are vehicle assignment parameters that do change during the assignment*/
+    /*! \brief  parameters of the search this node belongs to, shared by all of its nodes
+     * (set on the trunk by AssignmentTreeBranchBoundBase::isInitializeAssignment)*/
+    c_StaticAssignmentParameters* m_staticAssignmentParameters = {nullptr};
+    /*! \brief  these are vehicle assignment parameters that do change during the assignment. The trunk
+     * holds the initial states, all other nodes only while their children are added (without task assignments)*/
     std::unordered_map<int64_t, std::unique_ptr< c_VehicleAssignmentState> > m_vehicleIdVsAssignmentState; //available vehicle and their state for this node
-    /*! \brief  these are task assignment parameters that do change during the assignment*/
-    std::unordered_map<int64_t, std::unique_ptr< c_TaskAssignmentState> > m_taskIdVsAssignmentState; //tasks and their state for this node
 #ifdef AFRL_INTERNAL_ENABLED
     /*! \brief  this is used to determine the type of cost calculation to call */
     static uxas::project::pisr::AssignmentType::AssignmentType m_assignmentType;
 #endif
     
 protected: //member storage
-    /*! \brief map of children of this node, sorted by cost */
-    std::multimap<int64_t, std::unique_ptr<c_Node_Base> > m_costVsChildren;
-    std::vector<int64_t> m_viObjectiveIDs_Assigned;
+    /*! \brief children of this node, sorted by cost (stable, equal costs in the order they were added) */
+    std::vector<std::pair<int64_t, std::unique_ptr<c_Node_Base> > > m_costVsChildren;
+    /*! \brief  node this node extends (nullptr -> trunk)*/
+    c_Node_Base* m_parent = {nullptr};
 
-    // added for information
+    /*! \brief  the assignment added by this node*/
     int64_t m_vehicleID{0};
+    size_t m_vehicleIndex{0};
     int64_t m_taskOptionID{0};
+    size_t m_taskOptionIndex{0};
+    /*! \brief  prerequisite time of this node's assignment*/
+    int64_t m_timeThreshold_ms = {0};
     
-    /*! \brief  this is the travel time of the assignments, including this node and
-     *  it's predecessors from the trunk to the current node*/
+    /*! \brief  this is the travel time of the assigned vehicle, including this node and
+     *  it's predecessors from the trunk to the current node, i.e. the time the task is completed*/
     int64_t m_travelTimeTotal_ms = {0};
     
     bool m_isPruneable = {true}; //can this node be pruned
@@ -268,6 +451,10 @@ protected: //member storage
 
     int64_t m_nodeCost{0};
     
+    /*! \brief  rank of this node among its siblings, see getSearchOrder*/
+    uint32_t m_childRank{0};
+    /*! \brief  true if this node follows the warm start assignment, its children are expanded warm start first*/
+    bool m_isOnWarmStartPath{false};
     
 private:
     /*! @name Private: No Copying*/
@@ -286,13 +473,29 @@ private:
  * Configuration String: 
  * 
  * Options:
- *  - 
+ *  - AssignmentThreadCount - number of threads used to search the assignment tree
+ *    (1 - serial [default], 0 - number of hardware threads). Only searches without
+ *    a node limit (NumberNodesMaximum < 0) run in parallel, the nodes visited before
+ *    reaching a node limit depend on thread timing.
+ *  - AssignmentDeadline_ms - maximum search time (-1 - no deadline [default]). At the
+ *    deadline the search stops with the best assignment found so far, if it has not
+ *    found a complete assignment, yet, it stops at the first one.
+ *  - PublishProvisionalAssignments - if true, each improving assignment found during
+ *    the search is sent as a provisional TaskAssignmentSummary (default false).
+ *  - WarmStartAssignment - if true, the search first follows the previous assignment
+ *    (tasks that are no longer requested are skipped, new tasks are added greedily).
+ *    The first complete assignment is then close to the previous one and bounds the
+ *    rest of the search. Exhaustive searches find the same assignment as without warm
+ *    start (default false).
  * 
  * Subscribed Messages:
  *  - 
  * 
  * Sent Messages:
- *  - 
+ *  - TaskAssignmentSummary (final assignment)
+ *  - TaskAssignmentSummary, to s_provisionalAssignmentAddress() (provisional assignments).
+ *    Subscribers of TaskAssignmentSummary do not receive these.
+ * 
  * 
  */
 
@@ -308,6 +511,12 @@ public:
     virtual
     ~AssignmentTreeBranchBoundBase();
 
+    /** brief Address provisional assignments are sent to. The address
+     * is not prefixed by the TaskAssignmentSummary type name, so subscribers of
+     * TaskAssignmentSummary only receive final assignments. */
+    static const std::string&
+    s_provisionalAssignmentAddress() { static std::string s_string("ProvisionalTaskAssignmentSummary"); return (s_string); };
+
 private:
 
     /** brief Copy construction not permitted */
@@ -364,6 +573,19 @@ protected: //virtual
     virtual void runCalculateAssignment(const std::shared_ptr<AssigmentPrerequisites>& assigmentPrerequisites);
     /** brief starts the branch and bound assignment. */
     virtual void calculateAssignment(std::unique_ptr<c_Node_Base> nodeAssignment,const std::shared_ptr<AssigmentPrerequisites>& assigmentPrerequisites);
+    /** brief compiles the task plan options, the cost matrix and the algebra into new static
+     * assignment parameters, which it links to the trunk node, and the vehicle states of the trunk node. */
+    bool isInitializeAssignment(c_Node_Base& nodeAssignment, const std::shared_ptr<AssigmentPrerequisites>& assigmentPrerequisites);
+    /** brief searches the assignment tree below the trunk node (in parallel, if configured),
+     * the best assignment found is the candidate assignment. */
+    void searchAssignment(c_Node_Base& nodeAssignment, const std::shared_ptr<AssigmentPrerequisites>& assigmentPrerequisites);
+    /** brief keeps the final assignment, the next search starts from it (only if m_isWarmStartAssignment). */
+    void setWarmStartAssignment(const std::shared_ptr<uxas::messages::task::TaskAssignmentSummary>& taskAssignmentSummary);
+    /** brief deletes the trunk node and releases the memory of all search nodes. The static
+     * assignment parameters are kept, they hold the candidate assignment. */
+    static void releaseAssignmentNodes(std::unique_ptr<c_Node_Base> nodeAssignment);
+    /** brief builds a TaskAssignmentSummary from the current candidate assignment. */
+    std::shared_ptr<uxas::messages::task::TaskAssignmentSummary> getCandidateAssignmentSummary(const std::shared_ptr<AssigmentPrerequisites>& assigmentPrerequisites);
     void sendErrorMsg(std::string& errStr);
 
 
@@ -371,9 +593,23 @@ protected:
     
     
     bool m_isUsingAssignmentTypes{false};
+    /*! \brief  parameters of the current (or last) search of this service, its nodes share them */
+    std::unique_ptr<c_StaticAssignmentParameters> m_staticAssignmentParameters;
     std::unordered_map<int64_t,std::shared_ptr<AssigmentPrerequisites> > m_idVsAssigmentPrerequisites;
     int64_t m_numberNodesMaximum = {0}; // default to best-first search
     c_StaticAssignmentParameters::CostFunction m_CostFunction = {c_StaticAssignmentParameters::CostFunction::MINMAX};
+    /*! \brief  maximum search time (ms), -1 -> no deadline */
+    int64_t m_assignmentDeadline_ms{-1};
+    /*! \brief  publish each improving candidate assignment, before the final one */
+    bool m_isPublishingProvisionalAssignments{false};
+    /*! \brief  start each search from the previous assignment */
+    bool m_isWarmStartAssignment{false};
+    /*! \brief  task options of the previous assignment, in order, by vehicle ID */
+    std::unordered_map<int64_t, std::vector<int64_t> > m_previousVehicleIdVsTaskOptionIds;
+    /*! \brief  number of threads used to search the assignment tree, 1 -> serial search */
+    uint32_t m_assignmentThreadCount{1};
+    /*! \brief  threads used to search the assignment tree (only if m_assignmentThreadCount > 1) */
+    std::unique_ptr<uxas::common::ThreadPool> m_assignmentThreadPool;
 
 };
 }; //namespace service
@@ -57,6 +57,10 @@ private:
  * Options:
  *  - NumberNodesMaximum
  *  - CostFunction
+ *  - AssignmentThreadCount
+ *  - AssignmentDeadline_ms
+ *  - PublishProvisionalAssignments
+ *  - WarmStartAssignment
  * 
  * Subscribed Messages:
  *  - uxas::messages::task::UniqueAutomationRequest
@@ -67,6 +71,7 @@ private:
  * Sent Messages:
  *  - afrl::cmasi::ServiceStatus
  *  - uxas::messages::task::TaskAssignmentSummary
+ *  - uxas::messages::task::TaskAssignmentSummary (provisional, to AssignmentTreeBranchBoundBase::s_provisionalAssignmentAddress())
  * 
  */
 
@@ -16,7 +16,10 @@
 #include "UxAS_XmlUtil.h"
 
 #include "FileSystemUtilities.h"
+#include "LmcpObjectSerializer.h"
+#include "MessageEnvelope.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 #include <cstdint>
@@ -34,6 +37,10 @@ MessageLoggerDataService::ServiceBase::CreationRegistrar<MessageLoggerDataServic
 MessageLoggerDataService::MessageLoggerDataService()
 : ServiceBase(MessageLoggerDataService::s_typeName(), MessageLoggerDataService::s_directoryName())
 {
+    // receive serialized messages so that LMCP format logging never deserializes
+    m_receiveProcessingType = uxas::communications::LmcpObjectNetworkClientBase::ReceiveProcessingType::SERIALIZED_LMCP;
+    // log the KillService messages of other services as well
+    m_isOtherKillServiceProcessingPermitted = true;
 };
 
 MessageLoggerDataService::~MessageLoggerDataService()
@@ -47,6 +54,11 @@ MessageLoggerDataService::~MessageLoggerDataService()
     {
         m_fileLogger->closeStream();
     }
+
+    if (m_recordWriter.isOpen())
+    {
+        m_recordWriter.close();
+    }
 };
 
 bool
@@ -65,6 +77,67 @@ MessageLoggerDataService::configure(const pugi::xml_node& serviceXmlNode)
             UXAS_LOG_WARN(s_typeName(), "::configure retaining m_logFileMessageCountLimit value ", m_logFileMessageCountLimit, "; ignoring invalid value from XML");
         }
     }
+
+    if (!serviceXmlNode.attribute(uxas::common::StringConstant::LogDatabaseFormat().c_str()).empty())
+    {
+        std::string logDatabaseFormat = serviceXmlNode.attribute(uxas::common::StringConstant::LogDatabaseFormat().c_str()).value();
+        if (logDatabaseFormat == "lmcp" || logDatabaseFormat == "xml")
+        {
+            m_isLmcpDatabaseFormat = (logDatabaseFormat == "lmcp");
+            UXAS_LOG_INFORM(s_typeName(), "::configure set database format to ", logDatabaseFormat, " from XML");
+        }
+        else
+        {
+            UXAS_LOG_WARN(s_typeName(), "::configure retaining database format ", (m_isLmcpDatabaseFormat ? "lmcp" : "xml"), "; ignoring invalid value ", logDatabaseFormat, " from XML");
+        }
+    }
+
+    if (!serviceXmlNode.attribute(uxas::common::StringConstant::LogDatabaseBatchCount().c_str()).empty())
+    {
+        uint32_t logDatabaseBatchCountFromXml = serviceXmlNode.attribute(uxas::common::StringConstant::LogDatabaseBatchCount().c_str()).as_uint();
+        if (logDatabaseBatchCountFromXml > 0)
+        {
+            m_logDatabaseBatchCount = logDatabaseBatchCountFromXml;
+            m_logDatabaseQueueCountLimit = std::max(m_logDatabaseQueueCountLimit, m_logDatabaseBatchCount);
+            UXAS_LOG_INFORM(s_typeName(), "::configure set m_logDatabaseBatchCount value to ", m_logDatabaseBatchCount, " from XML");
+        }
+        else
+        {
+            UXAS_LOG_WARN(s_typeName(), "::configure retaining m_logDatabaseBatchCount value ", m_logDatabaseBatchCount, "; ignoring invalid value from XML");
+        }
+    }
+
+    if (!serviceXmlNode.attribute(uxas::common::StringConstant::LogDatabaseBatchPeriod_ms().c_str()).empty())
+    {
+        m_logDatabaseBatchPeriod_ms = serviceXmlNode.attribute(uxas::common::StringConstant::LogDatabaseBatchPeriod_ms().c_str()).as_uint();
+        UXAS_LOG_INFORM(s_typeName(), "::configure set m_logDatabaseBatchPeriod_ms value to ", m_logDatabaseBatchPeriod_ms, " from XML");
+    }
+
+    if (!serviceXmlNode.attribute(uxas::common::StringConstant::LogRecording().c_str()).empty())
+    {
+        m_isRecording = serviceXmlNode.attribute(uxas::common::StringConstant::LogRecording().c_str()).as_bool();
+        UXAS_LOG_INFORM(s_typeName(), "::configure set m_isRecording value to ", m_isRecording, " from XML");
+    }
+
+    if (!serviceXmlNode.attribute(uxas::common::StringConstant::LogRecordingCompressed().c_str()).empty())
+    {
+        m_isRecordingCompressed = serviceXmlNode.attribute(uxas::common::StringConstant::LogRecordingCompressed().c_str()).as_bool();
+        UXAS_LOG_INFORM(s_typeName(), "::configure set m_isRecordingCompressed value to ", m_isRecordingCompressed, " from XML");
+    }
+
+    if (!serviceXmlNode.attribute(uxas::common::StringConstant::LogRecordingChunkSize_kB().c_str()).empty())
+    {
+        uint32_t recordingChunkSizeFromXml = serviceXmlNode.attribute(uxas::common::StringConstant::LogRecordingChunkSize_kB().c_str()).as_uint();
+        if (recordingChunkSizeFromXml > 0 && recordingChunkSizeFromXml <= 65536)
+        {
+            m_recordingChunkSize_kB = recordingChunkSizeFromXml;
+            UXAS_LOG_INFORM(s_typeName(), "::configure set m_recordingChunkSize_kB value to ", m_recordingChunkSize_kB, " from XML");
+        }
+        else
+        {
+            UXAS_LOG_WARN(s_typeName(), "::configure retaining m_recordingChunkSize_kB value ", m_recordingChunkSize_kB, "; ignoring invalid value from XML");
+        }
+    }
     
     for (pugi::xml_node currentXmlNode = serviceXmlNode.first_child(); currentXmlNode; currentXmlNode = currentXmlNode.next_sibling())
     {
@@ -94,7 +167,8 @@ MessageLoggerDataService::initialize()
 
         if (isDatabaseLoggerSuccess)
         {
-            std::string dbTableColumnNames{"id,time_ms,descriptor,groupID,entityID,serviceID,xml"};
+            std::string messageColumnName{m_isLmcpDatabaseFormat ? "lmcp" : "xml"};
+            std::string dbTableColumnNames{"id,time_ms,descriptor,groupID,entityID,serviceID," + messageColumnName};
 
             std::string dbTableName{"msg"};
 
@@ -105,11 +179,17 @@ MessageLoggerDataService::initialize()
             dbTableCreate.append(", groupID TEXT NOT NULL");
             dbTableCreate.append(", entityID INTEGER NOT NULL");
             dbTableCreate.append(", serviceID INTEGER NOT NULL");
-            dbTableCreate.append(", xml BLOB NOT NULL)");
+            dbTableCreate.append(", " + messageColumnName + " BLOB NOT NULL)");
 
             isDatabaseLoggerSuccess = static_cast<uxas::common::log::DatabaseLogger*>(m_databaseLogger.get())->configureDatabase(dbTableCreate, dbTableName, dbTableColumnNames);
         }
 
+        if (isDatabaseLoggerSuccess)
+        {
+            isDatabaseLoggerSuccess = static_cast<uxas::common::log::DatabaseLogger*>(m_databaseLogger.get())->configureBatchedWriter(
+                    m_logDatabaseBatchCount, m_logDatabaseBatchPeriod_ms, m_logDatabaseQueueCountLimit);
+        }
+
         if (isDatabaseLoggerSuccess)
         {
             isDatabaseLoggerSuccess = m_databaseLogger->openStream(m_logFilePath);
@@ -146,34 +226,76 @@ MessageLoggerDataService::initialize()
         }
     }
     
-    return (isDatabaseLoggerSuccess && isFileLoggerSuccess);
+    bool isRecordingSuccess{true};
+    if (m_isRecording)
+    {
+        std::string recordingFilePath = m_workDirectoryPath + "messageLog"
+                + (isTimeStamp ? ('_' + std::to_string(uxas::common::Time::getInstance().getUtcTimeSinceEpoch_ms())) : "") + ".uxr";
+        isRecordingSuccess = m_recordWriter.open(recordingFilePath, m_isRecordingCompressed, m_recordingChunkSize_kB * 1024);
+        if (isRecordingSuccess)
+        {
+            UXAS_LOG_INFORM(s_typeName(), "::initialize opened message recording ", recordingFilePath);
+        }
+        else
+        {
+            UXAS_LOG_ERROR(s_typeName(), "::initialize failed to open message recording ", recordingFilePath);
+        }
+    }
+    
+    return (isDatabaseLoggerSuccess && isFileLoggerSuccess && isRecordingSuccess);
 };
 
 bool
-MessageLoggerDataService::processReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage)
+MessageLoggerDataService::processReceivedSerializedLmcpMessage(std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> receivedSerializedLmcpMessage)
 {
-    UXAS_LOG_DEBUG_VERBOSE(s_typeName(), "::processReceivedLmcpMessage BEFORE logging received message");
+    UXAS_LOG_DEBUG_VERBOSE(s_typeName(), "::processReceivedSerializedLmcpMessage BEFORE logging received message");
+
+    const auto& attributes = receivedSerializedLmcpMessage->getMessageAttributesReference();
+    int64_t time_ms = uxas::common::Time::getInstance().getUtcTimeSinceEpoch_ms();
+
+    if (m_recordWriter.isOpen())
+    {
+        uint32_t sourceEntityId{0};
+        uint32_t sourceServiceId{0};
+        uxas::communications::data::MessageEnvelope::toSourceId(attributes->getSourceEntityId(), sourceEntityId);
+        uxas::communications::data::MessageEnvelope::toSourceId(attributes->getSourceServiceId(), sourceServiceId);
+        m_recordWriter.writeRecord(time_ms, receivedSerializedLmcpMessage->getAddress(), attributes->getDescriptor(), attributes->getSourceGroup(),
+                                   sourceEntityId, sourceServiceId, receivedSerializedLmcpMessage->getPayload());
+    }
+
+    // XML is needed by the file logger and the XML database format
+    std::string xml;
+    if (m_fileLogger || (m_databaseLogger && !m_isLmcpDatabaseFormat))
+    {
+        std::unique_ptr<avtas::lmcp::Object> lmcpObject = uxas::communications::LmcpObjectSerializer::deserialize(receivedSerializedLmcpMessage->getPayload());
+        if (lmcpObject)
+        {
+            xml = lmcpObject->toXML();
+        }
+    }
     
-    if (m_databaseLogger)
+    if (m_databaseLogger && (m_isLmcpDatabaseFormat || !xml.empty()))
     {
-        std::string XML = receivedLmcpMessage->m_object->toXML();
-        //uxas::common::XmlUtil::escapeXmlQuoteApostropheChars(XML);
-        m_databaseLogger->outputTextToStream("NULL,'" +
-                std::to_string(uxas::common::Time::getInstance().getUtcTimeSinceEpoch_ms()) + "','" +
-                receivedLmcpMessage->m_attributes->getDescriptor() + "','" +
-                receivedLmcpMessage->m_attributes->getSourceGroup() + "','" +
-                receivedLmcpMessage->m_attributes->getSourceEntityId() + "','" +
-                receivedLmcpMessage->m_attributes->getSourceServiceId() + "','" +
-                XML + "'");
+        std::vector<uxas::common::log::DatabaseColumnValue> row;
+        row.reserve(7);
+        row.push_back(uxas::common::log::DatabaseColumnValue::null());
+        row.push_back(uxas::common::log::DatabaseColumnValue::integer(time_ms));
+        row.push_back(uxas::common::log::DatabaseColumnValue::text(attributes->getDescriptor()));
+        row.push_back(uxas::common::log::DatabaseColumnValue::text(attributes->getSourceGroup()));
+        row.push_back(uxas::common::log::DatabaseColumnValue::text(attributes->getSourceEntityId()));
+        row.push_back(uxas::common::log::DatabaseColumnValue::text(attributes->getSourceServiceId()));
+        row.push_back(m_isLmcpDatabaseFormat ? uxas::common::log::DatabaseColumnValue::blob(receivedSerializedLmcpMessage->getPayload())
+                      : uxas::common::log::DatabaseColumnValue::text(xml));
+        static_cast<uxas::common::log::DatabaseLogger*>(m_databaseLogger.get())->outputRowToTable(std::move(row));
     }
     
-    if (m_fileLogger)
+    if (m_fileLogger && !xml.empty())
     {
-        m_fileLogger->outputTimeTextToStream(receivedLmcpMessage->m_attributes->getString());
-        m_fileLogger->outputTextToStream(receivedLmcpMessage->m_object->toXML());
+        m_fileLogger->outputTimeTextToStream(attributes->getString());
+        m_fileLogger->outputTextToStream(xml);
     }
     
-    UXAS_LOG_DEBUG_VERBOSE(s_typeName(), "::processReceivedLmcpMessage AFTER logging received message");
+    UXAS_LOG_DEBUG_VERBOSE(s_typeName(), "::processReceivedSerializedLmcpMessage AFTER logging received message");
 
     return (false); // always false implies never terminating service from here
 };
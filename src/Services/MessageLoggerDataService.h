@@ -16,6 +16,7 @@
 
 #include "UxAS_DatabaseLogger.h"
 #include "UxAS_FileLogger.h"
+#include "UxAS_MessageRecording.h"
 
 //#include "UxAS_TypeDefs_String.h"
 
@@ -34,8 +35,12 @@ namespace data
  * either all or a subset of service messages.
  * 
  * 
+ * Database rows are written by a background thread that commits one 
+ * transaction per batch, so the service thread does not wait on disk I/O.
+ * 
  * Configuration String: 
- *  <Service Type="MessageLoggerDataService" LogFileMessageCountLimit="10000">
+ *  <Service Type="MessageLoggerDataService" LogFileMessageCountLimit="10000"
+ *           LogDatabaseFormat="xml" LogDatabaseBatchCount="1000" LogDatabaseBatchPeriod_ms="500">
  *      <LogMessage MessageType="uxas.messages.task.AssignmentCostMatrix" />
  *  </Service>
  *
@@ -43,6 +48,22 @@ namespace data
  *  - LogFileMessageCountLimit
  *     (if provided, turns on additional plain text file logging with each
  *      file containing 'LogFileMessageCountLimit' number of messages)
+ *  - LogDatabaseFormat
+ *     ("xml" (default) stores each message as LMCP XML in column 'xml';
+ *      "lmcp" stores the received serialized LMCP message in column 'lmcp',
+ *      avoiding deserialization and XML conversion)
+ *  - LogDatabaseBatchCount
+ *     (number of queued messages that triggers a database commit)
+ *  - LogDatabaseBatchPeriod_ms
+ *     (maximum time a queued message waits before it is committed)
+ *  - LogRecording
+ *     (if "true", also writes the received serialized messages to a binary
+ *      recording 'messageLog.uxr' that can be replayed by the
+ *      MessageReplayService - see UxAS_MessageRecording.h)
+ *  - LogRecordingCompressed
+ *     (if "false", recording chunks are not zlib compressed; default "true")
+ *  - LogRecordingChunkSize_kB
+ *     (uncompressed size of recording chunks; default 256)
  * 
  * Subscribed Messages:
  *  - all those in "LogMessage" entries
@@ -99,11 +120,19 @@ private:
     initialize() override;
 
     bool
-    processReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage) override;
+    processReceivedSerializedLmcpMessage(std::unique_ptr<uxas::communications::data::AddressedAttributedMessage> receivedSerializedLmcpMessage) override;
 
     bool isDatabaseLogger{true};  // always save to database log
     bool isFileLogger{false};     // only save to file if message count limit provided
+    bool m_isLmcpDatabaseFormat{false};
     uint32_t m_logDatabaseMessageCountLimit{UINT32_MAX};
+    uint32_t m_logDatabaseBatchCount{1000};
+    uint32_t m_logDatabaseBatchPeriod_ms{500};
+    uint32_t m_logDatabaseQueueCountLimit{100000};
+    bool m_isRecording{false};
+    bool m_isRecordingCompressed{true};
+    uint32_t m_recordingChunkSize_kB{256};
+    uxas::common::log::MessageRecordWriter m_recordWriter;
     uint32_t m_logFileMessageCountLimit{0};
     std::unique_ptr<uxas::common::log::LoggerBase> m_databaseLogger;
     std::unique_ptr<uxas::common::log::LoggerBase> m_fileLogger;
@@ -0,0 +1,221 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#include "MessageReplayService.h"
+
+#include "SerializedLmcpObject.h"
+
+#include "uxas/messages/uxnative/StartupComplete.h"
+
+#include "UxAS_Log.h"
+#include "Constants/UxAS_String.h"
+#include "stdUniquePtr.h"
+
+#include <algorithm>
+#include <chrono>
+
+#define STRING_XML_RECORDING_FILE "RecordingFile"
+#define STRING_XML_REPLAY_SPEED "ReplaySpeed"
+#define STRING_XML_START_TIME_MS "StartTime_ms"
+#define STRING_XML_IS_WAIT_FOR_STARTUP "IsWaitForStartup"
+#define STRING_XML_REPLAY_MESSAGE "ReplayMessage"
+
+namespace uxas
+{
+namespace service
+{
+namespace data
+{
+
+MessageReplayService::ServiceBase::CreationRegistrar<MessageReplayService>
+        MessageReplayService::s_registrar(MessageReplayService::s_registryServiceTypeNames());
+
+MessageReplayService::MessageReplayService()
+: ServiceBase(MessageReplayService::s_typeName(), MessageReplayService::s_directoryName())
+{
+};
+
+MessageReplayService::~MessageReplayService()
+{
+    m_isTerminate = true;
+    if (m_replayThread && m_replayThread->joinable())
+    {
+        m_replayThread->join();
+    }
+};
+
+bool
+MessageReplayService::configure(const pugi::xml_node& serviceXmlNode)
+{
+    m_recordingFilePath = serviceXmlNode.attribute(STRING_XML_RECORDING_FILE).value();
+    if (m_recordingFilePath.empty())
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::configure requires the ", STRING_XML_RECORDING_FILE, " attribute");
+        return (false);
+    }
+
+    if (!serviceXmlNode.attribute(STRING_XML_REPLAY_SPEED).empty())
+    {
+        double replaySpeed = serviceXmlNode.attribute(STRING_XML_REPLAY_SPEED).as_double();
+        if (replaySpeed >= 0.0)
+        {
+            m_replaySpeed = replaySpeed;
+            UXAS_LOG_INFORM(s_typeName(), "::configure set m_replaySpeed value to ", m_replaySpeed, " from XML");
+        }
+        else
+        {
+            UXAS_LOG_WARN(s_typeName(), "::configure retaining m_replaySpeed value ", m_replaySpeed, "; ignoring invalid value from XML");
+        }
+    }
+
+    if (!serviceXmlNode.attribute(STRING_XML_START_TIME_MS).empty())
+    {
+        m_startTime_ms = serviceXmlNode.attribute(STRING_XML_START_TIME_MS).as_llong();
+    }
+
+    if (!serviceXmlNode.attribute(STRING_XML_IS_WAIT_FOR_STARTUP).empty())
+    {
+        m_isWaitForStartup = serviceXmlNode.attribute(STRING_XML_IS_WAIT_FOR_STARTUP).as_bool();
+    }
+
+    for (pugi::xml_node currentXmlNode = serviceXmlNode.first_child(); currentXmlNode; currentXmlNode = currentXmlNode.next_sibling())
+    {
+        if (std::string(STRING_XML_REPLAY_MESSAGE) == currentXmlNode.name())
+        {
+            std::string messageType = currentXmlNode.attribute(uxas::common::StringConstant::MessageType().c_str()).value();
+            if (!messageType.empty())
+            {
+                m_replayDescriptors.insert(messageType);
+            }
+        }
+    }
+
+    if (m_isWaitForStartup)
+    {
+        addSubscriptionAddress(uxas::messages::uxnative::StartupComplete::Subscription);
+    }
+
+    return (true);
+};
+
+bool
+MessageReplayService::initialize()
+{
+    if (!m_recordReader.open(m_recordingFilePath))
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::initialize failed to open recording ", m_recordingFilePath);
+        return (false);
+    }
+    m_recordReader.setDescriptorFilter(m_replayDescriptors);
+    m_recordReader.seekToTime(m_recordReader.getFirstTime_ms() + m_startTime_ms);
+    UXAS_LOG_INFORM(s_typeName(), "::initialize opened recording ", m_recordingFilePath, " with ", m_recordReader.getChunkIndexes().size(),
+                    " chunks spanning ", m_recordReader.getLastTime_ms() - m_recordReader.getFirstTime_ms(), " ms");
+    return (true);
+};
+
+bool
+MessageReplayService::start()
+{
+    if (!m_isWaitForStartup)
+    {
+        startReplay();
+    }
+    return (true);
+};
+
+bool
+MessageReplayService::terminate()
+{
+    m_isTerminate = true;
+    if (m_replayThread && m_replayThread->joinable())
+    {
+        m_replayThread->join();
+    }
+    return (true);
+};
+
+bool
+MessageReplayService::processReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage)
+{
+    if (uxas::messages::uxnative::isStartupComplete(receivedLmcpMessage->m_object.get()))
+    {
+        startReplay();
+    }
+    return (false);
+};
+
+void
+MessageReplayService::startReplay()
+{
+    if (!m_isReplayStarted)
+    {
+        m_isReplayStarted = true;
+        m_replayThread = uxas::stduxas::make_unique<std::thread>(&MessageReplayService::executeReplay, this);
+    }
+};
+
+void
+MessageReplayService::executeReplay()
+{
+    UXAS_LOG_INFORM(s_typeName(), "::executeReplay starting replay of ", m_recordingFilePath, " at speed ", m_replaySpeed);
+
+    const std::chrono::milliseconds sleepSlice(100);
+    auto replayStartTime = std::chrono::steady_clock::now();
+    int64_t recordingStartTime_ms{0};
+    bool isFirstRecord{true};
+    uint64_t replayedMessageCount{0};
+
+    uxas::common::log::MessageRecord record;
+    while (!m_isTerminate && m_recordReader.readNextRecord(record))
+    {
+        if (isFirstRecord)
+        {
+            recordingStartTime_ms = record.m_time_ms;
+            isFirstRecord = false;
+        }
+
+        if (m_replaySpeed > 0.0)
+        {
+            auto dueTime = replayStartTime + std::chrono::microseconds(
+                    static_cast<int64_t>(static_cast<double>(record.m_time_ms - recordingStartTime_ms) * 1000.0 / m_replaySpeed));
+            auto now = std::chrono::steady_clock::now();
+            while (!m_isTerminate && now < dueTime)
+            {
+                std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(dueTime - now, sleepSlice));
+                now = std::chrono::steady_clock::now();
+            }
+            if (m_isTerminate)
+            {
+                break;
+            }
+        }
+
+        uxas::communications::data::SerializedLmcpObject serializedLmcpObject(
+                record.m_descriptor, std::make_shared<const std::string>(std::move(record.m_payload)));
+        // broadcast messages are addressed to their type; others were sent to
+        // a limited-cast address (e.g., a specific entity or service)
+        if (record.m_address.empty() || record.m_address == record.m_descriptor)
+        {
+            sendSharedSerializedLmcpObjectBroadcastMessage(serializedLmcpObject);
+        }
+        else
+        {
+            sendSharedSerializedLmcpObjectLimitedCastMessage(record.m_address, serializedLmcpObject);
+        }
+        replayedMessageCount++;
+    }
+
+    auto replayDuration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - replayStartTime).count();
+    UXAS_LOG_INFORM(s_typeName(), "::executeReplay replayed ", replayedMessageCount, " messages in ", replayDuration_ms, " ms",
+                    (m_isTerminate ? " (terminated)" : ""));
+};
+
+}; //namespace data
+}; //namespace service
+}; //namespace uxas
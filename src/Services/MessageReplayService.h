@@ -0,0 +1,143 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_SERVICE_DATA_MESSAGE_REPLAY_SERVICE_H
+#define UXAS_SERVICE_DATA_MESSAGE_REPLAY_SERVICE_H
+
+#include "ServiceBase.h"
+
+#include "UxAS_MessageRecording.h"
+
+#include <atomic>
+#include <memory>
+#include <set>
+#include <thread>
+
+namespace uxas
+{
+namespace service
+{
+namespace data
+{
+
+/*! \class MessageReplayService
+ *\brief Description:
+ * The <B><i>MessageReplayService</i></B> republishes the messages of a binary 
+ * message recording (written by the <B><i>MessageLoggerDataService</i></B> 
+ * with LogRecording="true"). Messages are sent to their recorded address 
+ * (broadcast or limited-cast) in recorded order, with the recorded spacing 
+ * scaled by the replay speed, or back-to-back. Payloads 
+ * are sent as recorded (never deserialized). Replayed messages carry this 
+ * service's source IDs rather than the recorded ones.
+ * 
+ * Configuration String: 
+ *  <Service Type="MessageReplayService" RecordingFile="messageLog.uxr" ReplaySpeed="1.0"
+ *           StartTime_ms="0" IsWaitForStartup="true">
+ *      <ReplayMessage MessageType="afrl.cmasi.AirVehicleState" />
+ *  </Service>
+ *
+ * Options:
+ *  - RecordingFile
+ *     (path to the recording; relative paths are relative to the start-up directory)
+ *  - ReplaySpeed
+ *     (1 replays in real time, N replays N times faster, 0 replays as fast 
+ *      as possible; default 1)
+ *  - StartTime_ms
+ *     (offset from the start of the recording at which replay begins; 
+ *      uses the recording index to skip earlier chunks)
+ *  - IsWaitForStartup
+ *     (if "true" (default), replay begins when StartupComplete is received; 
+ *      otherwise replay begins when the service starts)
+ *  - ReplayMessage MessageType
+ *     (if any are given, only these message types are replayed)
+ * 
+ * Subscribed Messages:
+ *  - uxas::messages::uxnative::StartupComplete
+ * 
+ * Sent Messages:
+ *  - recorded messages
+ * 
+ */
+
+class MessageReplayService : public ServiceBase
+{
+public:
+
+    static const std::string&
+    s_typeName() { static std::string s_string("MessageReplayService"); return (s_string); };
+
+    static const std::vector<std::string>
+    s_registryServiceTypeNames()
+    {
+        std::vector<std::string> registryServiceTypeNames = {s_typeName()};
+        return (registryServiceTypeNames);
+    };
+    
+    static const std::string&
+    s_directoryName() { static std::string s_string(""); return (s_string); };
+
+    static ServiceBase*
+    create() { return new MessageReplayService; };
+
+    MessageReplayService();
+
+    virtual
+    ~MessageReplayService();
+
+private:
+
+    static
+    ServiceBase::CreationRegistrar<MessageReplayService> s_registrar;
+
+    /** \brief Copy construction not permitted */
+    MessageReplayService(MessageReplayService const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(MessageReplayService const&) = delete;
+
+    bool
+    configure(const pugi::xml_node& serviceXmlNode) override;
+
+    bool
+    initialize() override;
+
+    bool
+    start() override;
+
+    bool
+    terminate() override;
+
+    bool
+    processReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage) override;
+
+    void
+    startReplay();
+
+    void
+    executeReplay();
+
+    std::string m_recordingFilePath;
+    double m_replaySpeed{1.0};
+    int64_t m_startTime_ms{0};
+    bool m_isWaitForStartup{true};
+    std::set<std::string> m_replayDescriptors;
+
+    uxas::common::log::MessageRecordReader m_recordReader;
+
+    bool m_isReplayStarted{false};
+    std::atomic<bool> m_isTerminate{false};
+    std::unique_ptr<std::thread> m_replayThread;
+
+};
+
+}; //namespace data
+}; //namespace service
+}; //namespace uxas
+
+#endif /* UXAS_SERVICE_DATA_MESSAGE_REPLAY_SERVICE_H */
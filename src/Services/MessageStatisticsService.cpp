@@ -0,0 +1,209 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/* 
+ * File:   MessageStatisticsService.cpp
+ *
+ * <Service Type="MessageStatisticsService" ReportPeriod_ms="5000" 
+ *                                          EndpointAddress="tcp://127.0.0.1:5590" />
+ *  
+ */
+
+#include "MessageStatisticsService.h"
+
+#include "MessageProcessingStatistics.h"
+#include "TransportBase.h"
+#include "ZeroMqFabric.h"
+
+#include "UxAS_TimerManager.h"
+#include "UxAS_ZeroMQ.h"
+
+#include "afrl/cmasi/KeyValuePair.h"
+#include "afrl/cmasi/ServiceStatus.h"
+
+#include "stdUniquePtr.h"
+
+#include <sstream>
+
+namespace uxas
+{
+namespace service
+{
+
+// this entry registers the service in the service creation registry
+MessageStatisticsService::ServiceBase::CreationRegistrar<MessageStatisticsService>
+MessageStatisticsService::s_registrar(MessageStatisticsService::s_registryServiceTypeNames());
+
+MessageStatisticsService::MessageStatisticsService()
+: ServiceBase(MessageStatisticsService::s_typeName(), MessageStatisticsService::s_directoryName())
+{
+};
+
+MessageStatisticsService::~MessageStatisticsService()
+{
+    uint64_t delayTime_ms{10};
+    if (m_reportTimerId && !uxas::common::TimerManager::getInstance().destroyTimer(m_reportTimerId, delayTime_ms))
+    {
+        UXAS_LOG_WARN(s_typeName(), "::~MessageStatisticsService failed to destroy report timer "
+                "(m_reportTimerId) with timer ID ", m_reportTimerId, " within ", delayTime_ms, " millisecond timeout");
+    }
+    terminate();
+};
+
+bool
+MessageStatisticsService::configure(const pugi::xml_node& ndComponent)
+{
+    m_reportPeriod_ms = ndComponent.attribute("ReportPeriod_ms").as_uint(m_reportPeriod_ms);
+    if (m_reportPeriod_ms > 0 && m_reportPeriod_ms < 100)
+    {
+        m_reportPeriod_ms = 100;
+    }
+    m_endpointAddress = ndComponent.attribute("EndpointAddress").as_string();
+    if (!uxas::common::ConfigurationManager::getIsMessageProcessingStatistics())
+    {
+        UXAS_LOG_WARN(s_typeName(), "::configure message processing statistics are disabled (enable with the UxAS attribute isMessageProcessingStatistics=\"true\"); reports will be empty");
+    }
+    return (true);
+};
+
+bool
+MessageStatisticsService::initialize()
+{
+    m_reportTimerId = uxas::common::TimerManager::getInstance().createTimer(
+        std::bind(&MessageStatisticsService::onReportTimeout, this), "MessageStatisticsService::onReportTimeout");
+
+    if (!m_endpointAddress.empty())
+    {
+        auto endpointConfiguration = uxas::communications::transport::ZeroMqSocketConfiguration(
+                uxas::communications::transport::NETWORK_NAME::zmqLmcpNetwork(), m_endpointAddress, ZMQ_REP, true, true, 100, 100);
+        try
+        {
+            m_endpointSocket = uxas::communications::transport::ZeroMqFabric::getInstance().createSocket(endpointConfiguration);
+        }
+        catch (std::exception& ex)
+        {
+            UXAS_LOG_ERROR(s_typeName(), "::initialize failed to create endpoint socket [", m_endpointAddress, "] EXCEPTION: ", ex.what());
+            return (false);
+        }
+    }
+    return (true);
+};
+
+bool
+MessageStatisticsService::start()
+{
+    if (m_reportPeriod_ms > 0)
+    {
+        uxas::common::TimerManager::getInstance().startPeriodicTimer(m_reportTimerId, m_reportPeriod_ms, m_reportPeriod_ms);
+    }
+    if (m_endpointSocket)
+    {
+        m_endpointThread = uxas::stduxas::make_unique<std::thread>(&MessageStatisticsService::executeEndpoint, this);
+        UXAS_LOG_INFORM(s_typeName(), "::start serving statistics on [", m_endpointAddress, "]");
+    }
+    return (true);
+};
+
+bool
+MessageStatisticsService::terminate()
+{
+    m_isEndpointTerminate = true;
+    if (m_endpointThread && m_endpointThread->joinable())
+    {
+        m_endpointThread->join();
+    }
+    m_endpointThread.reset();
+    return (true);
+};
+
+bool
+MessageStatisticsService::processReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage)
+{
+    return (false); // always return false unless terminating
+};
+
+void
+MessageStatisticsService::onReportTimeout()
+{
+    auto snapshots = uxas::communications::MessageProcessingStatistics::getRegisteredSnapshots();
+    auto serviceStatus = std::make_shared<afrl::cmasi::ServiceStatus>();
+    serviceStatus->setStatusType(afrl::cmasi::ServiceStatusType::Information);
+    for (auto& snapshot : snapshots)
+    {
+        std::string keyPrefix = snapshot.m_networkClientTypeName + "." + std::to_string(snapshot.m_networkId) + ".";
+        // queue depth and wait times are not known on every transport
+        auto queueDepthKeyValuePair = new afrl::cmasi::KeyValuePair;
+        queueDepthKeyValuePair->setKey(keyPrefix + "QueueDepth");
+        if (snapshot.m_queueDepth.getCount() > 0)
+        {
+            queueDepthKeyValuePair->setValue("p50=" + std::to_string(snapshot.m_queueDepth.getValueAtPercentile(50.0))
+                                             + " p99=" + std::to_string(snapshot.m_queueDepth.getValueAtPercentile(99.0))
+                                             + " max=" + std::to_string(snapshot.m_queueDepth.getMaximum()));
+        }
+        else
+        {
+            queueDepthKeyValuePair->setValue("unavailable");
+        }
+        serviceStatus->getInfo().push_back(queueDepthKeyValuePair);
+        for (auto& typeStatistics : snapshot.m_messageTypeStatistics)
+        {
+            auto& statistics = typeStatistics.second;
+            std::string value = "count=" + std::to_string(statistics.m_messageCount)
+                    + " p50_us=" + std::to_string(statistics.m_processingTime_us.getValueAtPercentile(50.0))
+                    + " p99_us=" + std::to_string(statistics.m_processingTime_us.getValueAtPercentile(99.0))
+                    + " max_us=" + std::to_string(statistics.m_processingTime_us.getMaximum());
+            value += " wait_p99_us=" + (statistics.m_queueWaitTime_us.getCount() > 0
+                    ? std::to_string(statistics.m_queueWaitTime_us.getValueAtPercentile(99.0)) : std::string("unavailable"));
+            auto keyValuePair = new afrl::cmasi::KeyValuePair;
+            keyValuePair->setKey(keyPrefix + typeStatistics.first);
+            keyValuePair->setValue(value);
+            serviceStatus->getInfo().push_back(keyValuePair);
+        }
+    }
+    sendSharedLmcpObjectBroadcastMessage(serviceStatus);
+};
+
+void
+MessageStatisticsService::executeEndpoint()
+{
+    try
+    {
+        while (!m_isEndpointTerminate)
+        {
+            zmq::pollitem_t pollItems [] = {
+                { *m_endpointSocket, 0, ZMQ_POLLIN, 0},
+            };
+            zmq::poll(&pollItems[0], 1, uxas::common::ConfigurationManager::getZeroMqReceiveSocketPollWaitTime_ms());
+            if (pollItems[0].revents & ZMQ_POLLIN)
+            {
+                // a REP socket must answer every request
+                std::string request = n_ZMQ::s_recv(*m_endpointSocket);
+                std::ostringstream reply;
+                auto snapshots = uxas::communications::MessageProcessingStatistics::getRegisteredSnapshots();
+                if (request == "text")
+                {
+                    uxas::communications::MessageProcessingStatistics::writeText(snapshots, reply);
+                }
+                else
+                {
+                    uxas::communications::MessageProcessingStatistics::writeJson(snapshots, reply);
+                }
+                n_ZMQ::s_send(*m_endpointSocket, reply.str());
+            }
+        }
+    }
+    catch (std::exception& ex)
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::executeEndpoint EXCEPTION: ", ex.what());
+    }
+    m_endpointSocket.reset();
+};
+
+}; //namespace service
+}; //namespace uxas
@@ -0,0 +1,147 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/* 
+ * File:   MessageStatisticsService.h
+ *
+ * <Service Type="MessageStatisticsService" ReportPeriod_ms="5000" 
+ *                                          EndpointAddress="tcp://127.0.0.1:5590" />
+ */
+
+#ifndef UXAS_SERVICE_MESSAGE_STATISTICS_SERVICE_H
+#define UXAS_SERVICE_MESSAGE_STATISTICS_SERVICE_H
+
+#include "ServiceBase.h"
+
+#include "zmq.hpp"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace uxas
+{
+namespace service
+{
+
+/*! \class MessageStatisticsService
+ *  \brief Periodically reports the message processing statistics (processing 
+ *  time, queue wait time and queue depth percentiles per service and message 
+ *  type) recorded by all network clients of this entity. Recording is 
+ *  enabled by the entity attribute isMessageProcessingStatistics (off by 
+ *  default). Queue wait times are only known for messages received via the 
+ *  in-process message bus or in message envelopes, queue depths only for the 
+ *  in-process message bus; otherwise they are reported as unavailable.
+ * 
+ * <Service Type="MessageStatisticsService" ReportPeriod_ms="5000" 
+ *                                          EndpointAddress="tcp://127.0.0.1:5590" />
+ * 
+ * Options:
+ *  - ReportPeriod_ms - Time (in ms) between subsequent periodic reports; 0 
+ *    disables the <b>LMCP</b> report
+ *  - EndpointAddress - optional Zero MQ REP socket address (bound) answering 
+ *    each request with the current statistics as JSON, or as text if the 
+ *    request is "text"
+ * 
+ * Subscribed Messages:
+ *  - none
+ * 
+ * Sent Messages:
+ *  - afrl::cmasi::ServiceStatus (Information; one KeyValuePair per service 
+ *    and message type, keyed "ServiceType.ServiceID.MessageType", and one 
+ *    per service keyed "ServiceType.ServiceID.QueueDepth")
+ * 
+ */
+class MessageStatisticsService : public ServiceBase
+{
+public:
+
+    static const std::string&
+    s_typeName()
+    {
+        static std::string s_string("MessageStatisticsService");
+        return (s_string);
+    };
+
+    static const std::vector<std::string>
+    s_registryServiceTypeNames()
+    {
+        std::vector<std::string> registryServiceTypeNames = {s_typeName()};
+        return (registryServiceTypeNames);
+    };
+
+    static const std::string&
+    s_directoryName() { static std::string s_string(""); return (s_string); };
+
+    static ServiceBase*
+    create()
+    {
+        return new MessageStatisticsService;
+    };
+
+    MessageStatisticsService();
+
+    virtual
+    ~MessageStatisticsService();
+
+private:
+
+    static
+    ServiceBase::CreationRegistrar<MessageStatisticsService> s_registrar;
+
+    /** \brief Copy construction not permitted */
+    MessageStatisticsService(MessageStatisticsService const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(MessageStatisticsService const&) = delete;
+
+    bool
+    configure(const pugi::xml_node& serviceXmlNode) override;
+    
+    bool
+    initialize() override;
+    
+    bool
+    start() override;
+
+    bool
+    terminate() override;
+
+    bool
+    processReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage) override;
+
+private:
+
+    /*! \brief Callback sending the statistics report */
+    void
+    onReportTimeout();
+
+    /*! \brief Answers endpoint requests until termination */
+    void
+    executeEndpoint();
+
+    // Options
+    /*! \brief Period (in ms) at which the report is sent */
+    uint32_t m_reportPeriod_ms{5000};
+    /*! \brief Zero MQ address of the statistics endpoint (empty if disabled) */
+    std::string m_endpointAddress;
+
+    /*! \brief Timer used to periodically send the report */
+    uint64_t m_reportTimerId{0};
+
+    std::unique_ptr<zmq::socket_t> m_endpointSocket;
+    std::unique_ptr<std::thread> m_endpointThread;
+    std::atomic<bool> m_isEndpointTerminate{false};
+};
+
+}; //namespace service
+}; //namespace uxas
+
+#endif /* UXAS_SERVICE_MESSAGE_STATISTICS_SERVICE_H */
@@ -32,6 +32,8 @@
 
 #include <sstream>  //stringstream
 #include <chrono>       // time functions
+#include <limits>
+#include <map>
 
 //TODO:: read in a open street map and calculate it's visibility graph
 
@@ -284,9 +286,75 @@ bool OsmPlannerService::bProcessRoutePlanRequest(const std::shared_ptr<uxas::mes
         }
     }
 
+    // find the closest graph nodes for all routes first, so that routes sharing
+    // a start node (e.g. a row of a cost matrix) can be planned with a single
+    // one-to-many search instead of one search per route
+    struct s_RouteNodes
+    {
+        n_FrameworkLib::CPosition positionStart;
+        n_FrameworkLib::CPosition positionEnd;
+        int64_t nodeIdStart{-1};
+        int64_t nodeIdEnd{-1};
+        double lengthFromStartToNode{-1.0};
+        double lengthFromNodeToEnd{-1.0};
+        bool isFoundNodeIds{false};
+    };
+    std::vector<s_RouteNodes> routeNodes;
+    std::map<std::pair<int64_t, int64_t>, std::pair<int32_t, std::deque<int64_t> > > startEndNodeIdsVsCostPath;
+    std::map<std::pair<int64_t, int64_t>, double> startEndNodeIdsVsSearchTime_s;
+    if (m_graph && m_planningIndexVsNodeId && m_idVsNode)
+    {
+        std::map<int64_t, std::vector<int64_t> > nodeIdStartVsNodeIdEnds;
+        routeNodes.reserve(routePlanRequest->getRouteRequests().size());
+        for (auto itRequest = routePlanRequest->getRouteRequests().begin();
+                itRequest != routePlanRequest->getRouteRequests().end();
+                itRequest++)
+        {
+            s_RouteNodes nodes;
+            nodes.positionStart = n_FrameworkLib::CPosition((*itRequest)->getStartLocation()->getLatitude() * n_Const::c_Convert::dDegreesToRadians(),
+                                                            (*itRequest)->getStartLocation()->getLongitude() * n_Const::c_Convert::dDegreesToRadians(),
+                                                            0.0, 0.0);
+            nodes.positionEnd = n_FrameworkLib::CPosition((*itRequest)->getEndLocation()->getLatitude() * n_Const::c_Convert::dDegreesToRadians(),
+                                                          (*itRequest)->getEndLocation()->getLongitude() * n_Const::c_Convert::dDegreesToRadians(),
+                                                          0.0, 0.0);
+            // start node Id
+            bool isFoundNodeIdStart = isFindClosestNodeId(nodes.positionStart, m_cellVsPlanningNodeIds, nodes.nodeIdStart, nodes.lengthFromStartToNode);
+            // end node Id
+            bool isFoundNodeIdEnd = isFindClosestNodeId(nodes.positionEnd, m_cellVsPlanningNodeIds, nodes.nodeIdEnd, nodes.lengthFromNodeToEnd);
+            nodes.isFoundNodeIds = isFoundNodeIdStart && isFoundNodeIdEnd;
+            if (nodes.isFoundNodeIds)
+            {
+                nodeIdStartVsNodeIdEnds[nodes.nodeIdStart].push_back(nodes.nodeIdEnd);
+            }
+            routeNodes.push_back(nodes);
+        }
+
+        for (auto itStart = nodeIdStartVsNodeIdEnds.begin(); itStart != nodeIdStartVsNodeIdEnds.end(); itStart++)
+        {
+            // a single route is planned faster with the goal directed search
+            if (itStart->second.size() < 2)
+            {
+                continue;
+            }
+            std::vector<int32_t> pathCosts;
+            std::vector<std::deque<int64_t> > pathNodeIds;
+            isFindShortestRoutes(itStart->first, itStart->second, pathCosts, pathNodeIds);
+            for (size_t iEnd = 0; iEnd < itStart->second.size(); iEnd++)
+            {
+                if (!pathNodeIds[iEnd].empty())
+                {
+                    auto startEnd = std::make_pair(itStart->first, itStart->second[iEnd]);
+                    startEndNodeIdsVsCostPath[startEnd] = std::make_pair(pathCosts[iEnd], pathNodeIds[iEnd]);
+                    startEndNodeIdsVsSearchTime_s[startEnd] = m_searchTime_s;
+                }
+            }
+        }
+    } //if(m_graph && m_planningIndexVsNodeId && m_idVsNode)
+
+    size_t routeIndex(0);
     for (auto itRequest = routePlanRequest->getRouteRequests().begin();
             itRequest != routePlanRequest->getRouteRequests().end();
-            itRequest++)
+            itRequest++, routeIndex++)
     {
         auto routePlan = new uxas::messages::route::RoutePlan;
         routePlan->setRouteID((*itRequest)->getRouteID());
@@ -298,28 +366,33 @@ bool OsmPlannerService::bProcessRoutePlanRequest(const std::shared_ptr<uxas::mes
 
             std::vector<int64_t> waypointNodeIds;
 
-            n_FrameworkLib::CPosition positionStart((*itRequest)->getStartLocation()->getLatitude() * n_Const::c_Convert::dDegreesToRadians(),
-                                                    (*itRequest)->getStartLocation()->getLongitude() * n_Const::c_Convert::dDegreesToRadians(),
-                                                    0.0, 0.0);
-            int64_t nodeIdStart(-1);
-            double lengthFromStartToNode(-1.0);
+            const n_FrameworkLib::CPosition& positionStart = routeNodes[routeIndex].positionStart;
+            const int64_t& nodeIdStart = routeNodes[routeIndex].nodeIdStart;
+            const double& lengthFromStartToNode = routeNodes[routeIndex].lengthFromStartToNode;
 
-            n_FrameworkLib::CPosition positionEnd((*itRequest)->getEndLocation()->getLatitude() * n_Const::c_Convert::dDegreesToRadians(),
-                                                  (*itRequest)->getEndLocation()->getLongitude() * n_Const::c_Convert::dDegreesToRadians(),
-                                                  0.0, 0.0);
-            int64_t nodeIdEnd(-1);
-            double lengthFromNodeToEnd(-1.0);
+            const n_FrameworkLib::CPosition& positionEnd = routeNodes[routeIndex].positionEnd;
+            const int64_t& nodeIdEnd = routeNodes[routeIndex].nodeIdEnd;
+            const double& lengthFromNodeToEnd = routeNodes[routeIndex].lengthFromNodeToEnd;
 
-            // start node Id
-            bool isFoundNodeIdStart = isFindClosestNodeId(positionStart, m_cellVsPlanningNodeIds, nodeIdStart, lengthFromStartToNode);
-            // end node Id
-            bool isFoundNodeIdEnd = isFindClosestNodeId(positionEnd, m_cellVsPlanningNodeIds, nodeIdEnd, lengthFromNodeToEnd);
-            if (isFoundNodeIdStart && isFoundNodeIdEnd)
+            if (routeNodes[routeIndex].isFoundNodeIds)
             {
                 int32_t numberWaypoints(-1); // for metrics
                 int32_t pathCost(0);
                 std::deque<int64_t> pathNodeIds;
-                if (isFindShortestRoute(nodeIdStart, nodeIdEnd, pathCost, pathNodeIds))
+                bool isFoundRoute(false);
+                auto itCostPath = startEndNodeIdsVsCostPath.find(std::make_pair(nodeIdStart, nodeIdEnd));
+                if (itCostPath != startEndNodeIdsVsCostPath.end())
+                {
+                    pathCost = itCostPath->second.first;
+                    pathNodeIds = itCostPath->second.second;
+                    m_searchTime_s = startEndNodeIdsVsSearchTime_s[itCostPath->first];
+                    isFoundRoute = true;
+                }
+                else
+                {
+                    isFoundRoute = isFindShortestRoute(nodeIdStart, nodeIdEnd, pathCost, pathNodeIds);
+                }
+                if (isFoundRoute)
                 {
                     float routCost = (static_cast<float> (lengthFromStartToNode) +
                             static_cast<float> (lengthFromNodeToEnd) +
@@ -1580,6 +1653,77 @@ bool OsmPlannerService::isFindShortestRoute(const int64_t& startNodeId, const in
     return (isSuccess);
 }
 
+bool OsmPlannerService::isFindShortestRoutes(const int64_t& startNodeId, const std::vector<int64_t>& endNodeIds,
+                                             std::vector<int32_t>& pathLengths, std::vector<std::deque<int64_t> >& pathNodes)
+{
+    bool isSuccess(false);
+
+    pathLengths.assign(endNodeIds.size(), 0);
+    pathNodes.assign(endNodeIds.size(), std::deque<int64_t>());
+
+    auto startTime = std::chrono::system_clock::now();
+
+    auto itStartNodeIndex = m_nodeIdVsPlanningIndex.find(startNodeId);
+    if (itStartNodeIndex != m_nodeIdVsPlanningIndex.end())
+    {
+        isSuccess = true;
+
+        // one single source search finds the shortest routes to all of the end nodes
+        VertexDescriptor_t start(itStartNodeIndex->second);
+        std::vector<int32_t> d(num_vertices(*m_graph));
+        std::vector<VertexDescriptor_t> p(num_vertices(*m_graph));
+        boost::dijkstra_shortest_paths
+                (*m_graph, start,
+                 predecessor_map(boost::make_iterator_property_map(p.begin(), boost::get(boost::vertex_index, *m_graph))).
+                 distance_map(boost::make_iterator_property_map(d.begin(), boost::get(boost::vertex_index, *m_graph))));
+
+        for (size_t iEnd = 0; iEnd < endNodeIds.size(); iEnd++)
+        {
+            auto itEndNodeIndex = m_nodeIdVsPlanningIndex.find(endNodeIds[iEnd]);
+            if ((itEndNodeIndex == m_nodeIdVsPlanningIndex.end()) ||
+                    (d[itEndNodeIndex->second] == (std::numeric_limits<int32_t>::max)()))
+            {
+                UXAS_LOG_ERROR("Didn't find a path from startNodeId[", startNodeId, "] to endNodeId[", endNodeIds[iEnd], "] !");
+                isSuccess = false;
+                continue;
+            }
+            VertexDescriptor_t goal(itEndNodeIndex->second);
+            pathLengths[iEnd] = d[goal];
+            for (VertexDescriptor_t v = goal;; v = p[v])
+            {
+                auto itId = m_planningIndexVsNodeId->find(static_cast<int32_t> (v));
+                if (itId != m_planningIndexVsNodeId->end())
+                {
+                    pathNodes[iEnd].push_front(itId->second);
+
+                    if (p[v] == v)
+                    {
+                        break;
+                    }
+                }
+                else
+                {
+                    UXAS_LOG_ERROR("OSM FILE:: while constructing shortest route from index[ ", static_cast<int64_t> (v), "], could not find corresponding node Id.");
+                    pathNodes[iEnd].clear();
+                    isSuccess = false;
+                    break;
+                }
+            }
+        }
+
+        auto endTime = std::chrono::system_clock::now();
+        std::chrono::duration<double> elapsed_seconds = endTime - startTime;
+        m_searchTime_s = elapsed_seconds.count();
+        UXAS_LOG_INFORM(" **** Finished running DIJKSTRA search from startNodeId[", startNodeId, "] to [", endNodeIds.size(), "] end nodes Elapsed Seconds[", elapsed_seconds.count(), "] ****");
+    }
+    else
+    {
+        UXAS_LOG_ERROR("Didn't find a path from startNodeId[", startNodeId, "], node is not in the planning graph!");
+    }
+
+    return (isSuccess);
+}
+
 bool OsmPlannerService::isFindClosestNodeId(const n_FrameworkLib::CPosition& position,
                                             std::unordered_multimap<std::pair<int32_t, int32_t>, int64_t, PairIdHash >& cellVsNodeIds,
                                             int64_t& nodeId, double& length_m)
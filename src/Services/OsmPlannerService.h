@@ -34,6 +34,7 @@
 #include "uxas/messages/route/RoadPointsResponse.h"
 
 #include "boost/graph/astar_search.hpp"
+#include "boost/graph/dijkstra_shortest_paths.hpp"
 #include "boost/graph/graph_traits.hpp"
 #include "boost/graph/adjacency_list.hpp"
 
@@ -185,6 +186,11 @@ protected:
     bool isBuildRoadGraphWithOsm(const string& osmFile);
     bool isFindShortestRoute(const int64_t& startNodeId, const int64_t& endNodeId,
             int32_t& pathCost, std::deque<int64_t>& pathNodes);
+    /** \brief finds the shortest routes from one start node to several end
+     * nodes with a single search. Routes that could not be found are returned
+     * with empty <B><i>pathNodes</i></B>. Returns false if any route was not found. */
+    bool isFindShortestRoutes(const int64_t& startNodeId, const std::vector<int64_t>& endNodeIds,
+            std::vector<int32_t>& pathCosts, std::vector<std::deque<int64_t> >& pathNodes);
     bool isProcessHighwayNodes(const std::unordered_map<int64_t, bool>& nodeIdVs_isPlanningNode,
             const std::vector<int64_t>& highWayIds);
     bool isBuildGraph(const std::unordered_set<int64_t>& planningNodeIds, const std::vector<int64_t>& highWayIds);
@@ -29,6 +29,7 @@
 #define STRING_XML_COMPONENT "Component"
 #define STRING_XML_TYPE "Type"
 #define STRING_XML_FAST_PLAN "FastPlan"
+#define STRING_XML_REUSE_ROUTE_COSTS "ReuseRouteCosts"
 
 namespace uxas
 {
@@ -66,6 +67,11 @@ RouteAggregatorService::configure(const pugi::xml_node& ndComponent)
         m_fastPlan = ndComponent.attribute(STRING_XML_FAST_PLAN).as_bool();
     }
 
+    if (!ndComponent.attribute(STRING_XML_REUSE_ROUTE_COSTS).empty())
+    {
+        m_isReusingRouteCosts = ndComponent.attribute(STRING_XML_REUSE_ROUTE_COSTS).as_bool();
+    }
+
     // track states and configurations for assignment cost matrix calculation
     // [EntityStates] are used to calculate costs from current position to first task
     // [EntityConfigurations] are used for nominal speed values (all costs are in terms of time to arrive)
@@ -94,6 +100,14 @@ RouteAggregatorService::configure(const pugi::xml_node& ndComponent)
     // listen for responses to requests from route planner(s)
     addSubscriptionAddress(uxas::messages::route::RoutePlanResponse::Subscription);
 
+    // route costs change with the zones and operating regions
+    if (m_isReusingRouteCosts)
+    {
+        addSubscriptionAddress(afrl::cmasi::KeepInZone::Subscription);
+        addSubscriptionAddress(afrl::cmasi::KeepOutZone::Subscription);
+        addSubscriptionAddress(afrl::cmasi::OperatingRegion::Subscription);
+    }
+
     // Subscribe to group messages (whisper from local route planner)
     //TODO REVIEW DESIGN "RouteAggregator" "RoutePlanner" flip message addressing effecting session behavior
 
@@ -139,20 +153,30 @@ RouteAggregatorService::processReceivedLmcpMessage(std::unique_ptr<uxas::communi
         m_entityStates[id] = std::static_pointer_cast<afrl::cmasi::EntityState>(receivedLmcpMessage->m_object);
         m_surfaceVehicles.insert(id);
     }
+    else if (afrl::cmasi::isKeepInZone(receivedLmcpMessage->m_object.get()) ||
+            afrl::cmasi::isKeepOutZone(receivedLmcpMessage->m_object.get()) ||
+            afrl::cmasi::isOperatingRegion(receivedLmcpMessage->m_object.get()))
+    {
+        m_routeCostCache.clear();
+    }
     else if (std::dynamic_pointer_cast<afrl::cmasi::AirVehicleConfiguration>(receivedLmcpMessage->m_object))
     {
+        // nominal speeds may have changed
+        m_routeCostCache.clear();
         int64_t id = std::static_pointer_cast<afrl::cmasi::EntityConfiguration>(receivedLmcpMessage->m_object)->getID();
         m_entityConfigurations[id] = std::static_pointer_cast<afrl::cmasi::EntityConfiguration>(receivedLmcpMessage->m_object);
         m_airVehicles.insert(id);
     }
     else if (afrl::vehicles::isGroundVehicleConfiguration(receivedLmcpMessage->m_object.get()))
     {
+        m_routeCostCache.clear();
         int64_t id = std::static_pointer_cast<afrl::cmasi::EntityConfiguration>(receivedLmcpMessage->m_object)->getID();
         m_entityConfigurations[id] = std::static_pointer_cast<afrl::cmasi::EntityConfiguration>(receivedLmcpMessage->m_object);
         m_groundVehicles.insert(id);
     }
     else if (afrl::vehicles::isSurfaceVehicleConfiguration(receivedLmcpMessage->m_object.get()))
     {
+        m_routeCostCache.clear();
         int64_t id = std::static_pointer_cast<afrl::cmasi::EntityConfiguration>(receivedLmcpMessage->m_object)->getID();
         m_entityConfigurations[id] = std::static_pointer_cast<afrl::cmasi::EntityConfiguration>(receivedLmcpMessage->m_object);
         m_surfaceVehicles.insert(id);
@@ -227,7 +251,10 @@ void RouteAggregatorService::BuildMatrixRequests(int64_t reqId, const std::share
     //       d. push routeID onto pending list
     //  3. Send requests to proper planners
 
+    // the routes of an earlier build of this request are superseded
+    RemovePendingRoutes(reqId);
     m_pendingAutoReq[reqId] = std::unordered_set<int64_t>();
+    bool isRouteCostReused{false};
     std::vector< std::shared_ptr<uxas::messages::route::RoutePlanRequest> > sendAirPlanRequest;
     std::vector< std::shared_ptr<uxas::messages::route::RoutePlanRequest> > sendGroundPlanRequest;
     
@@ -294,6 +321,7 @@ void RouteAggregatorService::BuildMatrixRequests(int64_t reqId, const std::share
             planRequest->setVehicleID(vehicleId);
             //planRequest->setRouteID(m_planrequestId);
             //m_planrequestId++;
+            double planningSpeed_mps = GetPlanningSpeed(vehicleId);
 
             if (!isFoundPlannningState)
             {
@@ -317,7 +345,15 @@ void RouteAggregatorService::BuildMatrixRequests(int64_t reqId, const std::share
                 r->setEndLocation(option->getStartLocation()->clone());
                 r->setEndHeading(option->getStartHeading());
                 r->setRouteID(m_routeId);
-                planRequest->getRouteRequests().push_back(r);
+                if (ReuseRouteCost(vehicleId, planRequest->getOperatingRegion(), planningSpeed_mps, r))
+                {
+                    delete r;
+                    isRouteCostReused = true;
+                }
+                else
+                {
+                    planRequest->getRouteRequests().push_back(r);
+                }
                 m_pendingAutoReq[reqId].insert(m_routeId);
                 m_routeId++;
             }
@@ -342,7 +378,15 @@ void RouteAggregatorService::BuildMatrixRequests(int64_t reqId, const std::share
                         r->setEndLocation(option2->getStartLocation()->clone());
                         r->setEndHeading(option2->getStartHeading());
                         r->setRouteID(m_routeId);
-                        planRequest->getRouteRequests().push_back(r);
+                        if (ReuseRouteCost(vehicleId, planRequest->getOperatingRegion(), planningSpeed_mps, r))
+                        {
+                            delete r;
+                            isRouteCostReused = true;
+                        }
+                        else
+                        {
+                            planRequest->getRouteRequests().push_back(r);
+                        }
                         m_pendingAutoReq[reqId].insert(m_routeId);
                         m_routeId++;
                     }
@@ -350,7 +394,11 @@ void RouteAggregatorService::BuildMatrixRequests(int64_t reqId, const std::share
             }
 
             // send this plan request to the prescribed route planner for ground vehicles
-            if (m_groundVehicles.find(vehicleId) != m_groundVehicles.end())
+            if (planRequest->getRouteRequests().empty())
+            {
+                // all route costs were reused
+            }
+            else if (m_groundVehicles.find(vehicleId) != m_groundVehicles.end())
             {
                 sendGroundPlanRequest.push_back(planRequest);
             }
@@ -384,13 +432,61 @@ void RouteAggregatorService::BuildMatrixRequests(int64_t reqId, const std::share
         }
     }
 
-    // fast planning should be complete, so kick off sending response
-    if (m_fastPlan)
+    // fast planning (and reused route costs) should be complete, so kick off sending response
+    if (m_fastPlan || isRouteCostReused)
     {
         CheckAllRoutePlans();
     }
 }
 
+double RouteAggregatorService::GetPlanningSpeed(int64_t vehicleId)
+{
+    // as the route planners: the ground speed of the latest state, unless (nearly) stopped, else the nominal speed
+    auto state = m_entityStates.find(vehicleId);
+    if (state != m_entityStates.end() && state->second->getGroundspeed() >= 0.1)
+    {
+        return state->second->getGroundspeed();
+    }
+    auto config = m_entityConfigurations.find(vehicleId);
+    if (config != m_entityConfigurations.end())
+    {
+        return config->second->getNominalSpeed();
+    }
+    return (state != m_entityStates.end()) ? state->second->getGroundspeed() : 0.0;
+}
+
+bool RouteAggregatorService::ReuseRouteCost(int64_t vehicleId, int64_t operatingRegion, double planningSpeed_mps, uxas::messages::route::RouteConstraints* routeConstraints)
+{
+    int64_t routeCost_ms(-1);
+    if (!m_isReusingRouteCosts || !m_routeCostCache.isFindRouteCost(vehicleId, operatingRegion, planningSpeed_mps, routeConstraints, routeCost_ms))
+    {
+        return false;
+    }
+
+    // store the plan as if the planner had returned it (there is no plan response)
+    uxas::messages::route::RoutePlan* plan = new uxas::messages::route::RoutePlan;
+    plan->setRouteID(routeConstraints->getRouteID());
+    plan->setRouteCost(routeCost_ms);
+    m_routePlans[routeConstraints->getRouteID()] = std::make_pair(-1, std::shared_ptr<uxas::messages::route::RoutePlan>(plan));
+    return true;
+}
+
+void RouteAggregatorService::RemovePendingRoutes(int64_t reqId)
+{
+    auto pendingRoutes = m_pendingAutoReq.find(reqId);
+    if (pendingRoutes == m_pendingAutoReq.end())
+    {
+        return;
+    }
+    for (const int64_t& rId : pendingRoutes->second)
+    {
+        m_routeCostCache.removeRoute(rId);
+        m_routeTaskPairing.erase(rId);
+        m_routePlans.erase(rId);
+    }
+    m_pendingAutoReq.erase(pendingRoutes);
+}
+
 void RouteAggregatorService::HandleRouteRequest(std::shared_ptr<uxas::messages::route::RouteRequest> request)
 {
     if (request->getVehicleID().empty())
@@ -545,6 +641,8 @@ void RouteAggregatorService::SendMatrix(int64_t autoKey)
         auto plan = m_routePlans.find(rId);
         if (plan != m_routePlans.end())
         {
+            m_routeCostCache.addRouteCost(rId, plan->second.second->getRouteCost());
+
             auto taskpair = m_routeTaskPairing.find(rId);
             if (taskpair != m_routeTaskPairing.end())
             {
@@ -569,6 +667,12 @@ void RouteAggregatorService::SendMatrix(int64_t autoKey)
         }
     }
 
+    // keep the costs of this request for the next one
+    if (m_isReusingRouteCosts)
+    {
+        m_routeCostCache.commitRouteCosts();
+    }
+
     // send the total cost matrix
     std::shared_ptr<avtas::lmcp::Object> pResponse = std::static_pointer_cast<avtas::lmcp::Object>(matrix);
     sendSharedLmcpObjectBroadcastMessage(pResponse);
@@ -20,6 +20,7 @@
 #define UXAS_SERVICE_ROUTE_AGGREGATOR_SERVICE_H
 
 #include "ServiceBase.h"
+#include "RouteCostCache.h"
 #include "afrl/cmasi/CMASI.h"
 #include "afrl/impact/IMPACT.h"
 #include "afrl/vehicles/VEHICLES.h"
@@ -70,10 +71,15 @@ public:
 
  * 
  * Configuration String: 
- *  <Service Type="RouteAggregatorService" FastPlan="FALSE" />
+ *  <Service Type="RouteAggregatorService" FastPlan="FALSE" ReuseRouteCosts="FALSE" />
  * 
  * Options:
  *  - FastPlan
+ *  - ReuseRouteCosts - reuse the route costs of the previous automation request for
+ *    routes with the same vehicle, operating region, planning speed (ground speed of
+ *    the latest state, or nominal speed), start and end (e.g., between unchanged task
+ *    options). Only new routes are planned. Vehicle configurations and keep-in/keep-out
+ *    zone or operating region updates discard the stored costs.
  * 
  * Subscribed Messages:
  *  - afrl::cmasi::AirVehicleState
@@ -86,7 +92,7 @@ public:
  *  - uxas::messages::task::TaskPlanOptions
  *  - uxas::messages::route::RouteRequest
  *  - uxas::messages::route::RoutePlanResponse
- *  - 
+ *  - afrl::cmasi::KeepInZone, afrl::cmasi::KeepOutZone, afrl::cmasi::OperatingRegion (ReuseRouteCosts only)
  *  - 
  *  - 
  *  - 
@@ -185,12 +191,22 @@ private:
     void BuildMatrixRequests(int64_t, const std::shared_ptr<uxas::messages::task::UniqueAutomationRequest>&);
     void SendRouteResponse(int64_t);
     void SendMatrix(int64_t);
+    double GetPlanningSpeed(int64_t);
+    bool ReuseRouteCost(int64_t, int64_t, double, uxas::messages::route::RouteConstraints*);
+    void RemovePendingRoutes(int64_t);
 
     // Configurable parameter that disables potentially costly ground route calculations
     // Paramter is identified as 'FastPlan' in the configuration file
     // Fast planning ignores all environment and dynamic constraints and plans straight line only
     bool m_fastPlan{false};
 
+    // Configurable parameter that enables reusing the route costs of the previous automation request
+    // Paramter is identified as 'ReuseRouteCosts' in the configuration file
+    bool m_isReusingRouteCosts{false};
+
+    // route costs of the last automation request
+    RouteCostCache m_routeCostCache;
+
     // vehicle state and configuration storage
     std::unordered_map<int64_t, std::shared_ptr<afrl::cmasi::EntityState> > m_entityStates;
     std::unordered_map<int64_t, std::shared_ptr<afrl::cmasi::EntityConfiguration> > m_entityConfigurations;
@@ -0,0 +1,72 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   RouteCostCache.cpp
+ *
+ */
+
+#include "RouteCostCache.h"
+
+namespace uxas
+{
+namespace service
+{
+
+bool RouteCostCache::isFindRouteCost(int64_t vehicleId, int64_t operatingRegion, double planningSpeed_mps, uxas::messages::route::RouteConstraints* routeConstraints, int64_t& routeCost_ms)
+{
+    RouteCostKey costKey(vehicleId, operatingRegion, planningSpeed_mps,
+                         routeConstraints->getStartLocation()->getLatitude(), routeConstraints->getStartLocation()->getLongitude(),
+                         routeConstraints->getStartLocation()->getAltitude(), routeConstraints->getStartHeading(),
+                         routeConstraints->getEndLocation()->getLatitude(), routeConstraints->getEndLocation()->getLongitude(),
+                         routeConstraints->getEndLocation()->getAltitude(), routeConstraints->getEndHeading());
+    m_routeIdVsCostKey[routeConstraints->getRouteID()] = costKey;
+
+    auto itRouteCost = m_routeCostCache.find(costKey);
+    if (itRouteCost == m_routeCostCache.end())
+    {
+        return (false);
+    }
+    routeCost_ms = itRouteCost->second;
+    return (true);
+}
+
+void RouteCostCache::addRouteCost(int64_t routeId, int64_t routeCost_ms)
+{
+    auto itCostKey = m_routeIdVsCostKey.find(routeId);
+    if (itCostKey != m_routeIdVsCostKey.end())
+    {
+        if (routeCost_ms >= 0)
+        {
+            m_addedRouteCosts[itCostKey->second] = routeCost_ms;
+        }
+        m_routeIdVsCostKey.erase(itCostKey);
+    }
+}
+
+void RouteCostCache::commitRouteCosts()
+{
+    m_routeCostCache.swap(m_addedRouteCosts);
+    m_addedRouteCosts.clear();
+}
+
+void RouteCostCache::removeRoute(int64_t routeId)
+{
+    m_routeIdVsCostKey.erase(routeId);
+}
+
+void RouteCostCache::clear()
+{
+    m_routeCostCache.clear();
+    m_addedRouteCosts.clear();
+    m_routeIdVsCostKey.clear();
+}
+
+}; //namespace service
+}; //namespace uxas
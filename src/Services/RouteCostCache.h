@@ -0,0 +1,84 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   RouteCostCache.h
+ *
+ * Route costs of the last automation request, reused by the next one (see
+ * the ReuseRouteCosts option of the RouteAggregatorService).
+ */
+
+#ifndef UXAS_SERVICE_ROUTE_COST_CACHE_H
+#define UXAS_SERVICE_ROUTE_COST_CACHE_H
+
+#include "uxas/messages/route/RouteConstraints.h"
+
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+namespace uxas
+{
+namespace service
+{
+
+/*! \class RouteCostCache
+ *  \brief Route costs by vehicle, operating region, planning speed and start/end pose.
+ * Routes with equal keys have equal costs, so the routes of a request that match a route of the last
+ * completed request reuse its cost instead of being planned again.
+ *
+ * The key of each route of a pending request is kept until its cost is added (the
+ * request's matrix is complete) or the route is removed (the request is dropped). The
+ * costs of a completed request replace the stored costs.
+ */
+class RouteCostCache
+{
+public:
+    RouteCostCache() { };
+    ~RouteCostCache() { };
+
+public:
+    /** brief keeps the key of a route of a pending request, returns true and the cost if a
+     * route with the same key was planned for the last completed request */
+    bool isFindRouteCost(int64_t vehicleId, int64_t operatingRegion, double planningSpeed_mps, uxas::messages::route::RouteConstraints* routeConstraints, int64_t& routeCost_ms);
+    /** brief adds the cost of a route of the request being completed (negative costs, i.e. no
+     * route found, are not kept) */
+    void addRouteCost(int64_t routeId, int64_t routeCost_ms);
+    /** brief the costs added since the last call replace the stored costs */
+    void commitRouteCosts();
+    /** brief forgets the key of a route whose request was dropped */
+    void removeRoute(int64_t routeId);
+    /** brief discards the stored costs and the keys of pending routes, e.g. when zones or
+     * vehicle speeds changed */
+    void clear();
+
+    size_t getRouteCostCount() const { return (m_routeCostCache.size()); };
+    size_t getPendingRouteCount() const { return (m_routeIdVsCostKey.size()); };
+
+private:
+    //               vehicle ID, operating region, planning speed, start latitude, longitude, altitude, heading, end latitude, longitude, altitude, heading
+    typedef std::tuple<int64_t, int64_t, double, double, double, double, double, double, double, double, double> RouteCostKey;
+    /*! \brief  route costs of the last completed request*/
+    std::map<RouteCostKey, int64_t> m_routeCostCache;
+    /*! \brief  route costs of the request being completed*/
+    std::map<RouteCostKey, int64_t> m_addedRouteCosts;
+    //                route id,  route cost key
+    std::unordered_map<int64_t, RouteCostKey> m_routeIdVsCostKey;
+
+private:
+    /*! @name Private: No Copying*/
+    RouteCostCache(const RouteCostCache& rhs) = delete; //no copying
+    RouteCostCache& operator=(const RouteCostCache&) = delete; //no copying
+};
+
+}; //namespace service
+}; //namespace uxas
+
+#endif /* UXAS_SERVICE_ROUTE_COST_CACHE_H */
@@ -20,6 +20,7 @@
 #include "UnitConversions.h"
 #include "Constants/Convert.h"
 #include "Constants/UxAS_String.h"
+#include "stdUniquePtr.h"
 
 #include "afrl/cmasi/CMASI.h"
 #include "afrl/impact/IMPACT.h"
@@ -28,12 +29,15 @@
 #include "pugixml.hpp"
 
 #include <algorithm>
+#include <iterator>
+#include <map>
 
 #define STRING_COMPONENT_NAME "RoutePlanner"
 #define STRING_XML_COMPONENT_TYPE STRING_COMPONENT_NAME
 
 #define STRING_XML_COMPONENT "Component"
 #define STRING_XML_TYPE "Type"
+#define STRING_XML_ROUTE_PLANNING_THREAD_COUNT "RoutePlanningThreadCount"
 
 namespace uxas
 {
@@ -49,11 +53,30 @@ RoutePlannerService::RoutePlannerService()
 
 RoutePlannerService::~RoutePlannerService()
 {
+    // queued requests reference this service, so drain them before members are destroyed
+    if (m_routePlanningThreadPool)
+    {
+        m_routePlanningThreadPool->shutdown();
+    }
 };
 
 bool
 RoutePlannerService::configure(const pugi::xml_node& serviceXmlNode)
 {
+    if (!serviceXmlNode.attribute(STRING_XML_ROUTE_PLANNING_THREAD_COUNT).empty())
+    {
+        m_routePlanningThreadCount = serviceXmlNode.attribute(STRING_XML_ROUTE_PLANNING_THREAD_COUNT).as_uint();
+        if (m_routePlanningThreadCount == 0)
+        {
+            m_routePlanningThreadCount = uxas::common::ThreadPool::getHardwareThreadCount();
+        }
+        UXAS_LOG_INFORM(s_typeName(), "::configure set route planning thread count to ", m_routePlanningThreadCount, " from XML");
+    }
+    if (m_routePlanningThreadCount > 1)
+    {
+        m_routePlanningThreadPool = uxas::stduxas::make_unique<uxas::common::ThreadPool>(m_routePlanningThreadCount);
+    }
+
     // Need to track:
     //  (1) environment construction (keep-in/keep-out zones and operating region)
     //  (2) current states of entities for non-specified start locations
@@ -84,6 +107,17 @@ RoutePlannerService::configure(const pugi::xml_node& serviceXmlNode)
     return true;
 }
 
+bool
+RoutePlannerService::terminate()
+{
+    // finishes (and responds to) all queued requests before returning
+    if (m_routePlanningThreadPool)
+    {
+        m_routePlanningThreadPool->shutdown();
+    }
+    return (true);
+}
+
 bool
 RoutePlannerService::processReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage)
 //example: if (afrl::cmasi::isServiceStatus(receivedLmcpMessage->m_object.get()))
@@ -95,15 +129,27 @@ RoutePlannerService::processReceivedLmcpMessage(std::unique_ptr<uxas::communicat
         if (m_airVehicles.find(request->getVehicleID()) != m_airVehicles.end() ||
                 m_surfaceVehicles.find(request->getVehicleID()) != m_surfaceVehicles.end())
         {
-            std::shared_ptr<uxas::messages::route::RoutePlanResponse> response = HandleRoutePlanRequestMsg(request);
-            std::shared_ptr<avtas::lmcp::Object> pResponse = std::static_pointer_cast<avtas::lmcp::Object>(response);
             // always limited-cast route plan responses
-            sendSharedLmcpObjectLimitedCastMessage(
-                    getNetworkClientUnicastAddress(
+            std::string responseAddress = getNetworkClientUnicastAddress(
                         receivedLmcpMessage->m_attributes->getSourceEntityId(),
-                        receivedLmcpMessage->m_attributes->getSourceServiceId()
-                    ),
-                    pResponse);
+                        receivedLmcpMessage->m_attributes->getSourceServiceId());
+            if (m_routePlanningThreadPool)
+            {
+                // plan on the pool so that concurrent requests are planned in parallel
+                std::shared_ptr<PreparedRoutePlanRequest> prepared = PrepareRoutePlanRequest(request);
+                m_routePlanningThreadPool->post([this, prepared, responseAddress]()
+                {
+                    std::shared_ptr<avtas::lmcp::Object> pResponse = std::static_pointer_cast<avtas::lmcp::Object>(PlanRoutes(*prepared));
+                    std::lock_guard<std::mutex> lock(m_sendMutex);
+                    sendSharedLmcpObjectLimitedCastMessage(responseAddress, pResponse);
+                });
+            }
+            else
+            {
+                std::shared_ptr<uxas::messages::route::RoutePlanResponse> response = HandleRoutePlanRequestMsg(request);
+                std::shared_ptr<avtas::lmcp::Object> pResponse = std::static_pointer_cast<avtas::lmcp::Object>(response);
+                sendSharedLmcpObjectLimitedCastMessage(responseAddress, pResponse);
+            }
         }
     }
     else if (afrl::cmasi::isEntityState(receivedLmcpMessage->m_object.get()))
@@ -203,42 +249,31 @@ RoutePlannerService::processReceivedLmcpMessage(std::unique_ptr<uxas::communicat
         std::shared_ptr<afrl::cmasi::KeepInZone> kiZone = std::static_pointer_cast<afrl::cmasi::KeepInZone>(receivedLmcpMessage->m_object);
         int64_t id = kiZone->getZoneID();
         auto zone = m_keepInZones.find(id);
-        if (zone != m_keepInZones.end())
+        bool isZoneChanged = (zone == m_keepInZones.end()) || !(zone->second->operator==(*kiZone));
+        m_keepInZones[id] = kiZone;
+        if (isZoneChanged)
         {
-            if (!(zone->second->operator==(*kiZone)))
-            {
-                UpdateRegions(receivedLmcpMessage->m_object); // an existing region was updated
-            }
+            UpdateRegions(receivedLmcpMessage->m_object); // a new or updated zone of existing regions
         }
-        m_keepInZones[id] = kiZone;
     }
     else if (afrl::cmasi::isKeepOutZone(receivedLmcpMessage->m_object.get()))
     {
         std::shared_ptr<afrl::cmasi::KeepOutZone> koZone = std::static_pointer_cast<afrl::cmasi::KeepOutZone>(receivedLmcpMessage->m_object);
         int64_t id = koZone->getZoneID();
         auto zone = m_keepOutZones.find(id);
-        if (zone != m_keepOutZones.end())
+        bool isZoneChanged = (zone == m_keepOutZones.end()) || !(zone->second->operator==(*koZone));
+        m_keepOutZones[id] = koZone;
+        if (isZoneChanged)
         {
-            if (!(zone->second->operator==(*koZone)))
-            {
-                UpdateRegions(receivedLmcpMessage->m_object);
-            }
+            UpdateRegions(receivedLmcpMessage->m_object); // e.g., a pop-up keep-out zone
         }
-        m_keepOutZones[id] = koZone;
     }
     else if (afrl::cmasi::isOperatingRegion(receivedLmcpMessage->m_object.get()))
     {
         std::shared_ptr<afrl::cmasi::OperatingRegion> region = std::static_pointer_cast<afrl::cmasi::OperatingRegion>(receivedLmcpMessage->m_object);
         int64_t id = region->getID();
         auto r = m_operatingRegions.find(id);
-        if (r != m_operatingRegions.end())
-        {
-            if (!(r->second->operator==(*region)))
-            {
-                BuildVisibilityRegion(region);
-            }
-        }
-        else
+        if (r == m_operatingRegions.end() || !(r->second->operator==(*region)))
         {
             m_operatingRegions[id] = region;
             BuildVisibilityRegion(region);
@@ -251,37 +286,90 @@ RoutePlannerService::processReceivedLmcpMessage(std::unique_ptr<uxas::communicat
 void RoutePlannerService::BuildVisibilityRegion(std::shared_ptr<afrl::cmasi::OperatingRegion> region)
 {
     // completely new/updated region, so clear everything out for all vehicles
+    // (keeping the previous graphs to update them rather than rebuild them)
+    std::unordered_map<int64_t, SharedVisibilityGraph> previousVehicleGraphs;
     auto env = m_environments.find(region->getID());
     if (env != m_environments.end())
     {
+        for (auto& vehicleEnvironment : env->second)
+        {
+            previousVehicleGraphs[vehicleEnvironment.first].m_environment = vehicleEnvironment.second;
+        }
         env->second.clear();
     }
 
     auto graph = m_visgraphs.find(region->getID());
     if (graph != m_visgraphs.end())
     {
+        for (auto& vehicleGraph : graph->second)
+        {
+            previousVehicleGraphs[vehicleGraph.first].m_visibilityGraph = vehicleGraph.second;
+        }
         graph->second.clear();
     }
+    m_sharedVisibilityGraphs.erase(region->getID());
 
-    // for each eligible vehicle (surface/air) build a visibility environment and graph
+    // group eligible vehicles (surface/air) by the visibility graph they plan against
+    std::map<VisibilityGraphKey, std::vector<int64_t> > vehicleIdsByKey;
     for (auto id = m_airVehicles.begin(); id != m_airVehicles.end(); id++)
     {
-        BuildVehicleSpecificRegion(region, *id, nullptr);
+        vehicleIdsByKey[GetVisibilityGraphKey(region, *id, nullptr)].push_back(*id);
     }
     for (auto id = m_surfaceVehicles.begin(); id != m_surfaceVehicles.end(); id++)
     {
-        afrl::cmasi::AbstractGeometry* waterzone = nullptr;
+        std::shared_ptr<afrl::impact::WaterZone> waterzone;
         auto surfaceConfig = m_entityConfigurations.find(*id);
         if (surfaceConfig != m_entityConfigurations.end())
         {
             std::shared_ptr<afrl::vehicles::SurfaceVehicleConfiguration> config = std::static_pointer_cast<afrl::vehicles::SurfaceVehicleConfiguration>(surfaceConfig->second);
-            if (m_waterZones.find(config->getWaterArea()) != m_waterZones.end())
+            auto wzone = m_waterZones.find(config->getWaterArea());
+            if (wzone != m_waterZones.end())
             {
-                waterzone = m_waterZones[config->getWaterArea()]->getBoundary();
+                waterzone = wzone->second;
             }
         }
-        BuildVehicleSpecificRegion(region, *id, waterzone);
+        vehicleIdsByKey[GetVisibilityGraphKey(region, *id, waterzone)].push_back(*id);
     }
+
+    // build each distinct environment and graph once and share it
+    std::vector<VisibilityGraphKey> keys;
+    std::vector<SharedVisibilityGraph> previousGraphs;
+    size_t updatedGraphCount = 0;
+    for (auto& keyVehicleIds : vehicleIdsByKey)
+    {
+        keys.push_back(keyVehicleIds.first);
+        previousGraphs.push_back(SharedVisibilityGraph());
+        for (auto vehicleId : keyVehicleIds.second)
+        {
+            auto previousGraph = previousVehicleGraphs.find(vehicleId);
+            if (previousGraph != previousVehicleGraphs.end() && previousGraph->second.m_visibilityGraph)
+            {
+                previousGraphs.back() = previousGraph->second;
+                updatedGraphCount++;
+                break;
+            }
+        }
+    }
+    std::vector<SharedVisibilityGraph> graphs;
+    BuildVisibilityGraphs(region, keys, previousGraphs, graphs);
+
+    size_t vehicleCount = 0;
+    size_t k = 0;
+    for (auto& keyVehicleIds : vehicleIdsByKey)
+    {
+        if (graphs[k].m_visibilityGraph)
+        {
+            m_sharedVisibilityGraphs[region->getID()][keyVehicleIds.first] = graphs[k];
+            for (auto vehicleId : keyVehicleIds.second)
+            {
+                SetVehicleVisibilityGraph(region->getID(), vehicleId, graphs[k]);
+            }
+        }
+        vehicleCount += keyVehicleIds.second.size();
+        k++;
+    }
+    UXAS_LOG_INFORM(s_typeName(), "::BuildVisibilityRegion built ", keys.size(), " visibility graph(s) (", updatedGraphCount,
+                    " updated from previous graphs) for ", vehicleCount, " vehicle(s) in operating region ", region->getID());
 }
 
 void RoutePlannerService::UpdateRegions(std::shared_ptr<avtas::lmcp::Object> msg)
@@ -317,10 +405,11 @@ void RoutePlannerService::UpdateRegions(std::shared_ptr<avtas::lmcp::Object> msg
     else if (afrl::vehicles::isSurfaceVehicleConfiguration(msg.get()))
     {
         std::shared_ptr<afrl::vehicles::SurfaceVehicleConfiguration> surfconfig = std::static_pointer_cast<afrl::vehicles::SurfaceVehicleConfiguration>(msg);
-        afrl::cmasi::AbstractGeometry* waterzone = nullptr;
-        if (m_waterZones.find(surfconfig->getWaterArea()) != m_waterZones.end())
+        std::shared_ptr<afrl::impact::WaterZone> waterzone;
+        auto wzone = m_waterZones.find(surfconfig->getWaterArea());
+        if (wzone != m_waterZones.end())
         {
-            waterzone = m_waterZones[surfconfig->getWaterArea()]->getBoundary();
+            waterzone = wzone->second;
         }
         bool hasZeroRegion = false;
         for (auto r = m_operatingRegions.begin(); r != m_operatingRegions.end(); r++)
@@ -374,103 +463,222 @@ void RoutePlannerService::UpdateRegions(std::shared_ptr<avtas::lmcp::Object> msg
     }
 }
 
-void RoutePlannerService::BuildVehicleSpecificRegion(std::shared_ptr<afrl::cmasi::OperatingRegion> region, int64_t vehicleId, afrl::cmasi::AbstractGeometry* geom)
+void RoutePlannerService::BuildVehicleSpecificRegion(std::shared_ptr<afrl::cmasi::OperatingRegion> region, int64_t vehicleId, std::shared_ptr<afrl::impact::WaterZone> waterZone)
+{
+    // share the graph of another vehicle with the same zones, if there is one
+    VisibilityGraphKey key = GetVisibilityGraphKey(region, vehicleId, waterZone);
+    auto& regionGraphs = m_sharedVisibilityGraphs[region->getID()];
+    auto sharedGraph = regionGraphs.find(key);
+    if (sharedGraph == regionGraphs.end())
+    {
+        std::vector<SharedVisibilityGraph> previousGraphs(1);
+        auto env = m_environments[region->getID()].find(vehicleId);
+        auto graph = m_visgraphs[region->getID()].find(vehicleId);
+        if (env != m_environments[region->getID()].end() && graph != m_visgraphs[region->getID()].end())
+        {
+            previousGraphs.front().m_environment = env->second;
+            previousGraphs.front().m_visibilityGraph = graph->second;
+        }
+        std::vector<SharedVisibilityGraph> graphs;
+        BuildVisibilityGraphs(region, std::vector<VisibilityGraphKey>(1, key), previousGraphs, graphs);
+        if (!graphs.front().m_visibilityGraph)
+        {
+            return; // invalid environment, vehicle keeps its previous graph
+        }
+        sharedGraph = regionGraphs.insert(std::make_pair(key, graphs.front())).first;
+    }
+    SetVehicleVisibilityGraph(region->getID(), vehicleId, sharedGraph->second);
+
+    // forget graphs that no vehicle of the region plans against anymore
+    auto& vehicleGraphs = m_visgraphs[region->getID()];
+    for (auto g = regionGraphs.begin(); g != regionGraphs.end();)
+    {
+        bool isReferenced = std::any_of(vehicleGraphs.begin(), vehicleGraphs.end(),
+                                        [&g](const std::pair<const int64_t, std::shared_ptr<VisiLibity::Visibility_Graph> >& vehicleGraph)
+                                        {
+                                            return (vehicleGraph.second == g->second.m_visibilityGraph);
+                                        });
+        g = isReferenced ? std::next(g) : regionGraphs.erase(g);
+    }
+}
+
+RoutePlannerService::VisibilityGraphKey
+RoutePlannerService::GetVisibilityGraphKey(std::shared_ptr<afrl::cmasi::OperatingRegion> region, int64_t vehicleId, std::shared_ptr<afrl::impact::WaterZone> waterZone)
+{
+    // a zone applies to the vehicle if it lists the vehicle or lists no vehicles at all
+    VisibilityGraphKey key;
+    for (size_t n = 0; n < region->getKeepOutAreas().size(); n++)
+    {
+        auto zone = m_keepOutZones.find(region->getKeepOutAreas().at(n));
+        if (zone != m_keepOutZones.end())
+        {
+            const std::vector<int64_t>& affected = zone->second->getAffectedAircraft();
+            if (affected.empty() || std::find(affected.begin(), affected.end(), vehicleId) != affected.end())
+            {
+                key.m_keepOutZoneIds.push_back(zone->first);
+            }
+        }
+    }
+    for (size_t n = 0; n < region->getKeepInAreas().size(); n++)
+    {
+        auto zone = m_keepInZones.find(region->getKeepInAreas().at(n));
+        if (zone != m_keepInZones.end())
+        {
+            const std::vector<int64_t>& affected = zone->second->getAffectedAircraft();
+            if (affected.empty() || std::find(affected.begin(), affected.end(), vehicleId) != affected.end())
+            {
+                key.m_keepInZoneIds.push_back(zone->first);
+            }
+        }
+    }
+    key.m_waterZone = waterZone;
+    return (key);
+}
+
+void RoutePlannerService::BuildVisibilityGraphs(std::shared_ptr<afrl::cmasi::OperatingRegion> region, const std::vector<VisibilityGraphKey>& keys,
+                                                const std::vector<SharedVisibilityGraph>& previousGraphs, std::vector<SharedVisibilityGraph>& graphs)
+{
+    // linearize each referenced zone once, on this thread (unit conversions are not thread-safe)
+    std::unordered_map<int64_t, ZonePolygon> keepOutPolygons;
+    std::unordered_map<int64_t, ZonePolygon> keepInPolygons;
+    std::map<std::shared_ptr<afrl::impact::WaterZone>, ZonePolygon> waterPolygons;
+    std::vector<VisibilityGraphInput> inputs(keys.size());
+    for (size_t k = 0; k < keys.size(); k++)
+    {
+        inputs[k].m_isBoundedByKeepOutZones = region->getKeepInAreas().empty();
+        if (k < previousGraphs.size())
+        {
+            inputs[k].m_previousGraph = previousGraphs[k];
+        }
+
+        for (auto zoneId : keys[k].m_keepOutZoneIds)
+        {
+            auto zonePolygon = keepOutPolygons.find(zoneId);
+            if (zonePolygon == keepOutPolygons.end())
+            {
+                std::shared_ptr<afrl::cmasi::KeepOutZone> zone = m_keepOutZones[zoneId];
+                ZonePolygon polygon;
+                polygon.m_isValid = LinearizeZone(zone->getBoundary(), polygon.m_polygon);
+                polygon.m_offset = (zone->getPadding() < 0.0) ? 0.0 : zone->getPadding();
+                zonePolygon = keepOutPolygons.insert(std::make_pair(zoneId, polygon)).first;
+            }
+            if (zonePolygon->second.m_isValid)
+            {
+                inputs[k].m_keepOutPolygons.push_back(zonePolygon->second);
+            }
+        }
+
+        for (auto zoneId : keys[k].m_keepInZoneIds)
+        {
+            auto zonePolygon = keepInPolygons.find(zoneId);
+            if (zonePolygon == keepInPolygons.end())
+            {
+                std::shared_ptr<afrl::cmasi::KeepInZone> zone = m_keepInZones[zoneId];
+                ZonePolygon polygon;
+                polygon.m_isValid = LinearizeZone(zone->getBoundary(), polygon.m_polygon);
+                polygon.m_offset = (zone->getPadding() > 0.0) ? 0.0 : zone->getPadding();
+                zonePolygon = keepInPolygons.insert(std::make_pair(zoneId, polygon)).first;
+            }
+            if (zonePolygon->second.m_isValid)
+            {
+                inputs[k].m_keepInPolygons.push_back(zonePolygon->second);
+            }
+        }
+
+        if (keys[k].m_waterZone)
+        {
+            auto zonePolygon = waterPolygons.find(keys[k].m_waterZone);
+            if (zonePolygon == waterPolygons.end())
+            {
+                ZonePolygon polygon;
+                polygon.m_isValid = LinearizeZone(keys[k].m_waterZone->getBoundary(), polygon.m_polygon);
+                polygon.m_offset = 0.0; // TODO: parameterize water zone padding
+                zonePolygon = waterPolygons.insert(std::make_pair(keys[k].m_waterZone, polygon)).first;
+            }
+            if (zonePolygon->second.m_isValid)
+            {
+                inputs[k].m_keepInPolygons.push_back(zonePolygon->second);
+            }
+        }
+    }
+
+    // build the environments and graphs
+    graphs.assign(keys.size(), SharedVisibilityGraph());
+    auto buildVisibilityGraph = [&inputs, &graphs](size_t k)
+    {
+        graphs[k] = BuildVisibilityGraph(inputs[k]);
+    };
+
+    if (m_routePlanningThreadPool && keys.size() > 1)
+    {
+        m_routePlanningThreadPool->parallelFor(keys.size(), buildVisibilityGraph);
+    }
+    else
+    {
+        for (size_t k = 0; k < keys.size(); k++)
+        {
+            buildVisibilityGraph(k);
+        }
+    }
+}
+
+RoutePlannerService::SharedVisibilityGraph
+RoutePlannerService::BuildVisibilityGraph(const VisibilityGraphInput& input)
 {
     double epsilon = 1e-4; // millimeter accuracy + tolerance
 
+    SharedVisibilityGraph sharedGraph;
     std::vector< VisiLibity::Polygon > polygonPlanningList;
     std::vector< VisiLibity::Polygon > polygonsToExpand;
     std::vector< double > expandValues;
     std::vector< VisiLibity::Polygon > polygonsToShrink;
     std::vector< double > shrinkValues;
 
-    // for each polygon:
-    //      linearize
-    //      eliminate redundant vertices
-    //      check orientation and reverse if needed
-    //      enforce standard form
-    //      insert to list
     VisiLibity::Bounding_Box zoneBox = { };
     bool boxInitialized = false;
     bool validKeepInZone = false;
 
     // add keep out zones to expansion list
-    for (size_t n = 0; n < region->getKeepOutAreas().size(); n++)
+    for (auto& zonePolygon : input.m_keepOutPolygons)
     {
-        auto zone = m_keepOutZones.find(region->getKeepOutAreas().at(n));
-        if (zone != m_keepOutZones.end())
+        const VisiLibity::Polygon& poly = zonePolygon.m_polygon;
+        polygonsToExpand.push_back(poly);
+        expandValues.push_back(zonePolygon.m_offset);
+
+        // update bounding box
+        if (input.m_isBoundedByKeepOutZones)
         {
-            bool isZoneApplicable = false;
-            for (size_t k = 0; k < zone->second->getAffectedAircraft().size(); k++)
+            VisiLibity::Bounding_Box bbox;
+            bbox.x_max = poly[0].x();
+            bbox.x_min = poly[0].x();
+            bbox.y_max = poly[0].y();
+            bbox.y_min = poly[0].y();
+            for (size_t k = 1; k < poly.n(); k++)
             {
-                if (zone->second->getAffectedAircraft().at(k) == vehicleId)
-                {
-                    isZoneApplicable = true;
-                    break;
-                }
+                double x = poly[k].x();
+                double y = poly[k].y();
+                if (x > bbox.x_max) bbox.x_max = x;
+                if (x < bbox.x_min) bbox.x_min = x;
+                if (y > bbox.y_max) bbox.y_max = y;
+                if (y < bbox.y_min) bbox.y_min = y;
             }
-
-            if (isZoneApplicable || zone->second->getAffectedAircraft().empty())
+            if (!boxInitialized)
             {
-                VisiLibity::Polygon poly;
-                afrl::cmasi::AbstractGeometry* boundary = zone->second->getBoundary();
-                double delta = (zone->second->getPadding() < 0.0) ? 0.0 : zone->second->getPadding();
-
-                // linearize
-                if (LinearizeBoundary(boundary, poly))
-                {
-                    // remove excess points
-                    poly.eliminate_redundant_vertices(1.0);
-
-                    // ensure that the polygon is simple
-                    if (poly.is_simple(epsilon))
-                    {
-                        // ensure that the polygon is properly oriented
-                        if (poly.area() < 0)
-                            poly.reverse();
-
-                        // add to list
-                        polygonsToExpand.push_back(poly);
-                        expandValues.push_back(delta);
-
-                        // update bounding box
-                        if (region->getKeepInAreas().empty())
-                        {
-                            VisiLibity::Bounding_Box bbox;
-                            bbox.x_max = poly[0].x();
-                            bbox.x_min = poly[0].x();
-                            bbox.y_max = poly[0].y();
-                            bbox.y_min = poly[0].y();
-                            for (size_t k = 1; k < poly.n(); k++)
-                            {
-                                double x = poly[k].x();
-                                double y = poly[k].y();
-                                if (x > bbox.x_max) bbox.x_max = x;
-                                if (x < bbox.x_min) bbox.x_min = x;
-                                if (y > bbox.y_max) bbox.y_max = y;
-                                if (y < bbox.y_min) bbox.y_min = y;
-                            }
-                            if (!boxInitialized)
-                            {
-                                zoneBox.x_max = bbox.x_max;
-                                zoneBox.x_min = bbox.x_min;
-                                zoneBox.y_max = bbox.y_max;
-                                zoneBox.y_min = bbox.y_min;
-                                boxInitialized = true;
-                            }
-                            else
-                            {
-                                if (bbox.x_max > zoneBox.x_max) zoneBox.x_max = bbox.x_max;
-                                if (bbox.x_min < zoneBox.x_min) zoneBox.x_min = bbox.x_min;
-                                if (bbox.y_max > zoneBox.y_max) zoneBox.y_max = bbox.y_max;
-                                if (bbox.y_min < zoneBox.y_min) zoneBox.y_min = bbox.y_min;
-                            }
-                        }
-                    }
-                }
+                zoneBox.x_max = bbox.x_max;
+                zoneBox.x_min = bbox.x_min;
+                zoneBox.y_max = bbox.y_max;
+                zoneBox.y_min = bbox.y_min;
+                boxInitialized = true;
+            }
+            else
+            {
+                if (bbox.x_max > zoneBox.x_max) zoneBox.x_max = bbox.x_max;
+                if (bbox.x_min < zoneBox.x_min) zoneBox.x_min = bbox.x_min;
+                if (bbox.y_max > zoneBox.y_max) zoneBox.y_max = bbox.y_max;
+                if (bbox.y_min < zoneBox.y_min) zoneBox.y_min = bbox.y_min;
             }
         }
-    } // done with keep in zones
+    }
 
     // expand all polygons
     std::vector< VisiLibity::Polygon > expandedPolygons;
@@ -492,66 +700,11 @@ void RoutePlannerService::BuildVehicleSpecificRegion(std::shared_ptr<afrl::cmasi
             polygonPlanningList.push_back(expandedPolygons[n]);
         }
 
-        // keep out zones are expanded and added, now process all keep in zones
-        for (size_t n = 0; n < region->getKeepInAreas().size(); n++)
+        // keep out zones are expanded and added, now process all keep in zones (water zone last)
+        for (auto& zonePolygon : input.m_keepInPolygons)
         {
-            VisiLibity::Polygon poly;
-            auto zone = m_keepInZones.find(region->getKeepInAreas().at(n));
-            if (zone != m_keepInZones.end())
-            {
-                bool isZoneApplicable = false;
-                for (size_t k = 0; k < zone->second->getAffectedAircraft().size(); k++)
-                {
-                    if (zone->second->getAffectedAircraft().at(k) == vehicleId)
-                    {
-                        isZoneApplicable = true;
-                        break;
-                    }
-                }
-
-                if (isZoneApplicable || zone->second->getAffectedAircraft().empty())
-                {
-                    afrl::cmasi::AbstractGeometry* boundary = zone->second->getBoundary();
-                    double delta = (zone->second->getPadding() > 0.0) ? 0.0 : zone->second->getPadding();
-
-                    // linearize
-                    if (LinearizeBoundary(boundary, poly))
-                    {
-                        // remove excess points
-                        poly.eliminate_redundant_vertices(1.0);
-
-                        // ensure that the polygon is simple
-                        if (poly.is_simple(epsilon))
-                        {
-                            // ensure that the polygon is properly oriented
-                            if (poly.area() < 0)
-                                poly.reverse();
-
-                            polygonsToShrink.push_back(poly);
-                            shrinkValues.push_back(delta);
-                        }
-                    }
-                }
-            }
-        }
-
-        // add water zone
-        VisiLibity::Polygon waterpoly;
-        if (geom && LinearizeBoundary(geom, waterpoly))
-        {
-            // remove excess points
-            waterpoly.eliminate_redundant_vertices(1.0);
-
-            // ensure that the polygon is simple
-            if (waterpoly.is_simple(epsilon))
-            {
-                // ensure that the polygon is properly oriented
-                if (waterpoly.area() < 0)
-                    waterpoly.reverse();
-
-                polygonsToShrink.push_back(waterpoly);
-                shrinkValues.push_back(0.0); // TODO: parameterize water zone padding
-            }
+            polygonsToShrink.push_back(zonePolygon.m_polygon);
+            shrinkValues.push_back(zonePolygon.m_offset);
         }
 
         // shrink all polygons
@@ -623,22 +776,57 @@ void RoutePlannerService::BuildVehicleSpecificRegion(std::shared_ptr<afrl::cmasi
         if (!polygonPlanningList.empty())
         {
             // create environment
-            VisiLibity::Environment* environment = new VisiLibity::Environment(polygonPlanningList);
+            std::shared_ptr<VisiLibity::Environment> environment = std::make_shared<VisiLibity::Environment>(polygonPlanningList);
 
             // check for epsilon valid
             if (environment->is_valid(epsilon))
             {
-                // save environment
-                m_environments[region->getID()][vehicleId].reset(environment);
-                // create visibility graph
-                m_visgraphs[region->getID()][vehicleId].reset(new VisiLibity::Visibility_Graph(*environment, epsilon));
-            }
-            else
-            {
-                delete environment;
+                // create visibility graph (only recomputing the visibility changed by the zones, if possible)
+                sharedGraph.m_environment = environment;
+                if (input.m_previousGraph.m_environment && input.m_previousGraph.m_visibilityGraph)
+                {
+                    sharedGraph.m_visibilityGraph = std::make_shared<VisiLibity::Visibility_Graph>(*input.m_previousGraph.m_visibilityGraph,
+                                                                                                   *input.m_previousGraph.m_environment, *environment, epsilon);
+                }
+                else
+                {
+                    sharedGraph.m_visibilityGraph = std::make_shared<VisiLibity::Visibility_Graph>(*environment, epsilon);
+                }
             }
         }
     }
+    return (sharedGraph);
+}
+
+void RoutePlannerService::SetVehicleVisibilityGraph(int64_t regionId, int64_t vehicleId, const SharedVisibilityGraph& graph)
+{
+    m_environments[regionId][vehicleId] = graph.m_environment;
+    m_visgraphs[regionId][vehicleId] = graph.m_visibilityGraph;
+}
+
+bool RoutePlannerService::LinearizeZone(afrl::cmasi::AbstractGeometry* boundary, VisiLibity::Polygon& poly)
+{
+    double epsilon = 1e-4; // millimeter accuracy + tolerance
+
+    // linearize
+    if (!boundary || !LinearizeBoundary(boundary, poly))
+    {
+        return (false);
+    }
+
+    // remove excess points
+    poly.eliminate_redundant_vertices(1.0);
+
+    // ensure that the polygon is simple
+    if (!poly.is_simple(epsilon))
+    {
+        return (false);
+    }
+
+    // ensure that the polygon is properly oriented
+    if (poly.area() < 0)
+        poly.reverse();
+    return (true);
 }
 
 bool RoutePlannerService::LinearizeBoundary(afrl::cmasi::AbstractGeometry* boundary, VisiLibity::Polygon& poly)
@@ -710,15 +898,22 @@ bool RoutePlannerService::LinearizeBoundary(afrl::cmasi::AbstractGeometry* bound
 std::shared_ptr<uxas::messages::route::RoutePlanResponse>
 RoutePlannerService::HandleRoutePlanRequestMsg(std::shared_ptr<uxas::messages::route::RoutePlanRequest> request)
 {
+    return PlanRoutes(*PrepareRoutePlanRequest(request));
+}
+
+std::shared_ptr<RoutePlannerService::PreparedRoutePlanRequest>
+RoutePlannerService::PrepareRoutePlanRequest(std::shared_ptr<uxas::messages::route::RoutePlanRequest> request)
+{
+    // all lat/long to north/east conversions happen here, on the service thread,
+    // which also guarantees the flat-earth reference is initialized before any
+    // planning thread converts back to lat/long
     uxas::common::utilities::CUnitConversions flatEarth;
+    auto prepared = std::make_shared<PreparedRoutePlanRequest>();
+    prepared->m_request = request;
     VisiLibity::Point vehiclePt;
-    double speed = -1.0;
-    double alt = 0.0;
-    afrl::cmasi::AltitudeType::AltitudeType altType = afrl::cmasi::AltitudeType::MSL;
 
     int64_t regionId = request->getOperatingRegion();
     int64_t vehicleId = request->getVehicleID();
-    int64_t taskId = request->getAssociatedTaskID();
     bool hasState = false;
 
     auto state = m_entityStates.find(vehicleId);
@@ -728,37 +923,46 @@ RoutePlannerService::HandleRoutePlanRequestMsg(std::shared_ptr<uxas::messages::r
         flatEarth.ConvertLatLong_degToNorthEast_m(state->second->getLocation()->getLatitude(), state->second->getLocation()->getLongitude(), north, east);
         vehiclePt.set_x(east);
         vehiclePt.set_y(north);
-        speed = state->second->getGroundspeed();
-        alt = state->second->getLocation()->getAltitude();
-        altType = state->second->getLocation()->getAltitudeType();
+        prepared->m_speed = state->second->getGroundspeed();
+        prepared->m_altitude = state->second->getLocation()->getAltitude();
+        prepared->m_altitudeType = state->second->getLocation()->getAltitudeType();
         hasState = true;
     }
 
     auto config = m_entityConfigurations.find(vehicleId);
-    if (config != m_entityConfigurations.end() && (!hasState || speed < 0.1))
+    if (config != m_entityConfigurations.end() && (!hasState || prepared->m_speed < 0.1))
     {
-        speed = config->second->getNominalSpeed();
-        alt = config->second->getNominalAltitude();
-        altType = config->second->getNominalAltitudeType();
+        prepared->m_speed = config->second->getNominalSpeed();
+        prepared->m_altitude = config->second->getNominalAltitude();
+        prepared->m_altitudeType = config->second->getNominalAltitudeType();
     }
 
-    // plan for all the requests
-    std::shared_ptr<uxas::messages::route::RoutePlanResponse> response(new uxas::messages::route::RoutePlanResponse);
-    response->setResponseID(request->getRequestID());
-    response->setAssociatedTaskID(taskId);
-    response->setVehicleID(vehicleId);
-    response->setOperatingRegion(regionId);
-    for (size_t k = 0; k < request->getRouteRequests().size(); k++)
+    // environment and visibility graph are only used as a pair
+    auto r = m_environments.find(regionId);
+    auto s = m_visgraphs.find(regionId);
+    if (r != m_environments.end() && s != m_visgraphs.end())
+    {
+        auto v = r->second.find(vehicleId);
+        auto vv = s->second.find(vehicleId);
+        if (v != r->second.end() && vv != s->second.end())
+        {
+            prepared->m_environment = v->second;
+            prepared->m_visibilityGraph = vv->second;
+        }
+    }
+
+    size_t routeCount = request->getRouteRequests().size();
+    prepared->m_hasValidLocations.resize(routeCount, false);
+    prepared->m_startPoints.resize(routeCount);
+    prepared->m_endPoints.resize(routeCount);
+    for (size_t k = 0; k < routeCount; k++)
     {
-        bool hasValidLocations = (speed < 1e-4) ? false : true;
+        bool hasValidLocations = (prepared->m_speed < 1e-4) ? false : true;
         uxas::messages::route::RouteConstraints* routeRequest = request->getRouteRequests().at(k);
-        int64_t routeId = routeRequest->getRouteID();
-        VisiLibity::Point startPt, endPt;
+        VisiLibity::Point& startPt = prepared->m_startPoints[k];
+        VisiLibity::Point& endPt = prepared->m_endPoints[k];
         double north, east;
 
-        uxas::messages::route::RoutePlan* plan = new uxas::messages::route::RoutePlan;
-        plan->setRouteID(routeId);
-
         if (routeRequest->getStartLocation() == nullptr && hasState)
         {
             startPt = vehiclePt;
@@ -789,106 +993,214 @@ RoutePlannerService::HandleRoutePlanRequestMsg(std::shared_ptr<uxas::messages::r
             hasValidLocations = false;
         }
 
-        if (hasValidLocations)
+        prepared->m_hasValidLocations[k] = hasValidLocations;
+    }
+
+    return prepared;
+}
+
+std::shared_ptr<uxas::messages::route::RoutePlanResponse>
+RoutePlannerService::PlanRoutes(const PreparedRoutePlanRequest& prepared)
+{
+    const auto& request = prepared.m_request;
+
+    // plan for all the requests
+    std::shared_ptr<uxas::messages::route::RoutePlanResponse> response(new uxas::messages::route::RoutePlanResponse);
+    response->setResponseID(request->getRequestID());
+    response->setAssociatedTaskID(request->getAssociatedTaskID());
+    response->setVehicleID(request->getVehicleID());
+    response->setOperatingRegion(request->getOperatingRegion());
+
+    // plans are stored by index so that responses keep the request order
+    std::vector<uxas::messages::route::RoutePlan*> plans(request->getRouteRequests().size(), nullptr);
+
+    // routes through the visibility graph are grouped by start location, so each
+    // group (e.g., a row of the aggregator's cost matrix) takes one single-source search
+    std::vector<VisiLibity::Point> points;
+    std::vector<size_t> startPointIndexes(plans.size(), 0);
+    std::vector<size_t> endPointIndexes(plans.size(), 0);
+    std::vector<std::vector<size_t> > rows;
+    if (prepared.m_environment && prepared.m_visibilityGraph)
+    {
+        std::map<std::pair<double, double>, size_t> pointIndexes;
+        std::map<size_t, size_t> startPointIndexVsRow;
+        auto getPointIndex = [&points, &pointIndexes](const VisiLibity::Point& point)
         {
-            bool hasEnvironment = false;
-            auto r = m_environments.find(regionId);
-            if (r != m_environments.end())
+            auto itPoint = pointIndexes.insert(std::make_pair(std::make_pair(point.x(), point.y()), points.size()));
+            if (itPoint.second)
             {
-                auto v = r->second.find(vehicleId);
-                if (v != r->second.end())
-                {
-                    VisiLibity::Environment* env = v->second.get();
-
-                    auto s = m_visgraphs.find(regionId);
-                    if (s != m_visgraphs.end())
-                    {
-                        auto vv = s->second.find(vehicleId);
-                        if (vv != s->second.end())
-                        {
-                            VisiLibity::Visibility_Graph* graph = vv->second.get();
-                            hasEnvironment = true;
-
-                            // make sure locations can be reached
-                            if (startPt.in(*env, 1e-4) && endPt.in(*env, 1e-4))
-                            {
-                                VisiLibity::Polyline path = env->shortest_path(startPt, endPt, *graph, 1e-4);
-                                // speed is guaranteed to be bounded postive away from zero by default setting on 'validLocations'
-                                // alt and altType are valid by same logic
-                                plan->setRouteCost((path.length() / speed * 1000)); // WARNING: in seconds -> change to miliseconds?? DONE RAS
-
-                                if (!request->getIsCostOnlyRequest())
-                                {
-                                    afrl::cmasi::Waypoint* wp;
-                                    for (size_t n = 0; n < path.size(); n++)
-                                    {
-                                        wp = new afrl::cmasi::Waypoint();
-                                        double lat, lon;
-                                        flatEarth.ConvertNorthEast_mToLatLong_deg(path[n].y(), path[n].x(), lat, lon);
-                                        wp->setLatitude(lat);
-                                        wp->setLongitude(lon);
-                                        wp->setAltitude(alt);
-                                        wp->setAltitudeType(altType);
-                                        wp->setNumber(n + 1);
-                                        wp->setNextWaypoint(n + 2);
-                                        if ((n + 1) >= path.size())
-                                        {
-                                            wp->setNextWaypoint(n + 1);
-                                        }
-                                        wp->setSpeed(speed);
-                                        wp->setTurnType(afrl::cmasi::TurnType::TurnShort);
-                                        plan->getWaypoints().push_back(wp);
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
+                points.push_back(point);
             }
-
-            if (!hasEnvironment)
+            return (itPoint.first->second);
+        };
+        for (size_t k = 0; k < plans.size(); k++)
+        {
+            if (prepared.m_hasValidLocations[k] && prepared.m_startPoints[k].in(*prepared.m_environment, 1e-4)
+                    && prepared.m_endPoints[k].in(*prepared.m_environment, 1e-4))
             {
-                // no valid region, so straight line plan
-                double linedist = VisiLibity::distance(startPt, endPt);
-                plan->setRouteCost((linedist / speed * 1000)); // WARNING: in seconds -> change to miliseconds?? DONE: RAS
-
-                if (!request->getIsCostOnlyRequest())
+                startPointIndexes[k] = getPointIndex(prepared.m_startPoints[k]);
+                endPointIndexes[k] = getPointIndex(prepared.m_endPoints[k]);
+                auto itRow = startPointIndexVsRow.insert(std::make_pair(startPointIndexes[k], rows.size()));
+                if (itRow.second)
                 {
-                    afrl::cmasi::Waypoint* wp;
-                    double lat, lon;
-
-                    wp = new afrl::cmasi::Waypoint();
-                    flatEarth.ConvertNorthEast_mToLatLong_deg(startPt.y(), startPt.x(), lat, lon);
-                    wp->setLatitude(lat);
-                    wp->setLongitude(lon);
-                    wp->setAltitude(alt);
-                    wp->setAltitudeType(altType);
-                    wp->setNumber(1);
-                    wp->setNextWaypoint(2);
-                    wp->setSpeed(speed);
-                    wp->setTurnType(afrl::cmasi::TurnType::TurnShort);
-                    plan->getWaypoints().push_back(wp);
-
-                    wp = new afrl::cmasi::Waypoint();
-                    flatEarth.ConvertNorthEast_mToLatLong_deg(endPt.y(), endPt.x(), lat, lon);
-                    wp->setLatitude(lat);
-                    wp->setLongitude(lon);
-                    wp->setAltitude(alt);
-                    wp->setAltitudeType(altType);
-                    wp->setNumber(2);
-                    wp->setNextWaypoint(2);
-                    wp->setSpeed(speed);
-                    wp->setTurnType(afrl::cmasi::TurnType::TurnShort);
-                    plan->getWaypoints().push_back(wp);
+                    rows.push_back(std::vector<size_t>());
                 }
+                rows[itRow.first->second].push_back(k);
             }
         }
+    }
+
+    // each point's visibility polygon is computed once and shared by all rows
+    std::vector<VisiLibity::Visibility_Polygon> visibilityPolygons(points.size());
+    auto computeVisibilityPolygon = [&prepared, &points, &visibilityPolygons](size_t p)
+    {
+        visibilityPolygons[p] = VisiLibity::Visibility_Polygon(points[p], *prepared.m_environment, 1e-4);
+    };
+    auto planRow = [this, &prepared, &plans, &rows, &startPointIndexes, &endPointIndexes, &visibilityPolygons](size_t row)
+    {
+        std::vector<const VisiLibity::Visibility_Polygon*> finishes;
+        for (auto k : rows[row])
+        {
+            finishes.push_back(&visibilityPolygons[endPointIndexes[k]]);
+        }
+        std::vector<VisiLibity::Polyline> paths = prepared.m_environment->shortest_paths(visibilityPolygons[startPointIndexes[rows[row].front()]],
+                                                                                         finishes, *prepared.m_visibilityGraph, 1e-4);
+        for (size_t f = 0; f < rows[row].size(); f++)
+        {
+            size_t k = rows[row][f];
+            plans[k] = new uxas::messages::route::RoutePlan;
+            plans[k]->setRouteID(prepared.m_request->getRouteRequests().at(k)->getRouteID());
+            SetRoutePath(prepared, paths[f], plans[k]);
+        }
+    };
+    auto planRemainingRoute = [this, &prepared, &plans](size_t k)
+    {
+        if (plans[k] == nullptr)
+        {
+            plans[k] = PlanRoute(prepared, k);
+        }
+    };
 
-        response->getRouteResponses().push_back(plan);
+    if (m_routePlanningThreadPool)
+    {
+        m_routePlanningThreadPool->parallelFor(visibilityPolygons.size(), computeVisibilityPolygon);
+        m_routePlanningThreadPool->parallelFor(rows.size(), planRow);
+        m_routePlanningThreadPool->parallelFor(plans.size(), planRemainingRoute);
     }
+    else
+    {
+        for (size_t p = 0; p < visibilityPolygons.size(); p++)
+        {
+            computeVisibilityPolygon(p);
+        }
+        for (size_t row = 0; row < rows.size(); row++)
+        {
+            planRow(row);
+        }
+        for (size_t k = 0; k < plans.size(); k++)
+        {
+            planRemainingRoute(k);
+        }
+    }
+    response->getRouteResponses().insert(response->getRouteResponses().end(), plans.begin(), plans.end());
 
     return response;
 }
 
+uxas::messages::route::RoutePlan*
+RoutePlannerService::PlanRoute(const PreparedRoutePlanRequest& prepared, size_t k)
+{
+    // routes that can be reached through the environment are planned per start
+    // location in PlanRoutes; with an environment, the rest cannot be reached and
+    // get no path. Only reads the prepared request, so routes can be planned concurrently
+    uxas::common::utilities::CUnitConversions flatEarth;
+    const auto& request = prepared.m_request;
+    double speed = prepared.m_speed;
+    double alt = prepared.m_altitude;
+    afrl::cmasi::AltitudeType::AltitudeType altType = prepared.m_altitudeType;
+    const VisiLibity::Point& startPt = prepared.m_startPoints[k];
+    const VisiLibity::Point& endPt = prepared.m_endPoints[k];
+
+    uxas::messages::route::RoutePlan* plan = new uxas::messages::route::RoutePlan;
+    plan->setRouteID(request->getRouteRequests().at(k)->getRouteID());
+
+    if (prepared.m_hasValidLocations[k])
+    {
+        if (!prepared.m_environment || !prepared.m_visibilityGraph)
+        {
+            // no valid region, so straight line plan
+            double linedist = VisiLibity::distance(startPt, endPt);
+            plan->setRouteCost((linedist / speed * 1000)); // WARNING: in seconds -> change to miliseconds?? DONE: RAS
+
+            if (!request->getIsCostOnlyRequest())
+            {
+                afrl::cmasi::Waypoint* wp;
+                double lat, lon;
+
+                wp = new afrl::cmasi::Waypoint();
+                flatEarth.ConvertNorthEast_mToLatLong_deg(startPt.y(), startPt.x(), lat, lon);
+                wp->setLatitude(lat);
+                wp->setLongitude(lon);
+                wp->setAltitude(alt);
+                wp->setAltitudeType(altType);
+                wp->setNumber(1);
+                wp->setNextWaypoint(2);
+                wp->setSpeed(speed);
+                wp->setTurnType(afrl::cmasi::TurnType::TurnShort);
+                plan->getWaypoints().push_back(wp);
+
+                wp = new afrl::cmasi::Waypoint();
+                flatEarth.ConvertNorthEast_mToLatLong_deg(endPt.y(), endPt.x(), lat, lon);
+                wp->setLatitude(lat);
+                wp->setLongitude(lon);
+                wp->setAltitude(alt);
+                wp->setAltitudeType(altType);
+                wp->setNumber(2);
+                wp->setNextWaypoint(2);
+                wp->setSpeed(speed);
+                wp->setTurnType(afrl::cmasi::TurnType::TurnShort);
+                plan->getWaypoints().push_back(wp);
+            }
+        }
+    }
+
+    return plan;
+}
+
+void
+RoutePlannerService::SetRoutePath(const PreparedRoutePlanRequest& prepared, const VisiLibity::Polyline& path, uxas::messages::route::RoutePlan* plan)
+{
+    uxas::common::utilities::CUnitConversions flatEarth;
+    double speed = prepared.m_speed;
+
+    // speed is guaranteed to be bounded postive away from zero by default setting on 'validLocations'
+    // alt and altType are valid by same logic
+    plan->setRouteCost((path.length() / speed * 1000)); // WARNING: in seconds -> change to miliseconds?? DONE RAS
+
+    if (!prepared.m_request->getIsCostOnlyRequest())
+    {
+        afrl::cmasi::Waypoint* wp;
+        for (size_t n = 0; n < path.size(); n++)
+        {
+            wp = new afrl::cmasi::Waypoint();
+            double lat, lon;
+            flatEarth.ConvertNorthEast_mToLatLong_deg(path[n].y(), path[n].x(), lat, lon);
+            wp->setLatitude(lat);
+            wp->setLongitude(lon);
+            wp->setAltitude(prepared.m_altitude);
+            wp->setAltitudeType(prepared.m_altitudeType);
+            wp->setNumber(n + 1);
+            wp->setNextWaypoint(n + 2);
+            if ((n + 1) >= path.size())
+            {
+                wp->setNextWaypoint(n + 1);
+            }
+            wp->setSpeed(speed);
+            wp->setTurnType(afrl::cmasi::TurnType::TurnShort);
+            plan->getWaypoints().push_back(wp);
+        }
+    }
+}
+
 }; //namespace service
 }; //namespace uxas
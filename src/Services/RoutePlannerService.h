@@ -25,10 +25,16 @@
 #include "afrl/impact/IMPACT.h"
 #include "afrl/vehicles/VEHICLES.h"
 #include "visilibity.h"
+#include "UxAS_ThreadPool.h"
 
 #include <unordered_map>
 #include <unordered_set>
 #include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
 
 namespace uxas
 {
@@ -44,7 +50,20 @@ namespace service
  * Configuration String: 
  * 
  * Options:
- *  - 
+ *  - RoutePlanningThreadCount - number of threads used to plan routes
+ *    (default 1: routes are planned serially on the service thread; 0: one
+ *    thread per hardware thread). With more than one thread, each request is
+ *    planned on the pool while the service keeps receiving, and the routes of
+ *    each request are planned in parallel against the read-only visibility
+ *    graph.
+ * 
+ * Visibility graphs: vehicles of an operating region that are affected by the
+ * same keep-in/keep-out zones (and, for surface vehicles, bounded by the same
+ * water zone) plan against one shared, read-only environment and graph. When
+ * a region is rebuilt, each distinct graph is built once (in parallel on the
+ * route planning pool, if there is one). When zones change, graphs are
+ * updated from the previous graph of their vehicles: only the visibility of
+ * vertices near added or removed obstacles is recomputed.
  * 
  * Subscribed Messages:
  *  - 
@@ -111,6 +130,9 @@ private:
     //bool
     //terminate() override;
 
+    bool
+    terminate() override;
+
     bool
     processReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage) override;
 
@@ -132,10 +154,85 @@ private:
 
 
 
+    /** \brief Everything needed to plan the routes of one request, gathered
+     * on the service thread so that planning itself does not read service
+     * state (which the service thread keeps updating). Environment and graph
+     * are shared, so a concurrent region rebuild does not invalidate them. */
+    struct PreparedRoutePlanRequest
+    {
+        std::shared_ptr<uxas::messages::route::RoutePlanRequest> m_request;
+        double m_speed{-1.0};
+        double m_altitude{0.0};
+        afrl::cmasi::AltitudeType::AltitudeType m_altitudeType{afrl::cmasi::AltitudeType::MSL};
+        std::shared_ptr<VisiLibity::Environment> m_environment;
+        std::shared_ptr<VisiLibity::Visibility_Graph> m_visibilityGraph;
+        std::vector<bool> m_hasValidLocations;
+        std::vector<VisiLibity::Point> m_startPoints;
+        std::vector<VisiLibity::Point> m_endPoints;
+    };
+
     std::shared_ptr<uxas::messages::route::RoutePlanResponse> HandleRoutePlanRequestMsg(std::shared_ptr<uxas::messages::route::RoutePlanRequest>);
+    std::shared_ptr<PreparedRoutePlanRequest> PrepareRoutePlanRequest(std::shared_ptr<uxas::messages::route::RoutePlanRequest>);
+    std::shared_ptr<uxas::messages::route::RoutePlanResponse> PlanRoutes(const PreparedRoutePlanRequest&);
+    uxas::messages::route::RoutePlan* PlanRoute(const PreparedRoutePlanRequest&, size_t);
+    void SetRoutePath(const PreparedRoutePlanRequest&, const VisiLibity::Polyline&, uxas::messages::route::RoutePlan*);
+
+    /** \brief Everything that determines the visibility graph of a vehicle in
+     * an operating region: the applicable zones of the region (in region
+     * order) and the water zone of surface vehicles. Zones are compared by ID
+     * (a changed zone rebuilds the whole region), water zones by identity (a
+     * received water zone replaces the stored object). */
+    struct VisibilityGraphKey
+    {
+        std::vector<int64_t> m_keepOutZoneIds;
+        std::vector<int64_t> m_keepInZoneIds;
+        std::shared_ptr<afrl::impact::WaterZone> m_waterZone;
+
+        bool operator<(const VisibilityGraphKey& other) const
+        {
+            return (std::tie(m_keepOutZoneIds, m_keepInZoneIds, m_waterZone)
+                    < std::tie(other.m_keepOutZoneIds, other.m_keepInZoneIds, other.m_waterZone));
+        };
+    };
+
+    /** \brief Linearized zone boundary and the padding applied to it. */
+    struct ZonePolygon
+    {
+        VisiLibity::Polygon m_polygon;
+        double m_offset{0.0};
+        bool m_isValid{false};
+    };
+
+    /** \brief Environment and graph shared by all vehicles with the same key. */
+    struct SharedVisibilityGraph
+    {
+        std::shared_ptr<VisiLibity::Environment> m_environment;
+        std::shared_ptr<VisiLibity::Visibility_Graph> m_visibilityGraph;
+    };
+
+    /** \brief Linearized polygons of one visibility graph. Building the graph
+     * from them does not read service state, so graphs can be built in
+     * parallel. */
+    struct VisibilityGraphInput
+    {
+        std::vector<ZonePolygon> m_keepOutPolygons;
+        std::vector<ZonePolygon> m_keepInPolygons;
+        /** \brief bound the environment by the keep-out zones (region has no keep-in areas) */
+        bool m_isBoundedByKeepOutZones{false};
+        /** \brief graph the vehicles planned against before the zones changed
+         * (updated incrementally rather than rebuilt, if present) */
+        SharedVisibilityGraph m_previousGraph;
+    };
+
     void BuildVisibilityRegion(std::shared_ptr<afrl::cmasi::OperatingRegion>);
     void UpdateRegions(std::shared_ptr<avtas::lmcp::Object>);
-    void BuildVehicleSpecificRegion(std::shared_ptr<afrl::cmasi::OperatingRegion>, int64_t, afrl::cmasi::AbstractGeometry*);
+    void BuildVehicleSpecificRegion(std::shared_ptr<afrl::cmasi::OperatingRegion>, int64_t, std::shared_ptr<afrl::impact::WaterZone>);
+    VisibilityGraphKey GetVisibilityGraphKey(std::shared_ptr<afrl::cmasi::OperatingRegion>, int64_t, std::shared_ptr<afrl::impact::WaterZone>);
+    void BuildVisibilityGraphs(std::shared_ptr<afrl::cmasi::OperatingRegion>, const std::vector<VisibilityGraphKey>&, const std::vector<SharedVisibilityGraph>&,
+                               std::vector<SharedVisibilityGraph>&);
+    static SharedVisibilityGraph BuildVisibilityGraph(const VisibilityGraphInput&);
+    void SetVehicleVisibilityGraph(int64_t, int64_t, const SharedVisibilityGraph&);
+    bool LinearizeZone(afrl::cmasi::AbstractGeometry*, VisiLibity::Polygon&);
     bool LinearizeBoundary(afrl::cmasi::AbstractGeometry*, VisiLibity::Polygon&);
 
     // storage
@@ -153,6 +250,16 @@ private:
     // [operating region id], [vehicle id], <environment/graph>
     std::unordered_map<int64_t, std::unordered_map<int64_t, std::shared_ptr<VisiLibity::Environment> > > m_environments;
     std::unordered_map<int64_t, std::unordered_map<int64_t, std::shared_ptr<VisiLibity::Visibility_Graph> > > m_visgraphs;
+    // distinct environments/graphs of each region, shared by the vehicles above
+    // [operating region id], [key], <environment/graph>
+    std::unordered_map<int64_t, std::map<VisibilityGraphKey, SharedVisibilityGraph> > m_sharedVisibilityGraphs;
+
+    /*! \brief  number of route planning threads (1: plan on the service thread) */
+    uint32_t m_routePlanningThreadCount{1};
+    /*! \brief  route planning pool (only exists for more than one thread) */
+    std::unique_ptr<uxas::common::ThreadPool> m_routePlanningThreadPool;
+    /*! \brief  serializes responses sent from route planning threads */
+    std::mutex m_sendMutex;
 
 };
 
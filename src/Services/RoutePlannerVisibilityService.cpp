@@ -25,6 +25,7 @@
 
 #include "UnitConversions.h"
 #include "Constants/UxAS_String.h"
+#include "stdUniquePtr.h"
 
 #include "afrl/cmasi/KeepInZone.h"
 #include "afrl/cmasi/KeepOutZone.h"
@@ -58,6 +59,7 @@
 #define STRING_XML_IS_ROUTE_AGGREGATOR "isRoutAggregator"
 #define STRING_XML_OSM_FILE_NAME "OsmFileName"
 #define STRING_XML_MINIMUM_WAYPOINT_SEPARATION_M "MinimumWaypointSeparation_m"
+#define STRING_XML_ROUTE_PLANNING_THREAD_COUNT "RoutePlanningThreadCount"
 
 
 #define COUT_INFO_MSG(MESSAGE) std::cout << "<>RoutePlannerVisibility::" << MESSAGE << std::endl;std::cout.flush();
@@ -80,6 +82,11 @@ RoutePlannerVisibilityService::RoutePlannerVisibilityService()
 
 RoutePlannerVisibilityService::~RoutePlannerVisibilityService()
 {
+    // queued requests reference this service, so drain them before members are destroyed
+    if (m_routePlanningThreadPool)
+    {
+        m_routePlanningThreadPool->shutdown();
+    }
 };
 
 bool
@@ -136,6 +143,18 @@ RoutePlannerVisibilityService::configure(const pugi::xml_node& ndComponent)
     {
         m_minimumWaypointSeparation_m = ndComponent.attribute(STRING_XML_MINIMUM_WAYPOINT_SEPARATION_M).as_double();
     }
+    if (!ndComponent.attribute(STRING_XML_ROUTE_PLANNING_THREAD_COUNT).empty())
+    {
+        m_routePlanningThreadCount = ndComponent.attribute(STRING_XML_ROUTE_PLANNING_THREAD_COUNT).as_uint();
+        if (m_routePlanningThreadCount == 0)
+        {
+            m_routePlanningThreadCount = uxas::common::ThreadPool::getHardwareThreadCount();
+        }
+    }
+    if (m_routePlanningThreadCount > 1)
+    {
+        m_routePlanningThreadPool = uxas::stduxas::make_unique<uxas::common::ThreadPool>(m_routePlanningThreadCount);
+    }
 
     addSubscriptionAddress(afrl::cmasi::KeepOutZone::Subscription);
     addSubscriptionAddress(afrl::cmasi::KeepInZone::Subscription);
@@ -182,6 +201,17 @@ RoutePlannerVisibilityService::initialize()
     return (isSuccess);
 };
 
+bool
+RoutePlannerVisibilityService::terminate()
+{
+    // finishes (and responds to) all queued requests before returning
+    if (m_routePlanningThreadPool)
+    {
+        m_routePlanningThreadPool->shutdown();
+    }
+    return (true);
+};
+
 bool
 RoutePlannerVisibilityService::processReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage)
 //example: if (afrl::cmasi::isServiceStatus(receivedLmcpMessage->m_object.get()))
@@ -223,21 +253,45 @@ RoutePlannerVisibilityService::processReceivedLmcpMessage(std::unique_ptr<uxas::
                 (std::dynamic_pointer_cast<afrl::cmasi::AirVehicleConfiguration>(itEntityConfiguration->second) ||
                 std::dynamic_pointer_cast<afrl::vehicles::SurfaceVehicleConfiguration>(itEntityConfiguration->second)))
         {
-            auto routePlanResponse = std::make_shared<uxas::messages::route::RoutePlanResponse>();
-            if (bProcessRoutePlanRequest(request, routePlanResponse))
+            // always limited-cast route plan responses
+            std::string responseAddress = getNetworkClientUnicastAddress(
+                        receivedLmcpMessage->m_attributes->getSourceEntityId(),
+                        receivedLmcpMessage->m_attributes->getSourceServiceId());
+            auto preparedRequest = std::make_shared<s_PreparedRoutePlanRequest>();
+            if (!bPrepareRoutePlanRequest(request, *preparedRequest))
+            {
+               CERR_FILE_LINE_MSG("Error processing route plan request")
+            }
+            else if (m_routePlanningThreadPool)
             {
-                auto message = std::static_pointer_cast<avtas::lmcp::Object>(routePlanResponse);
-                // always limited-cast route plan responses
-                sendSharedLmcpObjectLimitedCastMessage(
-                        getNetworkClientUnicastAddress(
-                            receivedLmcpMessage->m_attributes->getSourceEntityId(),
-                            receivedLmcpMessage->m_attributes->getSourceServiceId()
-                        ),
-                        message);
+                // plan on the pool so that concurrent requests are planned in parallel
+                m_routePlanningThreadPool->post([this, preparedRequest, responseAddress]()
+                {
+                    auto routePlanResponse = std::make_shared<uxas::messages::route::RoutePlanResponse>();
+                    if (bPlanRoutes(*preparedRequest, routePlanResponse))
+                    {
+                        auto message = std::static_pointer_cast<avtas::lmcp::Object>(routePlanResponse);
+                        std::lock_guard<std::mutex> lock(m_sendMutex);
+                        sendSharedLmcpObjectLimitedCastMessage(responseAddress, message);
+                    }
+                    else
+                    {
+                       CERR_FILE_LINE_MSG("Error processing route plan request")
+                    }
+                });
             }
             else
             {
-               CERR_FILE_LINE_MSG("Error processing route plan request")
+                auto routePlanResponse = std::make_shared<uxas::messages::route::RoutePlanResponse>();
+                if (bPlanRoutes(*preparedRequest, routePlanResponse))
+                {
+                    auto message = std::static_pointer_cast<avtas::lmcp::Object>(routePlanResponse);
+                    sendSharedLmcpObjectLimitedCastMessage(responseAddress, message);
+                }
+                else
+                {
+                   CERR_FILE_LINE_MSG("Error processing route plan request")
+                }
             }
         }
         else
@@ -353,7 +407,17 @@ bool RoutePlannerVisibilityService::bProcessOperatingRegion(const std::shared_pt
         n_FrameworkLib::CVisibilityGraph::enError errAddPolygon = baseVisibilityGraph->errFinalizePolygons();
         if (errAddPolygon == n_FrameworkLib::CVisibilityGraph::errNoError)
         {
-            errAddPolygon = baseVisibilityGraph->errBuildVisibilityGraph();
+            // an update of the operating region (e.g., a pop-up keep out zone) reuses the visibility
+            // between the zones that did not change
+            auto itPreviousVisibilityGraph = m_operatingIdVsBaseVisibilityGraph.find(operatingRegion->getID());
+            if (itPreviousVisibilityGraph != m_operatingIdVsBaseVisibilityGraph.end() && itPreviousVisibilityGraph->second)
+            {
+                errAddPolygon = baseVisibilityGraph->errBuildVisibilityGraph(*itPreviousVisibilityGraph->second);
+            }
+            else
+            {
+                errAddPolygon = baseVisibilityGraph->errBuildVisibilityGraph();
+            }
             if (errAddPolygon == n_FrameworkLib::CVisibilityGraph::errNoError)
             {
                 errAddPolygon = baseVisibilityGraph->errInitializeGraphBase();
@@ -391,8 +455,8 @@ bool RoutePlannerVisibilityService::bProcessRouteRequest(const std::shared_ptr<u
     return (isSuccess);
 }
 
-bool RoutePlannerVisibilityService::bProcessRoutePlanRequest(const std::shared_ptr<uxas::messages::route::RoutePlanRequest>& routePlanRequest,
-        std::shared_ptr<uxas::messages::route::RoutePlanResponse>& routePlanResponse)
+bool RoutePlannerVisibilityService::bPrepareRoutePlanRequest(const std::shared_ptr<uxas::messages::route::RoutePlanRequest>& routePlanRequest,
+        s_PreparedRoutePlanRequest& preparedRequest)
 {
     bool isSuccess(true);
 
@@ -415,12 +479,12 @@ bool RoutePlannerVisibilityService::bProcessRoutePlanRequest(const std::shared_p
     }
     else
     {
-        routePlanResponse->setResponseID(routePlanRequest->getRequestID());
-        routePlanResponse->setAssociatedTaskID(routePlanRequest->getAssociatedTaskID());
-        routePlanResponse->setOperatingRegion(routePlanRequest->getOperatingRegion());
-        routePlanResponse->setVehicleID(routePlanRequest->getVehicleID());
+        preparedRequest.routePlanRequest = routePlanRequest;
+        preparedRequest.visibilityGraph = itOperatingVisibilityGraph->second;
+        preparedRequest.plannerParameters = itPlannerParameters->second;
 
-        // convert uav position and waypoint positions to lat,long
+        // convert uav position and waypoint positions to north/east (on the service
+        // thread, so the unit conversions are initialized before planning threads use them)
         for (auto itRequest = routePlanRequest->getRouteRequests().begin();
                 itRequest != routePlanRequest->getRouteRequests().end();
                 itRequest++)
@@ -437,37 +501,97 @@ bool RoutePlannerVisibilityService::bProcessRoutePlanRequest(const std::shared_p
                     (*itRequest)->getEndLocation()->getLongitude(), dNorth_m, dEast_m);
             pathInformation->posGetEnd() = n_FrameworkLib::CPosition(dNorth_m, dEast_m);
 
-            if (itOperatingVisibilityGraph->second->isFindPath(pathInformation))
-            {
-                auto routePlan = std::make_shared<uxas::messages::route::RoutePlan>();
-                routePlan->setRouteID((*itRequest)->getRouteID());
-                double routeCost_ms = static_cast<int64_t> (((itPlannerParameters->second->nominalSpeed_mps > 0.0) ?
-                        (pathInformation->iGetLength() / itPlannerParameters->second->nominalSpeed_mps) : (0.0))*1000.0);
-                routePlan->setRouteCost(routeCost_ms);
-                if (!routePlanRequest->getIsCostOnlyRequest())
-                {
-                    n_FrameworkLib::CTrajectoryParameters::enPathType_t enpathType = n_FrameworkLib::CTrajectoryParameters::pathTurnStraightTurn;
-                    if((!(*itRequest)->getUseEndHeading()) && (!(*itRequest)->getUseStartHeading()))
-                    {
-                        enpathType = n_FrameworkLib::CTrajectoryParameters::pathEuclidean;
-                    }
-                    
-                    isCalculateWaypoints(itOperatingVisibilityGraph->second, pathInformation, routePlanRequest->getVehicleID(),
-                            (*itRequest)->getStartHeading(), (*itRequest)->getEndHeading(),
-                            routePlan->getWaypoints(),enpathType);
-                }
-                routePlanResponse->getRouteResponses().push_back(routePlan->clone());
-            }
-            else
-            {
-                CERR_FILE_LINE_MSG("Error:: could not find route for RouteRequestId[" << (*itRequest)->getRouteID() << "].")
-                isSuccess = false;
-            }
+            preparedRequest.pathInformation.push_back(pathInformation);
         }
     } //if(operatingVisibilityGraph == m_operatingIdVsBaseVisibilityGraph.end())
     return (isSuccess);
 }
 
+bool RoutePlannerVisibilityService::bPlanRoutes(const s_PreparedRoutePlanRequest& preparedRequest,
+        std::shared_ptr<uxas::messages::route::RoutePlanResponse>& routePlanResponse)
+{
+    bool isSuccess(true);
+
+    const auto& routePlanRequest = preparedRequest.routePlanRequest;
+    routePlanResponse->setResponseID(routePlanRequest->getRequestID());
+    routePlanResponse->setAssociatedTaskID(routePlanRequest->getAssociatedTaskID());
+    routePlanResponse->setOperatingRegion(routePlanRequest->getOperatingRegion());
+    routePlanResponse->setVehicleID(routePlanRequest->getVehicleID());
+
+    // all routes are searched together, so each distinct start location takes a single
+    // pass over the graph (one row of a cost matrix) instead of one search per route
+    n_FrameworkLib::CVisibilityGraph::PARALLEL_FOR_t parallelFor;
+    if (m_routePlanningThreadPool)
+    {
+        parallelFor = [this](size_t count, const std::function<void(size_t)>& body)
+        {
+            m_routePlanningThreadPool->parallelFor(count, body);
+        };
+    }
+    std::vector<std::shared_ptr<n_FrameworkLib::CPathInformation>> pathInformation = preparedRequest.pathInformation;
+    bool isPathsFound = preparedRequest.visibilityGraph->isFindPaths(pathInformation, parallelFor);
+
+    // routes are stored by index so that the response keeps the request order
+    std::vector<std::shared_ptr<uxas::messages::route::RoutePlan>> routePlans(preparedRequest.pathInformation.size());
+    if (!isPathsFound)
+    {
+        CERR_FILE_LINE_MSG("Error:: could not find routes for RoutePlanRequestId[" << routePlanRequest->getRequestID() << "].")
+    }
+    else if (m_routePlanningThreadPool)
+    {
+        m_routePlanningThreadPool->parallelFor(routePlans.size(), [this, &preparedRequest, &routePlans](size_t routeIndex)
+        {
+            routePlans[routeIndex] = planRoute(preparedRequest, routeIndex);
+        });
+    }
+    else
+    {
+        for (size_t routeIndex = 0; routeIndex < routePlans.size(); routeIndex++)
+        {
+            routePlans[routeIndex] = planRoute(preparedRequest, routeIndex);
+        }
+    }
+
+    for (auto& routePlan : routePlans)
+    {
+        if (routePlan)
+        {
+            routePlanResponse->getRouteResponses().push_back(routePlan->clone());
+        }
+        else
+        {
+            isSuccess = false;
+        }
+    }
+    return (isSuccess);
+}
+
+std::shared_ptr<uxas::messages::route::RoutePlan> RoutePlannerVisibilityService::planRoute(const s_PreparedRoutePlanRequest& preparedRequest, const size_t& routeIndex)
+{
+    // builds the plan for a route whose path has been found (see bPlanRoutes)
+    auto routeRequest = preparedRequest.routePlanRequest->getRouteRequests().at(routeIndex);
+    const auto& pathInformation = preparedRequest.pathInformation.at(routeIndex);
+
+    auto routePlan = std::make_shared<uxas::messages::route::RoutePlan>();
+    routePlan->setRouteID(routeRequest->getRouteID());
+    double routeCost_ms = static_cast<int64_t> (((preparedRequest.plannerParameters->nominalSpeed_mps > 0.0) ?
+            (pathInformation->iGetLength() / preparedRequest.plannerParameters->nominalSpeed_mps) : (0.0))*1000.0);
+    routePlan->setRouteCost(routeCost_ms);
+    if (!preparedRequest.routePlanRequest->getIsCostOnlyRequest())
+    {
+        n_FrameworkLib::CTrajectoryParameters::enPathType_t enpathType = n_FrameworkLib::CTrajectoryParameters::pathTurnStraightTurn;
+        if((!routeRequest->getUseEndHeading()) && (!routeRequest->getUseStartHeading()))
+        {
+            enpathType = n_FrameworkLib::CTrajectoryParameters::pathEuclidean;
+        }
+
+        isCalculateWaypoints(preparedRequest.visibilityGraph, pathInformation, preparedRequest.plannerParameters->turnRadius_m,
+                routeRequest->getStartHeading(), routeRequest->getEndHeading(),
+                routePlan->getWaypoints(),enpathType);
+    }
+    return (routePlan);
+}
+
 bool RoutePlannerVisibilityService::bFindPointsForAbstractGeometry(afrl::cmasi::AbstractGeometry* pAbstractGeometry, n_FrameworkLib::V_POSITION_t & vposBoundaryPoints)
 {
     bool isSuccess(true);
@@ -556,23 +680,13 @@ bool RoutePlannerVisibilityService::bFindPointsForAbstractGeometry(afrl::cmasi::
 
 bool RoutePlannerVisibilityService::isCalculateWaypoints(const n_FrameworkLib::PTR_VISIBILITYGRAPH_t& visibilityGraph,
         const std::shared_ptr<n_FrameworkLib::CPathInformation>& pathInformation,
-        const int64_t& vehicleId, const double& startHeading_deg, const double& endHeading_deg,
+        const double& turnRadius_m, const double& startHeading_deg, const double& endHeading_deg,
         std::vector<afrl::cmasi::Waypoint*>& planWaypoints,
         const n_FrameworkLib::CTrajectoryParameters::enPathType_t& enpathType)
 {
     bool isSuccessful(true);
 
-    auto itPlannerParameters = m_idVsPlannerParameters.find(vehicleId);
-    if (itPlannerParameters != m_idVsPlannerParameters.end())
-    {
-        double turnRadius_m = itPlannerParameters->second->turnRadius_m;
-        isSuccessful = visibilityGraph->isGenerateWaypoints(pathInformation, startHeading_deg, endHeading_deg, turnRadius_m, enpathType, m_minimumWaypointSeparation_m, planWaypoints);
-    }
-    else
-    {
-        CERR_FILE_LINE_MSG("ERROR::isCalculateWaypoints:: planning parameters not found for Vehicle Id [" << vehicleId << "]!!!")
-        isSuccessful = false;
-    }
+    isSuccessful = visibilityGraph->isGenerateWaypoints(pathInformation, startHeading_deg, endHeading_deg, turnRadius_m, enpathType, m_minimumWaypointSeparation_m, planWaypoints);
 
     return (isSuccessful);
 }
@@ -31,7 +31,11 @@
 
 
 #include "ServiceBase.h"
+#include "UxAS_ThreadPool.h"
 
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace uxas
 {
@@ -56,6 +60,11 @@ namespace service
  *  - TurnRadiusOffset_m
  *  - OsmFileName
  *  - MinimumWaypointSeparation_m
+ *  - RoutePlanningThreadCount - number of threads used to plan routes
+ *    (default 1: plan on the service thread; 0: one thread per hardware
+ *    thread). With more than one thread, concurrent requests and the routes
+ *    of each request are planned in parallel against the read-only
+ *    visibility graph.
  *  - 
  *  - 
  * 
@@ -134,8 +143,8 @@ private:
     //bool
     //start() override;
 
-    //bool
-    //terminate() override;
+    bool
+    terminate() override;
 
     bool
     processReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage) override;
@@ -157,12 +166,10 @@ protected:
     bool bProcessZone(const std::shared_ptr<afrl::cmasi::AbstractZone>& abstractZone, const bool& isKeepIn);
     bool bProcessOperatingRegion(const std::shared_ptr<afrl::cmasi::OperatingRegion>& operatingRegion);
     bool bProcessRouteRequest(const std::shared_ptr<uxas::messages::route::RouteRequest>& routeRequest);
-    bool bProcessRoutePlanRequest(const std::shared_ptr<uxas::messages::route::RoutePlanRequest>& routePlanRequest,
-            std::shared_ptr<uxas::messages::route::RoutePlanResponse>& routePlanResponse);
     bool bFindPointsForAbstractGeometry(afrl::cmasi::AbstractGeometry* pAbstractGeometry, n_FrameworkLib::V_POSITION_t& vposBoundaryPoints);
     bool isCalculateWaypoints(const n_FrameworkLib::PTR_VISIBILITYGRAPH_t& visibilityGraph,
             const std::shared_ptr<n_FrameworkLib::CPathInformation>& pathInformation,
-            const int64_t& vehicleId, const double& startHeading_deg, const double& endHeading_deg,
+            const double& turnRadius_m, const double& startHeading_deg, const double& endHeading_deg,
             std::vector<afrl::cmasi::Waypoint*>& planWaypoints,const n_FrameworkLib::CTrajectoryParameters::enPathType_t& enpathType);
     void calculatePlannerParameters(const std::shared_ptr<afrl::cmasi::EntityConfiguration>& enityConfiguration);
 
@@ -174,6 +181,25 @@ public:
         double nominalSpeed_mps = {0};
     };
 
+protected:
+
+    /*! \brief  everything needed to plan the routes of one request, gathered on
+     * the service thread. Planning only reads this and the visibility graph,
+     * which is replaced (never modified) when the operating region changes. */
+    struct s_PreparedRoutePlanRequest
+    {
+        std::shared_ptr<uxas::messages::route::RoutePlanRequest> routePlanRequest;
+        n_FrameworkLib::PTR_VISIBILITYGRAPH_t visibilityGraph;
+        std::shared_ptr<s_PlannerParameters> plannerParameters;
+        std::vector<std::shared_ptr<n_FrameworkLib::CPathInformation>> pathInformation;
+    };
+
+    bool bPrepareRoutePlanRequest(const std::shared_ptr<uxas::messages::route::RoutePlanRequest>& routePlanRequest,
+            s_PreparedRoutePlanRequest& preparedRequest);
+    bool bPlanRoutes(const s_PreparedRoutePlanRequest& preparedRequest,
+            std::shared_ptr<uxas::messages::route::RoutePlanResponse>& routePlanResponse);
+    std::shared_ptr<uxas::messages::route::RoutePlan> planRoute(const s_PreparedRoutePlanRequest& preparedRequest, const size_t& routeIndex);
+
 
 protected:
 
@@ -202,6 +228,13 @@ protected:
 
     double m_minimumWaypointSeparation_m = 50; //TODO:: this need to be configurable
 
+    /*! \brief  number of route planning threads (1: plan on the service thread)*/
+    uint32_t m_routePlanningThreadCount{1};
+    /*! \brief  route planning pool (only exists for more than one thread)*/
+    std::unique_ptr<uxas::common::ThreadPool> m_routePlanningThreadPool;
+    /*! \brief  serializes responses sent from route planning threads*/
+    std::mutex m_sendMutex;
+
 private:
 
 
@@ -249,16 +249,21 @@ SendMessagesService::sendMessages()
             {
                 if (timeFromStart > (*itMessage)->m_messageSendTime_ms)
                 {
+                    if (!(*itMessage)->m_serializedLmcpObjectPayload.isValid())
+                    {
+                        (*itMessage)->m_serializedLmcpObjectPayload = uxas::communications::data::SerializedLmcpObject((*itMessage)->m_lmcpObjectPayload);
+                    }
+
                     if ((*itMessage)->m_messageAddress.empty())
                     {
                         UXAS_LOG_DEBUG_VERBOSE(s_typeName(), "::sendMessages BEFORE sending periodic broadcast");
-                        sendSharedLmcpObjectBroadcastMessage((*itMessage)->m_lmcpObjectPayload);
+                        sendSharedSerializedLmcpObjectBroadcastMessage((*itMessage)->m_serializedLmcpObjectPayload);
                         UXAS_LOG_DEBUG_VERBOSE(s_typeName(), "::sendMessages AFTER sending periodic broadcast");
                     }
                     else
                     {
                         UXAS_LOG_DEBUG_VERBOSE(s_typeName(), "::sendMessages BEFORE sending periodic limited-cast");
-                        sendSharedLmcpObjectLimitedCastMessage((*itMessage)->m_messageAddress, (*itMessage)->m_lmcpObjectPayload);
+                        sendSharedSerializedLmcpObjectLimitedCastMessage((*itMessage)->m_messageAddress, (*itMessage)->m_serializedLmcpObjectPayload);
                         UXAS_LOG_DEBUG_VERBOSE(s_typeName(), "::sendMessages AFTER sending periodic limited-cast");
                     }
                     (*itMessage)->m_messageSendTime_ms += (*itMessage)->m_messageSendPeriod_ms;
@@ -108,6 +108,8 @@ private:
         m_numberTimesToSend(UINT32_MAX), m_numberTimesSent(0) { };
 
         std::shared_ptr<avtas::lmcp::Object> m_lmcpObjectPayload;
+        /** \brief  serialized once on first periodic send and re-used for every later send */
+        uxas::communications::data::SerializedLmcpObject m_serializedLmcpObjectPayload;
         std::string m_messageAddress;
         bool m_isUseSendTime;
         uint32_t m_messageSendTime_ms;
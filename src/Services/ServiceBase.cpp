@@ -14,6 +14,8 @@
 
 #include "FileSystemUtilities.h"
 
+#include "uxas/messages/uxnative/KillService.h"
+
 #include <sstream>
 
 namespace uxas
@@ -35,6 +37,68 @@ namespace service
     };
 
 
+void
+ServiceBase::setIsLmcpObjectHandlerOnly(bool isLmcpObjectHandlerOnly)
+{
+    m_isLmcpObjectHandlerOnly = isLmcpObjectHandlerOnly;
+    if (!m_isLmcpObjectHandlerOnly)
+    {
+        setLmcpTypeFilter(uxas::communications::LmcpObjectMessageReceiverPipe::LmcpTypeFilter());
+        return;
+    }
+
+    // the base class processes KillService messages addressed to this service
+    uxas::messages::uxnative::KillService killService;
+    LmcpTypeKey killServiceKey{killService.getSeriesNameAsLong(), killService.getLmcpType()};
+    setLmcpTypeFilter([this, killServiceKey](int64_t seriesId, uint32_t typeId, const std::string& descriptor)
+    {
+        return ((seriesId == killServiceKey.m_seriesId && typeId == killServiceKey.m_typeId)
+                || static_cast<bool>(getLmcpObjectHandler(seriesId, typeId, descriptor)));
+    });
+};
+
+bool
+ServiceBase::dispatchReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage)
+{
+    auto& object = receivedLmcpMessage->m_object;
+    if (object && !(m_lmcpObjectHandlers.empty() && m_lmcpObjectHandlersByTypeName.empty()))
+    {
+        // the full type name is only needed to resolve named registrations
+        const LmcpObjectHandler& handler = getLmcpObjectHandler(object->getSeriesNameAsLong(), object->getLmcpType(),
+                                                                receivedLmcpMessage->m_attributes->getDescriptor());
+        if (handler)
+        {
+            return (handler(object));
+        }
+    }
+    if (m_isLmcpObjectHandlerOnly)
+    {
+        // not filtered out on receipt (e.g., hosted service)
+        return (false);
+    }
+    return (processReceivedLmcpMessage(std::move(receivedLmcpMessage)));
+};
+
+const ServiceBase::LmcpObjectHandler&
+ServiceBase::getLmcpObjectHandler(int64_t seriesId, uint32_t typeId, const std::string& fullTypeName)
+{
+    LmcpTypeKey key{seriesId, typeId};
+    auto itHandler = m_lmcpObjectHandlers.find(key);
+    if (itHandler != m_lmcpObjectHandlers.end())
+    {
+        return (itHandler->second);
+    }
+
+    // first receipt of this type: resolve a named registration or cache "no handler"
+    auto itNamedHandler = m_lmcpObjectHandlersByTypeName.find(fullTypeName);
+    LmcpObjectHandler& handler = m_lmcpObjectHandlers[key];
+    if (itNamedHandler != m_lmcpObjectHandlersByTypeName.end())
+    {
+        handler = itNamedHandler->second;
+    }
+    return (handler);
+};
+
 bool
 ServiceBase::configureService(const std::string& parentOfWorkDirectory, const std::string& serviceXml)
 {
@@ -14,6 +14,11 @@
 
 #include "UxAS_Log.h"
 
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace uxas
 {
 namespace service
@@ -25,6 +30,16 @@ namespace service
  * Service class constructors are registered in the <B><i>ServiceBase</i></B> 
  * creation registry.
  * 
+ * \par Typed message dispatch:
+ * Services can register a typed handler per <b>LMCP</b> type (keyed by series 
+ * ID and type ID) with <B><i>addLmcpObjectHandler</i></B>. Received messages 
+ * of a registered type are passed to their handler with a single table 
+ * lookup; all others are passed to <B><i>processReceivedLmcpMessage</i></B>, 
+ * unless the service sets <B><i>setIsLmcpObjectHandlerOnly</i></B>, in which 
+ * case they are discarded before deserialization. Like 
+ * <B><i>processReceivedLmcpMessage</i></B>, handlers return true to 
+ * terminate the service.
+ * 
  * @n
  */
 class ServiceBase : public uxas::communications::LmcpObjectNetworkClientBase
@@ -110,6 +125,107 @@ protected:
         
     uxas::communications::LmcpObjectNetworkClientBase::ReceiveProcessingType m_receiveProcessingType{uxas::communications::LmcpObjectNetworkClientBase::ReceiveProcessingType::LMCP};
 
+    // <editor-fold defaultstate="collapsed" desc="Typed Message Dispatch">
+    /** \brief Handler of received <b>LMCP</b> objects of one type; returns 
+     * true to terminate the service.  */
+    typedef std::function<bool(const std::shared_ptr<avtas::lmcp::Object>&)> LmcpObjectHandler;
+
+    /** \brief The <B><i>addLmcpObjectHandler</i></B> method registers a handler 
+     * for received objects of type <B><i>T</i></B> (exact type; register 
+     * descendants separately). Handlers are registered during configuration 
+     * or initialization and are invoked on the receiving thread. Subscribing 
+     * to the type remains the responsibility of the service.
+     * 
+     * @param handler callable accepting a <B><i>std::shared_ptr<T></i></B> 
+     * (or a pointer to a base of <B><i>T</i></B>), returning true to 
+     * terminate the service
+     */
+    template <typename T, typename Handler>
+    void
+    addLmcpObjectHandler(Handler handler)
+    {
+        T prototype;
+        m_lmcpObjectHandlers[LmcpTypeKey{prototype.getSeriesNameAsLong(), prototype.getLmcpType()}]
+                = [handler](const std::shared_ptr<avtas::lmcp::Object>& object) { return (handler(std::static_pointer_cast<T>(object))); };
+    };
+
+    /** \brief The <B><i>addLmcpObjectHandler</i></B> method registers a handler 
+     * for received objects of the named descendant types of <B><i>T</i></B> 
+     * (e.g., <B><i>afrl::cmasi::EntityStateDescendants()</i></B>). The series 
+     * and type IDs of named types are resolved on first receipt.
+     * 
+     * @param descendantTypeNames full <b>LMCP</b> type names of descendants of <B><i>T</i></B>
+     * @param handler callable accepting a <B><i>std::shared_ptr<T></i></B>, 
+     * returning true to terminate the service
+     */
+    template <typename T, typename Handler>
+    void
+    addLmcpObjectHandler(const std::vector<std::string>& descendantTypeNames, Handler handler)
+    {
+        LmcpObjectHandler objectHandler = [handler](const std::shared_ptr<avtas::lmcp::Object>& object) { return (handler(std::static_pointer_cast<T>(object))); };
+        for (auto& typeName : descendantTypeNames)
+        {
+            m_lmcpObjectHandlersByTypeName[typeName] = objectHandler;
+        }
+        // forget resolved "no handler" entries
+        for (auto itHandler = m_lmcpObjectHandlers.begin(); itHandler != m_lmcpObjectHandlers.end();)
+        {
+            itHandler = itHandler->second ? std::next(itHandler) : m_lmcpObjectHandlers.erase(itHandler);
+        }
+    };
+
+    /** \brief The <B><i>setIsLmcpObjectHandlerOnly</i></B> method, when set, 
+     * discards received messages without a registered handler before they 
+     * are deserialized (instead of passing them to 
+     * <B><i>processReceivedLmcpMessage</i></B>). Invoke during configuration.
+     * 
+     * @param isLmcpObjectHandlerOnly true if only handled types are processed
+     */
+    void
+    setIsLmcpObjectHandlerOnly(bool isLmcpObjectHandlerOnly);
+
+    /** \brief Routes a received message to its registered handler, or to 
+     * <B><i>processReceivedLmcpMessage</i></B> if the type has no handler.
+     * 
+     * @return true if the handler (or processReceivedLmcpMessage) requests termination
+     */
+    bool
+    dispatchReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage) override;
+
+private:
+
+    struct LmcpTypeKey
+    {
+        int64_t m_seriesId;
+        uint32_t m_typeId;
+
+        bool
+        operator==(const LmcpTypeKey& other) const { return (m_seriesId == other.m_seriesId && m_typeId == other.m_typeId); };
+    };
+
+    struct LmcpTypeKeyHash
+    {
+        size_t
+        operator()(const LmcpTypeKey& key) const
+        {
+            return (std::hash<int64_t>()(key.m_seriesId) ^ (std::hash<uint32_t>()(key.m_typeId) * 0x9E3779B97F4A7C15ull));
+        };
+    };
+
+    /** \brief Handler of the type; resolves (and caches) named registrations 
+     * on first use. Returns an empty handler if the type has none. */
+    const LmcpObjectHandler&
+    getLmcpObjectHandler(int64_t seriesId, uint32_t typeId, const std::string& fullTypeName);
+
+    /** \brief handlers by series and type ID; empty handlers cache "no handler"  */
+    std::unordered_map<LmcpTypeKey, LmcpObjectHandler, LmcpTypeKeyHash> m_lmcpObjectHandlers;
+
+    /** \brief handlers registered by type name (not yet resolved to IDs)  */
+    std::unordered_map<std::string, LmcpObjectHandler> m_lmcpObjectHandlersByTypeName;
+
+    bool m_isLmcpObjectHandlerOnly{false};
+    // </editor-fold>
+
     // <editor-fold defaultstate="collapsed" desc="Static Service Registry">    
 public:
 
@@ -12,6 +12,7 @@
 #include "afrl/cmasi/AirVehicleConfiguration.h"
 #include "afrl/cmasi/AirVehicleConfigurationDescendants.h"
 #include "afrl/cmasi/AirVehicleState.h"
+#include "afrl/cmasi/AirVehicleStateDescendants.h"
 #include "afrl/cmasi/AutomationResponse.h"
 #include "afrl/cmasi/FlightDirectorAction.h"
 #include "afrl/cmasi/Location3D.h"
@@ -280,307 +281,331 @@ bool SteeringService::configure(const pugi::xml_node& ndComponent)
     addSubscriptionAddress(uxas::messages::task::UniqueAutomationRequest::Subscription);
     addSubscriptionAddress(uxas::messages::task::UniqueAutomationResponse::Subscription);
 
+    // typed dispatch; messages of other types are discarded before deserialization
+    addLmcpObjectHandler<afrl::cmasi::AirVehicleConfiguration>(std::bind(&SteeringService::onAirVehicleConfiguration, this, std::placeholders::_1));
+    addLmcpObjectHandler<afrl::cmasi::AirVehicleConfiguration>(childconfigs, std::bind(&SteeringService::onAirVehicleConfiguration, this, std::placeholders::_1));
+    addLmcpObjectHandler<afrl::cmasi::AirVehicleState>(std::bind(&SteeringService::onAirVehicleState, this, std::placeholders::_1));
+    addLmcpObjectHandler<afrl::cmasi::AirVehicleState>(afrl::cmasi::AirVehicleStateDescendants(), std::bind(&SteeringService::onAirVehicleState, this, std::placeholders::_1));
+    addLmcpObjectHandler<afrl::cmasi::AutomationResponse>(std::bind(&SteeringService::onAutomationResponse, this, std::placeholders::_1));
+    addLmcpObjectHandler<afrl::cmasi::MissionCommand>(std::bind(&SteeringService::onMissionCommand, this, std::placeholders::_1));
+    addLmcpObjectHandler<uxas::messages::uxnative::SpeedOverrideAction>(std::bind(&SteeringService::onSpeedOverrideAction, this, std::placeholders::_1));
+    addLmcpObjectHandler<afrl::cmasi::VehicleActionCommand>(std::bind(&SteeringService::onVehicleActionCommand, this, std::placeholders::_1));
+    addLmcpObjectHandler<uxas::messages::task::UniqueAutomationRequest>(std::bind(&SteeringService::onUniqueAutomationRequest, this, std::placeholders::_1));
+    addLmcpObjectHandler<uxas::messages::task::UniqueAutomationResponse>(std::bind(&SteeringService::onUniqueAutomationResponse, this, std::placeholders::_1));
+    setIsLmcpObjectHandlerOnly(true);
+
     return (true);
 }
 
-bool SteeringService::processReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage)
+bool SteeringService::onAirVehicleConfiguration(const std::shared_ptr<afrl::cmasi::AirVehicleConfiguration>& avconfig)
 {
-    auto avconfig = std::dynamic_pointer_cast<afrl::cmasi::AirVehicleConfiguration>(receivedLmcpMessage->m_object);
-    auto pState = std::dynamic_pointer_cast<afrl::cmasi::AirVehicleState>(receivedLmcpMessage->m_object);
-    if(avconfig && avconfig->getID() == m_vehicleID)
+    if (avconfig->getID() != m_vehicleID)
     {
-        // update loiter radius and lead-ahead distance based on configuration
-        double g = n_Const::c_Convert::dGravity_mps2();
-        double V = avconfig->getNominalSpeed();
-        double phi = fabs(avconfig->getNominalFlightProfile()->getMaxBankAngle());
-        if(phi < 1.0) phi = 1.0; // bounded away from 0
-        double Rmin = V*V/g/tan(phi*n_Const::c_Convert::dDegreesToRadians());
-        m_loiterRadius_m = 1.2*Rmin; // 20% bigger than min-turn radius
-        m_leadAheadDistance_m = 3.0*m_loiterRadius_m;
-        
-        if(m_acceptanceTimeToArrive_ms > 0)
-        {
-            m_acceptanceDistance = m_acceptanceTimeToArrive_ms/1000.0*V;
-        }
+        return (false);
     }
-    else if (uxas::messages::task::isUniqueAutomationRequest(receivedLmcpMessage->m_object.get()))
+
+    // update loiter radius and lead-ahead distance based on configuration
+    double g = n_Const::c_Convert::dGravity_mps2();
+    double V = avconfig->getNominalSpeed();
+    double phi = fabs(avconfig->getNominalFlightProfile()->getMaxBankAngle());
+    if(phi < 1.0) phi = 1.0; // bounded away from 0
+    double Rmin = V*V/g/tan(phi*n_Const::c_Convert::dDegreesToRadians());
+    m_loiterRadius_m = 1.2*Rmin; // 20% bigger than min-turn radius
+    m_leadAheadDistance_m = 3.0*m_loiterRadius_m;
+    
+    if(m_acceptanceTimeToArrive_ms > 0)
     {
-        const auto req = std::static_pointer_cast<uxas::messages::task::UniqueAutomationRequest>(receivedLmcpMessage->m_object);
-        if(!req->getSandBoxRequest() && req->getOriginalRequest())
-        {
-            m_requestToRegionMap[req->getRequestID()] = req->getOriginalRequest()->getOperatingRegion();
-        }
-        else
-        {
-            m_requestToRegionMap.erase(req->getRequestID());
-        }
+        m_acceptanceDistance = m_acceptanceTimeToArrive_ms/1000.0*V;
     }
-    else if (uxas::messages::task::isUniqueAutomationResponse(receivedLmcpMessage->m_object.get()))
-    {
-        const auto resp = std::static_pointer_cast<uxas::messages::task::UniqueAutomationResponse>(receivedLmcpMessage->m_object);
-        if(resp->getOriginalResponse())
-        {
-            const std::vector<afrl::cmasi::MissionCommand*> missionCommands = resp->getOriginalResponse()->getMissionCommandList();
-
-            const auto it_mission = std::find_if(missionCommands.cbegin(), missionCommands.cend(),
-                [&](const afrl::cmasi::MissionCommand* pMission){ return pMission->getVehicleID() == m_vehicleID; } );
+    return (false);
+}
 
-            const auto regionid = m_requestToRegionMap.find(resp->getResponseID());
-            
-            // if the vehicle is a participant in this request
-            if (it_mission != missionCommands.cend())
-            {
-                m_operatingRegion = m_operatingRegionDefault;
-                if(!m_overrideRegion && regionid != m_requestToRegionMap.cend())
-                {
-                    m_operatingRegion = regionid->second;
-                }
-            }
-            
-            // clear out map
-            if(regionid != m_requestToRegionMap.cend())
-            {
-                m_requestToRegionMap.erase(regionid->first);
-            }
-        }
+bool SteeringService::onUniqueAutomationRequest(const std::shared_ptr<uxas::messages::task::UniqueAutomationRequest>& req)
+{
+    if(!req->getSandBoxRequest() && req->getOriginalRequest())
+    {
+        m_requestToRegionMap[req->getRequestID()] = req->getOriginalRequest()->getOperatingRegion();
+    }
+    else
+    {
+        m_requestToRegionMap.erase(req->getRequestID());
     }
-    else if (afrl::cmasi::isAutomationResponse(receivedLmcpMessage->m_object.get()))
+    return (false);
+}
+
+bool SteeringService::onUniqueAutomationResponse(const std::shared_ptr<uxas::messages::task::UniqueAutomationResponse>& resp)
+{
+    if(resp->getOriginalResponse())
     {
-        const auto pResponse = std::static_pointer_cast<afrl::cmasi::AutomationResponse>(receivedLmcpMessage->m_object);
-        const std::vector<afrl::cmasi::MissionCommand*> missionCommands = pResponse->getMissionCommandList();
+        const std::vector<afrl::cmasi::MissionCommand*> missionCommands = resp->getOriginalResponse()->getMissionCommandList();
 
         const auto it_mission = std::find_if(missionCommands.cbegin(), missionCommands.cend(),
             [&](const afrl::cmasi::MissionCommand* pMission){ return pMission->getVehicleID() == m_vehicleID; } );
 
+        const auto regionid = m_requestToRegionMap.find(resp->getResponseID());
+        
+        // if the vehicle is a participant in this request
         if (it_mission != missionCommands.cend())
         {
-            m_isHeadingControlledByTask = false;
-            m_isSpeedOverridden = false;
-            reset(*it_mission);
+            m_operatingRegion = m_operatingRegionDefault;
+            if(!m_overrideRegion && regionid != m_requestToRegionMap.cend())
+            {
+                m_operatingRegion = regionid->second;
+            }
+        }
+        
+        // clear out map
+        if(regionid != m_requestToRegionMap.cend())
+        {
+            m_requestToRegionMap.erase(regionid->first);
         }
     }
-    else if (afrl::cmasi::isMissionCommand(receivedLmcpMessage->m_object.get()))
+    return (false);
+}
+
+bool SteeringService::onAutomationResponse(const std::shared_ptr<afrl::cmasi::AutomationResponse>& pResponse)
+{
+    const std::vector<afrl::cmasi::MissionCommand*> missionCommands = pResponse->getMissionCommandList();
+
+    const auto it_mission = std::find_if(missionCommands.cbegin(), missionCommands.cend(),
+        [&](const afrl::cmasi::MissionCommand* pMission){ return pMission->getVehicleID() == m_vehicleID; } );
+
+    if (it_mission != missionCommands.cend())
     {
-        const auto pMission = std::static_pointer_cast<afrl::cmasi::MissionCommand>(receivedLmcpMessage->m_object);
+        m_isHeadingControlledByTask = false;
+        m_isSpeedOverridden = false;
+        reset(*it_mission);
+    }
+    return (false);
+}
 
-        if (pMission->getVehicleID() == m_vehicleID)
-        {
-            m_isHeadingControlledByTask = false;
-            m_isSpeedOverridden = false;
-            reset(pMission.get());
-        }
+bool SteeringService::onMissionCommand(const std::shared_ptr<afrl::cmasi::MissionCommand>& pMission)
+{
+    if (pMission->getVehicleID() == m_vehicleID)
+    {
+        m_isHeadingControlledByTask = false;
+        m_isSpeedOverridden = false;
+        reset(pMission.get());
     }
-    else if (uxas::messages::uxnative::isSpeedOverrideAction(receivedLmcpMessage->m_object.get()))
+    return (false);
+}
+
+bool SteeringService::onSpeedOverrideAction(const std::shared_ptr<uxas::messages::uxnative::SpeedOverrideAction>& speed_override)
+{
+    if(speed_override->getVehicleID() == m_vehicleID)
     {
-        auto speed_override = std::static_pointer_cast<uxas::messages::uxnative::SpeedOverrideAction>(receivedLmcpMessage->m_object);
-        if(speed_override->getVehicleID() == m_vehicleID)
-        {
-            m_isSpeedOverridden = true;
-            m_overrideSpeed = speed_override->getSpeed();
-        }
+        m_isSpeedOverridden = true;
+        m_overrideSpeed = speed_override->getSpeed();
     }
-    else if (afrl::cmasi::isVehicleActionCommand(receivedLmcpMessage->m_object.get()))
+    return (false);
+}
+
+bool SteeringService::onVehicleActionCommand(const std::shared_ptr<afrl::cmasi::VehicleActionCommand>& vehicleActionCommand)
+{
+    if(vehicleActionCommand->getVehicleID() == m_vehicleID)
     {
-        auto vehicleActionCommand = std::static_pointer_cast<afrl::cmasi::VehicleActionCommand>(receivedLmcpMessage->m_object);
-        if(vehicleActionCommand->getVehicleID() == m_vehicleID)
+        for(auto action : vehicleActionCommand->getVehicleActionList())
         {
-            for(auto action : vehicleActionCommand->getVehicleActionList())
+            auto hsa_action = dynamic_cast<afrl::cmasi::FlightDirectorAction*>(action);
+            if(hsa_action)
             {
-                auto hsa_action = dynamic_cast<afrl::cmasi::FlightDirectorAction*>(action);
-                if(hsa_action)
-                {
-                    m_isHeadingControlledByTask = true;
-                }
+                m_isHeadingControlledByTask = true;
             }
         }
     }
-    else if (pState && pState->getID() == m_vehicleID) // aliased version of AirVehicleState
-    {   
-        afrl::cmasi::Waypoint* pCurrentWp = getWaypoint(m_pMissionCmd, m_currentWpID);
+    return (false);
+}
 
-        if (pCurrentWp != nullptr)
-        {
-            const afrl::cmasi::Location3D* pLocation = pState->getLocation();
-            uxas::common::utilities::FlatEarth flatEarth;
-
-            // TODO: don't need to calculate at linearization point and can remove identity operations from subsequent calculations
-            VisiLibity::Point position_m = convertLocation3DToNorthEast_m(pLocation, flatEarth);
-            VisiLibity::Point current_m = getNorthEast_m(pCurrentWp, flatEarth);
-            VisiLibity::Point previous_m = position_m;
-            if (m_previousLocation)
-                previous_m = convertLocation3DToNorthEast_m(m_previousLocation.get(), flatEarth);
-
-            int64_t nextWpID = pCurrentWp->getNextWaypoint();
-            afrl::cmasi::Waypoint* pNextWp = getWaypoint(m_pMissionCmd, nextWpID);
-    
-            // waypoint acceptance check
-            std::unordered_set<int64_t> acceptedWaypoints;
-            while (!m_isLastWaypoint &&
-                   ((!isOrbitType(pCurrentWp) && (CheckLineAcceptance(position_m, previous_m, current_m) || withinDistance(current_m, previous_m, DISTANCE_TRESHOLD_M) || CheckProximity(position_m, current_m, pCurrentWp))) ||
-                    (isOrbitType(pCurrentWp) && CheckOrbitAcceptance(pCurrentWp, m_currentStartTimestamp_ms))))
-            {
-                UXAS_LOG_DEBUGGING(s_typeName(), "::processReceivedLmcpMessage - Vehicle Id [", m_vehicleID, "] accepted Waypoint ", m_currentWpID);
-
-                // don't allow persisent cycling through loop of waypoints that are clustered together
-                // if the newly accepted waypoint has already been accepted during this check, then
-                // a cycle has been detected and there's nothing more to be accomplished
-                if (acceptedWaypoints.find(m_currentWpID) != acceptedWaypoints.end())
-                {
-                    m_isLastWaypoint = true;
-                    break;
-                }
-                acceptedWaypoints.insert(m_currentWpID);
-
-                m_previousLocation.reset(pCurrentWp->clone());
-                previous_m = current_m;
-
-                if ((pNextWp != nullptr) && (nextWpID != m_currentWpID))
-                {
-                    m_currentWpID = nextWpID;
-                    pCurrentWp = pNextWp;
-                    m_currentStartTimestamp_ms = uxas::common::Time::getInstance().getUtcTimeSinceEpoch_ms();
-
-                    current_m = getNorthEast_m(pCurrentWp, flatEarth);
-
-                    nextWpID = pCurrentWp->getNextWaypoint();
-                    pNextWp = getWaypoint(m_pMissionCmd, nextWpID);
-                }
-                else
-                {
-                    m_isLastWaypoint = true;
-                }
-            }
+bool SteeringService::onAirVehicleState(const std::shared_ptr<afrl::cmasi::AirVehicleState>& pState)
+{
+    if (pState->getID() != m_vehicleID)
+    {
+        return (false);
+    }
 
-            // const double course_rad = n_Const::c_Convert::toRadians(static_cast<double>(pState->getCourse()));
-            // const double groundSpeed_mps = static_cast<double>(pState->getGroundspeed());
+    afrl::cmasi::Waypoint* pCurrentWp = getWaypoint(m_pMissionCmd, m_currentWpID);
 
-            double desiredHeading_deg;
-            float speed_mps;
-            afrl::cmasi::SpeedType::SpeedType speedType;
+    if (pCurrentWp != nullptr)
+    {
+        const afrl::cmasi::Location3D* pLocation = pState->getLocation();
+        uxas::common::utilities::FlatEarth flatEarth;
+
+        // TODO: don't need to calculate at linearization point and can remove identity operations from subsequent calculations
+        VisiLibity::Point position_m = convertLocation3DToNorthEast_m(pLocation, flatEarth);
+        VisiLibity::Point current_m = getNorthEast_m(pCurrentWp, flatEarth);
+        VisiLibity::Point previous_m = position_m;
+        if (m_previousLocation)
+            previous_m = convertLocation3DToNorthEast_m(m_previousLocation.get(), flatEarth);
+
+        int64_t nextWpID = pCurrentWp->getNextWaypoint();
+        afrl::cmasi::Waypoint* pNextWp = getWaypoint(m_pMissionCmd, nextWpID);
+
+        // waypoint acceptance check
+        std::unordered_set<int64_t> acceptedWaypoints;
+        while (!m_isLastWaypoint &&
+               ((!isOrbitType(pCurrentWp) && (CheckLineAcceptance(position_m, previous_m, current_m) || withinDistance(current_m, previous_m, DISTANCE_TRESHOLD_M) || CheckProximity(position_m, current_m, pCurrentWp))) ||
+                (isOrbitType(pCurrentWp) && CheckOrbitAcceptance(pCurrentWp, m_currentStartTimestamp_ms))))
+        {
+            UXAS_LOG_DEBUGGING(s_typeName(), "::processReceivedLmcpMessage - Vehicle Id [", m_vehicleID, "] accepted Waypoint ", m_currentWpID);
 
-            if (isOrbitType(pCurrentWp))
+            // don't allow persisent cycling through loop of waypoints that are clustered together
+            // if the newly accepted waypoint has already been accepted during this check, then
+            // a cycle has been detected and there's nothing more to be accomplished
+            if (acceptedWaypoints.find(m_currentWpID) != acceptedWaypoints.end())
             {
-                afrl::cmasi::LoiterAction* pLoiterAction = getAssociatedLoiter(pCurrentWp);
-                assert(pLoiterAction != nullptr);
-
-                const VisiLibity::Point orbitRelativePosition_m = position_m - current_m;
-                const double gamma_rad = atan2(orbitRelativePosition_m.y(), orbitRelativePosition_m.x()); // angular position of uav
-
-                const double d_m = mag(orbitRelativePosition_m); // radial distance of uav
-
-                const double r_m = pLoiterAction->getRadius();
-                // const double beta = m_kOrbit / (r_m * (1 + pow(m_kOrbit * (d_m - r_m) / r_m, 2.0)));
-
-                double desiredCourse_rad;
-                // const double commandedCourse_deg;
-
-                if (pLoiterAction->getDirection() == afrl::cmasi::LoiterDirection::Clockwise)
-                {
-                    desiredCourse_rad = gamma_rad + n_Const::c_Convert::dPiO2() + atan(m_kOrbit * (d_m - r_m) / r_m); // Nelson et al., Eq. 17 in clockwise
-                }
-                else // CounterClockwise
-                {
-                    // TODO: handle VehicleDefault, for now treating as CounterClockwise
-                    desiredCourse_rad = gamma_rad - n_Const::c_Convert::dPiO2() - atan(m_kOrbit * (d_m - r_m) / r_m); // Nelson et al., Eq. 17
-
-                    // TODO: discretized version of Eq. 23, for now using Eq. 17 and assuming autopilot can achieve
-                    // commandedCourse_deg = n_Const::c_Convert::toDegrees( course_rad
-                    //     + (groundspeed_mps * sin(course_rad - gamma_rad) / (m_alpha * d_m))
-                    //     - (beta * groundspeed_mps * cos(course_rad - gamma_rad) / m_alpha)
-                    //     - (m_kappaOrbit * sat((course_rad - desiredCourse_rad) / m_epsilonOrbit) / m_alpha)); // Nelson et al., Eq. 23
-                }
-
-                desiredHeading_deg = n_Const::c_Convert::dNormalizeAngleDeg(n_Const::c_Convert::toDegrees(desiredCourse_rad));
-                speed_mps = pLoiterAction->getAirspeed();
-                speedType = afrl::cmasi::SpeedType::Airspeed;
+                m_isLastWaypoint = true;
+                break;
             }
-            else // line type
+            acceptedWaypoints.insert(m_currentWpID);
+
+            m_previousLocation.reset(pCurrentWp->clone());
+            previous_m = current_m;
+
+            if ((pNextWp != nullptr) && (nextWpID != m_currentWpID))
             {
-                // handle last waypoint (self-looping or invalid next waypoint) by always considering self on path
-                if (m_isLastWaypoint)
-                {
-                    previous_m = position_m;
-                }
-
-                const VisiLibity::Point path_m = current_m - previous_m;
-                const double pathAngle_rad = atan2(path_m.y(), path_m.x());
-                // const double pathRelativeCourse_rad = n_Const::c_Convert::dNormalizeAngleRad(course_rad - pathAngle_rad);
-
-                // path's normal is in clockwise direction (matches local frame's handedness)
-                // NOTE: rotation sign opposite as our point is in NE frame (XY)
-                const VisiLibity::Point pathNormal_m = VisiLibity::Point::rotate(VisiLibity::Point::normalize(path_m), n_Const::c_Convert::dPiO2());
-
-                // NOTE: positive distance corresponds to normal's side (clockwise)
-                const double y_m = dot(pathNormal_m, position_m - previous_m);
-                const double desiredCourse_rad = -2.0 * m_courseInf_rad / n_Const::c_Convert::dPi() * atan(m_kLine * y_m); // Nelson et al., Eq. 8
-
-                // TODO: discretized version of Eq. 12, for now using Eq. 8 and assuming autopilot can achieve
-                // const double commandedCourse_deg = n_Const::c_Convert::toDegrees( pathRelativeCourse_rad
-                //     - ((m_courseInf_rad * 2.0 * m_kLine * groundSpeed_mps * sin(pathRelativeCourse_rad)) / (m_alpha * n_Const::c_Convert::dPi() * (1.0 + pow(m_kLine * y_m, 2.0))))
-                //     - (m_kappaLine * sat((pathRelativeCourse_rad - desiredCourse_rad) / m_epsilonLine) / m_alpha) ); // Nelson et al., Eq. 12
-
-                // Calculations are relative to path so need to add back in to commanded
-                desiredHeading_deg = n_Const::c_Convert::dNormalizeAngleDeg(n_Const::c_Convert::toDegrees(desiredCourse_rad + pathAngle_rad));
-                speed_mps = pCurrentWp->getSpeed();
-                speedType = pCurrentWp->getSpeedType();
+                m_currentWpID = nextWpID;
+                pCurrentWp = pNextWp;
+                m_currentStartTimestamp_ms = uxas::common::Time::getInstance().getUtcTimeSinceEpoch_ms();
+
+                current_m = getNorthEast_m(pCurrentWp, flatEarth);
+
+                nextWpID = pCurrentWp->getNextWaypoint();
+                pNextWp = getWaypoint(m_pMissionCmd, nextWpID);
             }
-            
-            if(m_isSpeedOverridden)
+            else
             {
-                speed_mps = m_overrideSpeed;
+                m_isLastWaypoint = true;
             }
+        }
+
+        // const double course_rad = n_Const::c_Convert::toRadians(static_cast<double>(pState->getCourse()));
+        // const double groundSpeed_mps = static_cast<double>(pState->getGroundspeed());
+
+        double desiredHeading_deg;
+        float speed_mps;
+        afrl::cmasi::SpeedType::SpeedType speedType;
+
+        if (isOrbitType(pCurrentWp))
+        {
+            afrl::cmasi::LoiterAction* pLoiterAction = getAssociatedLoiter(pCurrentWp);
+            assert(pLoiterAction != nullptr);
+
+            const VisiLibity::Point orbitRelativePosition_m = position_m - current_m;
+            const double gamma_rad = atan2(orbitRelativePosition_m.y(), orbitRelativePosition_m.x()); // angular position of uav
+
+            const double d_m = mag(orbitRelativePosition_m); // radial distance of uav
 
-            if(m_useSafeHeadingAction && !m_isHeadingControlledByTask)
+            const double r_m = pLoiterAction->getRadius();
+            // const double beta = m_kOrbit / (r_m * (1 + pow(m_kOrbit * (d_m - r_m) / r_m, 2.0)));
+
+            double desiredCourse_rad;
+            // const double commandedCourse_deg;
+
+            if (pLoiterAction->getDirection() == afrl::cmasi::LoiterDirection::Clockwise)
             {
-                auto safeHeadingAction = uxas::stduxas::make_unique<uxas::messages::uxnative::SafeHeadingAction>();
-                safeHeadingAction->setVehicleID(pState->getID());
-                safeHeadingAction->setOperatingRegion(m_operatingRegion);
-                safeHeadingAction->setLeadAheadDistance(m_leadAheadDistance_m);
-                safeHeadingAction->setLoiterRadius(m_loiterRadius_m);
-                safeHeadingAction->setDesiredHeading(static_cast<float>(desiredHeading_deg));
-                safeHeadingAction->setDesiredHeadingRate(0.0);
-                safeHeadingAction->setUseHeadingRate(false);
-                safeHeadingAction->setAltitude(pCurrentWp->getAltitude());
-                safeHeadingAction->setAltitudeType(pCurrentWp->getAltitudeType());
-                safeHeadingAction->setUseAltitude(true);
-                safeHeadingAction->setSpeed(speed_mps);
-                safeHeadingAction->setUseSpeed(true);
-                sendSharedLmcpObjectBroadcastMessage(std::move(safeHeadingAction));
+                desiredCourse_rad = gamma_rad + n_Const::c_Convert::dPiO2() + atan(m_kOrbit * (d_m - r_m) / r_m); // Nelson et al., Eq. 17 in clockwise
             }
-            else if(!m_isHeadingControlledByTask)
+            else // CounterClockwise
             {
-                auto pAction = uxas::stduxas::make_unique<afrl::cmasi::FlightDirectorAction>();
-                pAction->setSpeed(speed_mps);
-                pAction->setSpeedType(speedType);
-                pAction->setHeading(static_cast<float>(desiredHeading_deg)); // true heading in degrees
-                pAction->setAltitude(pCurrentWp->getAltitude());
-                pAction->setAltitudeType(pCurrentWp->getAltitudeType());
-                pAction->setClimbRate(pCurrentWp->getClimbRate());
-
-                auto pCommand = uxas::stduxas::make_unique<afrl::cmasi::VehicleActionCommand>();
-                pCommand->setCommandID(getUniqueEntitySendMessageId());
-                pCommand->setVehicleID(m_vehicleID);
-                pCommand->getVehicleActionList().push_back(pAction.release());
-                pCommand->setStatus(afrl::cmasi::CommandStatusType::Approved);
-
-                sendLmcpObjectBroadcastMessage(std::move(pCommand));
+                // TODO: handle VehicleDefault, for now treating as CounterClockwise
+                desiredCourse_rad = gamma_rad - n_Const::c_Convert::dPiO2() - atan(m_kOrbit * (d_m - r_m) / r_m); // Nelson et al., Eq. 17
+
+                // TODO: discretized version of Eq. 23, for now using Eq. 17 and assuming autopilot can achieve
+                // commandedCourse_deg = n_Const::c_Convert::toDegrees( course_rad
+                //     + (groundspeed_mps * sin(course_rad - gamma_rad) / (m_alpha * d_m))
+                //     - (beta * groundspeed_mps * cos(course_rad - gamma_rad) / m_alpha)
+                //     - (m_kappaOrbit * sat((course_rad - desiredCourse_rad) / m_epsilonOrbit) / m_alpha)); // Nelson et al., Eq. 23
             }
+
+            desiredHeading_deg = n_Const::c_Convert::dNormalizeAngleDeg(n_Const::c_Convert::toDegrees(desiredCourse_rad));
+            speed_mps = pLoiterAction->getAirspeed();
+            speedType = afrl::cmasi::SpeedType::Airspeed;
         }
+        else // line type
+        {
+            // handle last waypoint (self-looping or invalid next waypoint) by always considering self on path
+            if (m_isLastWaypoint)
+            {
+                previous_m = position_m;
+            }
+
+            const VisiLibity::Point path_m = current_m - previous_m;
+            const double pathAngle_rad = atan2(path_m.y(), path_m.x());
+            // const double pathRelativeCourse_rad = n_Const::c_Convert::dNormalizeAngleRad(course_rad - pathAngle_rad);
+
+            // path's normal is in clockwise direction (matches local frame's handedness)
+            // NOTE: rotation sign opposite as our point is in NE frame (XY)
+            const VisiLibity::Point pathNormal_m = VisiLibity::Point::rotate(VisiLibity::Point::normalize(path_m), n_Const::c_Convert::dPiO2());
+
+            // NOTE: positive distance corresponds to normal's side (clockwise)
+            const double y_m = dot(pathNormal_m, position_m - previous_m);
+            const double desiredCourse_rad = -2.0 * m_courseInf_rad / n_Const::c_Convert::dPi() * atan(m_kLine * y_m); // Nelson et al., Eq. 8
 
-        // Always send out the corresponding AirVehicleState with its waypoint number and associated task list correctly populated
-        pState->setCurrentWaypoint(m_currentWpID);
-        pState->getAssociatedTasks().clear();
+            // TODO: discretized version of Eq. 12, for now using Eq. 8 and assuming autopilot can achieve
+            // const double commandedCourse_deg = n_Const::c_Convert::toDegrees( pathRelativeCourse_rad
+            //     - ((m_courseInf_rad * 2.0 * m_kLine * groundSpeed_mps * sin(pathRelativeCourse_rad)) / (m_alpha * n_Const::c_Convert::dPi() * (1.0 + pow(m_kLine * y_m, 2.0))))
+            //     - (m_kappaLine * sat((pathRelativeCourse_rad - desiredCourse_rad) / m_epsilonLine) / m_alpha) ); // Nelson et al., Eq. 12
 
-        if (pCurrentWp != nullptr)
+            // Calculations are relative to path so need to add back in to commanded
+            desiredHeading_deg = n_Const::c_Convert::dNormalizeAngleDeg(n_Const::c_Convert::toDegrees(desiredCourse_rad + pathAngle_rad));
+            speed_mps = pCurrentWp->getSpeed();
+            speedType = pCurrentWp->getSpeedType();
+        }
+        
+        if(m_isSpeedOverridden)
         {
-            // Note: only waypoint associated tasks are included, not those from other actions
-            pState->getAssociatedTasks().assign(pCurrentWp->getAssociatedTasks().begin(), pCurrentWp->getAssociatedTasks().end());
+            speed_mps = m_overrideSpeed;
         }
 
-        sendSharedLmcpObjectBroadcastMessage(pState);
+        if(m_useSafeHeadingAction && !m_isHeadingControlledByTask)
+        {
+            auto safeHeadingAction = uxas::stduxas::make_unique<uxas::messages::uxnative::SafeHeadingAction>();
+            safeHeadingAction->setVehicleID(pState->getID());
+            safeHeadingAction->setOperatingRegion(m_operatingRegion);
+            safeHeadingAction->setLeadAheadDistance(m_leadAheadDistance_m);
+            safeHeadingAction->setLoiterRadius(m_loiterRadius_m);
+            safeHeadingAction->setDesiredHeading(static_cast<float>(desiredHeading_deg));
+            safeHeadingAction->setDesiredHeadingRate(0.0);
+            safeHeadingAction->setUseHeadingRate(false);
+            safeHeadingAction->setAltitude(pCurrentWp->getAltitude());
+            safeHeadingAction->setAltitudeType(pCurrentWp->getAltitudeType());
+            safeHeadingAction->setUseAltitude(true);
+            safeHeadingAction->setSpeed(speed_mps);
+            safeHeadingAction->setUseSpeed(true);
+            sendSharedLmcpObjectBroadcastMessage(std::move(safeHeadingAction));
+        }
+        else if(!m_isHeadingControlledByTask)
+        {
+            auto pAction = uxas::stduxas::make_unique<afrl::cmasi::FlightDirectorAction>();
+            pAction->setSpeed(speed_mps);
+            pAction->setSpeedType(speedType);
+            pAction->setHeading(static_cast<float>(desiredHeading_deg)); // true heading in degrees
+            pAction->setAltitude(pCurrentWp->getAltitude());
+            pAction->setAltitudeType(pCurrentWp->getAltitudeType());
+            pAction->setClimbRate(pCurrentWp->getClimbRate());
+
+            auto pCommand = uxas::stduxas::make_unique<afrl::cmasi::VehicleActionCommand>();
+            pCommand->setCommandID(getUniqueEntitySendMessageId());
+            pCommand->setVehicleID(m_vehicleID);
+            pCommand->getVehicleActionList().push_back(pAction.release());
+            pCommand->setStatus(afrl::cmasi::CommandStatusType::Approved);
+
+            sendLmcpObjectBroadcastMessage(std::move(pCommand));
+        }
     }
 
-    return false;
+    // Always send out the corresponding AirVehicleState with its waypoint number and associated task list correctly populated
+    pState->setCurrentWaypoint(m_currentWpID);
+    pState->getAssociatedTasks().clear();
+
+    if (pCurrentWp != nullptr)
+    {
+        // Note: only waypoint associated tasks are included, not those from other actions
+        pState->getAssociatedTasks().assign(pCurrentWp->getAssociatedTasks().begin(), pCurrentWp->getAssociatedTasks().end());
+    }
+
+    sendSharedLmcpObjectBroadcastMessage(pState);
+    return (false);
 }
 
 void SteeringService::reset(const afrl::cmasi::MissionCommand* pMissionCmd)
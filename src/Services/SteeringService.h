@@ -24,12 +24,36 @@ namespace afrl
 namespace cmasi
 {
 
+class AirVehicleConfiguration;
+class AirVehicleState;
+class AutomationResponse;
 class Location3D;
 class MissionCommand;
+class VehicleActionCommand;
 
 } // namespace cmasi
 } // namespace afrl
 
+namespace uxas
+{
+namespace messages
+{
+namespace task
+{
+
+class UniqueAutomationRequest;
+class UniqueAutomationResponse;
+
+} // namespace task
+namespace uxnative
+{
+
+class SpeedOverrideAction;
+
+} // namespace uxnative
+} // namespace messages
+} // namespace uxas
+
 namespace uxas
 {
 namespace service
@@ -71,7 +95,14 @@ private:
 
     bool configure(const pugi::xml_node& serviceXmlNode) override;
 
-    bool processReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage) override;
+    bool onAirVehicleConfiguration(const std::shared_ptr<afrl::cmasi::AirVehicleConfiguration>& avconfig);
+    bool onAirVehicleState(const std::shared_ptr<afrl::cmasi::AirVehicleState>& pState);
+    bool onAutomationResponse(const std::shared_ptr<afrl::cmasi::AutomationResponse>& pResponse);
+    bool onMissionCommand(const std::shared_ptr<afrl::cmasi::MissionCommand>& pMission);
+    bool onSpeedOverrideAction(const std::shared_ptr<uxas::messages::uxnative::SpeedOverrideAction>& speed_override);
+    bool onVehicleActionCommand(const std::shared_ptr<afrl::cmasi::VehicleActionCommand>& vehicleActionCommand);
+    bool onUniqueAutomationRequest(const std::shared_ptr<uxas::messages::task::UniqueAutomationRequest>& req);
+    bool onUniqueAutomationResponse(const std::shared_ptr<uxas::messages::task::UniqueAutomationResponse>& resp);
 
     static ServiceBase::CreationRegistrar<SteeringService> s_registrar;
 
@@ -98,6 +98,7 @@ BlockadeTaskService::configureTask(const pugi::xml_node& ndComponent)
     } //isSuccessful
     if (isSuccessful)
     {
+        addEntityStateInterest(m_blockadeTask->getBlockedEntityID());
         if (m_entityStates.find(m_blockadeTask->getBlockedEntityID()) != m_entityStates.end())
         {
             m_blockedEntityStateLast = m_entityStates[m_blockadeTask->getBlockedEntityID()];
@@ -119,7 +120,6 @@ BlockadeTaskService::processReceivedLmcpMessageTask(std::shared_ptr<avtas::lmcp:
         {
             m_blockedEntityStateLast = entityState;
         }
-        m_entityStates[entityState->getID()] = entityState;
     }
     return (false); // always false implies never terminating service from here
 };
@@ -98,6 +98,7 @@ CommRelayTaskService::configureDynamicTask(const pugi::xml_node& ndComponent)
         }
         else
         {
+            addEntityStateInterest(m_CommRelayTask->getSupportedEntityID());
             if (m_entityStates.find(m_CommRelayTask->getSupportedEntityID()) != m_entityStates.end())
             {
                 m_supportedEntityStateLast = std::shared_ptr<afrl::cmasi::Location3D>(m_entityStates[m_CommRelayTask->getSupportedEntityID()]->getLocation()->clone());
@@ -92,6 +92,7 @@ EscortTaskService::configureDynamicTask(const pugi::xml_node& ndComponent)
     } //isSuccessful
     if (isSuccessful)
     {
+        addEntityStateInterest(m_escortTask->getSupportedEntityID());
         if (m_entityStates.find(m_escortTask->getSupportedEntityID()) != m_entityStates.end())
         {
             m_supportedEntityStateLast = m_entityStates[m_escortTask->getSupportedEntityID()];
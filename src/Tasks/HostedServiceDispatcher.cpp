@@ -0,0 +1,325 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#include "HostedServiceDispatcher.h"
+
+#include "uxas/messages/uxnative/KillService.h"
+
+#include "UxAS_Log.h"
+
+#include "stdUniquePtr.h"
+
+#include <algorithm>
+
+namespace uxas
+{
+namespace service
+{
+namespace task
+{
+
+HostedServiceDispatcher::HostedServiceDispatcher(uxas::common::ThreadPool& threadPool, uint32_t maxMessagesPerJob)
+: m_threadPool(threadPool), m_maxMessagesPerJob(maxMessagesPerJob)
+{
+};
+
+bool
+HostedServiceDispatcher::addService(std::unique_ptr<ServiceBase> service)
+{
+    int64_t networkId = service->m_networkId;
+    if (m_hostedServicesById.find(networkId) != m_hostedServicesById.end())
+    {
+        return (false);
+    }
+    auto hostedService = std::make_shared<HostedService>();
+    hostedService->m_service = std::move(service);
+    m_hostedServicesById[networkId] = std::move(hostedService);
+    return (true);
+};
+
+ServiceBase*
+HostedServiceDispatcher::getService(int64_t networkId) const
+{
+    auto itHostedService = m_hostedServicesById.find(networkId);
+    return (itHostedService != m_hostedServicesById.end() ? itHostedService->second->m_service.get() : nullptr);
+};
+
+bool
+HostedServiceDispatcher::addAddress(int64_t networkId, const std::string& address)
+{
+    auto itHostedService = m_hostedServicesById.find(networkId);
+    if (itHostedService == m_hostedServicesById.end() || !itHostedService->second->m_addresses.insert(address).second)
+    {
+        return (false);
+    }
+
+    auto& hostedServices = m_hostedServicesByAddress[address];
+    hostedServices.push_back(itHostedService->second);
+    if (hostedServices.size() > 1)
+    {
+        return (false);
+    }
+    m_addressCountByLength[address.size()]++;
+    return (true);
+};
+
+bool
+HostedServiceDispatcher::removeAddress(int64_t networkId, const std::string& address)
+{
+    auto itHostedService = m_hostedServicesById.find(networkId);
+    if (itHostedService == m_hostedServicesById.end() || itHostedService->second->m_addresses.erase(address) == 0)
+    {
+        return (false);
+    }
+
+    auto itAddress = m_hostedServicesByAddress.find(address);
+    if (itAddress == m_hostedServicesByAddress.end())
+    {
+        return (false);
+    }
+    auto& hostedServices = itAddress->second;
+    hostedServices.erase(std::remove(hostedServices.begin(), hostedServices.end(), itHostedService->second), hostedServices.end());
+    if (!hostedServices.empty())
+    {
+        return (false);
+    }
+    m_hostedServicesByAddress.erase(itAddress);
+    auto itLength = m_addressCountByLength.find(address.size());
+    if (--itLength->second == 0)
+    {
+        m_addressCountByLength.erase(itLength);
+    }
+    return (true);
+};
+
+void
+HostedServiceDispatcher::dispatch(std::unique_ptr<uxas::communications::data::LmcpMessage> message)
+{
+    if (uxas::messages::uxnative::isKillService(message->m_object))
+    {
+        int64_t serviceId = std::static_pointer_cast<uxas::messages::uxnative::KillService>(message->m_object)->getServiceID();
+        auto itHostedService = m_hostedServicesById.find(serviceId);
+        if (itHostedService != m_hostedServicesById.end())
+        {
+            UXAS_LOG_INFORM("HostedServiceDispatcher::dispatch terminating hosted service ID ", serviceId);
+            requestTermination(itHostedService->second);
+        }
+        return;
+    }
+
+    // every subscribed prefix of the address, each receiver once (in subscription order)
+    const std::string& address = message->m_address;
+    const std::string& sourceEntityId = message->m_attributes->getSourceEntityId();
+    const std::string& sourceServiceId = message->m_attributes->getSourceServiceId();
+    std::vector<std::shared_ptr<HostedService> > receivers;
+    for (auto& lengthCount : m_addressCountByLength)
+    {
+        if (lengthCount.first > address.size())
+        {
+            break;
+        }
+        auto itAddress = m_hostedServicesByAddress.find(address.substr(0, lengthCount.first));
+        if (itAddress == m_hostedServicesByAddress.end())
+        {
+            continue;
+        }
+        for (auto& hostedService : itAddress->second)
+        {
+            const auto& service = hostedService->m_service;
+            if (service->m_networkIdString == sourceServiceId && service->m_entityIdString == sourceEntityId)
+            {
+                continue; // do not deliver self-sent messages
+            }
+            if (std::find(receivers.begin(), receivers.end(), hostedService) == receivers.end())
+            {
+                receivers.push_back(hostedService);
+            }
+        }
+    }
+
+    // each receiver but the last gets a copy of the object; the last one takes the message
+    for (size_t index = 0; index < receivers.size(); index++)
+    {
+        if (index + 1 == receivers.size())
+        {
+            enqueue(receivers[index], std::move(message));
+        }
+        else
+        {
+            auto copy = uxas::stduxas::make_unique<uxas::communications::data::LmcpMessage>
+                    (uxas::stduxas::make_unique<uxas::communications::data::MessageAttributes>(*message->m_attributes),
+                     std::shared_ptr<avtas::lmcp::Object>(message->m_object->clone()));
+            copy->m_address = message->m_address;
+            copy->m_sendTime = message->m_sendTime;
+            enqueue(receivers[index], std::move(copy));
+        }
+    }
+};
+
+void
+HostedServiceDispatcher::requestTermination(int64_t networkId)
+{
+    auto itHostedService = m_hostedServicesById.find(networkId);
+    if (itHostedService != m_hostedServicesById.end())
+    {
+        requestTermination(itHostedService->second);
+    }
+};
+
+void
+HostedServiceDispatcher::requestAllTermination()
+{
+    for (auto& hostedService : m_hostedServicesById)
+    {
+        requestTermination(hostedService.second);
+    }
+};
+
+void
+HostedServiceDispatcher::discardService(int64_t networkId)
+{
+    auto itHostedService = m_hostedServicesById.find(networkId);
+    if (itHostedService != m_hostedServicesById.end())
+    {
+        std::lock_guard<std::mutex> lock(itHostedService->second->m_mutex);
+        itHostedService->second->m_isTerminated = true;
+    }
+};
+
+std::vector<std::string>
+HostedServiceDispatcher::removeTerminatedServices()
+{
+    std::vector<std::string> unsubscribedAddresses;
+    for (auto itHostedService = m_hostedServicesById.begin(); itHostedService != m_hostedServicesById.end();)
+    {
+        auto hostedService = itHostedService->second;
+        bool isRemove{false};
+        {
+            std::lock_guard<std::mutex> lock(hostedService->m_mutex);
+            isRemove = hostedService->m_isTerminated && !hostedService->m_isScheduled;
+        }
+        if (isRemove)
+        {
+            auto addresses = hostedService->m_addresses;
+            for (auto& address : addresses)
+            {
+                if (removeAddress(itHostedService->first, address))
+                {
+                    unsubscribedAddresses.push_back(address);
+                }
+            }
+            itHostedService = m_hostedServicesById.erase(itHostedService);
+        }
+        else
+        {
+            itHostedService++;
+        }
+    }
+    return (unsubscribedAddresses);
+};
+
+size_t
+HostedServiceDispatcher::terminateRemainingServices()
+{
+    for (auto& hostedService : m_hostedServicesById)
+    {
+        if (!hostedService.second->m_isTerminated)
+        {
+            hostedService.second->m_service->terminateHostedNetworkClient();
+            hostedService.second->m_isTerminated = true;
+        }
+    }
+    return (m_hostedServicesById.size());
+};
+
+void
+HostedServiceDispatcher::enqueue(const std::shared_ptr<HostedService>& hostedService, std::unique_ptr<uxas::communications::data::LmcpMessage> message)
+{
+    {
+        std::lock_guard<std::mutex> lock(hostedService->m_mutex);
+        if (hostedService->m_isTerminated)
+        {
+            return;
+        }
+        if (message)
+        {
+            hostedService->m_messages.push_back(std::move(message));
+        }
+        if (hostedService->m_isScheduled)
+        {
+            return;
+        }
+        hostedService->m_isScheduled = true;
+    }
+    m_threadPool.post([this, hostedService]() { execute(hostedService); });
+};
+
+void
+HostedServiceDispatcher::requestTermination(const std::shared_ptr<HostedService>& hostedService)
+{
+    {
+        std::lock_guard<std::mutex> lock(hostedService->m_mutex);
+        hostedService->m_isTerminationRequested = true;
+    }
+    enqueue(hostedService, std::unique_ptr<uxas::communications::data::LmcpMessage>());
+};
+
+void
+HostedServiceDispatcher::execute(const std::shared_ptr<HostedService>& hostedService)
+{
+    // a bounded batch, so that one busy service cannot starve the others
+    for (uint32_t messageCount = 0; messageCount < m_maxMessagesPerJob; messageCount++)
+    {
+        std::unique_ptr<uxas::communications::data::LmcpMessage> message;
+        {
+            std::lock_guard<std::mutex> lock(hostedService->m_mutex);
+            if (hostedService->m_isTerminationRequested || hostedService->m_messages.empty())
+            {
+                break;
+            }
+            message = std::move(hostedService->m_messages.front());
+            hostedService->m_messages.pop_front();
+        }
+        if (hostedService->m_service->processHostedLmcpMessage(std::move(message)))
+        {
+            std::lock_guard<std::mutex> lock(hostedService->m_mutex);
+            hostedService->m_isTerminationRequested = true;
+        }
+    }
+
+    bool isTerminate{false};
+    {
+        std::lock_guard<std::mutex> lock(hostedService->m_mutex);
+        isTerminate = hostedService->m_isTerminationRequested && !hostedService->m_isTerminated;
+    }
+    if (isTerminate)
+    {
+        hostedService->m_service->terminateHostedNetworkClient();
+    }
+
+    bool isReschedule{false};
+    {
+        std::lock_guard<std::mutex> lock(hostedService->m_mutex);
+        if (isTerminate)
+        {
+            hostedService->m_isTerminated = true;
+            hostedService->m_messages.clear();
+        }
+        isReschedule = !hostedService->m_isTerminated && !hostedService->m_messages.empty();
+        hostedService->m_isScheduled = isReschedule;
+    }
+    if (isReschedule)
+    {
+        m_threadPool.post([this, hostedService]() { execute(hostedService); });
+    }
+};
+
+}; //namespace task
+}; //namespace service
+}; //namespace uxas
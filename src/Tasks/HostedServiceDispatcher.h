@@ -0,0 +1,190 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_SERVICE_TASK_HOSTED_SERVICE_DISPATCHER_H
+#define UXAS_SERVICE_TASK_HOSTED_SERVICE_DISPATCHER_H
+
+#include "ServiceBase.h"
+#include "UxAS_ThreadPool.h"
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace uxas
+{
+namespace service
+{
+namespace task
+{
+
+/** \class HostedServiceDispatcher
+ *
+ * \par Description:
+ * Dispatches received messages to hosted services and executes them on a
+ * thread pool. A message is delivered to every hosted service subscribed to
+ * a prefix of its address (as Zero MQ subscriptions match), once per service,
+ * and never to the service that sent it. Each receiver gets its own copy of
+ * the LMCP object, since services may modify received objects. Each hosted
+ * service processes its messages in order and never concurrently (a strand
+ * on the thread pool). <B><i>KillService</i></B> messages addressed to a
+ * hosted service terminate it on its strand.
+ *
+ * \par Threading:
+ * All methods must be called from one thread (the dispatching thread); the
+ * hosted services are executed by the thread pool.
+ *
+ * \n
+ */
+class HostedServiceDispatcher
+{
+public:
+
+    /** \brief Constructs the dispatcher.
+     *
+     * @param threadPool pool executing the hosted services; must outlive
+     * the dispatcher or be shut down before it is destroyed
+     * @param maxMessagesPerJob maximum messages one job processes before
+     * yielding the worker thread
+     */
+    HostedServiceDispatcher(uxas::common::ThreadPool& threadPool, uint32_t maxMessagesPerJob = 16);
+
+private:
+
+    /** \brief Copy construction not permitted */
+    HostedServiceDispatcher(HostedServiceDispatcher const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(HostedServiceDispatcher const&) = delete;
+
+public:
+
+    /** \brief Adds a hosted service (not yet subscribed to any address).
+     *
+     * @param service service to host
+     * @return false if a service with the same network ID is hosted
+     */
+    bool
+    addService(std::unique_ptr<ServiceBase> service);
+
+    /** \brief Returns the hosted service with network ID
+     * <B><i>networkId</i></B> or nullptr. */
+    ServiceBase*
+    getService(int64_t networkId) const;
+
+    size_t
+    getServiceCount() const { return (m_hostedServicesById.size()); };
+
+    /** \brief Subscribes a hosted service to <B><i>address</i></B>.
+     *
+     * @return true if no hosted service was subscribed to the address before
+     * (the receiver of the dispatched messages must subscribe to it)
+     */
+    bool
+    addAddress(int64_t networkId, const std::string& address);
+
+    /** \brief Unsubscribes a hosted service from <B><i>address</i></B>.
+     *
+     * @return true if no hosted service remains subscribed to the address
+     * (the receiver of the dispatched messages can unsubscribe from it)
+     */
+    bool
+    removeAddress(int64_t networkId, const std::string& address);
+
+    /** \brief Queues <B><i>message</i></B> for the hosted services subscribed
+     * to its address, or terminates the hosted service addressed by a
+     * <B><i>KillService</i></B> message. */
+    void
+    dispatch(std::unique_ptr<uxas::communications::data::LmcpMessage> message);
+
+    /** \brief Terminates the hosted service on its strand after the message
+     * being processed (queued messages are discarded). */
+    void
+    requestTermination(int64_t networkId);
+
+    void
+    requestAllTermination();
+
+    /** \brief Marks a hosted service as terminated without executing its
+     * termination (e.g., it failed to start). */
+    void
+    discardService(int64_t networkId);
+
+    /** \brief Removes terminated services that are no longer referenced by
+     * a job.
+     *
+     * @return addresses no hosted service is subscribed to anymore
+     */
+    std::vector<std::string>
+    removeTerminatedServices();
+
+    /** \brief Terminates, on the calling thread, the hosted services that have
+     * not been terminated by a job. Call after the thread pool has been shut
+     * down.
+     *
+     * @return number of hosted services
+     */
+    size_t
+    terminateRemainingServices();
+
+private:
+
+    /** \class HostedService
+     *
+     * \par Description:
+     * A hosted service and its queue of received messages. The queue and
+     * flags are protected by <B><i>m_mutex</i></B>; <B><i>m_addresses</i></B>
+     * is only used by the dispatching thread.
+     */
+    class HostedService
+    {
+    public:
+        std::unique_ptr<ServiceBase> m_service;
+        std::mutex m_mutex;
+        std::deque<std::unique_ptr<uxas::communications::data::LmcpMessage> > m_messages;
+        /** \brief true while a job processing this service is queued or running */
+        bool m_isScheduled{false};
+        bool m_isTerminationRequested{false};
+        bool m_isTerminated{false};
+        std::set<std::string> m_addresses;
+    };
+
+    /** \brief Queues <B><i>message</i></B> (if any) for the hosted service and
+     * schedules processing. */
+    void
+    enqueue(const std::shared_ptr<HostedService>& hostedService, std::unique_ptr<uxas::communications::data::LmcpMessage> message);
+
+    void
+    requestTermination(const std::shared_ptr<HostedService>& hostedService);
+
+    /** \brief Processes a bounded number of queued messages of one hosted
+     * service (worker thread). */
+    void
+    execute(const std::shared_ptr<HostedService>& hostedService);
+
+    uxas::common::ThreadPool& m_threadPool;
+    uint32_t m_maxMessagesPerJob;
+
+    std::unordered_map<int64_t, std::shared_ptr<HostedService> > m_hostedServicesById;
+    std::unordered_map<std::string, std::vector<std::shared_ptr<HostedService> > > m_hostedServicesByAddress;
+    /** \brief number of subscribed addresses of each length (only these prefixes of a message address are looked up) */
+    std::map<size_t, size_t> m_addressCountByLength;
+};
+
+}; //namespace task
+}; //namespace service
+}; //namespace uxas
+
+#endif /* UXAS_SERVICE_TASK_HOSTED_SERVICE_DISPATCHER_H */
@@ -73,6 +73,7 @@ OverwatchTaskService::configureDynamicTask(const pugi::xml_node& ndComponent)
         }
     }
 
+    addEntityStateInterest(m_watchTask->getWatchedEntityID());
     if (m_entityStates.find(m_watchTask->getWatchedEntityID()) != m_entityStates.end())
     {
         m_watchedEntityStateLast = m_entityStates[m_watchTask->getWatchedEntityID()];
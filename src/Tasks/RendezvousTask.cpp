@@ -59,6 +59,9 @@ RendezvousTask::configureTask(const pugi::xml_node& ndComponent)
     // add subscription to AssignmentCostMatrix to determine timing between options
     addSubscriptionAddress(uxas::messages::task::AssignmentCostMatrix::Subscription);
 
+    // remaining distance is tracked for all vehicles, not only the assigned ones
+    addAllEntityStatesInterest();
+
     // Process task options
     pugi::xml_node ndTaskOptions = ndComponent.child(m_taskOptions_XmlTag.c_str());
     if (!ndTaskOptions)
@@ -0,0 +1,168 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#include "SharedEntityStore.h"
+
+namespace uxas
+{
+namespace service
+{
+namespace task
+{
+
+SharedEntityStore&
+SharedEntityStore::getInstance()
+{
+    // C++11 guarantees thread-safe initialization of function-local statics
+    static SharedEntityStore s_instance;
+    return (s_instance);
+};
+
+SharedEntityStore::SharedEntityStore()
+{
+    m_snapshot = std::make_shared<const Snapshot>();
+};
+
+void
+SharedEntityStore::publish(std::shared_ptr<Snapshot> snapshot)
+{
+    snapshot->m_version = m_snapshot->m_version + 1;
+    std::atomic_store(&m_snapshot, std::shared_ptr<const Snapshot>(std::move(snapshot)));
+};
+
+bool
+SharedEntityStore::setEntityState(const std::shared_ptr<afrl::cmasi::EntityState>& entityState, std::vector<std::string>& notifyAddresses)
+{
+    notifyAddresses.clear();
+    if (!entityState)
+    {
+        return (false);
+    }
+
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    auto& entityStates = m_snapshot->m_entityStates;
+    // the latest received state wins, also when time went backwards (replay
+    // seek, restart or simulation reset), as in the task services' own maps
+    auto itEntityState = entityStates.find(entityState->getID());
+    if (itEntityState != entityStates.end() && itEntityState->second == entityState)
+    {
+        return (false);
+    }
+
+    auto snapshot = std::make_shared<Snapshot>(*m_snapshot);
+    snapshot->m_entityStates = entityStates.set(entityState->getID(), entityState);
+    publish(std::move(snapshot));
+
+    notifyAddresses.assign(m_allEntitiesInterestedAddresses.begin(), m_allEntitiesInterestedAddresses.end());
+    auto itInterested = m_entityIdVsInterestedAddresses.find(entityState->getID());
+    if (itInterested != m_entityIdVsInterestedAddresses.end())
+    {
+        for (auto& address : itInterested->second)
+        {
+            if (m_allEntitiesInterestedAddresses.find(address) == m_allEntitiesInterestedAddresses.end())
+            {
+                notifyAddresses.push_back(address);
+            }
+        }
+    }
+    return (true);
+};
+
+bool
+SharedEntityStore::setEntityConfiguration(const std::shared_ptr<afrl::cmasi::EntityConfiguration>& entityConfiguration)
+{
+    if (!entityConfiguration)
+    {
+        return (false);
+    }
+
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    auto snapshot = std::make_shared<Snapshot>(*m_snapshot);
+    snapshot->m_entityConfigurations = m_snapshot->m_entityConfigurations.set(entityConfiguration->getID(), entityConfiguration);
+    publish(std::move(snapshot));
+    return (true);
+};
+
+bool
+SharedEntityStore::setKeepInZone(const std::shared_ptr<afrl::cmasi::KeepInZone>& keepInZone)
+{
+    if (!keepInZone)
+    {
+        return (false);
+    }
+
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    auto snapshot = std::make_shared<Snapshot>(*m_snapshot);
+    snapshot->m_keepInZones = m_snapshot->m_keepInZones.set(keepInZone->getZoneID(), keepInZone);
+    publish(std::move(snapshot));
+    return (true);
+};
+
+bool
+SharedEntityStore::setKeepOutZone(const std::shared_ptr<afrl::cmasi::KeepOutZone>& keepOutZone)
+{
+    if (!keepOutZone)
+    {
+        return (false);
+    }
+
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    auto snapshot = std::make_shared<Snapshot>(*m_snapshot);
+    snapshot->m_keepOutZones = m_snapshot->m_keepOutZones.set(keepOutZone->getZoneID(), keepOutZone);
+    publish(std::move(snapshot));
+    return (true);
+};
+
+void
+SharedEntityStore::setEntityStateInterest(const std::string& address, const std::unordered_set<int64_t>& entityIds, bool isAllEntities)
+{
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    auto& interestEntityIds = m_addressVsInterestEntityIds[address];
+    for (auto& entityId : interestEntityIds)
+    {
+        if (entityIds.find(entityId) == entityIds.end())
+        {
+            auto itInterested = m_entityIdVsInterestedAddresses.find(entityId);
+            if (itInterested != m_entityIdVsInterestedAddresses.end())
+            {
+                itInterested->second.erase(address);
+                if (itInterested->second.empty())
+                {
+                    m_entityIdVsInterestedAddresses.erase(itInterested);
+                }
+            }
+        }
+    }
+    for (auto& entityId : entityIds)
+    {
+        m_entityIdVsInterestedAddresses[entityId].insert(address);
+    }
+    interestEntityIds = entityIds;
+
+    if (isAllEntities)
+    {
+        m_allEntitiesInterestedAddresses.insert(address);
+    }
+    else
+    {
+        m_allEntitiesInterestedAddresses.erase(address);
+    }
+};
+
+void
+SharedEntityStore::removeEntityStateInterest(const std::string& address)
+{
+    setEntityStateInterest(address, std::unordered_set<int64_t>(), false);
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    m_addressVsInterestEntityIds.erase(address);
+};
+
+}; //namespace task
+}; //namespace service
+}; //namespace uxas
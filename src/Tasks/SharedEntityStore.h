@@ -0,0 +1,427 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_SERVICE_TASK_SHARED_ENTITY_STORE_H
+#define UXAS_SERVICE_TASK_SHARED_ENTITY_STORE_H
+
+#include "afrl/cmasi/EntityConfiguration.h"
+#include "afrl/cmasi/EntityState.h"
+#include "afrl/cmasi/KeepInZone.h"
+#include "afrl/cmasi/KeepOutZone.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace uxas
+{
+namespace service
+{
+namespace task
+{
+
+/** \class SharedEntityStore
+ *
+ * \par Description:
+ * Process-wide, versioned, read-mostly store of the latest entity
+ * configurations, entity states and keep-in/keep-out zones, shared by all task
+ * services. Each update publishes a new immutable <B><i>Snapshot</i></B>
+ * (copy-on-write of the path to the changed entry of one persistent map);
+ * readers load the current snapshot with a single atomic operation and never
+ * block writers (RCU style). Memory and decoding work therefore scale with
+ * the number of entities rather than entities times tasks, and an update
+ * costs O(log(entities)).
+ *
+ * \par Feeding and change notifications:
+ * One service (the <B><i>TaskManagerService</i></B>) subscribes to the
+ * entity messages, updates the store and then forwards each
+ * <B><i>EntityState</i></B> only to the task services that registered
+ * interest in that entity (uni-cast addresses returned by
+ * <B><i>setEntityState</i></B>). If no feeder is registered, task services
+ * fall back to subscribing to entity states themselves.
+ *
+ * \n
+ */
+class SharedEntityStore
+{
+public:
+
+    static const std::string&
+    s_typeName() { static std::string s_string("SharedEntityStore"); return (s_string); };
+
+    /** \class IdVsObject
+     *
+     * \par Description:
+     * Immutable (persistent) map of IDs to objects: a hash trie whose nodes
+     * are shared between versions. <B><i>set</i></B> returns a new map that
+     * copies only the nodes on the path to the changed entry (a few nodes of
+     * 32 pointers) and shares all others, so an update costs
+     * O(log32(entities)) instead of a copy of the map.
+     */
+    template <typename T>
+    class IdVsObject
+    {
+    public:
+        typedef std::pair<const int64_t, std::shared_ptr<T> > value_type;
+
+    private:
+        static const uint32_t c_bitsPerLevel{5};
+        static const uint32_t c_branchingFactor{1u << c_bitsPerLevel};
+
+        /*! \brief leaf (no children) holding one entry, or branch of c_branchingFactor children */
+        struct Node
+        {
+            Node() : m_entry(0, std::shared_ptr<T>()), m_children(c_branchingFactor) { };
+            explicit Node(const value_type& entry) : m_entry(entry) { };
+
+            bool isLeaf() const { return (m_children.empty()); };
+
+            value_type m_entry;
+            std::vector<std::shared_ptr<const Node> > m_children;
+        };
+
+    public:
+        class const_iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef typename IdVsObject::value_type value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const value_type* pointer;
+            typedef const value_type& reference;
+
+            reference operator*() const { return (m_leaf->m_entry); };
+            pointer operator->() const { return (&m_leaf->m_entry); };
+            bool operator==(const const_iterator& rhs) const { return (m_leaf == rhs.m_leaf); };
+            bool operator!=(const const_iterator& rhs) const { return (m_leaf != rhs.m_leaf); };
+
+            const_iterator&
+            operator++()
+            {
+                m_leaf = nullptr;
+                while (!m_path.empty())
+                {
+                    auto& branch = m_path.back();
+                    for (auto child = branch.second + 1; child < c_branchingFactor; child++)
+                    {
+                        if (branch.first->m_children[child])
+                        {
+                            branch.second = child;
+                            descend(branch.first->m_children[child].get());
+                            return (*this);
+                        }
+                    }
+                    m_path.pop_back();
+                }
+                return (*this);
+            };
+
+            const_iterator
+            operator++(int)
+            {
+                auto iterator = *this;
+                ++(*this);
+                return (iterator);
+            };
+
+        private:
+            friend class IdVsObject;
+
+            /*! \brief moves to the first leaf under 'node' */
+            void
+            descend(const Node* node)
+            {
+                while (!node->isLeaf())
+                {
+                    uint32_t child(0);
+                    while (!node->m_children[child])
+                    {
+                        child++;
+                    }
+                    m_path.push_back(std::make_pair(node, child));
+                    node = node->m_children[child].get();
+                }
+                m_leaf = node;
+            };
+
+            /*! \brief branches above the current leaf and the index of the child taken in each */
+            std::vector<std::pair<const Node*, uint32_t> > m_path;
+            /*! \brief null at the end */
+            const Node* m_leaf{nullptr};
+        };
+
+        const_iterator
+        begin() const
+        {
+            const_iterator iterator;
+            if (m_root)
+            {
+                iterator.descend(m_root.get());
+            }
+            return (iterator);
+        };
+
+        const_iterator end() const { return (const_iterator()); };
+
+        const_iterator
+        find(int64_t id) const
+        {
+            const_iterator iterator;
+            auto idHash = hash(id);
+            auto node = m_root.get();
+            for (uint32_t shift = 0; node && !node->isLeaf(); shift += c_bitsPerLevel)
+            {
+                auto child = childIndex(idHash, shift);
+                iterator.m_path.push_back(std::make_pair(node, child));
+                node = node->m_children[child].get();
+            }
+            if (node && node->m_entry.first == id)
+            {
+                iterator.m_leaf = node;
+                return (iterator);
+            }
+            return (end());
+        };
+
+        size_t count(int64_t id) const { return (find(id) != end() ? 1 : 0); };
+        size_t size() const { return (m_size); };
+        bool empty() const { return (m_size == 0); };
+
+        /** \brief Returns a copy of this map with <B><i>object</i></B> stored
+         * under <B><i>id</i></B>; this map is unchanged.
+         */
+        IdVsObject
+        set(int64_t id, const std::shared_ptr<T>& object) const
+        {
+            IdVsObject map;
+            bool isInserted(false);
+            map.m_root = setEntry(m_root, hash(id), 0, std::make_shared<const Node>(value_type(id, object)), isInserted);
+            map.m_size = m_size + (isInserted ? 1 : 0);
+            return (map);
+        };
+
+    private:
+        /*! \brief bijective mix of the ID (splitmix64 finalizer), so distinct IDs
+         * never collide and sequential IDs spread over the trie */
+        static uint64_t
+        hash(int64_t id)
+        {
+            auto idHash = static_cast<uint64_t>(id);
+            idHash = (idHash ^ (idHash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            idHash = (idHash ^ (idHash >> 27)) * 0x94d049bb133111ebULL;
+            return (idHash ^ (idHash >> 31));
+        };
+
+        static uint32_t
+        childIndex(uint64_t idHash, uint32_t shift)
+        {
+            return (static_cast<uint32_t>(idHash >> shift) & (c_branchingFactor - 1));
+        };
+
+        /*! \brief returns a copy of 'node' with 'leaf' stored; copies the nodes on the path only */
+        static std::shared_ptr<const Node>
+        setEntry(const std::shared_ptr<const Node>& node, uint64_t idHash, uint32_t shift,
+                 const std::shared_ptr<const Node>& leaf, bool& isInserted)
+        {
+            if (!node)
+            {
+                isInserted = true;
+                return (leaf);
+            }
+            std::shared_ptr<Node> branch;
+            if (node->isLeaf())
+            {
+                if (node->m_entry.first == leaf->m_entry.first)
+                {
+                    return (leaf);
+                }
+                // two IDs share this slot, the branch separates them on the next bits
+                branch = std::make_shared<Node>();
+                branch->m_children[childIndex(hash(node->m_entry.first), shift)] = node;
+            }
+            else
+            {
+                branch = std::make_shared<Node>(*node);
+            }
+            auto& child = branch->m_children[childIndex(idHash, shift)];
+            child = setEntry(child, idHash, shift + c_bitsPerLevel, leaf, isInserted);
+            return (branch);
+        };
+
+        std::shared_ptr<const Node> m_root;
+        size_t m_size{0};
+    };
+
+    /** \class Snapshot
+     *
+     * \par Description:
+     * Immutable view of the store at one version. Unchanged maps, and the
+     * unchanged nodes of the changed map, are shared between consecutive
+     * snapshots.
+     */
+    class Snapshot
+    {
+    public:
+        uint64_t m_version{0};
+        IdVsObject<afrl::cmasi::EntityConfiguration> m_entityConfigurations;
+        IdVsObject<afrl::cmasi::EntityState> m_entityStates;
+        IdVsObject<afrl::cmasi::KeepInZone> m_keepInZones;
+        IdVsObject<afrl::cmasi::KeepOutZone> m_keepOutZones;
+    };
+
+    /** \class MapView
+     *
+     * \par Description:
+     * Read-only, map-like handle on one map of a pinned snapshot. Provides
+     * the lookup and iteration subset of <B><i>std::unordered_map</i></B>
+     * used by the task services; <B><i>operator[]</i></B> returns an empty
+     * pointer for unknown IDs instead of inserting one.
+     */
+    template <typename T>
+    class MapView
+    {
+    public:
+        typedef typename IdVsObject<T>::const_iterator const_iterator;
+
+        void
+        reset(const IdVsObject<T>& map)
+        {
+            m_map = map;
+        };
+
+        const_iterator begin() const { return (m_map.begin()); };
+        const_iterator end() const { return (m_map.end()); };
+        const_iterator find(int64_t id) const { return (m_map.find(id)); };
+        size_t count(int64_t id) const { return (m_map.count(id)); };
+        size_t size() const { return (m_map.size()); };
+        bool empty() const { return (m_map.empty()); };
+
+        std::shared_ptr<T>
+        operator[](int64_t id) const
+        {
+            auto itObject = m_map.find(id);
+            return (itObject != m_map.end() ? itObject->second : std::shared_ptr<T>());
+        };
+
+    private:
+        IdVsObject<T> m_map;
+    };
+
+    static SharedEntityStore&
+    getInstance();
+
+    /** \brief Loads the current snapshot. Lock-free with respect to other
+     * readers; the returned snapshot stays valid (and unchanged) for as long
+     * as the caller holds it.
+     *
+     * @return current snapshot, never null
+     */
+    std::shared_ptr<const Snapshot>
+    getSnapshot() const
+    {
+        return (std::atomic_load(&m_snapshot));
+    };
+
+    uint64_t
+    getVersion() const
+    {
+        return (getSnapshot()->m_version);
+    };
+
+    /** \brief Stores an entity state, replacing the stored state of the same
+     * entity (even if it has a later time, e.g., after a replay seek or a
+     * simulation reset).
+     *
+     * @param entityState latest state
+     * @param notifyAddresses uni-cast addresses of the task services
+     * interested in this entity (cleared first)
+     * @return true if the store changed
+     */
+    bool
+    setEntityState(const std::shared_ptr<afrl::cmasi::EntityState>& entityState, std::vector<std::string>& notifyAddresses);
+
+    bool
+    setEntityConfiguration(const std::shared_ptr<afrl::cmasi::EntityConfiguration>& entityConfiguration);
+
+    bool
+    setKeepInZone(const std::shared_ptr<afrl::cmasi::KeepInZone>& keepInZone);
+
+    bool
+    setKeepOutZone(const std::shared_ptr<afrl::cmasi::KeepOutZone>& keepOutZone);
+
+    /** \brief Replaces the set of entities whose states are forwarded to
+     * <B><i>address</i></B>.
+     *
+     * @param address uni-cast address of the interested service
+     * @param entityIds entities of interest
+     * @param isAllEntities if true, states of all entities are forwarded
+     */
+    void
+    setEntityStateInterest(const std::string& address, const std::unordered_set<int64_t>& entityIds, bool isAllEntities);
+
+    void
+    removeEntityStateInterest(const std::string& address);
+
+    /** \brief Registers/unregisters a service that feeds entity messages into
+     * the store and forwards state notifications. */
+    void
+    addFeeder() { m_feederCount++; };
+
+    void
+    removeFeeder() { m_feederCount--; };
+
+    bool
+    isFed() const { return (m_feederCount.load() > 0); };
+
+private:
+
+    SharedEntityStore();
+
+    /** \brief Copy construction not permitted */
+    SharedEntityStore(SharedEntityStore const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(SharedEntityStore const&) = delete;
+
+    /** \brief Assigns the next version to <B><i>snapshot</i></B> and makes
+     * it current. Must be called with <B><i>m_writeMutex</i></B> held. */
+    void
+    publish(std::shared_ptr<Snapshot> snapshot);
+
+    std::shared_ptr<const Snapshot> m_snapshot;
+
+    /** \brief serializes writers and interest registration */
+    std::mutex m_writeMutex;
+
+    std::unordered_map<int64_t, std::unordered_set<std::string> > m_entityIdVsInterestedAddresses;
+    std::unordered_set<std::string> m_allEntitiesInterestedAddresses;
+    std::unordered_map<std::string, std::unordered_set<int64_t> > m_addressVsInterestEntityIds;
+
+    std::atomic<int32_t> m_feederCount{0};
+};
+
+template <typename T>
+const uint32_t SharedEntityStore::IdVsObject<T>::c_bitsPerLevel;
+
+template <typename T>
+const uint32_t SharedEntityStore::IdVsObject<T>::c_branchingFactor;
+
+}; //namespace task
+}; //namespace service
+}; //namespace uxas
+
+#endif /* UXAS_SERVICE_TASK_SHARED_ENTITY_STORE_H */
@@ -0,0 +1,215 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#include "TaskExecutionPool.h"
+
+#include "uxas/messages/uxnative/KillService.h"
+
+#include "Constants/UxAS_String.h"
+#include "UxAS_ConfigurationManager.h"
+#include "UxAS_Log.h"
+
+#include "stdUniquePtr.h"
+
+#include <algorithm>
+
+namespace uxas
+{
+namespace service
+{
+namespace task
+{
+
+TaskExecutionPool::TaskExecutionPool(uint32_t threadCount)
+: ServiceBase(TaskExecutionPool::s_typeName(), ""), m_threadCount(threadCount)
+{
+};
+
+TaskExecutionPool::~TaskExecutionPool()
+{
+    if (m_threadPool)
+    {
+        m_threadPool->shutdown();
+    }
+};
+
+bool
+TaskExecutionPool::hostService(std::unique_ptr<ServiceBase> service, const std::string& serviceXml)
+{
+    if (!service)
+    {
+        return (false);
+    }
+
+    service->setNetworkClientHost(this);
+    int64_t networkId = service->m_networkId;
+
+    pugi::xml_document xmlDoc;
+    bool isConfigured{false};
+    if (xmlDoc.load(serviceXml.c_str()))
+    {
+        isConfigured = service->configureService(uxas::common::ConfigurationManager::getInstance().getRootDataWorkDirectory(),
+                                                 xmlDoc.child(uxas::common::StringConstant::Service().c_str()));
+    }
+
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    if (!isConfigured)
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::hostService failed to configure ", service->m_serviceType, " service ID ", service->m_serviceId);
+        // discard the subscriptions staged during the failed configuration
+        m_pendingSubscriptionChanges.erase(std::remove_if(m_pendingSubscriptionChanges.begin(), m_pendingSubscriptionChanges.end(),
+                                                          [networkId](const SubscriptionChange& change) { return (change.m_networkId == networkId); }),
+                                           m_pendingSubscriptionChanges.end());
+        return (false);
+    }
+
+    UXAS_LOG_INFORM(s_typeName(), "::hostService configured ", service->m_serviceType, " service ID ", service->m_serviceId);
+    m_pendingServices.push_back(std::move(service));
+    return (true);
+};
+
+void
+TaskExecutionPool::addHostedSubscriptionAddress(uxas::communications::LmcpObjectNetworkClientBase* networkClient, const std::string& address)
+{
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    m_pendingSubscriptionChanges.push_back(SubscriptionChange{networkClient->m_networkId, address, true});
+};
+
+void
+TaskExecutionPool::removeHostedSubscriptionAddress(uxas::communications::LmcpObjectNetworkClientBase* networkClient, const std::string& address)
+{
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    m_pendingSubscriptionChanges.push_back(SubscriptionChange{networkClient->m_networkId, address, false});
+};
+
+bool
+TaskExecutionPool::configure(const pugi::xml_node& serviceXmlNode)
+{
+    // subscribed to by the base class; kept when hosted services unsubscribe
+    m_poolSubscriptionAddresses.insert(m_entityIdNetworkIdUnicastString);
+    m_poolSubscriptionAddresses.insert(s_entityServicesCastAllAddress);
+    m_poolSubscriptionAddresses.insert(uxas::messages::uxnative::KillService::Subscription);
+    return (true);
+};
+
+bool
+TaskExecutionPool::initialize()
+{
+    m_threadPool = uxas::stduxas::make_unique<uxas::common::ThreadPool>(m_threadCount);
+    m_dispatcher = uxas::stduxas::make_unique<HostedServiceDispatcher>(*m_threadPool);
+    UXAS_LOG_INFORM(s_typeName(), "::initialize started ", m_threadPool->getThreadCount(), " task execution threads");
+    return (true);
+};
+
+bool
+TaskExecutionPool::terminate()
+{
+    if (!m_dispatcher)
+    {
+        return (true);
+    }
+
+    m_dispatcher->requestAllTermination();
+
+    // executes the queued termination jobs
+    m_threadPool->shutdown();
+
+    size_t serviceCount = m_dispatcher->terminateRemainingServices();
+    UXAS_LOG_INFORM(s_typeName(), "::terminate terminated ", serviceCount, " hosted services");
+    return (true);
+};
+
+bool
+TaskExecutionPool::processReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage)
+{
+    m_dispatcher->dispatch(std::move(receivedLmcpMessage));
+    return (false);
+};
+
+void
+TaskExecutionPool::processPendingWork()
+{
+    std::vector<std::unique_ptr<ServiceBase> > pendingServices;
+    std::vector<SubscriptionChange> pendingSubscriptionChanges;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        pendingServices.swap(m_pendingServices);
+        pendingSubscriptionChanges.swap(m_pendingSubscriptionChanges);
+    }
+
+    // register new services before applying the subscriptions staged during their configuration
+    std::vector<int64_t> newNetworkIds;
+    for (auto& service : pendingServices)
+    {
+        int64_t networkId = service->m_networkId;
+        if (m_dispatcher->addService(std::move(service)))
+        {
+            newNetworkIds.push_back(networkId);
+        }
+    }
+
+    for (auto& subscriptionChange : pendingSubscriptionChanges)
+    {
+        if (subscriptionChange.m_isAdd)
+        {
+            if (m_dispatcher->addAddress(subscriptionChange.m_networkId, subscriptionChange.m_address))
+            {
+                addPoolAddress(subscriptionChange.m_address);
+            }
+        }
+        else if (m_dispatcher->removeAddress(subscriptionChange.m_networkId, subscriptionChange.m_address))
+        {
+            removePoolAddress(subscriptionChange.m_address);
+        }
+    }
+
+    // subscriptions are in place, so messages sent in response to start are received
+    for (auto networkId : newNetworkIds)
+    {
+        ServiceBase* service = m_dispatcher->getService(networkId);
+        if (service->initializeAndStartService())
+        {
+            UXAS_LOG_INFORM(s_typeName(), "::processPendingWork started ", service->m_serviceType,
+                            " service ID ", service->m_serviceId);
+        }
+        else
+        {
+            UXAS_LOG_ERROR(s_typeName(), "::processPendingWork failed to start ", service->m_serviceType,
+                           " service ID ", service->m_serviceId);
+            m_dispatcher->discardService(networkId);
+        }
+    }
+
+    for (auto& address : m_dispatcher->removeTerminatedServices())
+    {
+        removePoolAddress(address);
+    }
+};
+
+void
+TaskExecutionPool::addPoolAddress(const std::string& address)
+{
+    if (m_poolSubscriptionAddresses.find(address) == m_poolSubscriptionAddresses.end())
+    {
+        addSubscriptionAddress(address);
+    }
+};
+
+void
+TaskExecutionPool::removePoolAddress(const std::string& address)
+{
+    if (m_poolSubscriptionAddresses.find(address) == m_poolSubscriptionAddresses.end())
+    {
+        removeSubscriptionAddress(address);
+    }
+};
+
+}; //namespace task
+}; //namespace service
+}; //namespace uxas
@@ -0,0 +1,159 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_SERVICE_TASK_TASK_EXECUTION_POOL_H
+#define UXAS_SERVICE_TASK_TASK_EXECUTION_POOL_H
+
+#include "ServiceBase.h"
+#include "HostedServiceDispatcher.h"
+#include "LmcpObjectNetworkClientHost.h"
+#include "UxAS_ThreadPool.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace uxas
+{
+namespace service
+{
+namespace task
+{
+
+/** \class TaskExecutionPool
+ * 
+ * \par Description:
+ * Hosts many task services on a fixed number of worker threads. The pool has 
+ * one receiver (this service's thread), subscribed to the union of the 
+ * addresses of the hosted tasks, and dispatches each received message with a 
+ * <B><i>HostedServiceDispatcher</i></B>: by address prefix to the tasks 
+ * subscribed to it, each task receiving its own copy of the object. Each 
+ * hosted task processes its messages in order and never concurrently (a 
+ * strand on the worker pool), so task code is unchanged. Hosted tasks keep 
+ * their own service IDs and send through their own sender pipes, so each 
+ * hosted task still opens one sending socket unless the in-process message 
+ * bus is enabled; only the receiving sockets and threads are shared.
+ * 
+ * \par Termination:
+ * <B><i>KillService</i></B> messages addressed to a hosted task are handled by 
+ * the pool (the task is terminated on its strand and unsubscribed). 
+ * Terminating the pool terminates all hosted tasks.
+ * 
+ * \par Threading:
+ * <B><i>hostService</i></B>, <B><i>requestTermination</i></B> and the 
+ * <B><i>LmcpObjectNetworkClientHost</i></B> methods can be called from any 
+ * thread; subscription changes are applied by the pool thread.
+ * 
+ * \n
+ */
+class TaskExecutionPool : public ServiceBase, public uxas::communications::LmcpObjectNetworkClientHost
+{
+public:
+
+    static const std::string&
+    s_typeName() { static std::string s_string("TaskExecutionPool"); return (s_string); };
+
+    /** \brief Constructs the pool.
+     * 
+     * @param threadCount number of worker threads; 0 selects the number of 
+     * hardware threads
+     */
+    TaskExecutionPool(uint32_t threadCount);
+
+    virtual
+    ~TaskExecutionPool();
+
+private:
+
+    /** \brief Copy construction not permitted */
+    TaskExecutionPool(TaskExecutionPool const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(TaskExecutionPool const&) = delete;
+
+public:
+
+    /** \brief Configures <B><i>service</i></B> (on the calling thread) and 
+     * queues it for initialization and start on the pool.
+     * 
+     * @param service instantiated, not yet configured service
+     * @param serviceXml service configuration (<B><i>Service</i></B> node)
+     * @return true if configuration succeeds
+     */
+    bool
+    hostService(std::unique_ptr<ServiceBase> service, const std::string& serviceXml);
+
+    /** \brief Starts termination of the pool and of all hosted services; 
+     * completion is reported by <B><i>getIsTerminationFinished</i></B>. */
+    void
+    requestTermination() { m_isTerminateNetworkClient = true; };
+
+    void
+    addHostedSubscriptionAddress(uxas::communications::LmcpObjectNetworkClientBase* networkClient, const std::string& address) override;
+
+    void
+    removeHostedSubscriptionAddress(uxas::communications::LmcpObjectNetworkClientBase* networkClient, const std::string& address) override;
+
+private:
+
+    class SubscriptionChange
+    {
+    public:
+        int64_t m_networkId;
+        std::string m_address;
+        bool m_isAdd;
+    };
+
+    bool
+    configure(const pugi::xml_node& serviceXmlNode) override;
+
+    bool
+    initialize() override;
+
+    bool
+    terminate() override;
+
+    bool
+    processReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage) override;
+
+    /** \brief Starts newly hosted services, applies subscription changes and 
+     * removes terminated services (pool thread). */
+    void
+    processPendingWork() override;
+
+    /** \brief Subscribes the pool to <B><i>address</i></B> unless it is one 
+     * of its own addresses. */
+    void
+    addPoolAddress(const std::string& address);
+
+    void
+    removePoolAddress(const std::string& address);
+
+    std::unique_ptr<uxas::common::ThreadPool> m_threadPool;
+    uint32_t m_threadCount{0};
+
+    /** \brief protects the pending services and subscription changes */
+    std::mutex m_pendingMutex;
+    std::vector<std::unique_ptr<ServiceBase> > m_pendingServices;
+    std::vector<SubscriptionChange> m_pendingSubscriptionChanges;
+
+    // pool thread only
+    std::unique_ptr<HostedServiceDispatcher> m_dispatcher;
+    /** \brief addresses this pool subscribes to for itself (never unsubscribed) */
+    std::set<std::string> m_poolSubscriptionAddresses;
+};
+
+}; //namespace task
+}; //namespace service
+}; //namespace uxas
+
+#endif /* UXAS_SERVICE_TASK_TASK_EXECUTION_POOL_H */
@@ -16,7 +16,10 @@
 
 
 #include "TaskManagerService.h"
+#include "TaskExecutionPool.h"
 #include "TaskServiceBase.h"
+#include "SharedEntityStore.h"
+#include "SerializedLmcpObject.h"
 
 
 #include "afrl/cmasi/EntityConfiguration.h"
@@ -57,6 +60,8 @@
 #define STRING_XML_OPTION "Option"
 #define STRING_XML_OPTIONNAME "OptionName"
 #define STRING_XML_VALUE "Value"
+#define STRING_XML_USE_TASK_EXECUTION_POOL "UseTaskExecutionPool"
+#define STRING_XML_TASK_EXECUTION_THREAD_COUNT "TaskExecutionThreadCount"
 
 #define COUT_INFO_MSG(MESSAGE) std::cout << "<>TaskManager::" << MESSAGE << std::endl;std::cout.flush();
 #define COUT_FILE_LINE_MSG(MESSAGE) std::cout << "<>TaskManager::" << __FILE__ << ":" << __LINE__ << ":" << MESSAGE << std::endl;std::cout.flush();
@@ -69,6 +74,24 @@ namespace service
 {
 namespace task
 {
+
+namespace
+{
+
+/** \brief moves the (owned) objects of a <B><i>CreateNewService</i></B> list into shared pointers */
+template <typename T>
+void
+moveConfigurationObjects(std::vector<T*>& objects, std::vector<std::shared_ptr<avtas::lmcp::Object> >& configurationObjects)
+{
+    for (auto object : objects)
+    {
+        configurationObjects.push_back(std::shared_ptr<avtas::lmcp::Object>(object));
+    }
+    objects.clear();
+}
+
+} //namespace
+
 TaskManagerService::ServiceBase::CreationRegistrar<TaskManagerService>
 TaskManagerService::s_registrar(TaskManagerService::s_registryServiceTypeNames());
 
@@ -77,7 +100,13 @@ TaskManagerService::TaskManagerService()
 {
 }
 
-TaskManagerService::~TaskManagerService() { };
+TaskManagerService::~TaskManagerService()
+{
+    if (m_isFeedingSharedEntityStore)
+    {
+        SharedEntityStore::getInstance().removeFeeder();
+    }
+};
 
 bool
 TaskManagerService::configure(const pugi::xml_node& ndComponent)
@@ -89,6 +118,17 @@ TaskManagerService::configure(const pugi::xml_node& ndComponent)
     std::string strComponentType = ndComponent.attribute(STRING_XML_TYPE).value();
     //assert(strComponentType==STRING_XML_COMPONENT_TYPE)
 
+    if (ndComponent.attribute(STRING_XML_USE_TASK_EXECUTION_POOL).as_bool(false))
+    {
+        uint32_t threadCount = ndComponent.attribute(STRING_XML_TASK_EXECUTION_THREAD_COUNT).as_uint(0);
+        m_taskExecutionPool = uxas::stduxas::make_unique<TaskExecutionPool>(threadCount);
+        if (!m_taskExecutionPool->configureService(strBasePath, pugi::xml_node()))
+        {
+            UXAS_LOG_ERROR(s_typeName(), "::configure failed to configure the task execution pool; tasks run as separate services");
+            m_taskExecutionPool.reset();
+        }
+    }
+
     for (pugi::xml_node ndCurrent = ndComponent.first_child(); ndCurrent; ndCurrent = ndCurrent.next_sibling())
     {
         if (std::string(STRING_XML_TASKOPTIONS) == ndCurrent.name())
@@ -165,9 +205,65 @@ TaskManagerService::configure(const pugi::xml_node& ndComponent)
     addSubscriptionAddress(afrl::cmasi::KeepOutZone::Subscription);
     addSubscriptionAddress(afrl::cmasi::OperatingRegion::Subscription);
 
+    // entity configurations, states and zones are shared with the tasks 
+    // through the shared entity store
+    if (!m_isFeedingSharedEntityStore)
+    {
+        SharedEntityStore::getInstance().addFeeder();
+        m_isFeedingSharedEntityStore = true;
+    }
+
     return true;
 }
 
+bool
+TaskManagerService::initialize()
+{
+    if (m_taskExecutionPool && !m_taskExecutionPool->initializeAndStartService())
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::initialize failed to start the task execution pool; tasks run as separate services");
+        m_taskExecutionPool.reset();
+    }
+    return (true);
+}
+
+bool
+TaskManagerService::terminate()
+{
+    if (m_taskExecutionPool)
+    {
+        m_taskExecutionPool->requestTermination();
+        return (m_taskExecutionPool->getIsTerminationFinished());
+    }
+    return (true);
+}
+
+bool
+TaskManagerService::hostTaskService(const std::shared_ptr<afrl::cmasi::Task>& task, const std::string& xmlTaskOptions,
+                                    uxas::messages::uxnative::CreateNewService& createNewService, int64_t& serviceId)
+{
+    std::unique_ptr<ServiceBase> service = ServiceBase::instantiateService(task->getFullLmcpTypeName());
+    auto taskService = dynamic_cast<TaskServiceBase*>(service.get());
+    if (!taskService)
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::hostTaskService failed to instantiate a task service of type ", task->getFullLmcpTypeName());
+        return (false);
+    }
+
+    // typed objects instead of XML; the configuration only carries the task options
+    std::vector<std::shared_ptr<avtas::lmcp::Object> > configurationObjects;
+    moveConfigurationObjects(createNewService.getOperatingRegions(), configurationObjects);
+    moveConfigurationObjects(createNewService.getAreas(), configurationObjects);
+    moveConfigurationObjects(createNewService.getLines(), configurationObjects);
+    moveConfigurationObjects(createNewService.getPoints(), configurationObjects);
+    moveConfigurationObjects(createNewService.getMissionCommands(), configurationObjects);
+    taskService->setTaskAndConfigurationObjects(std::shared_ptr<afrl::cmasi::Task>(task->clone()), std::move(configurationObjects));
+
+    serviceId = service->m_networkId;
+    std::string xmlConfigStr = "<Service Type=\"" + task->getFullLmcpTypeName() + "\">" + xmlTaskOptions + "</Service>";
+    return (m_taskExecutionPool->hostService(std::move(service), xmlConfigStr));
+}
+
 bool
 TaskManagerService::processReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage)
 //example: if (afrl::cmasi::isServiceStatus(receivedLmcpObject))
@@ -250,35 +346,22 @@ TaskManagerService::processReceivedLmcpMessage(std::unique_ptr<uxas::communicati
             //COUT_INFO_MSG("INFO:: TaskId[" << taskId << "] xmlTaskOptions[" << xmlTaskOptions << "]")
         }
 
+        // with the task execution pool, the message only collects the objects the task requires
         auto createNewServiceMessage = std::make_shared<uxas::messages::uxnative::CreateNewService>();
-        auto serviceId = ServiceBase::getUniqueServceId();
-        createNewServiceMessage->setServiceID(serviceId);
-        std::string xmlConfigStr = "<Service Type=\"" + baseTask->getFullLmcpTypeName() + "\">" +
-                " <TaskRequest>" + baseTask->toXML() + "</TaskRequest>\n" + xmlTaskOptions;
-        uxas::common::StringUtil::ReplaceAll(xmlConfigStr, "<", "&lt;");
-        uxas::common::StringUtil::ReplaceAll(xmlConfigStr, ">", "&gt;");
-        createNewServiceMessage->setXmlConfiguration(xmlConfigStr);
-
-        // add all existing entities for new service initialization
-        for (auto& entityConfiguration : m_idVsEntityConfiguration)
+        int64_t serviceId{0};
+        if (!m_taskExecutionPool)
         {
-            createNewServiceMessage->getEntityConfigurations().push_back(entityConfiguration.second->clone());
-        }
-        
-        // add all existing entities for new service initialization
-        for (auto& entityState : m_idVsEntityState)
-        {
-            createNewServiceMessage->getEntityStates().push_back(entityState.second->clone());
+            serviceId = ServiceBase::getUniqueServceId();
+            createNewServiceMessage->setServiceID(serviceId);
+            std::string xmlConfigStr = "<Service Type=\"" + baseTask->getFullLmcpTypeName() + "\">" +
+                    " <TaskRequest>" + baseTask->toXML() + "</TaskRequest>\n" + xmlTaskOptions;
+            uxas::common::StringUtil::ReplaceAll(xmlConfigStr, "<", "&lt;");
+            uxas::common::StringUtil::ReplaceAll(xmlConfigStr, ">", "&gt;");
+            createNewServiceMessage->setXmlConfiguration(xmlConfigStr);
         }
 
-        for (auto kiz : m_idVsKeepInZone)
-        {
-          createNewServiceMessage->getKeepInZones().push_back(kiz.second->clone());
-        }
-        for (auto koz : m_idVsKeepOutZone)
-        {
-          createNewServiceMessage->getKeepOutZones().push_back(koz.second->clone());
-        }
+        // existing entity configurations, entity states and keep-in/keep-out 
+        // zones are read by the new task from the shared entity store
         for (auto opr : m_idVsOperatingRegion)
         {
           createNewServiceMessage->getOperatingRegions().push_back(opr .second->clone());
@@ -365,7 +448,14 @@ TaskManagerService::processReceivedLmcpMessage(std::unique_ptr<uxas::communicati
             }
         }
 
-        if (isGoodTask)
+        if (isGoodTask && m_taskExecutionPool)
+        {
+            if (hostTaskService(baseTask, xmlTaskOptions, *createNewServiceMessage, serviceId))
+            {
+                m_TaskIdVsServiceId[taskId] = serviceId;
+            }
+        }
+        else if (isGoodTask)
         {
             m_TaskIdVsServiceId[taskId] = serviceId;
             auto newServiceMessage = std::static_pointer_cast<avtas::lmcp::Object>(createNewServiceMessage);
@@ -375,11 +465,21 @@ TaskManagerService::processReceivedLmcpMessage(std::unique_ptr<uxas::communicati
     }
     else if (entityConfiguration)
     {
-        m_idVsEntityConfiguration[entityConfiguration->getID()] = entityConfiguration;
+        SharedEntityStore::getInstance().setEntityConfiguration(entityConfiguration);
     }
     else if (entityState)
     {
-        m_idVsEntityState[entityState->getID()] = entityState;
+        // forward the state only to the tasks that need it (e.g. assigned vehicles),
+        // serialized once for all of them
+        if (SharedEntityStore::getInstance().setEntityState(entityState, m_entityStateNotifyAddresses)
+                && !m_entityStateNotifyAddresses.empty())
+        {
+            uxas::communications::data::SerializedLmcpObject serializedEntityState(messageObject);
+            for (auto& address : m_entityStateNotifyAddresses)
+            {
+                sendSharedSerializedLmcpObjectLimitedCastMessage(address, serializedEntityState);
+            }
+        }
     }
     else if (afrl::impact::isAreaOfInterest(messageObject.get()))
     {
@@ -422,12 +522,12 @@ TaskManagerService::processReceivedLmcpMessage(std::unique_ptr<uxas::communicati
     else if (afrl::cmasi::isKeepInZone(messageObject.get()))
     {
         auto kiz = std::static_pointer_cast<afrl::cmasi::KeepInZone>(messageObject);
-        m_idVsKeepInZone[kiz->getZoneID()] = kiz;
+        SharedEntityStore::getInstance().setKeepInZone(kiz);
     }
     else if (afrl::cmasi::isKeepOutZone(messageObject.get()))
     {
         auto koz = std::static_pointer_cast<afrl::cmasi::KeepOutZone>(messageObject);
-        m_idVsKeepOutZone[koz->getZoneID()] = koz;
+        SharedEntityStore::getInstance().setKeepOutZone(koz);
     }
     else if (afrl::cmasi::isOperatingRegion(messageObject.get()))
     {
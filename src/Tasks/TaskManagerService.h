@@ -28,6 +28,9 @@
 #include "afrl/cmasi/KeepInZone.h"
 #include "afrl/cmasi/KeepOutZone.h"
 #include "afrl/cmasi/OperatingRegion.h"
+#include "afrl/cmasi/Task.h"
+#include "uxas/messages/uxnative/CreateNewService.h"
+#include <memory>
 #include <set>
 #include <cstdint> // int64_t
 
@@ -39,6 +42,8 @@ namespace service
 namespace task
 {
 
+class TaskExecutionPool;
+
 /*! \class TaskManagerService
     \brief A service that constructs/destroys tasks.
 
@@ -50,6 +55,14 @@ namespace task
  * 
  * Options:
  *  - TaskOptions entries provide options to tasks
+ *  - UseTaskExecutionPool - if true, tasks are constructed directly from the 
+ *    task objects and hosted by a <B><i>TaskExecutionPool</i></B> (shared 
+ *    receiver and worker threads; each task still opens its own sending 
+ *    socket unless the in-process message bus is enabled); if false 
+ *    (default), each task is created as a separate service (own thread and 
+ *    sockets) through a <B><i>CreateNewService</i></B> message
+ *  - TaskExecutionThreadCount - number of threads executing the hosted tasks
+ *    (default 0: one per hardware thread)
  * 
  * Subscribed Messages:
  *  - afrl::cmasi::RemoveTasks
@@ -66,9 +79,14 @@ namespace task
  *  - afrl::cmasi::FollowPathCommand
  *  - ALL TASKS
  * 
+ * Entity configurations, entity states and keep-in/keep-out zones are stored
+ * in the SharedEntityStore, which the task services read instead of keeping
+ * their own copies.
+ * 
  * Sent Messages:
+ *  - afrl::cmasi::EntityState (limited-cast to the task services interested in the entity)
  *  - uxas::messages::uxnative::KillService
- *  - uxas::messages::uxnative::CreateNewService
+ *  - uxas::messages::uxnative::CreateNewService (task execution pool not used)
  *  - afrl::cmasi::AutomationRequest
  *  - uxas::messages::task::UniqueAutomationRequest
  * 
@@ -121,14 +139,14 @@ private:
     bool
     configure(const pugi::xml_node& serviceXmlNode) override;
 
-    //bool
-    //initialize() override;
+    bool
+    initialize() override;
 
     //bool
     //start() override;
 
-    //bool
-    //terminate() override;
+    bool
+    terminate() override;
 
     bool
     processReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage) override;
@@ -137,14 +155,23 @@ public:
     static std::string GetTaskStringIdFromId(const int64_t& taskId);
 
 private:
-    std::unordered_map<int64_t, std::shared_ptr<afrl::cmasi::EntityConfiguration> > m_idVsEntityConfiguration;
-    std::unordered_map<int64_t, std::shared_ptr<afrl::cmasi::EntityState> > m_idVsEntityState;
+    /*! \brief constructs the task service directly from the task object and hosts it 
+     * in the task execution pool. The objects collected in 'createNewService' are 
+     * passed to the task (and removed from the message). */
+    bool hostTaskService(const std::shared_ptr<afrl::cmasi::Task>& task, const std::string& xmlTaskOptions,
+                         uxas::messages::uxnative::CreateNewService& createNewService, int64_t& serviceId);
+
+private:
+    /*! \brief hosts the task services; empty if tasks run as separate services */
+    std::unique_ptr<TaskExecutionPool> m_taskExecutionPool;
+    /*! \brief true once this service feeds the <B><i>SharedEntityStore</i></B> */
+    bool m_isFeedingSharedEntityStore{false};
+    /*! \brief task service addresses to forward the current entity state to (reused buffer) */
+    std::vector<std::string> m_entityStateNotifyAddresses;
     std::unordered_map<int64_t, std::shared_ptr<afrl::impact::AreaOfInterest> > m_idVsAreaOfInterest;
     std::unordered_map<int64_t, std::shared_ptr<afrl::impact::LineOfInterest> > m_idVsLineOfInterest;
     std::unordered_map<int64_t, std::shared_ptr<afrl::impact::PointOfInterest> > m_idVsPointOfInterest;
     std::unordered_map<int64_t, std::shared_ptr<afrl::cmasi::MissionCommand> > m_vehicleIdVsCurrentMission;
-    std::unordered_map<int64_t, std::shared_ptr<afrl::cmasi::KeepInZone> > m_idVsKeepInZone;
-    std::unordered_map<int64_t, std::shared_ptr<afrl::cmasi::KeepOutZone> > m_idVsKeepOutZone;
     std::unordered_map<int64_t, std::shared_ptr<afrl::cmasi::OperatingRegion> > m_idVsOperatingRegion;
     /*! \brief container for managing task options read in from the XML configuration file.
      *  If there is no TaskId, then 0 is used. If there is no TaskType, then the string "NoTaskType" is used.
@@ -93,7 +93,10 @@ bool TaskServiceBase::configure(const pugi::xml_node& serviceXmlNode)
         m_workDirectoryPath = "./";
     }
 
-    m_task = generateTaskObject(serviceXmlNode);
+    if (!m_task)
+    {
+        m_task = generateTaskObject(serviceXmlNode);
+    }
     if (!m_task)
     {
         std::stringstream sstrErrors;
@@ -117,78 +120,20 @@ bool TaskServiceBase::configure(const pugi::xml_node& serviceXmlNode)
 
         std::stringstream stringStream;
         currentXmlNode.print(stringStream);
-        avtas::lmcp::Object* object = avtas::lmcp::xml::readXML(stringStream.str());
-        if (object == nullptr)
-            continue;
-
-        if (dynamic_cast<afrl::cmasi::EntityConfiguration*> (object))
-        {
-            std::shared_ptr<afrl::cmasi::EntityConfiguration> entityConfiguration;
-            entityConfiguration.reset(static_cast<afrl::cmasi::EntityConfiguration*> (object->clone()));
-            auto foundEntity = std::find(m_task->getEligibleEntities().begin(), m_task->getEligibleEntities().end(), entityConfiguration->getID());
-            if (m_task->getEligibleEntities().empty() || foundEntity != m_task->getEligibleEntities().end())
-            {
-                m_entityConfigurations.insert(std::make_pair(entityConfiguration->getID(), entityConfiguration));
-                auto nominalSpeedToOneDecimalPlace_mps = std::round(entityConfiguration->getNominalSpeed()*10.0) / 10.0;
-                auto nominalAltitudeRounded = std::round(entityConfiguration->getNominalAltitude());
-                auto targetEntityIds = m_speedAltitudeVsEligibleEntityIds[std::make_pair(nominalSpeedToOneDecimalPlace_mps, nominalAltitudeRounded)];
-                if (std::find(targetEntityIds.begin(), targetEntityIds.end(), entityConfiguration->getID()) == targetEntityIds.end())
-                {
-                    m_speedAltitudeVsEligibleEntityIds[std::make_pair(nominalSpeedToOneDecimalPlace_mps, nominalAltitudeRounded)].push_back(entityConfiguration->getID());
-                }
-            }
-        }
-        else if (dynamic_cast<afrl::cmasi::EntityState*> (object))
-        {
-            std::shared_ptr<afrl::cmasi::EntityState> entityState;
-            entityState.reset(static_cast<afrl::cmasi::EntityState*> (object->clone()));
-            m_entityStates[entityState->getID()] = entityState;
-        }
-        else if (afrl::cmasi::isMissionCommand(object))
-        {
-            std::shared_ptr<afrl::cmasi::MissionCommand> missionCommand;
-            missionCommand.reset(static_cast<afrl::cmasi::MissionCommand*> (object->clone()));
-            m_currentMissions[missionCommand->getVehicleID()] = missionCommand;
-        }
-        else if (afrl::impact::isAreaOfInterest(object))
-        {
-            std::shared_ptr<afrl::impact::AreaOfInterest> areaOfInterest;
-            areaOfInterest.reset(static_cast<afrl::impact::AreaOfInterest*> (object->clone()));
-            m_areasOfInterest[areaOfInterest->getAreaID()] = areaOfInterest;
-        }
-        else if (afrl::impact::isLineOfInterest(object))
-        {
-            std::shared_ptr<afrl::impact::LineOfInterest> lineOfInterest;
-            lineOfInterest.reset(static_cast<afrl::impact::LineOfInterest*> (object->clone()));
-            m_linesOfInterest[lineOfInterest->getLineID()] = lineOfInterest;
-        }
-        else if (afrl::impact::isPointOfInterest(object))
-        {
-            std::shared_ptr<afrl::impact::PointOfInterest> pointOfInterest;
-            pointOfInterest.reset(static_cast<afrl::impact::PointOfInterest*> (object->clone()));
-            m_pointsOfInterest[pointOfInterest->getPointID()] = pointOfInterest;
-        }
-        else if (afrl::cmasi::isKeepInZone(object))
-        {
-            std::shared_ptr<afrl::cmasi::KeepInZone> kiz;
-            kiz.reset(static_cast<afrl::cmasi::KeepInZone*>(object->clone()));
-            m_keepInZones[kiz->getZoneID()] = kiz;
-        }
-        else if (afrl::cmasi::isKeepOutZone(object))
+        std::shared_ptr<avtas::lmcp::Object> object(avtas::lmcp::xml::readXML(stringStream.str()));
+        if (object)
         {
-            std::shared_ptr<afrl::cmasi::KeepOutZone> koz;
-            koz.reset(static_cast<afrl::cmasi::KeepOutZone*>(object->clone()));
-            m_keepOutZones[koz->getZoneID()] = koz;
+            addConfigurationObject(object);
         }
-        else if (afrl::cmasi::isOperatingRegion(object))
-        {
-            std::shared_ptr<afrl::cmasi::OperatingRegion> opr;
-            opr.reset(static_cast<afrl::cmasi::OperatingRegion*>(object->clone()));
-            m_OperatingRegions[opr->getID()] = opr;
-        }
-        delete object;
     }
 
+    // objects supplied directly (see setTaskAndConfigurationObjects)
+    for (auto& object : m_configurationObjects)
+    {
+        addConfigurationObject(object);
+    }
+    m_configurationObjects.clear();
+
     // set a (likely) unique ID from the task ID
     m_uniqueRouteRequestId = (rand() << 16) + m_task->getTaskID();
     if (m_uniqueRouteRequestId < 0)
@@ -201,10 +146,23 @@ bool TaskServiceBase::configure(const pugi::xml_node& serviceXmlNode)
         addSubscriptionAddress(child);
 
     // ENTITY STATES
-    addSubscriptionAddress(afrl::cmasi::EntityState::Subscription);
-    std::vector< std::string > childstates = afrl::cmasi::EntityStateDescendants();
-    for (auto child : childstates)
-        addSubscriptionAddress(child);
+    // normally forwarded, only for the entities of interest, by the service 
+    // feeding the shared entity store
+    m_isFeedingSharedEntityStore = !SharedEntityStore::getInstance().isFed();
+    if (m_isFeedingSharedEntityStore)
+    {
+        addSubscriptionAddress(afrl::cmasi::EntityState::Subscription);
+        std::vector< std::string > childstates = afrl::cmasi::EntityStateDescendants();
+        for (auto child : childstates)
+            addSubscriptionAddress(child);
+    }
+
+    // entity configurations received before this task was created
+    refreshSharedEntityViews();
+    for (auto& entityConfiguration : m_entityConfigurations)
+    {
+        addEligibleEntityConfiguration(entityConfiguration.second);
+    }
 
     addSubscriptionAddress(uxas::messages::task::UniqueAutomationRequest::Subscription);
     addSubscriptionAddress(uxas::messages::task::UniqueAutomationResponse::Subscription);
@@ -241,6 +199,7 @@ bool TaskServiceBase::start()
 
 bool TaskServiceBase::terminate()
 {
+    SharedEntityStore::getInstance().removeEntityStateInterest(m_entityIdNetworkIdUnicastString);
     bool isKillTheService(true);
     isKillTheService = terminateTask();
     return (isKillTheService);
@@ -253,9 +212,20 @@ bool TaskServiceBase::processReceivedLmcpMessage(std::unique_ptr<uxas::communica
     auto entityState = std::dynamic_pointer_cast<afrl::cmasi::EntityState>(receivedLmcpMessage->m_object);
     auto entityConfiguration = std::dynamic_pointer_cast<afrl::cmasi::EntityConfiguration>(receivedLmcpMessage->m_object);
 
+    if (entityState && m_isFeedingSharedEntityStore)
+    {
+        std::vector<std::string> notifyAddresses;
+        SharedEntityStore::getInstance().setEntityState(entityState, notifyAddresses);
+    }
+    else if (entityConfiguration)
+    {
+        // store before refreshing, so the views include the configuration
+        SharedEntityStore::getInstance().setEntityConfiguration(entityConfiguration);
+    }
+    refreshSharedEntityViews();
+
     if (entityState)
     {
-        m_entityStates[entityState->getID()] = entityState;
         if (m_assignedVehicleIds.find(entityState->getID()) != m_assignedVehicleIds.end())
         {
             bool isOnTask = std::find(entityState->getAssociatedTasks().begin(),
@@ -307,18 +277,7 @@ bool TaskServiceBase::processReceivedLmcpMessage(std::unique_ptr<uxas::communica
     }
     else if (entityConfiguration)
     {
-        auto foundEntity = std::find(m_task->getEligibleEntities().begin(), m_task->getEligibleEntities().end(), entityConfiguration->getID());
-        if (m_task->getEligibleEntities().empty() || foundEntity != m_task->getEligibleEntities().end())
-        {
-            m_entityConfigurations.insert(std::make_pair(entityConfiguration->getID(), entityConfiguration));
-            auto nominalSpeedToOneDecimalPlace_mps = std::round(entityConfiguration->getNominalSpeed()*10.0) / 10.0;
-            auto nominalAltitudeRounded = std::round(entityConfiguration->getNominalAltitude());
-            auto targetEntityIds = m_speedAltitudeVsEligibleEntityIds[std::make_pair(nominalSpeedToOneDecimalPlace_mps, nominalAltitudeRounded)];
-            if (std::find(targetEntityIds.begin(), targetEntityIds.end(), entityConfiguration->getID()) == targetEntityIds.end())
-            {
-                m_speedAltitudeVsEligibleEntityIds[std::make_pair(nominalSpeedToOneDecimalPlace_mps, nominalAltitudeRounded)].push_back(entityConfiguration->getID());
-            }
-        }
+        addEligibleEntityConfiguration(entityConfiguration);
     }
     else if (uxas::messages::task::isUniqueAutomationRequest(receivedLmcpMessage->m_object))
     {
@@ -592,6 +551,7 @@ bool TaskServiceBase::processReceivedLmcpMessage(std::unique_ptr<uxas::communica
                 }
             }
             m_idVsUniqueAutomationRequest.erase(uniqueAutomationResponse->getResponseID());
+            updateEntityStateInterest();
         }
     }
     else if (uxas::messages::task::isTaskImplementationRequest(receivedLmcpMessage->m_object))
@@ -655,6 +615,57 @@ bool TaskServiceBase::processReceivedLmcpMessage(std::unique_ptr<uxas::communica
     return (isKillService);
 };
 
+void TaskServiceBase::addEntityStateInterest(const int64_t& entityId)
+{
+    m_entityStateInterestIds.insert(entityId);
+    updateEntityStateInterest();
+}
+
+void TaskServiceBase::addAllEntityStatesInterest()
+{
+    m_isAllEntityStatesInterest = true;
+    updateEntityStateInterest();
+}
+
+void TaskServiceBase::addEligibleEntityConfiguration(const std::shared_ptr<afrl::cmasi::EntityConfiguration>& entityConfiguration)
+{
+    auto foundEntity = std::find(m_task->getEligibleEntities().begin(), m_task->getEligibleEntities().end(), entityConfiguration->getID());
+    if (m_task->getEligibleEntities().empty() || foundEntity != m_task->getEligibleEntities().end())
+    {
+        auto nominalSpeedToOneDecimalPlace_mps = std::round(entityConfiguration->getNominalSpeed()*10.0) / 10.0;
+        auto nominalAltitudeRounded = std::round(entityConfiguration->getNominalAltitude());
+        auto& targetEntityIds = m_speedAltitudeVsEligibleEntityIds[std::make_pair(nominalSpeedToOneDecimalPlace_mps, nominalAltitudeRounded)];
+        if (std::find(targetEntityIds.begin(), targetEntityIds.end(), entityConfiguration->getID()) == targetEntityIds.end())
+        {
+            targetEntityIds.push_back(entityConfiguration->getID());
+        }
+    }
+}
+
+void TaskServiceBase::refreshSharedEntityViews()
+{
+    auto snapshot = SharedEntityStore::getInstance().getSnapshot();
+    if (snapshot->m_version != m_sharedEntityStoreVersion)
+    {
+        m_entityConfigurations.reset(snapshot->m_entityConfigurations);
+        m_entityStates.reset(snapshot->m_entityStates);
+        m_keepInZones.reset(snapshot->m_keepInZones);
+        m_keepOutZones.reset(snapshot->m_keepOutZones);
+        m_sharedEntityStoreVersion = snapshot->m_version;
+    }
+}
+
+void TaskServiceBase::updateEntityStateInterest()
+{
+    // tasks that subscribe to all entity states do not need forwarded ones
+    if (!m_isFeedingSharedEntityStore)
+    {
+        std::unordered_set<int64_t> entityIds(m_entityStateInterestIds);
+        entityIds.insert(m_assignedVehicleIds.begin(), m_assignedVehicleIds.end());
+        SharedEntityStore::getInstance().setEntityStateInterest(m_entityIdNetworkIdUnicastString, entityIds, m_isAllEntityStatesInterest);
+    }
+}
+
 int64_t TaskServiceBase::getOptionRouteId(const int64_t& OptionId)
 {
     m_routeType[m_uniqueRouteRequestId] = RouteTypeEnum::OPTION;
@@ -1035,6 +1046,63 @@ void TaskServiceBase::processImplementationRoutePlanResponseBase(const std::shar
     }
 }
 
+void TaskServiceBase::setTaskAndConfigurationObjects(const std::shared_ptr<afrl::cmasi::Task>& task,
+        std::vector<std::shared_ptr<avtas::lmcp::Object> > configurationObjects)
+{
+    m_task = task;
+    m_configurationObjects = std::move(configurationObjects);
+}
+
+void TaskServiceBase::addConfigurationObject(const std::shared_ptr<avtas::lmcp::Object>& object)
+{
+    // entity configurations/states include descendant types (e.g. AirVehicleState)
+    auto entityConfiguration = std::dynamic_pointer_cast<afrl::cmasi::EntityConfiguration>(object);
+    auto entityState = std::dynamic_pointer_cast<afrl::cmasi::EntityState>(object);
+    if (entityConfiguration)
+    {
+        SharedEntityStore::getInstance().setEntityConfiguration(entityConfiguration);
+        addEligibleEntityConfiguration(entityConfiguration);
+    }
+    else if (entityState)
+    {
+        std::vector<std::string> notifyAddresses;
+        SharedEntityStore::getInstance().setEntityState(entityState, notifyAddresses);
+    }
+    else if (afrl::cmasi::isMissionCommand(object.get()))
+    {
+        auto missionCommand = std::static_pointer_cast<afrl::cmasi::MissionCommand>(object);
+        m_currentMissions[missionCommand->getVehicleID()] = missionCommand;
+    }
+    else if (afrl::impact::isAreaOfInterest(object.get()))
+    {
+        auto areaOfInterest = std::static_pointer_cast<afrl::impact::AreaOfInterest>(object);
+        m_areasOfInterest[areaOfInterest->getAreaID()] = areaOfInterest;
+    }
+    else if (afrl::impact::isLineOfInterest(object.get()))
+    {
+        auto lineOfInterest = std::static_pointer_cast<afrl::impact::LineOfInterest>(object);
+        m_linesOfInterest[lineOfInterest->getLineID()] = lineOfInterest;
+    }
+    else if (afrl::impact::isPointOfInterest(object.get()))
+    {
+        auto pointOfInterest = std::static_pointer_cast<afrl::impact::PointOfInterest>(object);
+        m_pointsOfInterest[pointOfInterest->getPointID()] = pointOfInterest;
+    }
+    else if (afrl::cmasi::isKeepInZone(object.get()))
+    {
+        SharedEntityStore::getInstance().setKeepInZone(std::static_pointer_cast<afrl::cmasi::KeepInZone>(object));
+    }
+    else if (afrl::cmasi::isKeepOutZone(object.get()))
+    {
+        SharedEntityStore::getInstance().setKeepOutZone(std::static_pointer_cast<afrl::cmasi::KeepOutZone>(object));
+    }
+    else if (afrl::cmasi::isOperatingRegion(object.get()))
+    {
+        auto opr = std::static_pointer_cast<afrl::cmasi::OperatingRegion>(object);
+        m_OperatingRegions[opr->getID()] = opr;
+    }
+}
+
 std::shared_ptr<afrl::cmasi::Task> TaskServiceBase::generateTaskObject(const pugi::xml_node& taskNode)
 {
     std::shared_ptr<afrl::cmasi::Task> taskPointer;
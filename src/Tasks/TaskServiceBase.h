@@ -18,6 +18,7 @@
 #define UXAS_SERVICE_TASK_TASK_SERVICE_BASE_H
 
 #include "ServiceBase.h"
+#include "SharedEntityStore.h"
 #include "Constants/Convert.h"
 
 #include "avtas/lmcp/Object.h"
@@ -49,6 +50,7 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <map>
+#include <vector>
 
 
 namespace uxas
@@ -153,9 +155,16 @@ namespace task
      * OPERATIONS
      * 1) When an 'EntityConfiguration', ('AirVehicleConfiguration', 'GroundVehicleConfiguration', 
      *  'SurfaceVehicleConfiguration') for an entity listed in the task's eligible 
-     *  entities is received, it is stored in 'm_entityConfigurations' and its ID 
-     *  is entered into the map 'm_speedAltitudeVsEligibleEntityIds', based on its
-     *  nominal speed and altitude.
+     *  entities is received, its ID is entered into the map 
+     *  'm_speedAltitudeVsEligibleEntityIds', based on its nominal speed and altitude.
+     * 
+     *  Entity configurations, entity states and keep-in/keep-out zones are
+     *  not copied per task: 'm_entityConfigurations', 'm_entityStates', 
+     *  'm_keepInZones' and 'm_keepOutZones' are read-only views of a snapshot 
+     *  of the process-wide 'SharedEntityStore', refreshed before each received
+     *  message is processed. 'EntityState' messages are only delivered for
+     *  the assigned vehicles and the entities registered with 
+     *  'addEntityStateInterest'/'addAllEntityStatesInterest'.
      * 
      * 2) When an 'UniqueAutomationRequest' is received, call the virtual function 
      *  'buildTaskPlanOptions()'.
@@ -213,13 +222,11 @@ namespace task
      *  
      * @n
      * TASK: Subscribed Messages:
-     *  - afrl::cmasi::EntityState
+     *  - afrl::cmasi::EntityState (forwarded by the TaskManagerService; 
+     *      subscribed directly only if no service feeds the SharedEntityStore)
      *  - afrl::cmasi::EntityConfiguration
-     *  - afrl::cmasi::AirVehicleState
      *  - afrl::cmasi::AirVehicleConfiguration
-     *  - afrl::vehicles::GroundVehicleState
      *  - afrl::vehicles::GroundVehicleConfiguration
-     *  - afrl::vehicles::SurfaceVehicleState
      *  - afrl::vehicles::SurfaceVehicleConfiguration
      *  - uxas::messages::task::UniqueAutomationRequest
      *  - uxas::messages::task::UniqueAutomationResponse
@@ -244,6 +251,15 @@ namespace task
          */
         TaskServiceBase(const std::string& typeName,const std::string& directoryName);
         virtual ~TaskServiceBase();
+
+        /** \brief Supplies the task and the objects it requires (e.g., 
+         * <B><i>OperatingRegion</i></B>, <B><i>AreaOfInterest</i></B>, 
+         * <B><i>MissionCommand</i></B>) as typed objects, so that the service 
+         * configuration XML only needs to carry the task options. Must be called 
+         * before configuration. The objects are owned by the task service afterwards.
+         */
+        void setTaskAndConfigurationObjects(const std::shared_ptr<afrl::cmasi::Task>& task,
+                std::vector<std::shared_ptr<avtas::lmcp::Object> > configurationObjects);
         
 
     protected:
@@ -329,6 +345,32 @@ namespace task
         int64_t getOptionIdFromRouteId(const int64_t& routeId);
         /*! \brief parses a RouteId, response to find the RouteType (enum) */
         RouteTypeEnum getRouteTypeFromRouteId(const int64_t& routeId);
+        /*! \brief requests <B><i>EntityState</i></B> messages for an entity 
+         * that is not assigned to this task (e.g. a watched entity) */
+        void addEntityStateInterest(const int64_t& entityId);
+        /*! \brief requests <B><i>EntityState</i></B> messages for all entities */
+        void addAllEntityStatesInterest();
+
+    private:
+        /*! \brief adds the entity to 'm_speedAltitudeVsEligibleEntityIds', if it is eligible */
+        void addEligibleEntityConfiguration(const std::shared_ptr<afrl::cmasi::EntityConfiguration>& entityConfiguration);
+        /*! \brief pins the latest 'SharedEntityStore' snapshot in the entity/zone views */
+        void refreshSharedEntityViews();
+        /*! \brief registers the assigned and requested entities with the 'SharedEntityStore' */
+        void updateEntityStateInterest();
+        /*! \brief stores a configuration object received as XML or supplied directly */
+        void addConfigurationObject(const std::shared_ptr<avtas::lmcp::Object>& object);
+
+        /*! \brief version of the 'SharedEntityStore' snapshot pinned in the views */
+        uint64_t m_sharedEntityStoreVersion{0};
+        /*! \brief entities, in addition to the assigned ones, whose states are requested */
+        std::unordered_set<int64_t> m_entityStateInterestIds;
+        bool m_isAllEntityStatesInterest{false};
+        /*! \brief true if no service feeds the 'SharedEntityStore', so this 
+         * task subscribes to and stores entity states itself */
+        bool m_isFeedingSharedEntityStore{false};
+        /*! \brief objects supplied by 'setTaskAndConfigurationObjects', consumed by 'configure' */
+        std::vector<std::shared_ptr<avtas::lmcp::Object> > m_configurationObjects;
 
         
     protected:
@@ -386,10 +428,10 @@ namespace task
          * this is a work around in the process of switching to multiple automation requests*/
         int64_t m_latestUniqueAutomationRequestId{0};
         
-        /*! \brief  copy of all known  <B><i>EntityConfiguration</i></B>s*/
-        std::unordered_map<int64_t, std::shared_ptr<afrl::cmasi::EntityConfiguration> > m_entityConfigurations;
-        /*! \brief  copy of all known  <B><i>EntityConfiguration</i></B>s*/
-        std::unordered_map<int64_t, std::shared_ptr<afrl::cmasi::EntityState> > m_entityStates;
+        /*! \brief  all known  <B><i>EntityConfiguration</i></B>s (shared, read-only)*/
+        SharedEntityStore::MapView<afrl::cmasi::EntityConfiguration> m_entityConfigurations;
+        /*! \brief  latest <B><i>EntityState</i></B>s of all known entities (shared, read-only)*/
+        SharedEntityStore::MapView<afrl::cmasi::EntityState> m_entityStates;
 
         //ROUTING
         /*! \brief map from route IDs to (task, option) IDs */
@@ -435,14 +477,10 @@ namespace task
          * configured in the @ref c_Component_TaskManager*/
         std::unordered_map<int64_t, std::shared_ptr<afrl::cmasi::MissionCommand> > m_currentMissions;
 
-        /*! \brief  all <B><i>KeepInZone</i></B> objects.
-        * NOTE: Object received before task creation are only available when
-        * configured in the @ref c_Component_TaskManager*/
-        std::unordered_map < int64_t, std::shared_ptr<afrl::cmasi::KeepInZone> > m_keepInZones;
-        /*! \brief  all <B><i>KeepOutZone</i></B> objects.
-        * NOTE: Object received before task creation are only available when
-        * configured in the @ref c_Component_TaskManager*/
-        std::unordered_map < int64_t, std::shared_ptr<afrl::cmasi::KeepOutZone> > m_keepOutZones;
+        /*! \brief  all <B><i>KeepInZone</i></B> objects (shared, read-only).*/
+        SharedEntityStore::MapView<afrl::cmasi::KeepInZone> m_keepInZones;
+        /*! \brief  all <B><i>KeepOutZone</i></B> objects (shared, read-only).*/
+        SharedEntityStore::MapView<afrl::cmasi::KeepOutZone> m_keepOutZones;
         /*! \brief  all <B><i>OperatingRegion</i></B> objects.
         * NOTE: Object received before task creation are only available when
         * configured in the @ref c_Component_TaskManager*/
@@ -43,14 +43,22 @@ namespace common
 {
 
 bool ConfigurationManager::s_isZeroMqMultipartMessage{false};
+bool ConfigurationManager::s_isZeroMqBinaryEnvelope{false};
+bool ConfigurationManager::s_isInProcessMessageBus{false};
+bool ConfigurationManager::s_isMessageProcessingStatistics{false};
+uint32_t ConfigurationManager::s_networkServerWorkerCount{1};
 uint32_t ConfigurationManager::s_serialPortWaitTime_ms = 50;
+uint32_t ConfigurationManager::s_serialFramingVersion{2};
 int32_t ConfigurationManager::s_zeroMqReceiveSocketPollWaitTime_ms = 100;
 
 int64_t ConfigurationManager::s_entityStartTimeSinceEpoch_ms = 0;
 uint32_t ConfigurationManager::s_startDelay_ms = 0;
+uint32_t ConfigurationManager::s_timerCallbackThreadCount = 0;
 uint32_t ConfigurationManager::s_runDuration_s = UINT32_MAX;
 bool ConfigurationManager::s_isLoggingThreadId{false};
 bool ConfigurationManager::s_isDataTimestamp{true};
+bool ConfigurationManager::s_isAsynchronousLogging{false};
+uint32_t ConfigurationManager::s_asynchronousLogRingCapacity{1024};
 
 uint32_t ConfigurationManager::s_entityId = 0;
 std::string ConfigurationManager::s_entityType{""};
@@ -379,6 +387,16 @@ ConfigurationManager::setEntityValuesFromXmlNode(const pugi::xml_node& xmlNode)
             UXAS_LOG_INFORM(s_typeName(), "::setEntityFromXmlNode retained default start delay milliseconds ", s_startDelay_ms);
         }
 
+        if (isSuccess && !entityInfoXmlNode.attribute(StringConstant::TimerCallbackThreadCount().c_str()).empty())
+        {
+            s_timerCallbackThreadCount = entityInfoXmlNode.attribute(StringConstant::TimerCallbackThreadCount().c_str()).as_uint();
+            UXAS_LOG_INFORM(s_typeName(), "::setEntityFromXmlNode set timer callback thread count ", s_timerCallbackThreadCount);
+        }
+        else
+        {
+            UXAS_LOG_INFORM(s_typeName(), "::setEntityFromXmlNode retained default timer callback thread count ", s_timerCallbackThreadCount);
+        }
+
         if (isSuccess && !entityInfoXmlNode.attribute(StringConstant::RunDuration_s().c_str()).empty())
         {
             s_runDuration_s = entityInfoXmlNode.attribute(StringConstant::RunDuration_s().c_str()).as_uint();
@@ -408,7 +426,94 @@ ConfigurationManager::setEntityValuesFromXmlNode(const pugi::xml_node& xmlNode)
         {
           UXAS_LOG_INFORM(s_typeName(), "::setEntityFromXmlNode retained default isDataTimeStamp ", s_isDataTimestamp);
         }
+
+        if (isSuccess && !entityInfoXmlNode.attribute(StringConstant::isAsynchronousLogging().c_str()).empty())
+        {
+            s_isAsynchronousLogging = entityInfoXmlNode.attribute(StringConstant::isAsynchronousLogging().c_str()).as_bool();
+            UXAS_LOG_INFORM(s_typeName(), "::setEntityFromXmlNode setting isAsynchronousLogging ", s_isAsynchronousLogging);
+        }
+        else
+        {
+            UXAS_LOG_INFORM(s_typeName(), "::setEntityFromXmlNode retained default isAsynchronousLogging ", s_isAsynchronousLogging);
+        }
+
+        if (isSuccess && !entityInfoXmlNode.attribute(StringConstant::AsynchronousLogRingCapacity().c_str()).empty())
+        {
+            s_asynchronousLogRingCapacity = entityInfoXmlNode.attribute(StringConstant::AsynchronousLogRingCapacity().c_str()).as_uint();
+            if (s_asynchronousLogRingCapacity < 2)
+            {
+                s_asynchronousLogRingCapacity = 2;
+            }
+            UXAS_LOG_INFORM(s_typeName(), "::setEntityFromXmlNode set asynchronous log ring capacity ", s_asynchronousLogRingCapacity);
+        }
+        else
+        {
+            UXAS_LOG_INFORM(s_typeName(), "::setEntityFromXmlNode retained default asynchronous log ring capacity ", s_asynchronousLogRingCapacity);
+        }
+
+        if (isSuccess && !entityInfoXmlNode.attribute(StringConstant::isZeroMqBinaryEnvelope().c_str()).empty())
+        {
+            s_isZeroMqBinaryEnvelope = entityInfoXmlNode.attribute(StringConstant::isZeroMqBinaryEnvelope().c_str()).as_bool();
+            UXAS_LOG_INFORM(s_typeName(), "::setEntityFromXmlNode setting isZeroMqBinaryEnvelope ", s_isZeroMqBinaryEnvelope);
+        }
+        else
+        {
+            UXAS_LOG_INFORM(s_typeName(), "::setEntityFromXmlNode retained default isZeroMqBinaryEnvelope ", s_isZeroMqBinaryEnvelope);
+        }
+
+        if (isSuccess && !entityInfoXmlNode.attribute(StringConstant::isInProcessMessageBus().c_str()).empty())
+        {
+            s_isInProcessMessageBus = entityInfoXmlNode.attribute(StringConstant::isInProcessMessageBus().c_str()).as_bool();
+            UXAS_LOG_INFORM(s_typeName(), "::setEntityFromXmlNode setting isInProcessMessageBus ", s_isInProcessMessageBus);
+        }
+        else
+        {
+            UXAS_LOG_INFORM(s_typeName(), "::setEntityFromXmlNode retained default isInProcessMessageBus ", s_isInProcessMessageBus);
+        }
+
+        if (isSuccess && !entityInfoXmlNode.attribute(StringConstant::isMessageProcessingStatistics().c_str()).empty())
+        {
+            s_isMessageProcessingStatistics = entityInfoXmlNode.attribute(StringConstant::isMessageProcessingStatistics().c_str()).as_bool();
+            UXAS_LOG_INFORM(s_typeName(), "::setEntityFromXmlNode setting isMessageProcessingStatistics ", s_isMessageProcessingStatistics);
+        }
+        else
+        {
+            UXAS_LOG_INFORM(s_typeName(), "::setEntityFromXmlNode retained default isMessageProcessingStatistics ", s_isMessageProcessingStatistics);
+        }
+
+        if (isSuccess && !entityInfoXmlNode.attribute(StringConstant::NetworkServerWorkerCount().c_str()).empty())
+        {
+            s_networkServerWorkerCount = entityInfoXmlNode.attribute(StringConstant::NetworkServerWorkerCount().c_str()).as_uint();
+            if (s_networkServerWorkerCount < 1)
+            {
+                s_networkServerWorkerCount = 1;
+            }
+            UXAS_LOG_INFORM(s_typeName(), "::setEntityFromXmlNode set network server worker count ", s_networkServerWorkerCount);
+        }
+        else
+        {
+            UXAS_LOG_INFORM(s_typeName(), "::setEntityFromXmlNode retained default network server worker count ", s_networkServerWorkerCount);
+        }
+
+        if (isSuccess && !entityInfoXmlNode.attribute(StringConstant::SerialFramingVersion().c_str()).empty())
+        {
+            s_serialFramingVersion = entityInfoXmlNode.attribute(StringConstant::SerialFramingVersion().c_str()).as_uint();
+            if (s_serialFramingVersion < 1)
+            {
+                s_serialFramingVersion = 1;
+            }
+            else if (s_serialFramingVersion > 2)
+            {
+                s_serialFramingVersion = 2;
+            }
+            UXAS_LOG_INFORM(s_typeName(), "::setEntityFromXmlNode set serial framing version ", s_serialFramingVersion);
+        }
+        else
+        {
+            UXAS_LOG_INFORM(s_typeName(), "::setEntityFromXmlNode retained default serial framing version ", s_serialFramingVersion);
+        }
         uxas::common::log::LogManager::getInstance().m_isLoggingThreadId = s_isLoggingThreadId;
+        uxas::common::log::LogManager::getInstance().setAsynchronous(s_isAsynchronousLogging, s_asynchronousLogRingCapacity);
     }
 
     return (isSuccess);
@@ -141,6 +141,22 @@ public:
     static const bool
     getIsDataTimeStamp() { return s_isDataTimestamp; };
 
+    /** \brief LogManager configuration to defer formatting and output of log 
+     * statements to a background thread.
+     * 
+     * @return true implies asynchronous logging
+     */
+    static const bool
+    getIsAsynchronousLogging() { return (s_isAsynchronousLogging); };
+
+    /** \brief LogManager asynchronous logging configuration.
+     * 
+     * @return capacity (log statements) of the queue of each logging thread; 
+     * statements logged while the queue is full are dropped (except errors)
+     */
+    static const uint32_t
+    getAsynchronousLogRingCapacity() { return (s_asynchronousLogRingCapacity); };
+
     /** \brief Zero MQ single-part/multi-part messaging boolean.
      * 
      * @return true if using Zero MQ multi-part messaging; false if using Zero MQ 
@@ -148,6 +164,38 @@ public:
      */
     static const bool
     getIsZeroMqMultipartMessage() { return (s_isZeroMqMultipartMessage); };
+
+    /** \brief Zero MQ binary message envelope boolean. Envelopes are only
+     * sent on in-process sockets; sockets to other processes keep the legacy
+     * format, since no format is negotiated with remote peers. Receivers
+     * always accept both envelope and legacy delimited/multi-part attribute
+     * messages.
+     * 
+     * @return true if sending Zero MQ messages with a binary attribute envelope; 
+     * false if sending legacy delimited/multi-part attribute strings
+     */
+    static const bool
+    getIsZeroMqBinaryEnvelope() { return (s_isZeroMqBinaryEnvelope); };
+
+    /** \brief In-process message bus boolean. When enabled, services of this 
+     * entity exchange <b>LMCP</b> objects through the in-process bus instead 
+     * of serializing through the Zero MQ message hub (objects are copied for 
+     * all but the last receiver of a message).
+     * 
+     * @return true if using the in-process message bus for the internal network
+     */
+    static const bool
+    getIsInProcessMessageBus() { return (s_isInProcessMessageBus); };
+
+    /** \brief Network client configuration to record per message type 
+     * processing time, queue wait time and queue depth histograms (see 
+     * MessageProcessingStatistics). Off by default, since recording costs a 
+     * lock and a map lookup per received message.
+     * 
+     * @return true if recording message processing statistics
+     */
+    static const bool
+    getIsMessageProcessingStatistics() { return (s_isMessageProcessingStatistics); };
   
     /** \brief UxAS application run duration (units: seconds).
      * 
@@ -163,6 +211,15 @@ public:
     static const uint32_t
     getSerialPortWaitTime_ms() { return (s_serialPortWaitTime_ms); };
 
+    /** \brief Highest framing version sent by bridges over TCP, serial and 
+     * Zyre links (1: sentinel framing, 2: length-prefixed binary framing, 
+     * used once the peer announced it). Receivers decode both.
+     * 
+     * @return highest framing version to send
+     */
+    static const uint32_t
+    getSerialFramingVersion() { return (s_serialFramingVersion); };
+
     /** \brief UxAS application start delay (units: milliseconds).
      * 
      * @return application start delay in milliseconds.
@@ -170,6 +227,14 @@ public:
     static const uint32_t
     getStartDelay_ms() { return (s_startDelay_ms); };
 
+    /** \brief Number of threads invoking TimerManager callbacks.
+     * 
+     * @return callback thread count; 0 implies callbacks are invoked on the 
+     * TimerManager's thread.
+     */
+    static const uint32_t
+    getTimerCallbackThreadCount() { return (s_timerCallbackThreadCount); };
+
     /** \brief Zero MQ receive socket poll wait duration (units: milliseconds).
      * 
      * @return Wait duration in milliseconds.
@@ -177,6 +242,14 @@ public:
     static const int32_t
     getZeroMqReceiveSocketPollWaitTime_ms() { return (s_zeroMqReceiveSocketPollWaitTime_ms); };
 
+    /** \brief Number of LMCP network server (hub) worker shards. Each shard 
+     * publishes on its own socket; 1 implies the single-threaded hub.
+     * 
+     * @return hub worker count (>= 1).
+     */
+    static const uint32_t
+    getNetworkServerWorkerCount() { return (s_networkServerWorkerCount); };
+
     /** \brief The <B><i>loadBaseXmlFile</i></B> method loads base configurations.
      * 
      * @param xmlFilePath location of XML file containing base configuration.
@@ -364,10 +437,18 @@ private:
     static std::string s_entityType;
     static bool s_isLoggingThreadId;
     static bool s_isDataTimestamp;
+    static bool s_isAsynchronousLogging;
+    static uint32_t s_asynchronousLogRingCapacity;
     static bool s_isZeroMqMultipartMessage;
+    static bool s_isZeroMqBinaryEnvelope;
+    static bool s_isInProcessMessageBus;
+    static bool s_isMessageProcessingStatistics;
+    static uint32_t s_networkServerWorkerCount;
     static uint32_t s_runDuration_s;
     static uint32_t s_serialPortWaitTime_ms;
+    static uint32_t s_serialFramingVersion;
     static uint32_t s_startDelay_ms;
+    static uint32_t s_timerCallbackThreadCount;
     static int32_t s_zeroMqReceiveSocketPollWaitTime_ms;
 
     static std::string s_rootDataInDirectory;
@@ -39,6 +39,12 @@ DatabaseLogger::configureDatabase(const std::string& createDatabase, const std::
 {
     return (m_databaseLoggerHelper->configureDatabaseHelper(m_location, m_isTimestamp, m_loggerStatementCountLimit, createDatabase, databaseTableName, databaseTableColumnNames));
 };
+
+bool
+DatabaseLogger::configureBatchedWriter(uint32_t batchStatementCountLimit, uint32_t batchPeriod_ms, uint32_t queueCountLimit)
+{
+    return (m_databaseLoggerHelper->configureBatchedWriter(batchStatementCountLimit, batchPeriod_ms, queueCountLimit));
+};
     
 bool
 DatabaseLogger::openStream(std::string& logFilePath)
@@ -58,6 +64,12 @@ DatabaseLogger::outputTextToStream(const std::string& text)
     return (m_databaseLoggerHelper->insertValuesIntoTable(text));
 };
 
+bool
+DatabaseLogger::outputRowToTable(std::vector<DatabaseColumnValue> row)
+{
+    return (m_databaseLoggerHelper->insertRowIntoTable(std::move(row)));
+};
+
 }; //namespace log
 }; //namespace common
 }; //namespace uxas
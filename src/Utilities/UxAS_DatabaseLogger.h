@@ -15,6 +15,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace uxas
 {
@@ -55,6 +56,9 @@ public:
 
     bool
     configureDatabase(const std::string& createDatabase, const std::string& databaseTableName, const std::string& databaseTableColumnNames);
+
+    bool
+    configureBatchedWriter(uint32_t batchStatementCountLimit, uint32_t batchPeriod_ms, uint32_t queueCountLimit);
     
     bool
     openStream(std::string& logFilePath) override;
@@ -65,6 +69,9 @@ public:
     bool
     outputTextToStream(const std::string& text) override;
 
+    bool
+    outputRowToTable(std::vector<DatabaseColumnValue> row);
+
 private:
     
     std::unique_ptr<DatabaseLoggerHelper> m_databaseLoggerHelper;
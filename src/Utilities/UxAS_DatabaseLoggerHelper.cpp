@@ -14,6 +14,7 @@
 
 #include "stdUniquePtr.h"
 
+#include <chrono>
 #include <iostream>
 
 namespace uxas
@@ -47,12 +48,59 @@ DatabaseLoggerHelper::configureDatabaseHelper(const std::string& location, bool
     m_dbTableCreate = createDatabase;
     m_dbTableName = databaseTableName;
     m_dbTableColumnNames = databaseTableColumnNames;
+
+    // one positional parameter per column
+    std::string parameters{"?"};
+    for (auto character : m_dbTableColumnNames)
+    {
+        if (character == ',')
+        {
+            parameters.append(",?");
+        }
+    }
+    m_dbInsertStatement = "INSERT INTO " + m_dbTableName + " (" + m_dbTableColumnNames + ") VALUES (" + parameters + ")";
     m_isTableConfigurationDefined = true;
     return (true);
 };
 
+bool
+DatabaseLoggerHelper::configureBatchedWriter(uint32_t batchStatementCountLimit, uint32_t batchPeriod_ms, uint32_t queueCountLimit)
+{
+    if (batchStatementCountLimit < 1 || queueCountLimit < batchStatementCountLimit)
+    {
+        std::cout << "ERROR: DatabaseLoggerHelper::configureBatchedWriter failed due to invalid batch count [" << batchStatementCountLimit
+                << "] or queue limit [" << queueCountLimit << "]" << std::endl;
+        return (false);
+    }
+    if (m_isWriterRunning)
+    {
+        std::cout << "ERROR: DatabaseLoggerHelper::configureBatchedWriter failed since the batched writer is already running" << std::endl;
+        return (false);
+    }
+    m_batchStatementCountLimit = batchStatementCountLimit;
+    m_batchPeriod_ms = batchPeriod_ms;
+    m_queueCountLimit = queueCountLimit;
+    m_isBatchedWriter = true;
+    return (true);
+};
+
 bool
 DatabaseLoggerHelper::openStream(std::string& logFilePath)
+{
+    bool isSuccess{false};
+    {
+        std::lock_guard<std::mutex> lock(m_dbMutex);
+        isSuccess = openDatabase(logFilePath);
+    }
+    if (isSuccess && m_isBatchedWriter && !m_isWriterRunning)
+    {
+        startBatchedWriter();
+    }
+    return (isSuccess);
+};
+
+bool
+DatabaseLoggerHelper::openDatabase(std::string& logFilePath)
 {
     if (!m_isTableConfigurationDefined)
     {
@@ -75,12 +123,19 @@ DatabaseLoggerHelper::openStream(std::string& logFilePath)
         }
             m_db = uxas::stduxas::make_unique<SQLite::Database>(m_dbFilePath, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
 
+            // write-ahead logging with relaxed sync: commits append to the log
+            // instead of rewriting (and syncing) the database file each time
+            m_db->exec("PRAGMA journal_mode=WAL");
+            m_db->exec("PRAGMA synchronous=NORMAL");
+
             // begin transaction
             SQLite::Transaction createTableTrans(*(m_db.get()));
             m_db->exec(m_dbTableCreate);
 
             // commit transaction
             createTableTrans.commit();
+
+            m_dbPreparedInsert = uxas::stduxas::make_unique<SQLite::Statement>(*(m_db.get()), m_dbInsertStatement);
         
         m_isDbOpened = true;
         isSuccess = true;
@@ -95,6 +150,15 @@ DatabaseLoggerHelper::openStream(std::string& logFilePath)
 
 bool
 DatabaseLoggerHelper::closeStream()
+{
+    // flush queued rows before closing
+    stopBatchedWriter();
+    std::lock_guard<std::mutex> lock(m_dbMutex);
+    return (closeDatabase());
+};
+
+bool
+DatabaseLoggerHelper::closeDatabase()
 {
     bool isSuccess{false};
     if (m_db)
@@ -102,7 +166,9 @@ DatabaseLoggerHelper::closeStream()
         std::string dbFilePath = m_db->getFilename();
         try
         {
+            m_dbPreparedInsert.reset();
             m_db.reset();
+            m_isDbOpened = false;
             isSuccess = true;
         }
         catch (std::exception& ex)
@@ -123,11 +189,12 @@ DatabaseLoggerHelper::closeStream()
 bool
 DatabaseLoggerHelper::insertValuesIntoTable(const std::string& commaDelimitedValues)
 {
+    std::lock_guard<std::mutex> lock(m_dbMutex);
     bool isSuccess{true};
     if (!m_isDbOpened)
     {
         std::string logFilePath;
-        isSuccess = openStream(logFilePath);
+        isSuccess = openDatabase(logFilePath);
     }
     if (isSuccess)
     {
@@ -150,19 +217,202 @@ DatabaseLoggerHelper::insertValuesIntoTable(const std::string& commaDelimitedVal
     return (isSuccess);
 };
 
+bool
+DatabaseLoggerHelper::insertRowIntoTable(std::vector<DatabaseColumnValue> row)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_queueMutex);
+        if (m_isWriterRunning)
+        {
+            // back-pressure instead of unbounded memory growth (or lost rows)
+            m_queueNotFull.wait(lock, [this] { return (m_queuedRows.size() < m_queueCountLimit || !m_isWriterRunning); });
+            if (m_isWriterRunning)
+            {
+                m_queuedRows.push_back(std::move(row));
+                if (m_queuedRows.size() >= m_batchStatementCountLimit)
+                {
+                    m_queueNotEmpty.notify_one();
+                }
+                return (true);
+            }
+        }
+    }
+
+    std::vector<std::vector<DatabaseColumnValue>> rows;
+    rows.push_back(std::move(row));
+    std::lock_guard<std::mutex> lock(m_dbMutex);
+    return (writeRows(rows));
+};
+
+bool
+DatabaseLoggerHelper::writeRows(std::vector<std::vector<DatabaseColumnValue>>& rows)
+{
+    bool isSuccess{true};
+    if (!m_isDbOpened)
+    {
+        std::string logFilePath;
+        isSuccess = openDatabase(logFilePath);
+    }
+
+    // a failed transaction is rolled back and attempted again once before its rows are given up
+    const uint32_t transactionAttemptLimit{2};
+    uint32_t transactionAttemptCount{0};
+    size_t rowIndex{0};
+    while (isSuccess && rowIndex < rows.size())
+    {
+        // one transaction for all rows up to the end of the batch or the
+        // statement count limit of the current database file
+        size_t transactionRowIndex{rowIndex};
+        uint32_t transactionStatementCount{m_dbStatementCount};
+        transactionAttemptCount++;
+        try
+        {
+            SQLite::Transaction transaction(*(m_db.get()));
+            while (rowIndex < rows.size() && m_dbStatementCount <= m_dbStatementCountLimit)
+            {
+                try
+                {
+                    bindRow(rows[rowIndex]);
+                    m_dbPreparedInsert->exec();
+                    m_dbStatementCount++;
+                }
+                catch (std::exception& ex)
+                {
+                    std::cout << "ERROR: DatabaseLoggerHelper::writeRows insert failed while executing SQL statement [" << m_dbInsertStatement << "] - ERROR: [" << ex.what() << "]" << std::endl;
+                }
+                try
+                {
+                    m_dbPreparedInsert->reset();
+                }
+                catch (std::exception&)
+                {
+                    // reset repeats the error of a failed insert (already reported)
+                }
+                rowIndex++;
+            }
+            // commit transaction
+            transaction.commit();
+            transactionAttemptCount = 0;
+        }
+        catch (std::exception& ex)
+        {
+            std::cout << "ERROR: DatabaseLoggerHelper::writeRows failed to commit [" << rowIndex - transactionRowIndex << "] rows - ERROR: [" << ex.what() << "]" << std::endl;
+            rowIndex = transactionRowIndex;
+            m_dbStatementCount = transactionStatementCount;
+            if (transactionAttemptCount < transactionAttemptLimit)
+            {
+                continue;
+            }
+            isSuccess = false;
+        }
+        if (!closeAndOpenStream())
+        {
+            isSuccess = false;
+        }
+    }
+    if (rowIndex < rows.size())
+    {
+        std::cout << "ERROR: DatabaseLoggerHelper::writeRows dropped [" << rows.size() - rowIndex << "] of [" << rows.size() << "] rows" << std::endl;
+    }
+    return (isSuccess);
+};
+
+void
+DatabaseLoggerHelper::bindRow(const std::vector<DatabaseColumnValue>& row)
+{
+    m_dbPreparedInsert->clearBindings();
+    for (size_t index = 0; index < row.size(); index++)
+    {
+        const DatabaseColumnValue& value = row[index];
+        int parameterIndex = static_cast<int>(index) + 1;
+        switch (value.m_type)
+        {
+            case DatabaseColumnValue::Type::NULL_VALUE:
+                m_dbPreparedInsert->bind(parameterIndex);
+                break;
+            case DatabaseColumnValue::Type::INTEGER:
+                m_dbPreparedInsert->bind(parameterIndex, static_cast<sqlite3_int64>(value.m_integer));
+                break;
+            case DatabaseColumnValue::Type::TEXT:
+                m_dbPreparedInsert->bind(parameterIndex, value.m_data);
+                break;
+            case DatabaseColumnValue::Type::BLOB:
+                m_dbPreparedInsert->bind(parameterIndex, value.m_data.data(), static_cast<int>(value.m_data.size()));
+                break;
+        }
+    }
+};
+
+void
+DatabaseLoggerHelper::startBatchedWriter()
+{
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    m_isWriterTerminate = false;
+    m_isWriterRunning = true;
+    m_writerThread = std::thread(&DatabaseLoggerHelper::executeBatchedWriter, this);
+};
+
+void
+DatabaseLoggerHelper::stopBatchedWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        if (!m_isWriterRunning)
+        {
+            return;
+        }
+        m_isWriterTerminate = true;
+    }
+    m_queueNotEmpty.notify_one();
+    if (m_writerThread.joinable())
+    {
+        m_writerThread.join();
+    }
+};
+
+void
+DatabaseLoggerHelper::executeBatchedWriter()
+{
+    std::vector<std::vector<DatabaseColumnValue>> rows;
+    bool isTerminate{false};
+    while (!isTerminate)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueNotEmpty.wait_for(lock, std::chrono::milliseconds(m_batchPeriod_ms),
+                                     [this] { return (m_queuedRows.size() >= m_batchStatementCountLimit || m_isWriterTerminate); });
+            isTerminate = m_isWriterTerminate;
+            if (isTerminate)
+            {
+                // later inserts are written synchronously by the caller
+                m_isWriterRunning = false;
+            }
+            rows.swap(m_queuedRows);
+        }
+        m_queueNotFull.notify_all();
+
+        if (!rows.empty())
+        {
+            std::lock_guard<std::mutex> lock(m_dbMutex);
+            writeRows(rows);
+            rows.clear();
+        }
+    }
+};
+
 bool
 DatabaseLoggerHelper::closeAndOpenStream()
 {
     bool isSuccess{true};
     if (m_dbStatementCount > m_dbStatementCountLimit)
     {
-        if (!closeStream())
+        if (!closeDatabase())
         {
             isSuccess = false;
             std::cout << "WARN: DatabaseLoggerHelper::closeAndOpenStream failed to close database file [" << m_dbFilePathOld << "]" << std::endl;
         }
         std::string logFilePath;        //not used ??
-        if (!openStream(logFilePath))
+        if (!openDatabase(logFilePath))
         {
             isSuccess = false;
             std::cout << "WARN: DatabaseLoggerHelper::closeAndOpenStream failed to open database file" << std::endl;
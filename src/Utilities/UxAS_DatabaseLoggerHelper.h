@@ -13,9 +13,14 @@
 #include <SQLiteCpp/Database.h>
 #include <SQLiteCpp/SQLiteCpp.h>
 
+#include <condition_variable>
+#include <cstdint>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace uxas
 {
@@ -24,6 +29,70 @@ namespace common
 namespace log
 {
 
+/** \class DatabaseColumnValue
+ *
+ * \par Description:
+ * Single column value of a row inserted with a prepared statement. Values are
+ * bound to statement parameters, so text and binary data do not need to be
+ * quoted or escaped.
+ *
+ * \n
+ */
+class DatabaseColumnValue
+{
+public:
+
+    enum class Type
+    {
+        NULL_VALUE,
+        INTEGER,
+        TEXT,
+        BLOB
+    };
+
+    static
+    DatabaseColumnValue
+    null() { return (DatabaseColumnValue(Type::NULL_VALUE, 0, std::string())); };
+
+    static
+    DatabaseColumnValue
+    integer(int64_t value) { return (DatabaseColumnValue(Type::INTEGER, value, std::string())); };
+
+    static
+    DatabaseColumnValue
+    text(std::string value) { return (DatabaseColumnValue(Type::TEXT, 0, std::move(value))); };
+
+    static
+    DatabaseColumnValue
+    blob(std::string value) { return (DatabaseColumnValue(Type::BLOB, 0, std::move(value))); };
+
+    Type m_type;
+    int64_t m_integer;
+    std::string m_data;
+
+private:
+
+    DatabaseColumnValue(Type type, int64_t integer, std::string data)
+    : m_type(type), m_integer(integer), m_data(std::move(data)) { };
+
+};
+
+/** \class DatabaseLoggerHelper
+ *
+ * \par Description:
+ * Writes rows into a single-table SQLite database, rolling over to a new
+ * database file after a configured number of statements.
+ *
+ * \par Batched writer:
+ * Rows inserted with <B><i>insertRowIntoTable</i></B> are bound to a prepared
+ * INSERT statement. If <B><i>configureBatchedWriter</i></B> is called before
+ * <B><i>openStream</i></B>, rows are queued and written by a background
+ * thread that commits one transaction per batch (when the batch count is
+ * reached or the batch period expires), so callers never wait on disk I/O
+ * unless the queue limit is reached. Databases are opened in WAL journal mode.
+ *
+ * \n
+ */
 class DatabaseLoggerHelper
 {
 public:
@@ -51,13 +120,55 @@ public:
     bool
     closeStream();
 
+    /** \brief Enables the background writer. Must be called before
+     * <B><i>openStream</i></B>.
+     *
+     * @param batchStatementCountLimit number of queued rows that triggers a commit
+     * @param batchPeriod_ms maximum time a queued row waits before commit
+     * @param queueCountLimit number of queued rows at which inserts block
+     * @return true if the writer parameters are valid
+     */
+    bool
+    configureBatchedWriter(uint32_t batchStatementCountLimit, uint32_t batchPeriod_ms, uint32_t queueCountLimit);
+
     bool
     insertValuesIntoTable(const std::string& commaDelimitedValues);
 
+    /** \brief Inserts one row (one value per configured column) with the
+     * prepared INSERT statement. Queues the row if the batched writer is
+     * running; otherwise writes it immediately.
+     *
+     * @param row column values in configured column order
+     * @return true if the row was queued or written
+     */
+    bool
+    insertRowIntoTable(std::vector<DatabaseColumnValue> row);
+
 private:
 
+    bool
+    openDatabase(std::string& logFilePath);
+
+    bool
+    closeDatabase();
+
     bool
     closeAndOpenStream();
+
+    bool
+    writeRows(std::vector<std::vector<DatabaseColumnValue>>& rows);
+
+    void
+    bindRow(const std::vector<DatabaseColumnValue>& row);
+
+    void
+    startBatchedWriter();
+
+    void
+    stopBatchedWriter();
+
+    void
+    executeBatchedWriter();
     
     std::string m_location;
     bool m_isTimestamp{true};
@@ -76,6 +187,25 @@ private:
     std::string m_dbTableCreate;
     std::string m_dbTableName;
     std::string m_dbTableColumnNames;
+    std::string m_dbInsertStatement;
+    std::unique_ptr<SQLite::Statement> m_dbPreparedInsert;
+
+    /** \brief Guards the database and prepared statement (background writer
+     * and caller threads). */
+    std::mutex m_dbMutex;
+
+    bool m_isBatchedWriter{false};
+    uint32_t m_batchStatementCountLimit{1000};
+    uint32_t m_batchPeriod_ms{500};
+    uint32_t m_queueCountLimit{100000};
+
+    std::mutex m_queueMutex;
+    std::condition_variable m_queueNotEmpty;
+    std::condition_variable m_queueNotFull;
+    std::vector<std::vector<DatabaseColumnValue>> m_queuedRows;
+    bool m_isWriterRunning{false};
+    bool m_isWriterTerminate{false};
+    std::thread m_writerThread;
     
 };
 
@@ -0,0 +1,466 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#include "UxAS_FramedSerialBuffer.h"
+#include "UxAS_SentinelSerialBuffer.h"
+
+#include "UxAS_Log.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace uxas
+{
+namespace common
+{
+
+namespace
+{
+
+const uint8_t c_marker0{0xE5};
+const uint8_t c_marker1{0xF7};
+
+/** \brief maximum number of decimal digits of a sentinel frame size or checksum */
+const size_t c_maximumSentinelDigitCount{10};
+
+/** \brief slicing-by-8 tables: table[0] is the byte-wise table, table[k]
+ * advances a byte by k further zero bytes */
+std::array<std::array<uint32_t, 256>, 8>
+createCrc32Tables()
+{
+    std::array<std::array<uint32_t, 256>, 8> tables;
+    for (uint32_t index = 0; index < 256; index++)
+    {
+        uint32_t crc = index;
+        for (uint32_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 1u) ? (0xEDB88320u ^ (crc >> 1)) : (crc >> 1);
+        }
+        tables[0][index] = crc;
+    }
+    for (uint32_t index = 0; index < 256; index++)
+    {
+        for (size_t slice = 1; slice < 8; slice++)
+        {
+            tables[slice][index] = (tables[slice - 1][index] >> 8) ^ tables[0][tables[slice - 1][index] & 0xFF];
+        }
+    }
+    return (tables);
+}
+
+void
+putUint32(std::string& buffer, uint32_t value)
+{
+    buffer.push_back(static_cast<char>((value >> 24) & 0xFF));
+    buffer.push_back(static_cast<char>((value >> 16) & 0xFF));
+    buffer.push_back(static_cast<char>((value >> 8) & 0xFF));
+    buffer.push_back(static_cast<char>(value & 0xFF));
+}
+
+} //namespace
+
+const uint8_t FramedSerialBuffer::s_sentinelFramingVersion;
+const uint8_t FramedSerialBuffer::s_binaryFramingVersion;
+const size_t FramedSerialBuffer::s_headerSize;
+const uint8_t FramedSerialBuffer::s_announceFlag;
+const uint32_t FramedSerialBuffer::s_maximumPayloadSize;
+
+uint32_t
+FramedSerialBuffer::calculateCrc32(const void* data, size_t size, uint32_t crc)
+{
+    static const std::array<std::array<uint32_t, 256>, 8> s_tables = createCrc32Tables();
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    // eight bytes per step (byte order independent)
+    for (; size >= 8; size -= 8, bytes += 8)
+    {
+        uint32_t low = crc ^ (static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8)
+                | (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24));
+        crc = s_tables[7][low & 0xFF] ^ s_tables[6][(low >> 8) & 0xFF] ^ s_tables[5][(low >> 16) & 0xFF] ^ s_tables[4][low >> 24]
+                ^ s_tables[3][bytes[4]] ^ s_tables[2][bytes[5]] ^ s_tables[1][bytes[6]] ^ s_tables[0][bytes[7]];
+    }
+    for (; size > 0; size--, bytes++)
+    {
+        crc = s_tables[0][(crc ^ *bytes) & 0xFF] ^ (crc >> 8);
+    }
+    return (~crc);
+};
+
+void
+FramedSerialBuffer::appendFramedString(const std::string& payload, uint8_t framingVersion, std::string& frame)
+{
+    if (framingVersion >= s_binaryFramingVersion)
+    {
+        frame.reserve(frame.size() + s_headerSize + payload.size());
+        frame.push_back(static_cast<char>(c_marker0));
+        frame.push_back(static_cast<char>(c_marker1));
+        frame.push_back(static_cast<char>(s_binaryFramingVersion));
+        frame.push_back(0);
+        putUint32(frame, static_cast<uint32_t>(payload.size()));
+        putUint32(frame, calculateCrc32(payload.data(), payload.size()));
+        frame.append(payload);
+    }
+    else
+    {
+        // same layout as SentinelSerialBuffer::createSentinelizedString, built in place
+        std::string payloadSize = std::to_string(payload.size());
+        std::string checksum = std::to_string(SentinelSerialBuffer::calculateChecksum(payload));
+        frame.reserve(frame.size() + payloadSize.size() + payload.size() + checksum.size()
+                      + SentinelSerialBuffer::getSerialSentinelBeforePayloadSizeSize() + SentinelSerialBuffer::getSerialSentinelAfterPayloadSizeSize()
+                      + SentinelSerialBuffer::getSerialSentinelBeforeChecksumSize() + SentinelSerialBuffer::getSerialSentinelAfterChecksumSize());
+        frame.append(SentinelSerialBuffer::getSerialSentinelBeforePayloadSize());
+        frame.append(payloadSize);
+        frame.append(SentinelSerialBuffer::getSerialSentinelAfterPayloadSize());
+        frame.append(payload);
+        frame.append(SentinelSerialBuffer::getSerialSentinelBeforeChecksum());
+        frame.append(checksum);
+        frame.append(SentinelSerialBuffer::getSerialSentinelAfterChecksum());
+    }
+};
+
+std::string
+FramedSerialBuffer::createFramedString(const std::string& payload, uint8_t framingVersion)
+{
+    std::string frame;
+    appendFramedString(payload, framingVersion, frame);
+    return (frame);
+};
+
+std::string
+FramedSerialBuffer::createAnnounceFrame()
+{
+    std::string frame;
+    frame.push_back(static_cast<char>(c_marker0));
+    frame.push_back(static_cast<char>(c_marker1));
+    frame.push_back(static_cast<char>(s_binaryFramingVersion));
+    frame.push_back(static_cast<char>(s_announceFlag));
+    putUint32(frame, 0);
+    putUint32(frame, calculateCrc32(nullptr, 0));
+    return (frame);
+};
+
+void
+FramedSerialBuffer::setLocalFramingVersion(uint8_t framingVersion)
+{
+    m_localFramingVersion = std::max(s_sentinelFramingVersion, std::min(framingVersion, s_binaryFramingVersion));
+};
+
+void
+FramedSerialBuffer::appendData(const void* data, size_t size)
+{
+    if (size == 0)
+    {
+        return;
+    }
+
+    size_t bufferedSize = getBufferedSize();
+    if (bufferedSize + size > m_ring.size())
+    {
+        // grow to the next power of two, linearizing the buffered bytes
+        size_t capacity = std::max<size_t>(m_ring.size(), 4096);
+        while (capacity < bufferedSize + size)
+        {
+            capacity *= 2;
+        }
+        std::vector<uint8_t> ring(capacity);
+        for (size_t index = 0; index < bufferedSize; index++)
+        {
+            ring[index] = getByte(m_readPosition + index);
+        }
+        m_ring.swap(ring);
+        m_mask = capacity - 1;
+        m_readPosition = 0;
+        m_writePosition = bufferedSize;
+    }
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    size_t writeIndex = static_cast<size_t>(m_writePosition) & m_mask;
+    size_t firstSize = std::min(size, m_ring.size() - writeIndex);
+    std::memcpy(&m_ring[writeIndex], bytes, firstSize);
+    if (firstSize < size)
+    {
+        std::memcpy(&m_ring[0], bytes + firstSize, size - firstSize);
+    }
+    m_writePosition += size;
+};
+
+void
+FramedSerialBuffer::copyData(uint64_t position, size_t size, std::string& data) const
+{
+    size_t readIndex = static_cast<size_t>(position) & m_mask;
+    size_t firstSize = std::min(size, m_ring.size() - readIndex);
+    data.assign(reinterpret_cast<const char*>(&m_ring[readIndex]), firstSize);
+    if (firstSize < size)
+    {
+        data.append(reinterpret_cast<const char*>(&m_ring[0]), size - firstSize);
+    }
+};
+
+uint32_t
+FramedSerialBuffer::calculateBufferedCrc32(uint64_t position, size_t size) const
+{
+    size_t readIndex = static_cast<size_t>(position) & m_mask;
+    size_t firstSize = std::min(size, m_ring.size() - readIndex);
+    uint32_t crc = calculateCrc32(size > 0 ? &m_ring[readIndex] : nullptr, firstSize);
+    if (firstSize < size)
+    {
+        crc = calculateCrc32(&m_ring[0], size - firstSize, crc);
+    }
+    return (crc);
+};
+
+bool
+FramedSerialBuffer::isMatch(uint64_t position, const std::string& marker) const
+{
+    for (size_t index = 0; index < marker.size(); index++)
+    {
+        if (getByte(position + index) != static_cast<uint8_t>(marker[index]))
+        {
+            return (false);
+        }
+    }
+    return (true);
+};
+
+std::string
+FramedSerialBuffer::getNextPayloadString(const std::string& newDataChunk)
+{
+    appendData(newDataChunk.data(), newDataChunk.size());
+    std::string payload;
+    getNextPayload(payload);
+    return (payload);
+};
+
+bool
+FramedSerialBuffer::getNextPayload(std::string& payload)
+{
+    payload.clear();
+    while (m_readPosition < m_writePosition)
+    {
+        int32_t result{-1};
+        uint8_t firstByte = getByte(m_readPosition);
+        if (firstByte == c_marker0)
+        {
+            result = getNextBinaryPayload(payload);
+        }
+        else if (firstByte == static_cast<uint8_t>(SentinelSerialBuffer::getSerialSentinelBeforePayloadSize()[0]))
+        {
+            result = getNextSentinelPayload(payload);
+        }
+        else
+        {
+            m_disregardedDataCount++;
+            skipToNextFrameStart();
+            continue;
+        }
+
+        if (result == 1)
+        {
+            m_validDeserializeCount++;
+            return (true);
+        }
+        else if (result == 0)
+        {
+            break;
+        }
+        else if (result < 0)
+        {
+            // resynchronize on the next possible frame start
+            m_invalidDeserializeCount++;
+            m_readPosition++;
+            skipToNextFrameStart();
+            UXAS_LOG_WARN(s_typeName(), "::getNextPayload skipped corrupt frame; m_invalidDeserializeCount=", m_invalidDeserializeCount);
+        }
+        // result 2: control frame consumed, continue with the next frame
+    }
+    return (false);
+};
+
+int32_t
+FramedSerialBuffer::getNextBinaryPayload(std::string& payload)
+{
+    size_t bufferedSize = getBufferedSize();
+    if (bufferedSize < 2)
+    {
+        return (0);
+    }
+    if (getByte(m_readPosition + 1) != c_marker1)
+    {
+        return (-1);
+    }
+    if (bufferedSize < s_headerSize)
+    {
+        return (0);
+    }
+
+    uint8_t version = getByte(m_readPosition + 2);
+    uint8_t flags = getByte(m_readPosition + 3);
+    uint32_t payloadSize{0};
+    uint32_t crc{0};
+    for (uint64_t index = 0; index < 4; index++)
+    {
+        payloadSize = (payloadSize << 8) | getByte(m_readPosition + 4 + index);
+        crc = (crc << 8) | getByte(m_readPosition + 8 + index);
+    }
+    if (version < s_binaryFramingVersion || payloadSize > s_maximumPayloadSize)
+    {
+        return (-1);
+    }
+    if (bufferedSize < s_headerSize + payloadSize)
+    {
+        return (0);
+    }
+    if (calculateBufferedCrc32(m_readPosition + s_headerSize, payloadSize) != crc)
+    {
+        UXAS_LOG_WARN(s_typeName(), "::getNextBinaryPayload CRC mismatch for frame with payload size ", payloadSize);
+        return (-1);
+    }
+
+    setFramingVersion(version);
+    if ((flags & s_announceFlag) != 0)
+    {
+        m_readPosition += s_headerSize + payloadSize;
+        return (2);
+    }
+    copyData(m_readPosition + s_headerSize, payloadSize, payload);
+    m_readPosition += s_headerSize + payloadSize;
+    return (1);
+};
+
+int32_t
+FramedSerialBuffer::getNextSentinelPayload(std::string& payload)
+{
+    // "+=+=+=+=" size "#@#@#@#@" payload "!%!%!%!%" checksum "?^?^?^?^"
+    const std::string& beforeSize = SentinelSerialBuffer::getSerialSentinelBeforePayloadSize();
+    const std::string& afterSize = SentinelSerialBuffer::getSerialSentinelAfterPayloadSize();
+    const std::string& beforeChecksum = SentinelSerialBuffer::getSerialSentinelBeforeChecksum();
+    const std::string& afterChecksum = SentinelSerialBuffer::getSerialSentinelAfterChecksum();
+
+    uint64_t endPosition = m_writePosition;
+    uint64_t position = m_readPosition;
+    for (size_t index = 0; index < beforeSize.size(); index++, position++)
+    {
+        if (position >= endPosition)
+        {
+            return (0);
+        }
+        if (getByte(position) != static_cast<uint8_t>(beforeSize[index]))
+        {
+            return (-1);
+        }
+    }
+
+    // decimal number terminated by a marker; returns 1, 0 (incomplete) or -1
+    auto parseNumber = [this, &position, endPosition](const std::string& terminator, uint64_t& value) -> int32_t
+    {
+        value = 0;
+        size_t digitCount{0};
+        while (true)
+        {
+            if (position >= endPosition)
+            {
+                return (0);
+            }
+            uint8_t byte = getByte(position);
+            if (byte < '0' || byte > '9')
+            {
+                break;
+            }
+            if (++digitCount > c_maximumSentinelDigitCount)
+            {
+                return (-1);
+            }
+            value = value * 10 + (byte - '0');
+            position++;
+        }
+        if (digitCount == 0)
+        {
+            return (-1);
+        }
+        if (position + terminator.size() > endPosition)
+        {
+            return (0);
+        }
+        if (!isMatch(position, terminator))
+        {
+            return (-1);
+        }
+        position += terminator.size();
+        return (1);
+    };
+
+    uint64_t payloadSize{0};
+    int32_t result = parseNumber(afterSize, payloadSize);
+    if (result != 1)
+    {
+        return (result);
+    }
+    if (payloadSize > s_maximumPayloadSize)
+    {
+        return (-1);
+    }
+    uint64_t payloadPosition = position;
+    position += payloadSize;
+    if (position + beforeChecksum.size() > endPosition)
+    {
+        return (0);
+    }
+    if (!isMatch(position, beforeChecksum))
+    {
+        return (-1);
+    }
+    position += beforeChecksum.size();
+    uint64_t checksum{0};
+    result = parseNumber(afterChecksum, checksum);
+    if (result != 1)
+    {
+        return (result);
+    }
+
+    copyData(payloadPosition, static_cast<size_t>(payloadSize), payload);
+    if (SentinelSerialBuffer::calculateChecksum(payload) != checksum)
+    {
+        UXAS_LOG_WARN(s_typeName(), "::getNextSentinelPayload checksum mismatch for frame with payload size ", payloadSize);
+        payload.clear();
+        return (-1);
+    }
+    setFramingVersion(s_sentinelFramingVersion);
+    m_readPosition = position;
+    return (1);
+};
+
+void
+FramedSerialBuffer::setFramingVersion(uint8_t framingVersion)
+{
+    m_lastFramingVersion = framingVersion;
+    if (framingVersion > m_peerFramingVersion.load())
+    {
+        UXAS_LOG_INFORM(s_typeName(), "::setFramingVersion peer framing version is ", static_cast<uint32_t>(framingVersion));
+        m_peerFramingVersion = framingVersion;
+    }
+};
+
+void
+FramedSerialBuffer::skipToNextFrameStart()
+{
+    uint8_t sentinelStart = static_cast<uint8_t>(SentinelSerialBuffer::getSerialSentinelBeforePayloadSize()[0]);
+    while (m_readPosition < m_writePosition)
+    {
+        uint8_t byte = getByte(m_readPosition);
+        if (byte == c_marker0 || byte == sentinelStart)
+        {
+            break;
+        }
+        m_readPosition++;
+    }
+};
+
+}; //namespace common
+}; //namespace uxas
@@ -0,0 +1,233 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_COMMON_FRAMED_SERIAL_BUFFER_H
+#define UXAS_COMMON_FRAMED_SERIAL_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace uxas
+{
+namespace common
+{
+
+/** \class FramedSerialBuffer
+ *
+ * \par Description:
+ * Framing codec for byte-stream links (TCP, serial) and whole-message links
+ * (Zyre). Replaces the sentinel framing of <B><i>SentinelSerialBuffer</i></B>
+ * with a length-prefixed binary frame:
+ * <ul style="padding-left:1em;margin-left:0">
+ * <li>2 bytes: marker 0xE5 0xF7
+ * <li>1 byte: framing version (2)
+ * <li>1 byte: flags (0x01 = version announcement without payload)
+ * <li>4 bytes: payload length (big endian)
+ * <li>4 bytes: CRC-32 (IEEE) of the payload (big endian)
+ * <li>payload
+ * </ul>
+ *
+ * Received data is appended to a ring buffer; frames are located from the
+ * length header, the CRC is computed in one pass and consumed bytes are
+ * released by advancing the read position (no erasure from the front of a
+ * string). Legacy sentinel frames (framing version 1) are still decoded, so
+ * both codecs can share a link.
+ *
+ * \par Version negotiation:
+ * Each decoded frame records the framing version of the peer. A link sends
+ * <B><i>createAnnounceFrame</i></B> when it is established (legacy receivers
+ * disregard it as data outside a sentinel frame) and frames its messages
+ * with <B><i>getSendFramingVersion</i></B>, i.e., with sentinel framing
+ * until the peer is known to decode binary frames.
+ *
+ * \par Threading:
+ * Decoding is single-threaded; the peer framing version may be read from
+ * other threads.
+ *
+ * \n
+ */
+class FramedSerialBuffer
+{
+public:
+
+    static const std::string&
+    s_typeName() { static std::string s_string("FramedSerialBuffer"); return (s_string); };
+
+    /** \brief sentinel framing (see SentinelSerialBuffer) */
+    static const uint8_t s_sentinelFramingVersion{1};
+    /** \brief length-prefixed binary framing */
+    static const uint8_t s_binaryFramingVersion{2};
+    static const size_t s_headerSize{12};
+    static const uint8_t s_announceFlag{0x01};
+    /** \brief frames announcing a larger payload are treated as corrupt */
+    static const uint32_t s_maximumPayloadSize{64 * 1024 * 1024};
+
+    FramedSerialBuffer() { };
+
+private:
+
+    /** \brief Copy construction not permitted */
+    FramedSerialBuffer(FramedSerialBuffer const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(FramedSerialBuffer const&) = delete;
+
+public:
+
+    /** \brief CRC-32 (IEEE 802.3, reflected 0xEDB88320). Passing the result
+     * of a previous call as <B><i>crc</i></B> continues the computation over
+     * non-contiguous data.
+     *
+     * @param data bytes
+     * @param size number of bytes
+     * @param crc CRC of the preceding bytes (0 to start)
+     * @return CRC-32 of all bytes so far
+     */
+    static uint32_t
+    calculateCrc32(const void* data, size_t size, uint32_t crc = 0);
+
+    /** \brief Appends a frame containing <B><i>payload</i></B> to
+     * <B><i>frame</i></B>.
+     *
+     * @param payload message data
+     * @param framingVersion binary or sentinel framing
+     * @param frame buffer to append to
+     */
+    static void
+    appendFramedString(const std::string& payload, uint8_t framingVersion, std::string& frame);
+
+    static std::string
+    createFramedString(const std::string& payload, uint8_t framingVersion);
+
+    /** \brief Binary frame without payload announcing the framing version of
+     * the sender.
+     */
+    static std::string
+    createAnnounceFrame();
+
+    /** \brief Highest framing version this side sends (sentinel or binary);
+     * the default is binary.
+     */
+    void
+    setLocalFramingVersion(uint8_t framingVersion);
+
+    uint8_t
+    getLocalFramingVersion() const { return (m_localFramingVersion); };
+
+    /** \brief Highest framing version decoded from the peer (a peer that
+     * announced binary framing may still send sentinel frames until it
+     * receives the announcement of this side).
+     *
+     * @return 0 if no frame was decoded yet
+     */
+    uint8_t
+    getPeerFramingVersion() const { return (m_peerFramingVersion.load()); };
+
+    /** \brief Forgets the peer framing version (e.g., after reconnecting). */
+    void
+    resetPeerFramingVersion() { m_peerFramingVersion = 0; };
+
+    /** \brief Framing version of the most recently decoded frame (including
+     * announcements), for links that share one buffer among several peers.
+     *
+     * @return 0 if no frame was decoded yet
+     */
+    uint8_t
+    getLastFramingVersion() const { return (m_lastFramingVersion); };
+
+    /** \brief Framing version to send to the peer of this buffer: binary if
+     * both sides support it, otherwise sentinel.
+     */
+    uint8_t
+    getSendFramingVersion() const
+    {
+        return (m_localFramingVersion >= s_binaryFramingVersion && m_peerFramingVersion.load() >= s_binaryFramingVersion
+                ? s_binaryFramingVersion : s_sentinelFramingVersion);
+    };
+
+    /** \brief Appends received bytes to the ring buffer. */
+    void
+    appendData(const void* data, size_t size);
+
+    /** \brief Decodes the next complete frame. Corrupt frames and data
+     * outside frames are skipped and counted.
+     *
+     * @param payload set to the payload of the next frame
+     * @return true if a frame was decoded
+     */
+    bool
+    getNextPayload(std::string& payload);
+
+    /** \brief Drop-in replacement for
+     * <B><i>SentinelSerialBuffer::getNextPayloadString</i></B>: appends
+     * <B><i>newDataChunk</i></B> and returns the next payload (empty if no
+     * complete frame is buffered).
+     */
+    std::string
+    getNextPayloadString(const std::string& newDataChunk);
+
+    size_t
+    getBufferedSize() const { return (static_cast<size_t>(m_writePosition - m_readPosition)); };
+
+    uint32_t m_validDeserializeCount{0};
+    uint32_t m_invalidDeserializeCount{0};
+    uint32_t m_disregardedDataCount{0};
+
+private:
+
+    uint8_t
+    getByte(uint64_t position) const { return (m_ring[static_cast<size_t>(position) & m_mask]); };
+
+    /** \brief Copies <B><i>size</i></B> buffered bytes starting at
+     * <B><i>position</i></B> (the copy may span the end of the ring). */
+    void
+    copyData(uint64_t position, size_t size, std::string& data) const;
+
+    uint32_t
+    calculateBufferedCrc32(uint64_t position, size_t size) const;
+
+    bool
+    isMatch(uint64_t position, const std::string& marker) const;
+
+    /** \brief Parses a binary frame at the read position.
+     * @return 1 if decoded, 0 if incomplete, -1 if corrupt */
+    int32_t
+    getNextBinaryPayload(std::string& payload);
+
+    /** \brief Parses a sentinel frame at the read position.
+     * @return 1 if decoded, 0 if incomplete, -1 if corrupt */
+    int32_t
+    getNextSentinelPayload(std::string& payload);
+
+    /** \brief Records the framing version of a decoded frame. */
+    void
+    setFramingVersion(uint8_t framingVersion);
+
+    /** \brief Discards bytes up to the next possible frame start. */
+    void
+    skipToNextFrameStart();
+
+    std::vector<uint8_t> m_ring;
+    size_t m_mask{0};
+    /** \brief monotonic positions; ring index is position & m_mask */
+    uint64_t m_readPosition{0};
+    uint64_t m_writePosition{0};
+
+    uint8_t m_localFramingVersion{s_binaryFramingVersion};
+    std::atomic<uint8_t> m_peerFramingVersion{0};
+    uint8_t m_lastFramingVersion{0};
+};
+
+}; //namespace common
+}; //namespace uxas
+
+#endif /* UXAS_COMMON_FRAMED_SERIAL_BUFFER_H */
@@ -0,0 +1,133 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#include "UxAS_LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace uxas
+{
+namespace common
+{
+
+namespace
+{
+
+// 16 buckets per power of two
+const uint32_t c_subBucketBits{4};
+const uint64_t c_subBucketCount{1ull << c_subBucketBits};
+const uint64_t c_maximumTrackedValue{std::numeric_limits<uint32_t>::max()};
+
+uint32_t
+getMostSignificantBit(uint64_t value)
+{
+    uint32_t bit{0};
+    while (value >>= 1)
+    {
+        bit++;
+    }
+    return (bit);
+}
+
+} //namespace
+
+LatencyHistogram::LatencyHistogram()
+: m_bucketCounts(getBucketIndex(c_maximumTrackedValue) + 1, 0)
+{
+};
+
+size_t
+LatencyHistogram::getBucketIndex(uint64_t value)
+{
+    value = std::min(value, c_maximumTrackedValue);
+    if (value < c_subBucketCount)
+    {
+        return (static_cast<size_t>(value));
+    }
+    // group 1 holds [16, 32) in buckets of 1, group 2 [32, 64) in buckets of 2, ...
+    uint32_t shift = getMostSignificantBit(value) - c_subBucketBits;
+    return (static_cast<size_t>((shift + 1) * c_subBucketCount + ((value >> shift) & (c_subBucketCount - 1))));
+};
+
+uint64_t
+LatencyHistogram::getBucketHighestValue(size_t bucketIndex)
+{
+    if (bucketIndex < c_subBucketCount)
+    {
+        return (bucketIndex);
+    }
+    uint32_t shift = static_cast<uint32_t>(bucketIndex / c_subBucketCount) - 1;
+    uint64_t lowestValue = (c_subBucketCount + bucketIndex % c_subBucketCount) << shift;
+    return (lowestValue + (1ull << shift) - 1);
+};
+
+void
+LatencyHistogram::record(uint64_t value)
+{
+    m_bucketCounts[getBucketIndex(value)]++;
+    m_minimum = (m_count > 0) ? std::min(m_minimum, value) : value;
+    m_maximum = std::max(m_maximum, value);
+    m_sum += value;
+    m_count++;
+};
+
+void
+LatencyHistogram::add(const LatencyHistogram& histogram)
+{
+    if (histogram.m_count == 0)
+    {
+        return;
+    }
+    for (size_t bucketIndex = 0; bucketIndex < m_bucketCounts.size(); bucketIndex++)
+    {
+        m_bucketCounts[bucketIndex] += histogram.m_bucketCounts[bucketIndex];
+    }
+    m_minimum = (m_count > 0) ? std::min(m_minimum, histogram.m_minimum) : histogram.m_minimum;
+    m_maximum = std::max(m_maximum, histogram.m_maximum);
+    m_sum += histogram.m_sum;
+    m_count += histogram.m_count;
+};
+
+void
+LatencyHistogram::reset()
+{
+    std::fill(m_bucketCounts.begin(), m_bucketCounts.end(), 0);
+    m_count = 0;
+    m_sum = 0;
+    m_minimum = 0;
+    m_maximum = 0;
+};
+
+uint64_t
+LatencyHistogram::getValueAtPercentile(double percentile) const
+{
+    if (m_count == 0)
+    {
+        return (0);
+    }
+    percentile = std::min(std::max(percentile, 0.0), 100.0);
+    uint64_t targetCount = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(m_count)));
+    targetCount = std::max<uint64_t>(targetCount, 1);
+    uint64_t cumulativeCount{0};
+    for (size_t bucketIndex = 0; bucketIndex < m_bucketCounts.size(); bucketIndex++)
+    {
+        cumulativeCount += m_bucketCounts[bucketIndex];
+        if (cumulativeCount >= targetCount)
+        {
+            // the last bucket also holds the values beyond the tracked range
+            return (bucketIndex + 1 < m_bucketCounts.size() ? std::min(getBucketHighestValue(bucketIndex), m_maximum) : m_maximum);
+        }
+    }
+    return (m_maximum);
+};
+
+}; //namespace common
+}; //namespace uxas
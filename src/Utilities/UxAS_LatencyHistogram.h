@@ -0,0 +1,98 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_COMMON_LATENCY_HISTOGRAM_H
+#define UXAS_COMMON_LATENCY_HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace uxas
+{
+namespace common
+{
+
+/** \class LatencyHistogram
+ * 
+ * \par Description:
+ * Fixed-memory, log-linear (HDR-style) histogram of non-negative integer 
+ * values (e.g., microseconds or queue depths). Values below 16 are counted 
+ * exactly; above, each power-of-two range is split into 16 equal buckets, so 
+ * reported values are within 6.25% of the recorded ones. Values above 
+ * 2^32 - 1 are counted in the last bucket. Recording is O(1) and does not 
+ * allocate.
+ * 
+ * \par Thread safety:
+ * Not thread-safe; the owner serializes recording and reading.
+ * 
+ * \n
+ */
+class LatencyHistogram
+{
+public:
+
+    static const std::string&
+    s_typeName() { static std::string s_string("LatencyHistogram"); return (s_string); };
+
+    LatencyHistogram();
+
+    void
+    record(uint64_t value);
+
+    /** \brief Adds the counts of another histogram. */
+    void
+    add(const LatencyHistogram& histogram);
+
+    void
+    reset();
+
+    uint64_t
+    getCount() const { return (m_count); };
+
+    uint64_t
+    getMinimum() const { return (m_count > 0 ? m_minimum : 0); };
+
+    uint64_t
+    getMaximum() const { return (m_maximum); };
+
+    double
+    getMean() const { return (m_count > 0 ? static_cast<double>(m_sum) / static_cast<double>(m_count) : 0.0); };
+
+    /** \brief Value at or below which the given percentage of recorded values 
+     * fall (upper bound of the containing bucket, limited to the maximum).
+     * 
+     * @param percentile percentage (0 to 100)
+     * @return value; 0 if empty
+     */
+    uint64_t
+    getValueAtPercentile(double percentile) const;
+
+private:
+
+    static
+    size_t
+    getBucketIndex(uint64_t value);
+
+    static
+    uint64_t
+    getBucketHighestValue(size_t bucketIndex);
+
+    std::vector<uint32_t> m_bucketCounts;
+    uint64_t m_count{0};
+    uint64_t m_sum{0};
+    uint64_t m_minimum{0};
+    uint64_t m_maximum{0};
+};
+
+}; //namespace common
+}; //namespace uxas
+
+#endif /* UXAS_COMMON_LATENCY_HISTOGRAM_H */
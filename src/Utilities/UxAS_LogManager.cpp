@@ -15,6 +15,7 @@
 
 #include "stdUniquePtr.h"
 
+#include <chrono>
 #include <iostream>
 
 #define LOG_MANAGER_LOCAL_LOG_MESSAGE(message) std::cout << message << std::endl; std::cout.flush();
@@ -26,6 +27,33 @@ namespace common
 namespace log
 {
 
+namespace
+{
+
+/** \brief Per-thread handle on the thread's log record ring. The ring is 
+ * shared with the log manager, which removes it once the thread has exited 
+ * and the ring has been drained. */
+struct ThreadLogRecordRing
+{
+    ~ThreadLogRecordRing()
+    {
+        if (m_ring)
+        {
+            m_ring->m_isProducerExited = true;
+        }
+    };
+
+    std::shared_ptr<LogRecordRing> m_ring;
+};
+
+thread_local ThreadLogRecordRing t_threadLogRecordRing;
+
+const uint32_t c_droppedRecordReportPeriod_ms{1000};
+
+} //namespace
+
+const size_t LogRecordRing::c_recordSlotSize;
+
 std::unique_ptr<LogManager> LogManager::s_instance = nullptr;
 
 LogManager&
@@ -60,6 +88,7 @@ LogManager::getInstance()
 
 LogManager::~LogManager()
 {
+    setAsynchronous(false, m_ringCapacity);
     for (auto& loggerIt : m_loggers)
     {
         if (loggerIt)
@@ -246,6 +275,259 @@ LogManager::setLoggerSeverityLevelByTypeAndNameImpl(const std::string& loggerTyp
     m_mutex.unlock();
 };
 
+void
+LogManager::setAsynchronous(bool isAsynchronous, uint32_t ringCapacity)
+{
+    std::unique_ptr<std::thread> asynchronousLoggingThread;
+    {
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        if (isAsynchronous)
+        {
+            // applies to rings of threads that have not logged yet
+            if (ringCapacity > 0)
+            {
+                m_ringCapacity = ringCapacity;
+            }
+            if (!m_asynchronousLoggingThread)
+            {
+                m_isTerminateAsynchronousLogging = false;
+                m_asynchronousLoggingThread.reset(new std::thread(&LogManager::executeAsynchronousLogging, this));
+            }
+            m_isAsynchronous = true;
+            return;
+        }
+        m_isAsynchronous = false;
+        m_isTerminateAsynchronousLogging = true;
+        asynchronousLoggingThread = std::move(m_asynchronousLoggingThread);
+    }
+
+    if (asynchronousLoggingThread)
+    {
+        m_asynchronousLoggingCondition.notify_all();
+        if (asynchronousLoggingThread->joinable())
+        {
+            asynchronousLoggingThread->join();
+        }
+        // threads that found asynchronous logging enabled may still be pushing 
+        // (any later push finds it disabled, see isBeginPushRecord)
+        std::vector<std::shared_ptr<LogRecordRing>> rings;
+        {
+            std::lock_guard<std::mutex> lock(m_ringsMutex);
+            rings = m_rings;
+        }
+        for (auto& ring : rings)
+        {
+            while (ring->m_isPushing)
+            {
+                std::this_thread::yield();
+            }
+        }
+        // records pushed by threads that were logging while the thread stopped
+        while (drainRings() > 0)
+        {
+        }
+    }
+};
+
+uint64_t
+LogManager::getDroppedRecordCount()
+{
+    std::lock_guard<std::mutex> lock(m_ringsMutex);
+    uint64_t droppedRecordCount = m_removedRingsDroppedRecordCount;
+    for (auto& ring : m_rings)
+    {
+        droppedRecordCount += ring->m_droppedCount;
+    }
+    return (droppedRecordCount);
+};
+
+bool
+LogManager::isBeginPushRecord(LogSeverityLevel severityLevel, LogRecordRing*& ring)
+{
+    ring = nullptr;
+    auto& threadRing = t_threadLogRecordRing.m_ring;
+    if (!threadRing)
+    {
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        if (!m_asynchronousLoggingThread)
+        {
+            return (false);
+        }
+        threadRing = std::make_shared<LogRecordRing>(m_ringCapacity);
+        m_rings.push_back(threadRing);
+    }
+
+    // flag, then mode (both sequentially consistent): either setAsynchronous(false) 
+    // sees the flag and waits for the push, or this thread sees the mode change
+    threadRing->m_isPushing = true;
+    if (!m_isAsynchronous)
+    {
+        threadRing->m_isPushing = false;
+        drainThreadRing();
+        return (false);
+    }
+
+    if (threadRing->isFull())
+    {
+        if (severityLevel != LogSeverityLevel::UXASERROR)
+        {
+            threadRing->m_isPushing = false;
+            threadRing->m_droppedCount++;
+            m_asynchronousLoggingCondition.notify_one();
+            return (true);
+        }
+        // errors are never dropped: make room by writing this thread's records (waits for the 
+        // asynchronous logging thread if it is writing them)
+        drainRing(*threadRing, threadRing->capacity());
+    }
+    ring = threadRing.get();
+    return (true);
+};
+
+void
+LogManager::endPushRecord(LogRecordRing& ring)
+{
+    ring.m_isPushing = false;
+    // wake the asynchronous logging thread early to avoid filling the ring
+    if (ring.size() * 2 > ring.capacity())
+    {
+        m_asynchronousLoggingCondition.notify_one();
+    }
+};
+
+void
+LogManager::drainThreadRing()
+{
+    auto& ring = t_threadLogRecordRing.m_ring;
+    if (ring && ring->size() > 0)
+    {
+        drainRing(*ring, ring->capacity());
+    }
+};
+
+void
+LogManager::outputRecord(const LogRecord& record)
+{
+    // format outside of the logger mutex
+    auto headerAndData = uxas::stduxas::make_unique<uxas::common::log::HeadLogData>();
+    headerAndData->m_time_ms = record.m_time_ms;
+    if (m_isLoggingThreadId)
+    {
+        headerAndData->m_threadID << record.m_threadId;
+    }
+    headerAndData->m_severityLevel = record.m_severityLevel;
+    headerAndData->m_severityLevelString = getSeverityLevelString(record.m_severityLevel);
+    record.format(headerAndData->m_message);
+
+    m_mutex.lock();
+    outputToLoggers(std::move(headerAndData));
+    m_mutex.unlock();
+};
+
+void
+LogManager::executeAsynchronousLogging()
+{
+    auto reportTime = std::chrono::steady_clock::now();
+    while (true)
+    {
+        size_t recordCount = drainRings();
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - reportTime >= std::chrono::milliseconds(c_droppedRecordReportPeriod_ms))
+        {
+            reportDroppedRecords();
+            reportTime = now;
+        }
+
+        std::unique_lock<std::mutex> lock(m_ringsMutex);
+        if (m_isTerminateAsynchronousLogging)
+        {
+            break;
+        }
+        if (recordCount == 0)
+        {
+            m_asynchronousLoggingCondition.wait_for(lock, std::chrono::milliseconds(m_asynchronousLoggingPeriod_ms));
+        }
+    }
+
+    drainRings();
+    reportDroppedRecords();
+};
+
+size_t
+LogManager::drainRings()
+{
+    std::vector<std::shared_ptr<LogRecordRing>> rings;
+    {
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        for (auto itRing = m_rings.begin(); itRing != m_rings.end();)
+        {
+            // exited flag first: the final records of an exited thread are then visible
+            if ((*itRing)->m_isProducerExited && (*itRing)->size() == 0)
+            {
+                m_removedRingsDroppedRecordCount += (*itRing)->m_droppedCount;
+                itRing = m_rings.erase(itRing);
+            }
+            else
+            {
+                ++itRing;
+            }
+        }
+        rings = m_rings;
+    }
+
+    size_t recordCount{0};
+    for (auto& ring : rings)
+    {
+        // at most one ring's worth per pass, so that a busy thread does not starve the others
+        recordCount += drainRing(*ring, ring->capacity());
+    }
+    return (recordCount);
+};
+
+size_t
+LogManager::drainRing(LogRecordRing& ring, size_t maximumRecordCount)
+{
+    std::lock_guard<std::mutex> lock(ring.m_consumerMutex);
+    size_t recordCount{0};
+    while (recordCount < maximumRecordCount && ring.consume([this](const LogRecord& record) { outputRecord(record); }))
+    {
+        recordCount++;
+    }
+    return (recordCount);
+};
+
+void
+LogManager::reportDroppedRecords()
+{
+    uint64_t droppedRecordCount = getDroppedRecordCount();
+    if (droppedRecordCount > m_reportedDroppedRecordCount)
+    {
+        LogRecordImpl<const char*, uint64_t, const char*, uint64_t, const char*> record(
+                uxas::common::Time::getInstance().getUtcTimeSinceEpoch_ms(), LogSeverityLevel::UXASWARNING,
+                "LogManager dropped ", droppedRecordCount - m_reportedDroppedRecordCount,
+                " log records (", droppedRecordCount, " total) because a logging thread's ring was full");
+        outputRecord(record);
+        m_reportedDroppedRecordCount = droppedRecordCount;
+    }
+};
+
+const std::string&
+LogManager::getSeverityLevelString(LogSeverityLevel severityLevel)
+{
+    switch (severityLevel)
+    {
+        case LogSeverityLevel::UXASINFO:
+            return (infoString());
+        case LogSeverityLevel::UXASWARNING:
+            return (warningString());
+        case LogSeverityLevel::UXASERROR:
+            return (errorString());
+        default:
+            return (debugString());
+    };
+};
+
 std::string
 LogManager::getDate()
 {
@@ -12,12 +12,15 @@
 
 #include "UxAS_ConfigurationManager.h"
 #include "UxAS_LoggerBase.h"
+#include "UxAS_LogRecord.h"
 #include "UxAS_LogSeverityLevel.h"
 #include "UxAS_Time.h"
 
 #include "stdUniquePtr.h"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <string>
 #include <sstream>
@@ -39,6 +42,16 @@ namespace log
  * \par Description:
  * Singleton pattern
  * 
+ * \par Asynchronous Logging:
+ * By default, <B><i>log</i></B> formats the statement and writes it to all 
+ * loggers on the calling thread, serialized by one mutex. In asynchronous 
+ * mode, <B><i>log</i></B> only captures the arguments and pushes the record 
+ * into a lock-free ring owned by the calling thread; a background thread 
+ * formats the records and writes them to the loggers (ordered per thread). 
+ * If a ring is full, the record is dropped and counted (for errors, the 
+ * thread writes its queued records itself to make room), and the number of 
+ * dropped records is logged.
+ * 
  * \n
  */
 class LogManager
@@ -100,6 +113,23 @@ public:
 
     void
     setLoggersSeverityLevelByLoggerTypeAndName(const std::string& loggerType, const std::string& name, LogSeverityLevel severityLevelThreshold);
+
+    /** \brief Enables or disables asynchronous logging (see class description). 
+     * Disabling writes all queued records before returning.
+     * 
+     * @param isAsynchronous true to enable asynchronous logging
+     * @param ringCapacity capacity (records) of the ring of each logging thread
+     */
+    void
+    setAsynchronous(bool isAsynchronous, uint32_t ringCapacity);
+
+    bool
+    getIsAsynchronous() const { return (m_isAsynchronous); };
+
+    /** \brief Number of records dropped in asynchronous mode because a 
+     * thread's ring was full. */
+    uint64_t
+    getDroppedRecordCount();
         
     template<LogSeverityLevel logSeverity, typename...Args>
     void
@@ -107,6 +137,28 @@ public:
     {
         if (logSeverity >= m_severityLevelThreshold)
         {
+            if (m_isAsynchronous)
+            {
+                // formatting is deferred to the asynchronous logging thread
+                auto time_ms = uxas::common::Time::getInstance().getUtcTimeSinceEpoch_ms();
+                LogRecordRing* ring{nullptr};
+                if (isBeginPushRecord(logSeverity, ring))
+                {
+                    if (ring)
+                    {
+                        ring->emplace<LogRecordImpl<Args...>>(time_ms, logSeverity, std::move(args)...);
+                        endPushRecord(*ring);
+                    }
+                    return;
+                }
+                // synchronous fall-back (asynchronous logging stopped), after this thread's queued records
+                LogRecordImpl<Args...> record(time_ms, logSeverity, std::move(args)...);
+                outputRecord(record);
+                return;
+            }
+
+            // records this thread queued before asynchronous logging was disabled are written first
+            drainThreadRing();
             m_mutex.lock();
             switch (logSeverity)
             {
@@ -183,6 +235,59 @@ private:
         }
     };
 
+    /** \brief Prepares the calling thread's ring for one record. If the ring 
+     * is full, the record is dropped and counted, unless it is an error: the 
+     * thread then writes its queued records itself to make room, so that 
+     * errors are neither dropped nor written ahead of earlier records.
+     * 
+     * @param severityLevel severity of the record
+     * @param ring set to the ring to emplace the record into (then call 
+     * <B><i>endPushRecord</i></B>), or null if the record is dropped
+     * @return false if asynchronous logging is stopped and the record must be 
+     * written synchronously (the thread's queued records have been written)
+     */
+    bool
+    isBeginPushRecord(LogSeverityLevel severityLevel, LogRecordRing*& ring);
+
+    /** \brief Completes a push started by <B><i>isBeginPushRecord</i></B>. */
+    void
+    endPushRecord(LogRecordRing& ring);
+
+    /** \brief Writes the records queued in the calling thread's ring, if any. */
+    void
+    drainThreadRing();
+
+    /** \brief Formats a record and writes it to the loggers. */
+    void
+    outputRecord(const LogRecord& record);
+
+    /** \brief Asynchronous logging thread: drains the rings of all logging 
+     * threads until stopped, then drains them once more. */
+    void
+    executeAsynchronousLogging();
+
+    /** \brief Writes the records queued in all rings.
+     * 
+     * @return number of records written
+     */
+    size_t
+    drainRings();
+
+    /** \brief Writes up to <B><i>maximumRecordCount</i></B> records queued in 
+     * <B><i>ring</i></B>.
+     * 
+     * @return number of records written
+     */
+    size_t
+    drainRing(LogRecordRing& ring, size_t maximumRecordCount);
+
+    /** \brief Logs a warning if records were dropped since the last report. */
+    void
+    reportDroppedRecords();
+
+    static const std::string&
+    getSeverityLevelString(LogSeverityLevel severityLevel);
+
     std::string
     getDate();
 
@@ -195,6 +300,23 @@ private:
 
     LogSeverityLevel m_severityLevelThreshold = LogSeverityLevel::UXASDEBUG;
     std::unique_ptr<uxas::common::log::HeadLogData> m_currentHeaderAndData;
+
+    std::atomic<bool> m_isAsynchronous{false};
+    uint32_t m_ringCapacity{1024};
+    /** \brief maximum period the asynchronous logging thread sleeps when all rings are empty */
+    uint32_t m_asynchronousLoggingPeriod_ms{10};
+
+    /** \brief protects <B><i>m_rings</i></B> and the asynchronous logging thread state */
+    std::mutex m_ringsMutex;
+    std::condition_variable m_asynchronousLoggingCondition;
+    std::vector<std::shared_ptr<LogRecordRing>> m_rings;
+    bool m_isTerminateAsynchronousLogging{false};
+    std::unique_ptr<std::thread> m_asynchronousLoggingThread;
+
+    /** \brief dropped records of rings already removed (threads exited) */
+    uint64_t m_removedRingsDroppedRecordCount{0};
+    /** \brief dropped records already reported (asynchronous logging thread only) */
+    uint64_t m_reportedDroppedRecordCount{0};
 };
 
 }; //namespace log
@@ -0,0 +1,277 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_COMMON_LOG_LOG_RECORD_H
+#define UXAS_COMMON_LOG_LOG_RECORD_H
+
+#include "UxAS_LogSeverityLevel.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace uxas
+{
+namespace common
+{
+namespace log
+{
+
+/** \class LogRecord
+ * 
+ * \par Description:
+ * Unformatted log statement: header fields captured when the statement is 
+ * logged, and the arguments, which are only formatted (by 
+ * <B><i>format</i></B>) on the asynchronous logging thread.
+ * 
+ * \n
+ */
+class LogRecord
+{
+public:
+
+    LogRecord(int64_t time_ms, LogSeverityLevel severityLevel)
+    : m_time_ms(time_ms), m_threadId(std::this_thread::get_id()), m_severityLevel(severityLevel) { };
+
+    virtual
+    ~LogRecord() { };
+
+    /** \brief Writes the captured arguments to <B><i>stream</i></B>. */
+    virtual
+    void
+    format(std::ostream& stream) const = 0;
+
+    int64_t m_time_ms{0};
+    std::thread::id m_threadId;
+    LogSeverityLevel m_severityLevel{LogSeverityLevel::UXASDEBUG};
+};
+
+/** \brief Type in which a log argument is captured. Character pointers are 
+ * copied into strings, since the characters they point to (e.g., 
+ * <B><i>std::exception::what</i></B>) can be gone when the record is formatted. */
+template <typename T>
+struct LogRecordArgument { typedef T type; };
+
+template <>
+struct LogRecordArgument<const char*> { typedef std::string type; };
+
+template <>
+struct LogRecordArgument<char*> { typedef std::string type; };
+
+template <typename...Args>
+class LogRecordImpl : public LogRecord
+{
+public:
+
+    LogRecordImpl(int64_t time_ms, LogSeverityLevel severityLevel, typename LogRecordArgument<Args>::type...args)
+    : LogRecord(time_ms, severityLevel), m_arguments(std::move(args)...) { };
+
+    void
+    format(std::ostream& stream) const override
+    {
+        formatArguments<0>(stream);
+    };
+
+private:
+
+    template <size_t index>
+    typename std::enable_if<index < sizeof...(Args)>::type
+    formatArguments(std::ostream& stream) const
+    {
+        stream << std::get<index>(m_arguments);
+        formatArguments<index + 1>(stream);
+    };
+
+    template <size_t index>
+    typename std::enable_if<index == sizeof...(Args)>::type
+    formatArguments(std::ostream&) const { };
+
+    std::tuple<typename LogRecordArgument<Args>::type...> m_arguments;
+};
+
+/** \class LogRecordRing
+ * 
+ * \par Description:
+ * Bounded, lock-free, single-producer/single-consumer ring of log records. 
+ * Each logging thread owns one ring (producer); the asynchronous logging 
+ * thread drains all rings (consumer). Records are constructed in place in 
+ * the ring's slots, so queuing a record does not allocate (only records 
+ * larger than <B><i>c_recordSlotSize</i></B> are allocated). When full, the 
+ * caller drops the record, or consumes the ring itself first (consumers are 
+ * serialized by <B><i>m_consumerMutex</i></B>).
+ * 
+ * \n
+ */
+class LogRecordRing
+{
+public:
+
+    /** \brief records up to this size (header and about five string 
+     * arguments) are constructed in the ring's slots */
+    static const size_t c_recordSlotSize{192};
+
+    /** \brief Constructs the ring.
+     * 
+     * @param capacity number of records (rounded up to a power of two)
+     */
+    explicit
+    LogRecordRing(uint32_t capacity)
+    {
+        size_t roundedCapacity{2};
+        while (roundedCapacity < capacity)
+        {
+            roundedCapacity <<= 1;
+        }
+        m_slots.reset(new Slot[roundedCapacity]);
+        m_mask = roundedCapacity - 1;
+    };
+
+    ~LogRecordRing()
+    {
+        while (consume([](const LogRecord&) { }))
+        {
+        }
+    };
+
+private:
+
+    /** \brief Copy construction not permitted */
+    LogRecordRing(LogRecordRing const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(LogRecordRing const&) = delete;
+
+public:
+
+    /** \brief Producer only. */
+    bool
+    isFull() const
+    {
+        return (m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_acquire) > m_mask);
+    };
+
+    /** \brief Producer only. Constructs a <B><i>Record</i></B> from 
+     * <B><i>args</i></B> in the next slot and queues it. The ring must not 
+     * be full.
+     */
+    template <typename Record, typename...Args>
+    void
+    emplace(Args&&...args)
+    {
+        typedef std::integral_constant<bool, sizeof(Record) <= sizeof(Storage) && alignof(Record) <= alignof(Storage)> IsInSlot;
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        auto& slot = m_slots[tail & m_mask];
+        slot.m_record = constructRecord<Record>(slot, IsInSlot(), std::forward<Args>(args)...);
+        slot.m_isInSlot = IsInSlot::value;
+        m_tail.store(tail + 1, std::memory_order_release);
+    };
+
+    /** \brief Consumer only. Passes the oldest record to 
+     * <B><i>function</i></B>, then removes it.
+     * 
+     * @return false if the ring is empty
+     */
+    template <typename Function>
+    bool
+    consume(Function function)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+        {
+            return (false);
+        }
+        auto& slot = m_slots[head & m_mask];
+        function(static_cast<const LogRecord&>(*slot.m_record));
+        if (slot.m_isInSlot)
+        {
+            slot.m_record->~LogRecord();
+        }
+        else
+        {
+            delete slot.m_record;
+        }
+        slot.m_record = nullptr;
+        m_head.store(head + 1, std::memory_order_release);
+        return (true);
+    };
+
+    /** \brief Approximate number of queued records (exact for the producer). */
+    size_t
+    size() const
+    {
+        return (m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_acquire));
+    };
+
+    size_t
+    capacity() const
+    {
+        return (m_mask + 1);
+    };
+
+    /** \brief records dropped because the ring was full */
+    std::atomic<uint64_t> m_droppedCount{0};
+
+    /** \brief set when the producing thread exits; the ring is removed once drained */
+    std::atomic<bool> m_isProducerExited{false};
+
+    /** \brief set by the producer while it checks the logging mode and pushes 
+     * a record, so that disabling asynchronous logging can wait for the push */
+    std::atomic<bool> m_isPushing{false};
+
+    /** \brief serializes consumers: the asynchronous logging thread, and the 
+     * producer writing its own queued records ahead of a synchronous record */
+    std::mutex m_consumerMutex;
+
+private:
+
+    typedef std::aligned_storage<c_recordSlotSize, alignof(std::max_align_t)>::type Storage;
+
+    struct Slot
+    {
+        Storage m_storage;
+        LogRecord* m_record{nullptr};
+        bool m_isInSlot{false};
+    };
+
+    template <typename Record, typename...Args>
+    static LogRecord*
+    constructRecord(Slot& slot, std::true_type, Args&&...args)
+    {
+        return (new (&slot.m_storage) Record(std::forward<Args>(args)...));
+    };
+
+    template <typename Record, typename...Args>
+    static LogRecord*
+    constructRecord(Slot&, std::false_type, Args&&...args)
+    {
+        return (new Record(std::forward<Args>(args)...));
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_mask{0};
+    std::atomic<size_t> m_head{0};
+    /** \brief keeps producer and consumer indices on separate cache lines */
+    char m_padding[64];
+    std::atomic<size_t> m_tail{0};
+};
+
+}; //namespace log
+}; //namespace common
+}; //namespace uxas
+
+#endif /* UXAS_COMMON_LOG_LOG_RECORD_H */
@@ -0,0 +1,606 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#include "UxAS_MessageRecording.h"
+
+#include "UxAS_Log.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace uxas
+{
+namespace common
+{
+namespace log
+{
+
+namespace
+{
+
+void
+putUint16(std::string& buffer, uint16_t value)
+{
+    buffer.push_back(static_cast<char>((value >> 8) & 0xFF));
+    buffer.push_back(static_cast<char>(value & 0xFF));
+}
+
+void
+putUint32(std::string& buffer, uint32_t value)
+{
+    buffer.push_back(static_cast<char>((value >> 24) & 0xFF));
+    buffer.push_back(static_cast<char>((value >> 16) & 0xFF));
+    buffer.push_back(static_cast<char>((value >> 8) & 0xFF));
+    buffer.push_back(static_cast<char>(value & 0xFF));
+}
+
+void
+putUint64(std::string& buffer, uint64_t value)
+{
+    putUint32(buffer, static_cast<uint32_t>(value >> 32));
+    putUint32(buffer, static_cast<uint32_t>(value & 0xFFFFFFFF));
+}
+
+uint16_t
+getUint16(const char* data)
+{
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    return (static_cast<uint16_t>((static_cast<uint16_t>(bytes[0]) << 8) | bytes[1]));
+}
+
+uint32_t
+getUint32(const char* data)
+{
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    return ((static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16)
+            | (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]));
+}
+
+uint64_t
+getUint64(const char* data)
+{
+    return ((static_cast<uint64_t>(getUint32(data)) << 32) | getUint32(data + 4));
+}
+
+} //namespace
+
+const uint32_t MessageRecording::s_version;
+const uint32_t MessageRecording::s_compressedFlag;
+const size_t MessageRecording::s_fileHeaderSize;
+const size_t MessageRecording::s_chunkHeaderSize;
+const size_t MessageRecording::s_recordHeaderSize;
+const size_t MessageRecording::s_trailerSize;
+
+MessageRecordWriter::~MessageRecordWriter()
+{
+    close();
+};
+
+bool
+MessageRecordWriter::open(const std::string& filePath, bool isCompressed, uint32_t chunkSizeLimit)
+{
+    close();
+    m_filePath = filePath;
+    m_isCompressed = isCompressed;
+    m_chunkSizeLimit = std::max(chunkSizeLimit, static_cast<uint32_t>(1024));
+    m_chunkBuffer.clear();
+    m_chunkBuffer.reserve(m_chunkSizeLimit + m_chunkSizeLimit / 4);
+    m_chunkIndex = MessageRecordingChunkIndex();
+    m_chunkDescriptorIndexes.clear();
+    m_descriptors.clear();
+    m_descriptorIndexes.clear();
+    m_addresses.clear();
+    m_addressSet.clear();
+    m_chunkIndexes.clear();
+
+    m_file.open(m_filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open())
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::open failed to create recording file [", m_filePath, "]");
+        return (false);
+    }
+
+    std::string header(MessageRecording::s_fileMagic());
+    putUint32(header, MessageRecording::s_version);
+    putUint32(header, m_isCompressed ? MessageRecording::s_compressedFlag : 0);
+    m_file.write(header.data(), header.size());
+    return (m_file.good());
+};
+
+bool
+MessageRecordWriter::writeRecord(int64_t time_ms, const std::string& address, const std::string& descriptor, const std::string& sourceGroup,
+                                 uint32_t sourceEntityId, uint32_t sourceServiceId, const std::string& payload)
+{
+    if (!m_file.is_open())
+    {
+        return (false);
+    }
+    if (address.size() > std::numeric_limits<uint16_t>::max()
+            || descriptor.size() > std::numeric_limits<uint16_t>::max() || sourceGroup.size() > std::numeric_limits<uint16_t>::max()
+            || payload.size() > std::numeric_limits<uint32_t>::max())
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::writeRecord attribute or payload length exceeds record field width");
+        return (false);
+    }
+
+    auto itDescriptor = m_descriptorIndexes.find(descriptor);
+    if (itDescriptor == m_descriptorIndexes.end())
+    {
+        itDescriptor = m_descriptorIndexes.emplace(descriptor, static_cast<uint32_t>(m_descriptors.size())).first;
+        m_descriptors.push_back(descriptor);
+    }
+    m_chunkDescriptorIndexes.insert(itDescriptor->second);
+    if (m_addressSet.insert(address).second)
+    {
+        m_addresses.push_back(address);
+    }
+
+    if (m_chunkIndex.m_recordCount == 0)
+    {
+        m_chunkIndex.m_firstTime_ms = time_ms;
+    }
+    m_chunkIndex.m_lastTime_ms = std::max(m_chunkIndex.m_lastTime_ms, time_ms);
+    m_chunkIndex.m_recordCount++;
+
+    putUint64(m_chunkBuffer, static_cast<uint64_t>(time_ms));
+    putUint32(m_chunkBuffer, sourceEntityId);
+    putUint32(m_chunkBuffer, sourceServiceId);
+    putUint16(m_chunkBuffer, static_cast<uint16_t>(address.size()));
+    putUint16(m_chunkBuffer, static_cast<uint16_t>(descriptor.size()));
+    putUint16(m_chunkBuffer, static_cast<uint16_t>(sourceGroup.size()));
+    putUint32(m_chunkBuffer, static_cast<uint32_t>(payload.size()));
+    m_chunkBuffer.append(address);
+    m_chunkBuffer.append(descriptor);
+    m_chunkBuffer.append(sourceGroup);
+    m_chunkBuffer.append(payload);
+
+    if (m_chunkBuffer.size() >= m_chunkSizeLimit)
+    {
+        return (flush());
+    }
+    return (true);
+};
+
+bool
+MessageRecordWriter::flush()
+{
+    if (!m_file.is_open() || m_chunkIndex.m_recordCount == 0)
+    {
+        return (true);
+    }
+
+    const std::string* storedBuffer = &m_chunkBuffer;
+    if (m_isCompressed)
+    {
+        uLongf compressedSize = compressBound(static_cast<uLong>(m_chunkBuffer.size()));
+        m_compressedBuffer.resize(compressedSize);
+        int result = compress2(reinterpret_cast<Bytef*>(&m_compressedBuffer[0]), &compressedSize,
+                               reinterpret_cast<const Bytef*>(m_chunkBuffer.data()), static_cast<uLong>(m_chunkBuffer.size()), Z_BEST_SPEED);
+        if (result != Z_OK)
+        {
+            UXAS_LOG_ERROR(s_typeName(), "::flush failed to compress chunk - zlib error ", result);
+            return (false);
+        }
+        m_compressedBuffer.resize(compressedSize);
+        storedBuffer = &m_compressedBuffer;
+    }
+
+    m_chunkIndex.m_fileOffset = static_cast<uint64_t>(m_file.tellp());
+    std::string chunkHeader(MessageRecording::s_chunkMarker());
+    putUint32(chunkHeader, static_cast<uint32_t>(storedBuffer->size()));
+    putUint32(chunkHeader, static_cast<uint32_t>(m_chunkBuffer.size()));
+    putUint32(chunkHeader, m_chunkIndex.m_recordCount);
+    putUint64(chunkHeader, static_cast<uint64_t>(m_chunkIndex.m_firstTime_ms));
+    putUint64(chunkHeader, static_cast<uint64_t>(m_chunkIndex.m_lastTime_ms));
+    m_file.write(chunkHeader.data(), chunkHeader.size());
+    m_file.write(storedBuffer->data(), storedBuffer->size());
+    m_file.flush();
+
+    m_chunkIndex.m_descriptorIndexes.assign(m_chunkDescriptorIndexes.begin(), m_chunkDescriptorIndexes.end());
+    m_chunkIndexes.push_back(std::move(m_chunkIndex));
+    m_chunkIndex = MessageRecordingChunkIndex();
+    m_chunkDescriptorIndexes.clear();
+    m_chunkBuffer.clear();
+
+    if (!m_file.good())
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::flush failed to write chunk to recording file [", m_filePath, "]");
+        return (false);
+    }
+    return (true);
+};
+
+bool
+MessageRecordWriter::close()
+{
+    if (!m_file.is_open())
+    {
+        return (false);
+    }
+
+    bool isSuccess = flush();
+
+    uint64_t indexOffset = static_cast<uint64_t>(m_file.tellp());
+    std::string index(MessageRecording::s_indexMarker());
+    putUint32(index, static_cast<uint32_t>(m_descriptors.size()));
+    for (const auto& descriptor : m_descriptors)
+    {
+        putUint16(index, static_cast<uint16_t>(descriptor.size()));
+        index.append(descriptor);
+    }
+    putUint32(index, static_cast<uint32_t>(m_addresses.size()));
+    for (const auto& address : m_addresses)
+    {
+        putUint16(index, static_cast<uint16_t>(address.size()));
+        index.append(address);
+    }
+    putUint32(index, static_cast<uint32_t>(m_chunkIndexes.size()));
+    for (const auto& chunkIndex : m_chunkIndexes)
+    {
+        putUint64(index, chunkIndex.m_fileOffset);
+        putUint64(index, static_cast<uint64_t>(chunkIndex.m_firstTime_ms));
+        putUint64(index, static_cast<uint64_t>(chunkIndex.m_lastTime_ms));
+        putUint32(index, chunkIndex.m_recordCount);
+        putUint32(index, static_cast<uint32_t>(chunkIndex.m_descriptorIndexes.size()));
+        for (auto descriptorIndex : chunkIndex.m_descriptorIndexes)
+        {
+            putUint32(index, descriptorIndex);
+        }
+    }
+    putUint64(index, indexOffset);
+    index.append(MessageRecording::s_trailerMagic());
+    m_file.write(index.data(), index.size());
+    m_file.close();
+
+    if (m_file.fail())
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::close failed to write index to recording file [", m_filePath, "]");
+        isSuccess = false;
+    }
+    return (isSuccess);
+};
+
+bool
+MessageRecordReader::open(const std::string& filePath)
+{
+    m_filePath = filePath;
+    m_descriptors.clear();
+    m_addresses.clear();
+    m_chunkIndexes.clear();
+    m_filterDescriptorIndexes.clear();
+    m_filterDescriptors.clear();
+    m_seekTime_ms = INT64_MIN;
+    m_nextChunk = 0;
+    m_chunkRecordsRemaining = 0;
+
+    if (m_file.is_open())
+    {
+        m_file.close();
+    }
+    m_file.open(m_filePath, std::ios::in | std::ios::binary);
+    if (!m_file.is_open())
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::open failed to open recording file [", m_filePath, "]");
+        return (false);
+    }
+
+    std::string header(MessageRecording::s_fileHeaderSize, '\0');
+    m_file.read(&header[0], header.size());
+    if (!m_file.good() || header.compare(0, 8, MessageRecording::s_fileMagic()) != 0)
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::open file [", m_filePath, "] is not a message recording");
+        return (false);
+    }
+    uint32_t version = getUint32(header.data() + 8);
+    if (version != MessageRecording::s_version)
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::open recording [", m_filePath, "] has unsupported version ", version);
+        return (false);
+    }
+    m_isCompressed = (getUint32(header.data() + 12) & MessageRecording::s_compressedFlag) != 0;
+
+    m_file.seekg(0, std::ios::end);
+    uint64_t fileSize = static_cast<uint64_t>(m_file.tellg());
+    if (!readIndex(fileSize))
+    {
+        UXAS_LOG_WARN(s_typeName(), "::open recording [", m_filePath, "] has no index; rebuilding index from chunks");
+        if (!rebuildIndex(fileSize))
+        {
+            return (false);
+        }
+    }
+    return (true);
+};
+
+int64_t
+MessageRecordReader::getFirstTime_ms() const
+{
+    return (m_chunkIndexes.empty() ? 0 : m_chunkIndexes.front().m_firstTime_ms);
+};
+
+int64_t
+MessageRecordReader::getLastTime_ms() const
+{
+    int64_t lastTime_ms{0};
+    for (const auto& chunkIndex : m_chunkIndexes)
+    {
+        lastTime_ms = std::max(lastTime_ms, chunkIndex.m_lastTime_ms);
+    }
+    return (lastTime_ms);
+};
+
+void
+MessageRecordReader::seekToTime(int64_t time_ms)
+{
+    m_seekTime_ms = time_ms;
+    m_chunkRecordsRemaining = 0;
+    m_nextChunk = 0;
+    while (m_nextChunk < m_chunkIndexes.size() && m_chunkIndexes[m_nextChunk].m_lastTime_ms < time_ms)
+    {
+        m_nextChunk++;
+    }
+};
+
+void
+MessageRecordReader::setDescriptorFilter(const std::set<std::string>& descriptors)
+{
+    m_filterDescriptors = descriptors;
+    m_filterDescriptorIndexes.clear();
+    for (uint32_t descriptorIndex = 0; descriptorIndex < m_descriptors.size(); descriptorIndex++)
+    {
+        if (m_filterDescriptors.find(m_descriptors[descriptorIndex]) != m_filterDescriptors.end())
+        {
+            m_filterDescriptorIndexes.insert(descriptorIndex);
+        }
+    }
+};
+
+bool
+MessageRecordReader::readNextRecord(MessageRecord& record)
+{
+    while (true)
+    {
+        while (m_chunkRecordsRemaining == 0)
+        {
+            if (m_nextChunk >= m_chunkIndexes.size())
+            {
+                return (false);
+            }
+            const MessageRecordingChunkIndex& chunkIndex = m_chunkIndexes[m_nextChunk++];
+            if (isChunkSelected(chunkIndex) && !loadChunk(chunkIndex))
+            {
+                return (false);
+            }
+        }
+
+        if (m_chunkPosition + MessageRecording::s_recordHeaderSize > m_chunkBuffer.size())
+        {
+            UXAS_LOG_ERROR(s_typeName(), "::readNextRecord truncated record in recording [", m_filePath, "]");
+            m_chunkRecordsRemaining = 0;
+            continue;
+        }
+        const char* data = m_chunkBuffer.data() + m_chunkPosition;
+        size_t addressLength = getUint16(data + 16);
+        size_t descriptorLength = getUint16(data + 18);
+        size_t sourceGroupLength = getUint16(data + 20);
+        size_t payloadLength = getUint32(data + 22);
+        size_t recordSize = MessageRecording::s_recordHeaderSize + addressLength + descriptorLength + sourceGroupLength + payloadLength;
+        if (m_chunkPosition + recordSize > m_chunkBuffer.size())
+        {
+            UXAS_LOG_ERROR(s_typeName(), "::readNextRecord truncated record in recording [", m_filePath, "]");
+            m_chunkRecordsRemaining = 0;
+            continue;
+        }
+        m_chunkPosition += recordSize;
+        m_chunkRecordsRemaining--;
+
+        int64_t time_ms = static_cast<int64_t>(getUint64(data));
+        const char* field = data + MessageRecording::s_recordHeaderSize;
+        if (time_ms < m_seekTime_ms
+                || (!m_filterDescriptors.empty()
+                    && m_filterDescriptors.find(std::string(field + addressLength, descriptorLength)) == m_filterDescriptors.end()))
+        {
+            continue;
+        }
+
+        record.m_time_ms = time_ms;
+        record.m_sourceEntityId = getUint32(data + 8);
+        record.m_sourceServiceId = getUint32(data + 12);
+        record.m_address.assign(field, addressLength);
+        field += addressLength;
+        record.m_descriptor.assign(field, descriptorLength);
+        field += descriptorLength;
+        record.m_sourceGroup.assign(field, sourceGroupLength);
+        field += sourceGroupLength;
+        record.m_payload.assign(field, payloadLength);
+        return (true);
+    }
+};
+
+bool
+MessageRecordReader::readIndex(uint64_t fileSize)
+{
+    if (fileSize < MessageRecording::s_fileHeaderSize + MessageRecording::s_trailerSize)
+    {
+        return (false);
+    }
+    std::string trailer(MessageRecording::s_trailerSize, '\0');
+    m_file.clear();
+    m_file.seekg(fileSize - MessageRecording::s_trailerSize);
+    m_file.read(&trailer[0], trailer.size());
+    if (!m_file.good() || trailer.compare(8, 8, MessageRecording::s_trailerMagic()) != 0)
+    {
+        return (false);
+    }
+    uint64_t indexOffset = getUint64(trailer.data());
+    if (indexOffset < MessageRecording::s_fileHeaderSize || indexOffset > fileSize - MessageRecording::s_trailerSize)
+    {
+        return (false);
+    }
+
+    std::string index(fileSize - MessageRecording::s_trailerSize - indexOffset, '\0');
+    m_file.seekg(indexOffset);
+    m_file.read(&index[0], index.size());
+    if (!m_file.good() || index.size() < 8 || index.compare(0, 4, MessageRecording::s_indexMarker()) != 0)
+    {
+        return (false);
+    }
+
+    size_t position{4};
+    auto isAvailable = [&index, &position](size_t size) { return (position + size <= index.size()); };
+    uint32_t descriptorCount = getUint32(index.data() + position);
+    position += 4;
+    for (uint32_t descriptorIndex = 0; descriptorIndex < descriptorCount; descriptorIndex++)
+    {
+        if (!isAvailable(2)) { return (false); }
+        size_t length = getUint16(index.data() + position);
+        position += 2;
+        if (!isAvailable(length)) { return (false); }
+        m_descriptors.emplace_back(index.data() + position, length);
+        position += length;
+    }
+    if (!isAvailable(4)) { return (false); }
+    uint32_t addressCount = getUint32(index.data() + position);
+    position += 4;
+    for (uint32_t addressIndex = 0; addressIndex < addressCount; addressIndex++)
+    {
+        if (!isAvailable(2)) { return (false); }
+        size_t length = getUint16(index.data() + position);
+        position += 2;
+        if (!isAvailable(length)) { return (false); }
+        m_addresses.emplace_back(index.data() + position, length);
+        position += length;
+    }
+    if (!isAvailable(4)) { return (false); }
+    uint32_t chunkCount = getUint32(index.data() + position);
+    position += 4;
+    for (uint32_t chunk = 0; chunk < chunkCount; chunk++)
+    {
+        if (!isAvailable(32)) { return (false); }
+        MessageRecordingChunkIndex chunkIndex;
+        chunkIndex.m_fileOffset = getUint64(index.data() + position);
+        chunkIndex.m_firstTime_ms = static_cast<int64_t>(getUint64(index.data() + position + 8));
+        chunkIndex.m_lastTime_ms = static_cast<int64_t>(getUint64(index.data() + position + 16));
+        chunkIndex.m_recordCount = getUint32(index.data() + position + 24);
+        uint32_t descriptorIndexCount = getUint32(index.data() + position + 28);
+        position += 32;
+        if (!isAvailable(static_cast<size_t>(descriptorIndexCount) * 4)) { return (false); }
+        for (uint32_t descriptorIndex = 0; descriptorIndex < descriptorIndexCount; descriptorIndex++)
+        {
+            chunkIndex.m_descriptorIndexes.push_back(getUint32(index.data() + position));
+            position += 4;
+        }
+        m_chunkIndexes.push_back(std::move(chunkIndex));
+    }
+    return (true);
+};
+
+bool
+MessageRecordReader::rebuildIndex(uint64_t fileSize)
+{
+    m_descriptors.clear();
+    m_addresses.clear();
+    m_chunkIndexes.clear();
+    uint64_t offset = MessageRecording::s_fileHeaderSize;
+    std::string chunkHeader(MessageRecording::s_chunkHeaderSize, '\0');
+    while (offset + MessageRecording::s_chunkHeaderSize <= fileSize)
+    {
+        m_file.clear();
+        m_file.seekg(offset);
+        m_file.read(&chunkHeader[0], chunkHeader.size());
+        if (!m_file.good() || chunkHeader.compare(0, 4, MessageRecording::s_chunkMarker()) != 0)
+        {
+            break;
+        }
+        uint64_t storedSize = getUint32(chunkHeader.data() + 4);
+        if (offset + MessageRecording::s_chunkHeaderSize + storedSize > fileSize)
+        {
+            // last chunk only partly written
+            break;
+        }
+        MessageRecordingChunkIndex chunkIndex;
+        chunkIndex.m_fileOffset = offset;
+        chunkIndex.m_recordCount = getUint32(chunkHeader.data() + 12);
+        chunkIndex.m_firstTime_ms = static_cast<int64_t>(getUint64(chunkHeader.data() + 16));
+        chunkIndex.m_lastTime_ms = static_cast<int64_t>(getUint64(chunkHeader.data() + 24));
+        m_chunkIndexes.push_back(std::move(chunkIndex));
+        offset += MessageRecording::s_chunkHeaderSize + storedSize;
+    }
+    m_file.clear();
+    return (true);
+};
+
+bool
+MessageRecordReader::isChunkSelected(const MessageRecordingChunkIndex& chunkIndex) const
+{
+    if (chunkIndex.m_lastTime_ms < m_seekTime_ms)
+    {
+        return (false);
+    }
+    if (m_filterDescriptors.empty() || chunkIndex.m_descriptorIndexes.empty())
+    {
+        return (true);
+    }
+    for (auto descriptorIndex : chunkIndex.m_descriptorIndexes)
+    {
+        if (m_filterDescriptorIndexes.find(descriptorIndex) != m_filterDescriptorIndexes.end())
+        {
+            return (true);
+        }
+    }
+    return (false);
+};
+
+bool
+MessageRecordReader::loadChunk(const MessageRecordingChunkIndex& chunkIndex)
+{
+    std::string chunkHeader(MessageRecording::s_chunkHeaderSize, '\0');
+    m_file.clear();
+    m_file.seekg(chunkIndex.m_fileOffset);
+    m_file.read(&chunkHeader[0], chunkHeader.size());
+    if (!m_file.good() || chunkHeader.compare(0, 4, MessageRecording::s_chunkMarker()) != 0)
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::loadChunk invalid chunk at offset ", chunkIndex.m_fileOffset, " in recording [", m_filePath, "]");
+        return (false);
+    }
+    uint32_t storedSize = getUint32(chunkHeader.data() + 4);
+    uint32_t uncompressedSize = getUint32(chunkHeader.data() + 8);
+
+    std::string& storedBuffer = m_isCompressed ? m_storedBuffer : m_chunkBuffer;
+    storedBuffer.resize(storedSize);
+    m_file.read(&storedBuffer[0], storedSize);
+    if (!m_file.good())
+    {
+        UXAS_LOG_ERROR(s_typeName(), "::loadChunk failed to read chunk at offset ", chunkIndex.m_fileOffset, " in recording [", m_filePath, "]");
+        return (false);
+    }
+
+    if (m_isCompressed)
+    {
+        m_chunkBuffer.resize(uncompressedSize);
+        uLongf size = uncompressedSize;
+        int result = uncompress(reinterpret_cast<Bytef*>(&m_chunkBuffer[0]), &size,
+                                reinterpret_cast<const Bytef*>(m_storedBuffer.data()), storedSize);
+        if (result != Z_OK || size != uncompressedSize)
+        {
+            UXAS_LOG_ERROR(s_typeName(), "::loadChunk failed to decompress chunk at offset ", chunkIndex.m_fileOffset, " - zlib error ", result);
+            return (false);
+        }
+    }
+
+    m_chunkPosition = 0;
+    m_chunkRecordsRemaining = getUint32(chunkHeader.data() + 12);
+    return (true);
+};
+
+}; //namespace log
+}; //namespace common
+}; //namespace uxas
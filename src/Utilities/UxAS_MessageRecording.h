@@ -0,0 +1,341 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_COMMON_LOG_MESSAGE_RECORDING_H
+#define UXAS_COMMON_LOG_MESSAGE_RECORDING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace uxas
+{
+namespace common
+{
+namespace log
+{
+
+/** \class MessageRecord
+ *
+ * \par Description:
+ * One recorded message: receive time, address, message attributes and the
+ * serialized payload exactly as received.
+ *
+ * \n
+ */
+struct MessageRecord
+{
+    int64_t m_time_ms{0};
+    /** \brief Address the message was sent to (the descriptor for broadcast
+     * messages). */
+    std::string m_address;
+    std::string m_descriptor;
+    std::string m_sourceGroup;
+    uint32_t m_sourceEntityId{0};
+    uint32_t m_sourceServiceId{0};
+    std::string m_payload;
+};
+
+/** \class MessageRecordingChunkIndex
+ *
+ * \par Description:
+ * Index entry of one recording chunk: file offset, time span, record count
+ * and the descriptors (message types) of the records in the chunk.
+ *
+ * \n
+ */
+struct MessageRecordingChunkIndex
+{
+    uint64_t m_fileOffset{0};
+    int64_t m_firstTime_ms{0};
+    int64_t m_lastTime_ms{0};
+    uint32_t m_recordCount{0};
+    /** \brief Indexes into the recording descriptor table. Empty if unknown
+     * (index rebuilt from an unterminated recording). */
+    std::vector<uint32_t> m_descriptorIndexes;
+};
+
+/** \class MessageRecording
+ *
+ * \par Description:
+ * Constants of the binary message recording format. All integers are in
+ * network byte order.
+ *
+ * \par Layout:
+ * <pre>
+ *  file header (16 bytes)
+ *       0     8  magic "UXASREC" + NUL
+ *       8     4  version
+ *      12     4  flags (bit 0: chunks are zlib compressed)
+ *  chunk (repeated)
+ *       0     4  chunk marker "CHNK"
+ *       4     4  stored (possibly compressed) size
+ *       8     4  uncompressed size
+ *      12     4  record count
+ *      16     8  first record time (ms)
+ *      24     8  last record time (ms)
+ *      32        stored records
+ *  record (within uncompressed chunk)
+ *       0     8  time (ms)
+ *       8     4  source entity ID
+ *      12     4  source service ID
+ *      16     2  address length
+ *      18     2  descriptor length
+ *      20     2  source group length
+ *      22     4  payload length
+ *      26        address, descriptor, source group, payload
+ *  index (written on close)
+ *       0     4  index marker "INDX"
+ *       4     4  descriptor count, then per descriptor: 2 length + characters
+ *                address count, then per address: 2 length + characters
+ *                chunk count, then per chunk: 8 offset, 8 first time,
+ *                8 last time, 4 record count, 4 descriptor index count,
+ *                4 per descriptor index
+ *  trailer (16 bytes)
+ *       0     8  index offset
+ *       8     8  magic "UXASEND" + NUL
+ * </pre>
+ *
+ * A recording that was not closed (no trailer) is still readable: the
+ * reader rebuilds the chunk index by walking the length-prefixed chunks.
+ *
+ * \n
+ */
+class MessageRecording
+{
+public:
+
+    static const uint32_t s_version{2};
+    static const uint32_t s_compressedFlag{0x01};
+    static const size_t s_fileHeaderSize{16};
+    static const size_t s_chunkHeaderSize{32};
+    static const size_t s_recordHeaderSize{26};
+    static const size_t s_trailerSize{16};
+
+    static const std::string&
+    s_fileMagic() { static std::string s_string("UXASREC\0", 8); return (s_string); };
+
+    static const std::string&
+    s_trailerMagic() { static std::string s_string("UXASEND\0", 8); return (s_string); };
+
+    static const std::string&
+    s_chunkMarker() { static std::string s_string("CHNK"); return (s_string); };
+
+    static const std::string&
+    s_indexMarker() { static std::string s_string("INDX"); return (s_string); };
+
+private:
+
+    // \brief Prevent construction (constants only)
+    MessageRecording() { };
+
+};
+
+/** \class MessageRecordWriter
+ *
+ * \par Description:
+ * Appends messages to a binary recording. Records are buffered into chunks
+ * that are (optionally) zlib compressed and written once they reach the
+ * configured size. <B><i>close</i></B> writes the time and type index.
+ *
+ * \n
+ */
+class MessageRecordWriter
+{
+public:
+
+    static const std::string&
+    s_typeName() { static std::string s_string("MessageRecordWriter"); return (s_string); };
+
+    MessageRecordWriter() { };
+
+    ~MessageRecordWriter();
+
+private:
+
+    /** \brief Copy construction not permitted */
+    MessageRecordWriter(MessageRecordWriter const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(MessageRecordWriter const&) = delete;
+
+public:
+
+    /** \brief Creates (or truncates) a recording file.
+     *
+     * @param filePath recording file path
+     * @param isCompressed if true, chunks are zlib compressed
+     * @param chunkSizeLimit uncompressed chunk size that triggers a chunk write
+     * @return true if the file was created and the header written
+     */
+    bool
+    open(const std::string& filePath, bool isCompressed, uint32_t chunkSizeLimit);
+
+    bool
+    isOpen() const { return (m_file.is_open()); };
+
+    /** \brief Adds a message to the current chunk.
+     *
+     * @return true if the record was buffered (and any full chunk written)
+     */
+    bool
+    writeRecord(int64_t time_ms, const std::string& address, const std::string& descriptor, const std::string& sourceGroup,
+                uint32_t sourceEntityId, uint32_t sourceServiceId, const std::string& payload);
+
+    /** \brief Writes any buffered records as a chunk. */
+    bool
+    flush();
+
+    /** \brief Writes the last chunk, the index and the trailer, then closes
+     * the file.
+     */
+    bool
+    close();
+
+private:
+
+    std::ofstream m_file;
+    std::string m_filePath;
+    bool m_isCompressed{true};
+    uint32_t m_chunkSizeLimit{262144};
+
+    std::string m_chunkBuffer;
+    std::string m_compressedBuffer;
+    MessageRecordingChunkIndex m_chunkIndex;
+    std::set<uint32_t> m_chunkDescriptorIndexes;
+
+    std::vector<std::string> m_descriptors;
+    std::unordered_map<std::string, uint32_t> m_descriptorIndexes;
+    /** \brief Distinct addresses, in order of first use. */
+    std::vector<std::string> m_addresses;
+    std::unordered_set<std::string> m_addressSet;
+    std::vector<MessageRecordingChunkIndex> m_chunkIndexes;
+
+};
+
+/** \class MessageRecordReader
+ *
+ * \par Description:
+ * Reads a binary recording in time order. Supports seeking to a time and
+ * filtering by descriptor; both use the chunk index so that chunks outside
+ * the requested time or without requested types are not decompressed.
+ *
+ * \n
+ */
+class MessageRecordReader
+{
+public:
+
+    static const std::string&
+    s_typeName() { static std::string s_string("MessageRecordReader"); return (s_string); };
+
+    MessageRecordReader() { };
+
+private:
+
+    /** \brief Copy construction not permitted */
+    MessageRecordReader(MessageRecordReader const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(MessageRecordReader const&) = delete;
+
+public:
+
+    /** \brief Opens a recording and loads (or rebuilds) its index.
+     *
+     * @param filePath recording file path
+     * @return true if the file is a readable recording
+     */
+    bool
+    open(const std::string& filePath);
+
+    const std::vector<MessageRecordingChunkIndex>&
+    getChunkIndexes() const { return (m_chunkIndexes); };
+
+    const std::vector<std::string>&
+    getDescriptors() const { return (m_descriptors); };
+
+    /** \brief Distinct addresses of the recorded messages (empty if the index
+     * was rebuilt from an unterminated recording). */
+    const std::vector<std::string>&
+    getAddresses() const { return (m_addresses); };
+
+    /** \brief Time of the first record (0 if the recording is empty). */
+    int64_t
+    getFirstTime_ms() const;
+
+    /** \brief Time of the last record (0 if the recording is empty). */
+    int64_t
+    getLastTime_ms() const;
+
+    /** \brief Positions the reader at the first record at or after
+     * <B><i>time_ms</i></B>.
+     */
+    void
+    seekToTime(int64_t time_ms);
+
+    /** \brief Restricts records returned by <B><i>readNextRecord</i></B> to
+     * the given descriptors. An empty set returns all records.
+     */
+    void
+    setDescriptorFilter(const std::set<std::string>& descriptors);
+
+    /** \brief Reads the next record that satisfies the seek time and the
+     * descriptor filter.
+     *
+     * @param record record read
+     * @return true if a record was read; false at the end of the recording
+     */
+    bool
+    readNextRecord(MessageRecord& record);
+
+private:
+
+    bool
+    readIndex(uint64_t fileSize);
+
+    bool
+    rebuildIndex(uint64_t fileSize);
+
+    bool
+    isChunkSelected(const MessageRecordingChunkIndex& chunkIndex) const;
+
+    bool
+    loadChunk(const MessageRecordingChunkIndex& chunkIndex);
+
+    std::ifstream m_file;
+    std::string m_filePath;
+    bool m_isCompressed{true};
+
+    std::vector<std::string> m_descriptors;
+    std::vector<std::string> m_addresses;
+    std::vector<MessageRecordingChunkIndex> m_chunkIndexes;
+
+    std::set<uint32_t> m_filterDescriptorIndexes;
+    std::set<std::string> m_filterDescriptors;
+    int64_t m_seekTime_ms{INT64_MIN};
+
+    size_t m_nextChunk{0};
+    std::string m_chunkBuffer;
+    std::string m_storedBuffer;
+    size_t m_chunkPosition{0};
+    uint32_t m_chunkRecordsRemaining{0};
+
+};
+
+}; //namespace log
+}; //namespace common
+}; //namespace uxas
+
+#endif /* UXAS_COMMON_LOG_MESSAGE_RECORDING_H */
@@ -0,0 +1,197 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#include "UxAS_ThreadPool.h"
+
+#include "UxAS_Log.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace uxas
+{
+namespace common
+{
+
+namespace
+{
+
+/** \brief Loop state shared by the calling thread and the helper jobs of one
+ * parallelFor call. Helper jobs that start after the loop is complete find no
+ * remaining indexes, so the state must outlive the call. */
+struct ParallelForState
+{
+    ParallelForState(size_t count, const std::function<void(size_t)>& body)
+    : m_count(count), m_body(body) { };
+
+    void
+    execute()
+    {
+        size_t index;
+        while ((index = m_nextIndex.fetch_add(1)) < m_count)
+        {
+            try
+            {
+                m_body(index);
+            }
+            catch (std::exception& ex)
+            {
+                UXAS_LOG_ERROR(ThreadPool::s_typeName(), "::parallelFor loop body threw exception [", ex.what(), "]");
+            }
+            if (m_completedCount.fetch_add(1) + 1 == m_count)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_isComplete = true;
+                m_completed.notify_all();
+            }
+        }
+    };
+
+    const size_t m_count;
+    const std::function<void(size_t)> m_body;
+    std::atomic<size_t> m_nextIndex{0};
+    std::atomic<size_t> m_completedCount{0};
+    std::mutex m_mutex;
+    std::condition_variable m_completed;
+    bool m_isComplete{false};
+};
+
+} //namespace
+
+uint32_t
+ThreadPool::getHardwareThreadCount()
+{
+    return (std::max(std::thread::hardware_concurrency(), 1u));
+};
+
+ThreadPool::ThreadPool(uint32_t threadCount)
+{
+    if (threadCount == 0)
+    {
+        threadCount = getHardwareThreadCount();
+    }
+    m_threads.reserve(threadCount);
+    for (uint32_t thread = 0; thread < threadCount; thread++)
+    {
+        m_threads.emplace_back(&ThreadPool::executeWorker, this);
+    }
+};
+
+ThreadPool::~ThreadPool()
+{
+    shutdown();
+};
+
+void
+ThreadPool::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isTerminate = true;
+    }
+    m_jobAvailable.notify_all();
+    for (auto& thread : m_threads)
+    {
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+};
+
+void
+ThreadPool::post(std::function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_isTerminate)
+        {
+            m_jobs.push_back(std::move(job));
+            m_jobAvailable.notify_one();
+            return;
+        }
+    }
+    job();
+};
+
+void
+ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& body)
+{
+    parallelFor(count, body, std::chrono::milliseconds(0), std::function<void()>());
+};
+
+void
+ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& body,
+                        const std::chrono::milliseconds& period, const std::function<void()>& periodic)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    if (count == 1 || m_threads.empty())
+    {
+        for (size_t index = 0; index < count; index++)
+        {
+            body(index);
+        }
+        return;
+    }
+
+    auto state = std::make_shared<ParallelForState>(count, body);
+    size_t helperCount = std::min(count - 1, m_threads.size());
+    for (size_t helper = 0; helper < helperCount; helper++)
+    {
+        post([state]() { state->execute(); });
+    }
+    state->execute();
+
+    std::unique_lock<std::mutex> lock(state->m_mutex);
+    if (!periodic)
+    {
+        state->m_completed.wait(lock, [&state]() { return (state->m_isComplete); });
+        return;
+    }
+    while (!state->m_completed.wait_for(lock, period, [&state]() { return (state->m_isComplete); }))
+    {
+        lock.unlock();
+        periodic();
+        lock.lock();
+    }
+};
+
+void
+ThreadPool::executeWorker()
+{
+    while (true)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobAvailable.wait(lock, [this]() { return (m_isTerminate || !m_jobs.empty()); });
+            if (m_jobs.empty())
+            {
+                // terminating and all queued jobs are done
+                return;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        try
+        {
+            job();
+        }
+        catch (std::exception& ex)
+        {
+            UXAS_LOG_ERROR(s_typeName(), "::executeWorker job threw exception [", ex.what(), "]");
+        }
+    }
+};
+
+}; //namespace common
+}; //namespace uxas
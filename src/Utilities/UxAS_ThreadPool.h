@@ -0,0 +1,132 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+// 
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+#ifndef UXAS_COMMON_THREAD_POOL_H
+#define UXAS_COMMON_THREAD_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace uxas
+{
+namespace common
+{
+
+/** \class ThreadPool
+ *
+ * \par Description:
+ * Fixed-size pool of worker threads executing queued jobs in FIFO order.
+ * <B><i>parallelFor</i></B> lets the calling thread take part in the loop,
+ * so it can be called from a pool job (nested parallelism) without risk of
+ * deadlock. Jobs must not throw; exceptions escaping a job are caught and
+ * logged.
+ *
+ * \n
+ */
+class ThreadPool
+{
+public:
+
+    static const std::string&
+    s_typeName() { static std::string s_string("ThreadPool"); return (s_string); };
+
+    /** \brief Returns the number of hardware threads (at least one). */
+    static
+    uint32_t
+    getHardwareThreadCount();
+
+    /** \brief Starts the worker threads.
+     *
+     * @param threadCount number of worker threads; 0 selects the number of
+     * hardware threads
+     */
+    explicit
+    ThreadPool(uint32_t threadCount);
+
+    /** \brief Executes all queued jobs, then joins the worker threads. */
+    ~ThreadPool();
+
+private:
+
+    /** \brief Copy construction not permitted */
+    ThreadPool(ThreadPool const&) = delete;
+
+    /** \brief Copy assignment operation not permitted */
+    void operator=(ThreadPool const&) = delete;
+
+public:
+
+    uint32_t
+    getThreadCount() const { return (static_cast<uint32_t>(m_threads.size())); };
+
+    /** \brief Executes all queued jobs, then joins the worker threads. Jobs
+     * posted afterwards (including by the draining jobs) execute on the
+     * posting thread. */
+    void
+    shutdown();
+
+    /** \brief Queues a job for execution by a worker thread. */
+    void
+    post(std::function<void()> job);
+
+    /** \brief Queues a job and returns a future for its result. */
+    template<typename Function>
+    std::future<typename std::result_of<Function()>::type>
+    submit(Function function)
+    {
+        typedef typename std::result_of<Function()>::type ResultType;
+        auto task = std::make_shared<std::packaged_task<ResultType()>>(std::move(function));
+        std::future<ResultType> result = task->get_future();
+        post([task]() { (*task)(); });
+        return (result);
+    };
+
+    /** \brief Executes <B><i>body(index)</i></B> for every index in
+     * [0, count) on the workers and the calling thread, and returns once
+     * all indexes are complete.
+     */
+    void
+    parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    /** \brief Same as parallelFor, and calls <B><i>periodic()</i></B> on the
+     * calling thread every <B><i>period</i></B> while it waits for indexes
+     * that are still executing on the workers.
+     */
+    void
+    parallelFor(size_t count, const std::function<void(size_t)>& body,
+                const std::chrono::milliseconds& period, const std::function<void()>& periodic);
+
+private:
+
+    void
+    executeWorker();
+
+    std::mutex m_mutex;
+    std::condition_variable m_jobAvailable;
+    std::deque<std::function<void()>> m_jobs;
+    bool m_isTerminate{false};
+    std::vector<std::thread> m_threads;
+
+};
+
+}; //namespace common
+}; //namespace uxas
+
+#endif /* UXAS_COMMON_THREAD_POOL_H */
@@ -9,8 +9,13 @@
 
 #include "UxAS_TimerManager.h"
 
+#include "UxAS_ConfigurationManager.h"
 #include "UxAS_Log.h"
 
+#include "stdUniquePtr.h"
+
+#include <limits>
+
 namespace uxas
 {
 namespace common
@@ -30,8 +35,13 @@ TimerManager::getInstance()
     return *s_instance;
 };
 
+const uint32_t TimerManager::s_firstLevelSlotBits;
+const uint32_t TimerManager::s_levelSlotBits;
+const uint32_t TimerManager::s_levelCount;
+
 TimerManager::TimerManager()
-: m_queue(m_comparator)
+: m_startTime(std::chrono::steady_clock::now()),
+m_wheelSlots((1 << s_firstLevelSlotBits) + (s_levelCount - 1) * (1 << s_levelSlotBits), nullptr)
 {
 };
 
@@ -42,15 +52,44 @@ TimerManager::~TimerManager()
     m_wakeUp.notify_all();
     lock.unlock();
     m_workerThread.join();
+
+    // callbacks already posted to the pool complete without invoking their handlers
+    lock.lock();
+    std::unique_ptr<uxas::common::ThreadPool> callbackPool = std::move(m_callbackPool);
+    lock.unlock();
+    callbackPool.reset();
 };
 
 void
 TimerManager::initialize()
 {
+    setCallbackThreadCount(uxas::common::ConfigurationManager::getTimerCallbackThreadCount());
     std::unique_lock<std::mutex> lock(m_mutex);
     m_workerThread = std::thread(std::bind(&TimerManager::executeManagement, this));
 };
 
+void
+TimerManager::setCallbackThreadCount(uint32_t callbackThreadCount)
+{
+    std::unique_ptr<uxas::common::ThreadPool> formerCallbackPool;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if ((m_callbackPool ? m_callbackPool->getThreadCount() : 0) == callbackThreadCount)
+        {
+            return;
+        }
+        formerCallbackPool = std::move(m_callbackPool);
+        if (callbackThreadCount > 0)
+        {
+            m_callbackPool = uxas::stduxas::make_unique<uxas::common::ThreadPool>(callbackThreadCount);
+        }
+    }
+    // completes the callbacks already posted to the former pool (outside of the lock)
+    formerCallbackPool.reset();
+    UXAS_LOG_INFORM(s_typeName(), "::setCallbackThreadCount invoking callbacks on ",
+                    (callbackThreadCount > 0 ? std::to_string(callbackThreadCount) + " callback threads" : std::string("the timer thread")));
+};
+
 uint64_t
 TimerManager::createTimer(const std::function<void()> &handler, const std::string& name)
 {
@@ -100,13 +139,9 @@ TimerManager::isTimerActive(uint64_t timerId)
         return (false);
     }
     
-    // timer exists, check to see if it is in the timing queue
-    auto queuedTimer = m_queue.find(std::ref(m_timersById.find(timerId)->second));
-    if (queuedTimer != m_queue.end())
-        return (true);
-    
-    // not in queue, report in-active
-    return (false);
+    // timer exists, check to see if it is scheduled (or to be scheduled after its callback)
+    const Timer& timer = m_timersById.find(timerId)->second;
+    return (timer.m_isScheduled || timer.m_isStartPending);
 };
 
 bool
@@ -211,100 +246,47 @@ TimerManager::startTimerImpl(uint64_t timerId, uint64_t startDelayFromNow_ms, ui
         return (false);
     }
 
-    if (m_workerThread.get_id() == std::this_thread::get_id())
+    Timer& timer = itTimer->second;
+    if (timer.m_isToBeDestroyed)
     {
-        // recursive timer re-start on TimerManager's thread from within the callback is not supported
-        UXAS_LOG_WARN(s_typeName(), "::startTimerImpl refused to re-start timer within the callback function "
-                 "using the TimerManager's thread for timer ID ", timerId, " and name ", itTimer->second.m_name);
+        UXAS_LOG_WARN(s_typeName(), "::startTimerImpl failed to start timer ID ", timerId, " and name ", timer.m_name,
+                      " to be destroyed after completing its callback");
         return (false);
     }
 
-    auto nowTime = std::chrono::system_clock::now();
-    
-    //
-    // if timer is queued (already started), attempt dequeue
-    //
-    bool isQueued{false};
-    auto queuedTimer = m_queue.find(std::ref(itTimer->second));
-    if (queuedTimer != m_queue.end())
-    {
-        isQueued = true;
-        UXAS_LOG_DEBUGGING(s_typeName(), "::startTimerImpl attempting to remove queued timer ID ", timerId);
-
-        // calculate timer disable attempt timeout
-        std::chrono::milliseconds reattemptSleep_ms = m_timeDurationReattempt_ms;
-        int64_t tmOut_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                itTimer->second.m_nextCallbackTime - nowTime).count();
-        if (tmOut_ms > 0) // queued for future callback
-        {
-            reattemptSleep_ms = std::chrono::milliseconds(1);
-            tmOut_ms = 3 * m_timeDurationReattempt_ms.count();
-        }
-        else // in callback or post-callback
-        {
-            if (itTimer->second.m_period_ms.count() > 0 &&
-                    itTimer->second.m_period_ms.count() < (3 * m_timeDurationReattempt_ms.count()))
-            {
-                // periodic timer with small period
-                reattemptSleep_ms = std::chrono::milliseconds(1);
-            }
-            tmOut_ms = 10 * m_timeDurationReattempt_ms.count();
-        }
-
-        // iteratively attempt to disable (dequeue) timer (within timeout)
-        while (isQueued)
-        {
-            if (disableOrDestroyExistingTimerImpl(timerId, *queuedTimer, false))
-            {
-                isQueued = false; // timer no longer queued
-                UXAS_LOG_DEBUGGING(s_typeName(), "::startTimerImpl removed queued timer ID ", timerId);
-            }
-            else if (std::chrono::duration_cast<std::chrono::milliseconds>(
-                    std::chrono::system_clock::now() - nowTime).count() > tmOut_ms)
-            {
-                UXAS_LOG_WARN(s_typeName(), "::startTimerImpl failed to disable and re-start timer ID ", timerId,
-                         " and name ", itTimer->second.m_name, " within ", tmOut_ms, " ms timeout");
-                break; // timed-out
-            }
-            else
-            {
-                // worker thread is performing callback - so wait, then re-attempt timer disable
-                lock.unlock(); // allow other threads to request timer disable/destroy
-                std::this_thread::sleep_for(reattemptSleep_ms);
-                lock.lock();
-            }
-        }
+    uint64_t expirationTick = getTick(std::chrono::steady_clock::now(), true) + startDelayFromNow_ms;
+    if (timer.m_isExecutingCallback)
+    {
+        // re-start after the callback completes (also when re-started from within the callback)
+        timer.m_isStartPending = true;
+        timer.m_pendingExpirationTick = expirationTick;
+        timer.m_pendingPeriod_ms = std::chrono::milliseconds(period_ms);
+        timer.m_isDisabled = false;
+        UXAS_LOG_DEBUGGING(s_typeName(), "::startTimerImpl starting timer ID ", timerId, " after completing its callback");
+        return (true);
     }
 
     //
-    // if timer is not queued (not started), then start (queue) timer
+    // if timer is scheduled (already started), re-schedule timer
     //
-    if (!isQueued)
-    {
-        itTimer->second.m_nextCallbackTime = nowTime + std::chrono::milliseconds(startDelayFromNow_ms);
-        itTimer->second.m_period_ms = std::chrono::milliseconds(period_ms);
-        itTimer->second.m_isDisabled = false;
-        itTimer->second.m_isToBeDestroyed = false;
-        itTimer->second.m_isExecutingCallback = false;
-        if (period_ms > 0)
-        {
-            UXAS_LOG_DEBUGGING(s_typeName(), "::startTimerImpl starting ", period_ms, " ms periodic timer ID ", timerId,
-                       " with ms start time delay ", startDelayFromNow_ms);
-        }
-        else
-        {
-            UXAS_LOG_DEBUGGING(s_typeName(), "::startTimerImpl starting single-shot timer ID ", timerId,
-                       " with ms start time delay ", startDelayFromNow_ms);
-        }
-        m_queue.insert(itTimer->second);
-        m_wakeUp.notify_all();
-        return (true);
+    unscheduleTimer(timer);
+    timer.m_expirationTick = expirationTick;
+    timer.m_period_ms = std::chrono::milliseconds(period_ms);
+    timer.m_isDisabled = false;
+    timer.m_isToBeDestroyed = false;
+    timer.m_isExecutingCallback = false;
+    if (period_ms > 0)
+    {
+        UXAS_LOG_DEBUGGING(s_typeName(), "::startTimerImpl starting ", period_ms, " ms periodic timer ID ", timerId,
+                   " with ms start time delay ", startDelayFromNow_ms);
     }
     else
     {
-        UXAS_LOG_WARN(s_typeName(), "::startTimerImpl did not re-start timer ID ", timerId);
-        return (false);
+        UXAS_LOG_DEBUGGING(s_typeName(), "::startTimerImpl starting single-shot timer ID ", timerId,
+                   " with ms start time delay ", startDelayFromNow_ms);
     }
+    scheduleTimer(timer);
+    return (true);
 };
 
 bool
@@ -369,6 +351,7 @@ TimerManager::disableOrDestroyExistingTimerImpl(uint64_t timerId, Timer& timer,
         // to be processed by worker thread
         // after completing callback
         timer.m_isDisabled = true;
+        timer.m_isStartPending = false;
         if (isDestroy)
         {
             timer.m_isToBeDestroyed = true;
@@ -380,11 +363,7 @@ TimerManager::disableOrDestroyExistingTimerImpl(uint64_t timerId, Timer& timer,
     else
     {
         // remove Timer
-        auto queuedTimer = m_queue.find(std::ref(timer));
-        if (queuedTimer != m_queue.end())
-        {
-            m_queue.erase(std::ref(timer));
-        }
+        unscheduleTimer(timer);
         if (isDestroy)
         {
             m_timersById.erase(timerId);
@@ -396,6 +375,218 @@ TimerManager::disableOrDestroyExistingTimerImpl(uint64_t timerId, Timer& timer,
     return (isCompleted);
 };
 
+uint64_t
+TimerManager::getTick(const std::chrono::steady_clock::time_point& timePoint, bool isRoundUp) const
+{
+    if (timePoint <= m_startTime)
+    {
+        return (0);
+    }
+    auto elapsed = timePoint - m_startTime;
+    auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed);
+    uint64_t tick = static_cast<uint64_t>(elapsed_ms.count());
+    if (isRoundUp && elapsed_ms < elapsed)
+    {
+        tick++;
+    }
+    return (tick);
+};
+
+void
+TimerManager::scheduleTimer(Timer& timer)
+{
+    // expired timers are placed in the slot of the current tick
+    uint64_t expirationTick = std::max(timer.m_expirationTick, m_currentTick);
+    uint64_t deltaTick = expirationTick - m_currentTick;
+
+    size_t slotIndex;
+    if (deltaTick < (1ull << s_firstLevelSlotBits))
+    {
+        slotIndex = static_cast<size_t>(expirationTick & ((1ull << s_firstLevelSlotBits) - 1));
+    }
+    else
+    {
+        uint32_t shift = s_firstLevelSlotBits;
+        size_t levelSlotOffset = 1 << s_firstLevelSlotBits;
+        for (uint32_t level = 1; level < s_levelCount - 1 && deltaTick >= (1ull << (shift + s_levelSlotBits)); level++)
+        {
+            shift += s_levelSlotBits;
+            levelSlotOffset += 1 << s_levelSlotBits;
+        }
+        if (deltaTick >= (1ull << (shift + s_levelSlotBits)))
+        {
+            // beyond the span of the wheel: park in the last slot, re-scheduled when cascaded
+            expirationTick = m_currentTick + (1ull << (shift + s_levelSlotBits)) - 1;
+        }
+        slotIndex = levelSlotOffset + static_cast<size_t>((expirationTick >> shift) & ((1ull << s_levelSlotBits) - 1));
+    }
+
+    timer.m_slotIndex = slotIndex;
+    timer.m_previous = nullptr;
+    timer.m_next = m_wheelSlots[slotIndex];
+    if (timer.m_next)
+    {
+        timer.m_next->m_previous = &timer;
+    }
+    m_wheelSlots[slotIndex] = &timer;
+    timer.m_isScheduled = true;
+    m_scheduledTimerCount++;
+
+    // wake the timer thread only if this timer is due before its planned wake-up
+    if (expirationTick < m_wakeUpTick)
+    {
+        m_wakeUp.notify_all();
+    }
+};
+
+void
+TimerManager::unscheduleTimer(Timer& timer)
+{
+    if (!timer.m_isScheduled)
+    {
+        return;
+    }
+    if (timer.m_previous)
+    {
+        timer.m_previous->m_next = timer.m_next;
+    }
+    else
+    {
+        m_wheelSlots[timer.m_slotIndex] = timer.m_next;
+    }
+    if (timer.m_next)
+    {
+        timer.m_next->m_previous = timer.m_previous;
+    }
+    timer.m_previous = nullptr;
+    timer.m_next = nullptr;
+    timer.m_isScheduled = false;
+    m_scheduledTimerCount--;
+};
+
+void
+TimerManager::cascadeTimers()
+{
+    uint32_t shift = s_firstLevelSlotBits;
+    size_t levelSlotOffset = 1 << s_firstLevelSlotBits;
+    for (uint32_t level = 1; level < s_levelCount; level++)
+    {
+        if ((m_currentTick & ((1ull << shift) - 1)) != 0)
+        {
+            // not at a slot boundary of this (or any higher) level
+            break;
+        }
+        size_t slotIndex = levelSlotOffset + static_cast<size_t>((m_currentTick >> shift) & ((1ull << s_levelSlotBits) - 1));
+        Timer* timer = m_wheelSlots[slotIndex];
+        while (timer)
+        {
+            Timer* nextTimer = timer->m_next;
+            unscheduleTimer(*timer);
+            scheduleTimer(*timer);
+            timer = nextTimer;
+        }
+        shift += s_levelSlotBits;
+        levelSlotOffset += 1 << s_levelSlotBits;
+    }
+};
+
+uint64_t
+TimerManager::getNextWakeUpTick() const
+{
+    // first occupied slot of the first level; otherwise, the next cascade
+    uint64_t slotMask = (1ull << s_firstLevelSlotBits) - 1;
+    uint64_t cascadeTick = (m_currentTick | slotMask) + 1;
+    for (uint64_t tick = m_currentTick; tick < cascadeTick; tick++)
+    {
+        if (m_wheelSlots[static_cast<size_t>(tick & slotMask)])
+        {
+            return (tick);
+        }
+    }
+    return (cascadeTick);
+};
+
+void
+TimerManager::dispatchCallback(Timer& timer, std::unique_lock<std::mutex>& lock)
+{
+    timer.m_isExecutingCallback = true;
+    if (m_callbackPool)
+    {
+        // the timer cannot be destroyed while its callback is executing
+        Timer* executingTimer = &timer;
+        m_callbackPool->post([this, executingTimer]()
+        {
+            std::unique_lock<std::mutex> callbackLock(m_mutex);
+            executeCallback(*executingTimer, callbackLock);
+        });
+    }
+    else
+    {
+        executeCallback(timer, lock);
+    }
+};
+
+void
+TimerManager::executeCallback(Timer& timer, std::unique_lock<std::mutex>& lock)
+{
+    if (!m_isFinished)
+    {
+        uint64_t timerId = timer.m_id;
+        UXAS_LOG_DEBUGGING(s_typeName(), "::executeCallback invoking callback function for timer ID ", timerId);
+        lock.unlock(); // allow other threads to request Timer disable/destroy
+        // invoke callback function
+        timer.m_handler();
+        lock.lock();
+        UXAS_LOG_DEBUGGING(s_typeName(), "::executeCallback completed callback function invocation for timer ID ", timerId);
+    }
+    completeCallback(timer);
+};
+
+void
+TimerManager::completeCallback(Timer& timer)
+{
+    timer.m_isExecutingCallback = false;
+    if (m_isFinished)
+    {
+        return;
+    }
+
+    if (timer.m_isToBeDestroyed)
+    {
+        // destroy was called for this Timer while performing callback
+        // (the lock was released during the callback)
+        uint64_t timerId = timer.m_id;
+        m_timersById.erase(timerId);
+        UXAS_LOG_INFORM(s_typeName(), "::completeCallback destroyed timer ID ", timerId);
+    }
+    else if (timer.m_isStartPending)
+    {
+        // start was called for this Timer while performing callback
+        timer.m_isStartPending = false;
+        timer.m_expirationTick = timer.m_pendingExpirationTick;
+        timer.m_period_ms = timer.m_pendingPeriod_ms;
+        scheduleTimer(timer);
+        UXAS_LOG_DEBUGGING(s_typeName(), "::completeCallback started timer ID ", timer.m_id);
+    }
+    else if (timer.m_isDisabled)
+    {
+        UXAS_LOG_DEBUGGING(s_typeName(), "::completeCallback not re-scheduling disabled timer ID ", timer.m_id);
+    }
+    else if (timer.m_period_ms.count() > 0)
+    {
+        // re-schedule to callback m_period_ms milliseconds later
+        timer.m_expirationTick += static_cast<uint64_t>(timer.m_period_ms.count());
+        scheduleTimer(timer);
+        UXAS_LOG_DEBUGGING(s_typeName(), "::completeCallback re-scheduled ",
+                      timer.m_period_ms.count(), " ms periodic timer ID ", timer.m_id);
+    }
+    else
+    {
+        timer.m_isDisabled = true;
+        UXAS_LOG_DEBUGGING(s_typeName(), "::completeCallback disabled expired single-shot timer ID ", timer.m_id);
+    }
+};
+
 void
 TimerManager::executeManagement()
 {
@@ -403,72 +594,41 @@ TimerManager::executeManagement()
 
     while (!m_isFinished)
     {
-        if (m_queue.empty())
+        uint64_t nowTick = getTick(std::chrono::steady_clock::now());
+        if (m_scheduledTimerCount == 0)
         {
+            // nothing to cascade or expire - skip the elapsed ticks
+            m_currentTick = std::max(m_currentTick, nowTick);
             // wait for creation and start of first Timer
             UXAS_LOG_DEBUGGING(s_typeName(), "::executeManagement waiting for creation and start of a timer");
+            m_wakeUpTick = std::numeric_limits<uint64_t>::max();
             m_wakeUp.wait(lock);
         }
-        else
+        else if (m_currentTick <= nowTick)
         {
-            // check Timer at front of queue
-            auto firstTmr = m_queue.begin();
-            Timer& timer = *firstTmr;
-            auto now = std::chrono::system_clock::now();
-            if (now >= timer.m_nextCallbackTime)
+            // process the current tick: cascade, then invoke callbacks of expired timers
+            m_wakeUpTick = 0;
+            cascadeTimers();
+            size_t slotIndex = static_cast<size_t>(m_currentTick & ((1ull << s_firstLevelSlotBits) - 1));
+            while (m_wheelSlots[slotIndex] && !m_isFinished)
             {
-                m_queue.erase(firstTmr);
-
-                UXAS_LOG_DEBUGGING(s_typeName(), "::executeManagement invoking callback function for timer ID ", timer.m_id);
-                timer.m_isExecutingCallback = true;
-                lock.unlock(); // allow other threads to request Timer disable/destroy
-                // invoke callback function
-                timer.m_handler();
-                lock.lock();
-                timer.m_isExecutingCallback = false;
-                UXAS_LOG_DEBUGGING(s_typeName(), "::executeManagement completed callback function invocation for timer ID ", timer.m_id);
-
-                if (m_isFinished)
-                {
-                    UXAS_LOG_INFORM(s_typeName(), "::executeManagement finished - exiting main loop");
-                    break;
-                }
-                else if (timer.m_isToBeDestroyed)
-                {
-                    // destroy was called for this Timer while performing callback 
-                    // (this thread released the lock during the callback)
-                    m_timersById.erase(timer.m_id);
-                    UXAS_LOG_INFORM(s_typeName(), "::executeManagement destroyed timer ID ", timer.m_id);
-                }
-                else if (timer.m_isDisabled)
-                {
-                    UXAS_LOG_DEBUGGING(s_typeName(), "::executeManagement not invoking callback of disabled timer ID ", timer.m_id);
-                }
-                else
-                {
-                    if (timer.m_period_ms.count() > 0)
-                    {
-                        // re-schedule to callback m_period_ms milliseconds later
-                        timer.m_nextCallbackTime = timer.m_nextCallbackTime + timer.m_period_ms;
-                        m_queue.insert(timer);
-                        UXAS_LOG_DEBUGGING(s_typeName(), "::executeManagement re-scheduled ", 
-                                      timer.m_period_ms.count(), " ms periodic timer ID ", timer.m_id);
-                    }
-                    else
-                    {
-                        timer.m_isDisabled = true;
-                        UXAS_LOG_DEBUGGING(s_typeName(), "::executeManagement disabled expired single-shot timer ID ", timer.m_id);
-                    }
-                }
+                Timer& timer = *m_wheelSlots[slotIndex];
+                unscheduleTimer(timer);
+                dispatchCallback(timer, lock);
             }
-            else
+            if (m_isFinished)
             {
-                // wait until the Timer is ready 
-                // or for Timer creation/disable/destroy event notification
-                m_wakeUp.wait_until(lock, timer.m_nextCallbackTime);
-                UXAS_LOG_DEBUGGING(s_typeName(), "::executeManagement waiting to process a triggering event "
-                        "or front-queued timer ID ", timer.m_id);
+                UXAS_LOG_INFORM(s_typeName(), "::executeManagement finished - exiting main loop");
+                break;
             }
+            m_currentTick++;
+        }
+        else
+        {
+            // wait until the next Timer is ready 
+            // or for Timer creation/disable/destroy event notification
+            m_wakeUpTick = getNextWakeUpTick();
+            m_wakeUp.wait_until(lock, m_startTime + std::chrono::milliseconds(m_wakeUpTick));
         }
     }
 };
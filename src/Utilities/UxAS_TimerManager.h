@@ -14,11 +14,12 @@
 #include <memory>
 #include <mutex>
 #include <condition_variable>
+#include "UxAS_ThreadPool.h"
+
 #include <algorithm>
 #include <functional>
 #include <chrono>
 #include <unordered_map>
-#include <set>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -33,6 +34,23 @@ namespace common
  * @par Description:
  * The <B><i>TimerManager</i></B> manages zero to many Timer objects with a single thread.
  * 
+ * @par Scheduling:
+ * Started timers are kept in a hierarchical timing wheel with a resolution 
+ * of one millisecond (steady clock). The first level has one slot per 
+ * millisecond for the next 256 ms; each higher level has 64 slots covering 
+ * 64 times the span of the level below, and its timers are cascaded into 
+ * the lower levels as time advances. Slots are intrusive doubly-linked lists, 
+ * so starting, disabling and destroying a timer are O(1), and the thread 
+ * only touches the slots of the elapsed milliseconds.
+ * 
+ * @par Callbacks:
+ * By default, callbacks are invoked on the timer thread. If a callback thread 
+ * count is configured (<B><i>TimerCallbackThreadCount</i></B>), callbacks are 
+ * dispatched to a pool of that many threads so that a slow callback does not 
+ * delay other timers. A timer's callbacks never overlap: a periodic timer is 
+ * re-scheduled when its callback completes (at the next period boundary, 
+ * immediately if that boundary has passed).
+ * 
  * @n
  */
 class TimerManager
@@ -49,20 +67,22 @@ private:
 
         Timer(Timer const& r) = delete;
 
+        /** \brief Moves an unscheduled timer */
         Timer(Timer&& rhs) noexcept
-        : m_id(rhs.m_id), m_name(rhs.m_name), m_nextCallbackTime(rhs.m_nextCallbackTime), m_period_ms(rhs.m_period_ms),
+        : m_id(rhs.m_id), m_name(rhs.m_name), m_expirationTick(rhs.m_expirationTick), m_period_ms(rhs.m_period_ms),
         m_handler(std::move(rhs.m_handler)), m_isExecutingCallback(rhs.m_isExecutingCallback),
         m_isDisabled(rhs.m_isDisabled), m_isToBeDestroyed(rhs.m_isToBeDestroyed) { };
 
         Timer& operator=(Timer const& r) = delete;
 
+        /** \brief Moves an unscheduled timer */
         Timer& operator=(Timer&& rhs)
         {
             if (this != &rhs)
             {
                 m_id = rhs.m_id;
                 m_name = rhs.m_name;
-                m_nextCallbackTime = rhs.m_nextCallbackTime;
+                m_expirationTick = rhs.m_expirationTick;
                 m_period_ms = rhs.m_period_ms;
                 m_handler = std::move(rhs.m_handler);
                 m_isExecutingCallback = rhs.m_isExecutingCallback;
@@ -74,22 +94,24 @@ private:
 
         uint64_t m_id{0};
         std::string m_name;
-        std::chrono::time_point<std::chrono::system_clock> m_nextCallbackTime;
+        /** \brief time of next callback (milliseconds since the TimerManager's start time) */
+        uint64_t m_expirationTick{0};
         std::chrono::milliseconds m_period_ms{0};
         std::function<void() > m_handler;
         bool m_isExecutingCallback{false};
         bool m_isDisabled{false};
         bool m_isToBeDestroyed{false};
-    };
 
-    /** Comparison functor to sort the timer "queue" by Timer::nextTimePoint */
-    struct NextActiveTimerComparator
-    {
+        /** \brief start requested while executing callback; applied when callback completes */
+        bool m_isStartPending{false};
+        uint64_t m_pendingExpirationTick{0};
+        std::chrono::milliseconds m_pendingPeriod_ms{0};
 
-        bool operator()(const Timer &a, const Timer &b) const
-        {
-            return a.m_nextCallbackTime < b.m_nextCallbackTime;
-        }
+        // timing wheel slot membership
+        bool m_isScheduled{false};
+        size_t m_slotIndex{0};
+        Timer* m_previous{nullptr};
+        Timer* m_next{nullptr};
     };
 
 public:
@@ -201,6 +223,14 @@ public:
     uint64_t
     destroyTimers(std::vector<uint64_t>& timerIds, uint64_t timeOut_ms);
 
+    /** \brief Sets the number of threads invoking timer callbacks.
+     * 
+     * @param callbackThreadCount number of callback threads; 0 invokes 
+     * callbacks on the timer thread.
+     */
+    void
+    setCallbackThreadCount(uint32_t callbackThreadCount);
+
 private:
 
     void
@@ -235,8 +265,52 @@ private:
     bool
     disableOrDestroyExistingTimerImpl(uint64_t timerId, Timer& timer, bool isDestroy);
 
+    /** \brief Number of milliseconds from the TimerManager's start time to 
+     * <B><i>timePoint</i></B>, rounded down (or up).
+     */
+    uint64_t
+    getTick(const std::chrono::steady_clock::time_point& timePoint, bool isRoundUp = false) const;
+
+    /** \brief Inserts a timer into the timing wheel slot of its expiration 
+     * tick (relative to <B><i>m_currentTick</i></B>). Lock mutex before calling. */
+    void
+    scheduleTimer(Timer& timer);
+
+    /** \brief Removes a timer from its timing wheel slot (if scheduled). 
+     * Lock mutex before calling. */
+    void
+    unscheduleTimer(Timer& timer);
+
+    /** \brief Re-schedules the timers of the higher-level slots that expire 
+     * within the span of the level below, starting at <B><i>m_currentTick</i></B>. */
+    void
+    cascadeTimers();
+
+    /** \brief Earliest tick at which the timer thread must wake up. */
+    uint64_t
+    getNextWakeUpTick() const;
+
+    /** \brief Invokes the callback on the timer thread or posts it to the 
+     * callback pool. Lock mutex before calling (it is released during inline callbacks). */
+    void
+    dispatchCallback(Timer& timer, std::unique_lock<std::mutex>& lock);
+
+    /** \brief Invokes the callback of a timer marked as executing, then completes it. */
+    void
+    executeCallback(Timer& timer, std::unique_lock<std::mutex>& lock);
+
+    /** \brief Processes disable/destroy/start requests made during the callback 
+     * and re-schedules periodic timers. Lock mutex before calling. */
+    void
+    completeCallback(Timer& timer);
+
     static std::unique_ptr<TimerManager> s_instance;
 
+    /** \brief number of bits of the slot index of the first (and of each higher) timing wheel level */
+    static const uint32_t s_firstLevelSlotBits{8};
+    static const uint32_t s_levelSlotBits{6};
+    static const uint32_t s_levelCount{5};
+
     std::mutex m_mutex;
     std::condition_variable m_wakeUp;
     std::thread m_workerThread;
@@ -244,9 +318,17 @@ private:
     uint64_t m_nextId{1};
     std::chrono::milliseconds m_timeDurationReattempt_ms{10};
 
-    NextActiveTimerComparator m_comparator;
-    // Queue is a set of references to Timer objects, sorted by next
-    std::multiset<std::reference_wrapper<Timer>, NextActiveTimerComparator> m_queue;
+    /** \brief callback pool (empty if callbacks are invoked on the timer thread) */
+    std::unique_ptr<uxas::common::ThreadPool> m_callbackPool;
+
+    std::chrono::steady_clock::time_point m_startTime;
+    /** \brief next tick to be processed by the timer thread */
+    uint64_t m_currentTick{0};
+    /** \brief heads of the slot lists of all levels (first level slots first) */
+    std::vector<Timer*> m_wheelSlots;
+    uint64_t m_scheduledTimerCount{0};
+    /** \brief tick at which the waiting timer thread wakes up (0 if not waiting) */
+    uint64_t m_wakeUpTick{0};
     std::unordered_map<uint64_t, Timer> m_timersById;
 };
 
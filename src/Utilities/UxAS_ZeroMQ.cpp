@@ -48,6 +48,36 @@ s_sendmore(zmq::socket_t & socket, const std::string & string) {
     return (rc);
 }
 
+//  Release the reference held by a 0MQ frame created by s_sendShared
+static void
+s_releaseSharedString(void* data, void* hint)
+{
+    delete static_cast<std::shared_ptr<const std::string>*> (hint);
+}
+
+static bool
+s_sendShared(zmq::socket_t & socket, const std::shared_ptr<const std::string> & sharedString, int flags)
+{
+    // 0MQ never writes to a frame's data, the const_cast only satisfies the API
+    std::shared_ptr<const std::string>* reference = new std::shared_ptr<const std::string>(sharedString);
+    zmq::message_t message(const_cast<char*> (sharedString->data()), sharedString->size(), s_releaseSharedString, reference);
+
+    bool rc = socket.send(message, flags);
+    return (rc);
+}
+
+bool
+s_send(zmq::socket_t & socket, const std::shared_ptr<const std::string> & sharedString) {
+
+    return (s_sendShared(socket, sharedString, 0));
+}
+
+bool
+s_sendmore(zmq::socket_t & socket, const std::shared_ptr<const std::string> & sharedString) {
+
+    return (s_sendShared(socket, sharedString, ZMQ_SNDMORE));
+}
+
 void
 s_sleep(int msecs) {
 #ifdef _WIN32
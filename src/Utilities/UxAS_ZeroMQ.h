@@ -10,6 +10,9 @@
 
 #include "zmq.hpp"
 
+#include <memory>
+#include <string>
+
 namespace n_ZMQ
 {
 
@@ -31,6 +34,15 @@ namespace n_ZMQ
     bool
     s_sendmore(zmq::socket_t & socket, const std::string & string);
 
+    //  Send shared string as 0MQ string without copying; the string is kept
+    //  alive until 0MQ releases the frame
+    bool
+    s_send(zmq::socket_t & socket, const std::shared_ptr<const std::string> & sharedString);
+
+    //  Sends shared string as 0MQ string without copying, as multipart non-terminal
+    bool
+    s_sendmore(zmq::socket_t & socket, const std::shared_ptr<const std::string> & sharedString);
+
     //  Sleep for a number of milliseconds
     void
     s_sleep(int msecs);
@@ -52,6 +52,8 @@ License along with VisiLibity.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "boost/geometry/algorithms/is_valid.hpp"
 #include "boost/geometry/algorithms/validity_failure_type.hpp"
+#include "boost/geometry/index/rtree.hpp"
+#include <iterator>      //back_inserter
 
 ///Hide helping functions in unnamed namespace (local to .C file).
 namespace
@@ -2730,6 +2732,116 @@ namespace VisiLibity
   }
 
 
+  std::vector<Polyline> Environment::shortest_paths(const Visibility_Polygon& start_visibility_polygon,
+                     const std::vector<const Visibility_Polygon*>& finish_visibility_polygons,
+                     const Visibility_Graph& visibility_graph,
+                     double epsilon) const
+  {
+    const Point start = start_visibility_polygon.observer();
+    const unsigned vertex_count = n();
+    std::vector<Polyline> shortest_paths_output( finish_visibility_polygons.size() );
+
+    //Single source search over the environment vertices.  The
+    //visibility graph is dense, so a linear scan for the closest
+    //unsettled vertex (O(n^2) overall) beats a heap.
+    //convention parent == vertex_count => parent is the start Point
+    const double infinity = std::numeric_limits<double>::infinity();
+    std::vector<double> cost_to_come( vertex_count, infinity );
+    std::vector<unsigned> parent( vertex_count, vertex_count );
+    std::vector<bool> settled( vertex_count, false );
+    for(unsigned k=0; k<vertex_count; k++)
+      if(  (*this)(k).in( start_visibility_polygon , epsilon )  )
+    cost_to_come[k] = distance( start , (*this)(k) );
+
+    while( true ){
+      unsigned current = vertex_count;
+      double current_cost = infinity;
+      for(unsigned k=0; k<vertex_count; k++)
+    if( !settled[k] and cost_to_come[k] < current_cost ){
+      current = k;
+      current_cost = cost_to_come[k];
+    }
+      if( current == vertex_count )
+    break;
+      settled[current] = true;
+      for(unsigned k=0; k<vertex_count; k++){
+    if( settled[k] or !visibility_graph( current , k ) )
+      continue;
+    double cost = current_cost + distance( (*this)(current) , (*this)(k) );
+    if( cost < cost_to_come[k] ){
+      cost_to_come[k] = cost;
+      parent[k] = current;
+    }
+      }
+    }
+
+    //Connect each finish to the search tree
+    for(unsigned f=0; f<finish_visibility_polygons.size(); f++){
+      const Point finish = finish_visibility_polygons[f]->observer();
+      Polyline& shortest_path_output = shortest_paths_output[f];
+
+      //Trivial cases (as shortest_path())
+      if( distance(start,finish) <= epsilon ){
+    shortest_path_output.push_back(start);
+    continue;
+      }
+      else if( finish.in(start_visibility_polygon, epsilon) ){
+    shortest_path_output.push_back(start);
+    shortest_path_output.push_back(finish);
+    continue;
+      }
+
+      unsigned last_vertex = vertex_count;
+      double best_cost = infinity;
+      for(unsigned k=0; k<vertex_count; k++){
+    if( cost_to_come[k] == infinity )
+      continue;
+    double cost = cost_to_come[k] + distance( (*this)(k) , finish );
+    if( cost < best_cost
+        and (*this)(k).in( *finish_visibility_polygons[f] , epsilon ) ){
+      last_vertex = k;
+      best_cost = cost;
+    }
+      }
+      if( last_vertex == vertex_count )
+    continue;
+
+      //Recover solution, adding vertices if not redundant
+      shortest_path_output.push_back( finish );
+      for(unsigned k=last_vertex; ; k=parent[k]){
+    Point waypoint = (k < vertex_count) ? (*this)(k) : start;
+    if( distance( shortest_path_output[ shortest_path_output.size() - 1 ],
+              waypoint ) > epsilon )
+      shortest_path_output.push_back( waypoint );
+    if( k == vertex_count )
+      break;
+      }
+      shortest_path_output.reverse();
+    }
+
+    return shortest_paths_output;
+  }
+
+
+  std::vector<Polyline> Environment::shortest_paths(const Point& start,
+                     const std::vector<Point>& finishes,
+                     const Visibility_Graph& visibility_graph,
+                     double epsilon) const
+  {
+    std::vector<Visibility_Polygon> finish_visibility_polygons;
+    std::vector<const Visibility_Polygon*> finish_visibility_polygon_pointers;
+    finish_visibility_polygons.reserve( finishes.size() );
+    for(unsigned f=0; f<finishes.size(); f++){
+      finish_visibility_polygons.push_back( Visibility_Polygon(finishes[f], *this, epsilon) );
+      finish_visibility_polygon_pointers.push_back( &finish_visibility_polygons.back() );
+    }
+    return shortest_paths( Visibility_Polygon(start, *this, epsilon),
+               finish_visibility_polygon_pointers,
+               visibility_graph,
+               epsilon );
+  }
+
+
   void Environment::write_to_file(const std::string& filename,
                   int fios_precision_temp)
   {
@@ -3804,6 +3916,164 @@ namespace VisiLibity
   }
 
 
+  //bounding box of a Line_Segment padded by epsilon (R-tree key)
+  static boost::geometry::model::box<boost_point>
+  segment_box(const Line_Segment& segment, double epsilon)
+  {
+    Point a = segment.first(), b = segment.second();
+    return boost::geometry::model::box<boost_point>(
+      boost_point( std::min(a.x(), b.x()) - epsilon,
+           std::min(a.y(), b.y()) - epsilon ),
+      boost_point( std::max(a.x(), b.x()) + epsilon,
+           std::max(a.y(), b.y()) + epsilon ) );
+  }
+
+
+  Visibility_Graph::Visibility_Graph(const Visibility_Graph& previous_graph,
+                     const Environment& previous_environment,
+                     const Environment& environment,
+                     double epsilon)
+  {
+    n_ = 0;
+    adjacency_matrix_ = NULL;
+    if( previous_graph.n() != previous_environment.n()
+        or environment[0] != previous_environment[0] ){
+      *this = Visibility_Graph( environment, epsilon );
+      return;
+    }
+
+    n_ = environment.n();
+
+    //fill vertex_counts_
+    vertex_counts_.reserve( environment.h() );
+    for(unsigned i=0; i<environment.h(); i++)
+      vertex_counts_.push_back( environment[i].n() );
+
+    //allocate a contiguous chunk of memory for adjacency_matrix_
+    adjacency_matrix_ = new bool*[n_];
+    adjacency_matrix_[0] = new bool[n_*n_];
+    for(unsigned i=1; i<n_; i++)
+      adjacency_matrix_[i] = adjacency_matrix_[i-1] + n_;
+
+    //flattened index of the first vertex of each Polygon
+    std::vector<unsigned> first_index( environment.h()+1, 0 );
+    for(unsigned i=1; i<=environment.h(); i++)
+      first_index[i] = first_index[i-1] + environment[i-1].n();
+    std::vector<unsigned> previous_first_index( previous_environment.h()+1, 0 );
+    for(unsigned i=1; i<=previous_environment.h(); i++)
+      previous_first_index[i] = previous_first_index[i-1]
+    + previous_environment[i-1].n();
+
+    //match unchanged Polygons and map their vertices to the previous
+    //flattened indices (n_ marks vertices of added holes)
+    std::vector<unsigned> previous_index( n_, n_ );
+    std::vector<bool> is_previous_kept( previous_environment.h()+1, false );
+    std::vector<bool> is_added( environment.h()+1, true );
+    for(unsigned i=0; i<=environment.h(); i++){
+      for(unsigned i_previous=0; i_previous<=previous_environment.h();
+      i_previous++){
+    if( !is_previous_kept[i_previous]
+        and environment[i] == previous_environment[i_previous] ){
+      is_previous_kept[i_previous] = true;
+      is_added[i] = false;
+      for(unsigned j=0; j<environment[i].n(); j++)
+        previous_index[ first_index[i]+j ]
+          = previous_first_index[i_previous] + j;
+      break;
+    }
+      }
+    }
+
+    //R-trees of the edges of added and removed holes
+    typedef boost::geometry::model::box<boost_point> boost_box;
+    typedef std::pair<boost_box, Line_Segment> indexed_edge;
+    typedef boost::geometry::index::rtree< indexed_edge,
+      boost::geometry::index::quadratic<16> > edge_rtree;
+    edge_rtree added_edges, removed_edges;
+    for(unsigned i=1; i<=environment.h(); i++){
+      if( !is_added[i] )
+    continue;
+      for(unsigned j=0; j<environment[i].n(); j++){
+    Line_Segment edge( environment[i][j], environment[i][j+1] );
+    added_edges.insert( std::make_pair( segment_box(edge, epsilon), edge ) );
+      }
+    }
+    for(unsigned i=1; i<=previous_environment.h(); i++){
+      if( is_previous_kept[i] )
+    continue;
+      for(unsigned j=0; j<previous_environment[i].n(); j++){
+    Line_Segment edge( previous_environment[i][j],
+               previous_environment[i][j+1] );
+    removed_edges.insert( std::make_pair( segment_box(edge, epsilon), edge ) );
+      }
+    }
+
+    //vertices of added holes and of pairs whose visibility may have
+    //changed: a visible pair can only be blocked by an added hole, an
+    //occluded pair can only be opened by a removed hole
+    std::vector<bool> is_recomputed( n_, false );
+    for(unsigned k=0; k<n_; k++)
+      is_recomputed[k] = ( previous_index[k] == n_ );
+    std::vector<indexed_edge> candidates;
+    for(unsigned k1=0; k1<n_; k1++){
+      if( is_recomputed[k1] )
+    continue;
+      for(unsigned k2=k1+1; k2<n_ and !is_recomputed[k1]; k2++){
+    if( is_recomputed[k2] )
+      continue;
+    const edge_rtree& changed_edges
+      = previous_graph( previous_index[k1], previous_index[k2] )
+      ? added_edges : removed_edges;
+    if( changed_edges.empty() )
+      continue;
+    Line_Segment segment( environment(k1), environment(k2) );
+    candidates.clear();
+    changed_edges.query( boost::geometry::index::intersects(
+                 segment_box(segment, epsilon) ),
+                 std::back_inserter(candidates) );
+    for(unsigned c=0; c<candidates.size(); c++){
+      if( distance( segment, candidates[c].second ) <= epsilon ){
+        //recompute the later vertex, as the Environment constructor
+        //takes the visibility of a pair from it
+        is_recomputed[k2] = true;
+        break;
+      }
+    }
+      }
+    }
+
+    //keep the visibility of unaffected pairs
+    for(unsigned k1=0; k1<n_; k1++){
+      if( is_recomputed[k1] )
+    continue;
+      for(unsigned k2=0; k2<n_; k2++){
+    if( !is_recomputed[k2] )
+      adjacency_matrix_[ k1 ][ k2 ]
+        = previous_graph( previous_index[k1], previous_index[k2] );
+      }
+    }
+
+    // fill the affected rows and columns by checking for inclusion in
+    // the visibility polygons
+    Polygon polygon_temp;
+    for(unsigned k1=0; k1<n_; k1++){
+      if( !is_recomputed[k1] )
+    continue;
+      polygon_temp = Visibility_Polygon( environment(k1),
+                     environment,
+                     epsilon );
+      for(unsigned k2=0; k2<n_; k2++){
+    if( k1 == k2 )
+      adjacency_matrix_[ k1 ][ k1 ] = true;
+    else if( !is_recomputed[k2] or k2 < k1 )
+      adjacency_matrix_[ k1 ][ k2 ] =
+        adjacency_matrix_[ k2 ][ k1 ] =
+        environment(k2).in( polygon_temp , epsilon );
+      }
+    }
+  }
+
+
   Visibility_Graph::Visibility_Graph(const std::vector<Point> points,
                      const Environment& environment,
                      double epsilon)
@@ -1633,6 +1633,34 @@ namespace VisiLibity
     Polyline shortest_path(const Point& start,
                const Point& finish,
                double epsilon=0.0);
+    /** \brief  compute shortest paths from one Point to many Points
+     *
+     * \pre  the observers of \a start_visibility_polygon and of each
+     * of \a finish_visibility_polygons (not null) must be in the environment, and
+     * the polygons must have been computed in this Environment with
+     * the same \a epsilon.  Environment must be \a epsilon -valid.
+     *
+     * \remarks  Runs one Dijkstra search from the start over the
+     * precomputed Visibility_Graph, O(n^2), then connects each finish
+     * in O(n), so a row of a cost matrix takes one search instead of
+     * one search per finish.  Passing precomputed visibility polygons
+     * lets a full matrix compute (and share) each polygon once.  Entry k of the
+     * result is the path to finish k in the same form as
+     * shortest_path() (empty if finish k cannot be reached).
+     */
+    std::vector<Polyline> shortest_paths(const Visibility_Polygon& start_visibility_polygon,
+                     const std::vector<const Visibility_Polygon*>& finish_visibility_polygons,
+                     const Visibility_Graph& visibility_graph,
+                     double epsilon=0.0) const;
+    /** \brief  compute shortest paths from one Point to many Points
+     *
+     * \remarks  computes the visibility polygons, then calls the
+     * overload above.
+     */
+    std::vector<Polyline> shortest_paths(const Point& start,
+                     const std::vector<Point>& finishes,
+                     const Visibility_Graph& visibility_graph,
+                     double epsilon=0.0) const;
     /** \brief  compute the faces (partition cells) of an arrangement
      *          of Line_Segments inside the Environment
      *
@@ -2165,6 +2193,27 @@ namespace VisiLibity
      * Implementing the optimal algorithm robustly is future work.
      */
     Visibility_Graph(const Environment& environment, double epsilon=0.0);
+    /** \brief  construct the visibility graph of Environment vertices
+     *          by updating the graph of a previous Environment
+     *
+     * \pre \a environment must be \a epsilon -valid and \a
+     * previous_graph must be the visibility graph of \a
+     * previous_environment.
+     *
+     * \remarks  Intended for holes added to or removed from an
+     * Environment (e.g., a pop-up keep-out zone).  Holes that are
+     * identical in both Environments keep their visibility; only the
+     * vertices of added holes and the vertices of pairs whose segment
+     * passes within \a epsilon of an edge of an added (visible pairs)
+     * or removed (occluded pairs) hole get a new Visibility_Polygon.
+     * Affected pairs are found with an R-tree of the changed edges;
+     * recomputed vertices are evaluated as in the Environment
+     * constructor, which this constructor falls back to if the outer
+     * boundaries differ.
+     */
+    Visibility_Graph(const Visibility_Graph& previous_graph,
+             const Environment& previous_environment,
+             const Environment& environment, double epsilon=0.0);
     //Constructors
     /** \brief  construct the visibility graph of Points in an Environment
      *
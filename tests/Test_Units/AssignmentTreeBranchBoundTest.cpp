@@ -0,0 +1,677 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   AssignmentTreeBranchBoundTest.cpp
+ *
+ * Functional checks of the assignment tree search on small fixed cost
+ * matrices: the parallel search must return the assignment of the serial
+ * search, also when several assignments have the minimum cost, repeated
+ * searches must return the same assignment, deadlines must stop searches,
+ * provisional candidates must be published from the thread that started the
+ * search (also while it waits for the pool), concurrent searches of different
+ * services must not affect each other, the vehicles' travel time tables
+ * must hold the cost matrix (-1 where it has no entry) and search nodes must
+ * be allocated from, and returned to, the arena of their thread.
+ */
+#include "gtest/gtest.h"
+
+#include "AssignmentTreeBranchBoundService.h"
+
+#include "afrl/cmasi/AutomationRequest.h"
+#include "uxas/messages/task/TaskOption.h"
+#include "uxas/messages/task/TaskOptionCost.h"
+
+#include "stdUniquePtr.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+
+using uxas::service::c_Node_Base;
+using uxas::service::c_NodeArena;
+
+const int64_t c_automationRequestId{7};
+const uint32_t c_threadCount{4};
+/** \brief Thread timing differs between parallel searches, so each is repeated. */
+const int c_parallelSearchCount{5};
+/** \brief Nodes are preceded by a header that holds their arena. */
+const size_t c_nodeHeaderSize{16};
+/** \brief Exhaustive searches of the large scenario take minutes. */
+const int64_t c_largeScenarioTaskCount{12};
+const int64_t c_assignmentDeadline_ms{200};
+/** \brief Generous, so that loaded machines still pass. */
+const std::chrono::seconds c_deadlineTolerance{10};
+
+struct Location
+{
+    int64_t m_x;
+    int64_t m_y;
+};
+
+/** \brief Vehicles (IDs 1..n) and tasks (IDs 1..m) on a grid. Travel times are
+ * Manhattan distances (s), tasks with two locations have two options. */
+struct Scenario
+{
+    std::vector<Location> m_vehicleStarts;
+    std::vector< std::vector<Location> > m_taskOptionLocations;
+    int64_t m_taskTime_ms{0};
+};
+
+/** \brief (vehicle ID, task ID, option ID, time task completed) */
+typedef std::tuple<int64_t, int64_t, int64_t, int64_t> Assignment;
+
+int64_t
+getTravelTime_ms(const Location& from, const Location& to)
+{
+    return ((std::abs(from.m_x - to.m_x) + std::abs(from.m_y - to.m_y)) * 1000);
+}
+
+/** \brief Assignment service that searches without sending messages. */
+class AssignmentTestService : public uxas::service::AssignmentTreeBranchBoundService
+{
+public:
+
+    using uxas::service::AssignmentTreeBranchBoundService::AssigmentPrerequisites;
+    using uxas::service::AssignmentTreeBranchBoundService::isInitializeAssignment;
+    using uxas::service::AssignmentTreeBranchBoundService::releaseAssignmentNodes;
+    using uxas::service::AssignmentTreeBranchBoundService::m_staticAssignmentParameters;
+
+    // exhaustive searches, only these run in parallel
+    explicit AssignmentTestService(uint32_t threadCount)
+    {
+        m_numberNodesMaximum = -1;
+        m_assignmentThreadCount = threadCount;
+        if (m_assignmentThreadCount > 1)
+        {
+            m_assignmentThreadPool = uxas::stduxas::make_unique<uxas::common::ThreadPool>(m_assignmentThreadCount);
+        }
+    };
+
+    // the candidate assignment, ordered by vehicle ID and completion time
+    std::vector<Assignment>
+    calculate(const std::shared_ptr<AssigmentPrerequisites>& prerequisites, int64_t& cost)
+    {
+        std::unique_ptr<c_Node_Base> nodeAssignment(new uxas::service::c_Node_TreeBranchAndBound);
+        EXPECT_TRUE(isInitializeAssignment(*nodeAssignment, prerequisites));
+        if (m_newCandidateCallback)
+        {
+            m_staticAssignmentParameters->m_publishingThreadId = std::this_thread::get_id();
+            m_staticAssignmentParameters->m_newCandidateCallback = m_newCandidateCallback;
+        }
+        searchAssignment(*nodeAssignment, prerequisites);
+        cost = m_staticAssignmentParameters->m_minimumAssignmentCostCandidate;
+        auto taskAssignmentSummary = getCandidateAssignmentSummary(prerequisites);
+        setWarmStartAssignment(taskAssignmentSummary);
+        releaseAssignmentNodes(std::move(nodeAssignment));
+
+        std::vector<Assignment> assignments;
+        for (auto& taskAssignment : taskAssignmentSummary->getTaskList())
+        {
+            assignments.push_back(std::make_tuple(taskAssignment->getAssignedVehicle(), taskAssignment->getTaskID(),
+                                                  taskAssignment->getOptionID(), taskAssignment->getTimeTaskCompleted()));
+        }
+        std::sort(assignments.begin(), assignments.end(), [](const Assignment& lhs, const Assignment& rhs)
+        {
+            return (std::make_tuple(std::get<0>(lhs), std::get<3>(lhs)) < std::make_tuple(std::get<0>(rhs), std::get<3>(rhs)));
+        });
+        return (assignments);
+    };
+
+    void
+    setAssignmentDeadline_ms(int64_t assignmentDeadline_ms) { m_assignmentDeadline_ms = assignmentDeadline_ms; };
+
+    void
+    setNumberNodesMaximum(int64_t numberNodesMaximum) { m_numberNodesMaximum = numberNodesMaximum; };
+
+    void
+    setIsWarmStartAssignment(bool isWarmStartAssignment) { m_isWarmStartAssignment = isWarmStartAssignment; };
+
+    /** \brief Called like the provisional assignment publisher, if not empty. */
+    std::function<void()> m_newCandidateCallback;
+};
+
+void
+addTaskOptionCost(uxas::messages::task::AssignmentCostMatrix& costMatrix, int64_t vehicleId,
+                  int64_t fromTaskId, int64_t fromOptionId, int64_t toTaskId, int64_t toOptionId, int64_t timeToGo_ms)
+{
+    auto taskOptionCost = new uxas::messages::task::TaskOptionCost;
+    taskOptionCost->setVehicleID(vehicleId);
+    taskOptionCost->setIntialTaskID(fromTaskId);
+    taskOptionCost->setIntialTaskOption(fromOptionId);
+    taskOptionCost->setDestinationTaskID(toTaskId);
+    taskOptionCost->setDestinationTaskOption(toOptionId);
+    taskOptionCost->setTimeToGo(timeToGo_ms);
+    costMatrix.getCostMatrix().push_back(taskOptionCost);
+}
+
+// automation request, task plan options and the complete cost matrix of a scenario
+std::shared_ptr<AssignmentTestService::AssigmentPrerequisites>
+createPrerequisites(const Scenario& scenario)
+{
+    auto prerequisites = std::make_shared<AssignmentTestService::AssigmentPrerequisites>();
+    auto automationRequest = new afrl::cmasi::AutomationRequest;
+    prerequisites->m_uniqueAutomationRequest = std::make_shared<uxas::messages::task::UniqueAutomationRequest>();
+    prerequisites->m_uniqueAutomationRequest->setRequestID(c_automationRequestId);
+    prerequisites->m_uniqueAutomationRequest->setOriginalRequest(automationRequest);
+    prerequisites->m_assignmentCostMatrix = std::make_shared<uxas::messages::task::AssignmentCostMatrix>();
+    prerequisites->m_assignmentCostMatrix->setCorrespondingAutomationRequestID(c_automationRequestId);
+
+    for (size_t vehicle = 0; vehicle < scenario.m_vehicleStarts.size(); vehicle++)
+    {
+        automationRequest->getEntityList().push_back(static_cast<int64_t>(vehicle) + 1);
+    }
+    for (size_t task = 0; task < scenario.m_taskOptionLocations.size(); task++)
+    {
+        int64_t taskId = static_cast<int64_t>(task) + 1;
+        automationRequest->getTaskList().push_back(taskId);
+        prerequisites->m_assignmentCostMatrix->getTaskList().push_back(taskId);
+        auto taskPlanOptions = std::make_shared<uxas::messages::task::TaskPlanOptions>();
+        taskPlanOptions->setCorrespondingAutomationRequestID(c_automationRequestId);
+        taskPlanOptions->setTaskID(taskId);
+        std::string composition("+(");
+        for (size_t option = 0; option < scenario.m_taskOptionLocations[task].size(); option++)
+        {
+            auto taskOption = new uxas::messages::task::TaskOption;
+            taskOption->setTaskID(taskId);
+            taskOption->setOptionID(static_cast<int64_t>(option) + 1);
+            taskOption->setCost(scenario.m_taskTime_ms);
+            taskOption->getEligibleEntities() = automationRequest->getEntityList();
+            taskPlanOptions->getOptions().push_back(taskOption);
+            composition += "p" + std::to_string(option + 1) + " ";
+        }
+        taskPlanOptions->setComposition(composition + ")");
+        prerequisites->m_taskIdVsTaskPlanOptions[taskId] = taskPlanOptions;
+    }
+
+    for (size_t vehicle = 0; vehicle < scenario.m_vehicleStarts.size(); vehicle++)
+    {
+        int64_t vehicleId = static_cast<int64_t>(vehicle) + 1;
+        for (size_t toTask = 0; toTask < scenario.m_taskOptionLocations.size(); toTask++)
+        {
+            for (size_t toOption = 0; toOption < scenario.m_taskOptionLocations[toTask].size(); toOption++)
+            {
+                const Location& to = scenario.m_taskOptionLocations[toTask][toOption];
+                addTaskOptionCost(*prerequisites->m_assignmentCostMatrix, vehicleId, 0, 0, toTask + 1, toOption + 1,
+                                  getTravelTime_ms(scenario.m_vehicleStarts[vehicle], to));
+                for (size_t fromTask = 0; fromTask < scenario.m_taskOptionLocations.size(); fromTask++)
+                {
+                    for (size_t fromOption = 0; (fromTask != toTask) && (fromOption < scenario.m_taskOptionLocations[fromTask].size()); fromOption++)
+                    {
+                        addTaskOptionCost(*prerequisites->m_assignmentCostMatrix, vehicleId, fromTask + 1, fromOption + 1, toTask + 1, toOption + 1,
+                                          getTravelTime_ms(scenario.m_taskOptionLocations[fromTask][fromOption], to));
+                    }
+                }
+            }
+        }
+    }
+    return (prerequisites);
+}
+
+// removes the costs of one vehicle from one task option (task ID 0: the vehicle's start) to another
+void
+removeTaskOptionCost(uxas::messages::task::AssignmentCostMatrix& costMatrix, int64_t vehicleId,
+                     int64_t fromTaskId, int64_t fromOptionId, int64_t toTaskId, int64_t toOptionId)
+{
+    auto& taskOptionCosts = costMatrix.getCostMatrix();
+    for (auto itTaskOptionCost = taskOptionCosts.begin(); itTaskOptionCost != taskOptionCosts.end();)
+    {
+        if (((*itTaskOptionCost)->getVehicleID() == vehicleId) &&
+                ((*itTaskOptionCost)->getIntialTaskID() == fromTaskId) && ((*itTaskOptionCost)->getIntialTaskOption() == fromOptionId) &&
+                ((*itTaskOptionCost)->getDestinationTaskID() == toTaskId) && ((*itTaskOptionCost)->getDestinationTaskOption() == toOptionId))
+        {
+            delete *itTaskOptionCost;
+            itTaskOptionCost = taskOptionCosts.erase(itTaskOptionCost);
+        }
+        else
+        {
+            itTaskOptionCost++;
+        }
+    }
+}
+
+void
+expectParallelEqualsSerial(const Scenario& scenario)
+{
+    auto prerequisites = createPrerequisites(scenario);
+    AssignmentTestService serialService(1);
+    int64_t serialCost(0);
+    auto serialAssignments = serialService.calculate(prerequisites, serialCost);
+    ASSERT_EQ(scenario.m_taskOptionLocations.size(), serialAssignments.size());
+    ASSERT_LT(serialCost, INT64_MAX);
+
+    AssignmentTestService parallelService(c_threadCount);
+    for (int search = 0; search < c_parallelSearchCount; search++)
+    {
+        int64_t parallelCost(0);
+        auto parallelAssignments = parallelService.calculate(prerequisites, parallelCost);
+        EXPECT_EQ(serialCost, parallelCost) << "search " << search;
+        EXPECT_EQ(serialAssignments, parallelAssignments) << "search " << search;
+    }
+}
+
+} //namespace
+
+TEST(AssignmentTreeBranchBoundTest, parallel_equals_serial)
+{
+    Scenario scenario;
+    scenario.m_vehicleStarts = {{0, 0}, {40, 0}, {0, 35}};
+    scenario.m_taskOptionLocations = {{{10, 3}}, {{25, 17}, {31, 2}}, {{7, 29}}, {{44, 21}}, {{18, 40}, {3, 12}}, {{33, 33}}, {{12, 19}}};
+    scenario.m_taskTime_ms = 2000;
+    expectParallelEqualsSerial(scenario);
+}
+
+TEST(AssignmentTreeBranchBoundTest, parallel_equals_serial_tied_costs)
+{
+    // identical vehicles and symmetric tasks: many assignments have the minimum cost
+    Scenario scenario;
+    scenario.m_vehicleStarts = {{0, 0}, {0, 0}, {0, 0}};
+    scenario.m_taskOptionLocations = {{{10, 0}}, {{-10, 0}}, {{0, 10}}, {{0, -10}}, {{10, 10}}, {{-10, -10}}};
+    scenario.m_taskTime_ms = 1000;
+    expectParallelEqualsSerial(scenario);
+}
+
+TEST(AssignmentTreeBranchBoundTest, node_arena)
+{
+    c_NodeArena arena;
+    void* memory = arena.allocate(40);
+    ASSERT_NE(nullptr, memory);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(memory) % 16);
+    void* otherMemory = arena.allocate(40);
+    EXPECT_EQ(static_cast<char*>(memory) + 48, static_cast<char*>(otherMemory));
+
+    // freed chunks are reused by allocations of the same rounded size only
+    arena.deallocate(memory, 40);
+    void* largerMemory = arena.allocate(72);
+    EXPECT_NE(memory, largerMemory);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(largerMemory) % 16);
+    EXPECT_EQ(memory, arena.allocate(33));
+
+    // allocations larger than a block get their own block
+    char* bigMemory = static_cast<char*>(arena.allocate(200 * 1024));
+    bigMemory[0] = 1;
+    bigMemory[200 * 1024 - 1] = 1;
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(arena.allocate(24)) % 16);
+}
+
+TEST(AssignmentTreeBranchBoundTest, node_allocation)
+{
+    ASSERT_EQ(nullptr, c_NodeArena::threadArena());
+
+    // without a thread arena, nodes are allocated from the heap
+    c_Node_Base* heapNode = new uxas::service::c_Node_TreeBranchAndBound;
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(heapNode) % 16);
+    EXPECT_EQ(nullptr, *reinterpret_cast<c_NodeArena**>(reinterpret_cast<char*>(heapNode) - c_nodeHeaderSize));
+    delete heapNode;
+
+    // with a thread arena, the header holds the arena and deleted nodes are reused
+    c_NodeArena arena;
+    c_NodeArena::threadArena() = &arena;
+    c_Node_Base* arenaNode = new uxas::service::c_Node_TreeBranchAndBound;
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(arenaNode) % 16);
+    EXPECT_EQ(&arena, *reinterpret_cast<c_NodeArena**>(reinterpret_cast<char*>(arenaNode) - c_nodeHeaderSize));
+    c_Node_Base* otherArenaNode = new uxas::service::c_Node_TreeBranchAndBound;
+    delete arenaNode;
+    c_Node_Base* reusedArenaNode = new uxas::service::c_Node_TreeBranchAndBound;
+    EXPECT_EQ(arenaNode, reusedArenaNode);
+
+    // nodes of another thread's arena are released with that arena
+    c_NodeArena otherArena;
+    c_NodeArena::threadArena() = &otherArena;
+    delete otherArenaNode;
+    c_NodeArena::threadArena() = &arena;
+    c_Node_Base* newArenaNode = new uxas::service::c_Node_TreeBranchAndBound;
+    EXPECT_NE(otherArenaNode, newArenaNode);
+    delete newArenaNode;
+    delete reusedArenaNode;
+    c_NodeArena::threadArena() = nullptr;
+}
+
+TEST(AssignmentTreeBranchBoundTest, repeated_search)
+{
+    // the arenas of a search are released and the next search on the same thread starts from the heap again
+    Scenario scenario;
+    scenario.m_vehicleStarts = {{0, 0}, {40, 0}, {0, 35}};
+    scenario.m_taskOptionLocations = {{{10, 3}}, {{25, 17}, {31, 2}}, {{7, 29}}, {{44, 21}}, {{18, 40}, {3, 12}}, {{33, 33}}};
+    scenario.m_taskTime_ms = 2000;
+    auto prerequisites = createPrerequisites(scenario);
+    for (uint32_t threadCount : {1u, c_threadCount})
+    {
+        AssignmentTestService service(threadCount);
+        int64_t cost(0);
+        auto assignments = service.calculate(prerequisites, cost);
+        ASSERT_EQ(scenario.m_taskOptionLocations.size(), assignments.size());
+        EXPECT_EQ(nullptr, c_NodeArena::threadArena());
+        EXPECT_TRUE(service.m_staticAssignmentParameters->m_nodeArenas.empty());
+
+        int64_t repeatedCost(0);
+        EXPECT_EQ(assignments, service.calculate(prerequisites, repeatedCost)) << "threads " << threadCount;
+        EXPECT_EQ(cost, repeatedCost) << "threads " << threadCount;
+        EXPECT_EQ(nullptr, c_NodeArena::threadArena());
+        EXPECT_TRUE(service.m_staticAssignmentParameters->m_nodeArenas.empty());
+    }
+}
+
+TEST(AssignmentTreeBranchBoundTest, concurrent_searches)
+{
+    // each service searches with its own parameters, also while other services search
+    Scenario scenario;
+    scenario.m_vehicleStarts = {{0, 0}, {40, 0}, {0, 35}};
+    scenario.m_taskOptionLocations = {{{10, 3}}, {{25, 17}, {31, 2}}, {{7, 29}}, {{44, 21}}, {{18, 40}, {3, 12}}, {{33, 33}}};
+    scenario.m_taskTime_ms = 2000;
+    Scenario otherScenario(scenario);
+    otherScenario.m_vehicleStarts = {{20, 20}, {5, 40}};
+    std::vector< std::shared_ptr<AssignmentTestService::AssigmentPrerequisites> > prerequisites{createPrerequisites(scenario), createPrerequisites(otherScenario)};
+    std::vector< std::vector<Assignment> > expectedAssignments;
+    std::vector<int64_t> expectedCosts;
+    for (auto& searchPrerequisites : prerequisites)
+    {
+        AssignmentTestService service(1);
+        int64_t cost(0);
+        expectedAssignments.push_back(service.calculate(searchPrerequisites, cost));
+        expectedCosts.push_back(cost);
+    }
+    ASSERT_NE(expectedCosts[0], expectedCosts[1]);
+
+    std::vector< std::vector<Assignment> > assignments(prerequisites.size());
+    std::vector<int64_t> costs(prerequisites.size(), 0);
+    std::vector<std::thread> threads;
+    for (size_t search = 0; search < prerequisites.size(); search++)
+    {
+        threads.emplace_back([&, search]()
+        {
+            AssignmentTestService service(search == 0 ? 1 : c_threadCount);
+            for (int repeat = 0; repeat < c_parallelSearchCount; repeat++)
+            {
+                assignments[search] = service.calculate(prerequisites[search], costs[search]);
+                if ((assignments[search] != expectedAssignments[search]) || (costs[search] != expectedCosts[search]))
+                {
+                    break;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(expectedAssignments, assignments);
+    EXPECT_EQ(expectedCosts, costs);
+}
+
+// many tasks spread over a grid: an exhaustive search takes far longer than the deadline
+Scenario
+createLargeScenario()
+{
+    Scenario scenario;
+    scenario.m_vehicleStarts = {{0, 0}, {50, 0}, {0, 50}, {50, 50}};
+    for (int64_t task = 0; task < c_largeScenarioTaskCount; task++)
+    {
+        scenario.m_taskOptionLocations.push_back({{(task * 37) % 53, (task * 23) % 47}});
+    }
+    scenario.m_taskTime_ms = 1000;
+    return (scenario);
+}
+
+TEST(AssignmentTreeBranchBoundTest, deadline)
+{
+    auto scenario = createLargeScenario();
+    auto prerequisites = createPrerequisites(scenario);
+    for (uint32_t threadCount : {1u, c_threadCount})
+    {
+        AssignmentTestService service(threadCount);
+        service.setAssignmentDeadline_ms(c_assignmentDeadline_ms);
+        int64_t cost(0);
+        auto start = std::chrono::steady_clock::now();
+        auto assignments = service.calculate(prerequisites, cost);
+        auto searchTime = std::chrono::steady_clock::now() - start;
+        EXPECT_TRUE(service.m_staticAssignmentParameters->m_isDeadlineReached) << "threads " << threadCount;
+        EXPECT_EQ(scenario.m_taskOptionLocations.size(), assignments.size()) << "threads " << threadCount;
+        EXPECT_LT(cost, INT64_MAX) << "threads " << threadCount;
+        EXPECT_GE(searchTime, std::chrono::milliseconds(c_assignmentDeadline_ms)) << "threads " << threadCount;
+        EXPECT_LT(searchTime, std::chrono::milliseconds(c_assignmentDeadline_ms) + c_deadlineTolerance) << "threads " << threadCount;
+    }
+}
+
+TEST(AssignmentTreeBranchBoundTest, provisional_assignments)
+{
+    // candidates are published from the thread that started the search, costs never increase
+    auto prerequisites = createPrerequisites(createLargeScenario());
+    for (uint32_t threadCount : {1u, c_threadCount})
+    {
+        AssignmentTestService service(threadCount);
+        service.setAssignmentDeadline_ms(c_assignmentDeadline_ms);
+        std::vector<int64_t> publishedCosts;
+        bool isPublishedOnOtherThread(false);
+        const std::thread::id searchThreadId = std::this_thread::get_id();
+        service.m_newCandidateCallback = [&]()
+        {
+            isPublishedOnOtherThread = isPublishedOnOtherThread || (std::this_thread::get_id() != searchThreadId);
+            publishedCosts.push_back(service.m_staticAssignmentParameters->m_minimumAssignmentCostCandidate);
+        };
+        int64_t cost(0);
+        service.calculate(prerequisites, cost);
+
+        EXPECT_FALSE(isPublishedOnOtherThread) << "threads " << threadCount;
+        ASSERT_FALSE(publishedCosts.empty()) << "threads " << threadCount;
+        for (size_t published = 1; published < publishedCosts.size(); published++)
+        {
+            EXPECT_LE(publishedCosts[published], publishedCosts[published - 1]) << "threads " << threadCount;
+        }
+        EXPECT_GE(publishedCosts.back(), cost) << "threads " << threadCount;
+        if (threadCount == 1)
+        {
+            // without a pool every candidate is published as soon as it is found
+            EXPECT_EQ(service.m_staticAssignmentParameters->m_numberCompleteAssignments, static_cast<int64_t>(publishedCosts.size()));
+            EXPECT_EQ(cost, publishedCosts.back());
+        }
+    }
+}
+
+TEST(AssignmentTreeBranchBoundTest, parallel_for_periodic)
+{
+    // the calling thread keeps calling periodic() while the workers execute the remaining indexes
+    uxas::common::ThreadPool threadPool(c_threadCount);
+    const std::thread::id callingThreadId = std::this_thread::get_id();
+    std::atomic<uint32_t> periodicCount{0};
+    std::atomic<bool> isPeriodicOnOtherThread{false};
+    std::atomic<uint32_t> numberWorkerIndexes{0};
+    std::atomic<uint32_t> numberIndexesWaited{0};
+    std::vector<int> isExecuted(c_threadCount * 4, 0);
+    threadPool.parallelFor(isExecuted.size(), [&](size_t index)
+    {
+        auto start = std::chrono::steady_clock::now();
+        if (std::this_thread::get_id() == callingThreadId)
+        {
+            // leave indexes to the workers
+            while ((numberWorkerIndexes == 0) && (std::chrono::steady_clock::now() - start < c_deadlineTolerance))
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        else
+        {
+            numberWorkerIndexes++;
+            while ((periodicCount < 3) && (std::chrono::steady_clock::now() - start < c_deadlineTolerance))
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            numberIndexesWaited += (periodicCount >= 3) ? 1 : 0;
+        }
+        isExecuted[index]++;
+    }, std::chrono::milliseconds(1), [&]()
+    {
+        isPeriodicOnOtherThread = isPeriodicOnOtherThread || (std::this_thread::get_id() != callingThreadId);
+        periodicCount++;
+    });
+
+    EXPECT_EQ(std::vector<int>(isExecuted.size(), 1), isExecuted);
+    EXPECT_FALSE(isPeriodicOnOtherThread);
+    EXPECT_EQ(numberWorkerIndexes, numberIndexesWaited);
+    EXPECT_LT(0u, numberIndexesWaited);
+    // periodic() is not called after parallelFor returns
+    uint32_t finalPeriodicCount = periodicCount;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(finalPeriodicCount, periodicCount);
+}
+
+TEST(AssignmentTreeBranchBoundTest, warm_start)
+{
+    Scenario scenario;
+    scenario.m_vehicleStarts = {{0, 0}, {40, 0}, {0, 35}};
+    scenario.m_taskOptionLocations = {{{10, 3}}, {{25, 17}, {31, 2}}, {{7, 29}}, {{44, 21}}, {{18, 40}, {3, 12}}, {{33, 33}}, {{12, 19}}};
+    scenario.m_taskTime_ms = 2000;
+    auto prerequisites = createPrerequisites(scenario);
+    AssignmentTestService service(1);
+    service.setIsWarmStartAssignment(true);
+    int64_t cost(0);
+    auto assignments = service.calculate(prerequisites, cost);
+    ASSERT_EQ(scenario.m_taskOptionLocations.size(), assignments.size());
+
+    // searches that stop at the first complete assignment: without a warm start it is worse
+    AssignmentTestService coldStartService(1);
+    coldStartService.setNumberNodesMaximum(1);
+    int64_t coldStartCost(0);
+    coldStartService.calculate(prerequisites, coldStartCost);
+    ASSERT_GT(coldStartCost, cost);
+
+    // ... with a warm start it is the previous assignment
+    service.setNumberNodesMaximum(1);
+    int64_t warmStartCost(0);
+    EXPECT_EQ(assignments, service.calculate(prerequisites, warmStartCost));
+    EXPECT_EQ(cost, warmStartCost);
+
+    // exhaustive searches return the same assignment with a warm start
+    service.setNumberNodesMaximum(-1);
+    EXPECT_EQ(assignments, service.calculate(prerequisites, warmStartCost));
+    EXPECT_EQ(cost, warmStartCost);
+
+    // a new task is added to the previous assignment
+    scenario.m_taskOptionLocations.push_back({{20, 8}});
+    service.setNumberNodesMaximum(1);
+    auto addedTaskAssignments = service.calculate(createPrerequisites(scenario), warmStartCost);
+    ASSERT_EQ(scenario.m_taskOptionLocations.size(), addedTaskAssignments.size());
+    for (auto& assignment : assignments)
+    {
+        EXPECT_TRUE(std::any_of(addedTaskAssignments.begin(), addedTaskAssignments.end(), [&assignment](const Assignment& addedTaskAssignment)
+        {
+            return (std::make_tuple(std::get<0>(assignment), std::get<1>(assignment), std::get<2>(assignment)) ==
+                    std::make_tuple(std::get<0>(addedTaskAssignment), std::get<1>(addedTaskAssignment), std::get<2>(addedTaskAssignment)));
+        })) << "vehicle " << std::get<0>(assignment) << " task " << std::get<1>(assignment);
+    }
+}
+
+TEST(AssignmentTreeBranchBoundTest, travel_time_table)
+{
+    Scenario scenario;
+    scenario.m_vehicleStarts = {{0, 0}, {40, 0}, {0, 35}};
+    scenario.m_taskOptionLocations = {{{10, 3}}, {{25, 17}, {31, 2}}, {{7, 29}}, {{44, 21}}};
+    scenario.m_taskTime_ms = 2000;
+    auto prerequisites = createPrerequisites(scenario);
+
+    // pairs without costs, costs of task options that were not requested and a task vehicle 1 can not do
+    auto& costMatrix = *prerequisites->m_assignmentCostMatrix;
+    removeTaskOptionCost(costMatrix, 2, 1, 1, 3, 1);
+    removeTaskOptionCost(costMatrix, 2, 3, 1, 1, 1);
+    removeTaskOptionCost(costMatrix, 3, 0, 0, 2, 2);
+    removeTaskOptionCost(costMatrix, 1, 2, 2, 4, 1);
+    addTaskOptionCost(costMatrix, 1, 0, 0, 9, 1, 5000);
+    addTaskOptionCost(costMatrix, 1, 9, 1, 1, 1, 5000);
+    addTaskOptionCost(costMatrix, 1, 1, 1, 2, 3, 5000);
+    auto& taskOptions = prerequisites->m_taskIdVsTaskPlanOptions[4]->getOptions();
+    taskOptions.front()->getEligibleEntities().erase(taskOptions.front()->getEligibleEntities().begin());
+
+    // expected travel times by vehicle ID, from task option ID (0: start) and to task option ID
+    std::map<std::tuple<int64_t, int64_t, int64_t>, int64_t> expectedTravelTimes;
+    for (auto& taskOptionCost : costMatrix.getCostMatrix())
+    {
+        expectedTravelTimes[std::make_tuple(taskOptionCost->getVehicleID(),
+                uxas::service::c_TaskAssignmentState::getTaskAndOptionId(taskOptionCost->getIntialTaskID(), taskOptionCost->getIntialTaskOption()),
+                uxas::service::c_TaskAssignmentState::getTaskAndOptionId(taskOptionCost->getDestinationTaskID(), taskOptionCost->getDestinationTaskOption()))] =
+                taskOptionCost->getTimeToGo();
+    }
+
+    AssignmentTestService service(1);
+    std::unique_ptr<c_Node_Base> nodeAssignment(new uxas::service::c_Node_TreeBranchAndBound);
+    ASSERT_TRUE(service.isInitializeAssignment(*nodeAssignment, prerequisites));
+    auto& staticAssignmentParameters = *service.m_staticAssignmentParameters;
+    ASSERT_EQ(&staticAssignmentParameters, nodeAssignment->m_staticAssignmentParameters);
+    ASSERT_EQ(5u, staticAssignmentParameters.m_taskOptionIdVsInformation.size());
+    ASSERT_EQ(scenario.m_vehicleStarts.size(), staticAssignmentParameters.m_vehicleIdVsInformation.size());
+
+    // location 0 is the vehicle's start, location i + 1 the end of the task option with index i
+    std::vector<int64_t> locationTaskOptionIds(1, 0);
+    locationTaskOptionIds.resize(staticAssignmentParameters.m_taskOptionIdVsInformation.size() + 1);
+    for (auto& taskOptionInformation : staticAssignmentParameters.m_taskOptionIdVsInformation)
+    {
+        locationTaskOptionIds[taskOptionInformation.second->m_taskOptionIndex + 1] = taskOptionInformation.first;
+    }
+
+    size_t numberMissingTravelTimes(0);
+    for (auto& vehicleInformation : staticAssignmentParameters.m_vehicleIdVsInformation)
+    {
+        int64_t vehicleId = vehicleInformation.first;
+        EXPECT_EQ(vehicleId, staticAssignmentParameters.m_vehicleIds[vehicleInformation.second->m_vehicleIndex]);
+        for (size_t toIndex = 0; toIndex + 1 < locationTaskOptionIds.size(); toIndex++)
+        {
+            int64_t toTaskOptionId = locationTaskOptionIds[toIndex + 1];
+            bool isEligible = (vehicleId != 1) || (uxas::service::c_TaskAssignmentState::getTaskID(toTaskOptionId) != 4);
+            EXPECT_EQ(isEligible ? scenario.m_taskTime_ms : -1, vehicleInformation.second->m_taskTime_ms[toIndex])
+                    << "vehicle " << vehicleId << " task option " << toTaskOptionId;
+            for (size_t fromLocationIndex = 0; fromLocationIndex < locationTaskOptionIds.size(); fromLocationIndex++)
+            {
+                auto itExpected = expectedTravelTimes.find(std::make_tuple(vehicleId, locationTaskOptionIds[fromLocationIndex], toTaskOptionId));
+                int64_t expectedTravelTime_ms = (itExpected == expectedTravelTimes.end()) ? -1 : itExpected->second;
+                numberMissingTravelTimes += (expectedTravelTime_ms < 0) ? 1 : 0;
+                EXPECT_EQ(expectedTravelTime_ms, vehicleInformation.second->getTravelTime_ms(fromLocationIndex, toIndex))
+                        << "vehicle " << vehicleId << " from " << locationTaskOptionIds[fromLocationIndex] << " to " << toTaskOptionId;
+            }
+        }
+    }
+    // no costs from a task option to itself or to the other option of task 2, and the removed pairs
+    EXPECT_EQ(scenario.m_vehicleStarts.size() * (5 + 2) + 4, numberMissingTravelTimes);
+    AssignmentTestService::releaseAssignmentNodes(std::move(nodeAssignment));
+
+    // assignments only use pairs with costs and vehicles only do tasks they are eligible for
+    int64_t cost(0);
+    auto assignments = service.calculate(prerequisites, cost);
+    ASSERT_EQ(scenario.m_taskOptionLocations.size(), assignments.size());
+    for (size_t assignment = 0; assignment < assignments.size(); assignment++)
+    {
+        int64_t vehicleId = std::get<0>(assignments[assignment]);
+        int64_t fromTaskOptionId(0);
+        if ((assignment > 0) && (std::get<0>(assignments[assignment - 1]) == vehicleId))
+        {
+            fromTaskOptionId = uxas::service::c_TaskAssignmentState::getTaskAndOptionId(std::get<1>(assignments[assignment - 1]), std::get<2>(assignments[assignment - 1]));
+        }
+        int64_t toTaskOptionId = uxas::service::c_TaskAssignmentState::getTaskAndOptionId(std::get<1>(assignments[assignment]), std::get<2>(assignments[assignment]));
+        EXPECT_TRUE(expectedTravelTimes.find(std::make_tuple(vehicleId, fromTaskOptionId, toTaskOptionId)) != expectedTravelTimes.end())
+                << "vehicle " << vehicleId << " from " << fromTaskOptionId << " to " << toTaskOptionId;
+        EXPECT_FALSE((vehicleId == 1) && (std::get<1>(assignments[assignment]) == 4));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    // Build, Google Test run-time and environment tear-down
+    ::testing::InitGoogleTest(&argc, argv);
+    // Run the tests and return the results
+    return RUN_ALL_TESTS();
+}
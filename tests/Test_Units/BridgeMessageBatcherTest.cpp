@@ -0,0 +1,194 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   BridgeMessageBatcherTest.cpp
+ *
+ * Functional checks of bridge message batching (round trip with and without
+ * compression, latest-value coalescing per entity, rejection of corrupt
+ * batches) and the bytes saved for a window of vehicle state traffic.
+ */
+#include "gtest/gtest.h"
+
+#include "BridgeMessageBatcher.h"
+#include "LmcpObjectSerializer.h"
+
+#include "afrl/cmasi/AirVehicleState.h"
+#include "afrl/cmasi/Location3D.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using uxas::communications::BridgeMessageBatcher;
+using uxas::communications::data::AddressedAttributedMessage;
+
+std::unique_ptr<AddressedAttributedMessage>
+createAirVehicleStateMessage(int64_t vehicleId, int64_t time_ms)
+{
+    afrl::cmasi::AirVehicleState airVehicleState;
+    airVehicleState.setID(vehicleId);
+    airVehicleState.setTime(time_ms);
+    airVehicleState.setHeading(87.5f);
+    airVehicleState.setAirspeed(22.0f);
+    auto location = new afrl::cmasi::Location3D;
+    location->setLatitude(45.3 + vehicleId * 0.001);
+    location->setLongitude(-121.1);
+    location->setAltitude(700.0f);
+    airVehicleState.setLocation(location);
+
+    std::unique_ptr<AddressedAttributedMessage> message(new AddressedAttributedMessage);
+    message->setAddressAttributesAndPayload(afrl::cmasi::AirVehicleState::Subscription, "lmcp", afrl::cmasi::AirVehicleState::Subscription,
+                                            "", "100", "12", *uxas::communications::LmcpObjectSerializer::serialize(&airVehicleState));
+    return (message);
+}
+
+std::unique_ptr<AddressedAttributedMessage>
+createTextMessage(const std::string& text)
+{
+    std::unique_ptr<AddressedAttributedMessage> message(new AddressedAttributedMessage);
+    message->setAddressAttributesAndPayload("uxas.test.Text", "text", "uxas.test.Text", "", "100", "12", text);
+    return (message);
+}
+
+std::vector<std::string>
+unpack(AddressedAttributedMessage& batchMessage)
+{
+    std::vector<std::unique_ptr<AddressedAttributedMessage>> messages;
+    EXPECT_TRUE(BridgeMessageBatcher::unpackBatchMessage(batchMessage, messages));
+    std::vector<std::string> messageStrings;
+    for (auto& message : messages)
+    {
+        messageStrings.push_back(message->getString());
+    }
+    return (messageStrings);
+}
+
+} //namespace
+
+TEST(BridgeMessageBatcherTest, round_trip)
+{
+    for (int32_t compressionLevel : {0, 6})
+    {
+        BridgeMessageBatcher::Configuration configuration;
+        configuration.m_compressionLevel = compressionLevel;
+        BridgeMessageBatcher batcher(configuration);
+        EXPECT_FALSE(batcher.createBatchMessage("100", "12"));
+
+        std::vector<std::string> expected;
+        for (int64_t messageIndex = 0; messageIndex < 20; messageIndex++)
+        {
+            auto message = messageIndex % 2 ? createTextMessage(std::string(50, 'a' + messageIndex)) : createAirVehicleStateMessage(400, messageIndex);
+            expected.push_back(message->getString());
+            batcher.addMessage(*message);
+        }
+        auto batchMessage = batcher.createBatchMessage("100", "12");
+        ASSERT_TRUE(batchMessage);
+        EXPECT_TRUE(BridgeMessageBatcher::isBatchMessage(*batchMessage));
+        EXPECT_TRUE(batcher.isEmpty());
+
+        // the batch survives a trip through its delimited string
+        AddressedAttributedMessage receivedBatchMessage;
+        ASSERT_TRUE(receivedBatchMessage.setAddressAttributesAndPayloadFromDelimitedString(batchMessage->getString()));
+        EXPECT_EQ(expected, unpack(receivedBatchMessage));
+        EXPECT_EQ(compressionLevel > 0, (receivedBatchMessage.getPayload()[1] & BridgeMessageBatcher::s_compressedFlag) != 0);
+    }
+}
+
+TEST(BridgeMessageBatcherTest, latest_value_coalescing)
+{
+    BridgeMessageBatcher::Configuration configuration;
+    configuration.m_latestValueDescriptors.insert(afrl::cmasi::AirVehicleState::Subscription);
+    BridgeMessageBatcher batcher(configuration);
+
+    auto firstVehicle = createAirVehicleStateMessage(400, 1000);
+    auto text = createTextMessage("between");
+    auto secondVehicle = createAirVehicleStateMessage(500, 1000);
+    auto firstVehicleUpdate = createAirVehicleStateMessage(400, 1100);
+    batcher.addMessage(*firstVehicle);
+    batcher.addMessage(*text);
+    batcher.addMessage(*secondVehicle);
+    batcher.addMessage(*firstVehicleUpdate);
+    batcher.addMessage(*text);
+
+    // the newest state of each vehicle, at the position of its first state
+    std::vector<std::string> expected = {firstVehicleUpdate->getString(), text->getString(), secondVehicle->getString(), text->getString()};
+    auto batchMessage = batcher.createBatchMessage("100", "12");
+    ASSERT_TRUE(batchMessage);
+    EXPECT_EQ(expected, unpack(*batchMessage));
+    EXPECT_EQ(5u, batcher.getStatistics().m_messageCount);
+    EXPECT_EQ(1u, batcher.getStatistics().m_coalescedMessageCount);
+
+    // coalescing does not span windows
+    batcher.addMessage(*firstVehicle);
+    batchMessage = batcher.createBatchMessage("100", "12");
+    ASSERT_TRUE(batchMessage);
+    EXPECT_EQ(std::vector<std::string>{firstVehicle->getString()}, unpack(*batchMessage));
+}
+
+TEST(BridgeMessageBatcherTest, corrupt_batch_is_rejected)
+{
+    BridgeMessageBatcher::Configuration configuration;
+    BridgeMessageBatcher batcher(configuration);
+    batcher.addMessage(*createTextMessage("first"));
+    batcher.addMessage(*createTextMessage("second"));
+    auto batchMessage = batcher.createBatchMessage("100", "12");
+    ASSERT_TRUE(batchMessage);
+
+    // a truncated batch is rejected as a whole
+    std::string truncated = batchMessage->getString().substr(0, batchMessage->getString().size() - 3);
+    AddressedAttributedMessage truncatedBatchMessage;
+    ASSERT_TRUE(truncatedBatchMessage.setAddressAttributesAndPayloadFromDelimitedString(truncated));
+    std::vector<std::unique_ptr<AddressedAttributedMessage>> messages;
+    EXPECT_FALSE(BridgeMessageBatcher::unpackBatchMessage(truncatedBatchMessage, messages));
+    EXPECT_TRUE(messages.empty());
+
+    auto textMessage = createTextMessage("not a batch");
+    EXPECT_FALSE(BridgeMessageBatcher::unpackBatchMessage(*textMessage, messages));
+    EXPECT_TRUE(messages.empty());
+}
+
+TEST(BridgeMessageBatcherTest, bytes_saved)
+{
+    // one window of 10 Hz states from 8 vehicles with a 500 ms batch window
+    BridgeMessageBatcher::Configuration configuration;
+    configuration.m_latestValueDescriptors.insert(afrl::cmasi::AirVehicleState::Subscription);
+    BridgeMessageBatcher coalescingBatcher(configuration);
+    configuration.m_latestValueDescriptors.clear();
+    BridgeMessageBatcher compressingBatcher(configuration);
+    for (int64_t time_ms = 0; time_ms < 500; time_ms += 100)
+    {
+        for (int64_t vehicleId = 1; vehicleId <= 8; vehicleId++)
+        {
+            auto message = createAirVehicleStateMessage(vehicleId, time_ms);
+            coalescingBatcher.addMessage(*message);
+            compressingBatcher.addMessage(*message);
+        }
+    }
+    ASSERT_TRUE(coalescingBatcher.createBatchMessage("100", "12"));
+    ASSERT_TRUE(compressingBatcher.createBatchMessage("100", "12"));
+
+    auto compressing = compressingBatcher.getStatistics();
+    auto coalescing = coalescingBatcher.getStatistics();
+    EXPECT_EQ(40u, compressing.m_messageCount);
+    EXPECT_EQ(32u, coalescing.m_coalescedMessageCount);
+    EXPECT_LT(compressing.m_sentByteCount, compressing.m_messageByteCount);
+    EXPECT_LT(coalescing.m_sentByteCount, compressing.m_sentByteCount);
+}
+
+int main(int argc, char **argv)
+{
+    // Build, Google Test run-time and environment tear-down
+    ::testing::InitGoogleTest(&argc, argv);
+    // Run the tests and return the results
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,145 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   DatabaseLoggerHelperTest.cpp
+ *
+ * Functional checks of the batched database writer (rows are committed when
+ * the batch count is reached, when the batch period expires and when the
+ * stream is closed).
+ */
+#include "gtest/gtest.h"
+
+#include "UxAS_DatabaseLoggerHelper.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+namespace
+{
+
+using uxas::common::log::DatabaseColumnValue;
+using uxas::common::log::DatabaseLoggerHelper;
+
+const std::string c_tableName("msg");
+const std::string c_columnNames("id,text");
+const std::string c_createTable("CREATE TABLE msg (id INTEGER, text TEXT)");
+
+/** \brief Time allowed for the background writer to commit rows it should commit. */
+const std::chrono::milliseconds c_flushTimeout(5000);
+
+void
+configureAndOpen(DatabaseLoggerHelper& helper, const std::string& location, uint32_t batchCount, uint32_t batchPeriod_ms, std::string& dbFilePath)
+{
+    ASSERT_TRUE(helper.configureDatabaseHelper(location, false, 100000, c_createTable, c_tableName, c_columnNames));
+    ASSERT_TRUE(helper.configureBatchedWriter(batchCount, batchPeriod_ms, batchCount * 10));
+    ASSERT_TRUE(helper.openStream(dbFilePath));
+}
+
+void
+insertRows(DatabaseLoggerHelper& helper, int64_t firstId, uint32_t count)
+{
+    for (int64_t id = firstId; id < firstId + count; id++)
+    {
+        EXPECT_TRUE(helper.insertRowIntoTable({DatabaseColumnValue::integer(id), DatabaseColumnValue::text("row " + std::to_string(id))}));
+    }
+}
+
+// committed rows as seen by a separate connection
+int
+getRowCount(const std::string& dbFilePath)
+{
+    SQLite::Database db(dbFilePath, SQLITE_OPEN_READONLY);
+    SQLite::Statement query(db, "SELECT COUNT(*) FROM " + c_tableName);
+    return (query.executeStep() ? query.getColumn(0).getInt() : -1);
+}
+
+// waits until the expected number of rows is committed (or the timeout expires)
+int
+waitForRowCount(const std::string& dbFilePath, int expectedCount)
+{
+    auto deadline = std::chrono::steady_clock::now() + c_flushTimeout;
+    int rowCount = getRowCount(dbFilePath);
+    while (rowCount < expectedCount && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        rowCount = getRowCount(dbFilePath);
+    }
+    return (rowCount);
+}
+
+void
+removeDatabase(const std::string& dbFilePath)
+{
+    std::remove(dbFilePath.c_str());
+    std::remove((dbFilePath + "-wal").c_str());
+    std::remove((dbFilePath + "-shm").c_str());
+}
+
+} //namespace
+
+TEST(DatabaseLoggerHelperTest, flush_on_batch_count)
+{
+    std::string dbFilePath;
+    {
+        // the batch period never expires during the test
+        DatabaseLoggerHelper helper;
+        configureAndOpen(helper, "DatabaseLoggerHelperTest_count", 10, 600000, dbFilePath);
+
+        insertRows(helper, 0, 9);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        EXPECT_EQ(0, getRowCount(dbFilePath));
+
+        insertRows(helper, 9, 1);
+        EXPECT_EQ(10, waitForRowCount(dbFilePath, 10));
+
+        // incomplete batch, written when the helper is destroyed
+        insertRows(helper, 10, 5);
+    }
+    EXPECT_EQ(15, getRowCount(dbFilePath));
+    removeDatabase(dbFilePath);
+}
+
+TEST(DatabaseLoggerHelperTest, flush_on_batch_period)
+{
+    std::string dbFilePath;
+    {
+        // the batch count is never reached during the test
+        DatabaseLoggerHelper helper;
+        configureAndOpen(helper, "DatabaseLoggerHelperTest_period", 1000, 50, dbFilePath);
+
+        insertRows(helper, 0, 3);
+        EXPECT_EQ(3, waitForRowCount(dbFilePath, 3));
+        insertRows(helper, 3, 2);
+        EXPECT_EQ(5, waitForRowCount(dbFilePath, 5));
+    }
+    removeDatabase(dbFilePath);
+}
+
+TEST(DatabaseLoggerHelperTest, flush_on_close)
+{
+    std::string dbFilePath;
+    DatabaseLoggerHelper helper;
+    configureAndOpen(helper, "DatabaseLoggerHelperTest_close", 1000, 600000, dbFilePath);
+
+    insertRows(helper, 0, 7);
+    EXPECT_TRUE(helper.closeStream());
+    EXPECT_EQ(7, getRowCount(dbFilePath));
+    removeDatabase(dbFilePath);
+}
+
+int main(int argc, char **argv)
+{
+    // Build, Google Test run-time and environment tear-down
+    ::testing::InitGoogleTest(&argc, argv);
+    // Run the tests and return the results
+    return RUN_ALL_TESTS();
+}
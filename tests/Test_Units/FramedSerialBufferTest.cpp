@@ -0,0 +1,253 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   FramedSerialBufferTest.cpp
+ *
+ * Functional checks of the binary framing codec (round trip across arbitrary
+ * chunk boundaries and ring wrap-around, CRC rejection and resynchronization,
+ * decoding of legacy sentinel frames, version negotiation) and a throughput
+ * benchmark against the sentinel codec for a large burst (disabled; run it
+ * with --gtest_also_run_disabled_tests).
+ */
+#include "gtest/gtest.h"
+
+#include "UxAS_FramedSerialBuffer.h"
+#include "UxAS_SentinelSerialBuffer.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+using uxas::common::FramedSerialBuffer;
+using uxas::common::SentinelSerialBuffer;
+
+std::vector<std::string>
+createPayloads(size_t count, size_t size)
+{
+    std::vector<std::string> payloads;
+    for (size_t payloadIndex = 0; payloadIndex < count; payloadIndex++)
+    {
+        std::string payload(size + payloadIndex % 97, '\0');
+        for (size_t index = 0; index < payload.size(); index++)
+        {
+            payload[index] = static_cast<char>((payloadIndex * 131 + index * 7) & 0xFF);
+        }
+        payloads.push_back(std::move(payload));
+    }
+    return (payloads);
+}
+
+std::vector<std::string>
+decodeInChunks(FramedSerialBuffer& buffer, const std::string& stream, size_t chunkSize)
+{
+    std::vector<std::string> payloads;
+    std::string payload;
+    for (size_t offset = 0; offset < stream.size(); offset += chunkSize)
+    {
+        buffer.appendData(stream.data() + offset, std::min(chunkSize, stream.size() - offset));
+        while (buffer.getNextPayload(payload))
+        {
+            payloads.push_back(payload);
+        }
+    }
+    return (payloads);
+}
+
+double
+getMegabytesPerSecond(size_t byteCount, Clock::duration duration)
+{
+    double duration_s = std::chrono::duration_cast<std::chrono::duration<double> >(duration).count();
+    return (duration_s > 0.0 ? byteCount / duration_s / 1.0e6 : 0.0);
+}
+
+} //namespace
+
+TEST(FramedSerialBufferTest, crc32_check_value)
+{
+    // standard CRC-32 check value; continuation over split data
+    std::string data("123456789");
+    EXPECT_EQ(0xCBF43926u, FramedSerialBuffer::calculateCrc32(data.data(), data.size()));
+    uint32_t crc = FramedSerialBuffer::calculateCrc32(data.data(), 4);
+    EXPECT_EQ(0xCBF43926u, FramedSerialBuffer::calculateCrc32(data.data() + 4, data.size() - 4, crc));
+}
+
+TEST(FramedSerialBufferTest, binary_round_trip_in_chunks)
+{
+    auto payloads = createPayloads(500, 300);
+    std::string stream;
+    for (const auto& payload : payloads)
+    {
+        FramedSerialBuffer::appendFramedString(payload, FramedSerialBuffer::s_binaryFramingVersion, stream);
+    }
+    // odd chunk sizes split headers and payloads and wrap the ring
+    for (size_t chunkSize : {1u, 7u, 1500u, 65536u})
+    {
+        FramedSerialBuffer buffer;
+        EXPECT_EQ(payloads, decodeInChunks(buffer, stream, chunkSize));
+        EXPECT_EQ(0u, buffer.getBufferedSize());
+        EXPECT_EQ(FramedSerialBuffer::s_binaryFramingVersion, buffer.getPeerFramingVersion());
+        EXPECT_EQ(0u, buffer.m_invalidDeserializeCount);
+    }
+}
+
+TEST(FramedSerialBufferTest, corrupt_frame_is_skipped)
+{
+    auto payloads = createPayloads(3, 100);
+    std::string stream;
+    FramedSerialBuffer::appendFramedString(payloads[0], FramedSerialBuffer::s_binaryFramingVersion, stream);
+    size_t corruptOffset = stream.size() + FramedSerialBuffer::s_headerSize + 10;
+    FramedSerialBuffer::appendFramedString(payloads[1], FramedSerialBuffer::s_binaryFramingVersion, stream);
+    stream.append("line noise");
+    FramedSerialBuffer::appendFramedString(payloads[2], FramedSerialBuffer::s_binaryFramingVersion, stream);
+    stream[corruptOffset] ^= 0x01;
+
+    FramedSerialBuffer buffer;
+    std::vector<std::string> expected = {payloads[0], payloads[2]};
+    EXPECT_EQ(expected, decodeInChunks(buffer, stream, 64));
+    EXPECT_GE(buffer.m_invalidDeserializeCount, 1u);
+}
+
+TEST(FramedSerialBufferTest, sentinel_frames_are_decoded)
+{
+    auto payloads = createPayloads(50, 200);
+    std::string stream;
+    for (size_t payloadIndex = 0; payloadIndex < payloads.size(); payloadIndex++)
+    {
+        // legacy encoder, new encoder in sentinel mode, and binary frames interleaved
+        if (payloadIndex % 3 == 0)
+        {
+            stream.append(SentinelSerialBuffer::createSentinelizedString(payloads[payloadIndex]));
+        }
+        else
+        {
+            FramedSerialBuffer::appendFramedString(payloads[payloadIndex], static_cast<uint8_t>(payloadIndex % 3), stream);
+        }
+    }
+    EXPECT_EQ(SentinelSerialBuffer::createSentinelizedString(payloads[0]),
+              FramedSerialBuffer::createFramedString(payloads[0], FramedSerialBuffer::s_sentinelFramingVersion));
+
+    FramedSerialBuffer buffer;
+    EXPECT_EQ(payloads, decodeInChunks(buffer, stream, 33));
+    EXPECT_EQ(0u, buffer.m_invalidDeserializeCount);
+}
+
+TEST(FramedSerialBufferTest, version_negotiation)
+{
+    FramedSerialBuffer buffer;
+    EXPECT_EQ(FramedSerialBuffer::s_sentinelFramingVersion, buffer.getSendFramingVersion());
+
+    // sentinel data from a legacy peer keeps sentinel framing
+    std::string payload;
+    std::string legacyFrame = SentinelSerialBuffer::createSentinelizedString("legacy");
+    buffer.appendData(legacyFrame.data(), legacyFrame.size());
+    ASSERT_TRUE(buffer.getNextPayload(payload));
+    EXPECT_EQ("legacy", payload);
+    EXPECT_EQ(FramedSerialBuffer::s_sentinelFramingVersion, buffer.getSendFramingVersion());
+
+    // an announcement switches to binary framing and produces no payload
+    std::string announce = FramedSerialBuffer::createAnnounceFrame();
+    buffer.appendData(announce.data(), announce.size());
+    EXPECT_FALSE(buffer.getNextPayload(payload));
+    EXPECT_EQ(FramedSerialBuffer::s_binaryFramingVersion, buffer.getSendFramingVersion());
+
+    // the peer may send sentinel frames until it receives this side's announcement
+    legacyFrame = SentinelSerialBuffer::createSentinelizedString("late");
+    buffer.appendData(legacyFrame.data(), legacyFrame.size());
+    ASSERT_TRUE(buffer.getNextPayload(payload));
+    EXPECT_EQ(FramedSerialBuffer::s_binaryFramingVersion, buffer.getSendFramingVersion());
+    EXPECT_EQ(FramedSerialBuffer::s_sentinelFramingVersion, buffer.getLastFramingVersion());
+
+    buffer.setLocalFramingVersion(FramedSerialBuffer::s_sentinelFramingVersion);
+    EXPECT_EQ(FramedSerialBuffer::s_sentinelFramingVersion, buffer.getSendFramingVersion());
+
+    // legacy receivers disregard the announcement
+    SentinelSerialBuffer legacyBuffer;
+    legacyBuffer.getNextPayloadString(announce);
+    EXPECT_EQ("legacy", legacyBuffer.getNextPayloadString(SentinelSerialBuffer::createSentinelizedString("legacy")));
+}
+
+TEST(FramedSerialBufferTest, DISABLED_throughput_benchmark)
+{
+    // one burst of messages delivered in TCP-sized chunks
+    auto payloads = createPayloads(4000, 1000);
+    size_t payloadByteCount{0};
+    std::string sentinelStream;
+    std::string binaryStream;
+    for (const auto& payload : payloads)
+    {
+        payloadByteCount += payload.size();
+        FramedSerialBuffer::appendFramedString(payload, FramedSerialBuffer::s_sentinelFramingVersion, sentinelStream);
+        FramedSerialBuffer::appendFramedString(payload, FramedSerialBuffer::s_binaryFramingVersion, binaryStream);
+    }
+
+    auto startTime = Clock::now();
+    std::vector<std::string> encoded;
+    for (const auto& payload : payloads)
+    {
+        encoded.push_back(SentinelSerialBuffer::createSentinelizedString(payload));
+    }
+    auto sentinelEncodeDuration = Clock::now() - startTime;
+    startTime = Clock::now();
+    encoded.clear();
+    for (const auto& payload : payloads)
+    {
+        encoded.push_back(FramedSerialBuffer::createFramedString(payload, FramedSerialBuffer::s_binaryFramingVersion));
+    }
+    auto binaryEncodeDuration = Clock::now() - startTime;
+
+    // sentinel decoder (the whole burst is buffered before it is drained)
+    startTime = Clock::now();
+    SentinelSerialBuffer sentinelBuffer;
+    std::vector<std::string> sentinelPayloads;
+    const size_t chunkSize{1500};
+    for (size_t offset = 0; offset < sentinelStream.size(); offset += chunkSize)
+    {
+        sentinelBuffer.m_data.append(sentinelStream, offset, chunkSize);
+    }
+    std::string segment = sentinelBuffer.getNextPayloadString("");
+    while (!segment.empty())
+    {
+        sentinelPayloads.push_back(std::move(segment));
+        segment = sentinelBuffer.getNextPayloadString("");
+    }
+    auto sentinelDecodeDuration = Clock::now() - startTime;
+
+    startTime = Clock::now();
+    FramedSerialBuffer framedBuffer;
+    framedBuffer.appendData(binaryStream.data(), binaryStream.size());
+    std::vector<std::string> binaryPayloads;
+    std::string payload;
+    while (framedBuffer.getNextPayload(payload))
+    {
+        binaryPayloads.push_back(payload);
+    }
+    auto binaryDecodeDuration = Clock::now() - startTime;
+
+    EXPECT_EQ(payloads, sentinelPayloads);
+    EXPECT_EQ(payloads, binaryPayloads);
+    std::cout << "burst of " << payloads.size() << " messages (" << payloadByteCount << " bytes):" << std::endl
+            << "  sentinel encode " << getMegabytesPerSecond(payloadByteCount, sentinelEncodeDuration) << " MB/s, decode "
+            << getMegabytesPerSecond(payloadByteCount, sentinelDecodeDuration) << " MB/s" << std::endl
+            << "  binary   encode " << getMegabytesPerSecond(payloadByteCount, binaryEncodeDuration) << " MB/s, decode "
+            << getMegabytesPerSecond(payloadByteCount, binaryDecodeDuration) << " MB/s" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    // Build, Google Test run-time and environment tear-down
+    ::testing::InitGoogleTest(&argc, argv);
+    // Run the tests and return the results
+    return RUN_ALL_TESTS();
+}
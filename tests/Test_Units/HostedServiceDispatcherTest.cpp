@@ -0,0 +1,251 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   HostedServiceDispatcherTest.cpp
+ *
+ * Functional checks of the dispatch of the TaskExecutionPool: each hosted
+ * service must process its messages in order and never concurrently,
+ * messages must reach the services subscribed to a prefix of their address
+ * once, never the sender, each with its own object, and KillService messages
+ * and terminating handlers must terminate the hosted service.
+ */
+#include "gtest/gtest.h"
+
+#include "HostedServiceDispatcher.h"
+#include "UxAS_ThreadPool.h"
+
+#include "afrl/cmasi/KeyValuePair.h"
+#include "uxas/messages/uxnative/KillService.h"
+
+#include "stdUniquePtr.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+const std::string c_address("afrl.cmasi.KeyValuePair");
+const std::string c_entityId("1");
+
+/** \brief Hosted service recording the keys and objects of the received
+ * KeyValuePair messages. */
+class HostedTestService : public uxas::service::ServiceBase
+{
+public:
+
+    HostedTestService()
+    : ServiceBase("HostedTestService", "")
+    {
+        m_entityIdString = c_entityId; // set on configuration
+    };
+
+    std::vector<std::string>
+    getKeys()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return (m_keys);
+    };
+
+    std::vector<const avtas::lmcp::Object*>
+    getObjects()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return (m_objects);
+    };
+
+    std::atomic<uint32_t> m_maxConcurrency{0};
+    std::atomic<bool> m_isTerminated{false};
+
+protected:
+
+    bool
+    processReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage) override
+    {
+        uint32_t concurrency = ++m_concurrency;
+        m_maxConcurrency = std::max(m_maxConcurrency.load(), concurrency);
+        std::this_thread::yield();
+
+        std::string key = std::static_pointer_cast<afrl::cmasi::KeyValuePair>(receivedLmcpMessage->m_object)->getKey();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_keys.push_back(key);
+            m_objects.push_back(receivedLmcpMessage->m_object.get());
+        }
+        m_concurrency--;
+        return (key == "terminate");
+    };
+
+    bool
+    terminate() override
+    {
+        m_isTerminated = true;
+        return (true);
+    };
+
+private:
+
+    std::atomic<uint32_t> m_concurrency{0};
+    std::mutex m_mutex;
+    std::vector<std::string> m_keys;
+    std::vector<const avtas::lmcp::Object*> m_objects;
+};
+
+std::unique_ptr<uxas::communications::data::LmcpMessage>
+createMessage(const std::string& address, const std::shared_ptr<avtas::lmcp::Object>& object, const std::string& sourceServiceId = "-1")
+{
+    auto attributes = uxas::stduxas::make_unique<uxas::communications::data::MessageAttributes>();
+    attributes->setAttributes("lmcp", object->getFullLmcpTypeName(), "", c_entityId, sourceServiceId);
+    auto message = uxas::stduxas::make_unique<uxas::communications::data::LmcpMessage>(std::move(attributes), object);
+    message->m_address = address;
+    return (message);
+};
+
+std::unique_ptr<uxas::communications::data::LmcpMessage>
+createKeyValuePairMessage(const std::string& address, const std::string& key, const std::string& sourceServiceId = "-1")
+{
+    auto keyValuePair = std::make_shared<afrl::cmasi::KeyValuePair>();
+    keyValuePair->setKey(key);
+    return (createMessage(address, keyValuePair, sourceServiceId));
+};
+
+/** \brief Adds a new HostedTestService to the dispatcher and returns it. */
+HostedTestService*
+addService(uxas::service::task::HostedServiceDispatcher& dispatcher)
+{
+    auto service = uxas::stduxas::make_unique<HostedTestService>();
+    HostedTestService* hostedTestService = service.get();
+    EXPECT_TRUE(dispatcher.addService(std::move(service)));
+    return (hostedTestService);
+};
+
+} //namespace
+
+TEST(HostedServiceDispatcherTest, strand_ordering)
+{
+    uxas::common::ThreadPool threadPool(4);
+    uxas::service::task::HostedServiceDispatcher dispatcher(threadPool, 4);
+    std::vector<HostedTestService*> services;
+    std::vector<std::string> expectedKeys;
+    for (size_t index = 0; index < 4; index++)
+    {
+        services.push_back(addService(dispatcher));
+        dispatcher.addAddress(services.back()->m_networkId, c_address);
+    }
+
+    for (size_t index = 0; index < 500; index++)
+    {
+        expectedKeys.push_back(std::to_string(index));
+        dispatcher.dispatch(createKeyValuePairMessage(c_address, expectedKeys.back()));
+    }
+
+    // executes the queued jobs
+    threadPool.shutdown();
+    for (auto service : services)
+    {
+        EXPECT_EQ(expectedKeys, service->getKeys());
+        EXPECT_EQ(1u, service->m_maxConcurrency.load());
+    }
+}
+
+TEST(HostedServiceDispatcherTest, subscriptions)
+{
+    // shut down: jobs execute on the dispatching thread
+    uxas::common::ThreadPool threadPool(1);
+    threadPool.shutdown();
+    uxas::service::task::HostedServiceDispatcher dispatcher(threadPool);
+    HostedTestService* prefixService = addService(dispatcher);
+    HostedTestService* exactService = addService(dispatcher);
+
+    // the first subscriber of an address reports it, repeated subscriptions are ignored
+    EXPECT_TRUE(dispatcher.addAddress(prefixService->m_networkId, "afrl.cmasi"));
+    EXPECT_TRUE(dispatcher.addAddress(prefixService->m_networkId, c_address));
+    EXPECT_FALSE(dispatcher.addAddress(prefixService->m_networkId, c_address));
+    EXPECT_FALSE(dispatcher.addAddress(exactService->m_networkId, c_address));
+    EXPECT_FALSE(dispatcher.addAddress(-1, "afrl"));
+
+    // prefix and exact subscription deliver once, each receiver its own object
+    auto keyValuePair = std::make_shared<afrl::cmasi::KeyValuePair>();
+    keyValuePair->setKey("both");
+    dispatcher.dispatch(createMessage(c_address, keyValuePair));
+    EXPECT_EQ(std::vector<std::string>({"both"}), prefixService->getKeys());
+    EXPECT_EQ(std::vector<std::string>({"both"}), exactService->getKeys());
+    EXPECT_NE(prefixService->getObjects().front(), exactService->getObjects().front());
+    EXPECT_TRUE(prefixService->getObjects().front() == keyValuePair.get() || exactService->getObjects().front() == keyValuePair.get());
+
+    // not delivered to the sender, nor to services subscribed to a longer address
+    dispatcher.dispatch(createKeyValuePairMessage(c_address, "fromExact", exactService->m_networkIdString));
+    dispatcher.dispatch(createKeyValuePairMessage("afrl.cmasi.Key", "prefix"));
+    dispatcher.dispatch(createKeyValuePairMessage("afrl.vehicles", "none"));
+    EXPECT_EQ(std::vector<std::string>({"both", "fromExact", "prefix"}), prefixService->getKeys());
+    EXPECT_EQ(std::vector<std::string>({"both"}), exactService->getKeys());
+
+    // the last subscriber of an address reports it
+    EXPECT_FALSE(dispatcher.removeAddress(prefixService->m_networkId, c_address));
+    EXPECT_FALSE(dispatcher.removeAddress(prefixService->m_networkId, c_address));
+    EXPECT_TRUE(dispatcher.removeAddress(exactService->m_networkId, c_address));
+    dispatcher.dispatch(createKeyValuePairMessage(c_address, "removed"));
+    EXPECT_EQ(std::vector<std::string>({"both", "fromExact", "prefix", "removed"}), prefixService->getKeys());
+    EXPECT_EQ(std::vector<std::string>({"both"}), exactService->getKeys());
+}
+
+TEST(HostedServiceDispatcherTest, termination)
+{
+    uxas::common::ThreadPool threadPool(1);
+    threadPool.shutdown();
+    uxas::service::task::HostedServiceDispatcher dispatcher(threadPool);
+    HostedTestService* killedService = addService(dispatcher);
+    HostedTestService* handlerService = addService(dispatcher);
+    HostedTestService* remainingService = addService(dispatcher);
+    int64_t killedNetworkId = killedService->m_networkId;
+    dispatcher.addAddress(killedService->m_networkId, "killed");
+    dispatcher.addAddress(handlerService->m_networkId, "handler");
+    dispatcher.addAddress(remainingService->m_networkId, "handler.remaining");
+    EXPECT_EQ(3u, dispatcher.getServiceCount());
+
+    // KillService terminates the addressed hosted service and is not delivered
+    auto killService = std::make_shared<uxas::messages::uxnative::KillService>();
+    killService->setServiceID(killedNetworkId);
+    dispatcher.dispatch(createMessage(uxas::messages::uxnative::KillService::Subscription, killService));
+    dispatcher.dispatch(createKeyValuePairMessage("killed", "afterKill"));
+    EXPECT_TRUE(killedService->m_isTerminated);
+    EXPECT_TRUE(killedService->getKeys().empty());
+
+    // a handler returning true terminates its hosted service only
+    dispatcher.dispatch(createKeyValuePairMessage("handler", "terminate"));
+    dispatcher.dispatch(createKeyValuePairMessage("handler.remaining", "afterTerminate"));
+    EXPECT_TRUE(handlerService->m_isTerminated);
+    EXPECT_EQ(std::vector<std::string>({"terminate"}), handlerService->getKeys());
+    EXPECT_FALSE(remainingService->m_isTerminated);
+    EXPECT_EQ(std::vector<std::string>({"afterTerminate"}), remainingService->getKeys());
+
+    // removal reports the addresses without subscriber
+    auto unsubscribedAddresses = dispatcher.removeTerminatedServices();
+    std::sort(unsubscribedAddresses.begin(), unsubscribedAddresses.end());
+    EXPECT_EQ(std::vector<std::string>({"handler", "killed"}), unsubscribedAddresses);
+    EXPECT_EQ(1u, dispatcher.getServiceCount());
+    EXPECT_EQ(nullptr, dispatcher.getService(killedNetworkId));
+
+    EXPECT_EQ(1u, dispatcher.terminateRemainingServices());
+    EXPECT_TRUE(remainingService->m_isTerminated);
+}
+
+int main(int argc, char **argv)
+{
+    // Build, Google Test run-time and environment tear-down
+    ::testing::InitGoogleTest(&argc, argv);
+    // Run the tests and return the results
+    return RUN_ALL_TESTS();
+}
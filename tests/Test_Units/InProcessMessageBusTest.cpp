@@ -0,0 +1,166 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   InProcessMessageBusTest.cpp
+ *
+ * Functional checks of the in-process message bus: subscriptions must match
+ * message addresses they prefix (as Zero MQ SUB sockets), each subscriber
+ * must receive a message once and never its own messages, each receiver must
+ * get its own object, and full queues must drop messages.
+ */
+#include "gtest/gtest.h"
+
+#include "InProcessMessageBus.h"
+
+#include "Constants/UxAS_String.h"
+
+#include "afrl/cmasi/KeyValuePair.h"
+
+#include <memory>
+#include <string>
+
+namespace
+{
+
+using uxas::communications::transport::InProcessMessage;
+using uxas::communications::transport::InProcessMessageBus;
+using uxas::communications::transport::InProcessMessageQueue;
+
+std::shared_ptr<InProcessMessageQueue>
+createQueue(const std::string& serviceId, size_t highWaterMark = 100)
+{
+    return (std::make_shared<InProcessMessageQueue>("1", serviceId, highWaterMark));
+};
+
+std::shared_ptr<InProcessMessage>
+createMessage(const std::string& address, const std::shared_ptr<avtas::lmcp::Object>& object, const std::string& sourceServiceId = "0")
+{
+    return (std::make_shared<InProcessMessage>(address, uxas::common::ContentType::lmcp(), object->getFullLmcpTypeName(),
+                                               "", "1", sourceServiceId, object, nullptr));
+};
+
+std::shared_ptr<InProcessMessage>
+createMessage(const std::string& address, const std::string& sourceServiceId = "0")
+{
+    return (createMessage(address, std::make_shared<afrl::cmasi::KeyValuePair>(), sourceServiceId));
+};
+
+} //namespace
+
+TEST(InProcessMessageBusTest, prefix_subscriptions)
+{
+    auto& bus = InProcessMessageBus::getInstance();
+    auto prefixQueue = createQueue("10");
+    auto exactQueue = createQueue("11");
+    bus.subscribe("test.prefix", prefixQueue);
+    bus.subscribe("test.prefix.exact", exactQueue);
+
+    EXPECT_EQ(2u, bus.publish(createMessage("test.prefix.exact")));
+    EXPECT_EQ(2u, bus.publish(createMessage("test.prefix.exact.longer")));
+    EXPECT_EQ(1u, bus.publish(createMessage("test.prefix.other")));
+    EXPECT_EQ(0u, bus.publish(createMessage("test.pre")));
+    EXPECT_EQ(3u, prefixQueue->size());
+    EXPECT_EQ(2u, exactQueue->size());
+
+    // unsubscribed queues no longer receive
+    bus.unsubscribe("test.prefix.exact", exactQueue);
+    EXPECT_EQ(1u, bus.publish(createMessage("test.prefix.exact")));
+    bus.unsubscribeAll(prefixQueue);
+    EXPECT_EQ(0u, bus.publish(createMessage("test.prefix.exact")));
+    EXPECT_EQ(4u, prefixQueue->size());
+    EXPECT_EQ(2u, exactQueue->size());
+}
+
+TEST(InProcessMessageBusTest, deliver_once_not_to_sender)
+{
+    auto& bus = InProcessMessageBus::getInstance();
+    auto queue = createQueue("20");
+    auto otherQueue = createQueue("21");
+    bus.subscribe("test.once", queue);
+    bus.subscribe("test.once.exact", queue);
+    bus.subscribe("test.once", otherQueue);
+
+    // matched by two subscriptions, delivered once
+    EXPECT_EQ(2u, bus.publish(createMessage("test.once.exact")));
+    EXPECT_EQ(1u, queue->size());
+
+    // not delivered to the sender (same entity and service ID)
+    EXPECT_EQ(1u, bus.publish(createMessage("test.once.exact", "20")));
+    EXPECT_EQ(1u, queue->size());
+    EXPECT_EQ(2u, otherQueue->size());
+
+    bus.unsubscribeAll(queue);
+    bus.unsubscribeAll(otherQueue);
+}
+
+TEST(InProcessMessageBusTest, object_per_receiver)
+{
+    auto& bus = InProcessMessageBus::getInstance();
+    auto firstQueue = createQueue("30");
+    auto secondQueue = createQueue("31");
+    auto thirdQueue = createQueue("32");
+    bus.subscribe("test.object", firstQueue);
+    bus.subscribe("test.object", secondQueue);
+    bus.subscribe("test.object", thirdQueue);
+
+    auto sentObject = std::make_shared<afrl::cmasi::KeyValuePair>();
+    sentObject->setKey("sent");
+    EXPECT_EQ(3u, bus.publish(createMessage("test.object", sentObject)));
+
+    // copies for all but the last receiver, whichever receives first
+    auto firstObject = firstQueue->pop(0)->takeObject();
+    thirdQueue->pop(0)->release();
+    auto secondObject = secondQueue->pop(0)->takeObject();
+    ASSERT_TRUE(firstObject && secondObject);
+    EXPECT_NE(sentObject.get(), firstObject.get());
+    EXPECT_EQ(sentObject.get(), secondObject.get());
+    EXPECT_EQ("sent", std::static_pointer_cast<afrl::cmasi::KeyValuePair>(firstObject)->getKey());
+
+    bus.unsubscribeAll(firstQueue);
+    bus.unsubscribeAll(secondQueue);
+    bus.unsubscribeAll(thirdQueue);
+}
+
+TEST(InProcessMessageBusTest, high_water_mark)
+{
+    auto& bus = InProcessMessageBus::getInstance();
+    auto queue = createQueue("40", 2);
+    auto otherQueue = createQueue("41");
+    bus.subscribe("test.full", queue);
+    bus.subscribe("test.full", otherQueue);
+
+    auto droppedObject = std::make_shared<afrl::cmasi::KeyValuePair>();
+    EXPECT_EQ(2u, bus.publish(createMessage("test.full")));
+    EXPECT_EQ(2u, bus.publish(createMessage("test.full")));
+    EXPECT_EQ(1u, bus.publish(createMessage("test.full", droppedObject)));
+    EXPECT_EQ(2u, queue->size());
+    EXPECT_EQ(1u, queue->getDroppedMessageCount());
+
+    // the dropped message is released, so the other receiver gets the sent object
+    otherQueue->pop(0);
+    otherQueue->pop(0);
+    EXPECT_EQ(droppedObject.get(), otherQueue->pop(0)->takeObject().get());
+
+    // space is freed by receiving
+    queue->pop(0);
+    EXPECT_EQ(2u, bus.publish(createMessage("test.full")));
+    EXPECT_EQ(1u, queue->getDroppedMessageCount());
+
+    bus.unsubscribeAll(queue);
+    bus.unsubscribeAll(otherQueue);
+}
+
+int main(int argc, char **argv)
+{
+    // Build, Google Test run-time and environment tear-down
+    ::testing::InitGoogleTest(&argc, argv);
+    // Run the tests and return the results
+    return RUN_ALL_TESTS();
+}
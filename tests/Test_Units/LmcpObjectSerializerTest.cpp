@@ -0,0 +1,176 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   LmcpObjectSerializerTest.cpp
+ *
+ * Round-trip checks and a micro-benchmark (disabled by default) comparing the
+ * bulk-copy LMCP deserialization path with the former per-byte ByteBuffer
+ * fill, for representative AirVehicleState and AssignmentCostMatrix message
+ * sizes.
+ */
+#include "gtest/gtest.h"
+
+#include "LmcpObjectSerializer.h"
+
+#include "avtas/lmcp/ByteBuffer.h"
+#include "avtas/lmcp/Factory.h"
+#include "afrl/cmasi/AirVehicleState.h"
+#include "afrl/cmasi/Location3D.h"
+#include "uxas/messages/task/AssignmentCostMatrix.h"
+#include "uxas/messages/task/TaskOptionCost.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace
+{
+
+std::string
+serialize(avtas::lmcp::Object* lmcpObject)
+{
+    avtas::lmcp::ByteBuffer* lmcpByteBuffer = avtas::lmcp::Factory::packMessage(lmcpObject, true);
+    std::string serializedPayload(reinterpret_cast<char*>(lmcpByteBuffer->array()), lmcpByteBuffer->capacity());
+    delete lmcpByteBuffer;
+    return (serializedPayload);
+}
+
+// the per-byte fill used by the network client before LmcpObjectSerializer existed
+avtas::lmcp::Object*
+deserializePerByte(const std::string& payload)
+{
+    avtas::lmcp::ByteBuffer lmcpByteBuffer;
+    lmcpByteBuffer.allocate(payload.size());
+    lmcpByteBuffer.rewind();
+    for (size_t charIndex = 0; charIndex < payload.size(); charIndex++)
+    {
+        lmcpByteBuffer.putByte(payload[charIndex]);
+    }
+    lmcpByteBuffer.rewind();
+    return (avtas::lmcp::Factory::getObject(lmcpByteBuffer));
+}
+
+std::string
+createAirVehicleStatePayload()
+{
+    afrl::cmasi::AirVehicleState airVehicleState;
+    airVehicleState.setID(400);
+    airVehicleState.setTime(123456789);
+    airVehicleState.setHeading(87.5f);
+    airVehicleState.setAirspeed(22.0f);
+    airVehicleState.setEnergyAvailable(95.0f);
+    auto location = new afrl::cmasi::Location3D;
+    location->setLatitude(45.3);
+    location->setLongitude(-121.1);
+    location->setAltitude(700.0f);
+    airVehicleState.setLocation(location);
+    return (serialize(&airVehicleState));
+}
+
+// vehicleCount x (taskCount + 1) x taskCount options, i.e. the cost matrix of a
+// full automation request
+std::string
+createAssignmentCostMatrixPayload(int64_t vehicleCount, int64_t taskCount)
+{
+    uxas::messages::task::AssignmentCostMatrix matrix;
+    matrix.setCorrespondingAutomationRequestID(1);
+    for (int64_t taskId = 1; taskId <= taskCount; taskId++)
+    {
+        matrix.getTaskList().push_back(taskId);
+    }
+    for (int64_t vehicleId = 1; vehicleId <= vehicleCount; vehicleId++)
+    {
+        for (int64_t fromTaskId = 0; fromTaskId <= taskCount; fromTaskId++)
+        {
+            for (int64_t toTaskId = 1; toTaskId <= taskCount; toTaskId++)
+            {
+                auto toc = new uxas::messages::task::TaskOptionCost;
+                toc->setVehicleID(vehicleId);
+                toc->setIntialTaskID(fromTaskId);
+                toc->setIntialTaskOption(0);
+                toc->setDestinationTaskID(toTaskId);
+                toc->setDestinationTaskOption(0);
+                toc->setTimeToGo(1000 * (fromTaskId + toTaskId));
+                matrix.getCostMatrix().push_back(toc);
+            }
+        }
+    }
+    return (serialize(&matrix));
+}
+
+void
+benchmark(const std::string& name, const std::string& payload, uint32_t iterations)
+{
+    auto perByteStart = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        std::unique_ptr<avtas::lmcp::Object> lmcpObject(deserializePerByte(payload));
+        ASSERT_TRUE(lmcpObject != nullptr);
+    }
+    auto perByteDuration_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - perByteStart).count();
+
+    auto bulkStart = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        std::unique_ptr<avtas::lmcp::Object> lmcpObject = uxas::communications::LmcpObjectSerializer::deserialize(payload);
+        ASSERT_TRUE(lmcpObject != nullptr);
+    }
+    auto bulkDuration_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - bulkStart).count();
+
+    std::cout << name << " [" << payload.size() << " bytes, " << iterations << " iterations] per-byte "
+            << perByteDuration_us << " us, bulk " << bulkDuration_us << " us" << std::endl;
+}
+
+} //namespace
+
+TEST(LmcpObjectSerializerTest, AirVehicleState_round_trip)
+{
+    std::string payload = createAirVehicleStatePayload();
+    std::unique_ptr<avtas::lmcp::Object> expected(deserializePerByte(payload));
+    std::unique_ptr<avtas::lmcp::Object> actual = uxas::communications::LmcpObjectSerializer::deserialize(payload);
+    ASSERT_TRUE(expected != nullptr);
+    ASSERT_TRUE(actual != nullptr);
+    EXPECT_EQ(expected->toXML(), actual->toXML());
+}
+
+TEST(LmcpObjectSerializerTest, AssignmentCostMatrix_round_trip)
+{
+    std::string payload = createAssignmentCostMatrixPayload(4, 5);
+    std::unique_ptr<avtas::lmcp::Object> expected(deserializePerByte(payload));
+    std::unique_ptr<avtas::lmcp::Object> actual = uxas::communications::LmcpObjectSerializer::deserialize(payload);
+    ASSERT_TRUE(expected != nullptr);
+    ASSERT_TRUE(actual != nullptr);
+    EXPECT_EQ(expected->toXML(), actual->toXML());
+}
+
+TEST(LmcpObjectSerializerTest, invalid_payload)
+{
+    std::string payload = createAirVehicleStatePayload();
+    payload[payload.size() / 2] ^= 0xFF;
+    EXPECT_TRUE(uxas::communications::LmcpObjectSerializer::deserialize(payload) == nullptr);
+    EXPECT_TRUE(uxas::communications::LmcpObjectSerializer::deserialize(std::string()) == nullptr);
+}
+
+// not part of the unit-test run: --gtest_also_run_disabled_tests --gtest_filter=*benchmark
+TEST(LmcpObjectSerializerTest, DISABLED_benchmark)
+{
+    benchmark("AirVehicleState", createAirVehicleStatePayload(), 100000);
+    benchmark("AssignmentCostMatrix 8x10", createAssignmentCostMatrixPayload(8, 10), 1000);
+    benchmark("AssignmentCostMatrix 40x16", createAssignmentCostMatrixPayload(40, 16), 100);
+}
+
+int main(int argc, char **argv)
+{
+    // Build, Google Test run-time and environment tear-down
+    ::testing::InitGoogleTest(&argc, argv);
+    // Run the tests and return the results
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,301 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   LogManagerTest.cpp
+ *
+ * Functional checks of asynchronous logging: the log record rings, the order
+ * of each thread's records, full rings (dropped records, errors written after
+ * the thread's earlier records) and switching between the asynchronous and
+ * synchronous modes while threads are logging.
+ */
+#include "gtest/gtest.h"
+
+#include "UxAS_LogManager.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+using uxas::common::log::LogManager;
+using uxas::common::log::LogRecordImpl;
+using uxas::common::log::LogRecordRing;
+using uxas::common::log::LogSeverityLevel;
+
+const uint32_t c_ringCapacity{4096};
+const size_t c_threadCount{4};
+const size_t c_threadRecordCount{500};
+const size_t c_modeSwitchCount{20};
+const std::chrono::seconds c_waitTimeout{10};
+
+/** \brief Logger keeping the messages written by the LogManager; can block
+ * the writing thread to let the rings fill up. */
+class TestLogger : public uxas::common::log::LoggerBase
+{
+public:
+
+    static const std::string&
+    s_typeName() { static std::string s_string("LogManagerTestLogger"); return (s_string); };
+
+    static
+    LoggerBase*
+    create()
+    {
+        return new TestLogger;
+    };
+
+    TestLogger() : LoggerBase(s_typeName()) { };
+
+    bool
+    outputToStream(uxas::common::log::HeadLogData& headerAndData) override
+    {
+        std::unique_lock<std::mutex> lock(s_mutex);
+        s_condition.wait(lock, []() { return (!s_isBlocked); });
+        s_messages.push_back(headerAndData.m_message.str());
+        return (true);
+    };
+
+    static void
+    setIsBlocked(bool isBlocked)
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        s_isBlocked = isBlocked;
+        s_condition.notify_all();
+    };
+
+    /** \brief messages starting with 'prefix', in the order written */
+    static std::vector<std::string>
+    getMessages(const std::string& prefix)
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        std::vector<std::string> messages;
+        for (auto& message : s_messages)
+        {
+            if (message.compare(0, prefix.size(), prefix) == 0)
+            {
+                messages.push_back(message);
+            }
+        }
+        return (messages);
+    };
+
+private:
+
+    static LoggerBase::CreationRegistrar<TestLogger> s_registrar;
+    static std::mutex s_mutex;
+    static std::condition_variable s_condition;
+    static bool s_isBlocked;
+    static std::vector<std::string> s_messages;
+};
+
+TestLogger::LoggerBase::CreationRegistrar<TestLogger> TestLogger::s_registrar(s_typeName());
+std::mutex TestLogger::s_mutex;
+std::condition_variable TestLogger::s_condition;
+bool TestLogger::s_isBlocked{false};
+std::vector<std::string> TestLogger::s_messages;
+
+void
+addTestLogger()
+{
+    static bool s_isAdded{false};
+    if (!s_isAdded)
+    {
+        std::string logFilePath;
+        ASSERT_TRUE(LogManager::getInstance().addLogger("test", TestLogger::s_typeName(), LogSeverityLevel::UXASDEBUG, "", logFilePath));
+        s_isAdded = true;
+    }
+}
+
+std::string
+getRecordMessage(const std::string& prefix, size_t thread, size_t record)
+{
+    std::ostringstream message;
+    message << prefix << thread << " " << record;
+    return (message.str());
+}
+
+// each thread's records are written exactly once, in order
+void
+expectThreadRecords(const std::string& prefix, size_t threadCount, size_t threadRecordCount)
+{
+    auto messages = TestLogger::getMessages(prefix);
+    EXPECT_EQ(threadCount * threadRecordCount, messages.size());
+    for (size_t thread = 0; thread < threadCount; thread++)
+    {
+        size_t record(0);
+        for (auto& message : messages)
+        {
+            if (record < threadRecordCount && message == getRecordMessage(prefix, thread, record))
+            {
+                record++;
+            }
+        }
+        EXPECT_EQ(threadRecordCount, record) << prefix << "thread " << thread << " records missing or out of order";
+    }
+}
+
+/** \brief Counts its live instances, to check that the rings destroy their records. */
+struct CountedArgument
+{
+    CountedArgument() { s_count++; };
+    CountedArgument(const CountedArgument&) { s_count++; };
+    ~CountedArgument() { s_count--; };
+    static int32_t s_count;
+};
+
+int32_t CountedArgument::s_count{0};
+
+std::ostream&
+operator<<(std::ostream& stream, const CountedArgument&)
+{
+    return (stream << "counted");
+}
+
+} //namespace
+
+TEST(LogManagerTest, record_ring)
+{
+    {
+        LogRecordRing ring(3);
+        EXPECT_EQ(4u, ring.capacity());
+        // small records are constructed in the slots, large ones allocated
+        typedef LogRecordImpl<const char*, CountedArgument, int32_t> SmallRecord;
+        typedef LogRecordImpl<std::string, std::string, std::string, std::string, std::string, std::string, CountedArgument> LargeRecord;
+        ASSERT_LE(sizeof(SmallRecord), LogRecordRing::c_recordSlotSize);
+        ASSERT_GT(sizeof(LargeRecord), LogRecordRing::c_recordSlotSize);
+        ring.emplace<SmallRecord>(1, LogSeverityLevel::UXASINFO, "small ", CountedArgument(), 1);
+        ring.emplace<LargeRecord>(2, LogSeverityLevel::UXASINFO, "large", " ", "record", " ", "of", " ", CountedArgument());
+        ring.emplace<SmallRecord>(3, LogSeverityLevel::UXASINFO, "small ", CountedArgument(), 3);
+        EXPECT_FALSE(ring.isFull());
+        ring.emplace<SmallRecord>(4, LogSeverityLevel::UXASERROR, "small ", CountedArgument(), 4);
+        EXPECT_TRUE(ring.isFull());
+        EXPECT_EQ(4, CountedArgument::s_count);
+
+        std::vector<std::string> messages;
+        auto format = [&messages](const uxas::common::log::LogRecord& record)
+        {
+            std::ostringstream message;
+            message << record.m_time_ms << ":";
+            record.format(message);
+            messages.push_back(message.str());
+            EXPECT_EQ(std::this_thread::get_id(), record.m_threadId);
+        };
+        EXPECT_TRUE(ring.consume(format));
+        EXPECT_TRUE(ring.consume(format));
+        EXPECT_EQ(std::vector<std::string>({"1:small counted1", "2:large record of counted"}), messages);
+        EXPECT_EQ(2, CountedArgument::s_count);
+        EXPECT_FALSE(ring.isFull());
+        EXPECT_EQ(2u, ring.size());
+    }
+    // records left in a destroyed ring are destroyed
+    EXPECT_EQ(0, CountedArgument::s_count);
+}
+
+TEST(LogManagerTest, ordering)
+{
+    addTestLogger();
+    LogManager::getInstance().setAsynchronous(true, c_ringCapacity);
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < c_threadCount; thread++)
+    {
+        threads.push_back(std::thread([thread]()
+        {
+            for (size_t record = 0; record < c_threadRecordCount; record++)
+            {
+                LogManager::getInstance().log<LogSeverityLevel::UXASINFO>("ordering ", thread, " ", record);
+            }
+        }));
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    LogManager::getInstance().setAsynchronous(false, c_ringCapacity);
+    expectThreadRecords("ordering ", c_threadCount, c_threadRecordCount);
+}
+
+TEST(LogManagerTest, overflow)
+{
+    addTestLogger();
+    auto droppedRecordCount = LogManager::getInstance().getDroppedRecordCount();
+    LogManager::getInstance().setAsynchronous(true, 4);
+
+    // the records are not written while the logger is blocked: the thread's
+    // ring takes 4 records, the next 6 are dropped
+    TestLogger::setIsBlocked(true);
+    std::thread thread([]()
+    {
+        for (size_t record = 0; record < 10; record++)
+        {
+            LogManager::getInstance().log<LogSeverityLevel::UXASDEBUG>("overflow ", record);
+        }
+        // an error is not dropped, and follows the thread's queued records
+        LogManager::getInstance().log<LogSeverityLevel::UXASERROR>("overflow error");
+    });
+    auto deadline = std::chrono::steady_clock::now() + c_waitTimeout;
+    while (LogManager::getInstance().getDroppedRecordCount() < droppedRecordCount + 6 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    // let the error wait for room in the ring
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    TestLogger::setIsBlocked(false);
+    thread.join();
+    LogManager::getInstance().setAsynchronous(false, c_ringCapacity);
+
+    EXPECT_EQ(droppedRecordCount + 6, LogManager::getInstance().getDroppedRecordCount());
+    EXPECT_EQ(std::vector<std::string>({"overflow 0", "overflow 1", "overflow 2", "overflow 3", "overflow error"}),
+              TestLogger::getMessages("overflow "));
+    EXPECT_FALSE(TestLogger::getMessages("LogManager dropped ").empty());
+}
+
+TEST(LogManagerTest, mode_switch)
+{
+    addTestLogger();
+    for (size_t modeSwitch = 0; modeSwitch < c_modeSwitchCount; modeSwitch++)
+    {
+        auto prefix = "switch " + std::to_string(modeSwitch) + " ";
+        LogManager::getInstance().setAsynchronous(true, c_ringCapacity);
+        std::vector<std::thread> threads;
+        for (size_t thread = 0; thread < c_threadCount; thread++)
+        {
+            threads.push_back(std::thread([thread, &prefix]()
+            {
+                for (size_t record = 0; record < c_threadRecordCount; record++)
+                {
+                    LogManager::getInstance().log<LogSeverityLevel::UXASINFO>(prefix, thread, " ", record);
+                }
+            }));
+        }
+        // disable while the threads are logging, at a different point each time
+        std::this_thread::sleep_for(std::chrono::microseconds(50 * modeSwitch));
+        LogManager::getInstance().setAsynchronous(false, c_ringCapacity);
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        // no record is left in a ring, records written synchronously follow the queued ones
+        expectThreadRecords(prefix, c_threadCount, c_threadRecordCount);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    // Build, Google Test run-time and environment tear-down
+    ::testing::InitGoogleTest(&argc, argv);
+    // Run the tests and return the results
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,158 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   MessageEnvelopeTest.cpp
+ *
+ * Functional checks of the binary message envelope (round trip with coded and
+ * uncoded content types and with the payload in a separate frame, source ID
+ * conversion, rejection of malformed headers and legacy attribute strings).
+ */
+#include "gtest/gtest.h"
+
+#include "MessageEnvelope.h"
+
+#include <chrono>
+#include <string>
+
+namespace
+{
+
+using uxas::communications::data::AddressedAttributedMessage;
+using uxas::communications::data::MessageEnvelope;
+
+const std::string c_address("afrl.cmasi.AirVehicleState");
+const std::string c_descriptor("afrl.cmasi.AirVehicleState");
+const std::string c_sourceGroup("fusion");
+const std::string c_payload("LMCP\x00\x01\x02 binary payload", 22);
+const std::chrono::steady_clock::time_point c_sendTime;
+
+std::string
+encode(const std::string& contentType, bool isPayloadInNextFrame = false,
+       const std::chrono::steady_clock::time_point& sendTime = std::chrono::steady_clock::time_point())
+{
+    std::string envelope;
+    EXPECT_TRUE(MessageEnvelope::encode(contentType, c_descriptor, c_sourceGroup, 100, 12, sendTime, c_payload, isPayloadInNextFrame, envelope));
+    return (envelope);
+}
+
+void
+expectMessage(const std::unique_ptr<AddressedAttributedMessage>& message, const std::string& contentType)
+{
+    ASSERT_TRUE(message);
+    EXPECT_EQ(c_address, message->getAddress());
+    EXPECT_EQ(contentType, message->getMessageAttributesReference()->getContentType());
+    EXPECT_EQ(c_descriptor, message->getMessageAttributesReference()->getDescriptor());
+    EXPECT_EQ(c_sourceGroup, message->getMessageAttributesReference()->getSourceGroup());
+    EXPECT_EQ("100", message->getMessageAttributesReference()->getSourceEntityId());
+    EXPECT_EQ("12", message->getMessageAttributesReference()->getSourceServiceId());
+    EXPECT_EQ(c_payload, message->getPayload());
+}
+
+} //namespace
+
+TEST(MessageEnvelopeTest, round_trip)
+{
+    // coded content type and content type carried as a string
+    for (const std::string contentType : {"lmcp", "custom"})
+    {
+        std::string envelope = encode(contentType);
+        EXPECT_TRUE(MessageEnvelope::isEnvelope(envelope.data(), envelope.size()));
+        uint32_t sourceEntityId{0};
+        uint32_t sourceServiceId{0};
+        ASSERT_TRUE(MessageEnvelope::getSourceIds(envelope.data(), envelope.size(), sourceEntityId, sourceServiceId));
+        EXPECT_EQ(100u, sourceEntityId);
+        EXPECT_EQ(12u, sourceServiceId);
+        expectMessage(MessageEnvelope::decode(c_address, envelope.data(), envelope.size()), contentType);
+    }
+}
+
+TEST(MessageEnvelopeTest, payload_in_next_frame)
+{
+    std::string header = encode("lmcp", true);
+    EXPECT_EQ(MessageEnvelope::s_headerSize + c_descriptor.size() + c_sourceGroup.size(), header.size());
+    expectMessage(MessageEnvelope::decode(c_address, header.data(), header.size(), c_payload.data(), c_payload.size()), "lmcp");
+
+    // the payload frame is missing or of the wrong size
+    EXPECT_FALSE(MessageEnvelope::decode(c_address, header.data(), header.size()));
+    EXPECT_FALSE(MessageEnvelope::decode(c_address, header.data(), header.size(), c_payload.data(), c_payload.size() - 1));
+}
+
+TEST(MessageEnvelopeTest, send_time)
+{
+    // carried at full resolution; unknown (epoch) stays unknown
+    auto sendTime = std::chrono::steady_clock::now();
+    for (auto& time : {sendTime, std::chrono::steady_clock::time_point()})
+    {
+        std::string envelope = encode("lmcp", false, time);
+        auto message = MessageEnvelope::decode(c_address, envelope.data(), envelope.size());
+        expectMessage(message, "lmcp");
+        EXPECT_TRUE(time == message->getSendTime());
+    }
+}
+
+TEST(MessageEnvelopeTest, malformed_header)
+{
+    std::string envelope = encode("lmcp");
+
+    // truncated or extended envelope
+    EXPECT_FALSE(MessageEnvelope::decode(c_address, envelope.data(), envelope.size() - 1));
+    std::string extended = envelope + "x";
+    EXPECT_FALSE(MessageEnvelope::decode(c_address, extended.data(), extended.size()));
+    EXPECT_FALSE(MessageEnvelope::isEnvelope(envelope.data(), MessageEnvelope::s_headerSize - 1));
+
+    // wrong marker, magic or version
+    for (size_t byteIndex : {0u, 1u, 2u})
+    {
+        std::string corrupt = envelope;
+        corrupt[byteIndex] ^= 0x40;
+        EXPECT_FALSE(MessageEnvelope::isEnvelope(corrupt.data(), corrupt.size()));
+        EXPECT_FALSE(MessageEnvelope::decode(c_address, corrupt.data(), corrupt.size()));
+    }
+
+    // payload length field that disagrees with the received size
+    std::string corrupt = envelope;
+    corrupt[21] ^= 0x01;
+    EXPECT_FALSE(MessageEnvelope::decode(c_address, corrupt.data(), corrupt.size()));
+
+    // legacy delimited attributes are not envelopes
+    AddressedAttributedMessage legacy;
+    ASSERT_TRUE(legacy.setAddressAttributesAndPayload(c_address, "lmcp", c_descriptor, c_sourceGroup, "100", "12", c_payload));
+    EXPECT_FALSE(MessageEnvelope::isEnvelope(legacy.getString().data(), legacy.getString().size()));
+    EXPECT_FALSE(MessageEnvelope::isEnvelope(nullptr, 100));
+}
+
+TEST(MessageEnvelopeTest, invalid_attributes)
+{
+    std::string envelope;
+    EXPECT_FALSE(MessageEnvelope::encode("lmcp", "", c_sourceGroup, 100, 12, c_sendTime, c_payload, false, envelope));
+    EXPECT_FALSE(MessageEnvelope::encode("lmcp", c_descriptor, c_sourceGroup, 100, 12, c_sendTime, "", false, envelope));
+    EXPECT_FALSE(MessageEnvelope::encode(std::string(256, 'c'), c_descriptor, c_sourceGroup, 100, 12, c_sendTime, c_payload, false, envelope));
+    EXPECT_TRUE(envelope.empty());
+
+    uint32_t id{0};
+    EXPECT_TRUE(MessageEnvelope::toSourceId("4294967295", id));
+    EXPECT_EQ(4294967295u, id);
+    EXPECT_FALSE(MessageEnvelope::toSourceId("4294967296", id));
+    EXPECT_FALSE(MessageEnvelope::toSourceId("", id));
+    EXPECT_FALSE(MessageEnvelope::toSourceId("12a", id));
+    EXPECT_FALSE(MessageEnvelope::toSourceId("-1", id));
+    EXPECT_FALSE(MessageEnvelope::toSourceId("+1", id));
+    EXPECT_FALSE(MessageEnvelope::toSourceId(" 1", id));
+    EXPECT_FALSE(MessageEnvelope::toSourceId("99999999999999999999", id));
+    EXPECT_EQ(4294967295u, id);
+}
+
+int main(int argc, char **argv)
+{
+    // Build, Google Test run-time and environment tear-down
+    ::testing::InitGoogleTest(&argc, argv);
+    // Run the tests and return the results
+    return RUN_ALL_TESTS();
+}
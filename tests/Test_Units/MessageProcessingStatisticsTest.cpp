@@ -0,0 +1,184 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   MessageProcessingStatisticsTest.cpp
+ *
+ * Functional checks of the message processing statistics: the histogram
+ * percentiles and their resolution, the queue wait times of messages with and
+ * without a send time, the registry of network clients and the text and JSON
+ * reports, which must show unmeasured queue depths and wait times as
+ * unavailable rather than 0.
+ */
+#include "gtest/gtest.h"
+
+#include "MessageProcessingStatistics.h"
+#include "UxAS_LatencyHistogram.h"
+
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using uxas::common::LatencyHistogram;
+using uxas::communications::MessageProcessingStatistics;
+
+const std::string c_descriptor("afrl.cmasi.AirVehicleState");
+
+std::string
+getText(const std::vector<MessageProcessingStatistics::Snapshot>& snapshots)
+{
+    std::ostringstream stream;
+    MessageProcessingStatistics::writeText(snapshots, stream);
+    return (stream.str());
+}
+
+std::string
+getJson(const std::vector<MessageProcessingStatistics::Snapshot>& snapshots)
+{
+    std::ostringstream stream;
+    MessageProcessingStatistics::writeJson(snapshots, stream);
+    return (stream.str());
+}
+
+} //namespace
+
+TEST(MessageProcessingStatisticsTest, latency_histogram)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(0u, histogram.getCount());
+    EXPECT_EQ(0u, histogram.getMinimum());
+    EXPECT_EQ(0u, histogram.getMaximum());
+    EXPECT_EQ(0.0, histogram.getMean());
+    EXPECT_EQ(0u, histogram.getValueAtPercentile(50.0));
+
+    // 1 to 1000 once each: exact below 16, within 6.25% above
+    for (uint64_t value = 1; value <= 1000; value++)
+    {
+        histogram.record(value);
+    }
+    EXPECT_EQ(1000u, histogram.getCount());
+    EXPECT_EQ(1u, histogram.getMinimum());
+    EXPECT_EQ(1000u, histogram.getMaximum());
+    EXPECT_DOUBLE_EQ(500.5, histogram.getMean());
+    EXPECT_EQ(1u, histogram.getValueAtPercentile(0.0));
+    EXPECT_EQ(10u, histogram.getValueAtPercentile(1.0));
+    for (double percentile : {50.0, 90.0, 99.0, 99.9})
+    {
+        auto exactValue = static_cast<double>(percentile * 10.0);
+        auto value = static_cast<double>(histogram.getValueAtPercentile(percentile));
+        EXPECT_GE(value, exactValue) << "percentile " << percentile;
+        EXPECT_LE(value, exactValue * 1.0625) << "percentile " << percentile;
+    }
+    EXPECT_EQ(1000u, histogram.getValueAtPercentile(100.0));
+
+    // values beyond the tracked range are counted in the last bucket, the maximum is kept
+    LatencyHistogram largeValues;
+    largeValues.record(0);
+    largeValues.record(UINT64_C(1) << 40);
+    EXPECT_EQ(0u, largeValues.getValueAtPercentile(50.0));
+    EXPECT_EQ(UINT64_C(1) << 40, largeValues.getMaximum());
+    EXPECT_EQ(UINT64_C(1) << 40, largeValues.getValueAtPercentile(100.0));
+
+    histogram.add(largeValues);
+    EXPECT_EQ(1002u, histogram.getCount());
+    EXPECT_EQ(0u, histogram.getMinimum());
+    EXPECT_EQ(UINT64_C(1) << 40, histogram.getMaximum());
+    histogram.reset();
+    EXPECT_EQ(0u, histogram.getCount());
+    EXPECT_EQ(0u, histogram.getValueAtPercentile(99.0));
+}
+
+TEST(MessageProcessingStatisticsTest, queue_wait_time)
+{
+    MessageProcessingStatistics statistics("TestService", 10);
+    auto start = std::chrono::steady_clock::now();
+
+    // unknown send time: processing time only
+    statistics.recordMessage(c_descriptor, std::chrono::steady_clock::time_point(), start, start + std::chrono::microseconds(100));
+    auto snapshot = statistics.getSnapshot();
+    ASSERT_EQ(1u, snapshot.m_messageTypeStatistics.count(c_descriptor));
+    EXPECT_EQ(1u, snapshot.m_messageTypeStatistics[c_descriptor].m_messageCount);
+    EXPECT_EQ(100u, snapshot.m_messageTypeStatistics[c_descriptor].m_processingTime_us.getMaximum());
+    EXPECT_EQ(0u, snapshot.m_messageTypeStatistics[c_descriptor].m_queueWaitTime_us.getCount());
+    EXPECT_EQ(0u, snapshot.m_queueDepth.getCount());
+
+    // known send time: the wait is the time from sending to the start of processing
+    statistics.recordMessage(c_descriptor, start - std::chrono::microseconds(250), start, start + std::chrono::microseconds(100));
+    statistics.recordQueueDepth(3);
+    snapshot = statistics.getSnapshot();
+    EXPECT_EQ(2u, snapshot.m_messageTypeStatistics[c_descriptor].m_messageCount);
+    EXPECT_EQ(1u, snapshot.m_messageTypeStatistics[c_descriptor].m_queueWaitTime_us.getCount());
+    EXPECT_EQ(250u, snapshot.m_messageTypeStatistics[c_descriptor].m_queueWaitTime_us.getMaximum());
+    EXPECT_EQ(3u, snapshot.m_queueDepth.getMaximum());
+}
+
+TEST(MessageProcessingStatisticsTest, unavailable_fields)
+{
+    // a Zero MQ client without send times or queue depths
+    MessageProcessingStatistics statistics("TestService", 11);
+    auto start = std::chrono::steady_clock::now();
+    statistics.recordMessage(c_descriptor, std::chrono::steady_clock::time_point(), start, start + std::chrono::microseconds(100));
+    std::vector<MessageProcessingStatistics::Snapshot> snapshots{statistics.getSnapshot()};
+
+    EXPECT_EQ("TestService.11 queue depth unavailable\n"
+              "TestService.11 afrl.cmasi.AirVehicleState count 1 processing_us p50 100 p99 100 max 100 queue_wait_us unavailable\n",
+              getText(snapshots));
+    EXPECT_EQ("{\"services\":[{\"type\":\"TestService\",\"networkId\":11,\"queueDepth\":null,\"messages\":{"
+              "\"afrl.cmasi.AirVehicleState\":{\"count\":1,"
+              "\"processing_us\":{\"count\":1,\"min\":100,\"mean\":100,\"p50\":100,\"p90\":100,\"p99\":100,\"p999\":100,\"max\":100},"
+              "\"queueWait_us\":null}}}]}",
+              getJson(snapshots));
+
+    // an in-process client measures both
+    statistics.recordMessage(c_descriptor, start - std::chrono::microseconds(20), start, start + std::chrono::microseconds(100));
+    statistics.recordQueueDepth(2);
+    snapshots = {statistics.getSnapshot()};
+    EXPECT_EQ("TestService.11 queue depth p50 2 p99 2 max 2\n"
+              "TestService.11 afrl.cmasi.AirVehicleState count 2 processing_us p50 100 p99 100 max 100 queue_wait_us p50 20 p99 20 max 20\n",
+              getText(snapshots));
+    auto json = getJson(snapshots);
+    EXPECT_NE(std::string::npos, json.find("\"queueDepth\":{\"count\":1,\"min\":2,")) << json;
+    EXPECT_NE(std::string::npos, json.find("\"queueWait_us\":{\"count\":1,\"min\":20,")) << json;
+}
+
+TEST(MessageProcessingStatisticsTest, registry)
+{
+    auto second = std::make_shared<MessageProcessingStatistics>("SecondService", 21);
+    auto first = std::make_shared<MessageProcessingStatistics>("FirstService", 20);
+    MessageProcessingStatistics::registerStatistics(second);
+    MessageProcessingStatistics::registerStatistics(first);
+    MessageProcessingStatistics::registerStatistics(std::shared_ptr<MessageProcessingStatistics>());
+
+    // ordered by network ID
+    auto snapshots = MessageProcessingStatistics::getRegisteredSnapshots();
+    ASSERT_EQ(2u, snapshots.size());
+    EXPECT_EQ("FirstService", snapshots[0].m_networkClientTypeName);
+    EXPECT_EQ(20, snapshots[0].m_networkId);
+    EXPECT_EQ(21, snapshots[1].m_networkId);
+
+    // destroyed network clients are no longer reported
+    second.reset();
+    snapshots = MessageProcessingStatistics::getRegisteredSnapshots();
+    ASSERT_EQ(1u, snapshots.size());
+    EXPECT_EQ(20, snapshots[0].m_networkId);
+    EXPECT_EQ("{\"services\":[]}", getJson({}));
+}
+
+int main(int argc, char **argv)
+{
+    // Build, Google Test run-time and environment tear-down
+    ::testing::InitGoogleTest(&argc, argv);
+    // Run the tests and return the results
+    return RUN_ALL_TESTS();
+}
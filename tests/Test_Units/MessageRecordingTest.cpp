@@ -0,0 +1,228 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   MessageRecordingTest.cpp
+ *
+ * Functional checks of the binary message recording (write/read round trip
+ * with and without compression, index rebuilt from an unterminated recording,
+ * seek by time and message type filtering).
+ */
+#include "gtest/gtest.h"
+
+#include "UxAS_MessageRecording.h"
+
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using uxas::common::log::MessageRecord;
+using uxas::common::log::MessageRecordReader;
+using uxas::common::log::MessageRecordWriter;
+
+const std::vector<std::string> c_descriptors = {"afrl.cmasi.AirVehicleState", "afrl.cmasi.MissionCommand", "uxas.messages.task.TaskPlanOptions"};
+const std::string c_limitedCastAddress("eid400$pid");
+
+/** \brief Small chunks, so that the recordings span several chunks. */
+const uint32_t c_chunkSizeLimit{1024};
+
+// every fifth message is sent to a limited-cast address
+std::vector<MessageRecord>
+createRecords(size_t count)
+{
+    std::vector<MessageRecord> records;
+    for (size_t index = 0; index < count; index++)
+    {
+        MessageRecord record;
+        record.m_time_ms = 1000 + static_cast<int64_t>(index) * 10;
+        record.m_descriptor = c_descriptors[index % c_descriptors.size()];
+        record.m_address = (index % 5 == 4) ? c_limitedCastAddress : record.m_descriptor;
+        record.m_sourceGroup = (index % 2 == 0) ? "fusion" : "";
+        record.m_sourceEntityId = 400 + static_cast<uint32_t>(index % 4);
+        record.m_sourceServiceId = static_cast<uint32_t>(index);
+        record.m_payload = "LMCP" + std::string(1, '\0') + std::to_string(index) + std::string(40 + index % 17, static_cast<char>('a' + index % 26));
+        records.push_back(std::move(record));
+    }
+    return (records);
+}
+
+void
+writeRecords(MessageRecordWriter& writer, const std::vector<MessageRecord>& records)
+{
+    for (const auto& record : records)
+    {
+        ASSERT_TRUE(writer.writeRecord(record.m_time_ms, record.m_address, record.m_descriptor, record.m_sourceGroup,
+                                       record.m_sourceEntityId, record.m_sourceServiceId, record.m_payload));
+    }
+}
+
+std::vector<MessageRecord>
+readRecords(MessageRecordReader& reader)
+{
+    std::vector<MessageRecord> records;
+    MessageRecord record;
+    while (reader.readNextRecord(record))
+    {
+        records.push_back(record);
+    }
+    return (records);
+}
+
+void
+expectEqualRecords(const std::vector<MessageRecord>& expected, const std::vector<MessageRecord>& actual)
+{
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t index = 0; index < expected.size(); index++)
+    {
+        EXPECT_EQ(expected[index].m_time_ms, actual[index].m_time_ms) << "record " << index;
+        EXPECT_EQ(expected[index].m_address, actual[index].m_address) << "record " << index;
+        EXPECT_EQ(expected[index].m_descriptor, actual[index].m_descriptor) << "record " << index;
+        EXPECT_EQ(expected[index].m_sourceGroup, actual[index].m_sourceGroup) << "record " << index;
+        EXPECT_EQ(expected[index].m_sourceEntityId, actual[index].m_sourceEntityId) << "record " << index;
+        EXPECT_EQ(expected[index].m_sourceServiceId, actual[index].m_sourceServiceId) << "record " << index;
+        EXPECT_EQ(expected[index].m_payload, actual[index].m_payload) << "record " << index;
+    }
+}
+
+// records that satisfy a seek time and a type filter (empty: all types)
+std::vector<MessageRecord>
+selectRecords(const std::vector<MessageRecord>& records, int64_t time_ms, const std::set<std::string>& descriptors)
+{
+    std::vector<MessageRecord> selected;
+    for (const auto& record : records)
+    {
+        if (record.m_time_ms >= time_ms && (descriptors.empty() || descriptors.count(record.m_descriptor) > 0))
+        {
+            selected.push_back(record);
+        }
+    }
+    return (selected);
+}
+
+void
+copyFile(const std::string& sourcePath, const std::string& destinationPath)
+{
+    std::ifstream source(sourcePath, std::ios::binary);
+    std::ofstream destination(destinationPath, std::ios::binary | std::ios::trunc);
+    destination << source.rdbuf();
+}
+
+} //namespace
+
+TEST(MessageRecordingTest, round_trip)
+{
+    auto records = createRecords(200);
+    for (bool isCompressed : {true, false})
+    {
+        const std::string filePath(isCompressed ? "MessageRecordingTest_compressed.uxr" : "MessageRecordingTest.uxr");
+        MessageRecordWriter writer;
+        ASSERT_TRUE(writer.open(filePath, isCompressed, c_chunkSizeLimit));
+        writeRecords(writer, records);
+        ASSERT_TRUE(writer.close());
+
+        MessageRecordReader reader;
+        ASSERT_TRUE(reader.open(filePath));
+        EXPECT_LT(1u, reader.getChunkIndexes().size());
+        EXPECT_EQ(c_descriptors.size(), reader.getDescriptors().size());
+        EXPECT_EQ(c_descriptors.size() + 1, reader.getAddresses().size());
+        EXPECT_EQ(records.front().m_time_ms, reader.getFirstTime_ms());
+        EXPECT_EQ(records.back().m_time_ms, reader.getLastTime_ms());
+        expectEqualRecords(records, readRecords(reader));
+        std::remove(filePath.c_str());
+    }
+}
+
+TEST(MessageRecordingTest, rebuild_index)
+{
+    // copy of a recording that was never closed: chunks but no index or trailer
+    const std::string filePath("MessageRecordingTest_open.uxr");
+    const std::string copyFilePath("MessageRecordingTest_unterminated.uxr");
+    auto records = createRecords(150);
+    {
+        MessageRecordWriter writer;
+        ASSERT_TRUE(writer.open(filePath, true, c_chunkSizeLimit));
+        writeRecords(writer, records);
+        ASSERT_TRUE(writer.flush());
+        copyFile(filePath, copyFilePath);
+    }
+
+    MessageRecordReader closedReader;
+    ASSERT_TRUE(closedReader.open(filePath));
+    MessageRecordReader reader;
+    ASSERT_TRUE(reader.open(copyFilePath));
+    ASSERT_EQ(closedReader.getChunkIndexes().size(), reader.getChunkIndexes().size());
+    for (size_t chunk = 0; chunk < reader.getChunkIndexes().size(); chunk++)
+    {
+        EXPECT_EQ(closedReader.getChunkIndexes()[chunk].m_fileOffset, reader.getChunkIndexes()[chunk].m_fileOffset);
+        EXPECT_EQ(closedReader.getChunkIndexes()[chunk].m_recordCount, reader.getChunkIndexes()[chunk].m_recordCount);
+        EXPECT_EQ(closedReader.getChunkIndexes()[chunk].m_firstTime_ms, reader.getChunkIndexes()[chunk].m_firstTime_ms);
+        EXPECT_EQ(closedReader.getChunkIndexes()[chunk].m_lastTime_ms, reader.getChunkIndexes()[chunk].m_lastTime_ms);
+    }
+    EXPECT_TRUE(reader.getDescriptors().empty());
+    expectEqualRecords(records, readRecords(reader));
+
+    // filtering still works without the type index
+    const std::set<std::string> descriptors = {c_descriptors[1]};
+    reader.seekToTime(1505);
+    reader.setDescriptorFilter(descriptors);
+    expectEqualRecords(selectRecords(records, 1505, descriptors), readRecords(reader));
+
+    std::remove(filePath.c_str());
+    std::remove(copyFilePath.c_str());
+}
+
+TEST(MessageRecordingTest, seek_and_filter)
+{
+    const std::string filePath("MessageRecordingTest_filter.uxr");
+    auto records = createRecords(300);
+    {
+        MessageRecordWriter writer;
+        ASSERT_TRUE(writer.open(filePath, true, c_chunkSizeLimit));
+        writeRecords(writer, records);
+    }
+
+    MessageRecordReader reader;
+    ASSERT_TRUE(reader.open(filePath));
+    for (int64_t seekTime_ms : {INT64_MIN, int64_t{1000}, int64_t{1995}, int64_t{2000}, int64_t{3990}, int64_t{5000}})
+    {
+        for (const auto& descriptors : std::vector< std::set<std::string> >{{}, {c_descriptors[0]}, {c_descriptors[1], c_descriptors[2]}, {"unknown.Type"}})
+        {
+            reader.setDescriptorFilter(descriptors);
+            reader.seekToTime(seekTime_ms);
+            expectEqualRecords(selectRecords(records, seekTime_ms, descriptors), readRecords(reader));
+        }
+    }
+    std::remove(filePath.c_str());
+}
+
+TEST(MessageRecordingTest, invalid_recording)
+{
+    const std::string filePath("MessageRecordingTest_invalid.uxr");
+    {
+        std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+        file << "not a message recording";
+    }
+    MessageRecordReader reader;
+    EXPECT_FALSE(reader.open(filePath));
+    EXPECT_FALSE(reader.open("MessageRecordingTest_missing.uxr"));
+    std::remove(filePath.c_str());
+}
+
+int main(int argc, char **argv)
+{
+    // Build, Google Test run-time and environment tear-down
+    ::testing::InitGoogleTest(&argc, argv);
+    // Run the tests and return the results
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,150 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   NetworkServerShardsTest.cpp
+ *
+ * Functional checks of the worker shards of the sharded network server: the
+ * messages of each sender must be published by one shard in the order they
+ * were pushed, the counters must account for every message, and stopping
+ * must publish the messages still queued.
+ */
+#include "gtest/gtest.h"
+
+#include "NetworkServerShards.h"
+
+#include "stdUniquePtr.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+using uxas::communications::NetworkServerShards;
+using uxas::communications::data::AddressedAttributedMessage;
+
+/** \brief Message of sender (entity 1, service <B><i>serviceId</i></B>) with
+ * payload <B><i>sequence</i></B>. */
+std::unique_ptr<AddressedAttributedMessage>
+createMessage(uint32_t serviceId, uint32_t sequence)
+{
+    auto message = uxas::stduxas::make_unique<AddressedAttributedMessage>();
+    message->setAddressAttributesAndPayload("afrl.cmasi.KeyValuePair", "lmcp", "afrl.cmasi.KeyValuePair", "", "1",
+                                            std::to_string(serviceId), std::to_string(sequence));
+    return (message);
+};
+
+/** \brief Records the published payloads by sender and the shard of each sender. */
+class PublishRecorder
+{
+public:
+
+    NetworkServerShards::Publisher
+    getPublisher()
+    {
+        return ([this](uint32_t shardIndex, std::unique_ptr<AddressedAttributedMessage> message)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const std::string& sender = message->getMessageAttributesReference()->getSourceServiceId();
+            m_sequencesBySender[sender].push_back(std::stoul(message->getPayload()));
+            m_shardIndicesBySender[sender].push_back(shardIndex);
+        });
+    };
+
+    std::mutex m_mutex;
+    std::map<std::string, std::vector<uint32_t> > m_sequencesBySender;
+    std::map<std::string, std::vector<uint32_t> > m_shardIndicesBySender;
+};
+
+} //namespace
+
+TEST(NetworkServerShardsTest, sender_order)
+{
+    const uint32_t senderCount{16};
+    const uint32_t messageCount{500};
+    PublishRecorder recorder;
+    NetworkServerShards shards(4, recorder.getPublisher());
+    shards.start();
+
+    // senders interleaved
+    for (uint32_t sequence = 0; sequence < messageCount; sequence++)
+    {
+        for (uint32_t serviceId = 0; serviceId < senderCount; serviceId++)
+        {
+            shards.push(createMessage(serviceId, sequence));
+        }
+    }
+    shards.stop();
+
+    // each sender on one shard, in push order
+    std::vector<uint32_t> expectedSequences;
+    for (uint32_t sequence = 0; sequence < messageCount; sequence++)
+    {
+        expectedSequences.push_back(sequence);
+    }
+    std::vector<uint64_t> expectedPublishedMessageCounts(shards.getShardCount(), 0);
+    ASSERT_EQ(senderCount, recorder.m_sequencesBySender.size());
+    for (uint32_t serviceId = 0; serviceId < senderCount; serviceId++)
+    {
+        std::string sender = std::to_string(serviceId);
+        uint32_t shardIndex = shards.getShardIndex(*createMessage(serviceId, 0));
+        EXPECT_EQ(expectedSequences, recorder.m_sequencesBySender[sender]);
+        EXPECT_EQ(std::vector<uint32_t>(messageCount, shardIndex), recorder.m_shardIndicesBySender[sender]);
+        expectedPublishedMessageCounts[shardIndex] += messageCount;
+    }
+
+    // counters account for every message
+    EXPECT_EQ(senderCount * messageCount, shards.getReceivedMessageCount());
+    for (uint32_t shardIndex = 0; shardIndex < shards.getShardCount(); shardIndex++)
+    {
+        EXPECT_EQ(expectedPublishedMessageCounts[shardIndex], shards.getPublishedMessageCount(shardIndex));
+        EXPECT_EQ(0u, shards.getQueueDepth(shardIndex));
+        EXPECT_LE(shards.getMaximumQueueDepth(shardIndex), expectedPublishedMessageCounts[shardIndex]);
+    }
+}
+
+TEST(NetworkServerShardsTest, stop_publishes_queued_messages)
+{
+    const uint32_t messageCount{100};
+    PublishRecorder recorder;
+    NetworkServerShards shards(2, recorder.getPublisher());
+
+    // queued before the workers start
+    for (uint32_t sequence = 0; sequence < messageCount; sequence++)
+    {
+        shards.push(createMessage(7, sequence));
+    }
+    uint32_t shardIndex = shards.getShardIndex(*createMessage(7, 0));
+    EXPECT_EQ(messageCount, shards.getReceivedMessageCount());
+    EXPECT_EQ(messageCount, shards.getQueueDepth(shardIndex));
+    EXPECT_EQ(messageCount, shards.getMaximumQueueDepth(shardIndex));
+    EXPECT_EQ(0u, shards.getPublishedMessageCount(shardIndex));
+
+    // stopping right after starting still publishes every queued message
+    shards.start();
+    shards.stop();
+    EXPECT_EQ(messageCount, shards.getPublishedMessageCount(shardIndex));
+    EXPECT_EQ(0u, shards.getPublishedMessageCount(1 - shardIndex));
+    EXPECT_EQ(0u, shards.getQueueDepth(shardIndex));
+    EXPECT_EQ(messageCount, shards.getMaximumQueueDepth(shardIndex));
+    EXPECT_EQ(messageCount, recorder.m_sequencesBySender["7"].size());
+}
+
+int main(int argc, char **argv)
+{
+    // Build, Google Test run-time and environment tear-down
+    ::testing::InitGoogleTest(&argc, argv);
+    // Run the tests and return the results
+    return RUN_ALL_TESTS();
+}
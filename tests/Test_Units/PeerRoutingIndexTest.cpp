@@ -0,0 +1,174 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   PeerRoutingIndexTest.cpp
+ *
+ * Functional checks of the routing index of the Zyre bridge: it must route
+ * each address to the same peers as a linear scan of the subscriptions for
+ * prefixes of the address (the former routing), including with more than 64
+ * peers, and the routing cache must be flushed when the index is replaced.
+ */
+#include "gtest/gtest.h"
+
+#include "PeerRoutingIndex.h"
+
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+
+using uxas::communications::PeerRoutingCache;
+using uxas::communications::PeerRoutingIndex;
+
+typedef std::unordered_map<std::string, std::set<std::string> > PeerIdsByAddress;
+
+/** \brief Peers subscribed to a prefix of <B><i>address</i></B>, by linear scan. */
+std::set<std::string>
+getScannedPeerIds(const PeerIdsByAddress& peerIdsBySubscriptionAddress, const std::string& address)
+{
+    std::set<std::string> peerIds;
+    for (const auto& addressPeerIds : peerIdsBySubscriptionAddress)
+    {
+        if (address.compare(0, addressPeerIds.first.size(), addressPeerIds.first) == 0)
+        {
+            peerIds.insert(addressPeerIds.second.begin(), addressPeerIds.second.end());
+        }
+    }
+    return (peerIds);
+};
+
+std::set<std::string>
+getPeerIds(const PeerRoutingIndex& routingIndex, const PeerRoutingIndex::PeerBitset& peers)
+{
+    std::set<std::string> peerIds;
+    for (size_t peerIndex = 0; peerIndex < routingIndex.getPeerCount(); peerIndex++)
+    {
+        if (peers[peerIndex / 64] & (uint64_t(1) << (peerIndex % 64)))
+        {
+            peerIds.insert(routingIndex.getPeerId(peerIndex));
+        }
+    }
+    return (peerIds);
+};
+
+std::string
+getPeerId(size_t peer)
+{
+    return ("peer" + std::to_string(1000 + peer));
+};
+
+} //namespace
+
+TEST(PeerRoutingIndexTest, prefix_and_exact_subscriptions)
+{
+    PeerIdsByAddress peerIdsBySubscriptionAddress;
+    peerIdsBySubscriptionAddress["afrl.cmasi"] = {"a"};
+    peerIdsBySubscriptionAddress["afrl.cmasi.AirVehicleState"] = {"b", "a"};
+    peerIdsBySubscriptionAddress["eid12"] = {"c"};
+    peerIdsBySubscriptionAddress["empty"] = {};
+    PeerRoutingIndex routingIndex(peerIdsBySubscriptionAddress);
+    EXPECT_EQ(3u, routingIndex.getPeerCount());
+    EXPECT_EQ(3u, routingIndex.getSubscriptionAddressCount());
+
+    // exact and prefix subscriptions, each peer once
+    EXPECT_EQ(std::set<std::string>({"a", "b"}), getPeerIds(routingIndex, routingIndex.getRoutedPeers("afrl.cmasi.AirVehicleState")));
+    EXPECT_EQ(std::set<std::string>({"a", "b"}), getPeerIds(routingIndex, routingIndex.getRoutedPeers("afrl.cmasi.AirVehicleStateX")));
+    EXPECT_EQ(std::set<std::string>({"a"}), getPeerIds(routingIndex, routingIndex.getRoutedPeers("afrl.cmasi.AirVehicle")));
+    EXPECT_EQ(std::set<std::string>({"a"}), getPeerIds(routingIndex, routingIndex.getRoutedPeers("afrl.cmasi")));
+    // subscriptions match raw string prefixes, as Zero MQ subscriptions
+    EXPECT_EQ(std::set<std::string>({"c"}), getPeerIds(routingIndex, routingIndex.getRoutedPeers("eid12s5")));
+    EXPECT_EQ(std::set<std::string>({"c"}), getPeerIds(routingIndex, routingIndex.getRoutedPeers("eid123")));
+    // longer subscriptions do not match
+    EXPECT_TRUE(getPeerIds(routingIndex, routingIndex.getRoutedPeers("afrl.cmas")).empty());
+    EXPECT_TRUE(getPeerIds(routingIndex, routingIndex.getRoutedPeers("eid1")).empty());
+    EXPECT_TRUE(getPeerIds(routingIndex, routingIndex.getRoutedPeers("empty")).empty());
+    EXPECT_TRUE(getPeerIds(routingIndex, routingIndex.getRoutedPeers("")).empty());
+
+    // no subscriptions
+    PeerRoutingIndex emptyRoutingIndex;
+    EXPECT_EQ(0u, emptyRoutingIndex.getPeerCount());
+    EXPECT_TRUE(emptyRoutingIndex.getRoutedPeers("afrl.cmasi").empty());
+}
+
+TEST(PeerRoutingIndexTest, linear_scan_equivalence)
+{
+    // more than two words of peers, with peers at word boundaries
+    const size_t peerCount{150};
+    const std::vector<std::string> addresses{"afrl", "afrl.cmasi", "afrl.cmasi.AirVehicleState", "afrl.cmasi.AirVehicleConfiguration",
+        "afrl.impact", "uxas.messages.task", "uxas.messages.task.TaskPlanOptions", "eid1", "eid12", "eid12s3", "eid123"};
+    std::mt19937 random(17);
+    PeerIdsByAddress peerIdsBySubscriptionAddress;
+    for (size_t peer = 0; peer < peerCount; peer++)
+    {
+        // unicast address, so that every peer subscribes to some address
+        peerIdsBySubscriptionAddress["u" + getPeerId(peer)].insert(getPeerId(peer));
+        for (const auto& address : addresses)
+        {
+            if (random() % 4 == 0 || (address == "eid12s3" && peer % 64 == 63))
+            {
+                peerIdsBySubscriptionAddress[address].insert(getPeerId(peer));
+            }
+        }
+    }
+    peerIdsBySubscriptionAddress["last"] = {getPeerId(peerCount - 1)};
+    PeerRoutingIndex routingIndex(peerIdsBySubscriptionAddress);
+    ASSERT_EQ(peerCount, routingIndex.getPeerCount());
+    EXPECT_EQ(3u, routingIndex.getRoutedPeers("afrl").size());
+
+    std::vector<std::string> sentAddresses(addresses);
+    sentAddresses.insert(sentAddresses.end(), {"afrl.cmasi.AirVehicleStateX", "afrl.cmas", "eid12s34", "eid2", "last", "lastX", "las", "",
+                                                "u" + getPeerId(0), "u" + getPeerId(64) + ".suffix", "u" + getPeerId(149)});
+    for (const auto& address : sentAddresses)
+    {
+        EXPECT_EQ(getScannedPeerIds(peerIdsBySubscriptionAddress, address), getPeerIds(routingIndex, routingIndex.getRoutedPeers(address))) << address;
+    }
+
+    // the peer in the last word
+    EXPECT_EQ(std::set<std::string>({getPeerId(peerCount - 1)}), getPeerIds(routingIndex, routingIndex.getRoutedPeers("lastX")));
+    EXPECT_EQ(uint64_t(1) << ((peerCount - 1) % 64), routingIndex.getRoutedPeers("last")[2]);
+}
+
+TEST(PeerRoutingIndexTest, cache_flush)
+{
+    PeerIdsByAddress peerIdsBySubscriptionAddress;
+    peerIdsBySubscriptionAddress["afrl.cmasi"] = {"a", "b"};
+    auto routingIndex = std::make_shared<const PeerRoutingIndex>(peerIdsBySubscriptionAddress);
+    PeerRoutingCache routingCache(2);
+
+    EXPECT_EQ(std::set<std::string>({"a", "b"}), getPeerIds(*routingIndex, routingCache.getRoutedPeers(routingIndex, "afrl.cmasi.AirVehicleState")));
+    EXPECT_EQ(std::set<std::string>({"a", "b"}), getPeerIds(*routingIndex, routingCache.getRoutedPeers(routingIndex, "afrl.cmasi.AirVehicleState")));
+    EXPECT_EQ(1u, routingCache.getAddressCount());
+
+    // a replaced index flushes the cached routes
+    peerIdsBySubscriptionAddress["afrl.cmasi"].erase("a");
+    peerIdsBySubscriptionAddress["afrl.cmasi.AirVehicleState"] = {"c"};
+    auto newRoutingIndex = std::make_shared<const PeerRoutingIndex>(peerIdsBySubscriptionAddress);
+    EXPECT_EQ(std::set<std::string>({"b", "c"}), getPeerIds(*newRoutingIndex, routingCache.getRoutedPeers(newRoutingIndex, "afrl.cmasi.AirVehicleState")));
+    EXPECT_EQ(1u, routingCache.getAddressCount());
+
+    // a full cache is flushed
+    routingCache.getRoutedPeers(newRoutingIndex, "afrl.cmasi.AirVehicleConfiguration");
+    EXPECT_EQ(2u, routingCache.getAddressCount());
+    EXPECT_EQ(std::set<std::string>({"b"}), getPeerIds(*newRoutingIndex, routingCache.getRoutedPeers(newRoutingIndex, "afrl.cmasi.KeepInZone")));
+    EXPECT_EQ(1u, routingCache.getAddressCount());
+}
+
+int main(int argc, char **argv)
+{
+    // Build, Google Test run-time and environment tear-down
+    ::testing::InitGoogleTest(&argc, argv);
+    // Run the tests and return the results
+    return RUN_ALL_TESTS();
+}
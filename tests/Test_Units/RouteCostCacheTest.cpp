@@ -0,0 +1,232 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   RouteCostCacheTest.cpp
+ *
+ * Functional checks of the route costs reused between automation requests:
+ * reused costs must equal the costs of planning the routes again, routes
+ * that differ in vehicle, operating region, planning speed or pose must be
+ * planned, and
+ * dropped routes and discarded costs must not be reused.
+ */
+#include "gtest/gtest.h"
+
+#include "RouteCostCache.h"
+
+#include "afrl/cmasi/Location3D.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+using uxas::service::RouteCostCache;
+
+struct Route
+{
+    int64_t m_vehicleId;
+    int64_t m_operatingRegion;
+    double m_planningSpeed_mps;
+    std::unique_ptr<uxas::messages::route::RouteConstraints> m_routeConstraints;
+};
+
+afrl::cmasi::Location3D*
+createLocation(double latitude, double longitude, float altitude)
+{
+    auto location = new afrl::cmasi::Location3D;
+    location->setLatitude(latitude);
+    location->setLongitude(longitude);
+    location->setAltitude(altitude);
+    return (location);
+}
+
+Route
+createRoute(int64_t routeId, int64_t vehicleId, int64_t operatingRegion,
+            double startLatitude, double startLongitude, float startHeading,
+            double endLatitude, double endLongitude, float endHeading, double planningSpeed_mps = 20.0)
+{
+    Route route{vehicleId, operatingRegion, planningSpeed_mps, std::unique_ptr<uxas::messages::route::RouteConstraints>(new uxas::messages::route::RouteConstraints)};
+    route.m_routeConstraints->setRouteID(routeId);
+    route.m_routeConstraints->setStartLocation(createLocation(startLatitude, startLongitude, 100.0f));
+    route.m_routeConstraints->setStartHeading(startHeading);
+    route.m_routeConstraints->setEndLocation(createLocation(endLatitude, endLongitude, 100.0f));
+    route.m_routeConstraints->setEndHeading(endHeading);
+    return (route);
+}
+
+// stands in for a route planner: the cost depends on every part of the key
+int64_t
+planRouteCost(const Route& route)
+{
+    auto& constraints = *route.m_routeConstraints;
+    double distance = std::hypot(constraints.getEndLocation()->getLatitude() - constraints.getStartLocation()->getLatitude(),
+                                 constraints.getEndLocation()->getLongitude() - constraints.getStartLocation()->getLongitude());
+    double turn = std::abs(constraints.getEndHeading() - constraints.getStartHeading());
+    return (static_cast<int64_t>(distance * 1.0e8 / (route.m_vehicleId * route.m_planningSpeed_mps) + turn * 100.0) + route.m_operatingRegion);
+}
+
+// the routes of one automation request: from the vehicles' starts to three task options and between them
+std::vector<Route>
+createRequestRoutes(int64_t firstRouteId, double vehicle2StartLatitude, float option3Heading, double vehicle2Speed_mps = 20.0)
+{
+    const std::vector<std::vector<double> > options = {{45.30, -120.90, 90.0}, {45.32, -120.85, 180.0}, {45.28, -120.80, option3Heading}};
+    const std::vector<std::vector<double> > starts = {{45.25, -121.00, 0.0}, {vehicle2StartLatitude, -120.95, 45.0}};
+    const std::vector<double> speeds = {20.0, vehicle2Speed_mps};
+    std::vector<Route> routes;
+    int64_t routeId = firstRouteId;
+    for (size_t vehicle = 0; vehicle < starts.size(); vehicle++)
+    {
+        for (size_t to = 0; to < options.size(); to++)
+        {
+            routes.push_back(createRoute(routeId++, static_cast<int64_t>(vehicle) + 1, 7, starts[vehicle][0], starts[vehicle][1],
+                                         static_cast<float>(starts[vehicle][2]), options[to][0], options[to][1], static_cast<float>(options[to][2]),
+                                         speeds[vehicle]));
+            for (size_t from = 0; from < options.size(); from++)
+            {
+                if (from != to)
+                {
+                    routes.push_back(createRoute(routeId++, static_cast<int64_t>(vehicle) + 1, 7, options[from][0], options[from][1],
+                                                 static_cast<float>(options[from][2]), options[to][0], options[to][1], static_cast<float>(options[to][2]),
+                                                 speeds[vehicle]));
+                }
+            }
+        }
+    }
+    return (routes);
+}
+
+// finds the reusable costs and adds the planned costs of all routes like the RouteAggregatorService,
+// returns the number of reused costs
+size_t
+completeRequest(RouteCostCache& routeCostCache, const std::vector<Route>& routes)
+{
+    size_t numberReusedCosts(0);
+    for (const auto& route : routes)
+    {
+        int64_t routeCost_ms(-1);
+        if (routeCostCache.isFindRouteCost(route.m_vehicleId, route.m_operatingRegion, route.m_planningSpeed_mps, route.m_routeConstraints.get(), routeCost_ms))
+        {
+            EXPECT_EQ(planRouteCost(route), routeCost_ms) << "route " << route.m_routeConstraints->getRouteID();
+            numberReusedCosts++;
+        }
+    }
+    EXPECT_EQ(routes.size(), routeCostCache.getPendingRouteCount());
+    for (const auto& route : routes)
+    {
+        routeCostCache.addRouteCost(route.m_routeConstraints->getRouteID(), planRouteCost(route));
+    }
+    routeCostCache.commitRouteCosts();
+    EXPECT_EQ(0u, routeCostCache.getPendingRouteCount());
+    return (numberReusedCosts);
+}
+
+} //namespace
+
+TEST(RouteCostCacheTest, reused_costs_match_planned_costs)
+{
+    RouteCostCache routeCostCache;
+    auto routes = createRequestRoutes(1000, 45.26, 270.0f);
+    EXPECT_EQ(0u, completeRequest(routeCostCache, routes));
+    EXPECT_EQ(routes.size(), routeCostCache.getRouteCostCount());
+
+    // the same request again: every cost is reused
+    EXPECT_EQ(routes.size(), completeRequest(routeCostCache, createRequestRoutes(2000, 45.26, 270.0f)));
+
+    // vehicle 2 moved: its routes from the start are planned (3 of 18)
+    EXPECT_EQ(routes.size() - 3, completeRequest(routeCostCache, createRequestRoutes(3000, 45.27, 270.0f)));
+
+    // option 3 changed heading: all routes to and from option 3 are planned (5 per vehicle)
+    EXPECT_EQ(routes.size() - 10, completeRequest(routeCostCache, createRequestRoutes(4000, 45.27, 300.0f)));
+
+    // vehicle 2 changed speed (e.g., its ground speed): all its routes are planned (9 of 18)
+    EXPECT_EQ(routes.size() - 9, completeRequest(routeCostCache, createRequestRoutes(4500, 45.27, 300.0f, 25.0)));
+    EXPECT_EQ(routes.size(), completeRequest(routeCostCache, createRequestRoutes(4600, 45.27, 300.0f, 25.0)));
+
+    // another vehicle, operating region or planning speed on an identical route does not reuse the cost
+    auto route = createRoute(5000, 3, 7, 45.30, -120.90, 90.0f, 45.32, -120.85, 180.0f);
+    int64_t routeCost_ms(-1);
+    EXPECT_FALSE(routeCostCache.isFindRouteCost(route.m_vehicleId, route.m_operatingRegion, route.m_planningSpeed_mps, route.m_routeConstraints.get(), routeCost_ms));
+    route = createRoute(5001, 1, 8, 45.30, -120.90, 90.0f, 45.32, -120.85, 180.0f);
+    EXPECT_FALSE(routeCostCache.isFindRouteCost(route.m_vehicleId, route.m_operatingRegion, route.m_planningSpeed_mps, route.m_routeConstraints.get(), routeCost_ms));
+    route = createRoute(5002, 1, 7, 45.30, -120.90, 90.0f, 45.32, -120.85, 180.0f, 25.0);
+    EXPECT_FALSE(routeCostCache.isFindRouteCost(route.m_vehicleId, route.m_operatingRegion, route.m_planningSpeed_mps, route.m_routeConstraints.get(), routeCost_ms));
+    route = createRoute(5003, 1, 7, 45.30, -120.90, 90.0f, 45.32, -120.85, 180.0f);
+    EXPECT_TRUE(routeCostCache.isFindRouteCost(route.m_vehicleId, route.m_operatingRegion, route.m_planningSpeed_mps, route.m_routeConstraints.get(), routeCost_ms));
+    EXPECT_EQ(planRouteCost(route), routeCost_ms);
+}
+
+TEST(RouteCostCacheTest, dropped_routes)
+{
+    RouteCostCache routeCostCache;
+    auto routes = createRequestRoutes(1000, 45.26, 270.0f);
+    int64_t routeCost_ms(-1);
+    for (const auto& route : routes)
+    {
+        routeCostCache.isFindRouteCost(route.m_vehicleId, route.m_operatingRegion, route.m_planningSpeed_mps, route.m_routeConstraints.get(), routeCost_ms);
+    }
+    ASSERT_EQ(routes.size(), routeCostCache.getPendingRouteCount());
+
+    // a rebuilt request drops the keys of its earlier routes, costs arriving for them are not kept
+    for (const auto& route : routes)
+    {
+        routeCostCache.removeRoute(route.m_routeConstraints->getRouteID());
+    }
+    EXPECT_EQ(0u, routeCostCache.getPendingRouteCount());
+    for (const auto& route : routes)
+    {
+        routeCostCache.addRouteCost(route.m_routeConstraints->getRouteID(), planRouteCost(route));
+    }
+    routeCostCache.commitRouteCosts();
+    EXPECT_EQ(0u, routeCostCache.getRouteCostCount());
+
+    // routes without a path are planned again
+    EXPECT_EQ(0u, completeRequest(routeCostCache, routes));
+    auto route = createRoute(2000, 1, 7, 45.0, -121.0, 0.0f, 46.0, -121.0, 0.0f);
+    routeCostCache.isFindRouteCost(route.m_vehicleId, route.m_operatingRegion, route.m_planningSpeed_mps, route.m_routeConstraints.get(), routeCost_ms);
+    routeCostCache.addRouteCost(2000, -1);
+    routeCostCache.commitRouteCosts();
+    EXPECT_FALSE(routeCostCache.isFindRouteCost(route.m_vehicleId, route.m_operatingRegion, route.m_planningSpeed_mps, route.m_routeConstraints.get(), routeCost_ms));
+}
+
+TEST(RouteCostCacheTest, clear)
+{
+    RouteCostCache routeCostCache;
+    auto routes = createRequestRoutes(1000, 45.26, 270.0f);
+    completeRequest(routeCostCache, routes);
+    ASSERT_EQ(routes.size(), routeCostCache.getRouteCostCount());
+
+    // costs of routes planned before the zones changed are not kept either
+    int64_t routeCost_ms(-1);
+    auto pendingRoutes = createRequestRoutes(2000, 45.26, 270.0f);
+    for (const auto& route : pendingRoutes)
+    {
+        EXPECT_TRUE(routeCostCache.isFindRouteCost(route.m_vehicleId, route.m_operatingRegion, route.m_planningSpeed_mps, route.m_routeConstraints.get(), routeCost_ms));
+    }
+    routeCostCache.clear();
+    EXPECT_EQ(0u, routeCostCache.getRouteCostCount());
+    EXPECT_EQ(0u, routeCostCache.getPendingRouteCount());
+    for (const auto& route : pendingRoutes)
+    {
+        routeCostCache.addRouteCost(route.m_routeConstraints->getRouteID(), planRouteCost(route));
+    }
+    routeCostCache.commitRouteCosts();
+    EXPECT_EQ(0u, routeCostCache.getRouteCostCount());
+    EXPECT_EQ(0u, completeRequest(routeCostCache, createRequestRoutes(3000, 45.26, 270.0f)));
+}
+
+int main(int argc, char **argv)
+{
+    // Build, Google Test run-time and environment tear-down
+    ::testing::InitGoogleTest(&argc, argv);
+    // Run the tests and return the results
+    return RUN_ALL_TESTS();
+}
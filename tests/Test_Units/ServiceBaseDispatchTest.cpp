@@ -0,0 +1,164 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   ServiceBaseDispatchTest.cpp
+ *
+ * Functional checks of the typed message dispatch of services: received
+ * objects must reach the handler of their exact type or of a named
+ * descendant type, others processReceivedLmcpMessage, and a handler must be
+ * able to terminate the service. With setIsLmcpObjectHandlerOnly, the type
+ * filter must only accept handled types (and KillService), and unhandled
+ * messages must not reach processReceivedLmcpMessage.
+ */
+#include "gtest/gtest.h"
+
+#include "ServiceBase.h"
+
+#include "afrl/cmasi/AirVehicleState.h"
+#include "afrl/cmasi/EntityStateDescendants.h"
+#include "afrl/cmasi/KeyValuePair.h"
+#include "afrl/vehicles/GroundVehicleState.h"
+#include "uxas/messages/uxnative/KillService.h"
+
+#include "stdUniquePtr.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+/** \brief Service recording where each received object was dispatched to. */
+class DispatchTestService : public uxas::service::ServiceBase
+{
+public:
+
+    DispatchTestService()
+    : ServiceBase("DispatchTestService", "") { };
+
+    void
+    addHandlers()
+    {
+        addLmcpObjectHandler<afrl::cmasi::AirVehicleState>([this](const std::shared_ptr<afrl::cmasi::AirVehicleState>& airVehicleState)
+        {
+            m_dispatches.push_back("AirVehicleState handler " + airVehicleState->getFullLmcpTypeName());
+            return (m_isTerminateOnAirVehicleState);
+        });
+        addLmcpObjectHandler<afrl::cmasi::EntityState>(afrl::cmasi::EntityStateDescendants(), [this](const std::shared_ptr<afrl::cmasi::EntityState>& entityState)
+        {
+            m_dispatches.push_back("EntityState handler " + entityState->getFullLmcpTypeName());
+            return (false);
+        });
+    };
+
+    using ServiceBase::setIsLmcpObjectHandlerOnly;
+
+    bool
+    dispatch(const std::shared_ptr<avtas::lmcp::Object>& object)
+    {
+        auto attributes = uxas::stduxas::make_unique<uxas::communications::data::MessageAttributes>();
+        attributes->setAttributes("lmcp", object->getFullLmcpTypeName(), "", "1", "2");
+        return (dispatchReceivedLmcpMessage(uxas::stduxas::make_unique<uxas::communications::data::LmcpMessage>(std::move(attributes), object)));
+    };
+
+    bool
+    isAcceptedLmcpType(const avtas::lmcp::Object& object)
+    {
+        return (m_lmcpObjectMessageReceiverPipe.isAcceptedLmcpType(object.getSeriesNameAsLong(), object.getLmcpType(), object.getFullLmcpTypeName()));
+    };
+
+    bool m_isTerminateOnAirVehicleState{false};
+    bool m_isTerminateOnProcess{false};
+    std::vector<std::string> m_dispatches;
+
+protected:
+
+    bool
+    processReceivedLmcpMessage(std::unique_ptr<uxas::communications::data::LmcpMessage> receivedLmcpMessage) override
+    {
+        m_dispatches.push_back("process " + receivedLmcpMessage->m_object->getFullLmcpTypeName());
+        return (m_isTerminateOnProcess);
+    };
+};
+
+} //namespace
+
+TEST(ServiceBaseDispatchTest, typed_dispatch)
+{
+    DispatchTestService service;
+    auto airVehicleState = std::make_shared<afrl::cmasi::AirVehicleState>();
+    auto groundVehicleState = std::make_shared<afrl::vehicles::GroundVehicleState>();
+    auto keyValuePair = std::make_shared<afrl::cmasi::KeyValuePair>();
+
+    // without handlers everything is processed
+    EXPECT_FALSE(service.dispatch(airVehicleState));
+    EXPECT_EQ(std::vector<std::string>({"process afrl.cmasi.AirVehicleState"}), service.m_dispatches);
+
+    // exact type, named descendant (resolved on first receipt, then by type IDs) and unhandled type
+    service.addHandlers();
+    service.m_dispatches.clear();
+    EXPECT_FALSE(service.dispatch(airVehicleState));
+    EXPECT_FALSE(service.dispatch(groundVehicleState));
+    EXPECT_FALSE(service.dispatch(groundVehicleState));
+    EXPECT_FALSE(service.dispatch(keyValuePair));
+    EXPECT_EQ(std::vector<std::string>({"AirVehicleState handler afrl.cmasi.AirVehicleState",
+                                        "EntityState handler afrl.vehicles.GroundVehicleState",
+                                        "EntityState handler afrl.vehicles.GroundVehicleState",
+                                        "process afrl.cmasi.KeyValuePair"}), service.m_dispatches);
+
+    // handlers and processReceivedLmcpMessage terminate the service alike
+    service.m_isTerminateOnAirVehicleState = true;
+    EXPECT_TRUE(service.dispatch(airVehicleState));
+    EXPECT_FALSE(service.dispatch(groundVehicleState));
+    service.m_isTerminateOnProcess = true;
+    EXPECT_TRUE(service.dispatch(keyValuePair));
+
+    // without a filter every type is accepted on receipt
+    EXPECT_TRUE(service.isAcceptedLmcpType(*keyValuePair));
+}
+
+TEST(ServiceBaseDispatchTest, handler_only)
+{
+    DispatchTestService service;
+    service.addHandlers();
+    service.setIsLmcpObjectHandlerOnly(true);
+    afrl::cmasi::AirVehicleState airVehicleState;
+    afrl::vehicles::GroundVehicleState groundVehicleState;
+    afrl::cmasi::KeyValuePair keyValuePair;
+    uxas::messages::uxnative::KillService killService;
+
+    // the filter accepts handled types (named ones before their first receipt) and KillService
+    EXPECT_TRUE(service.isAcceptedLmcpType(airVehicleState));
+    EXPECT_TRUE(service.isAcceptedLmcpType(groundVehicleState));
+    EXPECT_TRUE(service.isAcceptedLmcpType(groundVehicleState));
+    EXPECT_TRUE(service.isAcceptedLmcpType(killService));
+    EXPECT_FALSE(service.isAcceptedLmcpType(keyValuePair));
+    EXPECT_FALSE(service.isAcceptedLmcpType(keyValuePair));
+
+    // unhandled messages that were not filtered (e.g., hosted services) are discarded
+    service.m_isTerminateOnProcess = true;
+    EXPECT_FALSE(service.dispatch(std::make_shared<afrl::cmasi::KeyValuePair>()));
+    EXPECT_FALSE(service.dispatch(std::make_shared<afrl::vehicles::GroundVehicleState>()));
+    EXPECT_EQ(std::vector<std::string>({"EntityState handler afrl.vehicles.GroundVehicleState"}), service.m_dispatches);
+
+    // cleared: every type is accepted and processed again
+    service.setIsLmcpObjectHandlerOnly(false);
+    EXPECT_TRUE(service.isAcceptedLmcpType(keyValuePair));
+    EXPECT_TRUE(service.dispatch(std::make_shared<afrl::cmasi::KeyValuePair>()));
+}
+
+int main(int argc, char **argv)
+{
+    // Build, Google Test run-time and environment tear-down
+    ::testing::InitGoogleTest(&argc, argv);
+    // Run the tests and return the results
+    return RUN_ALL_TESTS();
+}
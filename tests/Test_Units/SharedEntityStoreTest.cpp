@@ -0,0 +1,268 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   SharedEntityStoreTest.cpp
+ *
+ * Functional checks of the SharedEntityStore: its persistent maps must keep
+ * every earlier version unchanged, snapshots held by readers must not change
+ * while writers update the store, concurrent readers must only see
+ * complete updates in publishing order, and states going back in time must
+ * replace the stored ones.
+ */
+#include "gtest/gtest.h"
+
+#include "SharedEntityStore.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+using uxas::service::task::SharedEntityStore;
+
+// the store is process-wide, each test uses its own entity IDs
+const int64_t c_snapshotEntityId{1000};
+const int64_t c_interestEntityId{2000};
+const int64_t c_concurrentFirstEntityId{3000};
+const int64_t c_resetEntityId{4000};
+const int64_t c_concurrentEntityCount{64};
+const int64_t c_concurrentRounds{200};
+const size_t c_readerCount{3};
+
+std::shared_ptr<afrl::cmasi::EntityState>
+createEntityState(int64_t id, int64_t time)
+{
+    auto entityState = std::make_shared<afrl::cmasi::EntityState>();
+    entityState->setID(id);
+    entityState->setTime(time);
+    return (entityState);
+}
+
+// checks the map against a reference: lookups, size and iteration
+void
+expectEqualMaps(const std::map<int64_t, std::shared_ptr<afrl::cmasi::EntityState> >& reference,
+                const SharedEntityStore::IdVsObject<afrl::cmasi::EntityState>& map)
+{
+    ASSERT_EQ(reference.size(), map.size());
+    for (auto& entry : reference)
+    {
+        auto itEntry = map.find(entry.first);
+        ASSERT_TRUE(itEntry != map.end()) << "ID " << entry.first;
+        EXPECT_EQ(entry.first, itEntry->first);
+        EXPECT_EQ(entry.second, itEntry->second) << "ID " << entry.first;
+    }
+    std::map<int64_t, std::shared_ptr<afrl::cmasi::EntityState> > iterated;
+    for (auto& entry : map)
+    {
+        EXPECT_TRUE(iterated.insert(entry).second) << "ID " << entry.first << " iterated twice";
+    }
+    EXPECT_EQ(reference, iterated);
+}
+
+} //namespace
+
+TEST(SharedEntityStoreTest, persistent_map)
+{
+    SharedEntityStore::IdVsObject<afrl::cmasi::EntityState> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_TRUE(map.begin() == map.end());
+    EXPECT_TRUE(map.find(0) == map.end());
+
+    // sequential, negative, sparse and extreme IDs
+    std::vector<int64_t> ids;
+    for (int64_t id = 0; id < 1000; id++)
+    {
+        ids.push_back(id);
+        ids.push_back(-id - 1);
+        ids.push_back(id << 32);
+    }
+    ids.push_back(INT64_MAX);
+    ids.push_back(INT64_MIN);
+
+    // every earlier version is kept, the references of some are checked
+    std::vector<SharedEntityStore::IdVsObject<afrl::cmasi::EntityState> > versions{map};
+    std::map<int64_t, std::shared_ptr<afrl::cmasi::EntityState> > reference;
+    std::map<size_t, std::map<int64_t, std::shared_ptr<afrl::cmasi::EntityState> > > versionVsReference{{0, reference}};
+    for (auto id : ids)
+    {
+        auto entityState = createEntityState(id, 0);
+        versions.push_back(versions.back().set(id, entityState));
+        reference[id] = entityState;
+        if (versions.size() % 97 == 0)
+        {
+            versionVsReference[versions.size() - 1] = reference;
+        }
+    }
+    versionVsReference[versions.size() - 1] = reference;
+    EXPECT_TRUE(versions.front().empty());
+    for (auto& versionReference : versionVsReference)
+    {
+        expectEqualMaps(versionReference.second, versions[versionReference.first]);
+    }
+
+    // replacing an entry keeps the size and leaves the earlier version unchanged
+    auto& latest = versions.back();
+    auto replacement = createEntityState(ids[5], 1);
+    auto replaced = latest.set(ids[5], replacement);
+    EXPECT_EQ(latest.size(), replaced.size());
+    EXPECT_EQ(replacement, replaced.find(ids[5])->second);
+    EXPECT_EQ(reference[ids[5]], latest.find(ids[5])->second);
+    EXPECT_EQ(1u, replaced.count(ids[5]));
+    EXPECT_EQ(0u, replaced.count(1000));
+}
+
+TEST(SharedEntityStoreTest, snapshot_consistency)
+{
+    auto& store = SharedEntityStore::getInstance();
+    std::vector<std::string> notifyAddresses;
+    auto firstState = createEntityState(c_snapshotEntityId, 100);
+    ASSERT_TRUE(store.setEntityState(firstState, notifyAddresses));
+    auto snapshot = store.getSnapshot();
+    EXPECT_EQ(snapshot->m_version, store.getVersion());
+    auto entityCount = snapshot->m_entityStates.size();
+
+    // a held snapshot does not see later updates
+    auto secondState = createEntityState(c_snapshotEntityId, 200);
+    ASSERT_TRUE(store.setEntityState(secondState, notifyAddresses));
+    ASSERT_TRUE(store.setEntityState(createEntityState(c_snapshotEntityId + 1, 200), notifyAddresses));
+    EXPECT_EQ(firstState, snapshot->m_entityStates.find(c_snapshotEntityId)->second);
+    EXPECT_EQ(0u, snapshot->m_entityStates.count(c_snapshotEntityId + 1));
+    EXPECT_EQ(entityCount, snapshot->m_entityStates.size());
+
+    auto latestSnapshot = store.getSnapshot();
+    EXPECT_EQ(snapshot->m_version + 2, latestSnapshot->m_version);
+    EXPECT_EQ(secondState, latestSnapshot->m_entityStates.find(c_snapshotEntityId)->second);
+    EXPECT_EQ(entityCount + 1, latestSnapshot->m_entityStates.size());
+
+    // repeated states do not change the store
+    EXPECT_FALSE(store.setEntityState(secondState, notifyAddresses));
+    EXPECT_EQ(latestSnapshot, store.getSnapshot());
+
+    // the views used by the task services
+    SharedEntityStore::MapView<afrl::cmasi::EntityState> view;
+    EXPECT_TRUE(view.empty());
+    view.reset(snapshot->m_entityStates);
+    EXPECT_EQ(firstState, view[c_snapshotEntityId]);
+    EXPECT_FALSE(view[c_snapshotEntityId + 1]);
+    EXPECT_EQ(entityCount, view.size());
+}
+
+TEST(SharedEntityStoreTest, entity_state_time_reset)
+{
+    // after a replay seek-back, restart or simulation reset, states go back in time
+    auto& store = SharedEntityStore::getInstance();
+    store.setEntityStateInterest("resetTask", {c_resetEntityId}, false);
+    std::vector<std::string> notifyAddresses;
+    ASSERT_TRUE(store.setEntityState(createEntityState(c_resetEntityId, 1000), notifyAddresses));
+
+    auto earlierState = createEntityState(c_resetEntityId, 10);
+    EXPECT_TRUE(store.setEntityState(earlierState, notifyAddresses));
+    EXPECT_EQ(std::vector<std::string>({"resetTask"}), notifyAddresses);
+    EXPECT_EQ(earlierState, store.getSnapshot()->m_entityStates.find(c_resetEntityId)->second);
+    EXPECT_TRUE(store.setEntityState(createEntityState(c_resetEntityId, 20), notifyAddresses));
+    EXPECT_EQ(20, store.getSnapshot()->m_entityStates.find(c_resetEntityId)->second->getTime());
+    store.removeEntityStateInterest("resetTask");
+}
+
+TEST(SharedEntityStoreTest, entity_state_interest)
+{
+    auto& store = SharedEntityStore::getInstance();
+    store.setEntityStateInterest("task1", {c_interestEntityId}, false);
+    store.setEntityStateInterest("task2", {c_interestEntityId, c_interestEntityId + 1}, false);
+    store.setEntityStateInterest("task3", {c_interestEntityId}, true);
+
+    std::vector<std::string> notifyAddresses;
+    ASSERT_TRUE(store.setEntityState(createEntityState(c_interestEntityId, 1), notifyAddresses));
+    std::sort(notifyAddresses.begin(), notifyAddresses.end());
+    EXPECT_EQ(std::vector<std::string>({"task1", "task2", "task3"}), notifyAddresses);
+
+    ASSERT_TRUE(store.setEntityState(createEntityState(c_interestEntityId + 2, 1), notifyAddresses));
+    EXPECT_EQ(std::vector<std::string>({"task3"}), notifyAddresses);
+
+    store.setEntityStateInterest("task2", {c_interestEntityId + 1}, false);
+    store.removeEntityStateInterest("task3");
+    ASSERT_TRUE(store.setEntityState(createEntityState(c_interestEntityId, 2), notifyAddresses));
+    EXPECT_EQ(std::vector<std::string>({"task1"}), notifyAddresses);
+    store.removeEntityStateInterest("task1");
+    store.removeEntityStateInterest("task2");
+}
+
+TEST(SharedEntityStoreTest, concurrent_readers)
+{
+    auto& store = SharedEntityStore::getInstance();
+    std::atomic<bool> isWriting(true);
+    std::vector<std::thread> readers;
+    std::vector<size_t> readerSnapshotCounts(c_readerCount, 0);
+    for (size_t reader = 0; reader < c_readerCount; reader++)
+    {
+        readers.push_back(std::thread([&, reader]()
+        {
+            uint64_t lastVersion(0);
+            std::vector<int64_t> lastTimes(c_concurrentEntityCount, 0);
+            while (isWriting.load() || readerSnapshotCounts[reader] == 0)
+            {
+                auto snapshot = store.getSnapshot();
+                EXPECT_GE(snapshot->m_version, lastVersion);
+                lastVersion = snapshot->m_version;
+
+                // the writer updates the entities in ID order, one round after the other:
+                // a snapshot holds round r for the first entities and round r - 1 for the others
+                int64_t firstTime(-1);
+                for (int64_t entity = 0; entity < c_concurrentEntityCount; entity++)
+                {
+                    auto itEntityState = snapshot->m_entityStates.find(c_concurrentFirstEntityId + entity);
+                    int64_t time = (itEntityState != snapshot->m_entityStates.end()) ? itEntityState->second->getTime() : 0;
+                    if (entity == 0)
+                    {
+                        firstTime = time;
+                    }
+                    EXPECT_TRUE(time == firstTime || time == firstTime - 1) << "entity " << entity << " time " << time << " first " << firstTime;
+                    EXPECT_GE(time, lastTimes[entity]);
+                    lastTimes[entity] = time;
+                }
+                readerSnapshotCounts[reader]++;
+            }
+        }));
+    }
+
+    std::vector<std::string> notifyAddresses;
+    for (int64_t round = 1; round <= c_concurrentRounds; round++)
+    {
+        for (int64_t entity = 0; entity < c_concurrentEntityCount; entity++)
+        {
+            store.setEntityState(createEntityState(c_concurrentFirstEntityId + entity, round), notifyAddresses);
+        }
+    }
+    isWriting = false;
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    auto snapshot = store.getSnapshot();
+    for (int64_t entity = 0; entity < c_concurrentEntityCount; entity++)
+    {
+        EXPECT_EQ(c_concurrentRounds, snapshot->m_entityStates.find(c_concurrentFirstEntityId + entity)->second->getTime());
+    }
+}
+
+int main(int argc, char **argv)
+{
+    // Build, Google Test run-time and environment tear-down
+    ::testing::InitGoogleTest(&argc, argv);
+    // Run the tests and return the results
+    return RUN_ALL_TESTS();
+}
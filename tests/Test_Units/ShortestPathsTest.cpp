@@ -0,0 +1,132 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   ShortestPathsTest.cpp
+ *
+ * Functional checks of the one-to-many path searches used for cost matrices:
+ * VisiLibity::Environment::shortest_paths and CVisibilityGraph::isFindPaths
+ * must return the paths of repeated one-to-one searches in an environment
+ * with holes (including unobstructed, coincident and repeated positions).
+ */
+#include "gtest/gtest.h"
+
+#include "visilibity.h"
+#include "VisibilityGraph.h"
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+const double c_epsilon{1e-6};
+
+// boundary 0..100 with three irregular holes (clockwise)
+VisiLibity::Environment
+createEnvironment()
+{
+    VisiLibity::Environment environment(VisiLibity::Polygon(std::vector<VisiLibity::Point>{
+        VisiLibity::Point(0.0, 0.0), VisiLibity::Point(100.0, 0.0), VisiLibity::Point(100.0, 100.0), VisiLibity::Point(0.0, 100.0)}));
+    environment.add_hole(VisiLibity::Polygon(std::vector<VisiLibity::Point>{
+        VisiLibity::Point(20.0, 20.0), VisiLibity::Point(23.0, 61.0), VisiLibity::Point(41.0, 58.0), VisiLibity::Point(38.0, 21.0)}));
+    environment.add_hole(VisiLibity::Polygon(std::vector<VisiLibity::Point>{
+        VisiLibity::Point(55.0, 30.0), VisiLibity::Point(52.0, 47.0), VisiLibity::Point(81.0, 52.0), VisiLibity::Point(78.0, 33.0)}));
+    environment.add_hole(VisiLibity::Polygon(std::vector<VisiLibity::Point>{
+        VisiLibity::Point(45.0, 70.0), VisiLibity::Point(47.0, 88.0), VisiLibity::Point(72.0, 84.0), VisiLibity::Point(69.0, 67.0)}));
+    environment.enforce_standard_form();
+    return (environment);
+}
+
+const std::vector<VisiLibity::Point> c_starts = {
+    VisiLibity::Point(5.0, 5.0), VisiLibity::Point(50.0, 60.0), VisiLibity::Point(95.0, 93.0)};
+
+// behind each hole, unobstructed, coincident with a start and repeated
+const std::vector<VisiLibity::Point> c_finishes = {
+    VisiLibity::Point(31.0, 75.0), VisiLibity::Point(90.0, 41.0), VisiLibity::Point(58.0, 95.0),
+    VisiLibity::Point(10.0, 4.0), VisiLibity::Point(50.0, 60.0), VisiLibity::Point(90.0, 41.0),
+    VisiLibity::Point(30.0, 15.0)};
+
+} //namespace
+
+TEST(ShortestPathsTest, visilibity_shortest_paths)
+{
+    VisiLibity::Environment environment = createEnvironment();
+    ASSERT_TRUE(environment.is_valid(c_epsilon));
+    VisiLibity::Visibility_Graph visibilityGraph(environment, c_epsilon);
+
+    for (const auto& start : c_starts)
+    {
+        std::vector<VisiLibity::Polyline> paths = environment.shortest_paths(start, c_finishes, visibilityGraph, c_epsilon);
+        ASSERT_EQ(c_finishes.size(), paths.size());
+        for (size_t finish = 0; finish < c_finishes.size(); finish++)
+        {
+            VisiLibity::Polyline expected = environment.shortest_path(start, c_finishes[finish], visibilityGraph, c_epsilon);
+            EXPECT_NEAR(expected.length(), paths[finish].length(), c_epsilon) << "start " << start << " finish " << c_finishes[finish];
+            ASSERT_EQ(expected.size(), paths[finish].size()) << "start " << start << " finish " << c_finishes[finish];
+            for (unsigned vertex = 0; vertex < expected.size(); vertex++)
+            {
+                EXPECT_LE(VisiLibity::distance(expected[vertex], paths[finish][vertex]), c_epsilon);
+            }
+        }
+    }
+}
+
+TEST(ShortestPathsTest, visibility_graph_find_paths)
+{
+    // the same zones as a keep-in zone and keep-out zones (north = x, east = y)
+    VisiLibity::Environment environment = createEnvironment();
+    n_FrameworkLib::CVisibilityGraph visibilityGraph;
+    for (unsigned polygon = 0; polygon < environment.h() + 1; polygon++)
+    {
+        n_FrameworkLib::V_POSITION_t vertices;
+        for (unsigned vertex = 0; vertex < environment[polygon].n(); vertex++)
+        {
+            vertices.push_back(n_FrameworkLib::CPosition(environment[polygon][vertex].x(), environment[polygon][vertex].y()));
+        }
+        ASSERT_EQ(n_FrameworkLib::CVisibilityGraph::errNoError,
+                  visibilityGraph.errAddPolygon(static_cast<int>(polygon) + 1, vertices.begin(), vertices.end(), polygon == 0));
+    }
+    ASSERT_EQ(n_FrameworkLib::CVisibilityGraph::errNoError, visibilityGraph.errFinalizePolygons());
+    ASSERT_EQ(n_FrameworkLib::CVisibilityGraph::errNoError, visibilityGraph.errBuildVisibilityGraph());
+    ASSERT_EQ(n_FrameworkLib::CVisibilityGraph::errNoError, visibilityGraph.errInitializeGraphBase());
+
+    // all start/finish pairs of a cost matrix in one request
+    std::vector<std::shared_ptr<n_FrameworkLib::CPathInformation> > paths;
+    for (const auto& start : c_starts)
+    {
+        for (const auto& finish : c_finishes)
+        {
+            auto path = std::make_shared<n_FrameworkLib::CPathInformation>();
+            path->posGetStart() = n_FrameworkLib::CPosition(start.x(), start.y());
+            path->posGetEnd() = n_FrameworkLib::CPosition(finish.x(), finish.y());
+            paths.push_back(path);
+        }
+    }
+    std::vector<std::shared_ptr<n_FrameworkLib::CPathInformation> > expectedPaths;
+    for (const auto& path : paths)
+    {
+        expectedPaths.push_back(std::make_shared<n_FrameworkLib::CPathInformation>(*path));
+    }
+    ASSERT_TRUE(visibilityGraph.isFindPaths(paths));
+
+    for (size_t path = 0; path < paths.size(); path++)
+    {
+        ASSERT_TRUE(visibilityGraph.isFindPath(expectedPaths[path]));
+        EXPECT_EQ(expectedPaths[path]->iGetLength(), paths[path]->iGetLength()) << "path " << path;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    // Build, Google Test run-time and environment tear-down
+    ::testing::InitGoogleTest(&argc, argv);
+    // Run the tests and return the results
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,130 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   ThreadPoolTest.cpp
+ *
+ * Functional checks of the thread pool: posted and submitted jobs must
+ * execute, exceptions thrown by submitted jobs must reach the future,
+ * parallelFor must complete every index even when nested or when all
+ * workers are busy (the calling thread takes part), and shutdown must
+ * execute the queued jobs.
+ */
+#include "gtest/gtest.h"
+
+#include "UxAS_ThreadPool.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(ThreadPoolTest, post_and_submit)
+{
+    uxas::common::ThreadPool threadPool(4);
+    EXPECT_EQ(4u, threadPool.getThreadCount());
+
+    std::promise<std::thread::id> postedThreadId;
+    threadPool.post([&postedThreadId]() { postedThreadId.set_value(std::this_thread::get_id()); });
+    EXPECT_NE(std::this_thread::get_id(), postedThreadId.get_future().get());
+
+    std::vector<std::future<size_t> > results;
+    for (size_t index = 0; index < 100; index++)
+    {
+        results.push_back(threadPool.submit([index]() { return (index * index); }));
+    }
+    for (size_t index = 0; index < results.size(); index++)
+    {
+        EXPECT_EQ(index * index, results[index].get());
+    }
+}
+
+TEST(ThreadPoolTest, submit_exception)
+{
+    uxas::common::ThreadPool threadPool(2);
+    auto result = threadPool.submit([]() -> int { throw std::runtime_error("submitted"); });
+    EXPECT_THROW(result.get(), std::runtime_error);
+
+    // the worker survives the exception
+    EXPECT_EQ(1, threadPool.submit([]() { return (1); }).get());
+}
+
+TEST(ThreadPoolTest, nested_parallel_for)
+{
+    uxas::common::ThreadPool threadPool(2);
+    const size_t outerCount{8};
+    const size_t innerCount{16};
+    std::vector<std::atomic<uint32_t> > executionCounts(outerCount * innerCount);
+    threadPool.parallelFor(outerCount, [&threadPool, &executionCounts, innerCount](size_t outerIndex)
+    {
+        threadPool.parallelFor(innerCount, [&executionCounts, innerCount, outerIndex](size_t innerIndex)
+        {
+            executionCounts[outerIndex * innerCount + innerIndex]++;
+        });
+    });
+    for (auto& executionCount : executionCounts)
+    {
+        EXPECT_EQ(1u, executionCount.load());
+    }
+}
+
+TEST(ThreadPoolTest, parallel_for_busy_workers)
+{
+    // the only worker waits until the loop is complete, so the calling
+    // thread must execute every index
+    uxas::common::ThreadPool threadPool(1);
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::promise<void> blocked;
+    threadPool.post([released, &blocked]() { blocked.set_value(); released.wait(); });
+    blocked.get_future().wait();
+
+    std::vector<std::thread::id> threadIds(32);
+    threadPool.parallelFor(threadIds.size(), [&threadIds](size_t index) { threadIds[index] = std::this_thread::get_id(); });
+    release.set_value();
+    EXPECT_EQ(std::vector<std::thread::id>(threadIds.size(), std::this_thread::get_id()), threadIds);
+}
+
+TEST(ThreadPoolTest, shutdown_drains)
+{
+    uxas::common::ThreadPool threadPool(1);
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<uint32_t> executedCount{0};
+    threadPool.post([released]() { released.wait(); });
+    for (size_t index = 0; index < 100; index++)
+    {
+        threadPool.post([&executedCount]() { executedCount++; });
+    }
+
+    // the jobs queued before shutdown execute
+    std::thread releaser([&release]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        release.set_value();
+    });
+    threadPool.shutdown();
+    releaser.join();
+    EXPECT_EQ(100u, executedCount.load());
+
+    // jobs posted afterwards execute on the posting thread
+    std::thread::id postedThreadId;
+    threadPool.post([&postedThreadId]() { postedThreadId = std::this_thread::get_id(); });
+    EXPECT_EQ(std::this_thread::get_id(), postedThreadId);
+}
+
+int main(int argc, char **argv)
+{
+    // Build, Google Test run-time and environment tear-down
+    ::testing::InitGoogleTest(&argc, argv);
+    // Run the tests and return the results
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,295 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   TimerManagerTest.cpp
+ *
+ * Functional checks of the timing-wheel TimerManager (single-shot, periodic,
+ * disable, re-start from within a callback, long delays, callback pool) and a
+ * jitter benchmark (disabled by default) with a few thousand active periodic
+ * timers, with callbacks on the timer thread and on a callback pool. The
+ * checks wait for callbacks with a generous timeout instead of sleeping for
+ * a fixed time, so that they hold on loaded machines.
+ */
+#include "gtest/gtest.h"
+
+#include "UxAS_TimerManager.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+// upper bound for callbacks that are due; only reached if the TimerManager fails
+const std::chrono::seconds c_waitTimeout{10};
+// period checked for callbacks that must not happen
+const std::chrono::milliseconds c_quietPeriod{50};
+
+/** \brief Counts callbacks; tests wait for a count instead of sleeping. */
+class CallbackCounter
+{
+public:
+
+    void
+    increment()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_count++;
+        m_condition.notify_all();
+    };
+
+    uint32_t
+    getCount()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return (m_count);
+    };
+
+    /** \brief returns false if the count is not reached within the timeout */
+    bool
+    isWaitForCount(uint32_t count, std::chrono::milliseconds timeout = c_waitTimeout)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return (m_condition.wait_for(lock, timeout, [this, count]() { return (m_count >= count); }));
+    };
+
+private:
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    uint32_t m_count{0};
+};
+
+struct PeriodicTimerRecord
+{
+    uint64_t m_timerId{0};
+    Clock::time_point m_startTime;
+    uint64_t m_startDelay_ms{0};
+    uint64_t m_period_ms{0};
+    uint64_t m_callbackCount{0};
+    std::vector<int64_t> m_lateness_us;
+};
+
+// the callbacks of one timer never overlap, so records are not shared between threads
+void
+recordCallback(PeriodicTimerRecord& record)
+{
+    auto expectedTime = record.m_startTime + std::chrono::milliseconds(record.m_startDelay_ms + record.m_callbackCount * record.m_period_ms);
+    record.m_lateness_us.push_back(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - expectedTime).count());
+    record.m_callbackCount++;
+}
+
+int64_t
+percentile(std::vector<int64_t>& values, double fraction)
+{
+    if (values.empty())
+    {
+        return (0);
+    }
+    size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return (values[index]);
+}
+
+void
+benchmarkJitter(const std::string& name, uint32_t timerCount, uint32_t duration_ms)
+{
+    auto& timerManager = uxas::common::TimerManager::getInstance();
+    std::vector<std::unique_ptr<PeriodicTimerRecord>> records;
+    for (uint32_t timerIndex = 0; timerIndex < timerCount; timerIndex++)
+    {
+        std::unique_ptr<PeriodicTimerRecord> record(new PeriodicTimerRecord);
+        record->m_startDelay_ms = 10 + timerIndex % 50;
+        record->m_period_ms = 20 + 10 * (timerIndex % 10);
+        PeriodicTimerRecord* callbackRecord = record.get();
+        record->m_timerId = timerManager.createTimer([callbackRecord]() { recordCallback(*callbackRecord); }, "JitterTimer");
+        records.push_back(std::move(record));
+    }
+    for (auto& record : records)
+    {
+        // lateness is measured from the requested start (never early, so rounding up adds less than 1 ms)
+        record->m_startTime = Clock::now();
+        ASSERT_TRUE(timerManager.startPeriodicTimer(record->m_timerId, record->m_startDelay_ms, record->m_period_ms));
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms));
+
+    std::vector<uint64_t> timerIds;
+    for (auto& record : records)
+    {
+        timerIds.push_back(record->m_timerId);
+    }
+    EXPECT_EQ(timerIds.size(), timerManager.destroyTimers(timerIds, 1000));
+
+    std::vector<int64_t> lateness_us;
+    uint64_t callbackCount{0};
+    for (auto& record : records)
+    {
+        EXPECT_GT(record->m_callbackCount, 0u);
+        callbackCount += record->m_callbackCount;
+        lateness_us.insert(lateness_us.end(), record->m_lateness_us.begin(), record->m_lateness_us.end());
+    }
+    int64_t minimumLateness_us = lateness_us.empty() ? 0 : *std::min_element(lateness_us.begin(), lateness_us.end());
+    EXPECT_GE(minimumLateness_us, -1000); // never more than the rounding of the start time early
+
+    std::cout << name << " [" << timerCount << " timers, " << duration_ms << " ms, " << callbackCount << " callbacks] lateness p50 "
+            << percentile(lateness_us, 0.5) << " us, p99 " << percentile(lateness_us, 0.99) << " us, max "
+            << percentile(lateness_us, 1.0) << " us" << std::endl;
+}
+
+} //namespace
+
+TEST(TimerManagerTest, single_shot)
+{
+    auto& timerManager = uxas::common::TimerManager::getInstance();
+    CallbackCounter callbackCounter;
+    uint64_t timerId = timerManager.createTimer([&callbackCounter]() { callbackCounter.increment(); }, "SingleShotTimer");
+    auto startTime = Clock::now();
+    ASSERT_TRUE(timerManager.startSingleShotTimer(timerId, 30));
+    EXPECT_TRUE(timerManager.isTimerActive(timerId));
+    ASSERT_TRUE(callbackCounter.isWaitForCount(1));
+    EXPECT_GE(Clock::now() - startTime, std::chrono::milliseconds(30));
+    // fires once
+    std::this_thread::sleep_for(c_quietPeriod);
+    EXPECT_EQ(1u, callbackCounter.getCount());
+    EXPECT_FALSE(timerManager.isTimerActive(timerId));
+    EXPECT_TRUE(timerManager.destroyTimer(timerId, 100));
+}
+
+TEST(TimerManagerTest, disable_and_restart)
+{
+    auto& timerManager = uxas::common::TimerManager::getInstance();
+    CallbackCounter callbackCounter;
+    uint64_t timerId = timerManager.createTimer([&callbackCounter]() { callbackCounter.increment(); }, "DisabledTimer");
+    ASSERT_TRUE(timerManager.startPeriodicTimer(timerId, 20, 20));
+    EXPECT_TRUE(timerManager.disableTimer(timerId, 100));
+    EXPECT_FALSE(timerManager.isTimerActive(timerId));
+    std::this_thread::sleep_for(c_quietPeriod + std::chrono::milliseconds(20));
+    EXPECT_EQ(0u, callbackCounter.getCount());
+
+    // re-starting a started timer replaces its schedule: one callback after 10 ms, none after 500 ms
+    ASSERT_TRUE(timerManager.startPeriodicTimer(timerId, 500, 500));
+    auto startTime = Clock::now();
+    ASSERT_TRUE(timerManager.startSingleShotTimer(timerId, 10));
+    ASSERT_TRUE(callbackCounter.isWaitForCount(1));
+    EXPECT_LT(Clock::now() - startTime, std::chrono::milliseconds(500));
+    EXPECT_FALSE(callbackCounter.isWaitForCount(2, std::chrono::milliseconds(500) + c_quietPeriod));
+    EXPECT_TRUE(timerManager.destroyTimer(timerId, 100));
+    EXPECT_FALSE(timerManager.startSingleShotTimer(timerId, 10));
+}
+
+TEST(TimerManagerTest, restart_within_callback)
+{
+    auto& timerManager = uxas::common::TimerManager::getInstance();
+    CallbackCounter callbackCounter;
+    std::atomic<uint32_t> callbackCount{0};
+    uint64_t timerId{0};
+    timerId = timerManager.createTimer([&timerManager, &callbackCounter, &callbackCount, &timerId]()
+    {
+        if (++callbackCount < 3)
+        {
+            timerManager.startSingleShotTimer(timerId, 5);
+        }
+        callbackCounter.increment();
+    }, "RestartedTimer");
+    ASSERT_TRUE(timerManager.startSingleShotTimer(timerId, 5));
+    ASSERT_TRUE(callbackCounter.isWaitForCount(3));
+    // not re-started by the third callback
+    std::this_thread::sleep_for(c_quietPeriod);
+    EXPECT_EQ(3u, callbackCounter.getCount());
+    EXPECT_TRUE(timerManager.destroyTimer(timerId, 100));
+}
+
+TEST(TimerManagerTest, ordering_across_wheel_levels)
+{
+    // delays spanning the first two wheel levels (cascaded timers)
+    auto& timerManager = uxas::common::TimerManager::getInstance();
+    CallbackCounter callbackCounter;
+    std::mutex orderMutex;
+    std::vector<uint64_t> order;
+    std::vector<uint64_t> delays_ms = {600, 5, 300, 255, 256, 40};
+    std::vector<uint64_t> timerIds;
+    for (auto delay_ms : delays_ms)
+    {
+        timerIds.push_back(timerManager.createTimer([&orderMutex, &order, &callbackCounter, delay_ms]()
+        {
+            {
+                std::lock_guard<std::mutex> lock(orderMutex);
+                order.push_back(delay_ms);
+            }
+            callbackCounter.increment();
+        }, "OrderedTimer"));
+    }
+    for (size_t timerIndex = 0; timerIndex < timerIds.size(); timerIndex++)
+    {
+        ASSERT_TRUE(timerManager.startSingleShotTimer(timerIds[timerIndex], delays_ms[timerIndex]));
+    }
+    ASSERT_TRUE(callbackCounter.isWaitForCount(static_cast<uint32_t>(delays_ms.size())));
+    std::sort(delays_ms.begin(), delays_ms.end());
+    {
+        std::lock_guard<std::mutex> lock(orderMutex);
+        EXPECT_EQ(delays_ms, order);
+    }
+    EXPECT_EQ(timerIds.size(), timerManager.destroyTimers(timerIds, 100));
+}
+
+TEST(TimerManagerTest, slow_callback_on_callback_pool)
+{
+    auto& timerManager = uxas::common::TimerManager::getInstance();
+    timerManager.setCallbackThreadCount(4);
+
+    // the slow callback lasts until the fast timer fired 3 more times, which
+    // only happens if the pool keeps running other callbacks meanwhile
+    CallbackCounter fastCallbackCounter;
+    CallbackCounter slowCallbackCounter;
+    std::atomic<bool> isFastTimerRunDuringSlowCallback{false};
+    uint64_t slowTimerId = timerManager.createTimer([&]()
+    {
+        isFastTimerRunDuringSlowCallback = fastCallbackCounter.isWaitForCount(fastCallbackCounter.getCount() + 3);
+        slowCallbackCounter.increment();
+    }, "SlowTimer");
+    uint64_t fastTimerId = timerManager.createTimer([&fastCallbackCounter]() { fastCallbackCounter.increment(); }, "FastTimer");
+    ASSERT_TRUE(timerManager.startSingleShotTimer(slowTimerId, 5));
+    ASSERT_TRUE(timerManager.startPeriodicTimer(fastTimerId, 10, 10));
+    ASSERT_TRUE(slowCallbackCounter.isWaitForCount(1, c_waitTimeout * 2));
+    EXPECT_TRUE(isFastTimerRunDuringSlowCallback);
+
+    std::vector<uint64_t> timerIds = {slowTimerId, fastTimerId};
+    EXPECT_EQ(timerIds.size(), timerManager.destroyTimers(timerIds, 1000));
+    timerManager.setCallbackThreadCount(0);
+}
+
+// not part of the unit-test run: --gtest_also_run_disabled_tests --gtest_filter=*benchmark
+TEST(TimerManagerTest, DISABLED_jitter_benchmark)
+{
+    auto& timerManager = uxas::common::TimerManager::getInstance();
+    timerManager.setCallbackThreadCount(0);
+    benchmarkJitter("timer thread callbacks", 4000, 2000);
+    timerManager.setCallbackThreadCount(4);
+    benchmarkJitter("callback pool (4 threads)", 4000, 2000);
+    timerManager.setCallbackThreadCount(0);
+}
+
+int main(int argc, char **argv)
+{
+    // Build, Google Test run-time and environment tear-down
+    ::testing::InitGoogleTest(&argc, argv);
+    // Run the tests and return the results
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,299 @@
+// ===============================================================================
+// Authors: AFRL/RQQA
+// Organization: Air Force Research Laboratory, Aerospace Systems Directorate, Power and Control Division
+//
+// Copyright (c) 2017 Government of the United State of America, as represented by
+// the Secretary of the Air Force.  No copyright is claimed in the United States under
+// Title 17, U.S. Code.  All Other Rights Reserved.
+// ===============================================================================
+
+/*
+ * File:   VisibilityGraphUpdateTest.cpp
+ *
+ * Functional checks of the incremental visibility graph updates of
+ * VisiLibity::Visibility_Graph and CVisibilityGraph: added, removed and
+ * merged holes (keep-out zones) must give the graph of a full build, and a
+ * changed outer boundary must fall back to a full build. The time of the
+ * updates against full builds for a pop-up keep-out zone is measured by a
+ * disabled benchmark.
+ */
+#include "gtest/gtest.h"
+
+#include "visilibity.h"
+#include "VisibilityGraph.h"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+const double c_epsilon{1e-4};
+
+// irregular quadrilateral hole (clockwise) around a center, in general position
+VisiLibity::Polygon
+createHole(double north, double east, double size, int32_t seed)
+{
+    std::vector<VisiLibity::Point> vertices = {
+        VisiLibity::Point(north - size, east - size * (0.8 + 0.03 * (seed % 7))),
+        VisiLibity::Point(north + size * (0.9 + 0.02 * (seed % 5)), east - size),
+        VisiLibity::Point(north + size, east + size * (0.7 + 0.04 * (seed % 3))),
+        VisiLibity::Point(north - size * (0.85 + 0.01 * (seed % 11)), east + size)};
+    VisiLibity::Polygon hole(vertices);
+    if (hole.area() > 0)
+    {
+        hole.reverse();
+    }
+    hole.enforce_standard_form();
+    return (hole);
+}
+
+VisiLibity::Polygon
+createBoundary(double size)
+{
+    std::vector<VisiLibity::Point> vertices = {
+        VisiLibity::Point(0.0, 0.0), VisiLibity::Point(size, 0.0),
+        VisiLibity::Point(size, size), VisiLibity::Point(0.0, size)};
+    VisiLibity::Polygon boundary(vertices);
+    boundary.enforce_standard_form();
+    return (boundary);
+}
+
+// boundary followed by a grid of holes
+std::vector<VisiLibity::Polygon>
+createPolygons(size_t rowCount, double spacing)
+{
+    std::vector<VisiLibity::Polygon> polygons = {createBoundary(spacing * (rowCount + 1))};
+    int32_t seed = 0;
+    for (size_t row = 1; row <= rowCount; row++)
+    {
+        for (size_t column = 1; column <= rowCount; column++)
+        {
+            polygons.push_back(createHole(spacing * row + 0.37 * column, spacing * column + 0.21 * row, spacing * 0.2, seed++));
+        }
+    }
+    return (polygons);
+}
+
+void
+expectEqualGraphs(const VisiLibity::Visibility_Graph& expected, const VisiLibity::Visibility_Graph& actual)
+{
+    ASSERT_EQ(expected.n(), actual.n());
+    size_t differenceCount = 0;
+    for (unsigned k1 = 0; k1 < expected.n(); k1++)
+    {
+        for (unsigned k2 = 0; k2 < expected.n(); k2++)
+        {
+            differenceCount += (expected(k1, k2) != actual(k1, k2)) ? 1 : 0;
+        }
+    }
+    EXPECT_EQ(0u, differenceCount);
+}
+
+// the first polygon is the keep-in zone, the others keep-out zones (north = x, east = y)
+void
+buildVisibilityGraph(const std::vector<VisiLibity::Polygon>& polygons, n_FrameworkLib::CVisibilityGraph& visibilityGraph)
+{
+    for (size_t polygon = 0; polygon < polygons.size(); polygon++)
+    {
+        n_FrameworkLib::V_POSITION_t vertices;
+        for (unsigned vertex = 0; vertex < polygons[polygon].n(); vertex++)
+        {
+            vertices.push_back(n_FrameworkLib::CPosition(polygons[polygon][vertex].x(), polygons[polygon][vertex].y()));
+        }
+        ASSERT_EQ(n_FrameworkLib::CVisibilityGraph::errNoError,
+                  visibilityGraph.errAddPolygon(static_cast<int>(polygon) + 1, vertices.begin(), vertices.end(), polygon == 0));
+    }
+    ASSERT_EQ(n_FrameworkLib::CVisibilityGraph::errNoError, visibilityGraph.errFinalizePolygons());
+}
+
+// the same edges, in the same order
+void
+expectEqualEdges(const n_FrameworkLib::CVisibilityGraph& expected, const n_FrameworkLib::CVisibilityGraph& actual)
+{
+    ASSERT_EQ(expected.veGetEdgesVisibleBase().size(), actual.veGetEdgesVisibleBase().size());
+    size_t differenceCount = 0;
+    for (size_t edge = 0; edge < expected.veGetEdgesVisibleBase().size(); edge++)
+    {
+        const n_FrameworkLib::CEdge& expectedEdge = expected.veGetEdgesVisibleBase()[edge];
+        const n_FrameworkLib::CEdge& actualEdge = actual.veGetEdgesVisibleBase()[edge];
+        differenceCount += ((expectedEdge.first != actualEdge.first) || (expectedEdge.second != actualEdge.second)
+                            || (expectedEdge.iGetLength() != actualEdge.iGetLength())) ? 1 : 0;
+    }
+    EXPECT_EQ(0u, differenceCount);
+}
+
+// full and incremental builds of the visibility graph after a change of the polygons
+void
+expectEqualVisibilityGraphs(const std::vector<VisiLibity::Polygon>& previousPolygons, const std::vector<VisiLibity::Polygon>& polygons)
+{
+    n_FrameworkLib::CVisibilityGraph previousGraph;
+    buildVisibilityGraph(previousPolygons, previousGraph);
+    ASSERT_EQ(n_FrameworkLib::CVisibilityGraph::errNoError, previousGraph.errBuildVisibilityGraph());
+
+    n_FrameworkLib::CVisibilityGraph fullGraph;
+    buildVisibilityGraph(polygons, fullGraph);
+    ASSERT_EQ(n_FrameworkLib::CVisibilityGraph::errNoError, fullGraph.errBuildVisibilityGraph());
+    n_FrameworkLib::CVisibilityGraph updatedGraph;
+    buildVisibilityGraph(polygons, updatedGraph);
+    ASSERT_EQ(n_FrameworkLib::CVisibilityGraph::errNoError, updatedGraph.errBuildVisibilityGraph(previousGraph));
+    expectEqualEdges(fullGraph, updatedGraph);
+}
+
+double
+getMilliseconds(Clock::duration duration)
+{
+    return (std::chrono::duration_cast<std::chrono::duration<double, std::milli> >(duration).count());
+}
+
+} //namespace
+
+TEST(VisibilityGraphUpdateTest, added_hole)
+{
+    auto polygons = createPolygons(3, 100.0);
+    VisiLibity::Environment previousEnvironment(polygons);
+    ASSERT_TRUE(previousEnvironment.is_valid(c_epsilon));
+    VisiLibity::Visibility_Graph previousGraph(previousEnvironment, c_epsilon);
+
+    // pop-up zone between the holes, inserted in the middle of the hole list
+    polygons.insert(polygons.begin() + 3, createHole(152.0, 148.0, 15.0, 42));
+    VisiLibity::Environment environment(polygons);
+    ASSERT_TRUE(environment.is_valid(c_epsilon));
+    expectEqualGraphs(VisiLibity::Visibility_Graph(environment, c_epsilon),
+                      VisiLibity::Visibility_Graph(previousGraph, previousEnvironment, environment, c_epsilon));
+}
+
+TEST(VisibilityGraphUpdateTest, removed_hole)
+{
+    auto polygons = createPolygons(3, 100.0);
+    VisiLibity::Environment previousEnvironment(polygons);
+    VisiLibity::Visibility_Graph previousGraph(previousEnvironment, c_epsilon);
+
+    polygons.erase(polygons.begin() + 5);
+    VisiLibity::Environment environment(polygons);
+    ASSERT_TRUE(environment.is_valid(c_epsilon));
+    expectEqualGraphs(VisiLibity::Visibility_Graph(environment, c_epsilon),
+                      VisiLibity::Visibility_Graph(previousGraph, previousEnvironment, environment, c_epsilon));
+}
+
+TEST(VisibilityGraphUpdateTest, merged_holes)
+{
+    // two holes replaced by one that covers both (as for merged keep-out zones)
+    auto polygons = createPolygons(3, 100.0);
+    VisiLibity::Environment previousEnvironment(polygons);
+    VisiLibity::Visibility_Graph previousGraph(previousEnvironment, c_epsilon);
+
+    polygons.erase(polygons.begin() + 1, polygons.begin() + 3);
+    polygons.push_back(createHole(101.0, 150.0, 75.0, 3));
+    VisiLibity::Environment environment(polygons);
+    ASSERT_TRUE(environment.is_valid(c_epsilon));
+    expectEqualGraphs(VisiLibity::Visibility_Graph(environment, c_epsilon),
+                      VisiLibity::Visibility_Graph(previousGraph, previousEnvironment, environment, c_epsilon));
+}
+
+TEST(VisibilityGraphUpdateTest, changed_boundary)
+{
+    auto polygons = createPolygons(2, 100.0);
+    VisiLibity::Environment previousEnvironment(polygons);
+    VisiLibity::Visibility_Graph previousGraph(previousEnvironment, c_epsilon);
+
+    polygons[0] = createBoundary(400.0);
+    VisiLibity::Environment environment(polygons);
+    ASSERT_TRUE(environment.is_valid(c_epsilon));
+    expectEqualGraphs(VisiLibity::Visibility_Graph(environment, c_epsilon),
+                      VisiLibity::Visibility_Graph(previousGraph, previousEnvironment, environment, c_epsilon));
+}
+
+TEST(VisibilityGraphUpdateTest, visibility_graph_added_zone)
+{
+    auto previousPolygons = createPolygons(3, 100.0);
+    auto polygons = previousPolygons;
+    polygons.insert(polygons.begin() + 3, createHole(152.0, 148.0, 15.0, 42));
+    expectEqualVisibilityGraphs(previousPolygons, polygons);
+}
+
+TEST(VisibilityGraphUpdateTest, visibility_graph_removed_zone)
+{
+    auto previousPolygons = createPolygons(3, 100.0);
+    auto polygons = previousPolygons;
+    polygons.erase(polygons.begin() + 5);
+    expectEqualVisibilityGraphs(previousPolygons, polygons);
+}
+
+TEST(VisibilityGraphUpdateTest, visibility_graph_merged_zones)
+{
+    // a keep-out zone overlapping two others, merged with them by errFinalizePolygons
+    auto previousPolygons = createPolygons(3, 100.0);
+    auto polygons = previousPolygons;
+    polygons.push_back(createHole(100.0, 150.0, 40.0, 5));
+    expectEqualVisibilityGraphs(previousPolygons, polygons);
+}
+
+TEST(VisibilityGraphUpdateTest, visibility_graph_changed_boundary)
+{
+    auto previousPolygons = createPolygons(2, 100.0);
+    auto polygons = previousPolygons;
+    polygons[0] = createBoundary(400.0);
+    expectEqualVisibilityGraphs(previousPolygons, polygons);
+}
+
+TEST(VisibilityGraphUpdateTest, pop_up_zone)
+{
+    auto previousPolygons = createPolygons(8, 100.0);
+    auto polygons = previousPolygons;
+    polygons.push_back(createHole(452.0, 448.0, 15.0, 42));
+    VisiLibity::Environment previousEnvironment(previousPolygons);
+    VisiLibity::Visibility_Graph previousGraph(previousEnvironment, c_epsilon);
+    VisiLibity::Environment environment(polygons);
+    ASSERT_TRUE(environment.is_valid(c_epsilon));
+    expectEqualGraphs(VisiLibity::Visibility_Graph(environment, c_epsilon),
+                      VisiLibity::Visibility_Graph(previousGraph, previousEnvironment, environment, c_epsilon));
+    expectEqualVisibilityGraphs(previousPolygons, polygons);
+}
+
+// not part of the unit-test run: --gtest_also_run_disabled_tests --gtest_filter=*benchmark
+TEST(VisibilityGraphUpdateTest, DISABLED_pop_up_zone_benchmark)
+{
+    auto previousPolygons = createPolygons(8, 100.0);
+    auto polygons = previousPolygons;
+    polygons.push_back(createHole(452.0, 448.0, 15.0, 42));
+
+    VisiLibity::Environment previousEnvironment(previousPolygons);
+    VisiLibity::Visibility_Graph previousGraph(previousEnvironment, c_epsilon);
+    VisiLibity::Environment environment(polygons);
+    auto startTime = Clock::now();
+    VisiLibity::Visibility_Graph fullGraph(environment, c_epsilon);
+    auto fullDuration = Clock::now() - startTime;
+    startTime = Clock::now();
+    VisiLibity::Visibility_Graph updatedGraph(previousGraph, previousEnvironment, environment, c_epsilon);
+    auto updateDuration = Clock::now() - startTime;
+
+    n_FrameworkLib::CVisibilityGraph previousVisibilityGraph;
+    buildVisibilityGraph(previousPolygons, previousVisibilityGraph);
+    previousVisibilityGraph.errBuildVisibilityGraph();
+    n_FrameworkLib::CVisibilityGraph visibilityGraph;
+    buildVisibilityGraph(polygons, visibilityGraph);
+    startTime = Clock::now();
+    visibilityGraph.errBuildVisibilityGraph();
+    auto fullVisibilityGraphDuration = Clock::now() - startTime;
+    startTime = Clock::now();
+    visibilityGraph.errBuildVisibilityGraph(previousVisibilityGraph);
+    auto updateVisibilityGraphDuration = Clock::now() - startTime;
+
+    std::cout << "pop-up zone in an environment of " << environment.n() << " vertices:" << std::endl
+            << "  VisiLibity::Visibility_Graph full build " << getMilliseconds(fullDuration) << " ms" << std::endl
+            << "  VisiLibity::Visibility_Graph incremental update " << getMilliseconds(updateDuration) << " ms" << std::endl
+            << "  CVisibilityGraph full build " << getMilliseconds(fullVisibilityGraphDuration) << " ms" << std::endl
+            << "  CVisibilityGraph incremental update " << getMilliseconds(updateVisibilityGraphDuration) << " ms" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    // Build, Google Test run-time and environment tear-down
+    ::testing::InitGoogleTest(&argc, argv);
+    // Run the tests and return the results
+    return RUN_ALL_TESTS();
+}